@@ -6,6 +6,8 @@ set(OGDF_MEMORY_MANAGER "POOL_TS" CACHE STRING "Memory manager to be used.")
 set_property(CACHE OGDF_MEMORY_MANAGER PROPERTY STRINGS POOL_TS POOL_NTS MALLOC_TS)
 option(OGDF_DEBUG "Whether to include OGDF assertions in Debug mode (increased runtime)." ON)
 mark_as_advanced(OGDF_DEBUG)
+option(OGDF_TRACING "Whether to compile trace spans of algorithm phases into OGDF (recording is enabled at runtime)." ON)
+mark_as_advanced(OGDF_TRACING)
 option(OGDF_USE_ASSERT_EXCEPTIONS "Whether to throw an exception on failed assertions." OFF)
 set(OGDF_USE_ASSERT_EXCEPTIONS_WITH_STACK_TRACE "OFF" CACHE
     STRING "Which library (libdw, libbdf, libunwind) to use in case a stack trace should be written \
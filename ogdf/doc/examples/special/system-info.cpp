@@ -1,5 +1,6 @@
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/System.h>
+#include <ogdf/basic/SIMDKernel.h>
 
 using namespace ogdf;
 
@@ -34,6 +35,18 @@ int main()
 	cout << "VMX:    " << yn(System::cpuSupports(CPUFeature::VMX))    << endl;
 	cout << "SMX:    " << yn(System::cpuSupports(CPUFeature::SMX))    << endl;
 	cout << "EST:    " << yn(System::cpuSupports(CPUFeature::EST))    << endl;
+	cout << "AVX:    " << yn(System::cpuSupports(CPUFeature::AVX))    << endl;
+	cout << "FMA:    " << yn(System::cpuSupports(CPUFeature::FMA))    << endl;
+	cout << "AVX2:   " << yn(System::cpuSupports(CPUFeature::AVX2))   << endl;
+	cout << "AVX512F: " << yn(System::cpuSupports(CPUFeature::AVX512F)) << endl;
+	cout << "WASM SIMD128: " << yn(System::cpuSupports(CPUFeature::WASM_SIMD128)) << endl;
+	cout << endl;
+
+	cout << "SIMD kernels:" << endl;
+	cout << "-------------" << endl;
+	// only the kernels of algorithms linked into the program are listed
+	cout << "Self-test: " << (SIMDKernels::selfTest(&cout) ? "passed" : "failed") << endl;
+	SIMDKernels::benchmark(cout);
 	cout << endl;
 
 	cout << "Memory management:" << endl;
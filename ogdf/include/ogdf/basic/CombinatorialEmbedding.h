@@ -529,9 +529,11 @@ public:
 	/**
 	 * \brief Contracts edge \p e.
 	 * @param e is an edge is the associated graph.
+	 * @param keepSelfLoops determines whether edges parallel to \p e are kept as self-loops.
+	 *        Otherwise, \p e must not have parallel edges.
 	 * @return the node resulting from the contraction.
 	 */
-	node contract(edge e);
+	node contract(edge e, bool keepSelfLoops = false);
 
 	/**
 	 * Splits a face by inserting a new edge.
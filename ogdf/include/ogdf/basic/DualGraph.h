@@ -43,6 +43,11 @@ namespace ogdf {
  *
  * Dual edges are rotated counter-clockwise compared to the primal ones.
  *
+ * If the dual graph is constructed from a mutable CombinatorialEmbedding,
+ * edges can be inserted into and removed from the primal graph via
+ * splitPrimalFace() and joinPrimalFaces(). Both the primal faces and the
+ * dual graph are then updated in place instead of being recomputed.
+ *
  * @ingroup graphs
  */
 class OGDF_EXPORT DualGraph : public CombinatorialEmbedding
@@ -50,6 +55,8 @@ class OGDF_EXPORT DualGraph : public CombinatorialEmbedding
 public:
 	//! Constructor; creates dual graph and its combinatorial embedding
 	explicit DualGraph(const ConstCombinatorialEmbedding &CE);
+	//! Constructor; creates dual graph that can be updated along with \p CE
+	explicit DualGraph(CombinatorialEmbedding &CE);
 	//! Destructor
 	~DualGraph();
 	//! Returns a reference to the combinatorial embedding of the primal graph
@@ -99,14 +106,48 @@ public:
 	*/
 	const face &dualFace(node v) const { return m_dualFace[v]; }
 
+	//! Splits a primal face by inserting a primal edge and updates the dual graph.
+	/**
+	 * The new primal edge connects the nodes of \p adjSrc and \p adjTgt as in
+	 * CombinatorialEmbedding::splitFace(). The dual node of the split face
+	 * is split accordingly, and the new dual edge connects both parts.
+	 *
+	 * Requires that this dual graph was constructed from a CombinatorialEmbedding.
+	 *
+	 * @param adjSrc is the adjacency entry after which the new edge is inserted at its source.
+	 * @param adjTgt is the adjacency entry after which the new edge is inserted at its target.
+	 * \return the new primal edge.
+	 */
+	edge splitPrimalFace(adjEntry adjSrc, adjEntry adjTgt);
+
+	//! Removes primal edge \p e separating two distinct faces and updates the dual graph.
+	/**
+	 * The two dual nodes of the faces adjacent to \p e are merged, preserving
+	 * parallel dual edges as self-loops.
+	 *
+	 * Requires that this dual graph was constructed from a CombinatorialEmbedding.
+	 *
+	 * @param e is a primal edge whose left and right faces differ.
+	 * \return the joined primal face.
+	 */
+	face joinPrimalFaces(edge e);
+
 protected:
 	const ConstCombinatorialEmbedding &m_primalEmbedding; //!< The embedding of the primal graph.
+	CombinatorialEmbedding *m_mutablePrimalEmbedding; //!< The primal embedding if it may be updated, otherwise \c nullptr.
 	FaceArray<node> m_primalNode; //!< The corresponding node in the primal graph.
 	NodeArray<face> m_primalFace; //!< The corresponding facee in the embedding of the primal graph.
 	EdgeArray<edge> m_primalEdge; //!< The corresponding edge in the primal graph.
 	FaceArray<node> m_dualNode; //!< The corresponding node in the dual graph.
 	NodeArray<face> m_dualFace; //!< The corresponding face in embedding of the dual graph.
 	EdgeArray<edge> m_dualEdge; //!< The corresponding edge in the dual graph.
+
+private:
+	//! Returns the dual adjacency entry crossing the primal adjacency entry \p adj.
+	adjEntry dualAdj(adjEntry adj) const {
+		edge eDual = m_dualEdge[adj->theEdge()];
+		return adj == adj->theEdge()->adjSource() ? eDual->adjSource() : eDual->adjTarget();
+	}
 }; // class DualGraph
 
 } // end namespace ogdf
@@ -0,0 +1,159 @@
+/** \file
+ * \brief Declaration of the class FlatPQTree.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/ArrayBuffer.h>
+#include <vector>
+
+namespace ogdf {
+
+//! PQ-tree over pooled, index-based node arrays.
+/**
+ * @ingroup containers
+ *
+ * This is a lean alternative to PQTree for the common case of planarity
+ * testing: leaves are identified by non-negative integer keys (e.g. edge
+ * indices), nodes live in a single pool and are addressed by index, and
+ * the reduction uses neither virtual dispatch nor per-node allocations.
+ *
+ * Children of a node are kept in a list whose sibling links carry no
+ * orientation, so reversing a Q-node is free. Parents are maintained by a
+ * union-find structure over node handles, which allows merging a partial
+ * Q-node into its Q-node parent in constant time and thus avoids the
+ * blocked-node bookkeeping of the classical bubble phase.
+ *
+ * The tree can be reset with clear() or initialize(); allocated memory is
+ * kept, so one instance can be reused for many runs.
+ */
+class OGDF_EXPORT FlatPQTree {
+public:
+	FlatPQTree() : m_root(-1), m_pertRoot(-1), m_stamp(0) { }
+
+	//! Removes all nodes; allocated memory is kept for later use.
+	void clear();
+
+	//! Reinitializes the tree as a single P-node with leaves for the keys in [\p first, \p last).
+	void initialize(const int *first, const int *last);
+
+	//! Reinitializes the tree as a single P-node with leaves \p keys.
+	void initialize(const ArrayBuffer<int> &keys) {
+		initialize(keys.begin(), keys.end());
+	}
+
+	//! Reduces the tree such that the leaves with keys in [\p first, \p last) become consecutive.
+	/**
+	 * Returns false if this is impossible; the tree must not be used
+	 * afterwards except for clear() and initialize().
+	 */
+	bool reduction(const int *first, const int *last);
+
+	//! Reduces the tree such that the leaves with \p keys become consecutive.
+	bool reduction(const ArrayBuffer<int> &keys) {
+		return reduction(keys.begin(), keys.end());
+	}
+
+	//! Replaces the pertinent subtree of the last successful reduction by a P-node with leaves for the keys in [\p first, \p last).
+	void replaceRoot(const int *first, const int *last);
+
+	//! Replaces the pertinent subtree of the last successful reduction by a P-node with leaves \p keys.
+	void replaceRoot(const ArrayBuffer<int> &keys) {
+		replaceRoot(keys.begin(), keys.end());
+	}
+
+private:
+	enum class NodeType : unsigned char { Leaf, PNode, QNode };
+	enum class NodeStatus : unsigned char { Empty, Partial, Full };
+
+	struct Node {
+		int sib[2];       //!< unordered sibling links (-1 at the ends of the child list)
+		int end[2];       //!< both ends of the child list
+		int parent;       //!< handle of the parent (-1 for the root)
+		int handle;       //!< own handle (internal nodes only)
+		int childCount;
+		int key;          //!< leaf key (leaves only)
+		int mark;         //!< reduction stamp set by the bubble phase
+		int pertChildCount;
+		int pertLeafCount;
+		int fullHead;     //!< first full child (linked by fullNext)
+		int fullNext;
+		int fullCount;
+		int partial[2];
+		int partialCount;
+		NodeType type;
+		NodeStatus status;
+	};
+
+	std::vector<Node> m_nodes;        //!< the node pool
+	std::vector<int> m_free;          //!< free slots of the pool
+	std::vector<int> m_leaf;          //!< leaf node of each key
+	std::vector<int> m_handleParent;  //!< union-find forest on handles
+	std::vector<int> m_handleOwner;   //!< node owning a root handle
+	std::vector<int> m_queue;
+	std::vector<int> m_touched;       //!< nodes whose pertinence has to be reset
+	std::vector<int> m_stack;
+
+	int m_root;
+	int m_pertRoot;
+	int m_blockEnd[2];   //!< full block of a partial pertinent root
+	int m_blockOuter[2]; //!< neighbors of the full block
+	int m_stamp;
+
+	int newNode(NodeType type);
+	int newLeaf(int key);
+	int parentOf(int v);
+	int otherSibling(int v, int w) const {
+		const Node &x = m_nodes[v];
+		return x.sib[0] == w ? x.sib[1] : x.sib[0];
+	}
+	void replaceSibling(int v, int oldSib, int newSib) {
+		Node &x = m_nodes[v];
+		x.sib[x.sib[0] == oldSib ? 0 : 1] = newSib;
+	}
+	int fullSide(int q) const {
+		return m_nodes[m_nodes[q].end[0]].status == NodeStatus::Full ? 0 : 1;
+	}
+
+	void appendChild(int p, int c, int side);
+	void removeChild(int p, int c);
+	void replaceNode(int v, int w);
+	void mergeQChild(int q, int y, int a, int side);
+	int collapse(int v);
+	int unwrap(int v);
+	int groupFull(int v);
+	void findBlock(int q, int c);
+	void freeSubtree(int v);
+	void resetPertinence();
+
+	void bubble(const int *first, const int *last);
+	int templateNonRoot(int v);
+	bool templateRoot(int v);
+};
+
+}
@@ -531,8 +531,9 @@ public:
 	 * edge \p eOrig must connect the original nodes of \p v and \a w. If \p eOrig =
 	 * (original(\p v),original(\a w)), then the created edge is (\p v,\a w), otherwise
 	 * it is (\a w,\p v). The new edge \a e must split a face in \p E, such that \a e
-	 * comes after \p adj in the adjacency list of \p v and at the end of the adjacency
-	 * list of \p v.
+	 * comes after \p adj in the adjacency list of \a w and at the end of the adjacency
+	 * list of \p v. The faces of \p E are updated accordingly, i.e., \p E need not
+	 * be recomputed.
 	 *
 	 * @param v is a node in the graph copy.
 	 * @param adj is an adjacency entry in the graph copy.
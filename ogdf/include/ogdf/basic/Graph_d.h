@@ -899,11 +899,12 @@ public:
 
 	//! Contracts edge \p e while preserving the order of adjacency entries.
 	/**
-	 * @attention Edges parallel to \p e will also be contracted (they do not result in self-loops).
+	 * @attention Unless \p keepSelfLoops is set, edges parallel to \p e will also be contracted (they do not result in self-loops).
 	 * @param e is the edge to be contracted.
+	 * @param keepSelfLoops determines whether edges parallel to \p e are kept as self-loops.
 	 * @return The endpoint of \p e to which all edges have been moved. The implementation ensures this to be the source of the former edge \p e.
 	 */
-	node contract(edge e);
+	node contract(edge e, bool keepSelfLoops = false);
 
 	//! Moves edge \p e to a different adjacency list.
 	/**
@@ -0,0 +1,86 @@
+/** \file
+ * \brief Declaration of parallelFor() for splitting loops among threads
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/Array.h>
+#include <ogdf/basic/Thread.h>
+
+namespace ogdf {
+
+//! Returns the number of threads to use for \p n work items.
+/**
+ * @ingroup threads
+ *
+ * The result is at most \p maxThreads and each thread gets at least
+ * \p minItemsPerThread items, so small inputs are processed sequentially.
+ */
+inline unsigned int numberOfThreadsFor(unsigned int maxThreads, int n, int minItemsPerThread)
+{
+	const int threads = n / std::max(minItemsPerThread, 1);
+	return std::max(1u, std::min(maxThreads, static_cast<unsigned int>(std::max(threads, 1))));
+}
+
+//! Processes the index range [0, \p n) with \p numberOfThreads threads.
+/**
+ * @ingroup threads
+ *
+ * The range is split into \p numberOfThreads consecutive chunks of (almost)
+ * equal size, and \p f(begin, end, t) is called for the t-th chunk [begin, end).
+ * The first chunk is processed by the calling thread. The function returns
+ * after all chunks have been processed. For a fixed number of threads, the
+ * chunks are always the same, so per-thread results can be combined
+ * deterministically.
+ */
+template<typename Function>
+void parallelFor(unsigned int numberOfThreads, int n, Function f)
+{
+	if (numberOfThreads > static_cast<unsigned int>(std::max(n, 1))) {
+		numberOfThreads = std::max(n, 1);
+	}
+	if (numberOfThreads <= 1) {
+		f(0, n, 0u);
+		return;
+	}
+
+	auto bound = [&](unsigned int t) {
+		return static_cast<int>(static_cast<long long>(n) * t / numberOfThreads);
+	};
+
+	Array<Thread> thread(numberOfThreads - 1);
+	for (unsigned int t = 1; t < numberOfThreads; ++t) {
+		thread[t - 1] = Thread(f, bound(t), bound(t + 1), static_cast<unsigned int>(t));
+	}
+	f(0, bound(1), 0u);
+	for (Thread &th : thread) {
+		th.join();
+	}
+}
+
+}
@@ -0,0 +1,252 @@
+/** \file
+ * \brief Declaration of SIMDKernel for numerical kernels with implementations
+ * for several instruction sets that are selected at runtime
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/System.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(EMSCRIPTEN)
+//! Defined if kernel variants for x86 instruction set extensions can be compiled.
+# define OGDF_SIMD_X86
+//! Compiles a function for the instruction set extensions \p isa, e.g., "avx2,fma".
+# define OGDF_SIMD_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+# define OGDF_SIMD_X86
+# define OGDF_SIMD_TARGET(isa)
+#else
+# define OGDF_SIMD_TARGET(isa)
+#endif
+
+#ifdef __wasm_simd128__
+//! Defined if kernel variants for WebAssembly SIMD can be compiled.
+# define OGDF_SIMD_WASM
+#endif
+
+namespace ogdf {
+
+//! Common interface of all SIMDKernel instances.
+/**
+ * @ingroup system
+ */
+class OGDF_EXPORT SIMDKernelBase {
+public:
+	explicit SIMDKernelBase(const char *name) : m_name(name) { }
+
+	SIMDKernelBase(const SIMDKernelBase&) = delete;
+	SIMDKernelBase &operator=(const SIMDKernelBase&) = delete;
+
+	//! Unregisters the kernel.
+	virtual ~SIMDKernelBase();
+
+	//! Returns the name of the kernel.
+	const char *name() const { return m_name; }
+
+	//! Returns the number of variants, variant 0 is the portable reference implementation.
+	virtual int numberOfVariants() const = 0;
+
+	//! Returns the name of variant \p i.
+	virtual const char *variantName(int i) const = 0;
+
+	//! Returns the CPUFeatureMask bits required by variant \p i.
+	virtual unsigned int requiredFeatures(int i) const = 0;
+
+	//! Returns true if variant \p i may be used on this system, see SIMDKernels::restrictFeatures().
+	bool isAvailable(int i) const;
+
+	//! Returns the index of the variant used by calls to the kernel.
+	virtual int selectedVariant() const = 0;
+
+	//! Uses variant \p i for all further calls, which must be available.
+	virtual void selectVariant(int i) = 0;
+
+	//! Selects the last available variant, i.e., the one for the most advanced instruction set.
+	void selectBest();
+
+	//! Compares the results of variant \p i with the reference implementation.
+	virtual bool selfTest(int i) const = 0;
+
+	//! Returns the minimal running time of the benchmark workload of variant \p i in seconds.
+	virtual double benchmark(int i, int repetitions) const = 0;
+
+protected:
+	//! Adds the kernel to the list returned by SIMDKernels::all(), to be called by the fully constructed kernel.
+	void registerKernel();
+
+private:
+	const char *m_name;
+};
+
+//! A numerical kernel with implementations for several instruction sets.
+/**
+ * @ingroup system
+ *
+ * Hot loops that benefit from vectorization can ship several variants in a single
+ * binary. Each variant is a function with the signature \p R(Args...) that is
+ * compiled for some instruction set extensions (see #OGDF_SIMD_TARGET) and requires
+ * the corresponding CPUFeature bits. The first variant has to be a portable
+ * implementation without requirements, it serves as the reference of the self-test.
+ *
+ * On construction, the last variant supported by the processor is selected,
+ * so variants should be listed from the least to the most advanced instruction set.
+ * Kernels are meant to be defined as static objects in the translation unit of
+ * the algorithm using them:
+ *
+ * \code
+ * SIMDKernel<double(const double*, int)> sumKernel("sum", {
+ *     {"scalar", 0, &sumScalar},
+ *     {"avx2", static_cast<unsigned int>(CPUFeatureMask::AVX2), &sumAVX2},
+ *   }, check, workload);
+ * double s = sumKernel(values, n);
+ * \endcode
+ *
+ * The \a check of the self-test runs a variant and the reference on the same
+ * input and compares the results, the \a workload runs a variant on a typical input
+ * for the benchmark mode of SIMDKernels.
+ */
+template<typename Signature>
+class SIMDKernel;
+
+template<typename R, typename... Args>
+class SIMDKernel<R(Args...)> : public SIMDKernelBase {
+public:
+	using Function = R(*)(Args...);
+
+	//! An implementation of the kernel.
+	struct Variant {
+		const char *name;              //!< Name of the instruction set, e.g., "avx2".
+		unsigned int requiredFeatures; //!< The required CPUFeatureMask bits.
+		Function function;             //!< The implementation.
+	};
+
+	//! Returns true if \a variant yields the same results as \a reference.
+	using Check = std::function<bool(Function variant, Function reference)>;
+
+	//! Runs \a variant on a typical input.
+	using Workload = std::function<void(Function variant)>;
+
+	SIMDKernel(const char *name, std::vector<Variant> variants, Check check, Workload workload)
+		: SIMDKernelBase(name), m_variants(std::move(variants)), m_check(std::move(check)), m_workload(std::move(workload))
+	{
+		OGDF_ASSERT(!m_variants.empty());
+		OGDF_ASSERT(m_variants.front().requiredFeatures == 0);
+		m_selected = 0;
+		m_function = m_variants.front().function;
+		selectBest();
+		registerKernel();
+	}
+
+	//! Calls the selected variant.
+	R operator()(Args... args) const {
+		return m_function.load(std::memory_order_relaxed)(args...);
+	}
+
+	int numberOfVariants() const override { return static_cast<int>(m_variants.size()); }
+
+	const char *variantName(int i) const override { return m_variants[i].name; }
+
+	unsigned int requiredFeatures(int i) const override { return m_variants[i].requiredFeatures; }
+
+	int selectedVariant() const override { return m_selected.load(std::memory_order_relaxed); }
+
+	void selectVariant(int i) override {
+		OGDF_ASSERT(isAvailable(i));
+		m_selected.store(i, std::memory_order_relaxed);
+		m_function.store(m_variants[i].function, std::memory_order_relaxed);
+	}
+
+	bool selfTest(int i) const override {
+		return m_check(m_variants[i].function, m_variants.front().function);
+	}
+
+	double benchmark(int i, int repetitions) const override {
+		double best = std::numeric_limits<double>::max();
+		for (int r = 0; r < repetitions; ++r) {
+			auto start = std::chrono::steady_clock::now();
+			m_workload(m_variants[i].function);
+			std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+			best = std::min(best, time.count());
+		}
+		return best;
+	}
+
+private:
+	std::vector<Variant> m_variants;
+	Check m_check;
+	Workload m_workload;
+	std::atomic<int> m_selected;
+	std::atomic<Function> m_function;
+};
+
+//! Access to all SIMDKernel instances of the program.
+/**
+ * @ingroup system
+ */
+class OGDF_EXPORT SIMDKernels {
+public:
+	//! Returns all kernels linked into the program.
+	static std::vector<SIMDKernelBase*> all();
+
+	//! Restricts the instruction set extensions kernels may use to the CPUFeatureMask bits \p mask.
+	/**
+	 * Every kernel selects its best variant that is still available, e.g.,
+	 * a \p mask of 0 selects the reference implementations.
+	 */
+	static void restrictFeatures(unsigned int mask);
+
+	//! Returns the CPUFeatureMask bits kernels may use.
+	static unsigned int allowedFeatures() { return s_allowedFeatures.load(std::memory_order_relaxed); }
+
+	//! Runs the self-test of all available variants of all kernels.
+	/**
+	 * @param os receives a line for every failed variant if not \c nullptr.
+	 * @return true iff all variants passed.
+	 */
+	static bool selfTest(std::ostream *os = nullptr);
+
+	//! Runs the benchmark workload of all available variants of all kernels and writes the timings to \p os.
+	/**
+	 * @param os receives a table of the running times.
+	 * @param repetitions is the number of runs of each workload, the minimum time is reported.
+	 * @param selectFastest selects the fastest variant of every kernel instead of the most advanced one.
+	 */
+	static void benchmark(std::ostream &os, int repetitions = 5, bool selectFastest = false);
+
+private:
+	static std::atomic<unsigned int> s_allowedFeatures;
+
+	friend class SIMDKernelBase;
+};
+
+}
@@ -0,0 +1,159 @@
+/** \file
+ * \brief Declaration of class SpatialIndex
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/basic/ArrayBuffer.h>
+#include <vector>
+
+namespace ogdf {
+
+//! Spatial index over the nodes and edges of a finished layout.
+/**
+ * @ingroup gd-helper
+ *
+ * The index answers the queries a viewer needs for interaction: all nodes or
+ * edges intersecting a box (viewport culling), the node or edge at a point
+ * (picking), and the k nodes nearest to a point.
+ *
+ * Nodes are indexed by their bounding rectangles given by x, y, width and
+ * height; edges by the segments of their polylines from the source through
+ * all bend points to the target. Both are stored in packed R-trees whose
+ * leaves are sorted along a Hilbert curve, so that the index is built in
+ * O(n log n) time and needs no pointers.
+ *
+ * When nodes are moved, updateNode() refits the affected leaves and their
+ * ancestors in O(log n) time per leaf. Many large movements degrade query
+ * performance; rebuild the index with build() in that case.
+ */
+class OGDF_EXPORT SpatialIndex
+{
+public:
+	//! Builds the index for the layout in \p GA.
+	/**
+	 * \pre \p GA has GraphAttributes::nodeGraphics and GraphAttributes::edgeGraphics.
+	 */
+	explicit SpatialIndex(const GraphAttributes &GA);
+
+	//! Rebuilds the index from scratch for the current layout.
+	void build();
+
+	//! Updates the index after node \p v and thus the end segments of its edges have moved.
+	void updateNode(node v);
+
+	//! Updates the index after the bend points of edge \p e have changed.
+	/**
+	 * If the number of bend points changed, the edge index is rebuilt.
+	 */
+	void updateEdge(edge e);
+
+	//! Returns the bounding box of the whole layout.
+	DRect boundingBox() const;
+
+	//! Appends all nodes whose rectangle intersects \p box to \p result.
+	void nodesInBox(const DRect &box, ArrayBuffer<node> &result) const;
+
+	//! Appends all edges with a segment intersecting \p box to \p result.
+	void edgesInBox(const DRect &box, ArrayBuffer<edge> &result) const;
+
+	//! Returns the node whose rectangle contains \p p, or nullptr.
+	/**
+	 * If several rectangles contain \p p, the node drawn last, i.e., the last
+	 * one in the node list of the graph, is returned.
+	 */
+	node nodeAt(const DPoint &p) const;
+
+	//! Returns the edge closest to \p p within distance \p tolerance, or nullptr.
+	edge edgeAt(const DPoint &p, double tolerance) const;
+
+	//! Appends the (at most) \p k nodes closest to \p p to \p result, in increasing distance.
+	/**
+	 * The distance of a node is the distance of \p p to its rectangle.
+	 */
+	void nearestNodes(const DPoint &p, int k, ArrayBuffer<node> &result) const;
+
+private:
+	//! A packed R-tree over axis-parallel boxes.
+	class PackedRTree {
+	public:
+		//! Builds the tree over \p boxes, four coordinates per item.
+		void build(const std::vector<double> &boxes);
+
+		//! Sets the box of \p item and refits its ancestors.
+		void update(int item, double minX, double minY, double maxX, double maxY);
+
+		//! Calls \p report for every item whose box intersects the given box.
+		template<typename Report>
+		void query(double minX, double minY, double maxX, double maxY, Report report) const;
+
+		//! Visits the items in increasing order of \p distance until \p report returns false.
+		template<typename Distance, typename Report>
+		void nearest(Distance distance, Report report) const;
+
+		//! Returns true iff the tree contains no items.
+		bool empty() const { return m_items.empty(); }
+
+		//! Returns the box of the root, or false if the tree is empty.
+		bool bounds(double &minX, double &minY, double &maxX, double &maxY) const;
+
+	private:
+		static const int s_nodeSize = 16; //!< The maximum number of children of an inner node.
+
+		std::vector<double> m_boxes; //!< Four coordinates per entry, leaves first, root last.
+		std::vector<int> m_items; //!< The item of each leaf.
+		std::vector<int> m_leaf; //!< The leaf of each item.
+		std::vector<int> m_levelStart; //!< The first entry of each level, followed by the number of entries.
+	};
+
+	const GraphAttributes *m_pGA; //!< The indexed layout.
+
+	Array<node> m_node; //!< The node of each node item.
+	NodeArray<int> m_nodeItem; //!< The item of each node.
+	std::vector<edge> m_segmentEdge; //!< The edge of each segment item.
+	EdgeArray<int> m_firstSegment; //!< The first segment item of each edge.
+	EdgeArray<int> m_numberOfSegments; //!< The number of segments of each edge.
+
+	PackedRTree m_nodeTree; //!< The tree over the node rectangles.
+	PackedRTree m_edgeTree; //!< The tree over the edge segments.
+
+	//! Returns the start point of segment item \p s in \p p and its end point in \p q.
+	void segment(int s, DPoint &p, DPoint &q) const;
+
+	//! Appends the boxes of the segments of \p e to \p boxes.
+	void segmentBoxes(edge e, std::vector<double> &boxes) const;
+
+	//! Refits the segments of \p e in the edge tree.
+	void refitEdge(edge e);
+
+	//! Builds the tree over all edge segments.
+	void buildEdges();
+};
+
+}
@@ -84,7 +84,12 @@ enum class CPUFeature {
 	VMX,    //!< Virtual Machine Extensions
 	SMX,    //!< Safer Mode Extensions
 	EST,    //!< Enhanced Intel SpeedStep Technology
-	MONITOR //!< Processor supports MONITOR/MWAIT instructions
+	MONITOR, //!< Processor supports MONITOR/MWAIT instructions
+	AVX,    //!< Advanced Vector Extensions (AVX), enabled by the operating system
+	FMA,    //!< Fused multiply-add instructions (FMA3)
+	AVX2,   //!< Advanced Vector Extensions 2 (AVX2)
+	AVX512F, //!< AVX-512 Foundation, enabled by the operating system
+	WASM_SIMD128 //!< WebAssembly 128-bit SIMD (a compile-time target, not detected at runtime)
 };
 
 //! Bit mask for CPU features.
@@ -102,7 +107,12 @@ enum class CPUFeatureMask : unsigned int {
 	VMX     = 1 << static_cast<int>(CPUFeature::VMX),    //!< Virtual Machine Extensions
 	SMX     = 1 << static_cast<int>(CPUFeature::SMX),    //!< Safer Mode Extensions
 	EST     = 1 << static_cast<int>(CPUFeature::EST),    //!< Enhanced Intel SpeedStep Technology
-	MONITOR = 1 << static_cast<int>(CPUFeature::MONITOR) //!< Processor supports MONITOR/MWAIT instructions
+	MONITOR = 1 << static_cast<int>(CPUFeature::MONITOR), //!< Processor supports MONITOR/MWAIT instructions
+	AVX     = 1 << static_cast<int>(CPUFeature::AVX),    //!< Advanced Vector Extensions (AVX)
+	FMA     = 1 << static_cast<int>(CPUFeature::FMA),    //!< Fused multiply-add instructions (FMA3)
+	AVX2    = 1 << static_cast<int>(CPUFeature::AVX2),   //!< Advanced Vector Extensions 2 (AVX2)
+	AVX512F = 1 << static_cast<int>(CPUFeature::AVX512F), //!< AVX-512 Foundation
+	WASM_SIMD128 = 1 << static_cast<int>(CPUFeature::WASM_SIMD128) //!< WebAssembly 128-bit SIMD
 };
 
 OGDF_EXPORT unsigned int operator|=(unsigned int &i, CPUFeatureMask fm);
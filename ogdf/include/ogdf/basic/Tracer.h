@@ -0,0 +1,139 @@
+/** \file
+ * \brief Declaration of a lightweight tracer for timing algorithm phases
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/basic.h>
+#include <atomic>
+#include <vector>
+
+
+namespace ogdf {
+
+//! Collects nested timing spans of algorithm phases.
+/**
+ * @ingroup date-time
+ *
+ * Layout modules mark their major phases with #OGDF_TRACE_SCOPE. As long as
+ * the tracer is disabled (the default), a span costs a single relaxed atomic
+ * load. After enable() has been called, every finished span is recorded
+ * together with its start time, duration, nesting depth and thread.
+ *
+ * The recorded spans can be written in the Chrome trace event format
+ * (see writeChromeTrace()) and inspected with \c chrome://tracing or Perfetto.
+ *
+ * If OGDF is configured with \c OGDF_TRACING=OFF, #OGDF_TRACE_SCOPE expands
+ * to nothing and the instrumentation is removed completely.
+ */
+class OGDF_EXPORT Tracer {
+public:
+	//! A finished span.
+	struct Event {
+		const char *name;   //!< The name of the span (a string literal).
+		int64_t start;      //!< The start time in microseconds since the first use of the tracer.
+		int64_t duration;   //!< The duration in microseconds.
+		int depth;          //!< The nesting depth of the span within its thread.
+		int thread;         //!< A small number identifying the recording thread.
+	};
+
+	//! Enables or disables recording of spans.
+	static void enable(bool on = true) {
+		s_enabled.store(on, std::memory_order_relaxed);
+	}
+
+	//! Returns true iff spans are currently recorded.
+	static bool enabled() {
+		return s_enabled.load(std::memory_order_relaxed);
+	}
+
+	//! Removes all recorded spans.
+	static void clear();
+
+	//! Returns a copy of all recorded spans in the order they were finished.
+	static std::vector<Event> events();
+
+	//! Returns the number of recorded spans.
+	static size_t numberOfEvents();
+
+	//! Writes all recorded spans as a Chrome trace event JSON object to \p os.
+	static void writeChromeTrace(std::ostream &os);
+
+	//! Returns the current time in microseconds since the first use of the tracer.
+	static int64_t now();
+
+	//! Opens a span on the calling thread and returns its start time.
+	static int64_t begin();
+
+	//! Closes the innermost span of the calling thread and records it as \p name.
+	static void end(const char *name, int64_t start);
+
+private:
+	static std::atomic<bool> s_enabled;
+};
+
+//! Scoped span of the Tracer; records the time between construction and destruction.
+/**
+ * @ingroup date-time
+ *
+ * Use #OGDF_TRACE_SCOPE rather than creating instances directly.
+ */
+class TraceScope {
+	const char *m_name; //!< The name of the span, or nullptr if tracing was disabled at construction.
+	int64_t m_start;    //!< The start time of the span.
+
+public:
+	explicit TraceScope(const char *name) : m_name(nullptr), m_start(0) {
+		if (Tracer::enabled()) {
+			m_name = name;
+			m_start = Tracer::begin();
+		}
+	}
+
+	~TraceScope() {
+		if (m_name != nullptr) {
+			Tracer::end(m_name, m_start);
+		}
+	}
+
+	TraceScope(const TraceScope &) = delete;
+	TraceScope &operator=(const TraceScope &) = delete;
+};
+
+}
+
+#define OGDF_TRACE_CONCAT_IMPL(a, b) a##b
+#define OGDF_TRACE_CONCAT(a, b) OGDF_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef OGDF_TRACING
+//! Records the enclosing scope as a span named \p name (a string literal) in the ogdf::Tracer.
+//! @ingroup macros
+#define OGDF_TRACE_SCOPE(name) ::ogdf::TraceScope OGDF_TRACE_CONCAT(ogdfTraceScope_, __LINE__)(name)
+#else
+#define OGDF_TRACE_SCOPE(name) ((void) 0)
+#endif
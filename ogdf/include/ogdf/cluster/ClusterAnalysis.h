@@ -40,8 +40,6 @@
 #pragma once
 
 #include <ogdf/cluster/ClusterGraph.h>
-#include <ogdf/basic/Skiplist.h>
-#include <ogdf/basic/HashArray.h>
 
 namespace ogdf {
 
@@ -108,6 +106,7 @@ public:
 	List<node>& oaNodes(cluster c);
 
 	//! Returns bag index number for a vertex \p v in cluster \p c.
+	//! A value of -1 (DefaultIndex) indicates that \p v is not a member of \p c.
 	int bagIndex(node v, cluster c);
 
 	//! Returns number of bags for cluster \p c.
@@ -141,26 +140,44 @@ protected:
 	void computeIndyBags();
 
 private:
-	//! Runs through a list of vertices (starting with the one \p nodeIT points to)
-	//! which is expected to be a full list of cluster vertices in \p c. Depending on
-	//! outer activity and bag index number of the vertices, independent bags
-	//! are detected and a corresponding index is assigned accordingly for each vertex.
-	//! If omitChildBags is set to true, already processed vertices are skipped.
-	void partitionCluster(ListConstIterator<node> & nodeIt, cluster c,
-			HashArray<int, List<node> > & bagNodes, HashArray<int, bool> & indyBag,
-			Skiplist<int*> &indexNumbers, Array<cluster> & bagRoots);
 	void init(); //!< Initialize the structures, performs analyses.
 	void cleanUp(); //!< Deletes dynamically allocated structures.
+
+	//! Returns true iff vertex \p v lies in cluster \p c or one of its descendants.
+	bool contains(node v, cluster c) const {
+		int p = m_clusterPre[c->index()];
+		int q = m_clusterPre[m_C->clusterOf(v)->index()];
+		return p <= q && q < m_preEnd[p];
+	}
+
+	//! Returns the position of the entry of \p v for its ancestor \p c in the per-level arrays.
+	int slot(node v, cluster c) const {
+		return m_slot[v] + m_clusterLevel[c->index()];
+	}
+
 	const ClusterGraph* m_C;
-	// we keep data structures to save inner/outer activity status
-	// instead of computing them on the fly when needed
-	// keep number of activity defining adjacent edges
-	NodeArray< ClusterArray<int> *> m_iactive;
-	NodeArray< ClusterArray<int> *> m_oactive;
-
-	//! We store the bag affiliation of the vertices for each cluster.
-	//! A value of -1 indicates that the vertex is not a member of the cluster.
-	NodeArray< ClusterArray<int> *> m_bagindex;
+
+	//! @name Flat representation of the cluster tree
+	//! Clusters are numbered in preorder, so that the vertices of each cluster
+	//! subtree form a contiguous range of #m_preNodes.
+	//! @{
+	Array<int> m_clusterPre;      //!< Preorder number of each cluster, indexed by cluster index.
+	Array<int> m_clusterLevel;    //!< Depth of each cluster (0 for the root), indexed by cluster index.
+	Array<cluster> m_preCluster;  //!< The clusters in preorder.
+	Array<int> m_preEnd;          //!< One past the largest preorder number in the subtree.
+	Array<node> m_preNodes;       //!< The vertices sorted by the preorder number of their cluster.
+	Array<int> m_preNodeStart;    //!< Start of the vertices of each cluster in #m_preNodes.
+	//! @}
+
+	// We do not keep per cluster activity status for the vertices: v is
+	// outer active for c iff c contains v and c lies at least at level
+	// m_oalevel[v], and inner active iff c contains a neighbor of v but not v.
+	// Bag affiliation is stored once per ancestor level of each vertex,
+	// starting at m_slot[v].
+	NodeArray<int> m_slot;
+
+	//! We store the bag affiliation of the vertices for each cluster containing them.
+	Array<int> m_bagindex;
 
 	NodeArray<int> m_ialevel;
 	NodeArray<int> m_oalevel;
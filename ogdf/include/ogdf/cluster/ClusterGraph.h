@@ -572,20 +572,34 @@ public:
 	 * \pre \p v and \p w are nodes in the graph.
 	 */
 	cluster commonCluster(node v, node w) const {
-		cluster c1, c2;
-		return commonClusterLastAncestors(v, w, c1, c2);
+		return commonCluster(clusterOf(v), clusterOf(w));
+	}
+
+	//! Returns the lowest common ancestor of clusters \p c and \p d in the cluster tree.
+	/**
+	 * The first query after a change of the cluster tree builds an index in time O(C log C),
+	 * every following query takes constant time. Reassigning nodes keeps the index valid.
+	 */
+	cluster commonCluster(cluster c, cluster d) const;
+
+	//! Returns true iff \p c is \p ancestor or lies in the cluster subtree rooted at \p ancestor.
+	bool isDescendant(cluster c, cluster ancestor) const {
+		buildTreeIndex();
+		int p = m_preIndex[ancestor->index()];
+		int q = m_preIndex[c->index()];
+		return p <= q && q < m_preEnd[p];
 	}
 
 	//! Returns the lowest common cluster lca and the highest ancestors on the path to lca.
+	/**
+	 * \p c1 (\p c2) is the child of lca containing \p v (\p w), or nullptr if \p v (\p w)
+	 * lies directly in lca. If \p v and \p w lie in the same cluster, both are set to this cluster.
+	 */
 	cluster commonClusterLastAncestors(
 		node v,
 		node w,
 		cluster& c1,
-		cluster& c2) const
-	{
-		List<cluster> eL;
-		return commonClusterAncestorsPath(v, w, c1, c2, eL);
-	}
+		cluster& c2) const;
 
 	//! Returns lca of \p v and \p w and stores corresponding path in \p eL.
 	/**
@@ -741,10 +755,19 @@ public:
 	//@}
 
 protected:
-	mutable ClusterArray<int>* m_lcaSearch; //!< Used to save last search run number for commoncluster.
-	mutable int m_lcaNumber;//!< Used to save last search run number for commoncluster.
-	mutable ClusterArray<cluster>* m_vAncestor;//!< Used to save last search run number for commoncluster.
-	mutable ClusterArray<cluster>* m_wAncestor;//!< Used to save last search run number for commoncluster.
+	//! @name Cluster tree index
+	//! Flat preorder representation of the cluster tree, built on demand by buildTreeIndex().
+	//! @{
+	mutable bool m_treeIndexValid;   //!< True iff the index represents the current cluster tree.
+	mutable Array<int> m_preIndex;   //!< Preorder number of each cluster, indexed by cluster index.
+	mutable Array<cluster> m_preCluster; //!< The clusters in preorder.
+	mutable Array<int> m_preDepth;   //!< Depth of the cluster with a given preorder number (0 for the root).
+	mutable Array<int> m_preParent;  //!< Preorder number of the parent (-1 for the root).
+	mutable Array<int> m_preEnd;     //!< One past the largest preorder number in the subtree.
+	mutable Array<int> m_childStart; //!< Start of the children of each cluster in #m_childPre.
+	mutable Array<int> m_childPre;   //!< Preorder numbers of all children, grouped by parent and ascending.
+	mutable Array<int> m_lcaTable;   //!< Sparse table of depth minima over preorder ranges of length 2^k.
+	//! @}
 
 	mutable bool m_updateDepth; //!< Depth of clusters is always updated if set to true.
 	mutable bool m_depthUpToDate; //!< Status of cluster depth information.
@@ -763,8 +786,15 @@ protected:
 	//! Clears all cluster data.
 	void doClear();
 
-	//! Copies lowest common ancestor info to copy of clustered graph.
-	void copyLCA(const ClusterGraph &C);
+	//! Builds the cluster tree index unless it is up to date.
+	void buildTreeIndex() const {
+		if (!m_treeIndexValid) {
+			doBuildTreeIndex();
+		}
+	}
+
+	//! Rebuilds the cluster tree index in time O(C log C).
+	void doBuildTreeIndex() const;
 	//int m_treeDepth; //should be implemented and updated in operations?
 
 	//! Adjusts the post order structure for moved clusters.
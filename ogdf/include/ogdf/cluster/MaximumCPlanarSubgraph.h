@@ -74,6 +74,7 @@ public:
 	                           m_numAddVariables(15),
 	                           m_strongConstraintViolation(0.3),
 	                           m_strongVariableViolation(0.3),
+	                           m_numThreads(1),
 	                           m_totalTime(-1.0),
 	                           m_heurTime(-1.0),
 	                           m_lpTime(-1.0),
@@ -144,6 +145,8 @@ public:
 	void setNumAddVariables(int n) { m_numAddVariables = n;}
 	void setStrongConstraintViolation(double d) { m_strongConstraintViolation=d;}
 	void setStrongVariableViolation(double d) { m_strongVariableViolation=d;}
+	//! Sets the number of threads processing branch-and-cut subproblems concurrently.
+	void setNumberOfThreads(int n) { m_numThreads = n; }
 	//! Use default abacus master cut pool or dedicated connectivity and
 	//! kuratowski cut pools
 	bool & useDefaultCutPool() {return m_defaultCutPool;}
@@ -223,6 +226,7 @@ private:
 	int m_numAddVariables;
 	double m_strongConstraintViolation;
 	double m_strongVariableViolation;
+	int m_numThreads; //!< The number of threads used by abacus
 
 	const char* getPortaFileName()
 	{
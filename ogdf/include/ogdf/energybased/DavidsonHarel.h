@@ -65,6 +65,19 @@ public:
 	//! Calls the Davidson-Harel method for graph \p GA.
 	void call(GraphAttributes &GA);
 
+	//! Returns the maximal number of threads used for evaluating candidates.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used for evaluating candidates to \p n.
+	/**
+	 * If all energy functions support concurrent candidates, several candidate
+	 * positions are evaluated concurrently for the current layout and the first
+	 * accepted candidate is taken. The later candidates of such a batch are
+	 * discarded and do not count as iterations, so the annealing schedule is
+	 * the same as with a single thread.
+	 */
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
 private:
 	//! The default starting temperature.
 	const static int m_defaultTemp;
@@ -82,11 +95,12 @@ private:
 	double m_diskRadius;        //!< The radius of the disk around the old position of a vertex where the new position will be.
 	double m_energy;            //!< The current energy of the system.
 	int m_numberOfIterations;   //!< The number of iterations per temperature step.
+	unsigned int m_maxThreads;  //!< The maximal number of threads.
 
 	List<EnergyFunction*> m_energyFunctions; //!< The list of the energy functions.
 	List<double> m_weightsOfEnergyFunctions; //!< The list of the weights for the energy functions.
 
-	List<node> m_nonIsolatedNodes; //!< The list of nodes with degree greater 0.
+	Array<node> m_nonIsolatedNodes; //!< The nodes with degree greater 0.
 
 	//! Resets the parameters for subsequent runs.
 	void initParameters();
@@ -94,6 +108,15 @@ private:
 	//! Randomly computes a node and a new position for that node.
 	node computeCandidateLayout(const GraphAttributes &, DPoint &) const;
 
+	//! Computes the energy if \p v is moved to \p newPos and stores the candidate in all energy functions.
+	double computeCandidateEnergy(node v, const DPoint &newPos);
+
+	//! Moves \p v to \p newPos after computeCandidateEnergy() for it.
+	void takeCandidate(GraphAttributes &AG, node v, const DPoint &newPos, double newEnergy);
+
+	//! Performs the iterations of one temperature step with candidates evaluated by \p numberOfThreads threads.
+	void concurrentIterations(GraphAttributes &AG, unsigned int numberOfThreads);
+
 	//! Tests if new energy value satisfies annealing property (only better if m_fineTune).
 	bool testEnergyValue(double newVal);
 
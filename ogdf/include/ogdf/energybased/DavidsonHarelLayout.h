@@ -63,6 +63,9 @@ public:
 	//! Calls the layout algorithm for graph attributes \p GA.
 	virtual void call(GraphAttributes &GA) override;
 
+	//! Predicts memory and running time of call() for \p GA, see LayoutModule::estimateCost().
+	virtual LayoutCostEstimate estimateCost(const GraphAttributes &GA) const override;
+
 	//! Fixes the cost values to special configurations.
 	void fixSettings(SettingsParameter sp);
 
@@ -123,6 +126,12 @@ public:
 	//! (*number of nodes of graph)
 	void setIterationNumberAsFactor(bool b) {m_itAsFactor = b;}
 
+	//! Returns the maximal number of threads used for evaluating candidates.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used for evaluating candidates to \p n, see DavidsonHarel::maxThreads().
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
 private:
 	double m_repulsionWeight;   //!< The weight for repulsion energy.
 	double m_attractionWeight;  //!< The weight for attraction energy.
@@ -135,6 +144,7 @@ private:
 	double m_prefEdgeLength;    //!< Preferred edge length (abs value), only used if > 0
 	bool m_crossings;           //!< Should crossings be computed?
 	bool m_itAsFactor;          //!< Should m_numberOfIterations be factor (true) or fixed number
+	unsigned int m_maxThreads;  //!< The maximal number of threads.
 };
 
 }
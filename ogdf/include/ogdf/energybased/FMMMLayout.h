@@ -37,6 +37,7 @@
 #include <ogdf/basic/geometry.h>
 #include <ogdf/energybased/fmmm/NewMultipoleMethod.h>
 #include <ogdf/energybased/fmmm/maar_packing/Rectangle.h>
+#include <ogdf/energybased/LayoutHierarchy.h>
 
 namespace ogdf {
 
@@ -96,6 +97,9 @@ namespace ogdf {
  *     <td><i>randSeed</i><td>int<td>100
  *     <td>The seed of the random number generator.
  *   </tr><tr>
+ *     <td><i>maxThreads</i><td>unsigned int<td>number of processors
+ *     <td>The maximal number of threads used for the force calculation.
+ *   </tr><tr>
  *     <td><i>edgeLengthMeasurement</i><td> FMMMOptions::EdgeLengthMeasurement <td> \c BoundingCircle
  *     <td>Indicates how the length of an edge is measured.
  *   </tr><tr>
@@ -251,6 +255,9 @@ public:
 	//! Calls the algorithm for graph \p GA and returns the layout information in \p GA.
 	virtual void call(GraphAttributes &GA) override;
 
+	//! Predicts memory and running time of call() for \p GA, see LayoutModule::estimateCost().
+	virtual LayoutCostEstimate estimateCost(const GraphAttributes &GA) const override;
+
 	//! Calls the algorithm for clustered graph \p GA and returns the layout information in \p GA.
 	//! Models cluster by simple edge length adaption based on least common ancestor
 	//! cluster of end vertices.
@@ -295,6 +302,9 @@ public:
 		return time_total;
 	}
 
+	//! Returns the multilevel hierarchy of the last call if retainHierarchy() is set.
+	const LayoutHierarchy &hierarchy() const { return m_hierarchy; }
+
 
 	/** @}
 	 *  @name High-level options
@@ -359,6 +369,17 @@ public:
 	//! Returns the seed of the random number generator.
 	int randSeed() const {return m_randSeed;}
 
+	//! Sets the maximal number of threads used for the force calculation to \p n.
+	/**
+	 * Levels with few nodes are always processed by a single thread. Since
+	 * per-thread forces are summed in a different order, drawings computed
+	 * with different numbers of threads may differ slightly.
+	 */
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
+	//! Returns the maximal number of threads used for the force calculation.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
 	//! Returns the current setting of option edgeLengthMeasurement.
 	FMMMOptions::EdgeLengthMeasurement edgeLengthMeasurement() const {
 		return m_edgeLengthMeasurement;
@@ -490,6 +511,16 @@ public:
 		m_initialPlacementMult = ipm;
 	}
 
+	//! Returns the current setting of option retainHierarchy.
+	/**
+	 * If set to true, the galaxies collapsed in the multilevel step are kept
+	 * and exported as hierarchy() after the layout is computed.
+	 */
+	bool retainHierarchy() const { return m_retainHierarchy; }
+
+	//! Sets the option retainHierarchy to \p b.
+	void retainHierarchy(bool b) { m_retainHierarchy = b; }
+
 
 	/** @}
 	 *  @name Options for the force calculation step
@@ -712,6 +743,7 @@ private:
 	//low level options
 	//general options
 	int                   m_randSeed; //!< The random seed.
+	unsigned int          m_maxThreads; //!< The maximal number of threads.
 	FMMMOptions::EdgeLengthMeasurement m_edgeLengthMeasurement; //!< The option for edge length measurement.
 	FMMMOptions::AllowedPositions m_allowedPositions; //!< The option for allowed positions.
 	int                   m_maxIntPosExponent; //!< The option for the used	exponent.
@@ -728,6 +760,7 @@ private:
 	int                   m_minGraphSize; //!< The option for minimal graph size.
 	FMMMOptions::GalaxyChoice m_galaxyChoice; //!< The selection of galaxy nodes.
 	int                   m_randomTries; //!< The number of random tries.
+	bool                  m_retainHierarchy; //!< The option for exporting the multilevel hierarchy.
 
 	//! The option for how to change MaxIterations.
 	//! If maxIterChange != micConstant, the iterations are decreased
@@ -776,6 +809,10 @@ private:
 	DPoint down_left_corner; //!< Holds down left corner of the comput. box.
 	NodeArray<double> radius; //!< Holds the radius of the surrounding circle for each node.
 	double time_total; //!< The runtime (=CPU-time) of the algorithm in seconds.
+	LayoutHierarchy m_hierarchy; //!< The multilevel hierarchy of the last call.
+	Array<node> m_levelNodes; //!< The nodes of the current level, for splitting them among threads.
+	Array<edge> m_levelEdges; //!< The edges of the current level, for splitting them among threads.
+	unsigned int m_levelThreads; //!< The number of threads used for the current level.
 
 	energybased::fmmm::FruchtermanReingold FR; //!< Class for repulsive force calculation (Fruchterman, Reingold).
 	energybased::fmmm::NewMultipoleMethod NM; //!< Class for repulsive force calculation.
@@ -795,6 +832,12 @@ private:
 		NodeArray<NodeAttributes>& A,
 		EdgeArray<EdgeAttributes>& E);
 
+	//! Adds the levels \p G_mult_ptr[0..\p max_level] of a connected subgraph to the hierarchy.
+	void add_levels_to_hierarchy(
+		Array<Graph*> &G_mult_ptr,
+		Array<NodeArray<NodeAttributes>*> &A_mult_ptr,
+		int max_level);
+
 	//! Returns true iff stopCriterion() is not met
 	bool running(int iter, int max_mult_iter, double actforcevectorlength);
 
@@ -1080,6 +1123,9 @@ private:
 			NM.deallocate_memory();
 	}
 
+	//! Collects the nodes and edges of the current level and decides how many threads work on it.
+	void init_level_threads(const Graph& G);
+
 	//! Calculates attractive forces for each node.
 	void calculate_attractive_forces(
 		Graph& G,
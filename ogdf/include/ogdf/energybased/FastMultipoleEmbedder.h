@@ -36,6 +36,7 @@
 #include <ogdf/energybased/fast_multipole_embedder/FMEThread.h>
 #include <ogdf/energybased/fast_multipole_embedder/FMEFunc.h>
 #include <ogdf/energybased/fast_multipole_embedder/GalaxyMultilevel.h>
+#include <ogdf/energybased/LayoutHierarchy.h>
 
 namespace ogdf {
 
@@ -72,6 +73,9 @@ public:
 	//! Calls the algorithm for graph \p GA and returns the layout information in \p GA.
 	virtual void call(GraphAttributes &GA) override;
 
+	//! Predicts memory and running time of call() for \p GA, see LayoutModule::estimateCost().
+	virtual LayoutCostEstimate estimateCost(const GraphAttributes &GA) const override;
+
 	//! sets the maximum number of iterations
 	void setNumIterations(uint32_t numIterations) { m_numIterations = numIterations; }
 
@@ -147,7 +151,7 @@ class OGDF_EXPORT FastMultipoleMultilevelEmbedder : public LayoutModule
 
 public:
 	//! Constructor, just sets number of maximum threads
-	FastMultipoleMultilevelEmbedder() : m_iMaxNumThreads(1) {}
+	FastMultipoleMultilevelEmbedder() : m_iMaxNumThreads(1), m_retainHierarchy(false) {}
 	//! Calls the algorithm for graph \p GA and returns the layout information in \p GA.
 	void call(GraphAttributes &GA) override;
 
@@ -155,6 +159,15 @@ public:
 	void multilevelUntilNumNodesAreLess(int nodesBound) { m_multiLevelNumNodesBound = nodesBound; }
 
 	void maxNumThreads(int numThreads) { m_iMaxNumThreads = numThreads; }
+
+	//! if set to true, the galaxy hierarchy is kept and exported as hierarchy() after each call
+	void retainHierarchy(bool b) { m_retainHierarchy = b; }
+
+	//! returns whether the galaxy hierarchy is kept
+	bool retainHierarchy() const { return m_retainHierarchy; }
+
+	//! returns the galaxy hierarchy of the last call if retainHierarchy() is set
+	const LayoutHierarchy &hierarchy() const { return m_hierarchy; }
 private:
 	//! internal function to compute a good edgelength
 	void computeAutoEdgeLength(const GraphAttributes& GA, EdgeArray<float>& edgeLength, float factor = 1.0f);
@@ -186,6 +199,9 @@ private:
 	//! clean up the multilevel graphs
 	void deleteMultiLevelGraphs();
 
+	//! records the parents of all multilevels in the hierarchy
+	void addLevelsToHierarchy(const NodeArray<int>& index);
+
 	//! for debugging only
 	void dumpCurrentLevel(const char *filename);
 
@@ -195,6 +211,8 @@ private:
 	int				  m_iMaxNumThreads;
 	int				  m_iNumLevels;
 	int				  m_multiLevelNumNodesBound;
+	bool			  m_retainHierarchy;
+	LayoutHierarchy	  m_hierarchy;
 
 	GalaxyMultilevel* m_pCurrentLevel;
 	GalaxyMultilevel* m_pFinestLevel;
@@ -0,0 +1,213 @@
+/** \file
+ * \brief Declaration of class FastMultipoleRelayoutSession
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/basic/GraphObserver.h>
+
+#include <vector>
+
+namespace ogdf {
+
+namespace fast_multipole_embedder {
+class ArrayGraph;
+class FMEThreadPool;
+struct FMEGlobalOptions;
+struct FMEGlobalContext;
+}
+
+//! Keeps a force-directed drawing up to date while its graph is edited.
+/**
+ * @ingroup gd-energy
+ *
+ * A session belongs to one GraphAttributes instance and observes its graph.
+ * It keeps the data structures of the fast multipole embedder (the array
+ * graph, the quadtree and the thread pool) alive between edits, so that a
+ * small edit does not pay for a full layout. After the caller moved nodes
+ * (and reported them with nodeChanged()) or edited the graph, update()
+ * refines the drawing:
+ *
+ * - Usually only the nodes within neighborhoodRadius() edges of the changed
+ *   nodes move. Their repulsive forces are computed exactly against all other
+ *   nodes, i.e., an iteration takes O(kn) time for k moving nodes. If the
+ *   neighborhood is too large for that, the fast multipole embedder iterates
+ *   while all other nodes stay fixed.
+ * - Every globalPassInterval()-th update instead runs the fast multipole
+ *   embedder on the whole graph, starting from the current drawing.
+ *
+ * Pinned nodes never move, neither in local nor in global passes, and their
+ * coordinates are not touched at all. Changed nodes move as well unless they
+ * are pinned; pin a node to keep it where the user dropped it.
+ *
+ * Nodes added to the graph are placed at the barycenter of their neighbors
+ * that existed before, if there are any. The data structures are only
+ * rebuilt if the graph changed, moving nodes reuses them.
+ *
+ * <H3>Optional parameters</H3>
+ *
+ * <table>
+ *   <tr>
+ *     <th><i>Option</i><th><i>Type</i><th><i>Default</i><th><i>Description</i>
+ *   </tr><tr>
+ *     <td><i>numIterations</i><td>int<td>100
+ *     <td>The maximal number of iterations of a global pass.
+ *   </tr><tr>
+ *     <td><i>localIterations</i><td>int<td>30
+ *     <td>The maximal number of iterations of a local pass.
+ *   </tr><tr>
+ *     <td><i>neighborhoodRadius</i><td>int<td>2
+ *     <td>The graph distance up to which nodes around changed nodes move in a local pass.
+ *   </tr><tr>
+ *     <td><i>globalPassInterval</i><td>int<td>10
+ *     <td>Every this many updates, a global pass is run; 0 disables global passes in update().
+ *   </tr><tr>
+ *     <td><i>numberOfThreads</i><td>int<td>1
+ *     <td>The maximal number of threads of global passes.
+ *   </tr>
+ * </table>
+ */
+class OGDF_EXPORT FastMultipoleRelayoutSession : public GraphObserver
+{
+public:
+	//! Creates a session for the drawing \p GA and its graph.
+	explicit FastMultipoleRelayoutSession(GraphAttributes &GA);
+
+	~FastMultipoleRelayoutSession();
+
+	//! Lays out the whole graph, starting from the current drawing.
+	void layout();
+
+	//! Refines the drawing after edits, see the class description.
+	void update();
+
+	//! Marks \p v as changed, e.g., after the caller moved it.
+	void nodeChanged(node v);
+
+	//! Pins \p v to its current position if \p pinned is set, releases it otherwise.
+	void pin(node v, bool pinned = true) { m_pinned[v] = pinned; }
+
+	//! Returns whether \p v is pinned.
+	bool isPinned(node v) const { return m_pinned[v]; }
+
+	//! Returns the number of calls of update().
+	int numberOfUpdates() const { return m_numUpdates; }
+
+	//! Returns whether the last call of update() was a global pass.
+	bool lastUpdateWasGlobal() const { return m_lastUpdateWasGlobal; }
+
+	//! Returns the maximal number of iterations of a global pass.
+	int numIterations() const { return m_numIterations; }
+
+	//! Sets the maximal number of iterations of a global pass to \p n.
+	void numIterations(int n) { m_numIterations = n; }
+
+	//! Returns the maximal number of iterations of a local pass.
+	int localIterations() const { return m_localIterations; }
+
+	//! Sets the maximal number of iterations of a local pass to \p n.
+	void localIterations(int n) { m_localIterations = n; }
+
+	//! Returns the graph distance up to which nodes around changed nodes move in a local pass.
+	int neighborhoodRadius() const { return m_neighborhoodRadius; }
+
+	//! Sets the graph distance up to which nodes around changed nodes move in a local pass to \p r.
+	void neighborhoodRadius(int r) { m_neighborhoodRadius = r; }
+
+	//! Returns after how many updates a global pass is run.
+	int globalPassInterval() const { return m_globalPassInterval; }
+
+	//! Sets after how many updates a global pass is run to \p k, 0 disables global passes in update().
+	void globalPassInterval(int k) { m_globalPassInterval = k; }
+
+	//! Returns the maximal number of threads of global passes.
+	unsigned int numberOfThreads() const { return m_numberOfThreads; }
+
+	//! Sets the maximal number of threads of global passes to \p n.
+	void numberOfThreads(unsigned int n) { m_numberOfThreads = n; m_structureChanged = true; }
+
+protected:
+	void nodeDeleted(node) override { m_structureChanged = true; }
+	void nodeAdded(node v) override;
+	void edgeDeleted(edge e) override;
+	void edgeAdded(edge e) override;
+	void reInit() override { m_structureChanged = true; }
+	void cleared() override { m_structureChanged = true; }
+
+private:
+	using ArrayGraph = fast_multipole_embedder::ArrayGraph;
+	using FMEThreadPool = fast_multipole_embedder::FMEThreadPool;
+	using FMEGlobalOptions = fast_multipole_embedder::FMEGlobalOptions;
+	using FMEGlobalContext = fast_multipole_embedder::FMEGlobalContext;
+
+	GraphAttributes &m_GA; //!< The drawing.
+
+	NodeArray<bool> m_pinned;  //!< Whether a node is pinned.
+	NodeArray<bool> m_changed; //!< Whether a node changed since the last update.
+	NodeArray<bool> m_added;   //!< Whether a node was added since the last update.
+	NodeArray<uint32_t> m_index; //!< The index of a node in the array graph.
+	bool m_structureChanged; //!< Whether the data structures have to be rebuilt.
+
+	ArrayGraph *m_pArrayGraph;
+	FMEGlobalOptions *m_pOptions;
+	FMEThreadPool *m_threadPool;
+	FMEGlobalContext *m_pGlobalContext; //!< The context of the multipole kernel, only for large graphs.
+
+	int m_numIterations;
+	int m_localIterations;
+	int m_neighborhoodRadius;
+	int m_globalPassInterval;
+	unsigned int m_numberOfThreads;
+
+	int m_numUpdates;
+	bool m_lastUpdateWasGlobal;
+
+	//! Places added nodes and brings the array graph up to date with the drawing.
+	void prepare();
+
+	//! Creates the array graph and the kernel data structures for the current graph.
+	void rebuild();
+
+	//! Frees the array graph and the kernel data structures.
+	void deallocate();
+
+	//! Runs the fast multipole embedder on all nodes whose move radius is positive.
+	void globalPass(int numIterations);
+
+	//! Iterates the nodes with the given indices, computing their forces exactly.
+	void localPass(const std::vector<uint32_t> &active);
+
+	//! Sets the move radius of each node, nodes not in \p active (if given) are fixed like pinned ones.
+	void setMoveRadii(const std::vector<bool> *active);
+
+	//! Writes the coordinates of all nodes that could move back to the drawing.
+	void writePositions();
+};
+
+}
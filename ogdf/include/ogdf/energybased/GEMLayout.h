@@ -155,6 +155,9 @@ public:
 	//! Calls the layout algorithm for graph attributes \p GA.
 	virtual void call(GraphAttributes &GA) override;
 
+	//! Predicts memory and running time of call() for \p GA, see LayoutModule::estimateCost().
+	virtual LayoutCostEstimate estimateCost(const GraphAttributes &GA) const override;
+
 	//! Returns the maximal number of rounds per node.
 	int numberOfRounds() const { return m_numberOfRounds; }
 
@@ -0,0 +1,123 @@
+/** \file
+ * \brief Declaration of class LayoutHierarchy
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/GraphAttributes.h>
+#include <vector>
+
+namespace ogdf {
+
+//! Coarsening hierarchy of a multilevel layout, exported for level-of-detail rendering.
+/**
+ * @ingroup gd-energy
+ *
+ * Multilevel layout algorithms compute a sequence of successively coarser
+ * graphs in which each node represents a set of nodes of the next finer
+ * level. If requested, FMMMLayout, FastMultipoleMultilevelEmbedder and
+ * ModularMultilevelMixer record this sequence in a LayoutHierarchy.
+ *
+ * Level 0 consists of the nodes of the input graph. All attributes of a level
+ * are stored in flat arrays indexed by the number of a node on that level, so
+ * they can be handed to a renderer without conversion. Positions and sizes of
+ * coarse nodes are aggregated from the final layout: a coarse node is placed at
+ * the barycenter of the input nodes it represents and covers the bounding box
+ * of its children. Parallel edges between coarse nodes are merged and their
+ * weights summed up.
+ */
+class OGDF_EXPORT LayoutHierarchy
+{
+public:
+	//! The nodes and edges of one level.
+	struct Level {
+		std::vector<int> parent;     //!< Number of the parent node on the next coarser level, -1 on the coarsest level.
+		std::vector<int> mass;       //!< Number of input nodes represented by each node.
+		std::vector<double> x;       //!< x-coordinates of the nodes.
+		std::vector<double> y;       //!< y-coordinates of the nodes.
+		std::vector<double> width;   //!< Widths of the nodes.
+		std::vector<double> height;  //!< Heights of the nodes.
+		std::vector<int> source;     //!< Source node of each edge.
+		std::vector<int> target;     //!< Target node of each edge.
+		std::vector<double> weight;  //!< Number of input edges represented by each edge.
+
+		//! Returns the number of nodes on this level.
+		int numberOfNodes() const { return static_cast<int>(parent.size()); }
+
+		//! Returns the number of edges on this level.
+		int numberOfEdges() const { return static_cast<int>(source.size()); }
+	};
+
+	//! Removes all levels.
+	void clear() { m_levels.clear(); }
+
+	//! Returns true iff no hierarchy has been recorded.
+	bool empty() const { return m_levels.empty(); }
+
+	//! Starts a new hierarchy whose finest level consists of \p n nodes.
+	void init(int n);
+
+	//! Returns the number of levels, level 0 being the finest.
+	int numberOfLevels() const { return static_cast<int>(m_levels.size()); }
+
+	//! Returns level \p i.
+	const Level &level(int i) const {
+		OGDF_ASSERT(0 <= i);
+		OGDF_ASSERT(i < numberOfLevels());
+		return m_levels[i];
+	}
+
+	/**
+	 * \brief Adds a node to level \p i and returns its number.
+	 *
+	 * \pre \p i is at most numberOfLevels(); if it is equal, a new coarsest
+	 * level is appended.
+	 */
+	int addNode(int i);
+
+	//! Makes node \p p of level \p i+1 the parent of node \p v of level \p i.
+	void setParent(int i, int v, int p) {
+		OGDF_ASSERT(i + 1 < numberOfLevels());
+		m_levels[i].parent[v] = p;
+	}
+
+	/**
+	 * \brief Computes positions, sizes and edges of all levels from the layout in \p GA.
+	 *
+	 * Nodes without a parent below the coarsest level are carried over to the
+	 * next coarser level unchanged, so every level covers the whole graph.
+	 * @param GA holds the final layout of the input graph.
+	 * @param index maps each node of the input graph to its number on level 0.
+	 */
+	void aggregate(const GraphAttributes &GA, const NodeArray<int> &index);
+
+private:
+	std::vector<Level> m_levels;
+};
+
+}
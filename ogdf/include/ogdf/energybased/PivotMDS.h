@@ -53,17 +53,33 @@ inline bool isinf(T value)
 //! The Pivot MDS (multi-dimensional scaling) layout algorithm.
 /**
  * @ingroup gd-energy
+ *
+ * The distances of all nodes to the pivots are stored in a contiguous
+ * row-major matrix with one row per pivot. The pivots are chosen one after
+ * the other by the maxmin strategy; the breadth-first searches from the
+ * pivots, the centering of the matrix, and the products with it are split
+ * among up to maxThreads() threads. The layout does not depend on the number
+ * of threads.
+ *
+ * If the GraphAttributes of the layout have GraphAttributes::threeD set, a
+ * three-dimensional layout is computed unless setForcing2DLayout() is set.
  */
 class OGDF_EXPORT PivotMDS : public LayoutModule {
 public:
-	PivotMDS() : m_numberOfPivots(250), m_edgeCosts(100), m_hasEdgeCostsAttribute(false) { }
+	PivotMDS()
+		: m_numberOfPivots(250)
+		, m_dimensionCount(2)
+		, m_edgeCosts(100)
+		, m_hasEdgeCostsAttribute(false)
+		, m_forcing2DLayout(false)
+		, m_maxThreads(1) { }
 
 	virtual ~PivotMDS() { }
 
-	//! Sets the number of pivots. If the new value is smaller or equal 0
-	//! the default value (250) is used.
+	//! Sets the number of pivots. If the new value is smaller than 2,
+	//! 2 pivots are used.
 	void setNumberOfPivots(int numberOfPivots) {
-		m_numberOfPivots = (numberOfPivots < DIMENSION_COUNT) ? DIMENSION_COUNT : numberOfPivots;
+		m_numberOfPivots = (numberOfPivots < MIN_DIMENSION_COUNT) ? MIN_DIMENSION_COUNT : numberOfPivots;
 	}
 
 	//! Sets the desired distance between adjacent nodes. If the new value is smaller or equal
@@ -72,6 +88,22 @@ public:
 		m_edgeCosts = edgeCosts;
 	}
 
+	//! Sets whether a 2D layout is computed even if GraphAttributes::threeD is set.
+	void setForcing2DLayout(bool forcing2DLayout) {
+		m_forcing2DLayout = forcing2DLayout;
+	}
+
+	//! Returns whether a 2D layout is computed even if GraphAttributes::threeD is set.
+	bool isForcing2DLayout() const {
+		return m_forcing2DLayout;
+	}
+
+	//! Returns the maximal number of threads used.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used to \p n.
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
 	//! Calls the layout algorithm for graph attributes \p GA.
 	virtual void call(GraphAttributes& GA) override;
 
@@ -86,14 +118,15 @@ public:
 
 private:
 
-	//! The dimension count determines the number of evecs that
-	//! will be computed. Nevertheless PivotMDS only takes the first two
-	//! with the highest eigenwert into account.
-	const static int DIMENSION_COUNT = 2;
+	//! The dimension count of 2D layouts; it is also the minimal number of pivots.
+	const static int MIN_DIMENSION_COUNT = 2;
 
 	//! Convergence factor used for power iteration.
 	const static double EPSILON;
 
+	//! Relative size below which eigenvalues are considered to be zero.
+	const static double RANK_EPSILON;
+
 	//! Factor used to center the pivot matrix.
 	const static double FACTOR;
 
@@ -103,6 +136,10 @@ private:
 	//! The number of pivots.
 	int m_numberOfPivots;
 
+	//! The number of dimensions of the current layout, i.e., the number
+	//! of eigenvectors that are computed.
+	int m_dimensionCount;
+
 	//! The costs to traverse an edge.
 	double m_edgeCosts;
 
@@ -110,25 +147,33 @@ private:
 	//! edge costs attribute
 	bool m_hasEdgeCostsAttribute;
 
-	//! Centers the pivot matrix.
-	void centerPivotmatrix(Array<Array<double> >& pivotMatrix);
+	//! Tells whether a 2D layout is computed for 3D graph attributes.
+	bool m_forcing2DLayout;
+
+	//! The maximal number of threads.
+	unsigned int m_maxThreads;
+
+	//! Centers the \p numberOfPivots times n pivot matrix.
+	void centerPivotmatrix(Array<double>& pivotMatrix, int numberOfPivots);
 
 	//! Computes the pivot mds layout of the given connected graph of \p GA.
 	void pivotMDSLayout(GraphAttributes& GA);
 
-	void copySPSS(Array<double>& copyTo, NodeArray<double>& copyFrom);
-
 	//! Computes the layout of a path.
 	void doPathLayout(GraphAttributes& GA, const node& v);
 
-	//! Computes the eigen value decomposition based on power iteration.
+	//! Computes the eigen value decomposition of the \a p times \a p matrix \p K based on power iteration.
 	void eigenValueDecomposition(
-		Array<Array<double> >& K,
+		const Array<double>& K,
 		Array<Array<double> >& eVecs,
 		Array<double>& eValues);
 
-	//! Computes the pivot distance matrix based on the maxmin strategy
-	void getPivotDistanceMatrix(const GraphAttributes& GA, Array<Array<double> >& pivDistMatrix);
+	//! Computes the pivot distance matrix based on the maxmin strategy.
+	/**
+	 * Row \a i of the row-major matrix \p pivDistMatrix holds the distances of
+	 * all nodes (in the order of the node list) to the \a i-th pivot.
+	 */
+	void getPivotDistanceMatrix(const GraphAttributes& GA, Array<double>& pivDistMatrix, int numberOfPivots);
 
 	//! Checks whether the given graph is a path or not.
 	node getRootedPath(const Graph& G);
@@ -142,12 +187,13 @@ private:
 	//! Fills the given \p matrix with random doubles d 0 <= d <= 1.
 	void randomize(Array<Array<double> >& matrix);
 
-	//! Computes the self product of \p d.
-	void selfProduct(const Array<Array<double> >&d, Array<Array<double> >& result);
+	//! Computes the self product \a DD^T of the \p numberOfPivots times n matrix \p d.
+	void selfProduct(const Array<double>& d, int numberOfPivots, Array<double>& result);
 
-	//! Computes the singular value decomposition of matrix \p K.
+	//! Computes the singular value decomposition of the \p numberOfPivots times n matrix \p pivDistMatrix.
 	void singularValueDecomposition(
-		Array<Array<double> >& K,
+		const Array<double>& pivDistMatrix,
+		int numberOfPivots,
 		Array<Array<double> >& eVecs,
 		Array<double>& eVals);
 };
@@ -33,7 +33,7 @@
 #pragma once
 
 #include <ogdf/module/LayoutModule.h>
-#include <ogdf/basic/Array2D.h>
+#include <ogdf/basic/Array.h>
 #include <ogdf/basic/tuples.h>
 #include <ogdf/basic/GraphCopyAttributes.h>
 
@@ -69,6 +69,10 @@ namespace ogdf {
  *   </tr><tr>
  *     <td><i>tolerance</i><td>int<td>0.0001
  *     <td>Tolerance for the energy level (below which the main loop stops).
+ *   </tr><tr>
+ *     <td><i>singlePrecisionMatrices</i><td>bool<td>false
+ *     <td>If set to true, the desired distances and spring strengths of all
+ *     node pairs are stored in single precision, halving the memory consumption.
  *   </tr>
  * </table>
  */
@@ -80,7 +84,7 @@ public:
 	//! Constructor: Constructs instance of Kamada Kawai Layout
 	SpringEmbedderKK() : m_tolerance(0.001), m_ltolerance(0.0001), m_computeMaxIt(true),
 		m_K(5.0), m_desLength(0.0), m_distFactor(2.0), m_useLayout(true),
-		m_gItBaseVal(50), m_gItFactor(16)
+		m_gItBaseVal(50), m_gItFactor(16), m_singlePrecisionMatrices(false)
 	{
 		m_maxLocalIt = m_maxGlobalIt = maxVal;
 	}
@@ -93,6 +97,9 @@ public:
 	//! distinction of BFS/APSS. Precondition: Graph is connected.
 	virtual void call(GraphAttributes& GA) override;
 
+	//! Predicts memory and running time of call() for \p GA, see LayoutModule::estimateCost().
+	virtual LayoutCostEstimate estimateCost(const GraphAttributes &GA) const override;
+
 	//! Calls the layout algorithm for graph attributes \p GA
 	//! using values in eLength for distance computation.
 	//! Precondition: Graph is connected.
@@ -104,17 +111,21 @@ public:
 
 	//! If set to true, the given layout is used for the initial positions
 	void setUseLayout(bool b) {m_useLayout = b;}
-	bool useLayout() {return m_useLayout;}
+	bool useLayout() const {return m_useLayout;}
 
 	//! If set != 0, value zerolength is used to determine the
 	//! desirable edge length by L = zerolength / max distance_ij.
 	//! Otherwise, zerolength is determined using the node number and sizes.
 	void setZeroLength(double d) {m_zeroLength = d;}
-	double zeroLength() {return m_zeroLength;}
+	double zeroLength() const {return m_zeroLength;}
 
 	//! Sets desirable edge length directly
 	void setDesLength(double d) {m_desLength = d;}
 
+	//! If set to true, the distance and strength matrices are stored in single precision.
+	void setSinglePrecisionMatrices(bool b) {m_singlePrecisionMatrices = b;}
+	bool singlePrecisionMatrices() const {return m_singlePrecisionMatrices;}
+
 
 	//! It is possible to limit the number of iterations to a fixed value
 	//! Returns the current setting of iterations.
@@ -211,30 +222,22 @@ protected:
 		EdgeArray<double>& adaptedLengths);
 	//! Adapts positions to avoid degeneracy (all nodes on a single point)
 	void shufflePositions(GraphAttributes& GA);
-	//! Computes contribution of node u to the first partial
-	//! derivatives (dE/dx_m, dE/dy_m) (for node m) (eq. 7 and 8 in paper)
-	dpair computeParDer(node m,
-		node u,
-		GraphAttributes& GA,
-		NodeArray< NodeArray<double> >& ss,
-		NodeArray< NodeArray<double> >& dist);
-	//! Compute partial derivative for v
-	dpair computeParDers(node v,
-		GraphAttributes& GA,
-		NodeArray< NodeArray<double> >& ss,
-		NodeArray< NodeArray<double> >& dist);
-	//! Does the necessary initialization work for the call functions
+	//! Does the necessary initialization work for the call functions.
+	/**
+	 * Fills the row-major matrices \p oLength and \p sstrength, whose rows
+	 * and columns correspond to the nodes in the order of GA.constGraph().nodes.
+	 */
+	template<typename T>
 	void initialize(GraphAttributes& GA,
-		NodeArray<dpair>& partialDer,
 		const EdgeArray<double>& eLength,
-		NodeArray< NodeArray<double> >& oLength,
-		NodeArray< NodeArray<double> >& sstrength,
+		Array<T>& oLength,
+		Array<T>& sstrength,
 		bool simpleBFS);
 	//! Main computation loop, nodes are moved here
+	template<typename T>
 	void mainStep(GraphAttributes& GA,
-		NodeArray<dpair>& partialDer,
-		NodeArray< NodeArray<double> >& oLength,
-		NodeArray< NodeArray<double> >& sstrength);
+		const Array<T>& oLength,
+		const Array<T>& sstrength);
 	//! Does the scaling if no edge lengths are given but node sizes
 	//! are respected
 	void scale(GraphAttributes& GA);
@@ -259,6 +262,7 @@ private:
 	bool m_useLayout; //!< use positions or allow to shuffle nodes to avoid degeneration
 	int m_gItBaseVal; //!< minimum number of global iterations
 	int m_gItFactor;  //!< factor for global iterations: m_gItBaseVal+m_gItFactor*|V|
+	bool m_singlePrecisionMatrices; //!< store the matrices as float instead of double
 
 	static const double startVal;
 	static const double minVal;
@@ -266,9 +270,16 @@ private:
 	//! Smaller values are treated as zero
 	static const int maxVal; //! defines infinite upper bound for iteration number
 
-	double allpairsspBFS(const Graph& G, NodeArray< NodeArray<double> >& distance);
-	double allpairssp(const Graph& G, const EdgeArray<double>& eLengths,
-		NodeArray< NodeArray<double> >& distance,	const double threshold = numeric_limits<double>::max());
+	//! Computes the graph theoretic distances of all node pairs by BFS, returns the maximum distance.
+	template<typename T>
+	double allpairsspBFS(const Graph& G, Array<T>& distance);
+	//! Computes the distances of all node pairs w.r.t. \p eLengths by Dijkstra's algorithm,
+	//! returns the maximum distance.
+	template<typename T>
+	double allpairssp(const Graph& G, const EdgeArray<double>& eLengths, Array<T>& distance);
+	//! Runs initialize(), mainStep() and scale() with matrices of type \p T.
+	template<typename T>
+	void layout(GraphAttributes& GA, const EdgeArray<double>& eLength, bool simpleBFS);
 };//SpringEmbedderKK
 
 #if 0
@@ -47,6 +47,13 @@ namespace ogdf {
 //! Energy-based layout using stress minimization.
 /**
  * @ingroup gd-energy
+ *
+ * The shortest path and weight matrices are stored as contiguous row-major
+ * arrays. Each iteration moves all nodes simultaneously (Jacobi-style) to the
+ * positions minimizing their localized stress majorants with respect to the
+ * previous layout. The rows are split among up to maxThreads() threads, and
+ * the stress of the previous layout is summed up in the same pass. The layout
+ * does not depend on the number of threads.
  */
 class OGDF_EXPORT StressMinimization: public LayoutModule {
 
@@ -72,6 +79,9 @@ public:
 	//! Calls the layout algorithm with uniform edge costs.
 	virtual void call(GraphAttributes& GA) override;
 
+	//! Predicts memory and running time of call() for \p GA, see LayoutModule::estimateCost().
+	virtual LayoutCostEstimate estimateCost(const GraphAttributes &GA) const override;
+
 	//! Tells whether the current layout should be used or the initial layout
 	//! needs to be computed.
 	inline void hasInitialLayout(bool hasInitialLayout);
@@ -103,8 +113,19 @@ public:
 	//! Tells whether the edge costs are uniform or defined by some edge costs attribute.
 	inline void useEdgeCostsAttribute(bool useEdgeCostsAttribute);
 
+	//! Returns the maximal number of threads used.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used to \p n.
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
 private:
 
+	//! Node coordinates in the order of the node list.
+	struct Coordinates {
+		Array<double> x, y, z;
+	};
+
 	//! Convergence constant.
 	const static double EPSILON;
 
@@ -143,58 +164,46 @@ private:
 	//! Indicates whether the z coordinates will be modified or not.
 	bool m_fixZCoords;
 
+	//! The maximal number of threads.
+	unsigned int m_maxThreads;
+
 	//! Calculates the stress for the given layout
-	double calcStress(const GraphAttributes& GA,
-			NodeArray<NodeArray<double> >& shortestPathMatrix,
-			NodeArray<NodeArray<double> >& weightMatrix);
+	double calcStress(const Coordinates& coords,
+			const Array<double>& shortestPathMatrix,
+			const Array<double>& weightMatrix);
 
-	//! Runs the stress for a given Graph, shortest path and weight matrix.
-	void call(GraphAttributes& GA,
-			NodeArray<NodeArray<double> >& shortestPathMatrix,
-			NodeArray<NodeArray<double> >& weightMatrix);
+	//! Runs the stress for a given Graph and row-major shortest path matrix.
+	void call(GraphAttributes& GA, Array<double>& shortestPathMatrix);
 
 	//! Calculates the weight matrix of the shortest path matrix. This is done by w_ij = s_ij^{-2}
-	void calcWeights(const Graph& G,
-			NodeArray<NodeArray<double> >& shortestPathMatrix,
-			NodeArray<NodeArray<double> >& weightMatrix);
+	void calcWeights(const Array<double>& shortestPathMatrix, Array<double>& weightMatrix);
 
 	//! Calculates the intial layout of the graph if necessary.
 	void computeInitialLayout(GraphAttributes& GA);
 
-	//! Convenience method copying the layout of the graph in case of epsilon convergence.
-	void copyLayout(const GraphAttributes& GA, NodeArray<double>& newX,
-			NodeArray<double>& newY);
-
-	//! Convenience method copying the layout of the graph in case of epsilon convergence for 3D.
-	void copyLayout(const GraphAttributes& GA, NodeArray<double>& newX,
-			NodeArray<double>& newY, NodeArray<double>& newZ);
+	//! Computes the row-major shortest path matrix of the graph of \p GA.
+	void computeShortestPaths(const GraphAttributes& GA, Array<double>& shortestPathMatrix);
 
 	//! Checks for epsilon convergence and whether the performed number of iterations
 	//! exceed the predefined maximum number of iterations.
-	bool finished(GraphAttributes& GA, int numberOfPerformedIterations,
-			NodeArray<double>& prevXCoords, NodeArray<double>& prevYCoords,
+	bool finished(int numberOfPerformedIterations,
+			const Coordinates& prevCoords, const Coordinates& curCoords,
 			const double prevStress, const double curStress);
 
-	//! Convenience method to initialize the matrices.
-	void initMatrices(const Graph& G,
-			NodeArray<NodeArray<double> >& shortestPathMatrix,
-			NodeArray<NodeArray<double> >& weightMatrix);
-
 	//! Minimizes the stress for each component separately given
 	//! the shortest path matrix and the weight matrix.
 	void minimizeStress(GraphAttributes& GA,
-			NodeArray<NodeArray<double> >& shortestPathMatrix,
-			NodeArray<NodeArray<double> >& weightMatrix);
+			const Array<double>& shortestPathMatrix,
+			const Array<double>& weightMatrix);
 
-	//! Runs the next iteration of the stress minimization process. Note that serial update
-	//! is used.
-	void nextIteration(GraphAttributes& GA,
-			NodeArray<NodeArray<double> >& shortestPathMatrix,
-			NodeArray<NodeArray<double> >& weightMatrix);
+	//! Computes the next layout \p next from \p cur and returns the stress of \p cur.
+	double nextIteration(const Coordinates& cur, Coordinates& next,
+			const Array<double>& shortestPathMatrix,
+			const Array<double>& weightMatrix,
+			bool threeD);
 
 	//! Replaces infinite distances to the given value
-	void replaceInfinityDistances(
-			NodeArray<NodeArray<double> >& shortestPathMatrix, double newVal);
+	void replaceInfinityDistances(Array<double>& shortestPathMatrix, double newVal);
 
 }
 ;
@@ -60,6 +60,21 @@ public:
 		const node v,
 		const DPoint &newPos);
 
+	//! Returns the energy for the layout where the given vertex is moved to the given position.
+	/**
+	 * In contrast to computeCandidateEnergy(), the candidate is not stored,
+	 * so it cannot be taken by candidateTaken(). Several candidates may be
+	 * evaluated concurrently.
+	 *
+	 * \pre supportsConcurrentCandidates() returns true.
+	 */
+	virtual double candidateEnergy(const node, const DPoint&) const {
+		OGDF_THROW(LibraryNotSupportedException);
+	}
+
+	//! Returns true iff candidateEnergy() is implemented.
+	virtual bool supportsConcurrentCandidates() const { return false; }
+
 	//! prints the name of the energy function
 	string getName() const { return m_name; }
 
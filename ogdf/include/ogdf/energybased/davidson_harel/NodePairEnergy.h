@@ -52,6 +52,11 @@ public:
 	//computes the energy of the initial layout
 	void computeEnergy() override;
 
+	//computes the energy of a candidate without storing the pair energies
+	double candidateEnergy(const node v, const DPoint &newPos) const override;
+
+	bool supportsConcurrentCandidates() const override { return true; }
+
 protected:
 	//! Computes the energy stored by a pair of vertices at the given positions.
 	virtual double computeCoordEnergy(node, node, const DPoint&, const DPoint&) const = 0;
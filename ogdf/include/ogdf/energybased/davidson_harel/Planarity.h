@@ -49,6 +49,11 @@ public:
 	//! Computes energy of initial layout and stores it in #m_energy.
 	void computeEnergy() override;
 
+	//! Computes energy of a candidate without storing the changed crossings.
+	double candidateEnergy(const node v, const DPoint &newPos) const override;
+
+	bool supportsConcurrentCandidates() const override { return true; }
+
 private:
 	struct ChangedCrossing {
 		int edgeNum1;
@@ -59,6 +64,10 @@ private:
 	//! Returns 1 if edges cross else 0.
 	bool intersect(const edge, const edge) const;
 
+	//! Calls \p visit for each pair of edges whose crossing changes if \p v is moved to \p newPos.
+	template<typename Visit>
+	void forChangedCrossings(const node v, const DPoint &newPos, Visit visit) const;
+
 	//! Computes energy of candidate.
 	void compCandEnergy() override;
 
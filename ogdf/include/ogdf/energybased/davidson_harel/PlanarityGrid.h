@@ -48,6 +48,9 @@ public:
 	~PlanarityGrid();
 	// computes energy of initial layout and stores it in m_energy
 	void computeEnergy() override;
+	// computes energy of a candidate without storing it
+	double candidateEnergy(const node v, const DPoint &newPos) const override;
+	bool supportsConcurrentCandidates() const override { return true; }
 private:
 	// computes energy of candidate
 	void compCandEnergy() override;
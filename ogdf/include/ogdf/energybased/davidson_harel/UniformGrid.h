@@ -60,17 +60,33 @@ public:
 
 	int numberOfCrossings() const {return m_crossNum;}
 
-	bool newGridNecessary(const node v, const DPoint& p) {
+	// Returns the number of crossings if the node is moved to the given
+	// position. Only the cells crossed by the edges incident to the node
+	// are visited and the grid is not changed, so this may be called
+	// concurrently.
+	int crossingsAfterMove(const node, const DPoint&) const;
+
+	// Updates the grid and the crossings in place for the node moved to the
+	// given position. The cell size is kept.
+	void moveNode(const node, const DPoint&);
+
+	bool newGridNecessary(const node v, const DPoint& p) const {
 		bool resize = false;
 		DIntersectableRect ir;
 		computeGridGeometry(v,p,ir);
-		double l = max(ir.width(),ir.height());
-		l /= m_edgeMultiplier*(m_graph).numberOfEdges();
+		double l = preferredCellSize(max(ir.width(),ir.height()));
 		if(l <= m_CellSize/2.0 || l >= m_CellSize*2.0) resize = true;
 		return resize;
 	}
 
 private:
+	// Returns the side length of a cell for a layout of the given size.
+	// There are about sqrt(m) cells in each direction, so an edge of
+	// typical length is stored in a few cells holding a few edges each.
+	double preferredCellSize(double maxLength) const {
+		return maxLength/(m_edgeMultiplier*sqrt(double(m_graph.numberOfEdges())));
+	}
+
 	void ModifiedBresenham(const IPoint &, const IPoint &, SList<IPoint> &) const;
 
 	// This takes two DPoints with and computes a list of points
@@ -120,7 +136,7 @@ private:
 		const edge,
 		const node,
 		const DPoint&,
-		const IPoint&);
+		const IPoint&) const;
 
 #ifdef OGDF_DEBUG
 	void markCells(SList<IPoint> &, Array2D<bool> &) const;
@@ -34,6 +34,8 @@
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/energybased/fast_multipole_embedder/EdgeChain.h>
 
+#include <cfloat>
+
 namespace ogdf {
 namespace fast_multipole_embedder {
 
@@ -94,6 +96,7 @@ public:
 			m_nodeXPos[m_numNodes] = (float)xPos[v];
 			m_nodeYPos[m_numNodes] = (float)yPos[v];
 			m_nodeSize[m_numNodes] = (float)nodeSize[v];
+			m_nodeMoveRadius[m_numNodes] = FLT_MAX;
 			m_avgNodeSize += nodeSize[v];
 			nodeIndex[v] = m_numNodes;
 			m_numNodes++;
@@ -180,6 +183,10 @@ public:
 	inline const float* nodeSize() const { return m_nodeSize; }
 
 	//! Returns the node movement radius array for all nodes.
+	/**
+	 * A node moves at most its radius per iteration, hence a radius of zero pins it.
+	 * The radius of every node is unbounded (FLT_MAX) after #readFrom.
+	 */
 	inline float* nodeMoveRadius() { return m_nodeMoveRadius; }
 
 	//! Returns the edge length array for all edges.
@@ -108,6 +108,7 @@ struct FMEGlobalContext
 	float* globalForceY;					//!< the global node force y array
 	FMEGlobalOptions* pOptions;				//!< pointer to the global options
 	bool earlyExit;							//!< var for the main thread to notify the other threads that they are done
+	bool reuseQuadtree;						//!< var for the main thread to notify the other threads that the quadtree is only refitted
 	float scaleFactor;						//!< var
 	float coolDown;
 	float min_x;							//!< global point, node min x coordinate for bounding box calculations
@@ -974,6 +975,16 @@ public:
 		double dsq = (d_x*d_x + d_y*d_y);
 		double d = sqrt(dsq);
 
+		// limit the movement to the move radius of the node, a radius of zero pins it
+		if ((FLAGS & USE_NODE_MOVE_RAD) && d > nodeMoveRadius[i] && d < FLT_MAX)
+		{
+			float s = (float)(nodeMoveRadius[i] / d);
+			d_x *= s;
+			d_y *= s;
+			dsq = (d_x*d_x + d_y*d_y);
+			d = sqrt(dsq);
+		}
+
 		localContext->maxForceSq = max<double>(localContext->maxForceSq, (double)dsq );
 		localContext->avgForce += d;
 		if (d < FLT_MAX)
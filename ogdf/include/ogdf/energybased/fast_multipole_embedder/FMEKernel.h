@@ -77,14 +77,25 @@ private:
 #define OGDF_FME_KERNEL_COMPUTE_FORCE(dx,dy,s) \
 	(s/(max<float>(s*OGDF_FME_KERNEL_COMPUTE_FORCE_PROTECTION_FACTOR, (dx)*(dx) + (dy)*(dy))))
 
-inline double move_nodes(float* x, float* y, const uint32_t begin, const uint32_t end, const float* fx, const float* fy, const float t)
+//! moves the nodes by their forces, but at most by their move radius \p r
+inline double move_nodes(float* x, float* y, const float* r, const uint32_t begin, const uint32_t end, const float* fx, const float* fy, const float t)
 {
 	double dsq_max = 0.0;
 	for (uint32_t i=begin; i <= end; i++)
 	{
 		double dsq = fx[i]*fx[i] + fy[i]*fy[i];
-		x[i] += fx[i]*t;
-		y[i] += fy[i]*t;
+		float d_x = fx[i]*t;
+		float d_y = fy[i]*t;
+		double d = sqrt(d_x*d_x + d_y*d_y);
+		if (d > r[i] && d < FLT_MAX)
+		{
+			float s = (float)(r[i] / d);
+			d_x *= s;
+			d_y *= s;
+			dsq *= s*s;
+		}
+		x[i] += d_x;
+		y[i] += d_y;
 		dsq_max = max(dsq_max, dsq);
 	}
 	return dsq_max;
@@ -203,7 +214,9 @@ class FMEBasicKernel
 public:
 	inline void edgeForces(const ArrayGraph& graph, float* fx, float* fy)
 	{
-		eval_edges(graph, 0, graph.numEdges()-1, fx, fy);
+		if (graph.numEdges() > 0) {
+			eval_edges(graph, 0, graph.numEdges()-1, fx, fy);
+		}
 	}
 
 	inline void repForces(ArrayGraph& graph, float* fx, float* fy)
@@ -213,7 +226,7 @@ public:
 
 	inline double moveNodes(ArrayGraph& graph, float* fx, float* fy, float timeStep)
 	{
-		return move_nodes(graph.nodeXPos(), graph.nodeYPos(), 0, graph.numNodes()-1, fx, fy, timeStep);
+		return move_nodes(graph.nodeXPos(), graph.nodeYPos(), graph.nodeMoveRadius(), 0, graph.numNodes()-1, fx, fy, timeStep);
 	}
 
 	inline double simpleIteration(ArrayGraph& graph, float* fx, float* fy, float timeStep)
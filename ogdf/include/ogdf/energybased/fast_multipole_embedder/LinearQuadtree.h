@@ -37,6 +37,8 @@
 #define OGDF_LQ_M2L_MIN_BOUND 8
 #define OGDF_LQ_WSPD_BRANCH_BOUND 16
 #define OGDF_LQ_WSPD_BOUND 25
+//! the point array is merged instead of radix sorted if it has at most numPoints/ratio descents
+#define OGDF_LQ_MERGE_SORT_RUN_RATIO 32
 
 namespace ogdf {
 namespace fast_multipole_embedder {
@@ -637,6 +639,34 @@ public:
 
 	LQPoint* pointArray() { return m_points; }
 
+	//! sorts the points by their morton numbers
+	/**
+	 * Between two iterations of a layout the points barely move, so the point
+	 * array is usually still sorted or nearly sorted. This is checked first:
+	 * if only a few points are out of order, the sorted runs are merged,
+	 * otherwise the points are sorted by an LSD radix sort on the morton numbers.
+	 * Note that the point array may be exchanged, i.e., pointArray() has to be
+	 * called again afterwards.
+	 *
+	 * @return true iff the order of the points has changed
+	 */
+	bool sortPoints();
+
+	//! returns true iff the tree built last can be reused for the current morton numbers
+	/**
+	 * The tree only depends on the order of the points and, for every pair of
+	 * consecutive points, on the highest bit in which their morton numbers
+	 * differ. These bits are compared to the ones of the previous call
+	 * and stored for the next one. If the tree can be reused, only the point and node
+	 * coordinates need to be refitted.
+	 *
+	 * @param orderChanged whether the order of the points changed since the last call
+	 */
+	bool canReuseTree(bool orderChanged);
+
+	//! returns the number of calls to canReuseTree() that returned true
+	uint32_t numberOfReusedTrees() const { return m_numReusedTrees; }
+
 	PointID findFirstPointInCell(PointID somePointInCell) const;
 
 private:
@@ -752,6 +782,18 @@ private:
 	//! the point order in tree order
 	LQPoint* m_points;
 
+	//! buffer for sorting the points
+	LQPoint* m_sortBuffer;
+
+	//! the highest differing morton number bit of each pair of consecutive points
+	uint8_t* m_splitBits;
+
+	//! true iff a tree has been built for the current split bits
+	bool m_treeBuilt;
+
+	//! number of reused trees
+	uint32_t m_numReusedTrees;
+
 	//! number of points this quadtree is based on
 	uint32_t m_numPoints;
 
@@ -41,6 +41,8 @@ namespace ogdf {
 namespace energybased {
 namespace fmmm {
 
+class numexcept;
+
 class OGDF_EXPORT FruchtermanReingold
 {
 public:
@@ -70,11 +72,33 @@ public:
 		boxlength = b_l; down_left_corner = d_l_c;
 	}
 
+	//! Sets the maximum number of threads used for the force calculation.
+	void max_threads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
 private:
 	int _grid_quotient;//!< for coarsening the FrRe-grid
 	int max_gridindex; //!< maximum index of a grid row/column
 	double boxlength;  //!< length of drawing box
 	DPoint down_left_corner;//!< down left corner of drawing box
+	unsigned int m_maxThreads; //!< maximum number of threads
+
+	//! Minimum number of nodes per thread; smaller graphs are processed sequentially.
+	static const int MIN_NODES_PER_THREAD = 2000;
+
+	//! Adds the repulsive force between \p u and \p v to \p F_rep.
+	void add_rep_force(
+		node u,
+		node v,
+		NodeArray<NodeAttributes>& A,
+		NodeArray<DPoint>& F_rep,
+		numexcept& N);
+
+	//! Adds the forces \p F_thread of threads 1, ..., \p threads - 1 to \p F_rep.
+	void sum_up_thread_forces(
+		const Array<node>& nodes,
+		Array<NodeArray<DPoint>>& F_thread,
+		NodeArray<DPoint>& F_rep,
+		unsigned int threads);
 
 	//! Returns the repulsing force_function_value of scalar d.
 	double f_rep_scalar (double d);
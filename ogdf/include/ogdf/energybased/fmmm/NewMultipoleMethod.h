@@ -70,6 +70,12 @@ public:
 	//! Import updated information of the drawing area.
 	void update_boxlength_and_cornercoordinate(double b_l,DPoint d_l_c);
 
+	//! Sets the maximum number of threads used for the force calculation.
+	void max_threads(unsigned int n) {
+		m_maxThreads = std::max(1u, n);
+		ExactMethod.max_threads(m_maxThreads);
+	}
+
 private:
 	//! The minimum number of nodes for which the forces are
 	//! calculated using NMM (for lower values the exact
@@ -79,6 +85,7 @@ private:
 	//! calculation (value depends on MIN_NODE_NUMBER)
 	bool using_NMM;
 	FruchtermanReingold ExactMethod; //!< needed in case that using_NMM == false
+	unsigned int m_maxThreads; //!< maximum number of threads
 
 	FMMMOptions::ReducedTreeConstruction _tree_construction_way;
 	FMMMOptions::SmallestCellFinding _find_small_cell;
@@ -387,15 +394,21 @@ private:
 
 	//! The multipole expansion terms ME are calculated for all nodes of T ( centers are
 	//! initialized for each cell and quad_tree_leaves stores pointers to leaves of T).
+	/**
+	 * The expansions of the leaves are formed in parallel, and then shifted
+	 * to the inner nodes bottom-up.
+	 */
 	void form_multipole_expansions(NodeArray<NodeAttributes>& A,
 		QuadTreeNM& T,
-		List<QuadTreeNodeNM*>& quad_tree_leaves);
+		Array<QuadTreeNodeNM*>& quad_tree_leaves);
 
-	//! The multipole expansion List ME for the tree rooted at T.get_act_ptr() is
-	//! recursively calculated.
+	//! The ME and LE Lists and the centers of the tree rooted at T.get_act_ptr() are
+	//! recursively initialized; its leaves are appended to quad_tree_leaves and its
+	//! non-root nodes are appended to shifted_nodes in postorder.
 	void form_multipole_expansion_of_subtree(NodeArray<NodeAttributes>& A,
 		QuadTreeNM& T,
-		List<QuadTreeNodeNM*>& quad_tree_leaves);
+		List<QuadTreeNodeNM*>& quad_tree_leaves,
+		List<QuadTreeNodeNM*>& shifted_nodes);
 
 	//! The Lists ME and LE are both initialized to zero entries for *act_ptr.
 	void init_expansion_Lists(QuadTreeNodeNM* act_ptr);
@@ -442,19 +455,19 @@ private:
 	//! For each leaf v in quad_tree_leaves the force contribution defined by
 	//! v.get_local_exp() is calculated and stored in F_local_exp.
 	void transform_local_exp_to_forces(NodeArray <NodeAttributes>&A,
-		List<QuadTreeNodeNM*>& quad_tree_leaves,
+		const Array<QuadTreeNodeNM*>& quad_tree_leaves,
 		NodeArray<DPoint>& F_local_exp);
 
 	//! For each leaf v in quad_tree_leaves the force contribution defined by all nodes
 	//! in v.get_M() is calculated and stored in F_multipole_exp.
 	void transform_multipole_exp_to_forces(NodeArray<NodeAttributes>& A,
-		List<QuadTreeNodeNM*>& quad_tree_leaves,
+		const Array<QuadTreeNodeNM*>& quad_tree_leaves,
 		NodeArray<DPoint>& F_multipole_exp);
 
 	//! For each leaf v in quad_tree_leaves the force contributions from all leaves in
 	//! v.get_D1() and v.get_D2() are calculated.
 	void calculate_neighbourcell_forces(NodeArray<NodeAttributes>& A,
-		List<QuadTreeNodeNM*>& quad_tree_leaves,
+		const Array<QuadTreeNodeNM*>& quad_tree_leaves,
 		NodeArray<DPoint>& F_direct);
 
 	//! Add repulsive force contributions for each node.
@@ -36,6 +36,7 @@
 #include <ogdf/energybased/multilevel_mixer/MultilevelGraph.h>
 #include <ogdf/energybased/multilevel_mixer/MultilevelBuilder.h>
 #include <ogdf/energybased/multilevel_mixer/InitialPlacer.h>
+#include <ogdf/energybased/LayoutHierarchy.h>
 
 
 namespace ogdf {
@@ -109,6 +110,12 @@ private:
 
 	bool m_levelBound; //!< Determines if computation is stopped when number of levels is too high.
 	bool m_randomize; //!< Determines if initial random layout is computed.
+	bool m_retainHierarchy; //!< Determines if the merge hierarchy is exported.
+
+	LayoutHierarchy m_hierarchy; //!< The merge hierarchy of the last call.
+
+	//! Records the merges of all levels of \p MLG in #m_hierarchy.
+	void addLevelsToHierarchy(MultilevelGraph &MLG);
 
 public:
 
@@ -155,6 +162,17 @@ public:
 	//! Determines if computation is stopped when number of levels is too high.
 	void setLevelBound(bool b) { m_levelBound = b; }
 
+	/**
+	 * \brief Determines if the merge hierarchy is exported as hierarchy().
+	 *
+	 * Level 0 of the hierarchy is indexed by the node indices of the multilevel
+	 * graph, which is the order of the input nodes for call(GraphAttributes&).
+	 */
+	void setRetainHierarchy(bool b) { m_retainHierarchy = b; }
+
+	//! Returns the merge hierarchy of the last call if enabled by setRetainHierarchy().
+	const LayoutHierarchy &hierarchy() const { return m_hierarchy; }
+
 	//! Calls the multilevel layout algorithm for graph attributes \p GA.
 	void call(GraphAttributes &GA) override;
 
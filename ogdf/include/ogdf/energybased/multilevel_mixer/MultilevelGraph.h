@@ -150,6 +150,8 @@ public:
 	bool deleteEdge(NodeMerge * NM, edge theEdge);
 	std::vector<edge> moveEdgesToParent(NodeMerge * NM, node theNode, node parent, bool deleteDoubleEndges, int adjustEdgeLengths);
 	NodeMerge * getLastMerge();
+	//! Returns all merges that have not been undone, in the order they were performed.
+	const std::vector<NodeMerge *> &getMerges() const { return m_changes; }
 	node undoLastMerge();
 
 	void updateReverseIndizes();
@@ -325,6 +325,32 @@ bool solve( Model &ReturnModel );
  */
 bool solve( Model &ReturnModel, double& timeLimit );
 
+//! tries to solve the formula under the given assumptions
+/**
+ * The assumptions only hold for this call. Clauses learned during the search
+ * remain valid, hence the same formula can be solved repeatedly under
+ * different assumptions, e.g., with selector variables switching clauses on.
+ *
+ * @param ReturnModel is the model output
+ * @param assumps are signed variables (like in Clause::add) assumed to be true
+ * \returns true if the problem is satisfiable under the assumptions and writes the output model to param
+ */
+bool solve( Model &ReturnModel, const std::vector<Internal::Var> &assumps );
+
+//! tries to solve the formula with a portfolio of concurrently running solvers
+/**
+ * Besides the solver of this formula, \p numberOfSolvers - 1 differently seeded and
+ * configured solvers work on copies of the current clause database in separate threads.
+ * The first solver that finishes determines the result and interrupts the others.
+ *
+ * @param ReturnModel is the model output
+ * @param numberOfSolvers is the number of racing solvers (including this formula)
+ * @param assumps are signed variables (like in Clause::add) assumed to be true
+ * \returns true if the problem is satisfiable under the assumptions and writes the output model to param
+ */
+bool solvePortfolio( Model &ReturnModel, int numberOfSolvers,
+                     const std::vector<Internal::Var> &assumps = std::vector<Internal::Var>() );
+
 Internal::Var getVarFromLit(const Internal::Lit &l)
 {
 	return Internal::var(l);
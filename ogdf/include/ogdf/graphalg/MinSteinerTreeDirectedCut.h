@@ -91,6 +91,7 @@ protected:
 	int m_callPrimalHeuristic;
 	MinSteinerTreeModule<double> *m_primalHeuristic;
 	int m_poolSizeInitFactor;
+	int m_numberOfThreads;
 
 	// Abacus LP classes
 	class Sub;
@@ -195,6 +196,12 @@ public:
 	{
 		m_poolSizeInitFactor = b;
 	}
+	//! Set the number of threads processing branch-and-cut subproblems concurrently. Default: 1
+	void setNumberOfThreads(int n)
+	{
+		OGDF_ASSERT(n >= 1);
+		m_numberOfThreads = n;
+	}
 
 	MinSteinerTreeDirectedCut()
 	  : m_configFile(nullptr)
@@ -217,6 +224,7 @@ public:
 	  , m_callPrimalHeuristic(1)
 	  , m_primalHeuristic(nullptr)
 	  , m_poolSizeInitFactor(5)
+	  , m_numberOfThreads(1)
 	{
 	}
 
@@ -2220,6 +2228,7 @@ T MinSteinerTreeDirectedCut<T>::computeSteinerTree(const EdgeWeightedGraph<T> &G
 	}
 	stpMaster->setPrimalHeuristicCallStrategy(m_callPrimalHeuristic);
 	stpMaster->setPoolSizeInitFactor(m_poolSizeInitFactor);
+	stpMaster->nThreads(m_numberOfThreads);
 	// XXX: should we set stpMaster->objInteger true/false according to weights automatically?
 
 	// now solve LP
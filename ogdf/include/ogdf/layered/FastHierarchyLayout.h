@@ -32,7 +32,7 @@
 #pragma once
 
 #include <ogdf/module/HierarchyLayoutModule.h>
-#include <ogdf/basic/List.h>
+#include <ogdf/basic/ArrayBuffer.h>
 
 
 namespace ogdf {
@@ -58,6 +58,11 @@ namespace ogdf {
  * Algorithm for k-Level Graphs</i>. LNCS 1984 (Proc. %Graph Drawing 2000),
  * pp. 229-240, 2001.
  *
+ * The hierarchy is stored in flat arrays indexed by the internal node
+ * numbering. The two placements of the long edges and the independent
+ * sequences of nonvirtual nodes on a layer are computed by up to
+ * maxThreads() threads; the layout does not depend on the number of threads.
+ *
  * <h3>Optional Parameters</h3>
  *
  * <table>
@@ -125,14 +130,23 @@ public:
 		m_fixedLayerDist = b;
 	}
 
+	//! Returns the maximum number of threads used for the placement.
+	unsigned int maxThreads() const {
+		return m_maxThreads;
+	}
+
+	//! Sets the maximum number of threads used for the placement.
+	void maxThreads(unsigned int threads) {
+		m_maxThreads = std::max(1u, threads);
+	}
 
 private:
 
 	int n;      //!< The number of nodes including virtual nodes.
 	int m;      //!< The number edge sections.
 	int k;      //!< The number of layers.
-	int *layer; //!< Stores for every node its layer.
-	int *first; //!< Stores for every layer the index of the first node.
+	Array<int> layer; //!< Stores for every node its layer.
+	Array<int> first; //!< Stores for every layer the index of the first node.
 
 
 	// nodes are numbered top down and from left to right.
@@ -141,43 +155,67 @@ private:
 	// For thechnical reasons we set first[k] to n.
 
 	/**
-	 * \brief The list of neighbors in previous / next layer.
+	 * \brief The neighbors in previous / next layer.
 	 *
-	 * for every node : adj[0][node] list of neighbors in previous layer;
-	 * for every node : adj[1][node] list of neighbors in next layer
+	 * for every node : adj[0][adjStart[0][node]], ..., adj[0][adjStart[0][node+1]-1]
+	 * are the neighbors in previous layer, adj[1] and adjStart[1] store
+	 * the neighbors in next layer. Neighbors are sorted by internal number.
 	 */
-	List<int> *adj[2];
+	Array<int> adjStart[2];
+	Array<int> adj[2]; //!< The neighbors, see adjStart.
 
 	/**
 	 * \brief The nodes belonging to a long edge.
 	 *
-	 * for every node : longEdge[node] is a pointer to a list containing all
-	 * nodes that belong to the same long edge as node.
+	 * for every node : longEdge[node] is the long edge that contains node.
+	 * The nodes of long edge e are chain[chainBegin[e]], ...,
+	 * chain[chainEnd[e]-1] from top to bottom.
 	 */
-	List<int> **longEdge;
+	Array<int> longEdge;
+	ArrayBuffer<int> chain;      //!< The nodes of all long edges, see longEdge.
+	ArrayBuffer<int> chainBegin; //!< for every long edge : index of its first node in chain.
+	ArrayBuffer<int> chainEnd;   //!< for every long edge : index behind its last node in chain.
 
 	double m_minNodeDist; //!< The minimal node distance on a layer.
 	double m_minLayerDist;//!< The minimal distance between layers.
-	double *breadth;      //!< for every node : breadth[node] = width of the node.
-	double *height;       //!< for every layer : height[layer] = height of max{height of node on layer}.
-	double *y;            //!< for every layer : y coordinate of layer.
-	double *x;            //!< for every node : x coordinate of node.
+	Array<double> breadth;//!< for every node : breadth[node] = width of the node.
+	Array<double> height; //!< for every layer : height[layer] = height of max{height of node on layer}.
+	Array<double> y;      //!< for every layer : y coordinate of layer.
+	Array<double> x;      //!< for every node : x coordinate of node.
 	/**
 	 * for every node : minimal possible distance between the center of a node
 	 * and first[layer[node]].
 	 */
-	double *totalB;
+	Array<double> totalB;
 
-	double *mDist; //!< Similar to totalB, used for temporary storage.
+	Array<double> mDist; //!< Similar to totalB, used for temporary storage.
 
 	bool m_fixedLayerDist; //!< 0 if distance between layers should be variable, 1 otherwise.
-	bool *virt; //!< for every node : virt[node] = 1 if node is virtual, 0 otherwise.
+	Array<bool> virt; //!< for every node : virt[node] = 1 if node is virtual, 0 otherwise.
 
-	void incrTo(double& d, double t) {
+	unsigned int m_maxThreads;      //!< Maximum number of threads.
+	unsigned int m_numberOfThreads; //!< Number of threads used by the current call.
+
+	//! Returns the number of neighbors of \p v in previous (\p d = 0) or next (\p d = 1) layer.
+	int degree(int d, int v) const {
+		return adjStart[d][v+1] - adjStart[d][v];
+	}
+
+	//! Returns the first neighbor of \p v in previous (\p d = 0) or next (\p d = 1) layer.
+	int firstAdj(int d, int v) const {
+		return adj[d][adjStart[d][v]];
+	}
+
+	//! Returns the number of nodes of the long edge containing \p v.
+	int longEdgeSize(int v) const {
+		return chainEnd[longEdge[v]] - chainBegin[longEdge[v]];
+	}
+
+	static void incrTo(double& d, double t) {
 		if(d < t) d = t;
 	}
 
-	void decrTo(double& d, double t) {
+	static void decrTo(double& d, double t) {
 		if(d > t) d = t;
 	}
 
@@ -232,7 +270,16 @@ private:
 	 *   edge (see exD) and its direct right (left) sibling if the sibling
 	 *   belongs to ANOTHER block. if exD is 0, dist is not relevant.
 	 */
-	void sortLongEdges(int actNode, int dir, double *pos, bool &exD, double &dist, int *block, bool *marked);
+	void sortLongEdges(int actNode, int dir, Array<double> &pos, bool &exD, double &dist, const Array<int> &block, Array<bool> &marked) const;
+
+	/**
+	 * Places all long edges as far as possible to the left (if \p dir = 1) or
+	 * to the right (if \p dir = -1) and stores the positions in \p pos.
+	 *
+	 * Only reads the member arrays, so both directions can be computed
+	 * concurrently.
+	 */
+	void placeLongEdges(int dir, Array<double> &pos) const;
 
 	/**
 	 * Places a sequence of nonvirtual nodes containing exactly one node.
@@ -256,7 +303,7 @@ private:
 	 * The funcion returns 0 if actNode does not have neighbours on the previous
 	 * (next) layer, 1 otherwise.
 	 */
-	bool placeSingleNode(int leftBnd, int rightBnd, int actNode, double &best, int d);
+	bool placeSingleNode(int leftBnd, int rightBnd, int actNode, double &best, int d) const;
 
 	/**
 	 * Places a sequence of nonvirtual nodes.
@@ -305,7 +352,7 @@ private:
 	 *   0 if there is no preference
 	 * @param marked Array for all nodes. Stores for every node, whether moveLongEdge has already been applied to it.
 	*/
-	void moveLongEdge(int actNode, int dir, bool *marked);
+	void moveLongEdge(int actNode, int dir, Array<bool> &marked);
 
 	/**
 	 * Tries to remove a bend at the position of the virtual node by straightening the edge.
@@ -319,7 +366,7 @@ private:
 	 * the current node, the function straightenEdge is first applied recursively to
 	 * this node.
 	 */
-	void straightenEdge(int actNode, bool *marked);
+	void straightenEdge(int actNode, Array<bool> &marked);
 
 	//! Computes the layout of an embedded layered graph.
 	void findPlacement();
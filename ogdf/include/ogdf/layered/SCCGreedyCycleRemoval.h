@@ -0,0 +1,79 @@
+/** \file
+ * \brief Declaration of class SCCGreedyCycleRemoval
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/module/AcyclicSubgraphModule.h>
+
+namespace ogdf {
+
+//! Greedy feasible arc set heuristic of Eades, Lin and Smyth applied to strong components.
+/**
+ * @ingroup ga-layered
+ *
+ * Edges between different strongly connected components never lie on a cycle,
+ * so the graph is decomposed into its strong components first and the greedy
+ * heuristic of Eades, Lin and Smyth (as in GreedyCycleRemoval) is only applied
+ * to the edges inside nontrivial components. The nodes are kept in buckets
+ * indexed by outdegree minus indegree, which are realized as linked lists
+ * over flat arrays, so the algorithm runs in linear time. Self-loops are
+ * always contained in the computed arc set.
+ *
+ * Strong components are processed concurrently, largest first.
+ *
+ * <H3>Optional parameters</H3>
+ *
+ * <table>
+ *   <tr>
+ *     <th>Option</th><th>Type</th><th>Default</th><th>Description</th>
+ *   </tr><tr>
+ *     <td><i>maxThreads</i><td>unsigned int<td>number of processors
+ *     <td>The maximal number of threads processing strong components.
+ *   </tr>
+ * </table>
+ */
+class OGDF_EXPORT SCCGreedyCycleRemoval : public AcyclicSubgraphModule {
+public:
+	//! Creates an instance of the cycle removal module.
+	SCCGreedyCycleRemoval();
+
+	//! Computes the set of edges \p arcSet, which have to be deleted in the acyclic subgraph.
+	virtual void call(const Graph &G, List<edge> &arcSet) override;
+
+	//! Returns the maximal number of used threads.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of used threads to \p n.
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
+private:
+	unsigned int m_maxThreads; //!< The maximal number of used threads.
+};
+
+}
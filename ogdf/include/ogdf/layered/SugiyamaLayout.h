@@ -221,6 +221,9 @@ public:
 	 */
 	virtual void call(GraphAttributes &GA) override;
 
+	//! Predicts memory and running time of call() for \p GA, see LayoutModule::estimateCost().
+	virtual LayoutCostEstimate estimateCost(const GraphAttributes &GA) const override;
+
 	/**
 	 * \brief Calls the layout algorithm for clustered graph \p CGA.
 	 *
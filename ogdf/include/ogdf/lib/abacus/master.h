@@ -35,6 +35,10 @@
 #include <ogdf/lib/abacus/hash.h>
 #include <ogdf/basic/Stopwatch.h>
 
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
 
 class OsiSolverInterface;
 
@@ -600,6 +604,28 @@ public:
 	 */
 	void maxNSub(int ml);
 
+	//! Returns the number of threads processing subproblems concurrently.
+	/**
+	 * By default this number is 1, i.e., the subproblems are processed sequentially.
+	 */
+	int nThreads() const { return nThreads_; }
+
+	//! Sets the number of threads processing subproblems concurrently to \a n.
+	/**
+	 * If \a n is greater than 1, up to \a n subproblems are optimized at the same time.
+	 * All subproblems share the master, its pools, and the set of open subproblems,
+	 * which are protected by a single lock. The lock is released only while
+	 * a subproblem solves its own linear program, hence problem specific functions
+	 * like the separation never run concurrently and need not be thread-safe.
+	 *
+	 * The global dual bound also takes the subproblems currently processed
+	 * into account, so the reported bounds stay valid. The order in which
+	 * subproblems are processed, and hence the statistics, may differ between runs.
+	 *
+	 * \param n The new number of threads.
+	 */
+	void nThreads(int n);
+
 	//! Returns the maximal cpu time (in seconds) which can be used by the optimization.
 	int64_t maxCpuTime() const { return maxCpuTime_; }
 
@@ -1193,6 +1219,42 @@ private:
 	 */
 	Sub   *select();
 
+	//! Checks the criteria for early termination of the optimization.
+	/**
+	 * If one of the criteria (maximal cpu time, maximal elapsed time, guarantee,
+	 * maximal number of subproblems) is fulfilled, the status of the
+	 * optimization is updated and \a true is returned.
+	 */
+	bool _terminate();
+
+	//! Processes the subproblems with #nThreads_ threads.
+	void _optimizeConcurrently();
+
+	//! Returns the worst dual bound of the subproblems processed concurrently to \a sub.
+	/**
+	 * If no other subproblem is processed, the dual bound of \a sub is returned.
+	 */
+	double _processedDualBound(const Sub *sub) const;
+
+	//! Releases the lock of the master while a subproblem solves its linear program.
+	/**
+	 * The lock is only released if the subproblems are processed concurrently,
+	 * and it is acquired again when the object is destroyed.
+	 */
+	class LpSolverSection {
+	public:
+		explicit LpSolverSection(Master *master) : master_(master->concurrent_ ? master : nullptr) {
+			if (master_) master_->mutex_.unlock();
+		}
+
+		~LpSolverSection() {
+			if (master_) master_->mutex_.lock();
+		}
+
+	private:
+		Master *master_;
+	};
+
 	int initLP();
 
 	//! Writes the string \a info to the stream associated with the Tree Interface.
@@ -1489,6 +1551,21 @@ private:
 	//! The timer for the cpu time spent in determining the branching rules.
 	ogdf::StopwatchCPU branchingTime_;
 
+	//! The number of threads processing subproblems.
+	int nThreads_;
+
+	//! \a true while the subproblems are processed by several threads.
+	bool concurrent_;
+
+	//! Protects the master while the subproblems are processed concurrently.
+	std::mutex mutex_;
+
+	//! Signals that a subproblem has been processed.
+	std::condition_variable subProcessed_;
+
+	//! The subproblems currently processed.
+	std::vector<Sub*> processing_;
+
 	//! The number of generated subproblems.
 	int nSub_;
 
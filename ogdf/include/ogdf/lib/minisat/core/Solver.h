@@ -20,6 +20,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #pragma once
 
+#include <atomic>
+
 #include <ogdf/lib/minisat/mtl/Vec.h>
 #include <ogdf/lib/minisat/mtl/Heap.h>
 #include <ogdf/lib/minisat/mtl/Alg.h>
@@ -224,7 +226,7 @@ protected:
     //
     int64_t             conflict_budget;    // -1 means no budget.
     int64_t             propagation_budget; // -1 means no budget.
-    bool                asynch_interrupt;
+    std::atomic<bool>   asynch_interrupt;
 
     // Main internal methods:
     //
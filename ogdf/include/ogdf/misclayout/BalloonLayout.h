@@ -42,6 +42,11 @@
  * edges around each vertex is optimized to maximize angular
  * resolution and to minimize the aspect ratio.
  *
+ * The spanning tree is stored in flat arrays in preorder, so
+ * each subtree occupies a contiguous range of positions.
+ * Independent subtrees are processed by up to maxThreads()
+ * threads; the layout does not depend on the number of threads.
+ *
  * Finally, the layout is shifted into the positive quadrant
  * of the cartesian plane
  * */
@@ -49,7 +54,7 @@
 #pragma once
 
 #include <ogdf/module/LayoutModule.h>
-#include <ogdf/basic/List.h>
+#include <ogdf/basic/ArrayBuffer.h>
 
 
 namespace ogdf {
@@ -90,17 +95,32 @@ public:
 	/// returns how the angles are assigned to subtrees.
 	bool getEvenAngles() {return m_evenAngles;}
 
+	/// Sets whether the children keep their embedding order or are rearranged.
+	/**
+	 * With ChildOrder::Optimized, the children of each vertex are sorted by the
+	 * size of their subtrees, and large and small subtrees are placed alternately.
+	 */
+	void setChildOrder(ChildOrder order) {m_childOrder = order;}
+	/// returns how the children of a vertex are arranged.
+	ChildOrder getChildOrder() const {return m_childOrder;}
+
+	//! Returns the maximum number of threads used for the tree passes.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximum number of threads used for the tree passes.
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
 protected:
 	//! Computes the spanning tree that is used for the
 	//! layout computation, the non-tree edges are
 	//! simply added into the layout.
 	void computeTree(const Graph &G);
 
-	//! Computes tree by BFS, fills m_parent and m_childCount.
+	//! Computes tree by BFS, fills m_parent and the child lists.
 	void computeBFSTree(const Graph &G, node v);
 
 	//! Selects the root of the spanning tree that
-	//! is placed in the layout center.
+	//! is placed in the layout center, and reroots the tree there.
 	void selectRoot(const Graph &G);
 
 	//! Computes a radius for each of the vertices in G.
@@ -108,11 +128,7 @@ protected:
 	//! that r(m) = gamma* r(m-1) where gamma is predefined
 	//! SNS model: different radii possible
 	//! Optimal: unordered tree, order of children is optimized.
-	#ifdef OGDF_DEBUG
-	void computeRadii(GraphAttributes &AG);
-	#else
 	void computeRadii(const GraphAttributes &AG);
-	#endif
 
 	//! Computes the angle distribution: assigns m_angle each node.
 	void computeAngles(const Graph &G);
@@ -121,20 +137,54 @@ protected:
 	void computeCoordinates(GraphAttributes &AG);
 
 private:
-	NodeArray<double> m_radius; //! Radius at node center.
-	NodeArray<double> m_oRadius; //!< Outer radius enclosing all children.
-	NodeArray<double> m_maxChildRadius; //!< Outer radius of largest child.
-	NodeArray<node>   m_parent; //!< Parent in spanning tree.
-	NodeArray<int>    m_childCount; //!< Number of children in spanning tree.
-	NodeArray<double> m_angle; //!< Angle assigned to nodes.
-	NodeArray<double> m_estimate; //!< Rough estimate of circumference of subtrees.
-	NodeArray<double> m_size;   //!< Radius of circle around node box.
-
-	NodeArray< List<node> > m_childList;
+	// The tree positions are BFS positions until selectRoot() is done,
+	// and preorder positions afterwards. The children of position i are
+	// m_child[m_childStart[i]], ..., m_child[m_childStart[i+1]-1].
+	NodeArray<int> m_pos; //!< Position of each node.
+	Array<node>   m_node; //!< Node at each position.
+	Array<int>    m_parent; //!< Parent position in spanning tree, -1 for the root.
+	Array<int>    m_childStart; //!< Start of the children of each position in m_child.
+	Array<int>    m_child; //!< Child positions, in drawing order.
+	Array<int>    m_subtreeEnd; //!< The subtree of i is [i, m_subtreeEnd[i]).
+
+	Array<double> m_radius; //!< Radius at node center.
+	Array<double> m_oRadius; //!< Outer radius enclosing all children.
+	Array<double> m_maxChildRadius; //!< Outer radius of largest child.
+	Array<double> m_angle; //!< Angle assigned to nodes.
+	Array<double> m_direction; //!< Direction from the parent to the node.
+	Array<double> m_estimate; //!< Rough estimate of circumference of subtrees.
+	Array<double> m_size;   //!< Radius of circle around node box.
+	Array<double> m_x; //!< x-coordinate of each position.
+	Array<double> m_y; //!< y-coordinate of each position.
+
+	ArrayBuffer<int> m_top; //!< Positions outside of all tasks, in preorder.
+	ArrayBuffer<int> m_tasks; //!< Roots of disjoint subtrees processed concurrently.
+	Array<int>    m_taskBegin; //!< Thread t processes m_tasks[m_taskBegin[t]], ..., m_tasks[m_taskBegin[t+1]-1].
+	unsigned int  m_numberOfThreads; //!< Number of threads of the current call.
+
+	//! Number of children of the node at position \p i.
+	int childCount(int i) const { return m_childStart[i+1] - m_childStart[i]; }
+
+	//! Renumbers the tree positions in preorder starting at the root.
+	void linearizeTree();
+
+	//! Splits the tree into m_top and the subtrees in m_tasks.
+	void splitTree();
+
+	//! Calls \p f(i) for all positions i, each after all its children.
+	template<typename Function>
+	void forAllBottomUp(Function f) const;
+
+	//! Calls \p f(i) for all positions i, each after its parent.
+	template<typename Function>
+	void forAllTopDown(Function f) const;
+
+	//! Rearranges the children of \p p for ChildOrder::Optimized.
+	void optimizeChildOrder(int p, ArrayBuffer<int> &sorted);
+
 #ifdef OGDF_DEBUG
 	//! Consistency check for the tree.
-	void checkTree(const Graph &G, bool treeRoot = true);
-	EdgeArray<bool> *m_treeEdge; //!< Holds info about tree edges.
+	void checkTree(const Graph &G);
 #endif
 
 	RootSelection     m_rootSelection; //!< Defines how the tree root is selected
@@ -147,8 +197,7 @@ private:
 	ChildOrder        m_childOrder; //!< How to arrange the children.
 	TreeComputation   m_treeComputation; //!< How to derive the spanning tree.
 	bool              m_evenAngles; //! Use even angles independent of subtree size.
-
-	void check(Graph &G);
+	unsigned int      m_maxThreads; //!< Maximum number of threads.
 
 	OGDF_NEW_DELETE
 }; //class BalloonLayout
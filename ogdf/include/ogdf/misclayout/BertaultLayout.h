@@ -64,6 +64,9 @@ public:
 	//! The main call to the algorithm. AG should have nodeGraphics and EdgeGraphics attributes enabled.
 	virtual void call(GraphAttributes &AG) override;
 
+	//! Predicts memory and running time of call() for \p GA, see LayoutModule::estimateCost().
+	virtual LayoutCostEstimate estimateCost(const GraphAttributes &GA) const override;
+
 
 	//! Sets impred option true or false.
 	void setImpred(bool option) { impred=option;};
@@ -144,13 +144,6 @@ private:
 		const Array<double> &outerRadius,
 		Array<double> &preferedAngle);
 
-	void assignPrefAngle(ClusterStructure &C,
-		const Array<double> &outerRadius,
-		Array<double> &preferedAngle,
-		int c,
-		int l,
-		double r1);
-
 };
 
 
@@ -0,0 +1,122 @@
+/** \file
+ * \brief Declaration of class OverlapRemovalLayout
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/module/LayoutModule.h>
+
+namespace ogdf {
+
+//! Removes overlaps between node rectangles while preserving the relative positions of the nodes.
+/**
+ * OverlapRemovalLayout is a post-processing step for layouts that treat nodes
+ * as points. It follows the proximity stress model (PRISM) of
+ *
+ * Emden R. Gansner, Yifan Hu: <i>Efficient, Proximity-Preserving Node Overlap
+ * Removal</i>. Journal of %Graph Algorithms and Applications 14(1), pp. 53-74, 2010.
+ *
+ * In every round, the overlapping node pairs are determined with a SpatialIndex.
+ * Together with the nearest neighbours of each node they form a proximity graph.
+ * Overlapping pairs get their distance stretched by the factor needed to separate
+ * them (at most 1.5 per round), all other pairs keep their current distance, and
+ * one stress majorization step is solved by conjugate gradients. Apart from the
+ * overlapping pairs themselves, each round takes O(n log n) time. The algorithm
+ * stops as soon as no overlaps remain or after the maximal number of rounds.
+ *
+ * Drawings whose bounding box is smaller than the total node area are first
+ * scaled uniformly.
+ *
+ * Bend points of edges are not modified.
+ *
+ * <H3>Optional parameters</H3>
+ *
+ * <table>
+ *   <tr>
+ *     <th><i>Option</i><th><i>Type</i><th><i>Default</i><th><i>Description</i>
+ *   </tr><tr>
+ *     <td><i>separation</i><td>double<td>4.0
+ *     <td>The minimal distance between two node rectangles.
+ *   </tr><tr>
+ *     <td><i>maxIterations</i><td>int<td>500
+ *     <td>The maximal number of rounds.
+ *   </tr><tr>
+ *     <td><i>neighbours</i><td>int<td>4
+ *     <td>The number of nearest neighbours of each node whose distance is preserved.
+ *   </tr>
+ * </table>
+ */
+class OGDF_EXPORT OverlapRemovalLayout : public LayoutModule
+{
+public:
+	//! Creates an instance of the overlap removal with default settings.
+	OverlapRemovalLayout();
+
+	//! Moves the nodes of \p GA such that their rectangles no longer overlap.
+	virtual void call(GraphAttributes &GA) override;
+
+	//! Predicts memory and running time of call() for \p GA, see LayoutModule::estimateCost().
+	virtual LayoutCostEstimate estimateCost(const GraphAttributes &GA) const override;
+
+	//! Returns the number of node pairs in \p GA closer than the separation.
+	int numberOfOverlaps(const GraphAttributes &GA) const;
+
+	//! Returns the minimal distance between two node rectangles.
+	double separation() const { return m_separation; }
+
+	//! Sets the minimal distance between two node rectangles to \p sep.
+	void separation(double sep) { m_separation = sep; }
+
+	//! Returns the maximal number of rounds.
+	int maxIterations() const { return m_maxIterations; }
+
+	//! Sets the maximal number of rounds to \p n.
+	void maxIterations(int n) { m_maxIterations = n; }
+
+	//! Returns the number of nearest neighbours whose distance is preserved.
+	int neighbours() const { return m_neighbours; }
+
+	//! Sets the number of nearest neighbours whose distance is preserved to \p k.
+	void neighbours(int k) { m_neighbours = k; }
+
+private:
+	struct ProximityEdge {
+		int source;
+		int target;
+		double length;
+	};
+
+	double m_separation; //!< The minimal distance between two node rectangles.
+	int m_maxIterations; //!< The maximal number of rounds.
+	int m_neighbours; //!< The number of preserved nearest neighbours.
+
+	//! Collects the proximity edges of the current drawing, returns the number of overlapping pairs.
+	int proximityEdges(const GraphAttributes &GA, const NodeArray<int> &index, std::vector<ProximityEdge> &edges) const;
+};
+
+}
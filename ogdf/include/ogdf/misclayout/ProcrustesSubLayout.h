@@ -32,6 +32,7 @@
 #pragma once
 
 #include <ogdf/module/LayoutModule.h>
+#include <ogdf/basic/Array.h>
 
 
 namespace ogdf {
@@ -131,17 +132,26 @@ private:
 
 //! A simple procrustes analysis implementation
 /*!
+ * Calls a sub layout and afterwards translates, scales, rotates and possibly
+ * flips the new drawing such that it matches the initial one as well as possible.
+ *
+ * The optimal similarity transform is obtained in closed form from the 2x2
+ * covariance of the two drawings, which is accumulated in a single vectorized
+ * pass. The coordinate buffers are kept between calls, so repeated calls, e.g.
+ * for successive frames of an animation, do not allocate. Optionally, only a
+ * sample of anchor nodes is used to determine the transform, which is then
+ * applied to all nodes.
  */
 class OGDF_EXPORT ProcrustesSubLayout : public LayoutModule
 {
 public:
-	//! Creates an instance of circular layout.
+	//! Creates an instance of procrustes sub layout.
 	ProcrustesSubLayout(LayoutModule* pSubLayout);
 
 	// destructor
 	~ProcrustesSubLayout() { }
 
-	//! Computes a circular layout for graph attributes \p GA.
+	//! Computes a layout for graph attributes \p GA by the sub layout and aligns it to the initial one.
 	virtual void call(GraphAttributes &GA) override;
 
 	//! Should the new layout scale be used or the initial scale? Default: inital
@@ -156,30 +166,45 @@ public:
 		return m_scaleToInitialLayout;
 	}
 
-private:
-	//! Does a reverse transform of graph attributes by using the origin, scale and angle in pointset
-	void reverseTransform(GraphAttributes& graphAttributes, const ProcrustesPointSet& pointSet);
-
-	//! Moves all coords in graphAttributes by dx, dy
-	void translate(GraphAttributes& graphAttributes, double dx, double dy);
-
-	//! Rotates all coords in graphAttributes by angle
-	void rotate(GraphAttributes& graphAttributes, double angle);
+	//! Sets the number of anchor nodes used for the alignment, 0 uses all nodes. Default: 0
+	/**
+	 * The anchors are spread evenly over the node list of the graph.
+	 */
+	void setNumberOfAnchors(int numAnchors)
+	{
+		m_numAnchors = std::max(0, numAnchors);
+	}
 
-	//! Scales all coords in graphAttributes by scale
-	void scale(GraphAttributes& graphAttributes, double scale);
+	//! Returns the number of anchor nodes used for the alignment, 0 means all nodes.
+	int numberOfAnchors() const
+	{
+		return m_numAnchors;
+	}
 
-	//! Flips all y coordinates
-	void flipY(GraphAttributes& graphAttributes);
+private:
+	//! Selects the anchor nodes of \p graph.
+	void selectAnchors(const Graph& graph);
 
-	//! copysthe coords in graph attributes to the point set
-	void copyFromGraphAttributes(const GraphAttributes& graphAttributes, ProcrustesPointSet& pointSet);
+	//! Copies the coords of the anchors relative to the first anchor to \p x and \p y, returns the first anchor.
+	DPoint copyAnchors(const GraphAttributes& graphAttributes, Array<double>& x, Array<double>& y) const;
 
 	//! The layout module to call for a new layout
 	LayoutModule* m_pSubLayout;
 
 	//! option for enabling/disabling scaling to initial layout scale
 	bool m_scaleToInitialLayout;
+
+	//! the number of anchors, 0 for all nodes
+	int m_numAnchors;
+
+	//! the anchor nodes of the current call
+	Array<node> m_anchors;
+
+	//! coordinates of the anchors in the initial layout
+	Array<double> m_initialX, m_initialY;
+
+	//! coordinates of the anchors in the new layout
+	Array<double> m_newX, m_newY;
 };
 
 } // end of namespace ogdf
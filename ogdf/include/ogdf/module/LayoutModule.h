@@ -36,6 +36,47 @@
 
 namespace ogdf {
 
+//! Predicted resource usage of a layout call.
+/**
+ * An estimate is returned by LayoutModule::estimateCost() and allows to decide
+ * whether a layout algorithm should be run on a graph at all, before any work
+ * is done. It is derived from the sizes of the data structures an algorithm
+ * allocates and from its iteration counts, so it is a coarse prediction and
+ * not a bound.
+ */
+struct OGDF_EXPORT LayoutCostEstimate {
+	//! The asymptotic running time of a layout call in the size of the input.
+	enum class TimeClass {
+		Linear,    //!< O(n + m)
+		Loglinear, //!< O((n + m) log n)
+		Quadratic, //!< O(n^2) or O(nm)
+		Cubic      //!< O(n^3) or O(n^2 m)
+	};
+
+	//! Size statistics of an input graph that the estimates are based on.
+	struct OGDF_EXPORT GraphProfile {
+		int numberOfNodes;         //!< The number of nodes.
+		int numberOfEdges;         //!< The number of edges.
+		int numberOfComponents;    //!< The number of connected components.
+		int maxComponentNodes;     //!< The number of nodes of the largest component.
+		int maxComponentEdges;     //!< The number of edges of the largest component.
+		double sumSquaredNodes;    //!< The sum of the squared component sizes.
+
+		//! Computes the profile of \p G in linear time.
+		explicit GraphProfile(const Graph &G);
+	};
+
+	double peakMemory = 0.0; //!< Predicted peak memory in bytes, in addition to the input.
+	double operations = 0.0; //!< Predicted number of elementary steps.
+	TimeClass timeClass = TimeClass::Linear; //!< The asymptotic time class.
+
+	//! Returns the number of bytes of a graph with \p n nodes and \p m edges.
+	static double graphMemory(double n, double m);
+
+	//! Returns the number of bytes of a copy of the graph of \p GA with all its attributes.
+	static double attributesMemory(const GraphAttributes &GA);
+};
+
 
 /**
  * \brief Interface of general layout algorithms.
@@ -64,6 +105,16 @@ public:
 	 */
 	void operator()(GraphAttributes &GA) { call(GA); }
 
+	/**
+	 * \brief Predicts memory and running time of call() for \p GA without running it.
+	 *
+	 * The default implementation assumes a linear-time algorithm that works on
+	 * a copy of the graph and its attributes. Algorithms with super-linear
+	 * memory or time override it, taking their current options into account.
+	 * @param GA is the input graph that would be passed to call().
+	 */
+	virtual LayoutCostEstimate estimateCost(const GraphAttributes &GA) const;
+
 	OGDF_MALLOC_NEW_DELETE
 };
 
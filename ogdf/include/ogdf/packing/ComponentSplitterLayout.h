@@ -60,6 +60,9 @@ public:
 
 	void call(GraphAttributes &GA) override;
 
+	//! Predicts memory and running time of call() for \p GA, see LayoutModule::estimateCost().
+	LayoutCostEstimate estimateCost(const GraphAttributes &GA) const override;
+
 	void setLayoutModule(LayoutModule *layout) {
 		m_secondaryLayout.reset(layout);
 	}
@@ -75,6 +75,13 @@ public:
 		return preparation(G,true);
 	}
 
+	//! Returns true, if the biconnected graph \p G is planar, false otherwise.
+	/**
+	 * \p numbering must contain an st-numbering of \p G (see computeSTNumbering()).
+	 * The test runs on a FlatPQTree and leaves \p G unchanged.
+	 */
+	static bool isPlanarSTNumbered(const Graph &G, const NodeArray<int> &numbering);
+
 private:
 
 	//! Prepares the planarity test and the planar embedding
@@ -34,6 +34,7 @@
 #include <ogdf/module/EmbedderModule.h>
 #include <ogdf/decomposition/BCTree.h>
 #include <ogdf/decomposition/StaticSPQRTree.h>
+#include <ogdf/basic/System.h>
 
 namespace ogdf {
 
@@ -48,7 +49,7 @@ class OGDF_EXPORT EmbedderMinDepth : public EmbedderModule
 {
 public:
 	//constructor
-	EmbedderMinDepth() { }
+	EmbedderMinDepth() : m_maxThreads(System::numberOfProcessors()) { }
 
 	/**
 	 * \brief Computes an embedding of \p G with minimum depth.
@@ -58,14 +59,24 @@ public:
 	 */
 	virtual void doCall(Graph& G, adjEntry& adjExternal) override;
 
+	//! Returns the maximal number of threads used for processing the blocks.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used for processing the blocks.
+	/**
+	 * Block graphs and SPQR-trees are computed concurrently, as are blocks
+	 * of the same height in the bottom-up traversal of the BC-tree.
+	 */
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
 private:
 	/**
-	 * \brief Computes recursively the block graph for every block.
+	 * \brief Computes the block graph and SPQR-tree of block \p bT.
 	 *
 	 * \param bT is a block node in the BC-tree.
 	 * \param cH is a node of bT in the block graph.
 	 */
-	void computeBlockGraphs(const node& bT, const node& cH);
+	void computeBlockGraph(const node& bT, const node& cH);
 
 	/**
 	 * \brief Bottom-up-traversal of bcTree computing the values \a m_{cT, bT}
@@ -113,6 +124,9 @@ private:
 	void embedBlock(const node& bT, const node& cT, ListIterator<adjEntry>& after);
 
 private:
+	/** maximal number of threads */
+	unsigned int m_maxThreads;
+
 	/** BC-tree of the original graph */
 	BCTree* pBCTree;
 
@@ -34,6 +34,7 @@
 
 #include <ogdf/module/EmbedderModule.h>
 #include <ogdf/decomposition/BCTree.h>
+#include <ogdf/basic/System.h>
 #include <ogdf/planarity/embedder/MDMFLengthAttribute.h>
 
 namespace ogdf {
@@ -49,7 +50,7 @@ class OGDF_EXPORT EmbedderMinDepthMaxFace : public EmbedderModule
 {
 public:
 	//constructor:
-	EmbedderMinDepthMaxFace() { }
+	EmbedderMinDepthMaxFace() : m_maxThreads(System::numberOfProcessors()) { }
 
 	/**
 	 * \brief Call embedder algorithm.
@@ -58,6 +59,16 @@ public:
 	 */
 	virtual void doCall(Graph& G, adjEntry& adjExternal) override;
 
+	//! Returns the maximal number of threads used for processing the blocks.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used for processing the blocks.
+	/**
+	 * Blocks of the same height are processed concurrently in the bottom-up
+	 * traversals of the BC-tree.
+	 */
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
 private:
 	using MDMFLengthAttribute = embedder::MDMFLengthAttribute;
 
@@ -65,6 +76,7 @@ private:
 	 * \brief Bottom-up-traversal of bcTree computing the values \a m_{cT, bT}
 	 * for all edges \a (cT, bT) in the BC-tree. The length of each vertex
 	 * \a v != \a c in \p bT is set to 1 if \a v in M_{bT} and to 0 otherwise.
+	 * The values of all child blocks of \p bT must already be computed.
 	 *
 	 * \param bT is a block vertex in the BC-tree.
 	 * \param cH is a vertex in the original graph \a G.
@@ -89,6 +101,8 @@ private:
 	/**
 	 * \brief Bottom up traversal of BC-tree.
 	 *
+	 * The values of all child blocks of \p bT must already be computed.
+	 *
 	 * \param bT is the BC-tree node treated in this function call.
 	 * \param cH is the block node which is related to the cut vertex which is
 	 *   parent of bT in BC-tree.
@@ -126,6 +140,9 @@ private:
 	void embedBlock(const node& bT, const node& cT, ListIterator<adjEntry>& after);
 
 private:
+	/** maximal number of threads */
+	unsigned int m_maxThreads;
+
 	/** the BC-tree of G */
 	BCTree* pBCTree;
 
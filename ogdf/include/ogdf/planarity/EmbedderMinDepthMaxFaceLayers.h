@@ -34,6 +34,7 @@
 
 #include <ogdf/module/EmbedderModule.h>
 #include <ogdf/decomposition/BCTree.h>
+#include <ogdf/basic/System.h>
 #include <ogdf/planarity/embedder/MDMFLengthAttribute.h>
 
 namespace ogdf {
@@ -54,7 +55,7 @@ class OGDF_EXPORT EmbedderMinDepthMaxFaceLayers : public EmbedderModule
 {
 public:
 	//constructor:
-	EmbedderMinDepthMaxFaceLayers() : pBCTree(nullptr), pAdjExternal(nullptr) {}
+	EmbedderMinDepthMaxFaceLayers() : m_maxThreads(System::numberOfProcessors()), pBCTree(nullptr), pAdjExternal(nullptr) {}
 
 	/**
 	 * \brief Call embedder algorithm.
@@ -63,6 +64,16 @@ public:
 	 */
 	virtual void doCall(Graph& G, adjEntry& adjExternal) override;
 
+	//! Returns the maximal number of threads used for processing the blocks.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used for processing the blocks.
+	/**
+	 * Blocks of the same height are processed concurrently in the bottom-up
+	 * traversals of the BC-tree.
+	 */
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
 private:
 	using MDMFLengthAttribute = embedder::MDMFLengthAttribute;
 
@@ -70,6 +81,7 @@ private:
 	 * \brief Bottom-up-traversal of bcTree computing the values \a m_{cT, bT}
 	 * for all edges (\a cT, \p bT) in the BC-tree. The length of each vertex
 	 * \a v != \a c in \p bT is set to 1 if \a v in M_{bT} and to 0 otherwise.
+	 * The values of all child blocks of \p bT must already be computed.
 	 *
 	 * \param bT is a block vertex in the BC-tree.
 	 * \param cH is a vertex in the original graph \a G.
@@ -94,6 +106,8 @@ private:
 	/**
 	 * \brief Bottom up traversal of BC-tree.
 	 *
+	 * The values of all child blocks of \p bT must already be computed.
+	 *
 	 * \param bT is the BC-tree node treated in this function call.
 	 * \param cH is the block node which is related to the cut vertex which is
 	 *   parent of bT in BC-tree.
@@ -131,6 +145,9 @@ private:
 	void embedBlock(const node& bT, const node& cT, ListIterator<adjEntry>& after);
 
 private:
+	/** maximal number of threads */
+	unsigned int m_maxThreads;
+
 	/** the BC-tree of G */
 	BCTree* pBCTree;
 
@@ -34,6 +34,7 @@
 
 #include <ogdf/module/EmbedderModule.h>
 #include <ogdf/decomposition/BCTree.h>
+#include <ogdf/basic/System.h>
 
 
 namespace ogdf {
@@ -49,7 +50,7 @@ class OGDF_EXPORT EmbedderMinDepthPiTa : public EmbedderModule
 public:
 	//constructor
 	EmbedderMinDepthPiTa()
-		: m_useExtendedDepthDefinition(true), pBCTree(nullptr), pAdjExternal(nullptr), pm_blockCutfaceTree(nullptr) {}
+		: m_useExtendedDepthDefinition(true), m_maxThreads(System::numberOfProcessors()), pBCTree(nullptr), pAdjExternal(nullptr), pm_blockCutfaceTree(nullptr) {}
 
 	/**
 	 * \brief Computes an embedding of \p G.
@@ -62,17 +63,24 @@ public:
 	bool useExtendedDepthDefinition() const { return m_useExtendedDepthDefinition; }
 	void useExtendedDepthDefinition(bool b) { m_useExtendedDepthDefinition = b; }
 
+	//! Returns the maximal number of threads used for embedding the blocks.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used for embedding the blocks.
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
 private:
 	bool m_useExtendedDepthDefinition;
+	unsigned int m_maxThreads; //!< The maximal number of threads.
 
 	/**
-	 * \brief Computes recursively an embedding for every block by using the
+	 * \brief Computes an embedding of block \p bT by using the
 	 * planarEmbed function.
 	 *
 	 * \param bT is a block node in the BC-tree.
 	 * \param cH is a node of bT in the auxiliary graph.
 	 */
-	void embedBlocks(const node& bT, const node& cH);
+	void embedBlock(const node& bT, const node& cH);
 
 	/**
 	 * \brief Computes entry in newOrder for a cutvertex.
@@ -33,6 +33,7 @@
 
 #include <ogdf/module/PlanarSubgraphModule.h>
 #include <ogdf/basic/STNumbering.h>
+#include <ogdf/planarity/BoothLueker.h>
 #include <ogdf/planarity/booth_lueker/PlanarLeafKey.h>
 #include <ogdf/planarity/planar_subgraph_fast/PlanarSubgraphPQTree.h>
 #include <ogdf/basic/simple_graph_alg.h>
@@ -253,6 +254,17 @@ protected:
 
 			for (node v : marked)
 				copyV[v] = nullptr;
+
+			// a planar block needs no planarization runs at all
+			if (bc->numberOfEdges() <= 3*bc->numberOfNodes() - 6) {
+				NodeArray<int> numbering(*bc, 0);
+				computeSTNumbering(*bc, numbering);
+				if (BoothLueker::isPlanarSTNumbered(*bc, numbering)) {
+					delete bc;
+					delete origE;
+					block[i] = BlockType((Graph*)nullptr, (EdgeArray<edge>*)nullptr);
+				}
+			}
 		}
 		copyV.init();
 
@@ -61,6 +61,9 @@ public:
 	 */
 	void call(GraphAttributes &ga) override;
 
+	//! Predicts memory and running time of call() for \p ga, see LayoutModule::estimateCost().
+	LayoutCostEstimate estimateCost(const GraphAttributes &ga) const override;
+
 	//! Calls planarization layout with clique handling for GraphAttributes \p ga with associated graph \p g.
 	/**
 	 * \pre \p g is the graph associated with graph attributes \p ga.
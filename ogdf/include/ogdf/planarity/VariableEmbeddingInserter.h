@@ -63,6 +63,18 @@ public:
 	//! Assignment operator. Copies option settings only.
 	VariableEmbeddingInserter &operator=(const VariableEmbeddingInserter &inserter);
 
+	//! Returns the maximal number of threads used by the remove-reinsert postprocessing.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used by the remove-reinsert postprocessing.
+	/**
+	 * With more than one thread, the reinsertion paths of several candidate
+	 * edges are computed speculatively and concurrently against the current
+	 * planarization. They are committed in the sequential order, so the
+	 * result does not depend on the number of threads.
+	 */
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
 
 	//! Calls only the postprocessing; assumes that all edges in \p origEdges are already inserted into \p pr.
 	/**
@@ -89,6 +101,8 @@ private:
 		const EdgeArray<int>      *pCostOrig,
 		const EdgeArray<bool>     *pForbiddenOrig,
 		const EdgeArray<uint32_t> *pEdgeSubgraphs);
+
+	unsigned int m_maxThreads = 1; //!< The maximal number of threads used by the postprocessing.
 };
 
 } // end namespace ogdf
@@ -0,0 +1,155 @@
+/** \file
+ * \brief Traversal of the blocks of a BC-tree processing independent blocks concurrently.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/ParallelFor.h>
+#include <ogdf/decomposition/BCTree.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace ogdf {
+namespace embedder {
+
+//! Traversal of the blocks of a BC-tree processing independent blocks concurrently.
+/**
+ * The BC-tree is rooted at a block node and its edges are directed from child to parent.
+ * Blocks of the same height (the height of a leaf block is 0) never depend on each
+ * other in a bottom-up traversal, so they are processed concurrently.
+ */
+class BlockTraversal
+{
+public:
+	//! Initializes the traversal of \p bcTree rooted at the block node \p rootBlock.
+	BlockTraversal(const BCTree &bcTree, node rootBlock)
+	  : m_bcTree(bcTree)
+	  , m_height(bcTree.bcTree(), -1)
+	{
+		computeHeight(rootBlock);
+		m_levels.resize(m_height[rootBlock] + 1);
+		for (node bT : m_postOrder) {
+			m_levels[m_height[bT]].push_back(bT);
+		}
+		m_bySize = m_postOrder;
+		std::stable_sort(m_bySize.begin(), m_bySize.end(), [&](node b1, node b2) {
+			return bcTree.numberOfEdges(b1) > bcTree.numberOfEdges(b2);
+		});
+	}
+
+	//! Returns the block nodes in the order of a recursive post-order traversal.
+	const std::vector<node> &postOrder() const { return m_postOrder; }
+
+	//! Returns the BC-tree edge from block node \p bT to its parent, or \c nullptr for the root block.
+	edge parentEdge(node bT) const {
+		for (adjEntry adj : bT->adjEntries) {
+			if (adj->theEdge()->source() == bT) {
+				return adj->theEdge();
+			}
+		}
+		return nullptr;
+	}
+
+	//! Returns the parent cut vertex of block node \p bT in the auxiliary graph.
+	/**
+	 * For the root block, the copy of the cut vertex belonging to its first
+	 * adjacent cut vertex node is returned.
+	 */
+	node parentCutVertex(node bT) const {
+		edge e = parentEdge(bT);
+		return m_bcTree.cutVertex(e == nullptr ? bT->firstAdj()->twinNode() : e->target(), bT);
+	}
+
+	//! Calls \p f(bT) for all block nodes \p bT using up to \p maxThreads threads, largest blocks first.
+	template<typename Function>
+	void forEachBlock(unsigned int maxThreads, Function f) const {
+		forEach(m_bySize, maxThreads, f);
+	}
+
+	//! Calls \p f(bT) for all block nodes \p bT after it returned for all blocks below \p bT.
+	/**
+	 * Up to \p maxThreads threads process the blocks of the same height concurrently.
+	 */
+	template<typename Function>
+	void bottomUp(unsigned int maxThreads, Function f) const {
+		for (const std::vector<node> &level : m_levels) {
+			forEach(level, maxThreads, f);
+		}
+	}
+
+private:
+	const BCTree &m_bcTree;
+	NodeArray<int> m_height; //!< The height of each block node.
+	std::vector<node> m_postOrder; //!< The block nodes in post-order.
+	std::vector<node> m_bySize; //!< The block nodes by decreasing number of edges.
+	std::vector<std::vector<node>> m_levels; //!< The block nodes of each height.
+
+	void computeHeight(node bT) {
+		int height = 0;
+		for (adjEntry adj : bT->adjEntries) {
+			edge e = adj->theEdge();
+			if (e->source() == bT) {
+				continue;
+			}
+			node cT = e->source();
+			for (adjEntry adjCT : cT->adjEntries) {
+				edge e2 = adjCT->theEdge();
+				if (e2->source() == cT) {
+					continue;
+				}
+				computeHeight(e2->source());
+				height = std::max(height, m_height[e2->source()] + 1);
+			}
+		}
+		m_height[bT] = height;
+		m_postOrder.push_back(bT);
+	}
+
+	template<typename Function>
+	static void forEach(const std::vector<node> &blocks, unsigned int maxThreads, Function &f) {
+		const int n = static_cast<int>(blocks.size());
+		const unsigned int threads = numberOfThreadsFor(maxThreads, n, 2);
+		if (threads <= 1) {
+			for (node bT : blocks) {
+				f(bT);
+			}
+			return;
+		}
+		std::atomic<int> next(0);
+		parallelFor(threads, threads, [&](int, int, unsigned int) {
+			for (int i = next++; i < n; i = next++) {
+				f(blocks[i]);
+			}
+		});
+	}
+};
+
+}
+}
@@ -34,6 +34,7 @@
 
 #include <ogdf/basic/Timeouter.h>
 #include <ogdf/basic/Module.h>
+#include <ogdf/basic/Stopwatch.h>
 #include <ogdf/planarity/PlanRepLight.h>
 #include <ogdf/planarity/RemoveReinsertType.h>
 #include <ogdf/decomposition/StaticSPQRTree.h>
@@ -48,7 +49,7 @@ public:
 		const EdgeArray<int>      *pCostOrig,
 		const EdgeArray<bool>     *pForbiddenOrig,
 		const EdgeArray<uint32_t> *pEdgeSubgraphs)
-		: m_pr(pr), m_pCost(pCostOrig), m_pForbidden(pForbiddenOrig), m_pSubgraph(pEdgeSubgraphs) { }
+		: m_pr(pr), m_pCost(pCostOrig), m_pForbidden(pForbiddenOrig), m_pSubgraph(pEdgeSubgraphs), m_maxThreads(1) { }
 
 	virtual ~VarEdgeInserterCore() { }
 
@@ -64,6 +65,9 @@ public:
 
 	int runsPostprocessing() const { return m_runsPostprocessing; }
 
+	//! Sets the maximal number of threads used for evaluating remove-reinsert candidates.
+	void maxThreads(unsigned int n) { m_maxThreads = std::max(1u, n); }
+
 protected:
 	class BiconnectedComponent;
 	class ExpandedGraph;
@@ -71,6 +75,63 @@ protected:
 	void insert(node s, node t, SList<adjEntry> &eip);
 	int costCrossed(edge eOrig) const;
 
+	//! Returns the cost of the current insertion path of \p eOrig.
+	int pathCost(edge eOrig) const {
+		return (m_pCost != nullptr) ? costCrossed(eOrig) : (m_pr.chain(eOrig).size() - 1);
+	}
+
+	//! Removes the insertion path of \p eOrig and computes an optimal new one in \p eip.
+	void findPath(edge eOrig, SList<adjEntry> &eip);
+
+	//! Removes and optimally reinserts \p eOrig; returns the cost of the new path.
+	int reinsert(edge eOrig);
+
+	//! Returns true iff the time limit is set and has been exceeded by \p watch.
+	bool timeLimitReached(const Stopwatch &watch) const {
+		return m_timeLimit >= 0 && watch.milliSeconds() >= 1000 * m_timeLimit;
+	}
+
+	//! Performs the postprocessing with the given candidates.
+	Module::ReturnType postprocessing(
+		SListPure<edge> &rrEdges,
+		RemoveReinsertType rrPost,
+		double percentMostCrossed);
+
+	//! Reinserts the edges in [\p it, \p itStop) one after the other; returns true iff some path got cheaper.
+	bool reinsertSequential(
+		SListConstIterator<edge> it,
+		SListConstIterator<edge> itStop,
+		const Stopwatch &watch,
+		bool &timeout);
+
+	//! Reinserts the edges in [\p it, \p itStop) with concurrent evaluation; returns true iff some path got cheaper.
+	/**
+	 * The candidates are processed in batches. The optimal reinsertion paths of
+	 * all candidates in a batch are computed in parallel, each on a private copy
+	 * of the current planarization. Going through the batch in order, candidates
+	 * whose path would not change are skipped, and the first other one is applied
+	 * as computed; the evaluation then restarts after it. Hence the result is the
+	 * same as with reinsertSequential().
+	 */
+	bool reinsertConcurrent(
+		SListConstIterator<edge> it,
+		SListConstIterator<edge> itStop,
+		const Stopwatch &watch,
+		bool &timeout);
+
+	//! Computes the gain of reinserting \p eOrig on a copy of the planarization.
+	/**
+	 * The crossed edges of the new path are returned in \p crossed as edges of
+	 * the planarization; they remain valid after removing the path of \p eOrig.
+	 */
+	int evaluateReinsertion(edge eOrig, SList<edge> &crossed) const;
+
+	//! Returns true iff removing the path of \p eOrig and inserting it crossing \p crossed restores the same path.
+	bool reinsertionKeepsPath(edge eOrig, const SList<edge> &crossed) const;
+
+	//! Creates a core with the same settings working on \p pr.
+	virtual VarEdgeInserterCore *createWorkerCore(PlanRepLight &pr) const;
+
 	bool dfsVertex(node v, int parent);
 	node dfsComp(int i, node parent);
 
@@ -112,6 +173,7 @@ protected:
 	node m_v1, m_v2;
 
 	int m_runsPostprocessing; //!< Runs of remove-reinsert method.
+	unsigned int m_maxThreads; //!< Maximal number of threads used for the remove-reinsert method.
 };
 
 
@@ -128,6 +190,7 @@ protected:
 	class ExpandedGraphUML;
 
 	void storeTypeOfCurrentEdge(edge eOrig) override { m_typeOfCurrentEdge = m_pr.typeOrig(eOrig); }
+	VarEdgeInserterCore *createWorkerCore(PlanRepLight &pr) const override;
 	BiconnectedComponent *createBlock() override;
 	ExpandedGraph *createExpandedGraph(const BiconnectedComponent &BC, const StaticSPQRTree &T) override;
 	virtual void buildSubpath(node v,
@@ -40,10 +40,11 @@ namespace ogdf {
 class MaximalFUPS : public FUPSModule {
 public:
 	//constructor
-	MaximalFUPS() : m_timelimit(0) {};
+	MaximalFUPS() : m_timelimit(0), m_portfolioSize(1) {};
 
 private:
 	int m_timelimit;
+	int m_portfolioSize;
 
 protected:
 	Module::ReturnType doCall(UpwardPlanRep &UPR, List<edge> &delEdges) override;
@@ -54,6 +55,10 @@ public:
 #endif
 	int getTimelimit()                 { return m_timelimit;      }
 	void setTimelimit(int timelimit)   { m_timelimit = timelimit; }
+	//! Returns the number of SAT solvers racing on each upward planarity test.
+	int getPortfolioSize()             { return m_portfolioSize;  }
+	//! Sets the number of SAT solvers racing on each upward planarity test.
+	void setPortfolioSize(int size)    { m_portfolioSize = size;  }
 };
 
 } // end namespace ogdf
@@ -44,7 +44,7 @@
 
 namespace ogdf {
 
-class UpSAT {
+class OGDF_EXPORT UpSAT {
 public:
 	//constructor
 	explicit UpSAT(Graph &G);
@@ -52,6 +52,8 @@ public:
 private:
 	//FLAGS
 	bool feasibleOriginalEdges;
+	//number of concurrently racing SAT solvers
+	int m_portfolioSize;
 	//copy of the input graph
 	Graph &m_G;
 	//number of clauses and variables
@@ -66,15 +68,28 @@ private:
 	std::vector< std::vector<int> > tau;
 	std::vector< std::vector<int> > sigma;
 	std::vector< std::vector<int> > mu;
+	//Selector variables switching the clauses of an edge on (incremental testing only)
+	std::vector<int> selector;
 	//Formula
 	Minisat::Formula m_F;
 public:
 	bool testUpwardPlanarity(NodeArray<int> *nodeOrder = nullptr);
+	//! Tests the subgraph induced by the \p selected edges for upward planarity.
+	/**
+	 * The formula for the whole graph is built on the first call only and every edge gets a
+	 * selector variable. Subsequent calls merely solve it under different assumptions on the
+	 * selectors, hence clauses learned while testing one subgraph speed up testing the next.
+	 * If \a feasibleOriginalEdges is set, the node order has to respect all original edges.
+	 */
+	bool testUpwardPlanarity(const EdgeArray<bool> &selected, NodeArray<int> *nodeOrder = nullptr);
 	bool embedUpwardPlanar(adjEntry& externalToItsRight,NodeArray<int> *nodeOrder = nullptr);
 	long long getNumberOfClauses();
 	int getNumberOfVariables();
+	//! Sets the number of SAT solvers racing on each formula (1 solves sequentially).
+	void setPortfolioSize(int size) { m_portfolioSize = size; }
 	void reset();
 private:
+	bool solve(Minisat::Model &model, const std::vector<int> &assumptions = std::vector<int>());
 	void computeDominatingEdges();
 	void computeTauVariables();
 	void computeSigmaVariables();
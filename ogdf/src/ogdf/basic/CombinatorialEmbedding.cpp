@@ -221,7 +221,7 @@ node CombinatorialEmbedding::splitNode(adjEntry adjStartLeft, adjEntry adjStartR
 }
 
 
-node CombinatorialEmbedding::contract(edge e)
+node CombinatorialEmbedding::contract(edge e, bool keepSelfLoops)
 {
 	// Since we remove edge e, we also remove adjSrc and adjTgt.
 	// We make sure that node of them is stored as first adjacency
@@ -242,7 +242,7 @@ node CombinatorialEmbedding::contract(edge e)
 		fTgt->entries.m_adjFirst = (adj != adjSrc) ? adj : adj->faceCycleSucc();
 	}
 
-	node v = m_pGraph->contract(e);
+	node v = m_pGraph->contract(e, keepSelfLoops);
 	--fSrc->m_size;
 	--fTgt->m_size;
 
@@ -362,6 +362,10 @@ face CombinatorialEmbedding::joinFacesPure(edge e)
 		m_rightFace[adj] = f1;
 	} while((adj = adj->faceCycleSucc()) != adj1);
 
+	// the joined face is external if one of its parts was
+	if (m_externalFace == f2)
+		m_externalFace = f1;
+
 	faces.del(f2);
 
 	return f1;
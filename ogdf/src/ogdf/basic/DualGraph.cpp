@@ -35,7 +35,8 @@ namespace ogdf{
 
 // Computes combinatorial embedding of dual graph
 // Precondition: CE must be combinatorial embedding of connected planar graph
-DualGraph::DualGraph(const ConstCombinatorialEmbedding &CE) : m_primalEmbedding(CE)
+DualGraph::DualGraph(const ConstCombinatorialEmbedding &CE)
+	: m_primalEmbedding(CE), m_mutablePrimalEmbedding(nullptr)
 {
 	const Graph &primalGraph = CE.getGraph();
 	init(*(new Graph));
@@ -106,6 +107,55 @@ DualGraph::DualGraph(const ConstCombinatorialEmbedding &CE) : m_primalEmbedding(
 	}
 }
 
+DualGraph::DualGraph(CombinatorialEmbedding &CE)
+	: DualGraph(static_cast<const ConstCombinatorialEmbedding&>(CE))
+{
+	m_mutablePrimalEmbedding = &CE;
+}
+
+// The dual adjacency entries at the dual node of a face are ordered like the
+// face cycle. Splitting the face thus splits a contiguous range of entries off
+// its dual node.
+edge DualGraph::splitPrimalFace(adjEntry adjSrc, adjEntry adjTgt)
+{
+	OGDF_ASSERT(m_mutablePrimalEmbedding != nullptr);
+
+	adjEntry adjStartLeft = dualAdj(adjTgt);
+	adjEntry adjStartRight = dualAdj(adjSrc);
+
+	edge e = m_mutablePrimalEmbedding->splitFace(adjSrc, adjTgt);
+	face fRight = m_mutablePrimalEmbedding->rightFace(e->adjTarget());
+
+	node vDual = splitNode(adjStartLeft, adjStartRight);
+	edge eDual = adjStartLeft->cyclicPred()->theEdge();
+	OGDF_ASSERT(eDual->target() == vDual);
+
+	m_dualNode[fRight] = vDual;
+	m_primalFace[vDual] = fRight;
+	m_dualEdge[e] = eDual;
+	m_primalEdge[eDual] = e;
+
+	return e;
+}
+
+// Joining two primal faces contracts the dual edge. Parallel dual edges
+// become self-loops, corresponding to primal bridges.
+face DualGraph::joinPrimalFaces(edge e)
+{
+	OGDF_ASSERT(m_mutablePrimalEmbedding != nullptr);
+
+	edge eDual = m_dualEdge[e];
+	OGDF_ASSERT(eDual->source() != eDual->target());
+
+	node vDual = contract(eDual, true);
+	face f = m_mutablePrimalEmbedding->joinFaces(e);
+
+	m_dualNode[f] = vDual;
+	m_primalFace[vDual] = f;
+
+	return f;
+}
+
 // Destructor
 DualGraph::~DualGraph()
 {
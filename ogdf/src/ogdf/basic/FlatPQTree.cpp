@@ -0,0 +1,680 @@
+/** \file
+ * \brief Implementation of the class FlatPQTree.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/FlatPQTree.h>
+
+namespace ogdf {
+
+void FlatPQTree::clear()
+{
+	m_nodes.clear();
+	m_free.clear();
+	std::fill(m_leaf.begin(), m_leaf.end(), -1);
+	m_handleParent.clear();
+	m_handleOwner.clear();
+	m_touched.clear();
+	m_root = m_pertRoot = -1;
+}
+
+void FlatPQTree::initialize(const int *first, const int *last)
+{
+	clear();
+	if (last - first == 1) {
+		m_root = newLeaf(*first);
+	} else if (last - first > 1) {
+		m_root = newNode(NodeType::PNode);
+		for (const int *key = first; key != last; ++key) {
+			appendChild(m_root, newLeaf(*key), 1);
+		}
+	}
+}
+
+bool FlatPQTree::reduction(const int *first, const int *last)
+{
+	resetPertinence();
+	if (first == last) {
+		return true;
+	}
+
+	bubble(first, last);
+
+	// process pertinent nodes bottom-up, a node as soon as all its pertinent children are done
+	const int nKeys = static_cast<int>(last - first);
+	m_queue.clear();
+	for (const int *key = first; key != last; ++key) {
+		int leaf = m_leaf[*key];
+		m_nodes[leaf].pertLeafCount = 1;
+		m_queue.push_back(leaf);
+	}
+
+	for (size_t head = 0; head < m_queue.size(); ++head) {
+		int v = m_queue[head];
+		int leafCount = m_nodes[v].pertLeafCount;
+		if (leafCount == nKeys) {
+			return templateRoot(v);
+		}
+
+		int w = templateNonRoot(v);
+		if (w < 0) {
+			return false;
+		}
+
+		int p = parentOf(w);
+		OGDF_ASSERT(p >= 0);
+		OGDF_ASSERT(m_nodes[p].mark == m_stamp);
+		Node &x = m_nodes[p];
+		x.pertLeafCount += leafCount;
+		if (m_nodes[w].status == NodeStatus::Full) {
+			m_nodes[w].fullNext = x.fullHead;
+			x.fullHead = w;
+			++x.fullCount;
+		} else {
+			if (x.partialCount < 2) {
+				x.partial[x.partialCount] = w;
+			}
+			++x.partialCount;
+		}
+		if (--x.pertChildCount == 0) {
+			m_queue.push_back(p);
+		}
+	}
+
+	OGDF_ASSERT(false);
+	return false;
+}
+
+void FlatPQTree::replaceRoot(const int *first, const int *last)
+{
+	int w = -1;
+	if (last - first == 1) {
+		w = newLeaf(*first);
+	} else if (last - first > 1) {
+		w = newNode(NodeType::PNode);
+		for (const int *key = first; key != last; ++key) {
+			appendChild(w, newLeaf(*key), 1);
+		}
+	}
+
+	int r = m_pertRoot;
+	OGDF_ASSERT(r >= 0);
+
+	if (m_nodes[r].status == NodeStatus::Full) {
+		if (w >= 0) {
+			replaceNode(r, w);
+		} else {
+			int p = parentOf(r);
+			if (p < 0) {
+				m_root = -1;
+			} else {
+				removeChild(p, r);
+				collapse(p);
+			}
+		}
+		freeSubtree(r);
+
+	} else {
+		// r is a partial Q-node; replace its full block by w
+		int a = m_blockEnd[0], b = m_blockEnd[1];
+		int outerA = m_blockOuter[0], outerB = m_blockOuter[1];
+		Node &q = m_nodes[r];
+		int endA = (q.end[0] == a) ? 0 : 1;
+		int endB = (q.end[0] == b) ? 0 : 1;
+
+		int removed = 0;
+		for (int c = a, prev = outerA; ; ) {
+			int next = otherSibling(c, prev);
+			freeSubtree(c);
+			++removed;
+			if (c == b) {
+				break;
+			}
+			prev = c;
+			c = next;
+		}
+
+		int linkA = (w >= 0) ? w : outerB;
+		int linkB = (w >= 0) ? w : outerA;
+		if (outerA >= 0) {
+			replaceSibling(outerA, a, linkA);
+		} else {
+			m_nodes[r].end[endA] = linkA;
+		}
+		if (outerB >= 0) {
+			replaceSibling(outerB, b, linkB);
+		} else {
+			m_nodes[r].end[endB] = linkB;
+		}
+		m_nodes[r].childCount -= removed;
+		if (w >= 0) {
+			Node &x = m_nodes[w];
+			x.sib[0] = outerA;
+			x.sib[1] = outerB;
+			x.parent = m_nodes[r].handle;
+			++m_nodes[r].childCount;
+		}
+		collapse(r);
+	}
+
+	m_pertRoot = -1;
+	resetPertinence();
+}
+
+int FlatPQTree::newNode(NodeType type)
+{
+	int v;
+	if (m_free.empty()) {
+		v = static_cast<int>(m_nodes.size());
+		m_nodes.emplace_back();
+	} else {
+		v = m_free.back();
+		m_free.pop_back();
+	}
+
+	Node &x = m_nodes[v];
+	x.sib[0] = x.sib[1] = -1;
+	x.end[0] = x.end[1] = -1;
+	x.parent = -1;
+	x.handle = -1;
+	x.childCount = 0;
+	x.key = -1;
+	x.mark = 0;
+	x.pertChildCount = 0;
+	x.pertLeafCount = 0;
+	x.fullHead = -1;
+	x.fullCount = 0;
+	x.partialCount = 0;
+	x.type = type;
+	x.status = NodeStatus::Empty;
+
+	if (type != NodeType::Leaf) {
+		x.handle = static_cast<int>(m_handleParent.size());
+		m_handleParent.push_back(x.handle);
+		m_handleOwner.push_back(v);
+	}
+	return v;
+}
+
+int FlatPQTree::newLeaf(int key)
+{
+	OGDF_ASSERT(key >= 0);
+	int v = newNode(NodeType::Leaf);
+	m_nodes[v].key = key;
+	if (key >= static_cast<int>(m_leaf.size())) {
+		m_leaf.resize(key + 1, -1);
+	}
+	m_leaf[key] = v;
+	return v;
+}
+
+int FlatPQTree::parentOf(int v)
+{
+	int h = m_nodes[v].parent;
+	if (h < 0) {
+		return -1;
+	}
+	while (m_handleParent[h] != h) {
+		m_handleParent[h] = m_handleParent[m_handleParent[h]];
+		h = m_handleParent[h];
+	}
+	return m_handleOwner[h];
+}
+
+void FlatPQTree::appendChild(int p, int c, int side)
+{
+	Node &x = m_nodes[p];
+	Node &y = m_nodes[c];
+	y.parent = x.handle;
+	int e = x.end[side];
+	if (e < 0) {
+		y.sib[0] = y.sib[1] = -1;
+		x.end[0] = x.end[1] = c;
+	} else {
+		replaceSibling(e, -1, c);
+		y.sib[0] = e;
+		y.sib[1] = -1;
+		x.end[side] = c;
+	}
+	++x.childCount;
+}
+
+void FlatPQTree::removeChild(int p, int c)
+{
+	int a = m_nodes[c].sib[0], b = m_nodes[c].sib[1];
+	if (a >= 0) {
+		replaceSibling(a, c, b);
+	}
+	if (b >= 0) {
+		replaceSibling(b, c, a);
+	}
+	Node &x = m_nodes[p];
+	for (int &e : x.end) {
+		if (e == c) {
+			e = (a >= 0) ? a : b;
+		}
+	}
+	--x.childCount;
+}
+
+void FlatPQTree::replaceNode(int v, int w)
+{
+	Node &x = m_nodes[v];
+	Node &y = m_nodes[w];
+	y.sib[0] = x.sib[0];
+	y.sib[1] = x.sib[1];
+	y.parent = x.parent;
+	for (int s : x.sib) {
+		if (s >= 0) {
+			replaceSibling(s, v, w);
+		}
+	}
+
+	int p = parentOf(v);
+	if (p < 0) {
+		m_root = w;
+	} else {
+		for (int &e : m_nodes[p].end) {
+			if (e == v) {
+				e = w;
+			}
+		}
+	}
+}
+
+// Replaces the Q-node y in the child list of the Q-node q by the children of y
+// such that the end side of y becomes adjacent to the sibling a of y.
+void FlatPQTree::mergeQChild(int q, int y, int a, int side)
+{
+	int b = otherSibling(y, a);
+	int yA = m_nodes[y].end[side];
+	int yB = m_nodes[y].end[1-side];
+
+	for (int i = 0; i < 2; ++i) {
+		int outer = (i == 0) ? a : b;
+		int inner = (i == 0) ? yA : yB;
+		replaceSibling(inner, -1, outer);
+		if (outer >= 0) {
+			replaceSibling(outer, y, inner);
+		} else {
+			Node &x = m_nodes[q];
+			x.end[x.end[0] == y ? 0 : 1] = inner;
+		}
+	}
+
+	m_handleParent[m_nodes[y].handle] = m_nodes[q].handle;
+	m_nodes[q].childCount += m_nodes[y].childCount - 1;
+	m_free.push_back(y);
+}
+
+// Removes v if it has less than two children; returns v or the node taking its place.
+int FlatPQTree::collapse(int v)
+{
+	Node &x = m_nodes[v];
+	if (x.childCount >= 2) {
+		return v;
+	}
+
+	int c = x.end[0];
+	if (c >= 0) {
+		replaceNode(v, c);
+	} else {
+		int p = parentOf(v);
+		if (p < 0) {
+			m_root = -1;
+		} else {
+			removeChild(p, v);
+			collapse(p);
+		}
+	}
+	m_free.push_back(v);
+	return c;
+}
+
+// Disposes of the detached node v if it has less than two children; returns v or its only child.
+int FlatPQTree::unwrap(int v)
+{
+	Node &x = m_nodes[v];
+	if (x.childCount >= 2) {
+		return v;
+	}
+	int c = x.end[0];
+	m_free.push_back(v);
+	return c;
+}
+
+// Detaches the full children of the P-node v, returning them grouped under a new full P-node.
+int FlatPQTree::groupFull(int v)
+{
+	int c = m_nodes[v].fullHead;
+	if (m_nodes[v].fullCount == 1) {
+		removeChild(v, c);
+		return c;
+	}
+
+	int g = newNode(NodeType::PNode);
+	m_nodes[g].status = NodeStatus::Full;
+	m_touched.push_back(g);
+	while (c >= 0) {
+		int next = m_nodes[c].fullNext;
+		removeChild(v, c);
+		appendChild(g, c, 1);
+		c = next;
+	}
+	return g;
+}
+
+// Determines the maximal run of full children of the Q-node q containing its child c.
+void FlatPQTree::findBlock(int q, int c)
+{
+	for (int i = 0; i < 2; ++i) {
+		int last = c;
+		int next = m_nodes[c].sib[i];
+		while (next >= 0 && m_nodes[next].status == NodeStatus::Full) {
+			int tmp = otherSibling(next, last);
+			last = next;
+			next = tmp;
+		}
+		m_blockEnd[i] = last;
+		m_blockOuter[i] = next;
+	}
+	m_pertRoot = q;
+}
+
+void FlatPQTree::freeSubtree(int v)
+{
+	m_stack.clear();
+	m_stack.push_back(v);
+	while (!m_stack.empty()) {
+		int w = m_stack.back();
+		m_stack.pop_back();
+		const Node &x = m_nodes[w];
+		if (x.type == NodeType::Leaf) {
+			if (m_leaf[x.key] == w) {
+				m_leaf[x.key] = -1;
+			}
+		} else {
+			for (int c = x.end[0], prev = -1; c >= 0; ) {
+				m_stack.push_back(c);
+				int next = otherSibling(c, prev);
+				prev = c;
+				c = next;
+			}
+		}
+		m_free.push_back(w);
+	}
+}
+
+void FlatPQTree::resetPertinence()
+{
+	for (int v : m_touched) {
+		Node &x = m_nodes[v];
+		x.status = NodeStatus::Empty;
+		x.pertChildCount = 0;
+		x.pertLeafCount = 0;
+		x.fullHead = -1;
+		x.fullCount = 0;
+		x.partialCount = 0;
+	}
+	m_touched.clear();
+}
+
+// Marks all pertinent nodes and counts their pertinent children. Since every node
+// knows its parent, no node is ever blocked; the walk stops as soon as all paths
+// from the leaves have met.
+void FlatPQTree::bubble(const int *first, const int *last)
+{
+	++m_stamp;
+	m_queue.clear();
+	for (const int *key = first; key != last; ++key) {
+		int leaf = m_leaf[*key];
+		OGDF_ASSERT(leaf >= 0);
+		m_nodes[leaf].mark = m_stamp;
+		m_queue.push_back(leaf);
+		m_touched.push_back(leaf);
+	}
+
+	int pending = static_cast<int>(last - first);
+	int offTheTop = 0;
+	for (size_t head = 0; pending + offTheTop > 1; ++head) {
+		int v = m_queue[head];
+		--pending;
+		int p = parentOf(v);
+		if (p < 0) {
+			offTheTop = 1;
+			continue;
+		}
+		Node &x = m_nodes[p];
+		if (x.mark != m_stamp) {
+			x.mark = m_stamp;
+			m_queue.push_back(p);
+			m_touched.push_back(p);
+			++pending;
+		}
+		++x.pertChildCount;
+	}
+}
+
+// Applies the templates L1, P1, P3, P5, Q1 and Q2 to the non-root pertinent node v.
+// Returns the node at the position of v, or -1 if the reduction fails.
+int FlatPQTree::templateNonRoot(int v)
+{
+	Node &x = m_nodes[v];
+	if (x.type == NodeType::Leaf
+	 || (x.partialCount == 0 && x.fullCount == x.childCount)) {
+		x.status = NodeStatus::Full;
+		return v;
+	}
+
+	if (x.type == NodeType::PNode) {
+		if (x.partialCount == 0) {
+			// P3
+			int g = groupFull(v);
+			int q = newNode(NodeType::QNode);
+			m_nodes[q].status = NodeStatus::Partial;
+			m_touched.push_back(q);
+			replaceNode(v, q);
+			int e = unwrap(v);
+			appendChild(q, e, 0);
+			appendChild(q, g, 1);
+			return q;
+		}
+
+		if (x.partialCount == 1) {
+			// P5
+			int y = x.partial[0];
+			int g = (x.fullCount > 0) ? groupFull(v) : -1;
+			removeChild(v, y);
+			int side = fullSide(y);
+			replaceNode(v, y);
+			int e = unwrap(v);
+			if (e >= 0) {
+				appendChild(y, e, 1-side);
+			}
+			if (g >= 0) {
+				appendChild(y, g, side);
+			}
+			return y;
+		}
+
+		return -1;
+	}
+
+	// Q2: the full children form a run at one end, followed by at most one partial child
+	if (x.partialCount > 1) {
+		return -1;
+	}
+	auto status = [&](int c) { return m_nodes[c].status; };
+	int side;
+	if (status(x.end[0]) == NodeStatus::Full) {
+		side = 0;
+	} else if (status(x.end[1]) == NodeStatus::Full) {
+		side = 1;
+	} else if (x.fullCount == 0 && status(x.end[0]) == NodeStatus::Partial) {
+		side = 0;
+	} else if (x.fullCount == 0 && status(x.end[1]) == NodeStatus::Partial) {
+		side = 1;
+	} else {
+		return -1;
+	}
+
+	int prev = -1, c = x.end[side], count = 0;
+	while (c >= 0 && status(c) == NodeStatus::Full) {
+		++count;
+		int next = otherSibling(c, prev);
+		prev = c;
+		c = next;
+	}
+	if (count != x.fullCount) {
+		return -1;
+	}
+	if (x.partialCount == 1) {
+		if (c < 0 || status(c) != NodeStatus::Partial) {
+			return -1;
+		}
+		mergeQChild(v, c, prev, fullSide(c));
+	}
+	m_nodes[v].status = NodeStatus::Partial;
+	return v;
+}
+
+// Applies the templates L1, P1, P2, P4, P6, Q1, Q2 and Q3 to the pertinent root v.
+bool FlatPQTree::templateRoot(int v)
+{
+	Node &x = m_nodes[v];
+	if (x.type == NodeType::Leaf
+	 || (x.partialCount == 0 && x.fullCount == x.childCount)) {
+		x.status = NodeStatus::Full;
+		m_pertRoot = v;
+		return true;
+	}
+
+	if (x.type == NodeType::PNode) {
+		if (x.partialCount == 0) {
+			// P2
+			if (x.fullCount == 1) {
+				m_pertRoot = x.fullHead;
+			} else {
+				int g = groupFull(v);
+				appendChild(v, g, 1);
+				m_pertRoot = g;
+			}
+			return true;
+		}
+
+		if (x.partialCount > 2) {
+			return false;
+		}
+
+		// P4 and P6
+		int y = x.partial[0];
+		int g = (x.fullCount > 0) ? groupFull(v) : -1;
+		int side = fullSide(y);
+		int junction = m_nodes[y].end[side];
+		if (g >= 0) {
+			appendChild(y, g, side);
+		}
+		if (m_nodes[v].partialCount == 2) {
+			int z = m_nodes[v].partial[1];
+			removeChild(v, z);
+			int sideZ = fullSide(z);
+			int a = m_nodes[y].end[side];
+			int b = m_nodes[z].end[sideZ];
+			replaceSibling(a, -1, b);
+			replaceSibling(b, -1, a);
+			m_nodes[y].end[side] = m_nodes[z].end[1-sideZ];
+			m_nodes[y].childCount += m_nodes[z].childCount;
+			m_handleParent[m_nodes[z].handle] = m_nodes[y].handle;
+			m_free.push_back(z);
+		}
+		if (m_nodes[v].childCount == 1) {
+			removeChild(v, y);
+			replaceNode(v, y);
+			m_free.push_back(v);
+		}
+		findBlock(y, junction);
+		return true;
+	}
+
+	// Q2 and Q3
+	if (x.partialCount > 2) {
+		return false;
+	}
+	auto status = [&](int c) { return m_nodes[c].status; };
+
+	if (x.fullCount > 0) {
+		int c0 = x.fullHead;
+		int last[2], outer[2];
+		int count = 1;
+		for (int i = 0; i < 2; ++i) {
+			last[i] = c0;
+			outer[i] = m_nodes[c0].sib[i];
+			while (outer[i] >= 0 && status(outer[i]) == NodeStatus::Full) {
+				++count;
+				int next = otherSibling(outer[i], last[i]);
+				last[i] = outer[i];
+				outer[i] = next;
+			}
+		}
+		if (count != x.fullCount) {
+			return false;
+		}
+		int partialCount = 0;
+		for (int i = 0; i < 2; ++i) {
+			if (outer[i] >= 0 && status(outer[i]) == NodeStatus::Partial) {
+				++partialCount;
+			}
+		}
+		if (partialCount != x.partialCount) {
+			return false;
+		}
+		for (int i = 0; i < 2; ++i) {
+			if (outer[i] >= 0 && status(outer[i]) == NodeStatus::Partial) {
+				mergeQChild(v, outer[i], last[i], fullSide(outer[i]));
+			}
+		}
+		findBlock(v, c0);
+		return true;
+	}
+
+	// no full children: two adjacent partial children
+	if (x.partialCount != 2) {
+		return false;
+	}
+	int y = x.partial[0], z = x.partial[1];
+	if (m_nodes[y].sib[0] != z && m_nodes[y].sib[1] != z) {
+		return false;
+	}
+	int sideY = fullSide(y);
+	int junction = m_nodes[y].end[sideY];
+	mergeQChild(v, y, z, sideY);
+	mergeQChild(v, z, junction, fullSide(z));
+	findBlock(v, junction);
+	return true;
+}
+
+}
@@ -300,10 +300,10 @@ void Graph::constructInitByNodes(
 		(eC->m_adjTgt = new AdjElement(eC, (m_edgeIdCount<<1)|1))
 			->m_twin = eC->m_adjSrc;
 		eC->m_adjSrc->m_twin = eC->m_adjTgt;
+		eC->m_adjSrc->m_node = eC->m_adjTgt->m_node = nullptr;
 		++m_edgeIdCount;
 	}
 
-	EdgeArray<bool> mark(G,false);
 	for(node vG : nodeList) {
 		node v = mapNode[vG];
 
@@ -313,12 +313,9 @@ void Graph::constructInitByNodes(
 
 			adjEntry adj;
 			if (eC->isSelfLoop()) {
-				if (mark[e])
-					adj = eC->m_adjTgt;
-				else {
-					adj = eC->m_adjSrc;
-					mark[e] = true;
-				}
+				// the first of both adjacency entries of a self-loop
+				// becomes the source entry; m_node marks it as assigned
+				adj = eC->m_adjSrc->m_node ? eC->m_adjTgt : eC->m_adjSrc;
 			} else
 				adj = (v == eC->m_src) ? eC->m_adjSrc : eC->m_adjTgt;
 
@@ -1274,7 +1271,7 @@ node Graph::splitNode(adjEntry adjStartLeft, adjEntry adjStartRight)
 }
 
 
-node Graph::contract(edge e)
+node Graph::contract(edge e, bool keepSelfLoops)
 {
 	adjEntry adjSrc = e->adjSource();
 	adjEntry adjTgt = e->adjTarget();
@@ -1284,12 +1281,12 @@ node Graph::contract(edge e)
 	adjEntry adjNext;
 	for (adjEntry adj = adjTgt->cyclicSucc(); adj != adjTgt; adj = adjNext) {
 		adjNext = adj->cyclicSucc();
-		if (adj->twinNode() == v) {
+		if (adj->twinNode() == v && !keepSelfLoops) {
 			continue;
 		}
 
 		edge eAdj = adj->theEdge();
-		if (w == eAdj->source()) {
+		if (adj == eAdj->adjSource()) {
 			moveSource(eAdj, adjSrc, Direction::before);
 		} else {
 			moveTarget(eAdj, adjSrc, Direction::before);
@@ -1310,7 +1307,7 @@ void Graph::moveAdj(adjEntry adj, node w)
 	adj->m_node = w;
 
 	edge e = adj->m_edge;
-	if(v == e->m_src) {
+	if(adj == e->adjSource()) {
 		--v->m_outdeg;
 		e->m_src = w;
 		++w->m_outdeg;
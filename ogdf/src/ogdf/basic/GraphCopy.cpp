@@ -365,10 +365,21 @@ edge GraphCopy::newEdge(node v, adjEntry adjEnd, edge eOrig, CombinatorialEmbedd
 
 	//check which direction is correct
 	edge e;
-	if (original(v) == eOrig->source())
-		e = E.addEdgeToIsolatedNode(v, adjEnd);
-	else
-		e = E.addEdgeToIsolatedNode(adjEnd, v);
+	if (v->degree() == 0) {
+		if (original(v) == eOrig->source())
+			e = E.addEdgeToIsolatedNode(v, adjEnd);
+		else
+			e = E.addEdgeToIsolatedNode(adjEnd, v);
+	} else {
+		//append e to the adjacency list of v by splitting the face
+		//between the last and first adjacency entry of v
+		adjEntry adjLast = v->lastAdj();
+		OGDF_ASSERT(E.rightFace(adjLast) == E.rightFace(adjEnd));
+		if (original(v) == eOrig->source())
+			e = E.splitFace(adjLast, adjEnd);
+		else
+			e = E.splitFace(adjEnd, adjLast);
+	}
 	m_eIterator[e] = m_eCopy[eOrig].pushBack(e);
 	m_eOrig[e] = eOrig;
 
@@ -0,0 +1,99 @@
+/** \file
+ * \brief Implementation of the default cost estimate of layout modules
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/module/LayoutModule.h>
+#include <ogdf/basic/simple_graph_alg.h>
+
+namespace ogdf {
+
+LayoutCostEstimate::GraphProfile::GraphProfile(const Graph &G)
+	: numberOfNodes(G.numberOfNodes())
+	, numberOfEdges(G.numberOfEdges())
+	, numberOfComponents(0)
+	, maxComponentNodes(0)
+	, maxComponentEdges(0)
+	, sumSquaredNodes(0.0)
+{
+	if (G.empty()) {
+		return;
+	}
+
+	NodeArray<int> component(G);
+	numberOfComponents = connectedComponents(G, component);
+
+	Array<int> nodes(0, numberOfComponents - 1, 0);
+	Array<int> edges(0, numberOfComponents - 1, 0);
+	for (node v : G.nodes) {
+		++nodes[component[v]];
+	}
+	for (edge e : G.edges) {
+		++edges[component[e->source()]];
+	}
+
+	for (int i = 0; i < numberOfComponents; ++i) {
+		maxComponentNodes = std::max(maxComponentNodes, nodes[i]);
+		maxComponentEdges = std::max(maxComponentEdges, edges[i]);
+		sumSquaredNodes += double(nodes[i]) * nodes[i];
+	}
+}
+
+
+double LayoutCostEstimate::graphMemory(double n, double m)
+{
+	return n * sizeof(NodeElement) + m * (sizeof(EdgeElement) + 2 * sizeof(AdjElement));
+}
+
+
+double LayoutCostEstimate::attributesMemory(const GraphAttributes &GA)
+{
+	const Graph &G = GA.constGraph();
+	const double n = G.numberOfNodes();
+	const double m = G.numberOfEdges();
+
+	// coordinates, sizes and the remaining per-element attributes
+	double bytes = graphMemory(n, m) + n * 8 * sizeof(double);
+	if (GA.has(GraphAttributes::edgeGraphics)) {
+		bytes += m * sizeof(DPolyline);
+	}
+	return bytes;
+}
+
+
+LayoutCostEstimate LayoutModule::estimateCost(const GraphAttributes &GA) const
+{
+	const Graph &G = GA.constGraph();
+
+	LayoutCostEstimate cost;
+	cost.peakMemory = LayoutCostEstimate::attributesMemory(GA);
+	cost.operations = G.numberOfNodes() + G.numberOfEdges();
+	cost.timeClass = LayoutCostEstimate::TimeClass::Linear;
+	return cost;
+}
+
+}
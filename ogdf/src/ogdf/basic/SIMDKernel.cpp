@@ -0,0 +1,158 @@
+/** \file
+ * \brief Implementation of the registry of SIMDKernel instances
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/SIMDKernel.h>
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+
+namespace ogdf {
+
+std::atomic<unsigned int> SIMDKernels::s_allowedFeatures{~0u};
+
+namespace {
+
+//! The registered kernels, guarded by the mutex.
+struct Registry {
+	std::mutex mutex;
+	std::vector<SIMDKernelBase*> kernels;
+};
+
+Registry &registry()
+{
+	static Registry r;
+	return r;
+}
+
+//! Returns the features of the processor.
+/**
+ * Kernels are static objects that may be constructed before the library
+ * has been initialized, so the initialization is triggered here.
+ */
+unsigned int processorFeatures()
+{
+	static Initialization init;
+	return static_cast<unsigned int>(System::cpuFeatures());
+}
+
+}
+
+SIMDKernelBase::~SIMDKernelBase()
+{
+	Registry &r = registry();
+	std::lock_guard<std::mutex> guard(r.mutex);
+	r.kernels.erase(std::remove(r.kernels.begin(), r.kernels.end(), this), r.kernels.end());
+}
+
+bool SIMDKernelBase::isAvailable(int i) const
+{
+	const unsigned int required = requiredFeatures(i);
+	return (required & processorFeatures() & SIMDKernels::allowedFeatures()) == required;
+}
+
+void SIMDKernelBase::selectBest()
+{
+	for (int i = numberOfVariants() - 1; i >= 0; --i) {
+		if (isAvailable(i)) {
+			selectVariant(i);
+			return;
+		}
+	}
+}
+
+void SIMDKernelBase::registerKernel()
+{
+	Registry &r = registry();
+	std::lock_guard<std::mutex> guard(r.mutex);
+	r.kernels.push_back(this);
+}
+
+std::vector<SIMDKernelBase*> SIMDKernels::all()
+{
+	Registry &r = registry();
+	std::lock_guard<std::mutex> guard(r.mutex);
+	return r.kernels;
+}
+
+void SIMDKernels::restrictFeatures(unsigned int mask)
+{
+	s_allowedFeatures.store(mask, std::memory_order_relaxed);
+	for (SIMDKernelBase *kernel : all()) {
+		kernel->selectBest();
+	}
+}
+
+bool SIMDKernels::selfTest(std::ostream *os)
+{
+	bool passed = true;
+	for (SIMDKernelBase *kernel : all()) {
+		for (int i = 1; i < kernel->numberOfVariants(); ++i) {
+			if (kernel->isAvailable(i) && !kernel->selfTest(i)) {
+				passed = false;
+				if (os != nullptr) {
+					*os << kernel->name() << ": variant " << kernel->variantName(i)
+					    << " differs from the reference" << std::endl;
+				}
+			}
+		}
+	}
+	return passed;
+}
+
+void SIMDKernels::benchmark(std::ostream &os, int repetitions, bool selectFastest)
+{
+	const std::ios::fmtflags flags = os.flags();
+	const std::streamsize precision = os.precision();
+	for (SIMDKernelBase *kernel : all()) {
+		os << kernel->name() << std::endl;
+		int fastest = 0;
+		double fastestTime = std::numeric_limits<double>::max();
+		for (int i = 0; i < kernel->numberOfVariants(); ++i) {
+			os << "  " << std::left << std::setw(12) << kernel->variantName(i);
+			if (!kernel->isAvailable(i)) {
+				os << "not available" << std::endl;
+				continue;
+			}
+			const double time = kernel->benchmark(i, repetitions);
+			if (time < fastestTime) {
+				fastest = i;
+				fastestTime = time;
+			}
+			os << std::fixed << std::setprecision(3) << 1000 * time << " ms"
+			   << (i == kernel->selectedVariant() ? " (selected)" : "") << std::endl;
+		}
+		if (selectFastest) {
+			kernel->selectVariant(fastest);
+		}
+	}
+	os.flags(flags);
+	os.precision(precision);
+}
+
+}
@@ -0,0 +1,492 @@
+/** \file
+ * \brief Implementation of class SpatialIndex
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/SpatialIndex.h>
+#include <algorithm>
+#include <queue>
+
+namespace ogdf {
+
+namespace {
+
+// Returns the position of (x,y) on a Hilbert curve filling a 2^16 x 2^16 grid.
+uint64_t hilbertIndex(uint32_t x, uint32_t y)
+{
+	const uint32_t n = 1u << 16;
+	uint64_t d = 0;
+	for (uint32_t s = n / 2; s > 0; s /= 2) {
+		uint32_t rx = (x & s) > 0;
+		uint32_t ry = (y & s) > 0;
+		d += uint64_t(s) * s * ((3 * rx) ^ ry);
+		if (ry == 0) {
+			if (rx == 1) {
+				x = n - 1 - x;
+				y = n - 1 - y;
+			}
+			std::swap(x, y);
+		}
+	}
+	return d;
+}
+
+inline bool intersects(const double *box, double minX, double minY, double maxX, double maxY)
+{
+	return box[0] <= maxX && minX <= box[2] && box[1] <= maxY && minY <= box[3];
+}
+
+// Returns the distance of p to the box, 0 if p lies inside.
+inline double distance(const double *box, const DPoint &p)
+{
+	double dx = std::max(std::max(box[0] - p.m_x, p.m_x - box[2]), 0.0);
+	double dy = std::max(std::max(box[1] - p.m_y, p.m_y - box[3]), 0.0);
+	return std::sqrt(dx * dx + dy * dy);
+}
+
+// Returns the distance of p to the segment from a to b.
+double distance(const DPoint &p, const DPoint &a, const DPoint &b)
+{
+	const double dx = b.m_x - a.m_x;
+	const double dy = b.m_y - a.m_y;
+	const double length2 = dx * dx + dy * dy;
+	double t = 0.0;
+	if (length2 > 0.0) {
+		t = ((p.m_x - a.m_x) * dx + (p.m_y - a.m_y) * dy) / length2;
+		t = std::min(std::max(t, 0.0), 1.0);
+	}
+	return p.distance(DPoint(a.m_x + t * dx, a.m_y + t * dy));
+}
+
+// Returns true iff the segment from a to b intersects the box (Liang-Barsky clipping).
+bool segmentIntersects(const DPoint &a, const DPoint &b, double minX, double minY, double maxX, double maxY)
+{
+	const double dx = b.m_x - a.m_x;
+	const double dy = b.m_y - a.m_y;
+	const double p[4] = { -dx, dx, -dy, dy };
+	const double q[4] = { a.m_x - minX, maxX - a.m_x, a.m_y - minY, maxY - a.m_y };
+
+	double t0 = 0.0, t1 = 1.0;
+	for (int i = 0; i < 4; ++i) {
+		if (p[i] == 0.0) {
+			if (q[i] < 0.0) {
+				return false;
+			}
+		} else {
+			const double t = q[i] / p[i];
+			if (p[i] < 0.0) {
+				t0 = std::max(t0, t);
+			} else {
+				t1 = std::min(t1, t);
+			}
+			if (t0 > t1) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+inline void pushBox(std::vector<double> &boxes, const DPoint &p, const DPoint &q)
+{
+	boxes.push_back(std::min(p.m_x, q.m_x));
+	boxes.push_back(std::min(p.m_y, q.m_y));
+	boxes.push_back(std::max(p.m_x, q.m_x));
+	boxes.push_back(std::max(p.m_y, q.m_y));
+}
+
+}
+
+
+void SpatialIndex::PackedRTree::build(const std::vector<double> &boxes)
+{
+	const int n = static_cast<int>(boxes.size() / 4);
+	m_boxes.clear();
+	m_items.resize(n);
+	m_leaf.resize(n);
+	m_levelStart.clear();
+	if (n == 0) {
+		return;
+	}
+
+	double minX = boxes[0], minY = boxes[1], maxX = boxes[2], maxY = boxes[3];
+	for (int i = 1; i < n; ++i) {
+		minX = std::min(minX, boxes[4*i]);
+		minY = std::min(minY, boxes[4*i + 1]);
+		maxX = std::max(maxX, boxes[4*i + 2]);
+		maxY = std::max(maxY, boxes[4*i + 3]);
+	}
+
+	// sort the items along a Hilbert curve through their centers
+	const double scaleX = maxX > minX ? 65535.0 / (maxX - minX) : 0.0;
+	const double scaleY = maxY > minY ? 65535.0 / (maxY - minY) : 0.0;
+	std::vector<uint64_t> key(n);
+	for (int i = 0; i < n; ++i) {
+		const double x = (boxes[4*i] + boxes[4*i + 2]) / 2 - minX;
+		const double y = (boxes[4*i + 1] + boxes[4*i + 3]) / 2 - minY;
+		key[i] = hilbertIndex(uint32_t(x * scaleX), uint32_t(y * scaleY));
+		m_items[i] = i;
+	}
+	std::sort(m_items.begin(), m_items.end(), [&](int a, int b) {
+		return key[a] < key[b] || (key[a] == key[b] && a < b);
+	});
+
+	m_boxes.reserve(4 * (n + n / (s_nodeSize - 1) + 1));
+	for (int leaf = 0; leaf < n; ++leaf) {
+		const int item = m_items[leaf];
+		m_leaf[item] = leaf;
+		m_boxes.insert(m_boxes.end(), boxes.begin() + 4*item, boxes.begin() + 4*item + 4);
+	}
+
+	// pack each level into the next one until a single root remains
+	int levelBegin = 0, levelEnd = n;
+	m_levelStart.push_back(0);
+	while (levelEnd - levelBegin > 1) {
+		m_levelStart.push_back(levelEnd);
+		for (int child = levelBegin; child < levelEnd; child += s_nodeSize) {
+			const int last = std::min(child + s_nodeSize, levelEnd);
+			double box[4] = { m_boxes[4*child], m_boxes[4*child + 1], m_boxes[4*child + 2], m_boxes[4*child + 3] };
+			for (int c = child + 1; c < last; ++c) {
+				box[0] = std::min(box[0], m_boxes[4*c]);
+				box[1] = std::min(box[1], m_boxes[4*c + 1]);
+				box[2] = std::max(box[2], m_boxes[4*c + 2]);
+				box[3] = std::max(box[3], m_boxes[4*c + 3]);
+			}
+			m_boxes.insert(m_boxes.end(), box, box + 4);
+		}
+		levelBegin = levelEnd;
+		levelEnd = static_cast<int>(m_boxes.size() / 4);
+	}
+	m_levelStart.push_back(levelEnd);
+}
+
+
+void SpatialIndex::PackedRTree::update(int item, double minX, double minY, double maxX, double maxY)
+{
+	int entry = m_leaf[item];
+	m_boxes[4*entry] = minX;
+	m_boxes[4*entry + 1] = minY;
+	m_boxes[4*entry + 2] = maxX;
+	m_boxes[4*entry + 3] = maxY;
+
+	const int numberOfLevels = static_cast<int>(m_levelStart.size()) - 1;
+	for (int level = 0; level + 1 < numberOfLevels; ++level) {
+		const int index = (entry - m_levelStart[level]) / s_nodeSize;
+		const int first = m_levelStart[level] + index * s_nodeSize;
+		const int last = std::min(first + s_nodeSize, m_levelStart[level + 1]);
+		entry = m_levelStart[level + 1] + index;
+
+		double *box = &m_boxes[4*entry];
+		box[0] = m_boxes[4*first];
+		box[1] = m_boxes[4*first + 1];
+		box[2] = m_boxes[4*first + 2];
+		box[3] = m_boxes[4*first + 3];
+		for (int c = first + 1; c < last; ++c) {
+			box[0] = std::min(box[0], m_boxes[4*c]);
+			box[1] = std::min(box[1], m_boxes[4*c + 1]);
+			box[2] = std::max(box[2], m_boxes[4*c + 2]);
+			box[3] = std::max(box[3], m_boxes[4*c + 3]);
+		}
+	}
+}
+
+
+template<typename Report>
+void SpatialIndex::PackedRTree::query(double minX, double minY, double maxX, double maxY, Report report) const
+{
+	if (m_items.empty()) {
+		return;
+	}
+
+	const int numberOfLevels = static_cast<int>(m_levelStart.size()) - 1;
+	ArrayBuffer<std::pair<int,int>> stack;
+	stack.push(std::make_pair(m_levelStart.back() - 1, numberOfLevels - 1));
+	while (!stack.empty()) {
+		const std::pair<int,int> top = stack.popRet();
+		const int entry = top.first, level = top.second;
+		if (!intersects(&m_boxes[4*entry], minX, minY, maxX, maxY)) {
+			continue;
+		}
+		if (level == 0) {
+			report(m_items[entry]);
+		} else {
+			const int first = m_levelStart[level - 1] + (entry - m_levelStart[level]) * s_nodeSize;
+			const int last = std::min(first + s_nodeSize, m_levelStart[level]);
+			for (int child = first; child < last; ++child) {
+				stack.push(std::make_pair(child, level - 1));
+			}
+		}
+	}
+}
+
+
+template<typename Distance, typename Report>
+void SpatialIndex::PackedRTree::nearest(Distance distanceTo, Report report) const
+{
+	if (m_items.empty()) {
+		return;
+	}
+
+	struct Candidate {
+		double distance;
+		int entry;
+		int level;
+		bool operator<(const Candidate &other) const { return distance > other.distance; }
+	};
+
+	const int numberOfLevels = static_cast<int>(m_levelStart.size()) - 1;
+	std::priority_queue<Candidate> queue;
+	const int root = m_levelStart.back() - 1;
+	queue.push({distanceTo(&m_boxes[4*root]), root, numberOfLevels - 1});
+	while (!queue.empty()) {
+		const Candidate c = queue.top();
+		queue.pop();
+		if (c.level == 0) {
+			if (!report(m_items[c.entry])) {
+				return;
+			}
+		} else {
+			const int first = m_levelStart[c.level - 1] + (c.entry - m_levelStart[c.level]) * s_nodeSize;
+			const int last = std::min(first + s_nodeSize, m_levelStart[c.level]);
+			for (int child = first; child < last; ++child) {
+				queue.push({distanceTo(&m_boxes[4*child]), child, c.level - 1});
+			}
+		}
+	}
+}
+
+
+bool SpatialIndex::PackedRTree::bounds(double &minX, double &minY, double &maxX, double &maxY) const
+{
+	if (m_items.empty()) {
+		return false;
+	}
+	const double *box = &m_boxes[m_boxes.size() - 4];
+	minX = box[0];
+	minY = box[1];
+	maxX = box[2];
+	maxY = box[3];
+	return true;
+}
+
+
+SpatialIndex::SpatialIndex(const GraphAttributes &GA)
+	: m_pGA(&GA)
+	, m_nodeItem(GA.constGraph())
+	, m_firstSegment(GA.constGraph())
+	, m_numberOfSegments(GA.constGraph())
+{
+	build();
+}
+
+
+void SpatialIndex::build()
+{
+	const Graph &G = m_pGA->constGraph();
+	m_node.init(G.numberOfNodes());
+
+	std::vector<double> boxes;
+	boxes.reserve(4 * G.numberOfNodes());
+	int item = 0;
+	for (node v : G.nodes) {
+		m_node[item] = v;
+		m_nodeItem[v] = item++;
+		const double w = m_pGA->width(v) / 2, h = m_pGA->height(v) / 2;
+		boxes.push_back(m_pGA->x(v) - w);
+		boxes.push_back(m_pGA->y(v) - h);
+		boxes.push_back(m_pGA->x(v) + w);
+		boxes.push_back(m_pGA->y(v) + h);
+	}
+	m_nodeTree.build(boxes);
+
+	buildEdges();
+}
+
+
+void SpatialIndex::buildEdges()
+{
+	const Graph &G = m_pGA->constGraph();
+	m_segmentEdge.clear();
+
+	std::vector<double> boxes;
+	boxes.reserve(4 * G.numberOfEdges());
+	for (edge e : G.edges) {
+		m_firstSegment[e] = static_cast<int>(m_segmentEdge.size());
+		m_numberOfSegments[e] = m_pGA->bends(e).size() + 1;
+		m_segmentEdge.insert(m_segmentEdge.end(), m_numberOfSegments[e], e);
+		segmentBoxes(e, boxes);
+	}
+	m_edgeTree.build(boxes);
+}
+
+
+void SpatialIndex::segmentBoxes(edge e, std::vector<double> &boxes) const
+{
+	DPoint previous(m_pGA->x(e->source()), m_pGA->y(e->source()));
+	for (const DPoint &bend : m_pGA->bends(e)) {
+		pushBox(boxes, previous, bend);
+		previous = bend;
+	}
+	pushBox(boxes, previous, DPoint(m_pGA->x(e->target()), m_pGA->y(e->target())));
+}
+
+
+void SpatialIndex::segment(int s, DPoint &p, DPoint &q) const
+{
+	const edge e = m_segmentEdge[s];
+	const DPolyline &bends = m_pGA->bends(e);
+	const int k = s - m_firstSegment[e];
+
+	p = k == 0 ? DPoint(m_pGA->x(e->source()), m_pGA->y(e->source())) : *bends.get(k - 1);
+	q = k == bends.size() ? DPoint(m_pGA->x(e->target()), m_pGA->y(e->target())) : *bends.get(k);
+}
+
+
+void SpatialIndex::refitEdge(edge e)
+{
+	if (m_pGA->bends(e).size() + 1 != m_numberOfSegments[e]) {
+		buildEdges();
+		return;
+	}
+
+	std::vector<double> boxes;
+	segmentBoxes(e, boxes);
+	for (int k = 0; k < m_numberOfSegments[e]; ++k) {
+		m_edgeTree.update(m_firstSegment[e] + k, boxes[4*k], boxes[4*k + 1], boxes[4*k + 2], boxes[4*k + 3]);
+	}
+}
+
+
+void SpatialIndex::updateNode(node v)
+{
+	const double w = m_pGA->width(v) / 2, h = m_pGA->height(v) / 2;
+	m_nodeTree.update(m_nodeItem[v], m_pGA->x(v) - w, m_pGA->y(v) - h, m_pGA->x(v) + w, m_pGA->y(v) + h);
+
+	for (adjEntry adj : v->adjEntries) {
+		refitEdge(adj->theEdge());
+	}
+}
+
+
+void SpatialIndex::updateEdge(edge e)
+{
+	refitEdge(e);
+}
+
+
+DRect SpatialIndex::boundingBox() const
+{
+	double minX, minY, maxX, maxY;
+	if (!m_nodeTree.bounds(minX, minY, maxX, maxY)) {
+		return DRect();
+	}
+
+	double eMinX, eMinY, eMaxX, eMaxY;
+	if (m_edgeTree.bounds(eMinX, eMinY, eMaxX, eMaxY)) {
+		minX = std::min(minX, eMinX);
+		minY = std::min(minY, eMinY);
+		maxX = std::max(maxX, eMaxX);
+		maxY = std::max(maxY, eMaxY);
+	}
+	return DRect(minX, minY, maxX, maxY);
+}
+
+
+void SpatialIndex::nodesInBox(const DRect &box, ArrayBuffer<node> &result) const
+{
+	m_nodeTree.query(box.p1().m_x, box.p1().m_y, box.p2().m_x, box.p2().m_y, [&](int item) {
+		result.push(m_node[item]);
+	});
+}
+
+
+void SpatialIndex::edgesInBox(const DRect &box, ArrayBuffer<edge> &result) const
+{
+	const double minX = box.p1().m_x, minY = box.p1().m_y;
+	const double maxX = box.p2().m_x, maxY = box.p2().m_y;
+
+	std::vector<int> hits;
+	m_edgeTree.query(minX, minY, maxX, maxY, [&](int s) {
+		DPoint p, q;
+		segment(s, p, q);
+		if (segmentIntersects(p, q, minX, minY, maxX, maxY)) {
+			hits.push_back(s);
+		}
+	});
+
+	// report each edge once, in the order of the edge list
+	std::sort(hits.begin(), hits.end());
+	edge last = nullptr;
+	for (int s : hits) {
+		if (m_segmentEdge[s] != last) {
+			last = m_segmentEdge[s];
+			result.push(last);
+		}
+	}
+}
+
+
+node SpatialIndex::nodeAt(const DPoint &p) const
+{
+	int top = -1;
+	m_nodeTree.query(p.m_x, p.m_y, p.m_x, p.m_y, [&](int item) {
+		top = std::max(top, item);
+	});
+	return top < 0 ? nullptr : m_node[top];
+}
+
+
+edge SpatialIndex::edgeAt(const DPoint &p, double tolerance) const
+{
+	edge closest = nullptr;
+	double best = tolerance;
+	m_edgeTree.query(p.m_x - tolerance, p.m_y - tolerance, p.m_x + tolerance, p.m_y + tolerance, [&](int s) {
+		DPoint a, b;
+		segment(s, a, b);
+		const double d = distance(p, a, b);
+		if (d <= best) {
+			best = d;
+			closest = m_segmentEdge[s];
+		}
+	});
+	return closest;
+}
+
+
+void SpatialIndex::nearestNodes(const DPoint &p, int k, ArrayBuffer<node> &result) const
+{
+	int found = 0;
+	if (k <= 0) {
+		return;
+	}
+	m_nodeTree.nearest([&](const double *box) { return distance(box, p); }, [&](int item) {
+		result.push(m_node[item]);
+		return ++found < k;
+	});
+}
+
+}
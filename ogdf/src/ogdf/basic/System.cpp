@@ -73,29 +73,43 @@
 #endif
 #endif
 
-static inline void cpuid(int CPUInfo[4], int infoType)
+static inline void cpuid(int CPUInfo[4], int infoType, int subLeaf = 0)
 {
 #ifndef EMSCRIPTEN
-#if defined(OGDF_SYSTEM_WINDOWS)
-	__cpuid(CPUInfo, infoType);
+#if defined(_MSC_VER)
+	__cpuidex(CPUInfo, infoType, subLeaf);
 #else
-#endif
 	uint32_t a = 0;
 	uint32_t b = 0;
 	uint32_t c = 0;
 	uint32_t d = 0;
 
-#ifndef EMSCRIPTEN
 # ifdef __GNUC__
-	__get_cpuid(infoType, &a, &b, &c, &d);
+	if (static_cast<unsigned int>(infoType) <= __get_cpuid_max(infoType & 0x80000000, nullptr)) {
+		__cpuid_count(infoType, subLeaf, a, b, c, d);
+	}
 # endif
-#endif
 
 	CPUInfo[0] = a;
 	CPUInfo[1] = b;
 	CPUInfo[2] = c;
 	CPUInfo[3] = d;
 #endif
+#endif
+}
+
+//! Returns the register state enabled by the operating system (XCR0), requires OSXSAVE.
+static inline uint64_t xgetbv()
+{
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#elif defined(__GNUC__) && !defined(EMSCRIPTEN) && (defined(__i386__) || defined(__x86_64__))
+	uint32_t a, d;
+	__asm__ volatile("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+	return (static_cast<uint64_t>(d) << 32) | a;
+#else
+	return 0;
+#endif
 }
 
 
@@ -140,8 +154,29 @@ void System::init()
 		if(featureInfoECX & (1 <<  6)) s_cpuFeatures |= CPUFeatureMask::SMX;
 		if(featureInfoECX & (1 <<  7)) s_cpuFeatures |= CPUFeatureMask::EST;
 		if(featureInfoECX & (1 <<  3)) s_cpuFeatures |= CPUFeatureMask::MONITOR;
+
+		// AVX registers are usable only if the OS saves them on context switches,
+		// i.e., XCR0 enables the SSE and AVX state (and the AVX-512 state, respectively)
+		const bool osxsave = (featureInfoECX & (1 << 27)) != 0;
+		const uint64_t xcr0 = osxsave ? xgetbv() : 0;
+		const bool osAVX = (xcr0 & 0x6) == 0x6;
+		const bool osAVX512 = osAVX && (xcr0 & 0xe0) == 0xe0;
+		if(osAVX && (featureInfoECX & (1 << 28))) s_cpuFeatures |= CPUFeatureMask::AVX;
+		if(osAVX && (featureInfoECX & (1 << 12))) s_cpuFeatures |= CPUFeatureMask::FMA;
+
+		if(nIds >= 7)
+		{
+			cpuid(CPUInfo, 7, 0);
+			int extendedFeaturesEBX = CPUInfo[1];
+			if(osAVX && (extendedFeaturesEBX & (1 <<  5))) s_cpuFeatures |= CPUFeatureMask::AVX2;
+			if(osAVX512 && (extendedFeaturesEBX & (1 << 16))) s_cpuFeatures |= CPUFeatureMask::AVX512F;
+		}
 	}
 
+#ifdef __wasm_simd128__
+	s_cpuFeatures |= CPUFeatureMask::WASM_SIMD128;
+#endif
+
 	cpuid(CPUInfo, 0x80000000);
 	unsigned int nExIds = CPUInfo[0];
 
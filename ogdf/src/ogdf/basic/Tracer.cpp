@@ -0,0 +1,154 @@
+/** \file
+ * \brief Implementation of the Tracer class
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/Tracer.h>
+#include <chrono>
+#include <mutex>
+
+namespace ogdf {
+
+std::atomic<bool> Tracer::s_enabled(false);
+
+namespace {
+
+std::mutex &traceMutex()
+{
+	static std::mutex m;
+	return m;
+}
+
+std::vector<Tracer::Event> &traceEvents()
+{
+	static std::vector<Tracer::Event> events;
+	return events;
+}
+
+std::chrono::steady_clock::time_point traceEpoch()
+{
+	static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+	return epoch;
+}
+
+int nextThreadNumber()
+{
+	static std::atomic<int> counter(0);
+	return counter++;
+}
+
+thread_local int t_depth = 0;
+thread_local int t_thread = -1;
+
+void writeEscaped(std::ostream &os, const char *str)
+{
+	for (; *str != '\0'; ++str) {
+		switch (*str) {
+		case '"':
+		case '\\':
+			os << '\\' << *str;
+			break;
+		default:
+			if (static_cast<unsigned char>(*str) >= 0x20) {
+				os << *str;
+			}
+		}
+	}
+}
+
+}
+
+void Tracer::clear()
+{
+	std::lock_guard<std::mutex> guard(traceMutex());
+	traceEvents().clear();
+}
+
+
+std::vector<Tracer::Event> Tracer::events()
+{
+	std::lock_guard<std::mutex> guard(traceMutex());
+	return traceEvents();
+}
+
+
+size_t Tracer::numberOfEvents()
+{
+	std::lock_guard<std::mutex> guard(traceMutex());
+	return traceEvents().size();
+}
+
+
+int64_t Tracer::now()
+{
+	using namespace std::chrono;
+	return duration_cast<microseconds>(steady_clock::now() - traceEpoch()).count();
+}
+
+
+int64_t Tracer::begin()
+{
+	++t_depth;
+	return now();
+}
+
+
+void Tracer::end(const char *name, int64_t start)
+{
+	int64_t stop = now();
+	int depth = --t_depth;
+	if (t_thread < 0) {
+		t_thread = nextThreadNumber();
+	}
+
+	std::lock_guard<std::mutex> guard(traceMutex());
+	traceEvents().push_back(Event{name, start, stop - start, depth, t_thread});
+}
+
+
+void Tracer::writeChromeTrace(std::ostream &os)
+{
+	std::vector<Event> evs = events();
+
+	os << "{\"traceEvents\":[";
+	bool first = true;
+	for (const Event &ev : evs) {
+		if (!first) {
+			os << ',';
+		}
+		first = false;
+		os << "\n{\"name\":\"";
+		writeEscaped(os, ev.name);
+		os << "\",\"cat\":\"ogdf\",\"ph\":\"X\",\"ts\":" << ev.start
+		   << ",\"dur\":" << ev.duration
+		   << ",\"pid\":0,\"tid\":" << ev.thread
+		   << ",\"args\":{\"depth\":" << ev.depth << "}}";
+	}
+	os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+}
@@ -34,22 +34,19 @@
 
 #include <ogdf/cluster/ClusterAnalysis.h>
 #include <ogdf/cluster/ClusterArray.h>
-#include <ogdf/basic/Queue.h>
+#include <ogdf/basic/ArrayBuffer.h>
 #include <ogdf/basic/DisjointSets.h>
 
-// Comment on use of ClusterArrays:
-// We would like to save some space by only reserving one slot
-// per existing cluster instead of maxClusterIndex() slots,
-// which might be larger. However, we then would
-// need to store an index with each cluster in a struct here,
-// minimizing the effect again. Note ClusterArrays are static
-// here, a change in the ClusterGraph won't be detected
-// by ClusterAnalysis after initialization.
-// Where multiple indexing is done, the static version
-// of ClusterArrays is used with successive cluster index
-// numbers computed locally, to save memory. When only a single
-// indexed structure is needed this is clearly an overhead.
-// Therefore the ClusterArrays are then created with size maxClusterIndex().
+// Comment on data layout:
+// Per-cluster results are stored in ClusterArrays. Per-vertex and
+// per-cluster information is not stored in a ClusterArray for each
+// vertex, as this needs n * maxClusterIndex() slots. Activity status is
+// derived from the activity levels and the cluster tree, the counts of
+// active vertices are accumulated bottom-up from difference values.
+// Bag indices exist only for clusters containing a vertex, i.e. ancestors
+// of its cluster, so each vertex gets one slot per ancestor level.
+// Note the structures are static here, a change in the ClusterGraph won't
+// be detected by ClusterAnalysis after initialization.
 
 
 namespace ogdf {
@@ -100,11 +97,7 @@ void ClusterAnalysis::cleanUp()
 	delete m_bags;
 	delete m_lcaEdges;
 	if (m_storeoalists) delete m_oalists;
-	for(node v : m_C->constGraph().nodes)
-	{
-		delete m_bagindex[v];
-	}
-	if (m_indyBags) delete m_indyBagRoots;
+	delete[] m_indyBagRoots;
 }
 
 int ClusterAnalysis::outerActive(cluster c) {return (*m_oanum)[c];}
@@ -117,17 +110,24 @@ List<node>& ClusterAnalysis::oaNodes(cluster c) {
 
 bool ClusterAnalysis::isOuterActive(node v, cluster c)
 {
-	return (*m_oactive[v])[c] > 0;
+	return contains(v, c) && m_clusterLevel[c->index()] >= m_oalevel[v];
 }
 bool ClusterAnalysis::isInnerActive(node v, cluster c)
 {
-	return (*m_iactive[v])[c] > 0;
+	if (contains(v, c)) return false;
+	for(adjEntry adj : v->adjEntries) {
+		if (contains(adj->twinNode(), c)) return true;
+	}
+	return false;
 }
 List<edge>& ClusterAnalysis::lcaEdges(cluster c)
 {
 	return (*m_lcaEdges)[c];
 }
-int ClusterAnalysis::bagIndex(node v, cluster c) {return (*m_bagindex[v])[c];}
+int ClusterAnalysis::bagIndex(node v, cluster c)
+{
+	return contains(v, c) ? m_bagindex[slot(v, c)] : DefaultIndex;
+}
 
 int ClusterAnalysis::indyBagIndex(node v) {
 	if (!m_indyBags)
@@ -147,15 +147,7 @@ cluster ClusterAnalysis::indyBagRoot(int i) {
 }
 //we fill all arrays that store the inner/outer activity status
 void ClusterAnalysis::init() {
-//does it make sense to split into detecting inner / outer activity?
-//is it faster to run once over the edges, with bidirectional detection
-//and a check if the edge is processed already, or is it at least almost
-//always as fast when testing from both directions?
-
-	//first outactive vertices
 	const Graph &G = m_C->constGraph();
-	m_iactive.init(G);
-	m_oactive.init(G);
 	m_ialevel.init(G, IsNotActiveBound);
 	m_oalevel.init(G, IsNotActiveBound);
 
@@ -170,204 +162,150 @@ void ClusterAnalysis::init() {
 		m_oalists = new ClusterArray<List<node> >(*m_C);
 
 	//We don't want to set dynamic depths update for clusters in m_C,
-	//therefore we just compute the values here
-	//top-down run through the cluster tree, depth 0 for the root
-	ClusterArray<int> cdepth(*m_C);
-	cdepth[m_C->rootCluster()] = 0;
-	Queue<cluster> cq;
-	for (cluster ci : m_C->rootCluster()->children) {
-		cq.append(ci);
+	//therefore we just compute the values here together with the
+	//preorder numbering, depth 0 for the root
+	const int numClusters = m_C->numberOfClusters();
+	m_clusterPre.init(m_C->maxClusterIndex()+1);
+	m_clusterLevel.init(m_C->maxClusterIndex()+1);
+	m_preCluster.init(numClusters);
+	m_preEnd.init(numClusters);
+
+	ArrayBuffer<cluster> stack;
+	stack.push(m_C->rootCluster());
+	int next = 0;
+	while (!stack.empty())
+	{
+		cluster c = stack.popRet();
+		m_clusterPre[c->index()] = next;
+		m_preCluster[next++] = c;
+		m_clusterLevel[c->index()] = (c == m_C->rootCluster()) ? 0 : m_clusterLevel[c->parent()->index()]+1;
+		for (ListConstIterator<cluster> it = c->crBegin(); it.valid(); --it)
+			stack.push(*it);
 	}
-
-	while (!cq.empty())
+	for (int p = numClusters-1; p >= 0; p--)
 	{
-		cluster cc = cq.pop();
-		cdepth[cc] = cdepth[cc->parent()]+1;
-		for(cluster ci : cc->children) {
-			cq.append(ci);
-		}
+		int end = p+1;
+		for (cluster child : m_preCluster[p]->children)
+			end = max(end, m_preEnd[m_clusterPre[child->index()]]);
+		m_preEnd[p] = end;
 	}
 
-	//store that we already visited e, as we don't have a static lookup
-	//for the paths, running the search from both directions is slower.
-	EdgeArray<bool> visited(G, false);
+	//sort the vertices by the preorder number of their cluster (stable),
+	//the vertices of a cluster subtree are then a contiguous range
+	m_preNodeStart.init(0, numClusters, 0);
 	for(node v : G.nodes)
+		m_preNodeStart[m_clusterPre[m_C->clusterOf(v)->index()]+1]++;
+	for (int p = 0; p < numClusters; p++)
+		m_preNodeStart[p+1] += m_preNodeStart[p];
+	m_preNodes.init(G.numberOfNodes());
 	{
-		// See comment on use of ClusterArrays above
-		m_iactive[v] = new ClusterArray<int>(*m_C,0,m_C->maxClusterIndex()+1);
-		m_oactive[v] = new ClusterArray<int>(*m_C,0,m_C->maxClusterIndex()+1);
+		Array<int> pos(numClusters);
+		for (int p = 0; p < numClusters; p++)
+			pos[p] = m_preNodeStart[p];
+		for(node v : G.nodes)
+			m_preNodes[pos[m_clusterPre[m_C->clusterOf(v)->index()]]++] = v;
 	}
-	for(node v : G.nodes)
-	{
-		for(adjEntry adj : v->adjEntries) {
-			edge e = adj->theEdge();
 
-			if (!visited[e])
+	//each vertex gets one slot per ancestor level, in the order of m_preNodes
+	m_slot.init(G);
+	int numSlots = 0;
+	for(node v : m_preNodes)
+	{
+		m_slot[v] = numSlots;
+		numSlots += m_clusterLevel[m_C->clusterOf(v)->index()]+1;
+	}
+	m_bagindex.init(0, numSlots-1, DefaultIndex);
+
+	//the path between v and w in the cluster tree runs from the cluster of v up
+	//to lca, and down to the cluster of w. Clusters before lca are left, i.e.
+	//v is outer active and w inner active for them; clusters behind lca are entered.
+	//The highest cluster on each side is a child of lca.
+	NodeArray<cluster> oaTop(G, nullptr); // the lca above the highest cluster v is outer active for
+	for(edge e : G.edges)
+	{
+		node v = e->source();
+		node w = e->target();
+		cluster cv = m_C->clusterOf(v);
+		cluster cw = m_C->clusterOf(w);
+		cluster lca = m_C->commonCluster(cv, cw);
+		int clevel = m_clusterLevel[lca->index()]+1;
+		for (int k = 0; k < 2; k++)
+		{
+			node x = k == 0 ? v : w;
+			node y = k == 0 ? w : v;
+			if (m_C->clusterOf(x) == lca)
+				continue;
+			if (m_oalevel[x] > clevel)
 			{
-				node w = e->opposite(v);
-				List<cluster> el; // result cluster list of path in cluster tree T between v,w
-				cluster c1,c2;   // ancestors of lca(v,w) on path, we don't really need them here
-
-				cluster lca = m_C->commonClusterAncestorsPath(v, w, c1, c2, el);
-				OGDF_ASSERT(el.size() > 0);
-				ListIterator<cluster> ctit =  el.begin();//m_C->clusterOf(v);
-
-				//run over the path, set activity status (vertices are
-				//active for a cluster if adjacent edge crosses the border
-
-				//clusters before lca are left, i.e. v is outer active
-				//clusters behind lca are entered, i.e. v is inner active
-				while (ctit.valid() && (*ctit) != lca)
-				{
-					(*m_oactive[v])[*ctit]++;
-					(*m_iactive[w])[*ctit]++;
-
-					//only count vertices a single time
-					if ((*m_oactive[v])[*ctit] == 1) (*m_oanum)[*ctit]++;
-					if ((*m_iactive[w])[*ctit] == 1) (*m_ianum)[*ctit]++;
-
-					//update the activity levels
-					//could do this just for the last in the line...
-					int clevel = cdepth[*ctit];
-					if (m_ialevel[w] > clevel)
-						m_ialevel[w] = clevel;
-					if (m_oalevel[v] > clevel)
-						m_oalevel[v] = clevel;
-
-					++ctit;
-				}
-
-				OGDF_ASSERT((*ctit) == lca);
-				//vertices are never active wrt lca
-				//we store however the corresponding edges
-				//for later use in bag detection
-				(*m_lcaEdges)[lca].pushBack(e);
-				++ctit;
-
-				while (ctit.valid())
-				{
-					(*m_iactive[v])[*ctit]++;
-					(*m_oactive[w])[*ctit]++;
-
-					if ((*m_iactive[v])[*ctit] == 1) (*m_ianum)[*ctit]++;
-					if ((*m_oactive[w])[*ctit] == 1) (*m_oanum)[*ctit]++;
-
-					//update the activity levels
-					int clevel = cdepth[*ctit];
-					//could do this just for the last in the line...
-					if (m_ialevel[v] > clevel)
-						m_ialevel[v] = clevel;
-					if (m_oalevel[w] > clevel)
-						m_oalevel[w] = clevel;
-
-					++ctit;
-				}
-
-				visited[e] = true;
-
-#ifdef OGDF_DEBUG
-				cout << "Edge "<< v << " " << w <<"\n";
-#endif
+				m_oalevel[x] = clevel;
+				oaTop[x] = lca;
 			}
+			m_ialevel[y] = min(m_ialevel[y], clevel);
 		}
-
+		//vertices are never active wrt lca
+		//we store however the corresponding edges
+		//for later use in bag detection
+		(*m_lcaEdges)[lca].pushBack(e);
 	}
-#ifdef OGDF_DEBUG
+
+	//Count the active vertices of each cluster by adding, for each vertex v,
+	//+1/-1 at the ends of the cluster tree paths v is active for and summing
+	//up over subtrees. v is outer active for the path from its cluster up to
+	//level m_oalevel[v]. The clusters v is inner active for are the union of
+	//the root paths of its neighbors' clusters minus the root path of v's cluster.
+	//A union of root paths of clusters sorted by preorder gets +1 at each
+	//cluster and -1 at the lca of each consecutive pair, its intersection
+	//with the root path of v's cluster is the root path of the deepest lca
+	//of v's cluster and a neighbor's cluster.
+	Array<int> oaDiff(0, numClusters-1, 0);
+	Array<int> iaDiff(0, numClusters-1, 0);
+	ArrayBuffer<int> neighbors;
 	for(node v : G.nodes)
 	{
-		cout << "Knoten "<<v<<" ist";
-		List<cluster> ol;
-		List<cluster> il;
-		for(cluster c : m_C->clusters)
+		cluster cv = m_C->clusterOf(v);
+		int pv = m_clusterPre[cv->index()];
+		if (oaTop[v] != nullptr)
 		{
-			if ((*m_iactive[v])[c]>0) il.pushBack(c);
-			if ((*m_oactive[v])[c]>0) ol.pushBack(c);
-		}
-		cout << " inneractive for ";
-		for (cluster ci : il) {
-			cout << ci << ", ";
+			oaDiff[pv]++;
+			oaDiff[m_clusterPre[oaTop[v]->index()]]--;
 		}
-		cout << "\n";
-		cout << " outeractive for ";
-		for (cluster ci : ol) {
-			cout << ci << ", ";
-		}
-		cout << "\n";
-	}
-
-#endif
-}
 
-// Runs through a list of vertices (starting with the one \p nodeIT points to)
-// which is expected to be a full list of cluster vertices in \p c. Depending on
-// outer activity and bag index number of the vertices, independent bags
-// are detected and a corresponding index is assigned accordingly for each vertex.
-void ClusterAnalysis::partitionCluster(ListConstIterator<node> & nodeIt, cluster c,
-		HashArray<int, List<node> > & bagNodes, HashArray<int, bool> & indyBag,
-		Skiplist<int*> & indexNumbers, Array<cluster> & bagRoots) {
-	// Run through all vertices in c
-	while (nodeIt.valid())
-	{
-		node v = *nodeIt;
-		//if vertex is outeractive, the containing bag loses its status
-		// Nodes that are already processed can never be outeractive
-		// as we traverse bottom up. They are skipped as they are part
-		// of an independent bag in an already processed cluster.
-		if (m_indyBagNumber[v] == DefaultIndex)
+		if (m_ialevel[v] != IsNotActiveBound)
 		{
-			int ind = bagIndex(v,c);
-			if (isOuterActive(v,c))
-			{
-				indyBag[ind]= false;
-			} else //don't need to add the index if vertex is oactive
+			neighbors.clear();
+			for(adjEntry adj : v->adjEntries)
+				neighbors.push(m_clusterPre[m_C->clusterOf(adj->twinNode())->index()]);
+			neighbors.quicksort();
+			int deepest = 0;
+			int prev = -1;
+			for (int q : neighbors)
 			{
-				if (!indexNumbers.isElement(&ind))
-				{
-					indexNumbers.add(new int(ind));
-				}
-				bagNodes[ind].pushBack(v); //store vertex in index' list
+				if (q == prev) continue;
+				iaDiff[q]++;
+				if (prev != -1)
+					iaDiff[m_clusterPre[m_C->commonCluster(m_preCluster[prev], m_preCluster[q])->index()]]--;
+				int d = m_clusterPre[m_C->commonCluster(cv, m_preCluster[q])->index()];
+				if (m_clusterLevel[m_preCluster[d]->index()] > m_clusterLevel[m_preCluster[deepest]->index()])
+					deepest = d;
+				prev = q;
 			}
+			iaDiff[deepest]--;
 		}
-#ifdef OGDF_DEBUG
-		if (m_indyBagNumber[v] != DefaultIndex)
-			OGDF_ASSERT(!isOuterActive(v,c));
-#endif
-
-		++nodeIt;
 	}
-	// Now we have all indexes of bags that don't solely contain oactive vertices.
-	// For each index we check if the bag still has independency status,
-	// in this case we have found an independent bag and can remove all its
-	// vertices (mark them).
-
-#if 0
-	cout << "Checking skiplist\n";
-#endif
-	SkiplistIterator<int*> its = indexNumbers.begin();
-	while (its.valid())
+	for (int p = numClusters-1; p >= 0; p--)
 	{
-		int bind = *(*its);
-#if 0
-		cout << "Found index "<< bind <<"\n";
-#endif
-		if (indyBag[bind])
+		cluster c = m_preCluster[p];
+		(*m_oanum)[c] = oaDiff[p];
+		(*m_ianum)[c] = iaDiff[p];
+		if (p > 0)
 		{
-#ifdef OGDF_DEBUG
-			Logger::slout()  << "Found independent bag with "<< bagNodes[bind].size() << "vertices\n";
-#endif
-
-			for (node v : bagNodes[bind]) {
-				// Assign the final index number
-				m_indyBagNumber[v] = m_numIndyBags;
-			}
-			bagRoots[m_numIndyBags] = c;
-			m_numIndyBags++;
+			int parent = m_clusterPre[c->parent()->index()];
+			oaDiff[parent] += oaDiff[p];
+			iaDiff[parent] += iaDiff[p];
 		}
-
-		delete *its;
-		++its;
 	}
-}//partitionCluster
+}
+
 // For each cluster we check if we can identify an independent
 // bag, which might be useful for clustered planarity testing.
 // compute independent bag affiliation for all vertices,
@@ -379,304 +317,181 @@ void ClusterAnalysis::computeIndyBags() {
 	m_numIndyBags = 0; //used both to count the bags and to store current
 					   //indyBag index number for vertex assignment (i.e., starts with 1)
 	const Graph &G = m_C->constGraph();
+	const int n = G.numberOfNodes();
 
 	// Store the root cluster of each indyBag
-	delete m_indyBagRoots;
+	delete[] m_indyBagRoots;
 	// Intermediate storage during computation, maximum of #vertices possible
-#ifdef OGDF_DEBUG
-	Array<cluster> bagRoots(0,G.numberOfNodes(),nullptr);
-#else
-	Array<cluster> bagRoots(G.numberOfNodes());
-#endif
+	Array<cluster> bagRoots(0, n, nullptr);
 
 	// Store indyBag affiliation. Every vertex will get a number != -1 (DefaultIndex,
 	// as in the worst case the whole graph is an indyBag (in root cluster).
 	// Once assigned, the number won't change during the processing.
-	m_indyBagNumber.init(G, DefaultIndex);
-
-	// We run bottom up over all clusters (to find the minimum inclusion).
-	// For each vertex, we use the outer activity and bag index information.
-	// In case we find a bag without outeractive vertices it is a IndyBag.
-	// Already processed vertices are simply marked by an indyBag index entry different to -1.
-#if 0
-	NodeArray<bool> processed(G, false); //mark vertices when IndyBag detected
-#endif
-
-	// We do not have the sets of vertices for all bags, as only the bag index
-	// has been stored for a cluster.
-	// Detect the current leaf clusters for bottom up traversal.
-	List<cluster> ccleafs;
-	ClusterArray<int> unprocessedChildren(*m_C); //processing below: compute bags
-	for(cluster c : m_C->clusters)
-	{
-		if (c->cCount() == 0) ccleafs.pushBack(c);
-		unprocessedChildren[c] = c->cCount();
+	// During the computation, vertices are addressed by their position in m_preNodes.
+	Array<int> indyBagNumber(0, n, DefaultIndex);
+	Array<int> slots(0, n, 0);
+	Array<int> oalevel(0, n, 0);
+	for (int i = 0; i < n; i++) {
+		slots[i] = m_slot[m_preNodes[i]];
+		oalevel[i] = m_oalevel[m_preNodes[i]];
 	}
-	OGDF_ASSERT(!ccleafs.empty());
-
-	// Run through all clusters, leaves first.
-	while (!ccleafs.empty()){
-		// We cannot store the following information over the whole
-		// graph even though the bag index (which is one out of the
-		// set of vertex set ids in union find) would allow this.
-		// The bag index is defined per cluster.
-		// However, when moving up in the cluster tree indy information
-		// is not monotone, we therefore would need to update it accordingly.
-		// (Bag which is not outeractive will not become outeractive, but
-		// may get a part of an outeractive bag with the same id, and an
-		// outeractive bag might become enclosed).
-		HashArray<int, bool> indyBag(true); //true if bag with index i does
-											//not have outeractive vertices
-		// We want to store all vertices for each index that may be a
-		// potential indyBag index. We could add these in the entry stored
-		// in our index Skiplist, but then we need a comparison of the
-		// respecting class objects, slowing down the processing.
-		HashArray<int, List<node> > bagNodes; //holds vertices for index i
-
-		// We need a data structure that holds all indexes used, allows
-		// to search for them and to iterate through them. Could use
-		// insertion sorted dynamically allocated array here, but as
-		// SkipLists are implemented in OGDF, which provide comparable
-		// efficiency, we use them.
-		Skiplist<int*> indexNumbers; //holds all index numbers in c
-
-		cluster c = ccleafs.popFrontRet();
-
-		List<node> nodes;
-		ListConstIterator<node> it;
-		// Process leaves separately. As long as we don't do something
-		// special for non-leaves, we could just use getClusterNodes instead.
-		if (c->cCount() == 0) {
-			it = c->nBegin();
-		}
-		else {
-			// At this point all child clusters of c have been processed.
-			// This is somewhat slow, as we repeatedly collect the vertices
-			// Todo: Instead, we could clone the clusternodes code
-			// here and process them as we see them.
 
-			c->getClusterNodes(nodes);
+	// Bag indices are union-find ids, i.e. numbers smaller than n. For the
+	// current cluster we mark the bags seen (by the cluster's preorder number),
+	// whether they are still independent, and chain their vertices.
+	Array<int> seen(0, n, -1);
+	Array<bool> indyBag(0, n, true);
+	Array<int> bagFirst(0, n, -1);
+	Array<int> nextInBag(0, n, -1);
+	ArrayBuffer<int> indexNumbers;
+
+	// We run bottom up over all clusters (to find the minimum inclusion),
+	// i.e., in descending preorder. In case we find a bag without
+	// outeractive vertices it is a IndyBag. Already processed vertices are
+	// simply marked by an indyBag index entry different to -1. Nodes that
+	// are already processed can never be outeractive as we traverse bottom up.
+	for (int p = m_C->numberOfClusters()-1; p >= 0; p--)
+	{
+		const cluster c = m_preCluster[p];
+		const int level = m_clusterLevel[c->index()];
+		indexNumbers.clear();
 
-#if 0
-			cout <<"Processing cluster with "<<nodes.size()<<"\n";
-#endif
+		for (int i = m_preNodeStart[p]; i < m_preNodeStart[m_preEnd[p]]; i++)
+		{
+			if (indyBagNumber[i] != DefaultIndex)
+			{
+				OGDF_ASSERT(level < oalevel[i]);
+				continue;
+			}
 
-			it = nodes.begin();
+			int ind = m_bagindex[slots[i] + level];
+			if (seen[ind] != p)
+			{
+				seen[ind] = p;
+				indyBag[ind] = true;
+				bagFirst[ind] = -1;
+				indexNumbers.push(ind);
+			}
+			//if vertex is outeractive, the containing bag loses its status
+			if (level >= oalevel[i])
+			{
+				indyBag[ind] = false;
+			} else
+			{
+				nextInBag[i] = bagFirst[ind];
+				bagFirst[ind] = i;
+			}
 		}
-		// Run through all vertices in c
-		partitionCluster(it, c, bagNodes, indyBag, indexNumbers, bagRoots);
-		// Now we update the status of the parent cluster and,
-		// in case all its children are processed, add it to
-		// the process queue.
-		if (c != m_C->rootCluster())
+
+		// For each index we check if the bag still has independency status,
+		// in this case we have found an independent bag and can remove all its
+		// vertices (mark them).
+		indexNumbers.quicksort();
+		for (int ind : indexNumbers)
 		{
-			OGDF_ASSERT(unprocessedChildren[c->parent()] > 0);
-			unprocessedChildren[c->parent()]--;
-			if (unprocessedChildren[c->parent()] == 0) ccleafs.pushBack(c->parent());
+			if (indyBag[ind] && bagFirst[ind] != -1)
+			{
+				for (int i = bagFirst[ind]; i != -1; i = nextInBag[i]) {
+					// Assign the final index number
+					indyBagNumber[i] = m_numIndyBags;
+				}
+				bagRoots[m_numIndyBags] = c;
+				m_numIndyBags++;
+			}
 		}
-	}//while clusters
-	// Copying into smaller array is a bit slower than just reserving the whole #v array,
-	// but we do it anyway.
-	m_indyBagRoots = new cluster[m_numIndyBags];
-	for (int k = 0; k < m_numIndyBags; k++)
-	{
-		OGDF_ASSERT(bagRoots[k] != nullptr);
-		m_indyBagRoots[k] = bagRoots[k];
-	}
-#ifdef OGDF_DEBUG
-#if 0
-	List<node> rnodes;
-	m_C->rootCluster()->getClusterNodes(rnodes);
-
-	for(node v : rnodes) {
-		cout << "Root bag index: "<<bagIndex(v, m_C->rootCluster())<<"\n";
-		cout << "Indy bag index: "<<m_indyBagNumber[v]<<"\n";
 	}
-#endif
 
-	Skiplist<int*> ibind;
-	for(node v : G.nodes)
+	m_indyBagNumber.init(G);
+	for (int i = 0; i < n; i++)
 	{
-		int i = m_indyBagNumber[v];
-		if (!ibind.isElement(&i))
-		{
-			ibind.add(new int(i));
-		}
-		cout << "numIndyBags: "<<m_numIndyBags<<" i: "<<i<<"\n";
-		OGDF_ASSERT(i != DefaultIndex);
-		OGDF_ASSERT(i >= 0);
-		OGDF_ASSERT(i < m_numIndyBags);
-
+		OGDF_ASSERT(indyBagNumber[i] >= 0);
+		OGDF_ASSERT(indyBagNumber[i] < m_numIndyBags);
+		m_indyBagNumber[m_preNodes[i]] = indyBagNumber[i];
 	}
-	int storedBags = 0;
-	SkiplistIterator<int*> its = ibind.begin();
-	while (its.valid())
+
+	m_indyBagRoots = new cluster[m_numIndyBags];
+	for (int k = 0; k < m_numIndyBags; k++)
 	{
-		storedBags++;
-		delete *its;
-		++its;
+		OGDF_ASSERT(bagRoots[k] != nullptr);
+		m_indyBagRoots[k] = bagRoots[k];
 	}
-	Logger::slout() << m_numIndyBags<< " independent bags detected, "<<storedBags<<" stored\n";
-	OGDF_ASSERT(m_numIndyBags==storedBags);
-#endif
 }
 
 //compute bag affiliation for all vertices
 //store result in m_bagindex
 void ClusterAnalysis::computeBags() {
 	const Graph &G = m_C->constGraph();
-
-	// Storage structure for results
-	m_bagindex.init(G);
-	// We use Union-Find for chunks and bags
-	DisjointSets<> uf;
-	NodeArray<int> setid(G); // Index mapping for union-find
-#if 0
-	node* nn = new node[G.numberOfNodes()]; // dito
-#endif
-
-	// Every cluster gets its index
-	ClusterArray<int> cind(*m_C);
-	// We store the lists of cluster vertices
-	List<node>* clists = new List<node>[m_C->numberOfClusters()];
-	int i = 0;
-
-	// Store index and detect the current leaf clusters
-	List<cluster> ccleafs;
-	ClusterArray<int> unprocessedChildren(*m_C); //processing below: compute bags
-	for(cluster c : m_C->clusters)
-	{
-		cind[c] = i++;
-		if (c->cCount() == 0) ccleafs.pushBack(c);
-		unprocessedChildren[c] = c->cCount();
+	const int n = G.numberOfNodes();
+
+	// We use Union-Find for chunks and bags, the set of a vertex
+	// is its position in m_preNodes
+	DisjointSets<> uf(max(n, 1));
+	for (int i = 0; i < n; i++)
+		uf.makeSet();
+	NodeArray<int> pos(G);
+	Array<int> slots(0, n, 0);
+	Array<int> oalevel(0, n, 0);
+	for (int i = 0; i < n; i++) {
+		pos[m_preNodes[i]] = i;
+		slots[i] = m_slot[m_preNodes[i]];
+		oalevel[i] = m_oalevel[m_preNodes[i]];
 	}
 
-
-	// Now we run through all vertices, storing them in the parent lists,
-	// at the same time, we initialize m_bagindex
-	for(node v : G.nodes)
+	auto unite = [&](int s1, int s2) {
+		s1 = uf.find(s1);
+		s2 = uf.find(s2);
+		if (s1 != s2)
+			uf.link(s1, s2);
+	};
+
+	// Marks the bag ids already counted for the current cluster.
+	Array<int> seen(0, n, -1);
+	ArrayBuffer<int> bagIds;
+
+	// We process the clusters bottom-up, i.e. in descending preorder.
+	// Bags are updated as follows: chunks may be linked by exactly
+	// the edges with lca(c) ie the ones in m_lcaEdges[c] (for leaves,
+	// these are the edges inside the cluster), and bags may be built
+	// by direct child clusters that join chunks. The vertices of each
+	// cluster subtree form a contiguous range in m_preNodes.
+	for (int p = m_C->numberOfClusters()-1; p >= 0; p--)
 	{
-		// setid is constant in the following
-		setid[v] = uf.makeSet();
-		// Each vertex v gets its own ClusterArray that stores v's bag index per cluster.
-		// See comment on use of ClusterArrays above
-		m_bagindex[v] = new ClusterArray<int>(*m_C,DefaultIndex, m_C->maxClusterIndex()+1);//m_C->numberOfClusters());
-		cluster c = m_C->clusterOf(v);
-		// Push vertices in parent list
-		clists[cind[c]].pushBack(v);
-	}
+		const cluster c = m_preCluster[p];
+		const int level = m_clusterLevel[c->index()];
 
-	// Now each clist contains the direct vertex descendants
-	// We process the clusters bottom-up, compute the chunks
-	// of the leafs first. At each level, for a cluster the
-	// vertex lists of all children are concatenated
-	// (could improve this by having an array of size(#leafs)
-	// and concatenating only at child1), then the bags are
-	// updated as follows: chunks may be linked by exactly
-	// the edges with lca(c) ie the ones in m_lcaEdges[c],
-	// and bags may be built by direct child clusters that join chunks.
-	// While concatenating the vertex lists, we can check
-	// for the vertices in each child if the uf number is the same
-	// as the one of a first initial vertex, otherwise we join.
-
-	// First, lowest level clusters are processed: All chunks are bags
-
-
-	OGDF_ASSERT(!ccleafs.empty());
-
-	while (!ccleafs.empty()){
-		const cluster c = ccleafs.popFrontRet();
-		Skiplist<int*> cbags; //Stores bag indexes ocurring in c
-
-		auto storeResult = [&] {
-			for (node v : clists[cind[c]]) {
-				int theid = uf.find(setid[v]);
-				(*m_bagindex[v])[c] = theid;
-				if (!cbags.isElement(&theid)) {
-					cbags.add(new int(theid));
-				}
-				// push into list of outer active vertices
-				if (m_storeoalists && isOuterActive(v, c)) {
-					(*m_oalists)[c].pushBack(v);
-				}
-			}
-			(*m_bags)[c] = cbags.size(); // store number of bags of c
-		};
+		// Edge links
+		for(edge e : (*m_lcaEdges)[c]) {
+			unite(pos[e->source()], pos[e->target()]);
+		}
 
 		if (m_storeoalists){
 			//no outeractive vertices detected so far
 			(*m_oalists)[c].clear();
 		}
 
-		//process leafs separately
-		if (c->cCount() == 0) {
-
-
-			//Todo could use lcaEdges list here too, see below
-			for (node u : c->nodes)
-			{
-				for(adjEntry adj : u->adjEntries) {
-					node w = adj->twinNode();
-					if (m_C->clusterOf(w) == c)
-					{
-						uf.link(uf.find(setid[u]),uf.find(setid[w]));
-					}
-				}
-			}
-			// Now all chunks in the leaf cluster are computed
-			// update for parent is done in the else case
-
-			storeResult();
-		}
-		else {
-			// ?We construct the vertex list by concatenating
-			// ?the lists of the children to the current list.
-			// We need the lists for storing the results efficiently.
-			// (Should be slightly faster than to call clusterNodes each time)
-			// Bags are either links of chunks by edges with lca==c
-			// or links of chunk by child clusters.
-			// Edge links
-			for(edge e : (*m_lcaEdges)[c]) {
-				uf.link(uf.find(setid[e->source()]),uf.find(setid[e->target()]));
+		bagIds.clear();
+		for (int i = m_preNodeStart[p]; i < m_preNodeStart[m_preEnd[p]]; i++)
+		{
+			int theid = uf.find(i);
+			m_bagindex[slots[i] + level] = theid;
+			if (seen[theid] != p) {
+				seen[theid] = p;
+				bagIds.push(theid);
 			}
-
-			// Cluster links
-			for(cluster cc : c->children)
-			{
-				//Initial id per child cluster cc: Use value of first
-				//vertex, each time we encounter a different value in cc,
-				//we link the chunks
-
-				//add (*itcc)'s vertices to c's list
-				ListConstIterator<node> itvc = clists[cind[cc]].begin();
-				int inid;
-				if (itvc.valid()) inid = uf.find(setid[*itvc]);
-				while (itvc.valid())
-				{
-					int theid = uf.find(setid[*itvc]);
-
-					if (theid != inid)
-						uf.link(inid,theid);
-					clists[cind[c]].pushBack(*itvc);
-					++itvc;
-				}
+			// push into list of outer active vertices
+			if (m_storeoalists && level >= oalevel[i]) {
+				(*m_oalists)[c].pushBack(m_preNodes[i]);
 			}
-
-			storeResult();
-		}
-		// Now we update the status of the parent cluster and,
-		// in case all its children are processed, add it to
-		// the process queue.
-		if (c != m_C->rootCluster())
-		{
-			OGDF_ASSERT(unprocessedChildren[c->parent()] > 0);
-			unprocessedChildren[c->parent()]--;
-			if (unprocessedChildren[c->parent()] == 0) ccleafs.pushBack(c->parent());
 		}
-	}//while cluster
+		(*m_bags)[c] = bagIds.size(); // store number of bags of c
 
-	// clean up
-	delete[] clists;
+		// Cluster links: c joins its bags in its parent. This can be done
+		// right away, as the sets processed before the parent are disjoint
+		// from the vertices of c.
+		for (int theid : bagIds) {
+			unite(bagIds[0], theid);
+		}
+	}
 }
 
 
@@ -37,6 +37,7 @@
 #include <ogdf/cluster/ClusterArray.h>
 #include <ogdf/cluster/ClusterGraphObserver.h>
 #include <ogdf/basic/AdjEntryArray.h>
+#include <ogdf/basic/ArrayBuffer.h>
 
 using std::mutex;
 #ifndef OGDF_MEMORY_POOL_NTS
@@ -80,10 +81,7 @@ ClusterGraph::ClusterGraph() : m_pGraph(nullptr)
 
 	m_clusterArrayTableSize = MIN_CLUSTER_TABLE_SIZE;
 	m_adjAvailable = false;
-	m_lcaNumber = 0;
-	m_lcaSearch = nullptr;
-	m_vAncestor = nullptr;
-	m_wAncestor = nullptr;
+	m_treeIndexValid = false;
 }
 
 
@@ -99,16 +97,13 @@ ClusterGraph::ClusterGraph(const Graph &G) : GraphObserver(&G), m_pGraph(&G)
 	m_updateDepth   = false;
 	m_depthUpToDate = false;
 
-	m_lcaNumber = 0;
 	m_clusterArrayTableSize = G.nextPower2(MIN_CLUSTER_TABLE_SIZE, G.nodeArrayTableSize());
 	initGraph(G);
 }
 
 
 ClusterGraph::ClusterGraph(const ClusterGraph &C) : GraphObserver(C.m_pGraph),
-	m_lcaSearch(nullptr),
-	m_vAncestor(nullptr),
-	m_wAncestor(nullptr)
+	m_treeIndexValid(false)
 {
 	m_clusterIdCount = 0;
 	m_postOrderStart = nullptr;
@@ -118,7 +113,6 @@ ClusterGraph::ClusterGraph(const ClusterGraph &C) : GraphObserver(C.m_pGraph),
 	m_updateDepth   = false;
 	m_depthUpToDate = false;
 
-	m_lcaNumber = 0;
 
 	m_clusterArrayTableSize = C.m_clusterArrayTableSize;
 	shallowCopy(C);
@@ -132,9 +126,7 @@ ClusterGraph::ClusterGraph(
 	NodeArray<node> &originalNodeTable)
 :
 	GraphObserver(&G),
-	m_lcaSearch(nullptr),
-	m_vAncestor(nullptr),
-	m_wAncestor(nullptr)
+	m_treeIndexValid(false)
 {
 	m_clusterIdCount = 0;
 	m_postOrderStart = nullptr;
@@ -144,7 +136,6 @@ ClusterGraph::ClusterGraph(
 	m_updateDepth   = false;
 	m_depthUpToDate = false;
 
-	m_lcaNumber = 0;
 
 	m_clusterArrayTableSize = C.m_clusterArrayTableSize;
 	deepCopy(C,G,originalClusterTable,originalNodeTable);
@@ -159,9 +150,7 @@ ClusterGraph::ClusterGraph(
 	EdgeArray<edge> &edgeCopy)
 :
 	GraphObserver(&G),
-	m_lcaSearch(nullptr),
-	m_vAncestor(nullptr),
-	m_wAncestor(nullptr)
+	m_treeIndexValid(false)
 {
 	m_clusterIdCount = 0;
 	m_postOrderStart = nullptr;
@@ -171,7 +160,6 @@ ClusterGraph::ClusterGraph(
 	m_updateDepth   = false;
 	m_depthUpToDate = false;
 
-	m_lcaNumber = 0;
 
 	m_clusterArrayTableSize = C.m_clusterArrayTableSize;
 	deepCopy(C, G, originalClusterTable, originalNodeTable, edgeCopy);
@@ -180,9 +168,7 @@ ClusterGraph::ClusterGraph(
 
 ClusterGraph::ClusterGraph(const ClusterGraph &C,Graph &G) :
 	GraphObserver(&G),
-	m_lcaSearch(nullptr),
-	m_vAncestor(nullptr),
-	m_wAncestor(nullptr)
+	m_treeIndexValid(false)
 {
 	m_clusterIdCount = 0;
 	m_postOrderStart = nullptr;
@@ -192,7 +178,6 @@ ClusterGraph::ClusterGraph(const ClusterGraph &C,Graph &G) :
 	m_updateDepth   = false;
 	m_depthUpToDate = false;
 
-	m_lcaNumber = 0;
 
 	m_clusterArrayTableSize = C.m_clusterArrayTableSize;
 	deepCopy(C,G);
@@ -217,7 +202,6 @@ void ClusterGraph::init(const Graph &G)
 	m_postOrderStart = nullptr;
 	m_pGraph = &G;
 
-	m_lcaNumber = 0;
 	m_clusterArrayTableSize = G.nextPower2(MIN_CLUSTER_TABLE_SIZE, G.nodeArrayTableSize());
 	initGraph(G);
 }
@@ -271,8 +255,6 @@ void ClusterGraph::shallowCopy(const ClusterGraph &C)
 
 	for(node v : G.nodes)
 		reassignNode(v,originalClusterTable[C.clusterOf(v)]);
-
-	copyLCA(C);
 }
 
 
@@ -282,11 +264,7 @@ void ClusterGraph::initGraph(const Graph &G)
 {
 	reregister(&G); //will in some constructors cause double registration
 
-	m_lcaNumber = 0;
-	m_lcaSearch = nullptr;
-	m_vAncestor = nullptr;
-	m_wAncestor = nullptr;
-
+	m_treeIndexValid = false;
 	m_adjAvailable = false;
 
 	// root cluster must always get id 0
@@ -418,103 +396,150 @@ void ClusterGraph::deepCopy(
 
 	for(node v : G.nodes)
 		reassignNode(v,originalClusterTable[C.clusterOf(orig[v])]);
-
-	copyLCA(C);
 }
 
 
-//We search for the lowest common cluster of a set of nodes.
-//We first compute the common path of two nodes, then update path if root
-//path from other nodes hits it .
-//We always stop if we encounter root cluster.
+//We search for the lowest common cluster of a set of nodes
+//by folding constant time lca queries over the list.
 cluster ClusterGraph::commonCluster(SList<node>& nodes)
 {
-	//worst case running time #nodes x clustertreeheight-1
-	//always <= complete tree run
-	//we could even use pathcompression...
-	//at any time, we stop if root is encountered as lowest
-	//common cluster of a node subset
+	if (nodes.empty()) return nullptr;
 
+	SListConstIterator<node> it = nodes.begin();
+	cluster lowestCommon = clusterOf(*it);
+	for (++it; it.valid() && lowestCommon != m_rootCluster; ++it)
+		lowestCommon = commonCluster(lowestCommon, clusterOf(*it));
 
-	if (nodes.empty()) return nullptr;
+	return lowestCommon;
+}//commoncluster
 
-	//For simplicity, we use cluster arrays
-	ClusterArray<int> commonPathHit(*this, 0); //count for clusters path hits
-	int runs = 0; //number of nodes already considered
-	cluster pathCluster;
-	SListIterator<node> sIt = nodes.begin();
-	node v1 = (*sIt);
-	if (nodes.size() == 1) return clusterOf(v1);
-	++sIt;
-	node v2 = (*sIt);
-
-	cluster lowestCommon = commonCluster(v1, v2);
-	commonPathHit[lowestCommon] = 2;
-	pathCluster = lowestCommon;
-	while (pathCluster->parent())
-	{
-		pathCluster = pathCluster->parent();
-		commonPathHit[pathCluster] = 2;
+
+//The cluster tree is stored in preorder: the subtree of the cluster with
+//preorder number p occupies the range [p, m_preEnd[p]). For p < q with q
+//not in the subtree of p, the lca is the parent of the shallowest cluster
+//in (p, q], which we find with a sparse table range minimum query.
+void ClusterGraph::doBuildTreeIndex() const
+{
+	const int n = numberOfClusters();
+	m_preIndex.init(maxClusterIndex() + 1);
+	m_preCluster.init(n);
+	m_preDepth.init(n);
+	m_preParent.init(n);
+	m_preEnd.init(n);
+	m_childStart.init(n + 1);
+	m_childPre.init(n - 1);
+
+	// iterative dfs, children are numbered in the order of the children lists
+	ArrayBuffer<cluster> stack;
+	stack.push(m_rootCluster);
+	int next = 0;
+	while (!stack.empty()) {
+		cluster c = stack.popRet();
+		int p = next++;
+		m_preIndex[c->index()] = p;
+		m_preCluster[p] = c;
+		if (c == m_rootCluster) {
+			m_preParent[p] = -1;
+			m_preDepth[p] = 0;
+		} else {
+			m_preParent[p] = m_preIndex[c->parent()->index()];
+			m_preDepth[p] = m_preDepth[m_preParent[p]] + 1;
+		}
+		for (ListConstIterator<cluster> itC = c->crBegin(); itC.valid(); --itC)
+			stack.push(*itC);
 	}
-	runs = 2;
-	//we save direct lca access, it also lies on a runs hit path from root
-	while ((runs < nodes.size()) && (lowestCommon != m_rootCluster))
-	{
-		++sIt;
-		node v = (*sIt);
-		pathCluster = clusterOf(v);
-		while (commonPathHit[pathCluster] == 0)
-		{
-			if (pathCluster->parent()) pathCluster = pathCluster->parent();
-			else return m_rootCluster; //can never happen
-		}//while
-		//assign new (maybe same) lowest common
-		if (commonPathHit[pathCluster] == runs) lowestCommon = pathCluster;
-		commonPathHit[pathCluster] = commonPathHit[pathCluster]+1;
-		if (pathCluster == m_rootCluster) return m_rootCluster;
-		//update hits in path to root
-		while (pathCluster->parent())
-		{
-			pathCluster = pathCluster->parent();
-			commonPathHit[pathCluster] = commonPathHit[pathCluster]+1;
+	OGDF_ASSERT(next == n);
+
+	// subtree ends bottom-up, children grouped by parent
+	for (int p = n - 1; p >= 0; --p) {
+		int end = p + 1;
+		for (cluster child : m_preCluster[p]->children)
+			end = max(end, m_preEnd[m_preIndex[child->index()]]);
+		m_preEnd[p] = end;
+	}
+	int k = 0;
+	for (int p = 0; p < n; ++p) {
+		m_childStart[p] = k;
+		for (cluster child : m_preCluster[p]->children)
+			m_childPre[k++] = m_preIndex[child->index()];
+	}
+	m_childStart[n] = k;
+
+	// level j of the table holds the shallowest preorder number in [p, p + 2^j)
+	int levels = 1;
+	while ((1 << levels) <= n) ++levels;
+	m_lcaTable.init(levels * n);
+	for (int p = 0; p < n; ++p)
+		m_lcaTable[p] = p;
+	for (int j = 1; j < levels; ++j) {
+		const int half = 1 << (j - 1);
+		const int *prev = &m_lcaTable[(j - 1) * n];
+		int *cur = &m_lcaTable[j * n];
+		for (int p = 0; p + 2 * half <= n; ++p) {
+			int a = prev[p], b = prev[p + half];
+			cur[p] = m_preDepth[b] < m_preDepth[a] ? b : a;
 		}
-
-		runs++;
 	}
 
-	return lowestCommon;
-}//commoncluster
+	m_treeIndexValid = true;
+}
 
-#if 0
-//lowest common cluster of v,w
-cluster ClusterGraph::commonCluster(node v, node w) const
+
+cluster ClusterGraph::commonCluster(cluster c, cluster d) const
 {
-	cluster c1, c2;
-	return commonClusterLastAncestors(v, w, c1, c2);
-}//commonCluster
+	OGDF_ASSERT(c->graphOf() == this);
+	OGDF_ASSERT(d->graphOf() == this);
+
+	if (c == d) return c;
+	buildTreeIndex();
+
+	int p = m_preIndex[c->index()];
+	int q = m_preIndex[d->index()];
+	if (p > q) std::swap(p, q);
+	if (q < m_preEnd[p]) return m_preCluster[p];
+
+	// shallowest cluster in (p, q] is a child of the lca
+	const int n = numberOfClusters();
+	int j = 0;
+	while ((2 << j) <= q - p) ++j;
+	int a = m_lcaTable[j * n + p + 1];
+	int b = m_lcaTable[j * n + q - (1 << j) + 1];
+	int child = m_preDepth[b] < m_preDepth[a] ? b : a;
+	return m_preCluster[m_preParent[child]];
+}
+
 
-//lowest common cluster of v,w and its ancestors
+//lowest common cluster of v,w and the children of it containing v and w
 cluster ClusterGraph::commonClusterLastAncestors(
 	node v,
 	node w,
 	cluster& c1,
 	cluster& c2) const
 {
-	List<cluster> e;
-	return commonClusterAncestorsPath(v, w, c1, c2, e);
-}//commonClusterLastAncestors
+	cluster cv = clusterOf(v);
+	cluster cw = clusterOf(w);
+	if (cv == cw) {
+		c1 = c2 = cv;
+		return cv;
+	}
 
-//lowest common cluster and path between v and w containing it
-//note that eL is directed from v to w
-cluster ClusterGraph::commonClusterPath(
-	node v,
-	node w,
-	List<cluster>& eL) const
-{
-	cluster c1, c2;
-	return commonClusterAncestorsPath(v, w, c1, c2, eL);
+	cluster lca = commonCluster(cv, cw);
+
+	// binary search for the child subtree containing c among the children of lca
+	auto lastAncestor = [&](cluster c) -> cluster {
+		if (c == lca) return nullptr;
+		int q = m_preIndex[c->index()];
+		const int p = m_preIndex[lca->index()];
+		const int *first = m_childPre.begin() + m_childStart[p];
+		const int *last = m_childPre.begin() + m_childStart[p + 1];
+		return m_preCluster[*(std::upper_bound(first, last, q) - 1)];
+	};
+
+	c1 = lastAncestor(cv);
+	c2 = lastAncestor(cw);
+	return lca;
 }//commonClusterLastAncestors
-#endif
+
 
 //note that eL is directed from v to w
 cluster ClusterGraph::commonClusterAncestorsPath(
@@ -530,10 +555,6 @@ cluster ClusterGraph::commonClusterAncestorsPath(
 	cluster cv = clusterOf(v);
 	cluster cw = clusterOf(w);
 
-	//clusters from v and w to common
-	List<cluster> vList;
-	List<cluster> wList;
-
 	//CASE1 no search necessary
 	//if both nodes are in the same cluster, we return this cluster
 	//and have to check if c1 == c2 to have a (v,w) representation edge
@@ -544,135 +565,23 @@ cluster ClusterGraph::commonClusterAncestorsPath(
 		return cv;
 	}
 
-	if (m_lcaNumber == numeric_limits<int>::max() - 1) m_lcaNumber = 0;
-	else m_lcaNumber++;
-	if (!m_lcaSearch)
-	{
-		m_lcaSearch = new ClusterArray<int>(*this, -1);
-		m_vAncestor = new ClusterArray<cluster>(*this, nullptr);
-		m_wAncestor = new ClusterArray<cluster>(*this, nullptr);
-	}
-
-	//CASE2: one of the nodes hangs at root: save root as ancestor
-	//any other case: save cluster of node as ancestor, too, to check this
-	//case:: common = xCluster != yCluster
-#if 0
-	(*m_vAncestor)[rootCluster()] = rootCluster();
-	(*m_wAncestor)[rootCluster()] = rootCluster();
-#endif
-	(*m_vAncestor)[cv] = nullptr;
-	(*m_wAncestor)[cw] = nullptr;
+	cluster lca = commonCluster(cv, cw);
 
-	//we rely on the fact all nodes are in the rootcluster or
-	//that parent is initialized to zero to terminate
-
-	//we start with different clusters due to CASE1
-	//save the ancestor information
-	(*m_lcaSearch)[cw] = m_lcaNumber; //not really necessary, we won't return
-	(*m_lcaSearch)[cv] = m_lcaNumber;
-	vList.pushBack(cv);
-	wList.pushBack(cw);
-
-	//we break and return if we find a common node
-	//before we reach the rootcluster
-	do
-	{
-		if (cv->parent()) //root reached?
-		{
-			(*m_vAncestor)[cv->parent()] = cv;
-			cv = cv->parent();
-			//was cv visited on path from w
-			if ((*m_lcaSearch)[cv] == m_lcaNumber)
-			{
-				c1 = (*m_vAncestor)[cv];
-				c2 = (*m_wAncestor)[cv];
-				//setup list
-				ListIterator<cluster> itC = vList.begin();
-
-				while (itC.valid())
-				{
-					eL.pushBack(*itC);
-					++itC;
-				}
-				itC = wList.rbegin();
-				while (itC.valid() && ((*itC) != cv))
-					--itC;
-				while (itC.valid())
-				{
-					eL.pushBack(*itC);
-					--itC;
-				}
-
-				return cv;
-			}
-			vList.pushBack(cv);
-			(*m_lcaSearch)[cv] = m_lcaNumber;
-		}//if not root reached on cvpath
-
-		if (cw->parent())
-		{
-			(*m_wAncestor)[cw->parent()] = cw;
-			cw = cw->parent();
-			//was cw visited on path from v
-			if ((*m_lcaSearch)[cw] == m_lcaNumber)
-			{
-				c1 = (*m_vAncestor)[cw];
-				c2 = (*m_wAncestor)[cw];
-				//setup list
-				ListIterator<cluster> itC = vList.begin();
-				while (itC.valid() && ((*itC) != cw))
-				{
-					eL.pushBack(*itC);
-					++itC;
-				}
-
-				eL.pushBack(cw);
-
-				itC = wList.rbegin();
-				while (itC.valid())
-				{
-					eL.pushBack(*itC);
-					--itC;
-				}
-
-				return cw;
-			}
-			wList.pushBack(cw);
-			(*m_lcaSearch)[cw] = m_lcaNumber;
-
-		}//if not root reached on cwpath
-	}	while ( cv->parent() || cw->parent() );
-
-	//v,w should be at least together in the rootcluster
-	c1 = (*m_vAncestor)[rootCluster()];
-	c2 = (*m_wAncestor)[rootCluster()];
-
-	return rootCluster();
-
-}//commonclusterlastAncestors
-
-
-void ClusterGraph::copyLCA(
-	const ClusterGraph &C)
-{
-	if (m_lcaSearch)
-	{
-		delete m_lcaSearch;
-		delete m_vAncestor;
-		delete m_wAncestor;
+	//the path from v up to lca is appended, the path from w
+	//is inserted directly behind lca in reverse order
+	c1 = c2 = nullptr;
+	for (cluster c = cv; c != lca; c = c->parent()) {
+		eL.pushBack(c);
+		c1 = c;
 	}
-	if (C.m_lcaSearch)
-	{
-		//otherwise, initialization won't work
-		m_clusterArrayTableSize = C.m_clusterArrayTableSize;
-
-		m_lcaSearch = new ClusterArray<int>(*this, -1);//(*C.m_lcaSearch);
-
-		m_vAncestor = new ClusterArray<cluster>(*this, nullptr);
-		m_wAncestor = new ClusterArray<cluster>(*this, nullptr);
-		//setting of clusters is not necessary!
+	ListIterator<cluster> itLca = eL.pushBack(lca);
+	for (cluster c = cw; c != lca; c = c->parent()) {
+		eL.insertAfter(c, itLca);
+		c2 = c;
 	}
-}
+
+	return lca;
+}//commonclusterlastAncestors
 
 
 // check the graph for empty clusters
@@ -737,6 +646,7 @@ cluster ClusterGraph::newCluster(int id)
 {
 	m_adjAvailable = false;
 	m_postOrderStart = nullptr;
+	m_treeIndexValid = false;
 	if (id >= m_clusterIdCount) m_clusterIdCount = id+1;
 	if (m_clusterIdCount >= m_clusterArrayTableSize)
 	{
@@ -767,6 +677,7 @@ cluster ClusterGraph::newCluster()
 {
 	m_adjAvailable = false;
 	m_postOrderStart = nullptr;
+	m_treeIndexValid = false;
 	if (m_clusterIdCount == m_clusterArrayTableSize)
 	{
 		m_clusterArrayTableSize <<= 1;
@@ -912,6 +823,7 @@ void ClusterGraph::delCluster(cluster c)
 		obs->clusterDeleted(c);
 
 	m_adjAvailable = false;
+	m_treeIndexValid = false;
 
 	c->m_parent->children.del(c->m_it);
 	c->m_it = ListIterator<cluster>();
@@ -963,13 +875,7 @@ void ClusterGraph::pullUpSubTree(cluster c)
 
 void ClusterGraph::doClear()
 {
-	//split condition
-	if (m_lcaSearch)
-	{
-		delete m_lcaSearch;
-		delete m_vAncestor;
-		delete m_wAncestor;
-	}
+	m_treeIndexValid = false;
 	if (numberOfClusters() != 0)
 	{
 		clearClusterTree(m_rootCluster);
@@ -986,6 +892,7 @@ void ClusterGraph::clearClusterTree(cluster c)
 	cluster parent = c->parent();
 	m_postOrderStart = nullptr;
 	m_adjAvailable = false;
+	m_treeIndexValid = false;
 
 	List<cluster>  children = c->getChildren();
 	List<node>     attached;
@@ -1037,13 +944,7 @@ void ClusterGraph::clearClusterTree(cluster c,List<node> &attached)
 //don't delete root cluster
 void ClusterGraph::clear()
 {
-	//split condition
-	if (m_lcaSearch)
-	{
-		delete m_lcaSearch;
-		delete m_vAncestor;
-		delete m_wAncestor;
-	}
+	m_treeIndexValid = false;
 	if (numberOfClusters() != 0)
 	{
 		//clear the cluster structure under root cluster
@@ -1119,6 +1020,7 @@ void ClusterGraph::moveCluster(cluster c, cluster newParent)
 
 	//temporarily only recompute postorder for all clusters
 
+	m_treeIndexValid = false;
 	oldParent->children.del(c->m_it);
 	newParent->children.pushBack(c);
 	c->m_it = newParent->getChildren().rbegin();
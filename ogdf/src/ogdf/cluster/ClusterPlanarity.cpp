@@ -278,6 +278,7 @@ bool ClusterPlanarity::doTest(const ClusterGraph &G, NodePairs &addedEdges)
 #endif
 	cplanMaster->setTimeLimit(m_time.c_str());
 	cplanMaster->setPortaFile(m_portaOutput);
+	cplanMaster->nThreads(m_numThreads);
 	cplanMaster->useDefaultCutPool() = m_defaultCutPool;
 #ifdef OGDF_DEBUG
 	cout << "Starting Optimization\n";
@@ -73,6 +73,7 @@ Module::ReturnType MaximumCPlanarSubgraph::doCall(const ClusterGraph &G,
 		m_strongVariableViolation);
 
 	cplanMaster->setPortaFile(m_portaOutput);
+	cplanMaster->nThreads(m_numThreads);
 	cplanMaster->useDefaultCutPool() = m_defaultCutPool;
 #ifdef OGDF_DEBUG
 	cout << "Starting Optimization\n";
@@ -37,6 +37,7 @@
  */
 
 #include <ogdf/energybased/DavidsonHarel.h>
+#include <ogdf/basic/ParallelFor.h>
 
 //TODO: in addition to the layout size, node sizes should be used in
 //the initial radius computation in case of "all central" layouts with
@@ -59,7 +60,8 @@ m_temperature(m_defaultTemp),
 m_shrinkingFactor(m_shrinkFactor),
 m_diskRadius(m_defaultRadius),
 m_energy(0.0),
-m_numberOfIterations(0)
+m_numberOfIterations(0),
+m_maxThreads(1)
 {
 	srand((unsigned)time(nullptr));
 }
@@ -150,7 +152,7 @@ const GraphAttributes &AG,
 DPoint &newPos) const
 {
 	int randomPos = randomNumber(0,m_nonIsolatedNodes.size()-1);
-	node v = *(m_nonIsolatedNodes.get(randomPos));
+	node v = m_nonIsolatedNodes[randomPos];
 	double oldx = AG.x(v);
 	double oldy = AG.y(v);
 	double randomAngle = randNum() * 2.0 * Math::pi;
@@ -245,7 +247,7 @@ void DavidsonHarel::placeIsolatedNodes(GraphAttributes &AG) const {
 
 	if (!m_nonIsolatedNodes.empty()) {
 		//compute a rectangle that includes all non-isolated vertices
-		node vFirst = m_nonIsolatedNodes.front();
+		node vFirst = m_nonIsolatedNodes[0];
 		minX = AG.x(vFirst);
 		minY = AG.y(vFirst);
 		maxX = minX;
@@ -288,6 +290,82 @@ void DavidsonHarel::placeIsolatedNodes(GraphAttributes &AG) const {
 	}
 }
 
+//computes the weighted sum of the candidate energies of all energy functions.
+//Each function stores the candidate so that it can be taken afterwards
+double DavidsonHarel::computeCandidateEnergy(node v, const DPoint &newPos)
+{
+	ListIterator<double> it2 = m_weightsOfEnergyFunctions.begin();
+	double newEnergy = 0.0;
+	for(EnergyFunction *f : m_energyFunctions) {
+		newEnergy += f->computeCandidateEnergy(v,newPos) * (*it2);
+		++it2;
+	}
+	OGDF_ASSERT(newEnergy >= 0.0);
+	return newEnergy;
+}
+
+//all energy functions are informed that the new layout is accepted
+void DavidsonHarel::takeCandidate(GraphAttributes &AG, node v, const DPoint &newPos, double newEnergy)
+{
+	for(EnergyFunction *f : m_energyFunctions)
+		f->candidateTaken();
+	AG.x(v) = newPos.m_x;
+	AG.y(v) = newPos.m_y;
+	m_energy = newEnergy;
+}
+
+//the candidates of a batch are computed like in the sequential loop and then
+//evaluated concurrently for the current layout. The first accepted candidate
+//is taken and the remaining ones are discarded since they were evaluated for
+//the old layout. The batch grows while candidates are rejected, which is the
+//common case at low temperatures
+void DavidsonHarel::concurrentIterations(GraphAttributes &AG, unsigned int numberOfThreads)
+{
+	const int minBatch = numberOfThreads;
+	const int maxBatch = 64 * numberOfThreads;
+	Array<node> candNode(maxBatch);
+	Array<DPoint> candPos(maxBatch);
+	Array<double> candEnergy(maxBatch);
+	Array<EnergyFunction*> functions(m_energyFunctions.size());
+	Array<double> weights(m_energyFunctions.size());
+	int i = 0;
+	ListIterator<double> itW = m_weightsOfEnergyFunctions.begin();
+	for(EnergyFunction *f : m_energyFunctions) {
+		functions[i] = f;
+		weights[i++] = *itW;
+		++itW;
+	}
+
+	int batch = minBatch;
+	for(int ic = 1; ic <= m_numberOfIterations; ) {
+		const int size = min(batch, m_numberOfIterations - ic + 1);
+		for(int k = 0; k < size; ++k)
+			candNode[k] = computeCandidateLayout(AG, candPos[k]);
+
+		parallelFor(numberOfThreads, size, [&](int begin, int end, unsigned int) {
+			for(int k = begin; k < end; ++k) {
+				double newEnergy = 0.0;
+				for(int j = 0; j < functions.size(); ++j)
+					newEnergy += functions[j]->candidateEnergy(candNode[k], candPos[k]) * weights[j];
+				candEnergy[k] = newEnergy;
+			}
+		});
+
+		int taken = 0;
+		while(taken < size && !testEnergyValue(candEnergy[taken]))
+			++taken;
+		if(taken < size) {
+			node v = candNode[taken];
+			takeCandidate(AG, v, candPos[taken], computeCandidateEnergy(v, candPos[taken]));
+			ic += taken + 1;
+			batch = max(minBatch, batch / 2);
+		} else {
+			ic += size;
+			batch = min(maxBatch, 2 * batch);
+		}
+	}
+}
+
 //this is the main optimization routine with the loop that lowers the temperature
 //and the disk radius geometrically until the temperature is zero. For each
 //temperature, a certain number of new positions for a random vertex are tried
@@ -300,13 +378,21 @@ void DavidsonHarel::call(GraphAttributes &AG)
 	OGDF_ASSERT(!m_energyFunctions.empty());
 
 	const Graph &G = AG.constGraph();
-	//compute the list of vertices with degree greater than zero
-	G.allNodes(m_nonIsolatedNodes);
-	ListIterator<node> it,itSucc;
-	for(it = m_nonIsolatedNodes.begin(); it.valid(); it = itSucc) {
-		itSucc = it.succ();
-		if((*it)->degree() == 0) m_nonIsolatedNodes.del(it);
-	}
+	//compute the array of vertices with degree greater than zero
+	int numberOfNonIsolated = 0;
+	for(node v : G.nodes)
+		if(v->degree() > 0) ++numberOfNonIsolated;
+	m_nonIsolatedNodes.init(numberOfNonIsolated);
+	numberOfNonIsolated = 0;
+	for(node v : G.nodes)
+		if(v->degree() > 0) m_nonIsolatedNodes[numberOfNonIsolated++] = v;
+
+	//candidates are only evaluated concurrently if every energy function
+	//supports it and each thread gets enough vertices to compare with
+	unsigned int numberOfThreads = numberOfThreadsFor(m_maxThreads, G.numberOfNodes(), 256);
+	for(EnergyFunction *f : m_energyFunctions)
+		if(!f->supportsConcurrentCandidates()) numberOfThreads = 1;
+
 	if(G.numberOfEdges() > 0) { //else only isolated nodes
 		computeFirstRadius(AG);
 		computeInitialEnergy();
@@ -315,27 +401,18 @@ void DavidsonHarel::call(GraphAttributes &AG)
 		//this is the main optimization loop
 		while(m_temperature > 0) {
 			//iteration loop for each temperature
-			for(int ic = 1; ic <= m_numberOfIterations; ic ++) {
+			if(numberOfThreads > 1)
+				concurrentIterations(AG, numberOfThreads);
+			else for(int ic = 1; ic <= m_numberOfIterations; ic ++) {
 				DPoint newPos;
 				//choose random vertex and new position for vertex
 				node v = computeCandidateLayout(AG,newPos);
 				//compute candidate energy and decide if new layout is chosen
-				ListIterator<double> it2 = m_weightsOfEnergyFunctions.begin();
-				double newEnergy = 0.0;
-				for(EnergyFunction *f : m_energyFunctions) {
-					newEnergy += f->computeCandidateEnergy(v,newPos) * (*it2);
-					++it2;
-				}
-				OGDF_ASSERT(newEnergy >= 0.0);
+				double newEnergy = computeCandidateEnergy(v,newPos);
 				//this tests if the new layout is accepted. If this is the case,
 				//all energy functions are informed that the new layout is accepted
-				if(testEnergyValue(newEnergy)) {
-					for(EnergyFunction *f : m_energyFunctions)
-						f->candidateTaken();
-					AG.x(v) = newPos.m_x;
-					AG.y(v) = newPos.m_y;
-					m_energy = newEnergy;
-				}
+				if(testEnergyValue(newEnergy))
+					takeCandidate(AG,v,newPos,newEnergy);
 			}
 			//lower the temperature and decrease the disk radius
 			m_temperature = (int)floor(m_temperature*m_coolingFactor);
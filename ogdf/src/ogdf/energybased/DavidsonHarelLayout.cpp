@@ -74,6 +74,7 @@ DavidsonHarelLayout::DavidsonHarelLayout()
 	m_multiplier = 2.0;
 	m_prefEdgeLength = 0.0;
 	m_crossings = false;
+	m_maxThreads = 1;
 }
 
 
@@ -216,7 +217,49 @@ void DavidsonHarelLayout::call(GraphAttributes &AG)
 			dh.setNumberOfIterations(m_numberOfIterations);
 	}
 	dh.setStartTemperature(m_startTemperature);
+	dh.maxThreads(m_maxThreads);
 	dh.call(AG);
 }
 
+LayoutCostEstimate DavidsonHarelLayout::estimateCost(const GraphAttributes &GA) const
+{
+	const Graph &G = GA.constGraph();
+	const double n = G.numberOfNodes();
+	const double m = G.numberOfEdges();
+
+	// mirror the choice of iterations and start temperature in call()
+	double iterations = 25 * n;
+	int temperature = m_startTemperature;
+	if (m_numberOfIterations == 0) {
+		switch (m_speed) {
+		case SpeedParameter::Fast:   temperature = 400;  break;
+		case SpeedParameter::Medium: temperature = 1500; break;
+		case SpeedParameter::HQ:     temperature = 2000; break;
+		}
+	} else {
+		iterations = m_itAsFactor ? 200 + m_numberOfIterations * n : m_numberOfIterations;
+	}
+
+	// the temperature is lowered geometrically by DavidsonHarel's cooling factor
+	int steps = 0;
+	for (; temperature > 0; temperature = int(temperature * 0.8)) {
+		++steps;
+	}
+
+	// repulsion and overlap store the energy of every node pair, planarity
+	// stores the crossing state of every edge pair
+	LayoutCostEstimate cost;
+	cost.peakMemory = 2 * LayoutCostEstimate::attributesMemory(GA) + 2 * n * n * sizeof(double);
+	double move = 2 * n + m / max(n, 1.0);
+	if (m_crossings) {
+		cost.peakMemory += m * m * sizeof(bool);
+		move += 2 * m * m / max(n, 1.0);
+	}
+	cost.operations = steps * iterations * move;
+	cost.timeClass = m_crossings
+	  ? LayoutCostEstimate::TimeClass::Cubic
+	  : LayoutCostEstimate::TimeClass::Quadratic;
+	return cost;
+}
+
 } // namespace ogdf
@@ -35,6 +35,9 @@
 #include <ogdf/energybased/fmmm/MAARPacking.h>
 #include <ogdf/energybased/fmmm/Multilevel.h>
 #include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/basic/Tracer.h>
+#include <ogdf/basic/ParallelFor.h>
+#include <ogdf/basic/System.h>
 
 namespace ogdf {
 
@@ -79,8 +82,13 @@ void FMMMLayout::call(GraphAttributes &GA, const EdgeArray<double> &edgeLength)
 	EdgeArray<EdgeAttributes> E_reduced;  //stores the edge attributes of G_reduced
 	NodeArray<NodeAttributes> A_reduced;  //stores the node attributes of G_reduced
 
+	m_hierarchy.clear();
+	if(retainHierarchy())
+		m_hierarchy.init(G.numberOfNodes());
+
 	if(G.numberOfNodes() > 1)
 	{
+		OGDF_TRACE_SCOPE("FMMMLayout::call");
 		GA.clearAllBends();//all edges are straight-line
 		if(useHighLevelOptions())
 			update_low_level_options_due_to_high_level_options_settings();
@@ -91,7 +99,10 @@ void FMMMLayout::call(GraphAttributes &GA, const EdgeArray<double> &edgeLength)
 		usedTime(t_total);
 		max_integer_position = pow(2.0,maxIntPosExponent());
 		init_ind_ideal_edgelength(G,A,E);
-		make_simple_loopfree(G,A,E,G_reduced,A_reduced,E_reduced);
+		{
+			OGDF_TRACE_SCOPE("FMMMLayout::preprocessing");
+			make_simple_loopfree(G,A,E,G_reduced,A_reduced,E_reduced);
+		}
 		call_DIVIDE_ET_IMPERA_step(G_reduced,A_reduced,E_reduced);
 		adjust_positions(G_reduced, A_reduced);
 		time_total = usedTime(t_total);
@@ -107,6 +118,16 @@ void FMMMLayout::call(GraphAttributes &GA, const EdgeArray<double> &edgeLength)
 			GA.y(v) = 0;
 		}
 	}
+
+	if(retainHierarchy())
+	{
+		// G_reduced and thus level 0 of the hierarchy number the nodes in the order of G
+		NodeArray<int> index(G);
+		int i = 0;
+		for(node v : G.nodes)
+			index[v] = i++;
+		m_hierarchy.aggregate(GA, index);
+	}
 }
 
 
@@ -145,7 +166,10 @@ void FMMMLayout::call_DIVIDE_ET_IMPERA_step(
 		for(int i = 0; i < number_of_components;i++)
 			call_MULTILEVEL_step_for_subGraph(G_sub[i],A_sub[i],E_sub[i]);
 
-	pack_subGraph_drawings (A,G_sub,A_sub);
+	{
+		OGDF_TRACE_SCOPE("FMMMLayout::packing");
+		pack_subGraph_drawings (A,G_sub,A_sub);
+	}
 	delete_all_subGraphs(G_sub,A_sub,E_sub);
 }
 
@@ -164,13 +188,19 @@ void FMMMLayout::call_MULTILEVEL_step_for_subGraph(
 	Array<NodeArray<NodeAttributes>*> A_mult_ptr (max_level+1);
 	Array<EdgeArray<EdgeAttributes>*> E_mult_ptr (max_level+1);
 
-	Mult.create_multilevel_representations(G,A,E,randSeed(),
-				galaxyChoice(),minGraphSize(),
-				randomTries(),G_mult_ptr,A_mult_ptr,
-				E_mult_ptr,max_level);
+	{
+		OGDF_TRACE_SCOPE("FMMMLayout::coarsening");
+		Mult.create_multilevel_representations(G,A,E,randSeed(),
+					galaxyChoice(),minGraphSize(),
+					randomTries(),G_mult_ptr,A_mult_ptr,
+					E_mult_ptr,max_level);
+	}
+	if(retainHierarchy())
+		add_levels_to_hierarchy(G_mult_ptr,A_mult_ptr,max_level);
 
 	for(int i = max_level;i >= 0;i--)
 	{
+		OGDF_TRACE_SCOPE("FMMMLayout::level");
 		if(i == max_level)
 			create_initial_placement(*G_mult_ptr[i],*A_mult_ptr[i]);
 		else
@@ -183,6 +213,35 @@ void FMMMLayout::call_MULTILEVEL_step_for_subGraph(
 	Mult.delete_multilevel_representations(G_mult_ptr,A_mult_ptr,E_mult_ptr,max_level);
 }
 
+
+void FMMMLayout::add_levels_to_hierarchy(
+	Array<Graph*> &G_mult_ptr,
+	Array<NodeArray<NodeAttributes>*> &A_mult_ptr,
+	int max_level)
+{
+	//level 0 is a connected subgraph of G_reduced, whose node indices are the
+	//hierarchy numbers of the input nodes
+	NodeArray<int> fine_index(*G_mult_ptr[0]);
+	for(node v : G_mult_ptr[0]->nodes)
+		fine_index[v] = (*A_mult_ptr[0])[v].get_original_node()->index();
+
+	for(int i = 0; i < max_level; i++)
+	{
+		const NodeArray<NodeAttributes> &A = *A_mult_ptr[i];
+		NodeArray<int> coarse_index(*G_mult_ptr[i+1]);
+		for(node v : G_mult_ptr[i+1]->nodes)
+			coarse_index[v] = m_hierarchy.addNode(i+1);
+
+		//every node belongs to the solar system of its dedicated sun
+		for(node v : G_mult_ptr[i]->nodes)
+		{
+			node sun = A[v].get_dedicated_sun_node();
+			m_hierarchy.setParent(i, fine_index[v], coarse_index[A[sun].get_higher_level_node()]);
+		}
+		fine_index = coarse_index;
+	}
+}
+
 bool FMMMLayout::running(int iter, int max_mult_iter, double actforcevectorlength)
 {
 	const int ITERBOUND = 10000;
@@ -217,15 +276,19 @@ void FMMMLayout::call_FORCE_CALCULATION_step(
 												//iterations (needed to avoid oscillations)
 
 		set_average_ideal_edgelength(G,E);//needed for easy scaling of the forces
+		init_level_threads(G);
 		make_initialisations_for_rep_calc_classes(G);
 
-		while (running(iter, max_mult_iter, actforcevectorlength))
-		{//while
-			calculate_forces(G,A,E,F,F_attr,F_rep,last_node_movement,iter,0);
-			if(stopCriterion() != FMMMOptions::StopCriterion::FixedIterations)
-				actforcevectorlength = get_average_forcevector_length(G,F);
-			iter++;
-		}//while
+		{
+			OGDF_TRACE_SCOPE("FMMMLayout::forceCalculation");
+			while (running(iter, max_mult_iter, actforcevectorlength))
+			{//while
+				calculate_forces(G,A,E,F,F_attr,F_rep,last_node_movement,iter,0);
+				if(stopCriterion() != FMMMOptions::StopCriterion::FixedIterations)
+					actforcevectorlength = get_average_forcevector_length(G,F);
+				iter++;
+			}//while
+		}
 
 		if(act_level == 0)
 			call_POSTPROCESSING_step(G,A,E,F,F_attr,F_rep,last_node_movement);
@@ -244,6 +307,7 @@ void FMMMLayout::call_POSTPROCESSING_step(
 	NodeArray<DPoint>& F_rep,
 	NodeArray<DPoint>& last_node_movement)
 {
+	OGDF_TRACE_SCOPE("FMMMLayout::postprocessing");
 	for(int i = 1; i<= 10; i++)
 		calculate_forces(G,A,E,F,F_attr,F_rep,last_node_movement,i,1);
 
@@ -273,6 +337,7 @@ void FMMMLayout::initialize_all_options()
 	//setting low level options
 	//setting general options
 	randSeed(100);
+	maxThreads(System::numberOfProcessors());
 	edgeLengthMeasurement(FMMMOptions::EdgeLengthMeasurement::BoundingCircle);
 	allowedPositions(FMMMOptions::AllowedPositions::Integer);
 	maxIntPosExponent(40);
@@ -288,6 +353,7 @@ void FMMMLayout::initialize_all_options()
 	minGraphSize(50);
 	galaxyChoice(FMMMOptions::GalaxyChoice::NonUniformProbLowerMass);
 	randomTries(20);
+	retainHierarchy(false);
 	maxIterChange(FMMMOptions::MaxIterChange::LinearlyDecreasing);
 	maxIterFactor(10);
 	initialPlacementMult(FMMMOptions::InitialPlacementMult::Advanced);
@@ -1223,35 +1289,74 @@ void FMMMLayout::calculate_attractive_forces(
 	EdgeArray<EdgeAttributes> & E,
 	NodeArray<DPoint>& F_attr)
 {
-	energybased::fmmm::numexcept N;
-	DPoint f_u;
-	DPoint nullpoint (0,0);
-
 	//initialisation
 	init_F(G,F_attr);
 
-	//calculation
-	for(edge e : G.edges)
-	{
-		node u = e->source();
-		node v = e->target();
-		DPoint vector_v_minus_u  = A[v].get_position() - A[u].get_position();
-		double norm_v_minus_u = vector_v_minus_u.norm();
-		if(vector_v_minus_u == nullpoint)
-			f_u = nullpoint;
-		else if(!N.f_near_machine_precision(norm_v_minus_u,f_u))
+	//every thread sums up the forces of its edges in its own buffer;
+	//thread 0 writes to F_attr directly
+	Array<NodeArray<DPoint>> F_thread(1, m_levelThreads - 1);
+	for (unsigned int t = 1; t < m_levelThreads; t++)
+		F_thread[t].init(G, DPoint(0, 0));
+
+	parallelFor(m_levelThreads, m_levelEdges.size(), [&](int begin, int end, unsigned int t) {
+		energybased::fmmm::numexcept N;
+		DPoint f_u;
+		DPoint nullpoint (0,0);
+		NodeArray<DPoint>& F_sum = (t == 0) ? F_attr : F_thread[t];
+
+		//calculation
+		for (int i = begin; i < end; i++)
 		{
-			double scalar = f_attr_scalar(norm_v_minus_u,E[e].get_length())/norm_v_minus_u;
-			f_u.m_x = scalar * vector_v_minus_u.m_x;
-			f_u.m_y = scalar * vector_v_minus_u.m_y;
-		}
+			edge e = m_levelEdges[i];
+			node u = e->source();
+			node v = e->target();
+			DPoint vector_v_minus_u  = A[v].get_position() - A[u].get_position();
+			double norm_v_minus_u = vector_v_minus_u.norm();
+			if(vector_v_minus_u == nullpoint)
+				f_u = nullpoint;
+			else if(!N.f_near_machine_precision(norm_v_minus_u,f_u))
+			{
+				double scalar = f_attr_scalar(norm_v_minus_u,E[e].get_length())/norm_v_minus_u;
+				f_u.m_x = scalar * vector_v_minus_u.m_x;
+				f_u.m_y = scalar * vector_v_minus_u.m_y;
+			}
 
-		F_attr[v] = F_attr[v] - f_u;
-		F_attr[u] = F_attr[u] + f_u;
+			F_sum[v] = F_sum[v] - f_u;
+			F_sum[u] = F_sum[u] + f_u;
+		}
+	});
+
+	if (m_levelThreads > 1) {
+		parallelFor(m_levelThreads, m_levelNodes.size(), [&](int begin, int end, unsigned int) {
+			for (int i = begin; i < end; i++) {
+				node v = m_levelNodes[i];
+				for (unsigned int t = 1; t < m_levelThreads; t++)
+					F_attr[v] = F_attr[v] + F_thread[t][v];
+			}
+		});
 	}
 }
 
 
+void FMMMLayout::init_level_threads(const Graph& G)
+{
+	m_levelNodes.init(G.numberOfNodes());
+	m_levelEdges.init(G.numberOfEdges());
+	int i = 0;
+	for (node v : G.nodes)
+		m_levelNodes[i++] = v;
+	i = 0;
+	for (edge e : G.edges)
+		m_levelEdges[i++] = e;
+
+	//small levels are not worth the overhead of starting threads
+	const int MIN_NODES_PER_THREAD = 2000;
+	m_levelThreads = numberOfThreadsFor(maxThreads(), G.numberOfNodes(), MIN_NODES_PER_THREAD);
+	FR.max_threads(m_levelThreads);
+	NM.max_threads(m_levelThreads);
+}
+
+
 double FMMMLayout::f_attr_scalar(double d, double ind_ideal_edge_length)
 {
 	double s(0);
@@ -1338,29 +1443,32 @@ void FMMMLayout::add_attr_rep_forces(
 		act_rep_force_strength = get_post_rep_force_strength(G.numberOfNodes());
 	}
 
-	for (node v : G.nodes)
-	{
-		DPoint f;
-		f.m_x = act_spring_strength * F_attr[v].m_x + act_rep_force_strength * F_rep[v].m_x;
-		f.m_y = act_spring_strength * F_attr[v].m_y + act_rep_force_strength * F_rep[v].m_y;
-		f.m_x = average_ideal_edgelength * average_ideal_edgelength * f.m_x;
-		f.m_y = average_ideal_edgelength * average_ideal_edgelength * f.m_y;
-
-		double norm_f = f.norm();
-
-		DPoint force;
-		if (f == nullpoint)
-			force = nullpoint;
-		else if (N.f_near_machine_precision(norm_f, force))
-			restrict_force_to_comp_box(force);
-		else
+	parallelFor(m_levelThreads, m_levelNodes.size(), [&](int begin, int end, unsigned int) {
+		for (int i = begin; i < end; i++)
 		{
-			double scalar = min(norm_f * cool_factor * forceScalingFactor(), max_radius(iter)) / norm_f;
-			force.m_x = scalar * f.m_x;
-			force.m_y = scalar * f.m_y;
+			node v = m_levelNodes[i];
+			DPoint f;
+			f.m_x = act_spring_strength * F_attr[v].m_x + act_rep_force_strength * F_rep[v].m_x;
+			f.m_y = act_spring_strength * F_attr[v].m_y + act_rep_force_strength * F_rep[v].m_y;
+			f.m_x = average_ideal_edgelength * average_ideal_edgelength * f.m_x;
+			f.m_y = average_ideal_edgelength * average_ideal_edgelength * f.m_y;
+
+			double norm_f = f.norm();
+
+			DPoint force;
+			if (f == nullpoint)
+				force = nullpoint;
+			else if (N.f_near_machine_precision(norm_f, force))
+				restrict_force_to_comp_box(force);
+			else
+			{
+				double scalar = min(norm_f * cool_factor * forceScalingFactor(), max_radius(iter)) / norm_f;
+				force.m_x = scalar * f.m_x;
+				force.m_y = scalar * f.m_y;
+			}
+			F[v] = force;
 		}
-		F[v] = force;
-	}
+	});
 }
 
 
@@ -1369,8 +1477,12 @@ void FMMMLayout::move_nodes(
 	NodeArray<NodeAttributes>& A,
 	NodeArray<DPoint>& F)
 {
-	for(node v : G.nodes)
-		A[v].set_position(A[v].get_position() + F[v]);
+	parallelFor(m_levelThreads, m_levelNodes.size(), [&](int begin, int end, unsigned int) {
+		for (int i = begin; i < end; i++) {
+			node v = m_levelNodes[i];
+			A[v].set_position(A[v].get_position() + F[v]);
+		}
+	});
 }
 
 
@@ -1465,22 +1577,25 @@ void FMMMLayout::prevent_oscillations(
 	const DPoint nullpoint(0, 0);
 
 	if (iter > 1) { // usual case
-		for (node v : G.nodes) {
-			const DPoint force_new(F[v]);
-			const DPoint force_old(last_node_movement[v]);
-			const double norm_new = F[v].norm();
-			const double norm_old = last_node_movement[v].norm();
-			if (norm_new > 0 && norm_old > 0) {
-				const double fi = nullpoint.angle(force_old, force_new);
-				const double factor = factors[int(std::ceil(fi / pi_times_1_over_6))];
-				const double quot = norm_old * factor / norm_new;
-				if (quot < 1.0) {
-					F[v].m_x = quot * F[v].m_x;
-					F[v].m_y = quot * F[v].m_y;
+		parallelFor(m_levelThreads, m_levelNodes.size(), [&](int begin, int end, unsigned int) {
+			for (int i = begin; i < end; i++) {
+				node v = m_levelNodes[i];
+				const DPoint force_new(F[v]);
+				const DPoint force_old(last_node_movement[v]);
+				const double norm_new = F[v].norm();
+				const double norm_old = last_node_movement[v].norm();
+				if (norm_new > 0 && norm_old > 0) {
+					const double fi = nullpoint.angle(force_old, force_new);
+					const double factor = factors[int(std::ceil(fi / pi_times_1_over_6))];
+					const double quot = norm_old * factor / norm_new;
+					if (quot < 1.0) {
+						F[v].m_x = quot * F[v].m_x;
+						F[v].m_y = quot * F[v].m_y;
+					}
 				}
+				last_node_movement[v] = F[v];
 			}
-			last_node_movement[v] = F[v];
-		}
+		});
 	}
 	else if (iter == 1)
 		init_last_node_movement(G,F,last_node_movement);
@@ -1525,5 +1640,34 @@ void FMMMLayout::adapt_drawing_to_ideal_average_edgelength(
 	}
 }
 
+LayoutCostEstimate FMMMLayout::estimateCost(const GraphAttributes &GA) const
+{
+	const Graph &G = GA.constGraph();
+	const double n = G.numberOfNodes();
+	const double m = G.numberOfEdges();
+	const double logN = n > 2 ? std::log2(n) : 1.0;
+
+	// the levels of the multilevel hierarchy together are about twice the
+	// input, and each quadtree cell of the multipole method stores two
+	// expansions with nmPrecision() coefficients
+	LayoutCostEstimate cost;
+	cost.peakMemory = LayoutCostEstimate::attributesMemory(GA)
+	  + 2 * (LayoutCostEstimate::graphMemory(n, m)
+	       + n * sizeof(energybased::fmmm::NodeAttributes)
+	       + m * sizeof(energybased::fmmm::EdgeAttributes))
+	  + 4 * n * (m_NMPrecision + 1) * sizeof(std::complex<double>);
+
+	// coarser levels run up to maxIterFactor() times the fixed iterations on
+	// geometrically shrinking graphs
+	const double iterations = double(m_fixedIterations) * (1 + m_maxIterFactor) + m_fineTuningIterations;
+	if (m_repulsiveForcesCalculation == FMMMOptions::RepulsiveForcesMethod::Exact) {
+		cost.operations = iterations * (n * n + m);
+		cost.timeClass = LayoutCostEstimate::TimeClass::Quadratic;
+	} else {
+		cost.operations = iterations * (n * logN + m);
+		cost.timeClass = LayoutCostEstimate::TimeClass::Loglinear;
+	}
+	return cost;
+}
 
 } //end namespace ogdf
@@ -32,6 +32,7 @@
 #include <ogdf/energybased/FastMultipoleEmbedder.h>
 #include <ogdf/energybased/fast_multipole_embedder/FMEMultipoleKernel.h>
 #include <ogdf/fileformats/GraphIO.h>
+#include <ogdf/basic/Tracer.h>
 
 namespace ogdf {
 
@@ -79,6 +80,7 @@ void FastMultipoleEmbedder::call(const Graph& G,
                                  NodeArray<float>& nodeXPosition, NodeArray<float>& nodeYPosition,
                                  const EdgeArray<float>& edgeLength, const NodeArray<float>& nodeSize)
 {
+	OGDF_TRACE_SCOPE("FastMultipoleEmbedder::call");
 	allocate(G.numberOfNodes(), G.numberOfEdges());
 	m_pGraph->readFrom(G, nodeXPosition, nodeYPosition, edgeLength, nodeSize);
 	run(m_numIterations);
@@ -105,6 +107,7 @@ void FastMultipoleEmbedder::call(GraphAttributes &GA)
 
 void FastMultipoleEmbedder::call(GraphAttributes &GA, const EdgeArray<float>& edgeLength, const NodeArray<float>& nodeSize)
 {
+	OGDF_TRACE_SCOPE("FastMultipoleEmbedder::call");
 	allocate(GA.constGraph().numberOfNodes(), GA.constGraph().numberOfEdges());
 	m_pGraph->readFrom(GA, edgeLength, nodeSize);
 	run(m_numIterations);
@@ -162,6 +165,7 @@ void FastMultipoleEmbedder::runMultipole()
 
 void FastMultipoleEmbedder::runSingle()
 {
+	OGDF_TRACE_SCOPE("FastMultipoleEmbedder::runSingle");
 	FMESingleKernel kernel;
 	kernel(*m_pGraph, m_pOptions->timeStep, m_pOptions->minNumIterations, m_pOptions->maxNumIterations, m_pOptions->stopCritForce);
 }
@@ -221,6 +225,7 @@ void FastMultipoleMultilevelEmbedder::call(GraphAttributes &GA)
 	computeAutoEdgeLength(GA, edgeLengthAuto);
 	m_multiLevelNumNodesBound = 10; //10
 	const Graph& t = GA.constGraph();
+	m_hierarchy.clear();
 	if (t.numberOfNodes() <= 25)
 	{
 		FastMultipoleEmbedder fme;
@@ -228,14 +233,30 @@ void FastMultipoleMultilevelEmbedder::call(GraphAttributes &GA)
 		fme.setRandomize(true);
 		fme.setNumIterations(500);
 		fme.call(GA);
-		return;
 	}
+	else
+	{
+		run(GA, edgeLengthAuto);
 
-	run(GA, edgeLengthAuto);
+		for(edge e : GA.constGraph().edges)
+		{
+			GA.bends(e).clear();
+		}
+	}
 
-	for(edge e : GA.constGraph().edges)
+	if (m_retainHierarchy)
 	{
-		GA.bends(e).clear();
+		NodeArray<int> index(t);
+		int i = 0;
+		for(node v : t.nodes)
+		{
+			index[v] = i++;
+		}
+		if (m_hierarchy.empty())
+		{
+			m_hierarchy.init(t.numberOfNodes());
+		}
+		m_hierarchy.aggregate(GA, index);
 	}
 }
 
@@ -274,6 +295,16 @@ void FastMultipoleMultilevelEmbedder::run(GraphAttributes& GA, const EdgeArray<f
 
 	// create all multilevels
 	this->createMultiLevelGraphs(pGraph, GA, edgeLength);
+	if (m_retainHierarchy)
+	{
+		NodeArray<int> index(*pGraph);
+		int i = 0;
+		for(node v : pGraph->nodes)
+		{
+			index[v] = i++;
+		}
+		addLevelsToHierarchy(index);
+	}
 	// init the coarsest level
 	initCurrentLevel();
 
@@ -311,15 +342,40 @@ void FastMultipoleMultilevelEmbedder::createMultiLevelGraphs(Graph* pGraph, Grap
 	while (m_pCurrentLevel->m_pGraph->numberOfNodes() > m_multiLevelNumNodesBound)
 	{
 		GalaxyMultilevel* newLevel = builder.build(m_pCurrentLevel);
+		const bool shrunk = newLevel->m_pGraph->numberOfNodes() < m_pCurrentLevel->m_pGraph->numberOfNodes();
 		m_pCurrentLevel = newLevel;
 		m_iNumLevels++;
 		m_iCurrentLevelNr++;
+		// isolated nodes are never merged, so mostly edgeless levels may not shrink
+		if (!shrunk)
+			break;
 	}
 	m_pCoarsestLevel = m_pCurrentLevel;
 	m_pCurrentGraph = m_pCurrentLevel->m_pGraph;
 }
 
 
+void FastMultipoleMultilevelEmbedder::addLevelsToHierarchy(const NodeArray<int>& index)
+{
+	m_hierarchy.init(m_pFinestLevel->m_pGraph->numberOfNodes());
+	NodeArray<int> fineIndex(index);
+	for (GalaxyMultilevel* l = m_pFinestLevel; l->m_pCoarserMultiLevel; l = l->m_pCoarserMultiLevel)
+	{
+		const Graph& coarseGraph = *(l->m_pCoarserMultiLevel->m_pGraph);
+		NodeArray<int> coarseIndex(coarseGraph);
+		for(node v : coarseGraph.nodes)
+		{
+			coarseIndex[v] = m_hierarchy.addNode(l->levelNumber + 1);
+		}
+		for(node v : l->m_pGraph->nodes)
+		{
+			m_hierarchy.setParent(l->levelNumber, fineIndex[v], coarseIndex[(*(l->m_pNodeInfo))[v].parent]);
+		}
+		fineIndex = coarseIndex;
+	}
+}
+
+
 void FastMultipoleMultilevelEmbedder::writeCurrentToGraphAttributes(GraphAttributes& GA)
 {
 	for(node v : m_pCurrentGraph->nodes)
@@ -429,5 +485,22 @@ uint32_t FastMultipoleMultilevelEmbedder::numberOfIterationsByLevelNr(uint32_t l
 	return 200*(levelNr+1)*(levelNr+1);
 }
 
+LayoutCostEstimate FastMultipoleEmbedder::estimateCost(const GraphAttributes &GA) const
+{
+	const Graph &G = GA.constGraph();
+	const double n = G.numberOfNodes();
+	const double m = G.numberOfEdges();
+	const double logN = n > 2 ? std::log2(n) : 1.0;
+
+	// the array graph keeps a handful of floats per node and edge, the
+	// quadtree has less than 2n nodes with two expansions each
+	LayoutCostEstimate cost;
+	cost.peakMemory = LayoutCostEstimate::attributesMemory(GA)
+	  + n * 16 * sizeof(float) + m * 4 * sizeof(uint32_t)
+	  + 4 * n * (m_precisionParameter + 1) * 2 * sizeof(double);
+	cost.operations = double(m_numIterations) * (n * logN + m);
+	cost.timeClass = LayoutCostEstimate::TimeClass::Loglinear;
+	return cost;
+}
 
 } // end of namespace
@@ -0,0 +1,415 @@
+/** \file
+ * \brief Implementation of class FastMultipoleRelayoutSession
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/energybased/FastMultipoleRelayoutSession.h>
+#include <ogdf/energybased/fast_multipole_embedder/FMEMultipoleKernel.h>
+#include <ogdf/basic/ParallelFor.h>
+#include <ogdf/basic/System.h>
+#include <ogdf/basic/Tracer.h>
+
+#include <algorithm>
+
+namespace ogdf {
+
+using namespace fast_multipole_embedder;
+
+namespace {
+
+// graphs with fewer nodes are handled by the direct kernel, as in FastMultipoleEmbedder
+const uint32_t s_minMultipoleNodes = 100;
+
+// number of moving nodes up to which a local pass computes their forces exactly
+const size_t s_maxExactNodes = 128;
+
+// minimal number of moving nodes per thread in a local pass
+const int s_minNodesPerThread = 16;
+
+}
+
+FastMultipoleRelayoutSession::FastMultipoleRelayoutSession(GraphAttributes &GA)
+	: GraphObserver(&GA.constGraph())
+	, m_GA(GA)
+	, m_pinned(GA.constGraph(), false)
+	, m_changed(GA.constGraph(), false)
+	, m_added(GA.constGraph(), false)
+	, m_index(GA.constGraph(), 0)
+	, m_structureChanged(true)
+	, m_pArrayGraph(nullptr)
+	, m_pOptions(nullptr)
+	, m_threadPool(nullptr)
+	, m_pGlobalContext(nullptr)
+	, m_numIterations(100)
+	, m_localIterations(30)
+	, m_neighborhoodRadius(2)
+	, m_globalPassInterval(10)
+	, m_numberOfThreads(1)
+	, m_numUpdates(0)
+	, m_lastUpdateWasGlobal(false)
+{
+}
+
+FastMultipoleRelayoutSession::~FastMultipoleRelayoutSession()
+{
+	deallocate();
+}
+
+void FastMultipoleRelayoutSession::nodeChanged(node v)
+{
+	m_changed[v] = true;
+}
+
+void FastMultipoleRelayoutSession::nodeAdded(node v)
+{
+	m_pinned[v] = false;
+	m_changed[v] = true;
+	m_added[v] = true;
+	m_structureChanged = true;
+}
+
+void FastMultipoleRelayoutSession::edgeAdded(edge e)
+{
+	m_changed[e->source()] = true;
+	m_changed[e->target()] = true;
+	m_structureChanged = true;
+}
+
+void FastMultipoleRelayoutSession::edgeDeleted(edge e)
+{
+	m_changed[e->source()] = true;
+	m_changed[e->target()] = true;
+	m_structureChanged = true;
+}
+
+void FastMultipoleRelayoutSession::layout()
+{
+	OGDF_TRACE_SCOPE("FastMultipoleRelayoutSession::layout");
+	prepare();
+	for (node v : m_GA.constGraph().nodes) {
+		m_changed[v] = false;
+	}
+	if (m_pArrayGraph == nullptr) {
+		return;
+	}
+	setMoveRadii(nullptr);
+	globalPass(m_numIterations);
+	writePositions();
+}
+
+void FastMultipoleRelayoutSession::update()
+{
+	OGDF_TRACE_SCOPE("FastMultipoleRelayoutSession::update");
+	const Graph &G = m_GA.constGraph();
+	m_numUpdates++;
+	prepare();
+
+	std::vector<uint32_t> changed;
+	for (node v : G.nodes) {
+		if (m_changed[v]) {
+			changed.push_back(m_index[v]);
+			m_changed[v] = false;
+		}
+	}
+
+	m_lastUpdateWasGlobal = m_globalPassInterval > 0 && m_numUpdates % m_globalPassInterval == 0;
+	if (m_pArrayGraph == nullptr) {
+		return;
+	}
+
+	if (m_lastUpdateWasGlobal) {
+		setMoveRadii(nullptr);
+		globalPass(m_numIterations);
+		writePositions();
+		return;
+	}
+
+	// collect the unpinned nodes within the neighborhood radius of the changed nodes
+	const ArrayGraph &AG = *m_pArrayGraph;
+	std::vector<bool> isActive(AG.numNodes(), false);
+	std::vector<uint32_t> active;
+	std::vector<uint32_t> dist(AG.numNodes(), 0);
+	for (uint32_t i : changed) {
+		if (!isActive[i]) {
+			isActive[i] = true;
+			active.push_back(i);
+		}
+	}
+	for (size_t head = 0; head < active.size(); head++) {
+		const uint32_t i = active[head];
+		if (dist[i] >= static_cast<uint32_t>(m_neighborhoodRadius)) {
+			continue;
+		}
+		uint32_t adj = AG.firstEdgeAdjIndex(i);
+		for (uint32_t k = 0; k < AG.nodeInfo(i).degree; k++) {
+			const uint32_t j = AG.twinNodeIndex(adj, i);
+			if (!isActive[j]) {
+				isActive[j] = true;
+				dist[j] = dist[i] + 1;
+				active.push_back(j);
+			}
+			adj = AG.nextEdgeAdjIndex(adj, i);
+		}
+	}
+
+	// pinned nodes stay where they are
+	setMoveRadii(nullptr);
+	active.erase(std::remove_if(active.begin(), active.end(), [&](uint32_t i) {
+		return m_pArrayGraph->nodeMoveRadius()[i] == 0.0f;
+	}), active.end());
+	if (active.empty()) {
+		return;
+	}
+
+	setMoveRadii(&isActive);
+	if (active.size() > s_maxExactNodes && m_pGlobalContext != nullptr) {
+		globalPass(m_localIterations);
+	} else {
+		localPass(active);
+	}
+	writePositions();
+}
+
+void FastMultipoleRelayoutSession::prepare()
+{
+	const Graph &G = m_GA.constGraph();
+
+	// place added nodes at the barycenter of their old neighbors
+	int numAdded = 0;
+	for (node v : G.nodes) {
+		if (!m_added[v]) {
+			continue;
+		}
+		double x = 0, y = 0;
+		int count = 0;
+		for (adjEntry adj : v->adjEntries) {
+			node w = adj->twinNode();
+			if (!m_added[w]) {
+				x += m_GA.x(w);
+				y += m_GA.y(w);
+				count++;
+			}
+		}
+		if (count > 0) {
+			// spread the added nodes around the barycenter so that they do not coincide
+			const double angle = 2.39996323 * numAdded++;
+			const double r = std::max(m_GA.width(v), m_GA.height(v)) / 2;
+			m_GA.x(v) = x / count + r * cos(angle);
+			m_GA.y(v) = y / count + r * sin(angle);
+		}
+	}
+	for (node v : G.nodes) {
+		m_added[v] = false;
+	}
+
+	if (m_structureChanged) {
+		rebuild();
+	} else if (m_pArrayGraph != nullptr) {
+		float *x = m_pArrayGraph->nodeXPos();
+		float *y = m_pArrayGraph->nodeYPos();
+		for (node v : G.nodes) {
+			x[m_index[v]] = static_cast<float>(m_GA.x(v));
+			y[m_index[v]] = static_cast<float>(m_GA.y(v));
+		}
+	}
+}
+
+void FastMultipoleRelayoutSession::rebuild()
+{
+	OGDF_TRACE_SCOPE("FastMultipoleRelayoutSession::rebuild");
+	const Graph &G = m_GA.constGraph();
+	deallocate();
+	m_structureChanged = false;
+
+	uint32_t i = 0;
+	for (node v : G.nodes) {
+		m_index[v] = i++;
+	}
+	if (G.numberOfNodes() == 0) {
+		return;
+	}
+
+	// the same node sizes and edge lengths as FastMultipoleEmbedder::call(GraphAttributes&)
+	NodeArray<float> nodeSize(G);
+	EdgeArray<float> edgeLength(G);
+	for (node v : G.nodes) {
+		nodeSize[v] = (float)sqrt(m_GA.width(v)*m_GA.width(v) + m_GA.height(v)*m_GA.height(v)) * 0.5f;
+	}
+	for (edge e : G.edges) {
+		edgeLength[e] = nodeSize[e->source()] + nodeSize[e->target()];
+	}
+
+	const uint32_t numNodes = G.numberOfNodes();
+	m_pArrayGraph = new ArrayGraph(numNodes, std::max(G.numberOfEdges(), 1));
+	m_pArrayGraph->readFrom(m_GA, edgeLength, nodeSize);
+
+	// the options of FastMultipoleEmbedder, but the drawing is already a good start
+	m_pOptions = new FMEGlobalOptions();
+	m_pOptions->preProcTimeStep = 0.5;
+	m_pOptions->preProcMaxNumIterations = 0;
+	m_pOptions->preProcEdgeForceFactor = 0.5;
+	m_pOptions->timeStep = 0.25;
+	m_pOptions->edgeForceFactor = 1.0;
+	m_pOptions->repForceFactor = 2.0;
+	m_pOptions->stopCritConstSq = 2000400;
+	m_pOptions->stopCritAvgForce = 0.1f;
+	m_pOptions->minNumIterations = 4;
+	m_pOptions->multipolePrecision = 5;
+	m_pOptions->stopCritForce = (((float)numNodes)*((float)numNodes)*m_pArrayGraph->avgNodeSize()) / m_pOptions->stopCritConstSq;
+
+	if (numNodes >= s_minMultipoleNodes) {
+		uint32_t numThreads = std::min<uint32_t>(std::max(m_numberOfThreads, 1u), System::numberOfProcessors());
+		numThreads = prevPowerOfTwo(std::max<uint32_t>(1, std::min(numThreads, numNodes / s_minMultipoleNodes)));
+		m_threadPool = new FMEThreadPool(numThreads);
+		m_pGlobalContext = FMEMultipoleKernel::allocateContext(m_pArrayGraph, m_pOptions, numThreads);
+	}
+}
+
+void FastMultipoleRelayoutSession::deallocate()
+{
+	if (m_pGlobalContext != nullptr) {
+		FMEMultipoleKernel::deallocateContext(m_pGlobalContext);
+	}
+	delete m_threadPool;
+	delete m_pOptions;
+	delete m_pArrayGraph;
+	m_pGlobalContext = nullptr;
+	m_threadPool = nullptr;
+	m_pOptions = nullptr;
+	m_pArrayGraph = nullptr;
+}
+
+void FastMultipoleRelayoutSession::setMoveRadii(const std::vector<bool> *active)
+{
+	float *radius = m_pArrayGraph->nodeMoveRadius();
+	for (node v : m_GA.constGraph().nodes) {
+		const uint32_t i = m_index[v];
+		const bool fixed = m_pinned[v] || (active != nullptr && !(*active)[i]);
+		radius[i] = fixed ? 0.0f : FLT_MAX;
+	}
+}
+
+void FastMultipoleRelayoutSession::globalPass(int numIterations)
+{
+	OGDF_TRACE_SCOPE("FastMultipoleRelayoutSession::globalPass");
+	m_pOptions->maxNumIterations = numIterations;
+	if (m_pGlobalContext != nullptr) {
+		m_pGlobalContext->earlyExit = false;
+		m_threadPool->runKernel<FMEMultipoleKernel>(m_pGlobalContext);
+	} else {
+		FMEBasicKernel kernel;
+		kernel.simpleForceDirected(*m_pArrayGraph, m_pOptions->timeStep,
+			m_pOptions->minNumIterations, m_pOptions->maxNumIterations, 0, m_pOptions->stopCritForce);
+	}
+}
+
+void FastMultipoleRelayoutSession::localPass(const std::vector<uint32_t> &active)
+{
+	OGDF_TRACE_SCOPE("FastMultipoleRelayoutSession::localPass");
+	const ArrayGraph &AG = *m_pArrayGraph;
+	float *x = m_pArrayGraph->nodeXPos();
+	float *y = m_pArrayGraph->nodeYPos();
+	const float *s = AG.nodeSize();
+	const float *length = AG.desiredEdgeLength();
+	const uint32_t n = AG.numNodes();
+	const int k = static_cast<int>(active.size());
+	const float timeStep = m_pOptions->timeStep;
+
+	const unsigned int numThreads = numberOfThreadsFor(m_numberOfThreads, k, s_minNodesPerThread);
+	std::vector<float> fx(k), fy(k);
+	std::vector<double> maxForceSq(numThreads, 0.0);
+
+	for (int it = 0; it < m_localIterations; it++) {
+		// the same forces as the direct kernel of the fast multipole embedder, but only on the active nodes
+		parallelFor(numThreads, k, [&](int begin, int end, unsigned int t) {
+			double maxSq = 0.0;
+			for (int a = begin; a < end; a++) {
+				const uint32_t i = active[a];
+				float fxi = 0.0f, fyi = 0.0f;
+				for (uint32_t j = 0; j < n; j++) {
+					if (j == i) {
+						continue;
+					}
+					const float dx = x[i] - x[j];
+					const float dy = y[i] - y[j];
+					const float s_sum = s[i] + s[j];
+					const float f = OGDF_FME_KERNEL_COMPUTE_FORCE(dx, dy, s_sum);
+					fxi += dx*f;
+					fyi += dy*f;
+				}
+				const uint32_t degree = AG.nodeInfo(i).degree;
+				uint32_t adj = AG.firstEdgeAdjIndex(i);
+				for (uint32_t d = 0; d < degree; d++) {
+					const uint32_t j = AG.twinNodeIndex(adj, i);
+					if (j != i) {
+						const float dx = x[i] - x[j];
+						const float dy = y[i] - y[j];
+						const float f = (logf(dx*dx + dy*dy)*0.5f - logf(length[adj])) * 0.25f / degree;
+						fxi -= dx*f;
+						fyi -= dy*f;
+					}
+					adj = AG.nextEdgeAdjIndex(adj, i);
+				}
+				fx[a] = fxi;
+				fy[a] = fyi;
+				maxSq = std::max(maxSq, (double)(fxi*fxi + fyi*fyi));
+			}
+			maxForceSq[t] = maxSq;
+		});
+
+		double maxSq = 0.0;
+		for (unsigned int t = 0; t < numThreads; t++) {
+			maxSq = std::max(maxSq, maxForceSq[t]);
+		}
+		if (!(maxSq < FLT_MAX)) {
+			break;
+		}
+		for (int a = 0; a < k; a++) {
+			x[active[a]] += fx[a]*timeStep;
+			y[active[a]] += fy[a]*timeStep;
+		}
+		if (it >= static_cast<int>(m_pOptions->minNumIterations) && maxSq < m_pOptions->stopCritForce) {
+			break;
+		}
+	}
+}
+
+void FastMultipoleRelayoutSession::writePositions()
+{
+	const float *x = m_pArrayGraph->nodeXPos();
+	const float *y = m_pArrayGraph->nodeYPos();
+	const float *radius = m_pArrayGraph->nodeMoveRadius();
+	for (node v : m_GA.constGraph().nodes) {
+		const uint32_t i = m_index[v];
+		if (radius[i] > 0.0f) {
+			m_GA.x(v) = x[i];
+			m_GA.y(v) = y[i];
+		}
+	}
+}
+
+}
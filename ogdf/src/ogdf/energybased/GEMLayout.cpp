@@ -350,4 +350,18 @@ void GEMLayout::updateNode(GraphCopy &G, GraphCopyAttributes &AG,node v) {
 	}
 }
 
+LayoutCostEstimate GEMLayout::estimateCost(const GraphAttributes &GA) const
+{
+	const LayoutCostEstimate::GraphProfile profile(GA.constGraph());
+
+	// each round moves one node and computes its impulse against all other
+	// nodes of its component, and the rounds are spent per component
+	LayoutCostEstimate cost;
+	cost.peakMemory = 2 * LayoutCostEstimate::attributesMemory(GA);
+	cost.operations = double(m_numberOfRounds) * profile.numberOfComponents
+	  * (double(profile.maxComponentNodes) + 2.0 * profile.maxComponentEdges / max(profile.maxComponentNodes, 1));
+	cost.timeClass = LayoutCostEstimate::TimeClass::Quadratic;
+	return cost;
+}
+
 } // end namespace ogdf
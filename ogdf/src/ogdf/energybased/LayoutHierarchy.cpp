@@ -0,0 +1,187 @@
+/** \file
+ * \brief Implementation of class LayoutHierarchy
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/energybased/LayoutHierarchy.h>
+#include <algorithm>
+
+namespace ogdf {
+
+namespace {
+
+struct WeightedEdge {
+	int source;
+	int target;
+	double weight;
+};
+
+// Stores the edges in \p edges as edges of \p level, merging parallel
+// edges and dropping self-loops.
+void setEdges(LayoutHierarchy::Level &level, std::vector<WeightedEdge> &edges)
+{
+	for (WeightedEdge &e : edges) {
+		if (e.source > e.target) {
+			std::swap(e.source, e.target);
+		}
+	}
+	std::sort(edges.begin(), edges.end(), [](const WeightedEdge &a, const WeightedEdge &b) {
+		return a.source < b.source || (a.source == b.source && a.target < b.target);
+	});
+
+	level.source.clear();
+	level.target.clear();
+	level.weight.clear();
+	for (const WeightedEdge &e : edges) {
+		if (e.source == e.target) {
+			continue;
+		}
+		if (!level.source.empty() && level.source.back() == e.source && level.target.back() == e.target) {
+			level.weight.back() += e.weight;
+		} else {
+			level.source.push_back(e.source);
+			level.target.push_back(e.target);
+			level.weight.push_back(e.weight);
+		}
+	}
+}
+
+void resizeNodeAttributes(LayoutHierarchy::Level &level)
+{
+	const int n = level.numberOfNodes();
+	level.mass.assign(n, 0);
+	level.x.assign(n, 0.0);
+	level.y.assign(n, 0.0);
+	level.width.assign(n, 0.0);
+	level.height.assign(n, 0.0);
+}
+
+}
+
+
+void LayoutHierarchy::init(int n)
+{
+	m_levels.clear();
+	m_levels.resize(1);
+	m_levels[0].parent.assign(n, -1);
+}
+
+
+int LayoutHierarchy::addNode(int i)
+{
+	OGDF_ASSERT(0 <= i);
+	OGDF_ASSERT(i <= numberOfLevels());
+	if (i == numberOfLevels()) {
+		m_levels.emplace_back();
+	}
+	m_levels[i].parent.push_back(-1);
+	return m_levels[i].numberOfNodes() - 1;
+}
+
+
+void LayoutHierarchy::aggregate(const GraphAttributes &GA, const NodeArray<int> &index)
+{
+	OGDF_ASSERT(!empty());
+	const Graph &G = GA.constGraph();
+
+	for (int i = 0; i + 1 < numberOfLevels(); ++i) {
+		std::vector<int> &parent = m_levels[i].parent;
+		for (int &p : parent) {
+			if (p < 0) {
+				p = addNode(i + 1);
+			}
+		}
+	}
+
+	Level &finest = m_levels[0];
+	resizeNodeAttributes(finest);
+	for (node v : G.nodes) {
+		const int i = index[v];
+		finest.mass[i] = 1;
+		finest.x[i] = GA.x(v);
+		finest.y[i] = GA.y(v);
+		finest.width[i] = GA.width(v);
+		finest.height[i] = GA.height(v);
+	}
+
+	std::vector<WeightedEdge> edges;
+	edges.reserve(G.numberOfEdges());
+	for (edge e : G.edges) {
+		edges.push_back({index[e->source()], index[e->target()], 1.0});
+	}
+	setEdges(finest, edges);
+
+	for (int i = 1; i < numberOfLevels(); ++i) {
+		const Level &fine = m_levels[i - 1];
+		Level &coarse = m_levels[i];
+		const int n = coarse.numberOfNodes();
+		resizeNodeAttributes(coarse);
+
+		// barycenters weighted by mass, and bounding boxes of the children
+		std::vector<double> left(n, 0.0), right(n, 0.0), bottom(n, 0.0), top(n, 0.0);
+		for (int v = 0; v < fine.numberOfNodes(); ++v) {
+			if (fine.mass[v] == 0) {
+				continue;
+			}
+			const int p = fine.parent[v];
+			const double l = fine.x[v] - fine.width[v] / 2;
+			const double r = fine.x[v] + fine.width[v] / 2;
+			const double b = fine.y[v] - fine.height[v] / 2;
+			const double t = fine.y[v] + fine.height[v] / 2;
+			if (coarse.mass[p] == 0) {
+				left[p] = l;
+				right[p] = r;
+				bottom[p] = b;
+				top[p] = t;
+			} else {
+				left[p] = std::min(left[p], l);
+				right[p] = std::max(right[p], r);
+				bottom[p] = std::min(bottom[p], b);
+				top[p] = std::max(top[p], t);
+			}
+			coarse.mass[p] += fine.mass[v];
+			coarse.x[p] += fine.mass[v] * fine.x[v];
+			coarse.y[p] += fine.mass[v] * fine.y[v];
+		}
+		for (int p = 0; p < n; ++p) {
+			if (coarse.mass[p] > 0) {
+				coarse.x[p] /= coarse.mass[p];
+				coarse.y[p] /= coarse.mass[p];
+				coarse.width[p] = right[p] - left[p];
+				coarse.height[p] = top[p] - bottom[p];
+			}
+		}
+
+		edges.clear();
+		for (int e = 0; e < fine.numberOfEdges(); ++e) {
+			edges.push_back({fine.parent[fine.source[e]], fine.parent[fine.target[e]], fine.weight[e]});
+		}
+		setEdges(coarse, edges);
+	}
+}
+
+}
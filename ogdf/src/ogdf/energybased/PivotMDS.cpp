@@ -30,12 +30,180 @@
  */
 
 #include <ogdf/energybased/PivotMDS.h>
+#include <ogdf/basic/ParallelFor.h>
+#include <atomic>
+#include <queue>
 
 
 namespace ogdf {
 
 const double PivotMDS::EPSILON = 1 - 1e-10;
 const double PivotMDS::FACTOR = -0.5;
+const double PivotMDS::RANK_EPSILON = 1e-10;
+
+namespace {
+
+//! Number of nodes processed as one block by the matrix operations.
+constexpr int BLOCK_SIZE = 256;
+
+//! Minimal number of nodes per thread.
+constexpr int MIN_NODES_PER_THREAD = 4096;
+
+//! Returns the dot product of the vectors of length \p len starting at \p x and \p y.
+inline double dotProduct(const double *x, const double *y, int len)
+{
+	// independent partial sums allow for vectorization
+	double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	int i = 0;
+	for (; i + 4 <= len; i += 4) {
+		s0 += x[i] * y[i];
+		s1 += x[i+1] * y[i+1];
+		s2 += x[i+2] * y[i+2];
+		s3 += x[i+3] * y[i+3];
+	}
+	for (; i < len; ++i) {
+		s0 += x[i] * y[i];
+	}
+	return (s0 + s1) + (s2 + s3);
+}
+
+//! Adds the dot products of the vector at \p x with the four vectors at \p y0, ..., \p y3 of length \p len to \p sum.
+inline void dotProduct4(const double *x, const double *y0, const double *y1, const double *y2, const double *y3, int len, double *sum)
+{
+	// two independent partial sums per product allow for vectorization
+	double s00 = 0, s01 = 0, s10 = 0, s11 = 0, s20 = 0, s21 = 0, s30 = 0, s31 = 0;
+	int i = 0;
+	for (; i + 2 <= len; i += 2) {
+		s00 += x[i] * y0[i];
+		s01 += x[i+1] * y0[i+1];
+		s10 += x[i] * y1[i];
+		s11 += x[i+1] * y1[i+1];
+		s20 += x[i] * y2[i];
+		s21 += x[i+1] * y2[i+1];
+		s30 += x[i] * y3[i];
+		s31 += x[i+1] * y3[i+1];
+	}
+	for (; i < len; ++i) {
+		s00 += x[i] * y0[i];
+		s10 += x[i] * y1[i];
+		s20 += x[i] * y2[i];
+		s30 += x[i] * y3[i];
+	}
+	sum[0] += s00 + s01;
+	sum[1] += s10 + s11;
+	sum[2] += s20 + s21;
+	sum[3] += s30 + s31;
+}
+
+//! Adjacency lists of a graph in compressed sparse row format.
+struct AdjacencyArrays {
+	Array<int> start; //!< The neighbors of node \a v are at [start[v], start[v+1]).
+	Array<int> target; //!< The indices of the neighbors.
+	Array<double> cost; //!< The costs of the adjacencies, if any.
+
+	AdjacencyArrays(const Graph &G, const NodeArray<int> &index, const EdgeArray<double> *edgeCosts)
+		: start(0, G.numberOfNodes(), 0), target(2 * G.numberOfEdges())
+	{
+		if (edgeCosts != nullptr) {
+			cost.init(2 * G.numberOfEdges());
+		}
+		int i = 0;
+		for (node v : G.nodes) {
+			start[index[v]] = i;
+			for (adjEntry adj : v->adjEntries) {
+				if (edgeCosts != nullptr) {
+					cost[i] = (*edgeCosts)[adj->theEdge()];
+				}
+				target[i++] = index[adj->twinNode()];
+			}
+		}
+		start[G.numberOfNodes()] = i;
+	}
+};
+
+//! Computes the distances from \p source with uniform \p edgeCosts by a level-synchronous BFS.
+/**
+ * A node is claimed for the next level by atomically setting its \p visited
+ * entry to \p round, so the frontier can be expanded by several threads.
+ */
+void bfsDistances(
+	const AdjacencyArrays &adjacency,
+	int source,
+	double edgeCosts,
+	int round,
+	std::vector<std::atomic<int>> &visited,
+	double *distance,
+	unsigned int maxThreads)
+{
+	Array<ArrayBuffer<int>> next(maxThreads);
+	ArrayBuffer<int> frontier;
+
+	visited[source].store(round, std::memory_order_relaxed);
+	distance[source] = 0;
+	frontier.push(source);
+
+	for (double d = edgeCosts; !frontier.empty(); d += edgeCosts) {
+		const unsigned int numThreads = numberOfThreadsFor(maxThreads, frontier.size(), MIN_NODES_PER_THREAD);
+		parallelFor(numThreads, frontier.size(), [&](int begin, int end, unsigned int t) {
+			ArrayBuffer<int> &nextFrontier = next[t];
+			for (int i = begin; i < end; ++i) {
+				const int v = frontier[i];
+				for (int j = adjacency.start[v]; j < adjacency.start[v+1]; ++j) {
+					const int w = adjacency.target[j];
+					int old = visited[w].load(std::memory_order_relaxed);
+					if (old == round) {
+						continue;
+					}
+					if (numThreads == 1) {
+						visited[w].store(round, std::memory_order_relaxed);
+					} else if (!visited[w].compare_exchange_strong(old, round, std::memory_order_relaxed)) {
+						continue;
+					}
+					distance[w] = d;
+					nextFrontier.push(w);
+				}
+			}
+		});
+
+		frontier.clear();
+		for (unsigned int t = 0; t < numThreads; ++t) {
+			for (int w : next[t]) {
+				frontier.push(w);
+			}
+			next[t].clear();
+		}
+	}
+}
+
+//! Computes the distances from \p source with Dijkstra's algorithm.
+void dijkstraDistances(const AdjacencyArrays &adjacency, int source, double *distance, int n)
+{
+	using Entry = std::pair<double, int>;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+	std::fill(distance, distance + n, std::numeric_limits<double>::infinity());
+	distance[source] = 0;
+	queue.emplace(0, source);
+
+	while (!queue.empty()) {
+		Entry entry = queue.top();
+		queue.pop();
+		const int v = entry.second;
+		if (entry.first > distance[v]) {
+			continue; // outdated entry
+		}
+		for (int j = adjacency.start[v]; j < adjacency.start[v+1]; ++j) {
+			const int w = adjacency.target[j];
+			const double d = entry.first + adjacency.cost[j];
+			if (d < distance[w]) {
+				distance[w] = d;
+				queue.emplace(d, w);
+			}
+		}
+	}
+}
+
+}
 
 
 void PivotMDS::call(GraphAttributes& GA)
@@ -52,45 +220,64 @@ void PivotMDS::call(GraphAttributes& GA)
 }
 
 
-void PivotMDS::centerPivotmatrix(Array<Array<double> >& pivotMatrix)
+void PivotMDS::centerPivotmatrix(Array<double>& pivotMatrix, int numberOfPivots)
 {
-	int numberOfPivots = pivotMatrix.size();
 	// this is ensured since the graph size is at least 2!
-	int nodeCount = pivotMatrix[0].size();
+	const int nodeCount = pivotMatrix.size() / numberOfPivots;
+	double *matrix = &pivotMatrix[0];
 
 	double normalizationFactor = 0;
-	double rowColNormalizer;
 	Array<double> colNormalization(numberOfPivots);
 
-	for (int i = 0; i < numberOfPivots; i++) {
-		rowColNormalizer = 0;
-		for (int j = 0; j < nodeCount; j++) {
-			rowColNormalizer += pivotMatrix[i][j] * pivotMatrix[i][j];
+	parallelFor(numberOfThreadsFor(m_maxThreads, numberOfPivots, 1), numberOfPivots, [&](int begin, int end, unsigned int) {
+		for (int i = begin; i < end; i++) {
+			const double *row = matrix + static_cast<size_t>(i) * nodeCount;
+			colNormalization[i] = dotProduct(row, row, nodeCount);
 		}
-		normalizationFactor += rowColNormalizer;
-		colNormalization[i] = rowColNormalizer / nodeCount;
+	});
+	for (int i = 0; i < numberOfPivots; i++) {
+		normalizationFactor += colNormalization[i];
+		colNormalization[i] /= nodeCount;
 	}
 	normalizationFactor = normalizationFactor / (nodeCount * numberOfPivots);
-	for (int i = 0; i < nodeCount; i++) {
-		rowColNormalizer = 0;
-		for (int j = 0; j < numberOfPivots; j++) {
-			double square = pivotMatrix[j][i] * pivotMatrix[j][i];
-			pivotMatrix[j][i] = square + normalizationFactor
-					- colNormalization[j];
-			rowColNormalizer += square;
-		}
-		rowColNormalizer /= numberOfPivots;
-		for (int j = 0; j < numberOfPivots; j++) {
-			pivotMatrix[j][i] = FACTOR * (pivotMatrix[j][i] - rowColNormalizer);
+
+	// the columns are processed in blocks so that the rows of a block stay in cache
+	const int numberOfBlocks = (nodeCount + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	const unsigned int numThreads = numberOfThreadsFor(m_maxThreads, nodeCount, MIN_NODES_PER_THREAD);
+	parallelFor(numThreads, numberOfBlocks, [&](int beginBlock, int endBlock, unsigned int) {
+		double rowColNormalizer[BLOCK_SIZE];
+		for (int b = beginBlock; b < endBlock; b++) {
+			const int begin = b * BLOCK_SIZE;
+			const int len = std::min(BLOCK_SIZE, nodeCount - begin);
+			std::fill(rowColNormalizer, rowColNormalizer + len, 0.0);
+			for (int j = 0; j < numberOfPivots; j++) {
+				double *row = matrix + static_cast<size_t>(j) * nodeCount + begin;
+				const double shift = normalizationFactor - colNormalization[j];
+				for (int i = 0; i < len; i++) {
+					double square = row[i] * row[i];
+					row[i] = square + shift;
+					rowColNormalizer[i] += square;
+				}
+			}
+			for (int i = 0; i < len; i++) {
+				rowColNormalizer[i] /= numberOfPivots;
+			}
+			for (int j = 0; j < numberOfPivots; j++) {
+				double *row = matrix + static_cast<size_t>(j) * nodeCount + begin;
+				for (int i = 0; i < len; i++) {
+					row[i] = FACTOR * (row[i] - rowColNormalizer[i]);
+				}
+			}
 		}
-	}
+	});
 }
 
 
 void PivotMDS::pivotMDSLayout(GraphAttributes& GA)
 {
 	const Graph& G = GA.constGraph();
-	bool use3D = GA.has(GraphAttributes::threeD) && DIMENSION_COUNT > 2;
+	bool use3D = GA.has(GraphAttributes::threeD) && !m_forcing2DLayout;
+	m_dimensionCount = use3D ? 3 : MIN_DIMENSION_COUNT;
 
 	const int n = G.numberOfNodes();
 
@@ -111,21 +298,28 @@ void PivotMDS::pivotMDSLayout(GraphAttributes& GA)
 	const node head = getRootedPath(G);
 	if (head != nullptr) {
 		doPathLayout(GA, head);
+		if (use3D) {
+			for (node v : G.nodes) {
+				GA.z(v) = 0.0;
+			}
+		}
 	}
 	else {
-		Array<Array<double> > pivDistMatrix;
+		// lower the number of pivots if necessary
+		const int numberOfPivots = min(n, max(m_numberOfPivots, m_dimensionCount));
+		Array<double> pivDistMatrix;
 		// compute the pivot matrix
-		getPivotDistanceMatrix(GA, pivDistMatrix);
+		getPivotDistanceMatrix(GA, pivDistMatrix, numberOfPivots);
 		// center the pivot matrix
-		centerPivotmatrix(pivDistMatrix);
+		centerPivotmatrix(pivDistMatrix, numberOfPivots);
 		// init the coordinate matrix
-		Array<Array<double> > coord(DIMENSION_COUNT);
+		Array<Array<double> > coord(m_dimensionCount);
 		for (auto &elem : coord) {
 			elem.init(n);
 		}
 		// init the eigen values array
-		Array<double> eVals(DIMENSION_COUNT);
-		singularValueDecomposition(pivDistMatrix, coord, eVals);
+		Array<double> eVals(m_dimensionCount);
+		singularValueDecomposition(pivDistMatrix, numberOfPivots, coord, eVals);
 		// compute the correct aspect ratio
 		for (int i = 0; i < coord.size(); i++) {
 			eVals[i] = sqrt(eVals[i]);
@@ -140,7 +334,7 @@ void PivotMDS::pivotMDSLayout(GraphAttributes& GA)
 			GA.x(v) = coord[0][i];
 			GA.y(v) = coord[1][i];
 			if (use3D){
-				GA.z(v) = coord[2][i];//cout << coord[2][i] << "\n";
+				GA.z(v) = coord[2][i];
 			}
 			++i;
 		}
@@ -178,16 +372,20 @@ void PivotMDS::doPathLayout(GraphAttributes& GA, const node& v)
 
 
 void PivotMDS::eigenValueDecomposition(
-	Array<Array<double> >& K,
+	const Array<double>& K,
 	Array<Array<double> >& eVecs,
 	Array<double>& eValues)
 {
 	randomize(eVecs);
-	const int p = K.size();
+	const int p = eVecs[0].size();
 	double r = 0;
-	for (int i = 0; i < DIMENSION_COUNT; i++) {
+	for (int i = 0; i < m_dimensionCount; i++) {
 		eValues[i] = normalize(eVecs[i]);
 	}
+	Array<Array<double> > tmpOld(m_dimensionCount);
+	for (int i = 0; i < m_dimensionCount; i++) {
+		tmpOld[i].init(p);
+	}
 	while (r < EPSILON) {
 		if (std::isnan(r) || isinf(r)) {
 			// Throw arithmetic exception (Shouldn't occur
@@ -196,24 +394,17 @@ void PivotMDS::eigenValueDecomposition(
 			return;
 		}
 		// remember prev values
-		Array<Array<double> > tmpOld(DIMENSION_COUNT);
-		for (int i = 0; i < DIMENSION_COUNT; i++) {
-			tmpOld[i].init(p);
-			for (int j = 0; j < p; j++) {
-				tmpOld[i][j] = eVecs[i][j];
-				eVecs[i][j] = 0;
-			}
+		for (int i = 0; i < m_dimensionCount; i++) {
+			std::swap(tmpOld[i], eVecs[i]);
 		}
-		// multiply matrices
-		for (int i = 0; i < DIMENSION_COUNT; i++) {
-			for (int j = 0; j < p; j++) {
-				for (int k = 0; k < p; k++) {
-					eVecs[i][k] += K[j][k] * tmpOld[i][j];
-				}
+		// multiply matrices; K is symmetric, so its rows are used
+		for (int i = 0; i < m_dimensionCount; i++) {
+			for (int k = 0; k < p; k++) {
+				eVecs[i][k] = dotProduct(&K[k * p], &tmpOld[i][0], p);
 			}
 		}
 		// orthogonalize
-		for (int i = 0; i < DIMENSION_COUNT; i++) {
+		for (int i = 0; i < m_dimensionCount; i++) {
 			for (int j = 0; j < i; j++) {
 				double fac = prod(eVecs[j], eVecs[i])
 						/ prod(eVecs[j], eVecs[j]);
@@ -223,11 +414,16 @@ void PivotMDS::eigenValueDecomposition(
 			}
 		}
 		// normalize
-		for (int i = 0; i < DIMENSION_COUNT; i++) {
+		for (int i = 0; i < m_dimensionCount; i++) {
 			eValues[i] = normalize(eVecs[i]);
 		}
 		r = 1;
-		for (int i = 0; i < DIMENSION_COUNT; i++) {
+		for (int i = 0; i < m_dimensionCount; i++) {
+			// an eigenvector of a vanishing eigenvalue (e.g., the third one of a
+			// planar point set) is numerical noise and does not converge
+			if (eValues[i] <= RANK_EPSILON * eValues[0]) {
+				continue;
+			}
 			// get absolute value (abs only defined for int)
 			double tmp = prod(eVecs[i], tmpOld[i]);
 			if (tmp < 0) {
@@ -241,21 +437,22 @@ void PivotMDS::eigenValueDecomposition(
 
 void PivotMDS::getPivotDistanceMatrix(
 	const GraphAttributes& GA,
-	Array<Array<double> >& pivDistMatrix)
+	Array<double>& pivDistMatrix,
+	int numberOfPivots)
 {
 	const Graph& G = GA.constGraph();
 	const int n = G.numberOfNodes();
 
-	// lower the number of pivots if necessary
-	int numberOfPivots = min(n, m_numberOfPivots);
 	// number of pivots times n matrix used to store the graph distances
-	pivDistMatrix.init(numberOfPivots);
-	for (int i = 0; i < numberOfPivots; i++) {
-		pivDistMatrix[i].init(n);
+	pivDistMatrix.init(numberOfPivots * n);
+
+	NodeArray<int> index(G);
+	int i = 0;
+	for (node v : G.nodes) {
+		index[v] = i++;
 	}
 	// edges costs array
 	EdgeArray<double> edgeCosts;
-	bool hasEdgeCosts = false;
 	// already checked whether this attribute exists or not (see call method)
 	if (m_hasEdgeCostsAttribute) {
 		edgeCosts.init(G);
@@ -263,30 +460,45 @@ void PivotMDS::getPivotDistanceMatrix(
 		{
 			edgeCosts[e] = GA.doubleWeight(e);
 		}
-		hasEdgeCosts = true;
 	}
+	const AdjacencyArrays adjacency(G, index, m_hasEdgeCostsAttribute ? &edgeCosts : nullptr);
+	std::vector<std::atomic<int>> visited(n);
+	for (auto &elem : visited) {
+		elem.store(-1, std::memory_order_relaxed);
+	}
+
 	// used for min-max strategy
-	NodeArray<double> minDistances(G, std::numeric_limits<double>::infinity());
-	NodeArray<double> shortestPathSingleSource(G);
+	Array<double> minDistances(0, n - 1, std::numeric_limits<double>::infinity());
+	const unsigned int numThreads = numberOfThreadsFor(m_maxThreads, n, MIN_NODES_PER_THREAD);
+	Array<int> threadPivot(numThreads);
 	// the current pivot node
-	node pivNode = G.firstNode();
-	for (int i = 0; i < numberOfPivots; i++) {
+	int pivNode = 0;
+	for (i = 0; i < numberOfPivots; i++) {
 		// get the shortest path from the currently processed pivot node to
 		// all other nodes in the graph
-		shortestPathSingleSource.fill(std::numeric_limits<double>::infinity());
-		if (hasEdgeCosts) {
-			dijkstra_SPSS(pivNode, G, shortestPathSingleSource, edgeCosts);
+		double *shortestPathSingleSource = &pivDistMatrix[i * n];
+		if (m_hasEdgeCostsAttribute) {
+			dijkstraDistances(adjacency, pivNode, shortestPathSingleSource, n);
 		} else {
-			bfs_SPSS(pivNode, G, shortestPathSingleSource, m_edgeCosts);
+			bfsDistances(adjacency, pivNode, m_edgeCosts, i, visited, shortestPathSingleSource, m_maxThreads);
 		}
-		copySPSS(pivDistMatrix[i], shortestPathSingleSource);
 		// update the pivot and the minDistances array ... to ensure the
 		// correctness set minDistance of the pivot node to zero
 		minDistances[pivNode] = 0;
-		for(node v : G.nodes)
-		{
-			minDistances[v] = min(minDistances[v], shortestPathSingleSource[v]);
-			if (minDistances[v] > minDistances[pivNode]) {
+		parallelFor(numThreads, n, [&](int begin, int end, unsigned int t) {
+			int best = -1;
+			for (int v = begin; v < end; v++) {
+				minDistances[v] = min(minDistances[v], shortestPathSingleSource[v]);
+				if (best < 0 || minDistances[v] > minDistances[best]) {
+					best = v;
+				}
+			}
+			threadPivot[t] = best;
+		});
+		// the first node of maximal distance becomes the next pivot
+		for (unsigned int t = 0; t < numThreads; t++) {
+			int v = threadPivot[t];
+			if (v >= 0 && minDistances[v] > minDistances[pivNode]) {
 				pivNode = v;
 			}
 		}
@@ -294,17 +506,6 @@ void PivotMDS::getPivotDistanceMatrix(
 }
 
 
-void PivotMDS::copySPSS(Array<double>& copyTo, NodeArray<double>& copyFrom)
-{
-	const Graph &G = *copyFrom.graphOf();
-
-	int i = 0;
-	for (node v : G.nodes) {
-		copyTo[i++] = copyFrom[v];
-	}
-}
-
-
 node PivotMDS::getRootedPath(const Graph& G)
 {
 	node head = nullptr;
@@ -376,54 +577,88 @@ void PivotMDS::randomize(Array<Array<double> >& matrix)
 }
 
 
-void PivotMDS::selfProduct(const Array<Array<double> >& d, Array<Array<double> >& result)
+void PivotMDS::selfProduct(const Array<double>& d, int numberOfPivots, Array<double>& result)
 {
-	double sum;
-	for (int i = 0; i < d.size(); i++) {
-		for (int j = 0; j <= i; j++) {
-			sum = 0;
-			for (int k = 0; k < d[0].size(); k++) {
-				sum += d[i][k] * d[j][k];
+	const int k = numberOfPivots;
+	const int n = d.size() / k;
+	const double *matrix = &d[0];
+
+	result.init(0, k * k - 1, 0.0);
+
+	// Each thread computes the entries of a range of rows of the lower triangle,
+	// balanced by their number. The columns of d are processed in blocks, and
+	// the entries are summed up over the blocks in the same order by every
+	// thread, so the result does not depend on the number of threads.
+	const unsigned int numThreads = numberOfThreadsFor(m_maxThreads, n, MIN_NODES_PER_THREAD);
+	Array<int> firstRow(numThreads + 1);
+	for (unsigned int t = 0; t <= numThreads; t++) {
+		firstRow[t] = static_cast<int>(std::ceil(k * std::sqrt(static_cast<double>(t) / numThreads)));
+	}
+	parallelFor(numThreads, numThreads, [&](int beginThread, int endThread, unsigned int) {
+		for (int t = beginThread; t < endThread; t++) {
+			for (int begin = 0; begin < n; begin += BLOCK_SIZE) {
+				const int len = std::min(BLOCK_SIZE, n - begin);
+				for (int i = firstRow[t]; i < firstRow[t+1]; i++) {
+					const double *rowI = matrix + static_cast<size_t>(i) * n + begin;
+					auto row = [&](int j) { return matrix + static_cast<size_t>(j) * n + begin; };
+					int j = 0;
+					for (; j + 4 <= i + 1; j += 4) {
+						dotProduct4(rowI, row(j), row(j+1), row(j+2), row(j+3), len, &result[i * k + j]);
+					}
+					for (; j <= i; j++) {
+						result[i * k + j] += dotProduct(rowI, row(j), len);
+					}
+				}
 			}
-			result[i][j] = sum;
-			result[j][i] = sum;
+		}
+	});
+
+	for (int i = 0; i < k; i++) {
+		for (int j = 0; j < i; j++) {
+			result[j * k + i] = result[i * k + j];
 		}
 	}
 }
 
 
 void PivotMDS::singularValueDecomposition(
-	Array<Array<double> >& pivDistMatrix,
+	const Array<double>& pivDistMatrix,
+	int numberOfPivots,
 	Array<Array<double> >& eVecs,
 	Array<double>& eVals)
 {
-	const int l = pivDistMatrix.size();
-	const int n = pivDistMatrix[0].size();
-	Array<Array<double> > K(l);
-	for (int i = 0; i < l; i++) {
-		K[i].init(l);
-	}
+	const int l = numberOfPivots;
+	const int n = pivDistMatrix.size() / l;
 	// calc C^TC
-	selfProduct(pivDistMatrix, K);
+	Array<double> K;
+	selfProduct(pivDistMatrix, l, K);
 
-	Array<Array<double> > tmp(DIMENSION_COUNT);
-	for (int i = 0; i < DIMENSION_COUNT; i++) {
+	Array<Array<double> > tmp(m_dimensionCount);
+	for (int i = 0; i < m_dimensionCount; i++) {
 		tmp[i].init(l);
 	}
 
 	eigenValueDecomposition(K, tmp, eVals);
 
 	// C^Tx
-	for (int i = 0; i < DIMENSION_COUNT; i++) {
+	for (int i = 0; i < m_dimensionCount; i++) {
 		eVals[i] = sqrt(eVals[i]);
-		for (int j = 0; j < n; j++) { // node j
-			eVecs[i][j] = 0;
+	}
+	const double *matrix = &pivDistMatrix[0];
+	parallelFor(numberOfThreadsFor(m_maxThreads, n, MIN_NODES_PER_THREAD), n, [&](int begin, int end, unsigned int) {
+		for (int i = 0; i < m_dimensionCount; i++) {
+			double *x = &eVecs[i][0];
+			std::fill(x + begin, x + end, 0.0);
 			for (int k = 0; k < l; k++) { // pivot k
-				eVecs[i][j] += pivDistMatrix[k][j] * tmp[i][k];
+				const double *row = matrix + static_cast<size_t>(k) * n;
+				const double factor = tmp[i][k];
+				for (int j = begin; j < end; j++) { // node j
+					x[j] += row[j] * factor;
+				}
 			}
 		}
-	}
-	for (int i = 0; i < DIMENSION_COUNT; i++) {
+	});
+	for (int i = 0; i < m_dimensionCount; i++) {
 		normalize(eVecs[i]);
 	}
 }
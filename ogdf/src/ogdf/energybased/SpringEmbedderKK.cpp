@@ -30,27 +30,245 @@
  */
 
 #include <ogdf/energybased/SpringEmbedderKK.h>
+#include <queue>
 
 #ifdef OGDF_DEBUG
 #include <ogdf/basic/simple_graph_alg.h>
 #endif
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace ogdf {
 const double SpringEmbedderKK::startVal = numeric_limits<double>::max() - 1.0;
 const double SpringEmbedderKK::minVal = DBL_MIN;
 const double SpringEmbedderKK::desMinLength = 0.0001;
 const int SpringEmbedderKK::maxVal = numeric_limits<int>::max();
 
+namespace {
+
+//! Sum of the contributions of other nodes to the derivatives of a single node.
+struct Derivatives {
+	double x = 0, y = 0;
+};
+
+//! The three distinct entries of the symmetric Jacobian of a node's partial derivatives.
+struct Jacobian {
+	double xx = 0, xy = 0, yy = 0;
+};
+
+//! The node with the largest partial derivatives found so far.
+struct Candidate {
+	int index = -1;
+	double energy = -1; //!< squared length of the partial derivatives
+};
+
+#ifdef __SSE2__
+//! Loads two consecutive matrix entries.
+inline __m128d load2(const double *p) {
+	return _mm_loadu_pd(p);
+}
+
+inline __m128d load2(const float *p) {
+	return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+}
+
+//! Returns (1 - \p length / (distance of \p dx, \p dy)) * \p strength.
+inline __m128d springFactor(__m128d dx, __m128d dy, __m128d length, __m128d strength) {
+	const __m128d dist = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+	return _mm_mul_pd(strength, _mm_sub_pd(_mm_set1_pd(1.0), _mm_div_pd(length, dist)));
+}
+
+inline double sum(__m128d v) {
+	double a[2];
+	_mm_storeu_pd(a, v);
+	return a[0] + a[1];
+}
+#endif
+
+//! Returns the factor of the contribution of a node at offset (\p dx, \p dy) to the derivatives (eq. 7 and 8 in paper).
+inline double springFactor(double dx, double dy, double length, double strength) {
+	return strength * (1.0 - length / std::sqrt(dx * dx + dy * dy));
+}
+
+//! Adds the contributions of the nodes in [\p begin, \p end) to the partial derivatives of the node at (\p xm, \p ym).
+template<typename T>
+void addDerivatives(int begin, int end, double xm, double ym,
+	const double *x, const double *y, const T *length, const T *strength,
+	Derivatives &der)
+{
+	int j = begin;
+#ifdef __SSE2__
+	const __m128d vxm = _mm_set1_pd(xm), vym = _mm_set1_pd(ym);
+	__m128d sx = _mm_setzero_pd(), sy = _mm_setzero_pd();
+	for (; j + 2 <= end; j += 2) {
+		const __m128d dx = _mm_sub_pd(vxm, _mm_loadu_pd(x + j));
+		const __m128d dy = _mm_sub_pd(vym, _mm_loadu_pd(y + j));
+		const __m128d f = springFactor(dx, dy, load2(length + j), load2(strength + j));
+		sx = _mm_add_pd(sx, _mm_mul_pd(f, dx));
+		sy = _mm_add_pd(sy, _mm_mul_pd(f, dy));
+	}
+	der.x += sum(sx);
+	der.y += sum(sy);
+#endif
+	for (; j < end; ++j) {
+		const double dx = xm - x[j], dy = ym - y[j];
+		const double f = springFactor(dx, dy, length[j], strength[j]);
+		der.x += f * dx;
+		der.y += f * dy;
+	}
+}
+
+//! Adds the contributions of the nodes in [\p begin, \p end) to the Jacobian of the node at (\p xm, \p ym).
+template<typename T>
+void addJacobian(int begin, int end, double xm, double ym,
+	const double *x, const double *y, const T *length, const T *strength,
+	Jacobian &jac)
+{
+	// k_mi * l_mi / dist^3 is the factor of all off-diagonal terms
+	int j = begin;
+#ifdef __SSE2__
+	const __m128d vxm = _mm_set1_pd(xm), vym = _mm_set1_pd(ym);
+	__m128d sxx = _mm_setzero_pd(), sxy = _mm_setzero_pd(), syy = _mm_setzero_pd();
+	for (; j + 2 <= end; j += 2) {
+		const __m128d dx = _mm_sub_pd(vxm, _mm_loadu_pd(x + j));
+		const __m128d dy = _mm_sub_pd(vym, _mm_loadu_pd(y + j));
+		const __m128d k = load2(strength + j);
+		const __m128d square = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+		const __m128d dist3 = _mm_mul_pd(_mm_sqrt_pd(square), square);
+		const __m128d t = _mm_div_pd(_mm_mul_pd(k, load2(length + j)), dist3);
+		sxx = _mm_add_pd(sxx, _mm_sub_pd(k, _mm_mul_pd(t, _mm_mul_pd(dy, dy))));
+		sxy = _mm_add_pd(sxy, _mm_mul_pd(t, _mm_mul_pd(dx, dy)));
+		syy = _mm_add_pd(syy, _mm_sub_pd(k, _mm_mul_pd(t, _mm_mul_pd(dx, dx))));
+	}
+	jac.xx += sum(sxx);
+	jac.xy += sum(sxy);
+	jac.yy += sum(syy);
+#endif
+	for (; j < end; ++j) {
+		const double dx = xm - x[j], dy = ym - y[j];
+		const double k = strength[j];
+		const double square = dx * dx + dy * dy;
+		const double dist3 = std::sqrt(square) * square;
+		OGDF_ASSERT(dist3 != 0.0);
+		const double t = k * length[j] / dist3;
+		jac.xx += k - t * dy * dy;
+		jac.xy += t * dx * dy;
+		jac.yy += k - t * dx * dx;
+	}
+}
+
+//! Updates the partial derivatives of the nodes in [\p begin, \p end) after node m moved from (\p oldX, \p oldY)
+//! to (\p newX, \p newY), where \p length and \p strength are the matrix rows of m.
+/**
+ * Adds the new contributions of the nodes to the partial derivatives of m to \p der
+ * and updates \p best by the node with the largest partial derivatives.
+ */
+template<typename T>
+void updateDerivatives(int begin, int end, double oldX, double oldY, double newX, double newY,
+	const double *x, const double *y, const T *length, const T *strength,
+	double *derX, double *derY, Derivatives &der, Candidate &best)
+{
+	int j = begin;
+#ifdef __SSE2__
+	const __m128d vOldX = _mm_set1_pd(oldX), vOldY = _mm_set1_pd(oldY);
+	const __m128d vNewX = _mm_set1_pd(newX), vNewY = _mm_set1_pd(newY);
+	__m128d sx = _mm_setzero_pd(), sy = _mm_setzero_pd();
+	// every lane keeps track of its first maximum
+	__m128d bestEnergy = _mm_set1_pd(best.energy), bestIndex = _mm_set1_pd(best.index);
+	__m128d index = _mm_set_pd(j + 1, j);
+	const __m128d two = _mm_set1_pd(2.0);
+	for (; j + 2 <= end; j += 2) {
+		const __m128d xj = _mm_loadu_pd(x + j), yj = _mm_loadu_pd(y + j);
+		const __m128d l = load2(length + j), k = load2(strength + j);
+		const __m128d oldDx = _mm_sub_pd(vOldX, xj), oldDy = _mm_sub_pd(vOldY, yj);
+		const __m128d newDx = _mm_sub_pd(vNewX, xj), newDy = _mm_sub_pd(vNewY, yj);
+		const __m128d oldF = springFactor(oldDx, oldDy, l, k);
+		const __m128d newF = springFactor(newDx, newDy, l, k);
+		const __m128d newContX = _mm_mul_pd(newF, newDx), newContY = _mm_mul_pd(newF, newDy);
+		sx = _mm_add_pd(sx, newContX);
+		sy = _mm_add_pd(sy, newContY);
+		// the contribution of m to node j is the negated contribution of j to m
+		const __m128d dx = _mm_add_pd(_mm_sub_pd(_mm_loadu_pd(derX + j), newContX), _mm_mul_pd(oldF, oldDx));
+		const __m128d dy = _mm_add_pd(_mm_sub_pd(_mm_loadu_pd(derY + j), newContY), _mm_mul_pd(oldF, oldDy));
+		_mm_storeu_pd(derX + j, dx);
+		_mm_storeu_pd(derY + j, dy);
+		const __m128d energy = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+		const __m128d greater = _mm_cmpgt_pd(energy, bestEnergy);
+		bestEnergy = _mm_or_pd(_mm_and_pd(greater, energy), _mm_andnot_pd(greater, bestEnergy));
+		bestIndex = _mm_or_pd(_mm_and_pd(greater, index), _mm_andnot_pd(greater, bestIndex));
+		index = _mm_add_pd(index, two);
+	}
+	der.x += sum(sx);
+	der.y += sum(sy);
+	double energies[2], indices[2];
+	_mm_storeu_pd(energies, bestEnergy);
+	_mm_storeu_pd(indices, bestIndex);
+	for (int l = 0; l < 2; ++l) {
+		const int i = static_cast<int>(indices[l]);
+		if (energies[l] > best.energy || (energies[l] == best.energy && i < best.index)) {
+			best.energy = energies[l];
+			best.index = i;
+		}
+	}
+#endif
+	for (; j < end; ++j) {
+		const double oldDx = oldX - x[j], oldDy = oldY - y[j];
+		const double newDx = newX - x[j], newDy = newY - y[j];
+		const double oldF = springFactor(oldDx, oldDy, length[j], strength[j]);
+		const double newF = springFactor(newDx, newDy, length[j], strength[j]);
+		der.x += newF * newDx;
+		der.y += newF * newDy;
+		derX[j] += oldF * oldDx - newF * newDx;
+		derY[j] += oldF * oldDy - newF * newDy;
+		const double energy = derX[j] * derX[j] + derY[j] * derY[j];
+		if (energy > best.energy) {
+			best.energy = energy;
+			best.index = j;
+		}
+	}
+}
+
+//! Adjacency lists of a graph in compressed form, the nodes are indexed in the order of G.nodes.
+struct AdjacencyArrays {
+	Array<int> start;  //!< the neighbors of node i are at [start[i], start[i+1])
+	Array<int> target; //!< the neighbor's index
+	Array<edge> edges; //!< the corresponding edge
+
+	explicit AdjacencyArrays(const Graph &G) : start(G.numberOfNodes() + 1), target(2 * G.numberOfEdges()), edges(2 * G.numberOfEdges()) {
+		NodeArray<int> index(G);
+		int i = 0;
+		for (node v : G.nodes) {
+			index[v] = i++;
+		}
+		int j = 0;
+		i = 0;
+		for (node v : G.nodes) {
+			start[i++] = j;
+			for (adjEntry adj : v->adjEntries) {
+				target[j] = index[adj->twinNode()];
+				edges[j++] = adj->theEdge();
+			}
+		}
+		start[i] = j;
+	}
+};
+
+}
+
+
+template<typename T>
 void SpringEmbedderKK::initialize(
 	GraphAttributes& GA,
-	NodeArray<dpair>& partialDer,
 	const EdgeArray<double>& eLength,
-	NodeArray< NodeArray<double> >& oLength,
-	NodeArray< NodeArray<double> >& sstrength,
+	Array<T>& oLength,
+	Array<T>& sstrength,
 	bool simpleBFS)
 {
 	double maxDist;
 	const Graph &G = GA.constGraph();
+	const int n = G.numberOfNodes();
 	m_prevEnergy =  startVal;
 	m_prevLEnergy =  startVal;
 
@@ -60,36 +278,22 @@ void SpringEmbedderKK::initialize(
 		shufflePositions(GA);
 
 	//the shortest path lengths
-	for(node v : G.nodes)
-		oLength[v].init(G, numeric_limits<double>::max());
+	oLength.init(n * n);
+	oLength.fill(numeric_limits<T>::max());
+	sstrength.init(n * n);
 
 	//computes shortest path distances d_ij
 	if (simpleBFS)
 	{
 		//we use simply BFS n times
-		//TODO experimentally compare speed, also with bintree dijkstra
-#if 0
-#ifdef OGDF_DEBUG
-		double timeUsed;
-		usedTime(timeUsed);
-#endif
-#endif
 		maxDist = allpairsspBFS(G, oLength);
-
-#if 0
-#ifdef OGDF_DEBUG
-		timeUsed = usedTime(timeUsed);
-		cout << "\n******APSP BFS runtime: \n";
-#endif
-#endif
 	}
 	else
 	{
 		EdgeArray<double> adaptedLength(G);
 		adaptLengths(G, GA, eLength, adaptedLength);
-		//we use simply the BFM n times or Floyd instead, leading to cubic runtime
-		//TODO experimentally compare speed, also with bintree dijkstra
-		maxDist = allpairssp(G, adaptedLength, oLength, numeric_limits<double>::max());
+		//we use Dijkstra's algorithm n times
+		maxDist = allpairssp(G, adaptedLength, oLength);
 	}
 	//computes original spring length l_ij
 
@@ -142,175 +346,151 @@ void SpringEmbedderKK::initialize(
 	}//set L != 0
 	// Having L we can compute the original lengths l_ij
 	// Computes spring strengths k_ij
-	double dij;
-	for(node v : G.nodes)
+	for (int i = 0; i < n; ++i)
 	{
-		sstrength[v].init(G);
-		for(node w : G.nodes)
+		for (int j = 0; j < n; ++j)
 		{
-			dij = oLength[v][w];
-			if (dij == numeric_limits<double>::max())
+			const T dij = oLength[i * n + j];
+			if (dij == numeric_limits<T>::max())
 			{
-				sstrength[v][w] = minVal;
+				sstrength[i * n + j] = numeric_limits<T>::min();
 			}
 			else
 			{
-				oLength[v][w] = L * dij;
-				if (v==w) sstrength[v][w] = 1.0;
+				oLength[i * n + j] = static_cast<T>(L * dij);
+				if (i == j) sstrength[i * n + j] = 1;
 				else
-				sstrength[v][w] = m_K / (dij * dij);
-
-
-
+				sstrength[i * n + j] = static_cast<T>(m_K / (double(dij) * dij));
 			}
 		}
 	}
 }//initialize
 
 
+template<typename T>
 void SpringEmbedderKK::mainStep(GraphAttributes& GA,
-								NodeArray<dpair>& partialDer,
-								NodeArray< NodeArray<double> >& oLength,
-								NodeArray< NodeArray<double> >& sstrength)
+								const Array<T>& oLength,
+								const Array<T>& sstrength)
 {
 	const Graph &G = GA.constGraph();
+	const int n = G.numberOfNodes();
+
+	// positions and partial derivatives (dE/dx_m, dE/dy_m) in the order of G.nodes
+	Array<double> x(n), y(n), derX(n), derY(n);
+	int i = 0;
+	for (node v : G.nodes) {
+		x[i] = GA.x(v);
+		y[i++] = GA.y(v);
+	}
 
-#ifdef OGDF_DEBUG
-	NodeArray<int> nodeCounts(G, 0);
-	int nodeCount = 0; //number of moved nodes
-#endif
-	// Now we compute delta_m, we search for the node with max value
-	double delta_m = 0.0;
-	node best_m = G.firstNode();
-
-	// Compute the partial derivatives first
-	for(node v : G.nodes)
-	{
-		dpair parder = computeParDers(v, GA, sstrength, oLength);
-		partialDer[v] = parder;
-		//delta_m is sqrt of squares of partial derivatives
-		double delta_v = sqrt(parder.x1()*parder.x1() + parder.x2()*parder.x2());
-
-		if (delta_v > delta_m)
-		{
-			best_m = v;
-			delta_m = delta_v;
+	// Compute the partial derivatives first,
+	// then we search for the node with max value delta_m
+	// (the sqrt of squares of partial derivatives)
+	Candidate best;
+	for (int m = 0; m < n; ++m) {
+		const T *lengthRow = &oLength[m * n], *strengthRow = &sstrength[m * n];
+		Derivatives der;
+		addDerivatives(0, m, x[m], y[m], &x[0], &y[0], lengthRow, strengthRow, der);
+		addDerivatives(m + 1, n, x[m], y[m], &x[0], &y[0], lengthRow, strengthRow, der);
+		derX[m] = der.x;
+		derY[m] = der.y;
+		const double energy = der.x * der.x + der.y * der.y;
+		if (energy > best.energy) {
+			best.index = m;
+			best.energy = energy;
 		}
 	}
 
-	int globalItCount, localItCount;
+	int globalItCount;
 	if (m_computeMaxIt)
 	{
-		globalItCount = m_gItBaseVal+m_gItFactor*G.numberOfNodes();
-		localItCount = 2*G.numberOfNodes();
+		globalItCount = m_gItBaseVal+m_gItFactor*n;
 	}
 	else
 	{
 		globalItCount = m_maxGlobalIt;
-		localItCount = m_maxLocalIt;
 	}
 
-
-	while (globalItCount-- > 0 && !finished(delta_m))
+	while (globalItCount-- > 0 && !finished(sqrt(best.energy)))
 	{
-#ifdef OGDF_DEBUG
-		nodeCount++;
-		nodeCounts[best_m]++;
-#endif
-		// The contribution best_m makes to the partial derivatives of
-		// each vertex.
-		NodeArray<dpair> p_partials(G);
-		for(node v : G.nodes)
-		{
-			p_partials[v] = computeParDer(v, best_m, GA, sstrength, oLength);
+		const int m = best.index;
+		const T *lengthRow = &oLength[m * n], *strengthRow = &sstrength[m * n];
+
+		// Compute the 4 elements of the Jacobian, dE_dx_dy = dE_dy_dx
+		Jacobian jac;
+		addJacobian(0, m, x[m], y[m], &x[0], &y[0], lengthRow, strengthRow, jac);
+		addJacobian(m + 1, n, x[m], y[m], &x[0], &y[0], lengthRow, strengthRow, jac);
+
+		// Solve for delta_x and delta_y, a single Newton-Raphson step is
+		// performed for the selected node
+		double dE_dx = derX[m];
+		double dE_dy = derY[m];
+
+		double delta_x =
+			(jac.xy * dE_dy - jac.yy * dE_dx)
+			/ (jac.xx * jac.yy - jac.xy * jac.xy);
+
+		double delta_y =
+			(jac.xx * dE_dy - jac.xy * dE_dx)
+			/ (jac.xy * jac.xy - jac.xx * jac.yy);
+
+		// Move m by (delta_x, delta_y)
+		const double oldX = x[m], oldY = y[m];
+		x[m] += delta_x;
+		y[m] += delta_y;
+
+		// Update each partial derivative by the change of the contribution
+		// of m, recompute the partial derivatives of m and select the new
+		// best node. Ties are resolved in favor of m and then by node order.
+		Derivatives der;
+		Candidate next;
+		updateDerivatives(0, m, oldX, oldY, x[m], y[m], &x[0], &y[0], lengthRow, strengthRow,
+			&derX[0], &derY[0], der, next);
+		updateDerivatives(m + 1, n, oldX, oldY, x[m], y[m], &x[0], &y[0], lengthRow, strengthRow,
+			&derX[0], &derY[0], der, next);
+		derX[m] = der.x;
+		derY[m] = der.y;
+		best.index = m;
+		best.energy = der.x * der.x + der.y * der.y;
+		if (next.energy > best.energy) {
+			best = next;
 		}
+	}//while
 
-		localItCount = 0;
-		do {
-			// Compute the 4 elements of the Jacobian
-			double dE_dx_dx = 0.0, dE_dx_dy = 0.0, dE_dy_dx = 0.0, dE_dy_dy = 0.0;
-			for(node v : G.nodes)
-			{
-				if (v != best_m) {
-					double x_diff = GA.x(best_m) - GA.x(v);
-					double y_diff = GA.y(best_m) - GA.y(v);
-					double dist = sqrt(x_diff * x_diff + y_diff * y_diff);
-					double dist3 = dist * dist * dist;
-					OGDF_ASSERT(dist3 != 0.0);
-					double k_mi = sstrength[best_m][v];
-					double l_mi = oLength[best_m][v];
-					dE_dx_dx += k_mi * (1 - (l_mi * y_diff * y_diff)/dist3);
-					dE_dx_dy += k_mi * l_mi * x_diff * y_diff / dist3;
-					dE_dy_dx += k_mi * l_mi * x_diff * y_diff / dist3;
-					dE_dy_dy += k_mi * (1 - (l_mi * x_diff * x_diff)/dist3);
-				}
-			}
-
-			// Solve for delta_x and delta_y
-			double dE_dx = partialDer[best_m].x1();
-			double dE_dy = partialDer[best_m].x2();
-
-			double delta_x =
-				(dE_dx_dy * dE_dy - dE_dy_dy * dE_dx)
-				/ (dE_dx_dx * dE_dy_dy - dE_dx_dy * dE_dy_dx);
-
-			double delta_y =
-				(dE_dx_dx * dE_dy - dE_dy_dx * dE_dx)
-				/ (dE_dy_dx * dE_dx_dy - dE_dx_dx * dE_dy_dy);
-
-			// Move p by (delta_x, delta_y)
-			GA.x(best_m) += delta_x;
-			GA.y(best_m) += delta_y;
-
-			// Recompute partial derivatives and delta_p
-			dpair deriv = computeParDers(best_m, GA, sstrength, oLength);
-			partialDer[best_m] = deriv;
+	i = 0;
+	for (node v : G.nodes) {
+		GA.x(v) = x[i];
+		GA.y(v) = y[i++];
+	}
+}//mainStep
 
-			delta_m =
-				sqrt(deriv.x1()*deriv.x1() + deriv.x2()*deriv.x2());
-		} while (localItCount-- > 0 && !finishedNode(delta_m));
 
-		// Select new best_m by updating each partial derivative and delta
-		node old_p = best_m;
-		for(node v : G.nodes)
-		{
-			dpair old_deriv_p = p_partials[v];
-			dpair old_p_partial =
-				computeParDer(v, old_p, GA, sstrength, oLength);
-			dpair deriv = partialDer[v];
+template<typename T>
+void SpringEmbedderKK::layout(GraphAttributes& GA, const EdgeArray<double>& eLength, bool simpleBFS)
+{
+	Array<T> oLength;//first distance, then original length
+	Array<T> sstrength;//the spring strength
 
-			deriv.x1() += old_p_partial.x1() - old_deriv_p.x1();
-			deriv.x2() += old_p_partial.x2() - old_deriv_p.x2();
+	//compute relevant values
+	initialize(GA, eLength, oLength, sstrength, simpleBFS);
 
-			partialDer[v] = deriv;
-			double delta = sqrt(deriv.x1()*deriv.x1() + deriv.x2()*deriv.x2());
+	//main loop with node movement
+	mainStep(GA, oLength, sstrength);
 
-			if (delta > delta_m) {
-				best_m = v;
-				delta_m = delta;
-			}
-		}
-	}//while
-}//mainStep
+	if (simpleBFS) scale(GA);
+}
 
 
 void SpringEmbedderKK::doCall(GraphAttributes& GA, const EdgeArray<double>& eLength, bool simpleBFS)
 {
-	const Graph& G = GA.constGraph();
-	NodeArray<dpair> partialDer(G); //stores the partial derivative per node
-	NodeArray< NodeArray<double> > oLength(G);//first distance, then original length
-	NodeArray< NodeArray<double> > sstrength(G);//the spring strength
-
 	//only for debugging
-	OGDF_ASSERT(isConnected(G));
+	OGDF_ASSERT(isConnected(GA.constGraph()));
 
-	//compute relevant values
-	initialize(GA, partialDer, eLength, oLength, sstrength, simpleBFS);
-
-	//main loop with node movement
-	mainStep(GA, partialDer, oLength, sstrength);
-
-	if (simpleBFS) scale(GA);
+	if (m_singlePrecisionMatrices) {
+		layout<float>(GA, eLength, simpleBFS);
+	} else {
+		layout<double>(GA, eLength, simpleBFS);
+	}
 }
 
 
@@ -364,114 +544,55 @@ void SpringEmbedderKK::shufflePositions(GraphAttributes& GA)
 
 
 
-// Compute contribution of vertex u to the first partial
-// derivatives (dE/dx_m, dE/dy_m) (for vertex m) (eq. 7 and 8 in paper)
-SpringEmbedderKK::dpair SpringEmbedderKK::computeParDer(
-	node m,
-	node u,
-	GraphAttributes& GA,
-	NodeArray< NodeArray<double> >& ss,
-	NodeArray< NodeArray<double> >& dist)
-{
-	dpair result(0.0, 0.0);
-	if (m != u)
-	{
-		double x_diff = GA.x(m) - GA.x(u);
-		double y_diff = GA.y(m) - GA.y(u);
-		double distance = sqrt(x_diff * x_diff + y_diff * y_diff);
-		result.x1() = (ss[m][u]) * (x_diff - (dist[m][u])*x_diff/distance);
-		result.x2() = (ss[m][u]) * (y_diff - (dist[m][u])*y_diff/distance);
-	}
-
-	return result;
-}
-
-
-//compute partial derivative for v
-SpringEmbedderKK::dpair SpringEmbedderKK::computeParDers(node v,
-	GraphAttributes& GA,
-	NodeArray< NodeArray<double> >& ss,
-	NodeArray< NodeArray<double> >& dist)
+//All Pairs Shortest Paths by Dijkstra's algorithm from every node, fills the whole matrix.
+//returns maximum distance. Unreachable pairs keep their initial distance.
+template<typename T>
+double SpringEmbedderKK::allpairssp(const Graph& G, const EdgeArray<double>& eLengths, Array<T>& distance)
 {
-	dpair result(0.0, 0.0);
-	for(node u : GA.constGraph().nodes)
-	{
-		dpair deriv = computeParDer(v, u, GA, ss, dist);
-		result.x1() += deriv.x1();
-		result.x2() += deriv.x2();
+	using Entry = std::pair<double, int>;
+	const int n = G.numberOfNodes();
+	const AdjacencyArrays adjacency(G);
+	Array<double> cost(adjacency.edges.size());
+	for (int j = 0; j < cost.size(); ++j) {
+		cost[j] = eLengths[adjacency.edges[j]];
 	}
 
-	return result;
-}
-
-
-/**
- * Initialise the original estimates from nodes and edges.
- */
-
-//we could speed this up by not using nested NodeArrays and
-//by not doing the fully symmetrical computation on undirected graphs
-//All Pairs Shortest Path Floyd, initializes the whole matrix
-//returns maximum distance. Does not detect negative cycles (lead to neg. values on diagonal)
-//threshold is the value for the distance of non-adjacent nodes, distance has to be
-//initialized with
-double SpringEmbedderKK::allpairssp(const Graph& G, const EdgeArray<double>& eLengths, NodeArray< NodeArray<double> >& distance,
-	const double threshold)
-{
-	double maxDist = -threshold;
-
-	for(node v : G.nodes)
-	{
-		distance[v][v] = 0.0;
-	}
-
-	//TODO: Experimentally compare this against
-	// all nodes and incident edges (memory access) on huge graphs
-	for(edge e : G.edges)
+	double maxDist = 0.0;
+	Array<double> dist(n);
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+	for (int source = 0; source < n; ++source)
 	{
-		distance[e->source()][e->target()] = eLengths[e];
-		distance[e->target()][e->source()] = eLengths[e];
-	}
-
-///**
-// * And run the main loop of the algorithm.
-// */
-	for(node v : G.nodes)
-	{
-		for(node u : G.nodes)
+		dist.fill(numeric_limits<double>::max());
+		dist[source] = 0.0;
+		queue.emplace(0.0, source);
+		while (!queue.empty())
 		{
-			for(node w : G.nodes)
+			Entry entry = queue.top();
+			queue.pop();
+			const int v = entry.second;
+			if (entry.first > dist[v]) {
+				continue; // outdated entry
+			}
+			for (int j = adjacency.start[v]; j < adjacency.start[v+1]; ++j)
 			{
-				if ((distance[u][v] < threshold) && (distance[v][w] < threshold))
-				{
-					distance[u][w] = min( distance[u][w], distance[u][v] + distance[v][w] );
-#if 0
-					distance[w][u] = distance[u][w]; //is done anyway afterwards
-#endif
+				const int w = adjacency.target[j];
+				const double d = entry.first + cost[j];
+				if (d < dist[w]) {
+					dist[w] = d;
+					queue.emplace(d, w);
 				}
-				if (distance[u][w] < threshold)
-					maxDist = max(maxDist,distance[u][w]);
+			}
+		}
+
+		T *row = &distance[source * n];
+		for (int w = 0; w < n; ++w)
+		{
+			if (dist[w] != numeric_limits<double>::max()) {
+				row[w] = static_cast<T>(dist[w]);
+				maxDist = max(maxDist, dist[w]);
 			}
 		}
 	}
-#if 0
-#ifdef OGDF_DEBUG
-	for(node v : G.nodes)
-	{
-		if (distance[v][v] < 0.0) cerr << "\n###Error in shortest path computation###\n\n";
-	}
-	cout << "Maxdist: "<<maxDist<<"\n";
-	for(node u : G.nodes)
-	{
-	for(node w : G.nodes)
-	{
-#if 0
-		cout << "Distance " << u->index() << " -> "<<w->index()<<" "<<distance[u][w]<<"\n";
-#endif
-	}
-	}
-#endif
-#endif
 	return maxDist;
 }//allpairssp
 
@@ -479,61 +600,36 @@ double SpringEmbedderKK::allpairssp(const Graph& G, const EdgeArray<double>& eLe
 //the same without weights, i.e. all pairs shortest paths with BFS
 //Runs in time |V|²
 //for compatibility, distances are double
-double SpringEmbedderKK::allpairsspBFS(const Graph& G, NodeArray< NodeArray<double> >& distance)
+template<typename T>
+double SpringEmbedderKK::allpairsspBFS(const Graph& G, Array<T>& distance)
 {
+	const int n = G.numberOfNodes();
+	const AdjacencyArrays adjacency(G);
+	Array<int> bfs(n);
 	double maxDist = 0;
 
-	for(node v : G.nodes)
-	{
-		distance[v][v] = 0.0;
-	}
-
 	//start in each node once
-	for(node v: G.nodes)
+	for (int v = 0; v < n; ++v)
 	{
-		//do a bfs
-		NodeArray<bool> mark(G, true);
-		SListPure<node> bfs;
-		bfs.pushBack(v);
-		mark[v] = false;
-
-		while (!bfs.empty())
+		T *row = &distance[v * n];
+		row[v] = 0;
+		bfs[0] = v;
+		for (int head = 0, tail = 1; head < tail; ++head)
 		{
-			node w = bfs.popFrontRet();
-			double d = distance[v][w]+1.0f;
-
-
-			for(adjEntry adj : w->adjEntries) {
-				node u = adj->twinNode();
-				if (mark[u])
+			const int w = bfs[head];
+			const T d = row[w] + 1;
+			for (int j = adjacency.start[w]; j < adjacency.start[w+1]; ++j)
+			{
+				const int u = adjacency.target[j];
+				if (row[u] == numeric_limits<T>::max())
 				{
-					mark[u] = false;
-					bfs.pushBack(u);
-					distance[v][u] = d;
-					maxDist = max(maxDist,d);
+					row[u] = d;
+					bfs[tail++] = u;
+					maxDist = max(maxDist, double(d));
 				}
 			}
-		}//while
-	}//while
-	//check for negative cycles
-	for(node v : G.nodes)
-	{
-		if (distance[v][v] < 0.0)
-			cerr << "\n###Error in shortest path computation###\n\n";
-	}
-
-#if 0
-#ifdef OGDF_DEBUG
-	cout << "Maxdist: "<<maxDist<<"\n";
-	for(node u : G.nodes)
-	{
-	for(node w : G.nodes)
-	{
-		cout << "Distance " << u->index() << " -> "<<w->index()<<" "<<distance[u][w]<<"\n";
-	}
+		}
 	}
-#endif
-#endif
 	return maxDist;
 }//allpairsspBFS
 
@@ -612,4 +708,23 @@ void SpringEmbedderKK::scale(GraphAttributes& GA)
 	}
 }//Scale
 
+LayoutCostEstimate SpringEmbedderKK::estimateCost(const GraphAttributes &GA) const
+{
+	const Graph &G = GA.constGraph();
+	const double n = G.numberOfNodes();
+	const double m = G.numberOfEdges();
+
+	// distance and spring strength are stored for every node pair
+	LayoutCostEstimate cost;
+	const double entrySize = m_singlePrecisionMatrices ? sizeof(float) : sizeof(double);
+	cost.peakMemory = LayoutCostEstimate::attributesMemory(GA) + 2 * n * n * entrySize;
+
+	// all pairs BFS, then every global iteration selects the node with the
+	// largest energy and updates the partial derivatives of all nodes
+	const double globalIt = m_computeMaxIt ? m_gItBaseVal + m_gItFactor * n : m_maxGlobalIt;
+	cost.operations = n * (n + m) + globalIt * 2 * n;
+	cost.timeClass = LayoutCostEstimate::TimeClass::Quadratic;
+	return cost;
+}
+
 }//namespace
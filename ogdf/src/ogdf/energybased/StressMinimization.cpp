@@ -31,6 +31,17 @@
  */
 
 #include <ogdf/energybased/StressMinimization.h>
+#include <ogdf/basic/ParallelFor.h>
+#include <ogdf/basic/SIMDKernel.h>
+#include <queue>
+#include <random>
+
+#ifdef OGDF_SIMD_X86
+#include <immintrin.h>
+#endif
+#ifdef OGDF_SIMD_WASM
+#include <wasm_simd128.h>
+#endif
 
 
 namespace ogdf {
@@ -39,6 +50,437 @@ const double StressMinimization::EPSILON = 10e-4;
 
 const int StressMinimization::DEFAULT_NUMBER_OF_PIVOTS = 50;
 
+namespace {
+
+//! Minimal number of matrix rows per thread.
+constexpr int MIN_ROWS_PER_THREAD = 64;
+
+//! Number of independent partial sums in the reference implementation, allowing for vectorization.
+constexpr int LANES = 4;
+
+//! Sums of the majorization step for a single node.
+struct RowSums {
+	double x = 0, y = 0, z = 0, weight = 0, stress = 0;
+
+	RowSums &operator+=(const RowSums &other) {
+		x += other.x;
+		y += other.y;
+		z += other.z;
+		weight += other.weight;
+		stress += other.stress;
+		return *this;
+	}
+};
+
+//! Adds the vote of node \p j for the position of node \p i to \p sums.
+template<bool ThreeD>
+inline void addVote(int i, int j,
+	const double *dist, const double *weight,
+	const double *x, const double *y, const double *z,
+	RowSums &sums)
+{
+	const double xDiff = x[i] - x[j];
+	const double yDiff = y[i] - y[j];
+	const double zDiff = ThreeD ? z[i] - z[j] : 0.0;
+	const double euclideanDist = std::sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
+	const double w = weight[j];
+	const double d = dist[j];
+	// nodes at the same position do not vote for a direction
+	const double factor = euclideanDist != 0 ? d / euclideanDist : 0.0;
+	const double deviation = euclideanDist != 0 ? d - euclideanDist : 0.0;
+	sums.x += w * (x[j] + factor * xDiff);
+	sums.y += w * (y[j] + factor * yDiff);
+	if (ThreeD) {
+		sums.z += w * (z[j] + factor * zDiff);
+	}
+	sums.weight += w;
+	sums.stress += w * deviation * deviation;
+}
+
+//! Signature of the kernels adding the votes of the nodes in [begin, end) for the position of node i.
+using AddVotes = void(int i, int begin, int end,
+	const double *dist, const double *weight,
+	const double *x, const double *y, const double *z,
+	RowSums &sums);
+
+//! Portable implementation of #AddVotes, independent partial sums allow for auto-vectorization.
+template<bool ThreeD>
+void addVotesScalar(int i, int begin, int end,
+	const double *dist, const double *weight,
+	const double *x, const double *y, const double *z,
+	RowSums &sums)
+{
+	RowSums lanes[LANES];
+	int j = begin;
+	for (; j + LANES <= end; j += LANES) {
+		for (int l = 0; l < LANES; ++l) {
+			addVote<ThreeD>(i, j + l, dist, weight, x, y, z, lanes[l]);
+		}
+	}
+	for (; j < end; ++j) {
+		addVote<ThreeD>(i, j, dist, weight, x, y, z, lanes[0]);
+	}
+	lanes[0] += lanes[1];
+	lanes[2] += lanes[3];
+	lanes[0] += lanes[2];
+	sums += lanes[0];
+}
+
+#ifdef OGDF_SIMD_X86
+//! SSE2 implementation of #AddVotes, computing the same on lanes 0-1 and 2-3, respectively.
+template<bool ThreeD>
+OGDF_SIMD_TARGET("sse2")
+void addVotesSSE2(int i, int begin, int end,
+	const double *dist, const double *weight,
+	const double *x, const double *y, const double *z,
+	RowSums &sums)
+{
+	const __m128d zero = _mm_setzero_pd();
+	const __m128d vxi = _mm_set1_pd(x[i]), vyi = _mm_set1_pd(y[i]), vzi = _mm_set1_pd(ThreeD ? z[i] : 0.0);
+	__m128d vsx[2] = {zero, zero}, vsy[2] = {zero, zero}, vsz[2] = {zero, zero};
+	__m128d vsw[2] = {zero, zero}, vss[2] = {zero, zero};
+	int j = begin;
+	for (; j + 4 <= end; j += 4) {
+		for (int h = 0; h < 2; ++h) {
+			const int k = j + 2 * h;
+			const __m128d xj = _mm_loadu_pd(x + k);
+			const __m128d yj = _mm_loadu_pd(y + k);
+			const __m128d xDiff = _mm_sub_pd(vxi, xj);
+			const __m128d yDiff = _mm_sub_pd(vyi, yj);
+			__m128d square = _mm_add_pd(_mm_mul_pd(xDiff, xDiff), _mm_mul_pd(yDiff, yDiff));
+			__m128d zj = zero, zDiff = zero;
+			if (ThreeD) {
+				zj = _mm_loadu_pd(z + k);
+				zDiff = _mm_sub_pd(vzi, zj);
+				square = _mm_add_pd(square, _mm_mul_pd(zDiff, zDiff));
+			}
+			const __m128d euclideanDist = _mm_sqrt_pd(square);
+			const __m128d w = _mm_loadu_pd(weight + k);
+			const __m128d d = _mm_loadu_pd(dist + k);
+			const __m128d nonZero = _mm_cmpneq_pd(euclideanDist, zero);
+			const __m128d factor = _mm_and_pd(nonZero, _mm_div_pd(d, euclideanDist));
+			const __m128d deviation = _mm_and_pd(nonZero, _mm_sub_pd(d, euclideanDist));
+			vsx[h] = _mm_add_pd(vsx[h], _mm_mul_pd(w, _mm_add_pd(xj, _mm_mul_pd(factor, xDiff))));
+			vsy[h] = _mm_add_pd(vsy[h], _mm_mul_pd(w, _mm_add_pd(yj, _mm_mul_pd(factor, yDiff))));
+			if (ThreeD) {
+				vsz[h] = _mm_add_pd(vsz[h], _mm_mul_pd(w, _mm_add_pd(zj, _mm_mul_pd(factor, zDiff))));
+			}
+			vsw[h] = _mm_add_pd(vsw[h], w);
+			vss[h] = _mm_add_pd(vss[h], _mm_mul_pd(_mm_mul_pd(w, deviation), deviation));
+		}
+	}
+	for (; j < end; ++j) {
+		addVote<ThreeD>(i, j, dist, weight, x, y, z, sums);
+	}
+
+	double a[5][4];
+	for (int h = 0; h < 2; ++h) {
+		_mm_storeu_pd(a[0] + 2 * h, vsx[h]);
+		_mm_storeu_pd(a[1] + 2 * h, vsy[h]);
+		_mm_storeu_pd(a[2] + 2 * h, vsz[h]);
+		_mm_storeu_pd(a[3] + 2 * h, vsw[h]);
+		_mm_storeu_pd(a[4] + 2 * h, vss[h]);
+	}
+	sums.x += (a[0][0] + a[0][1]) + (a[0][2] + a[0][3]);
+	sums.y += (a[1][0] + a[1][1]) + (a[1][2] + a[1][3]);
+	sums.z += (a[2][0] + a[2][1]) + (a[2][2] + a[2][3]);
+	sums.weight += (a[3][0] + a[3][1]) + (a[3][2] + a[3][3]);
+	sums.stress += (a[4][0] + a[4][1]) + (a[4][2] + a[4][3]);
+}
+
+//! AVX2 implementation of #AddVotes using fused multiply-add.
+template<bool ThreeD>
+OGDF_SIMD_TARGET("avx2,fma")
+void addVotesAVX2(int i, int begin, int end,
+	const double *dist, const double *weight,
+	const double *x, const double *y, const double *z,
+	RowSums &sums)
+{
+	const __m256d zero = _mm256_setzero_pd();
+	const __m256d vxi = _mm256_set1_pd(x[i]), vyi = _mm256_set1_pd(y[i]), vzi = _mm256_set1_pd(ThreeD ? z[i] : 0.0);
+	__m256d vsx = zero, vsy = zero, vsz = zero, vsw = zero, vss = zero;
+	int j = begin;
+	for (; j + 4 <= end; j += 4) {
+		const __m256d xj = _mm256_loadu_pd(x + j);
+		const __m256d yj = _mm256_loadu_pd(y + j);
+		const __m256d xDiff = _mm256_sub_pd(vxi, xj);
+		const __m256d yDiff = _mm256_sub_pd(vyi, yj);
+		__m256d square = _mm256_fmadd_pd(yDiff, yDiff, _mm256_mul_pd(xDiff, xDiff));
+		__m256d zj = zero, zDiff = zero;
+		if (ThreeD) {
+			zj = _mm256_loadu_pd(z + j);
+			zDiff = _mm256_sub_pd(vzi, zj);
+			square = _mm256_fmadd_pd(zDiff, zDiff, square);
+		}
+		const __m256d euclideanDist = _mm256_sqrt_pd(square);
+		const __m256d w = _mm256_loadu_pd(weight + j);
+		const __m256d d = _mm256_loadu_pd(dist + j);
+		const __m256d nonZero = _mm256_cmp_pd(euclideanDist, zero, _CMP_NEQ_OQ);
+		const __m256d factor = _mm256_and_pd(nonZero, _mm256_div_pd(d, euclideanDist));
+		const __m256d deviation = _mm256_and_pd(nonZero, _mm256_sub_pd(d, euclideanDist));
+		vsx = _mm256_fmadd_pd(w, _mm256_fmadd_pd(factor, xDiff, xj), vsx);
+		vsy = _mm256_fmadd_pd(w, _mm256_fmadd_pd(factor, yDiff, yj), vsy);
+		if (ThreeD) {
+			vsz = _mm256_fmadd_pd(w, _mm256_fmadd_pd(factor, zDiff, zj), vsz);
+		}
+		vsw = _mm256_add_pd(vsw, w);
+		vss = _mm256_fmadd_pd(_mm256_mul_pd(w, deviation), deviation, vss);
+	}
+	for (; j < end; ++j) {
+		addVote<ThreeD>(i, j, dist, weight, x, y, z, sums);
+	}
+
+	// lambdas would not inherit the target, so the lanes are summed explicitly
+	double a[5][4];
+	_mm256_storeu_pd(a[0], vsx);
+	_mm256_storeu_pd(a[1], vsy);
+	_mm256_storeu_pd(a[2], vsz);
+	_mm256_storeu_pd(a[3], vsw);
+	_mm256_storeu_pd(a[4], vss);
+	sums.x += (a[0][0] + a[0][1]) + (a[0][2] + a[0][3]);
+	sums.y += (a[1][0] + a[1][1]) + (a[1][2] + a[1][3]);
+	sums.z += (a[2][0] + a[2][1]) + (a[2][2] + a[2][3]);
+	sums.weight += (a[3][0] + a[3][1]) + (a[3][2] + a[3][3]);
+	sums.stress += (a[4][0] + a[4][1]) + (a[4][2] + a[4][3]);
+}
+
+//! AVX-512 implementation of #AddVotes.
+template<bool ThreeD>
+OGDF_SIMD_TARGET("avx512f")
+void addVotesAVX512(int i, int begin, int end,
+	const double *dist, const double *weight,
+	const double *x, const double *y, const double *z,
+	RowSums &sums)
+{
+	const __m512d zero = _mm512_setzero_pd();
+	const __m512d vxi = _mm512_set1_pd(x[i]), vyi = _mm512_set1_pd(y[i]), vzi = _mm512_set1_pd(ThreeD ? z[i] : 0.0);
+	__m512d vsx = zero, vsy = zero, vsz = zero, vsw = zero, vss = zero;
+	int j = begin;
+	for (; j + 8 <= end; j += 8) {
+		const __m512d xj = _mm512_loadu_pd(x + j);
+		const __m512d yj = _mm512_loadu_pd(y + j);
+		const __m512d xDiff = _mm512_sub_pd(vxi, xj);
+		const __m512d yDiff = _mm512_sub_pd(vyi, yj);
+		__m512d square = _mm512_fmadd_pd(yDiff, yDiff, _mm512_mul_pd(xDiff, xDiff));
+		__m512d zj = zero, zDiff = zero;
+		if (ThreeD) {
+			zj = _mm512_loadu_pd(z + j);
+			zDiff = _mm512_sub_pd(vzi, zj);
+			square = _mm512_fmadd_pd(zDiff, zDiff, square);
+		}
+		// the masked forms avoid _mm512_undefined_pd(), which makes GCC warn about uninitialized values
+		const __m512d euclideanDist = _mm512_maskz_sqrt_pd(0xff, square);
+		const __m512d w = _mm512_loadu_pd(weight + j);
+		const __m512d d = _mm512_loadu_pd(dist + j);
+		const __mmask8 nonZero = _mm512_cmp_pd_mask(euclideanDist, zero, _CMP_NEQ_OQ);
+		const __m512d factor = _mm512_maskz_div_pd(nonZero, d, euclideanDist);
+		const __m512d deviation = _mm512_maskz_sub_pd(nonZero, d, euclideanDist);
+		vsx = _mm512_fmadd_pd(w, _mm512_fmadd_pd(factor, xDiff, xj), vsx);
+		vsy = _mm512_fmadd_pd(w, _mm512_fmadd_pd(factor, yDiff, yj), vsy);
+		if (ThreeD) {
+			vsz = _mm512_fmadd_pd(w, _mm512_fmadd_pd(factor, zDiff, zj), vsz);
+		}
+		vsw = _mm512_add_pd(vsw, w);
+		vss = _mm512_fmadd_pd(_mm512_mul_pd(w, deviation), deviation, vss);
+	}
+	for (; j < end; ++j) {
+		addVote<ThreeD>(i, j, dist, weight, x, y, z, sums);
+	}
+
+	double a[5][8];
+	_mm512_storeu_pd(a[0], vsx);
+	_mm512_storeu_pd(a[1], vsy);
+	_mm512_storeu_pd(a[2], vsz);
+	_mm512_storeu_pd(a[3], vsw);
+	_mm512_storeu_pd(a[4], vss);
+	double *total[5] = {&sums.x, &sums.y, &sums.z, &sums.weight, &sums.stress};
+	for (int k = 0; k < 5; ++k) {
+		*total[k] += ((a[k][0] + a[k][1]) + (a[k][2] + a[k][3])) + ((a[k][4] + a[k][5]) + (a[k][6] + a[k][7]));
+	}
+}
+#endif
+
+#ifdef OGDF_SIMD_WASM
+//! WebAssembly SIMD implementation of #AddVotes.
+template<bool ThreeD>
+void addVotesWasm(int i, int begin, int end,
+	const double *dist, const double *weight,
+	const double *x, const double *y, const double *z,
+	RowSums &sums)
+{
+	const v128_t zero = wasm_f64x2_splat(0.0);
+	const v128_t vxi = wasm_f64x2_splat(x[i]), vyi = wasm_f64x2_splat(y[i]), vzi = wasm_f64x2_splat(ThreeD ? z[i] : 0.0);
+	v128_t vsx = zero, vsy = zero, vsz = zero, vsw = zero, vss = zero;
+	int j = begin;
+	for (; j + 2 <= end; j += 2) {
+		const v128_t xj = wasm_v128_load(x + j);
+		const v128_t yj = wasm_v128_load(y + j);
+		const v128_t xDiff = wasm_f64x2_sub(vxi, xj);
+		const v128_t yDiff = wasm_f64x2_sub(vyi, yj);
+		v128_t square = wasm_f64x2_add(wasm_f64x2_mul(xDiff, xDiff), wasm_f64x2_mul(yDiff, yDiff));
+		v128_t zj = zero, zDiff = zero;
+		if (ThreeD) {
+			zj = wasm_v128_load(z + j);
+			zDiff = wasm_f64x2_sub(vzi, zj);
+			square = wasm_f64x2_add(square, wasm_f64x2_mul(zDiff, zDiff));
+		}
+		const v128_t euclideanDist = wasm_f64x2_sqrt(square);
+		const v128_t w = wasm_v128_load(weight + j);
+		const v128_t d = wasm_v128_load(dist + j);
+		const v128_t nonZero = wasm_f64x2_ne(euclideanDist, zero);
+		const v128_t factor = wasm_v128_and(nonZero, wasm_f64x2_div(d, euclideanDist));
+		const v128_t deviation = wasm_v128_and(nonZero, wasm_f64x2_sub(d, euclideanDist));
+		vsx = wasm_f64x2_add(vsx, wasm_f64x2_mul(w, wasm_f64x2_add(xj, wasm_f64x2_mul(factor, xDiff))));
+		vsy = wasm_f64x2_add(vsy, wasm_f64x2_mul(w, wasm_f64x2_add(yj, wasm_f64x2_mul(factor, yDiff))));
+		if (ThreeD) {
+			vsz = wasm_f64x2_add(vsz, wasm_f64x2_mul(w, wasm_f64x2_add(zj, wasm_f64x2_mul(factor, zDiff))));
+		}
+		vsw = wasm_f64x2_add(vsw, w);
+		vss = wasm_f64x2_add(vss, wasm_f64x2_mul(wasm_f64x2_mul(w, deviation), deviation));
+	}
+	for (; j < end; ++j) {
+		addVote<ThreeD>(i, j, dist, weight, x, y, z, sums);
+	}
+
+	auto sum = [](v128_t v) {
+		return wasm_f64x2_extract_lane(v, 0) + wasm_f64x2_extract_lane(v, 1);
+	};
+	sums.x += sum(vsx);
+	sums.y += sum(vsy);
+	sums.z += sum(vsz);
+	sums.weight += sum(vsw);
+	sums.stress += sum(vss);
+}
+#endif
+
+//! Random rows of the distance and weight matrices for the self-test and the benchmark of the kernels.
+struct VoteInput {
+	Array<double> dist, weight, x, y, z;
+
+	explicit VoteInput(int n) : dist(n), weight(n), x(n), y(n), z(n) {
+		std::minstd_rand rng(n);
+		std::uniform_real_distribution<double> position(-100, 100), distance(1, 50);
+		for (int j = 0; j < n; ++j) {
+			x[j] = position(rng);
+			y[j] = position(rng);
+			z[j] = position(rng);
+			dist[j] = distance(rng);
+			weight[j] = 1 / (dist[j] * dist[j]);
+		}
+		// nodes at the same position
+		x[n - 1] = x[0];
+		y[n - 1] = y[0];
+		z[n - 1] = z[0];
+	}
+
+	int size() const { return x.size(); }
+
+	RowSums votes(AddVotes *kernel, int i) const {
+		RowSums sums;
+		kernel(i, 0, i, &dist[0], &weight[0], &x[0], &y[0], &z[0], sums);
+		kernel(i, i + 1, size(), &dist[0], &weight[0], &x[0], &y[0], &z[0], sums);
+		return sums;
+	}
+};
+
+bool equalSums(const RowSums &a, const RowSums &b) {
+	auto equal = [](double u, double v) {
+		return std::fabs(u - v) <= 1e-9 * std::max(std::fabs(u), std::fabs(v)) + 1e-12;
+	};
+	return equal(a.x, b.x) && equal(a.y, b.y) && equal(a.z, b.z)
+	    && equal(a.weight, b.weight) && equal(a.stress, b.stress);
+}
+
+//! Returns the implementations of #AddVotes, from the least to the most advanced instruction set.
+template<bool ThreeD>
+std::vector<SIMDKernel<AddVotes>::Variant> addVotesVariants()
+{
+	std::vector<SIMDKernel<AddVotes>::Variant> variants = {{"scalar", 0, &addVotesScalar<ThreeD>}};
+#ifdef OGDF_SIMD_X86
+	variants.push_back({"sse2", static_cast<unsigned int>(CPUFeatureMask::SSE2), &addVotesSSE2<ThreeD>});
+	variants.push_back({"avx2", static_cast<unsigned int>(CPUFeatureMask::AVX2) | static_cast<unsigned int>(CPUFeatureMask::FMA), &addVotesAVX2<ThreeD>});
+	variants.push_back({"avx512", static_cast<unsigned int>(CPUFeatureMask::AVX512F), &addVotesAVX512<ThreeD>});
+#endif
+#ifdef OGDF_SIMD_WASM
+	variants.push_back({"wasm-simd128", static_cast<unsigned int>(CPUFeatureMask::WASM_SIMD128), &addVotesWasm<ThreeD>});
+#endif
+	return variants;
+}
+
+bool checkAddVotes(AddVotes *variant, AddVotes *reference)
+{
+	// small and odd sizes exercise the remainder loops
+	for (int n : {1, 2, 7, 1001}) {
+		VoteInput input(n);
+		for (int i : {0, n / 2, n - 1}) {
+			if (!equalSums(input.votes(variant, i), input.votes(reference, i))) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void addVotesWorkload(AddVotes *variant)
+{
+	static const VoteInput input(4096);
+	volatile double sink = 0;
+	for (int i = 0; i < 256; ++i) {
+		sink = sink + input.votes(variant, i).x;
+	}
+}
+
+SIMDKernel<AddVotes> addVotes2D("StressMinimization 2D votes", addVotesVariants<false>(), checkAddVotes, addVotesWorkload);
+SIMDKernel<AddVotes> addVotes3D("StressMinimization 3D votes", addVotesVariants<true>(), checkAddVotes, addVotesWorkload);
+
+//! Computes the shortest path distances from \p source with uniform \p edgeCosts by BFS.
+void bfsDistances(const Array<int> &adjStart, const Array<int> &adjTarget,
+	int source, double edgeCosts, double *dist, Array<int> &queue)
+{
+	dist[source] = 0;
+	queue[0] = source;
+	for (int head = 0, tail = 1; head < tail; ++head) {
+		const int v = queue[head];
+		const double d = dist[v] + edgeCosts;
+		for (int j = adjStart[v]; j < adjStart[v+1]; ++j) {
+			const int w = adjTarget[j];
+			if (isinf(dist[w])) {
+				dist[w] = d;
+				queue[tail++] = w;
+			}
+		}
+	}
+}
+
+//! Computes the shortest path distances from \p source by Dijkstra's algorithm.
+void dijkstraDistances(const Array<int> &adjStart, const Array<int> &adjTarget,
+	const Array<double> &adjCost, int source, double *dist)
+{
+	using Entry = std::pair<double, int>;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+	dist[source] = 0;
+	queue.emplace(0, source);
+	while (!queue.empty()) {
+		Entry entry = queue.top();
+		queue.pop();
+		const int v = entry.second;
+		if (entry.first > dist[v]) {
+			continue; // outdated entry
+		}
+		for (int j = adjStart[v]; j < adjStart[v+1]; ++j) {
+			const int w = adjTarget[j];
+			const double d = entry.first + adjCost[j];
+			if (d < dist[w]) {
+				dist[w] = d;
+				queue.emplace(d, w);
+			}
+		}
+	}
+}
+
+}
+
 
 void StressMinimization::call(GraphAttributes& GA)
 {
@@ -57,30 +499,78 @@ void StressMinimization::call(GraphAttributes& GA)
 		OGDF_THROW(PreconditionViolatedException);
 		return;
 	}
-	NodeArray<NodeArray<double> > shortestPathMatrix(G);
-	NodeArray<NodeArray<double> > weightMatrix(G);
-	initMatrices(G, shortestPathMatrix, weightMatrix);
 	// if the edge costs are defined by the attribute copy it to an array and
 	// construct the proper shortest path matrix
+	if (m_hasEdgeCostsAttribute && !GA.has(GraphAttributes::edgeDoubleWeight)) {
+		OGDF_THROW(PreconditionViolatedException);
+		return;
+	}
+	Array<double> shortestPathMatrix;
+	computeShortestPaths(GA, shortestPathMatrix);
+	call(GA, shortestPathMatrix);
+}
+
+
+void StressMinimization::computeShortestPaths(
+	const GraphAttributes& GA,
+	Array<double>& shortestPathMatrix)
+{
+	const Graph& G = GA.constGraph();
+	const int n = G.numberOfNodes();
+
+	// adjacency lists in compressed sparse row format
+	NodeArray<int> index(G);
+	int i = 0;
+	for (node v : G.nodes) {
+		index[v] = i++;
+	}
+	Array<int> adjStart(0, n, 0);
+	Array<int> adjTarget(2 * G.numberOfEdges());
+	Array<double> adjCost;
+	if (m_hasEdgeCostsAttribute) {
+		adjCost.init(2 * G.numberOfEdges());
+	}
+	i = 0;
+	for (node v : G.nodes) {
+		adjStart[index[v]] = i;
+		for (adjEntry adj : v->adjEntries) {
+			if (m_hasEdgeCostsAttribute) {
+				adjCost[i] = GA.doubleWeight(adj->theEdge());
+			}
+			adjTarget[i++] = index[adj->twinNode()];
+		}
+	}
+	adjStart[n] = i;
+
 	if (m_hasEdgeCostsAttribute) {
-		if (!GA.has(GraphAttributes::edgeDoubleWeight)) {
-			OGDF_THROW(PreconditionViolatedException);
-			return;
+		double avgCosts = 0;
+		for (edge e : G.edges) {
+			avgCosts += GA.doubleWeight(e);
 		}
-		m_avgEdgeCosts = dijkstra_SPAP(GA, shortestPathMatrix);
-		// compute shortest path all pairs
+		m_avgEdgeCosts = avgCosts / G.numberOfEdges();
 	} else {
 		m_avgEdgeCosts = m_edgeCosts;
-		bfs_SPAP(G, shortestPathMatrix, m_edgeCosts);
 	}
-	call(GA, shortestPathMatrix, weightMatrix);
+
+	// init shortest path matrix by infinity distances
+	shortestPathMatrix.init(0, n * n - 1, std::numeric_limits<double>::infinity());
+	parallelFor(numberOfThreadsFor(m_maxThreads, n, MIN_ROWS_PER_THREAD), n, [&](int begin, int end, unsigned int) {
+		Array<int> queue(n);
+		for (int source = begin; source < end; ++source) {
+			double *dist = &shortestPathMatrix[source * n];
+			if (m_hasEdgeCostsAttribute) {
+				dijkstraDistances(adjStart, adjTarget, adjCost, source, dist);
+			} else {
+				bfsDistances(adjStart, adjTarget, source, m_edgeCosts, dist, queue);
+			}
+		}
+	});
 }
 
 
 void StressMinimization::call(
 	GraphAttributes& GA,
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	NodeArray<NodeArray<double> >& weightMatrix)
+	Array<double>& shortestPathMatrix)
 {
 	// compute the initial layout if necessary
 	if (!m_hasInitialLayout) {
@@ -95,7 +585,8 @@ void StressMinimization::call(
 				m_avgEdgeCosts * sqrt((double)(G.numberOfNodes())));
 	}
 	// calculate the weights
-	calcWeights(G, shortestPathMatrix, weightMatrix);
+	Array<double> weightMatrix;
+	calcWeights(shortestPathMatrix, weightMatrix);
 	// minimize the stress
 	minimizeStress(GA, shortestPathMatrix, weightMatrix);
 }
@@ -107,6 +598,7 @@ void StressMinimization::computeInitialLayout(GraphAttributes& GA)
 	pivMDS->setNumberOfPivots(DEFAULT_NUMBER_OF_PIVOTS);
 	pivMDS->useEdgeCostsAttribute(m_hasEdgeCostsAttribute);
 	pivMDS->setEdgeCosts(m_edgeCosts);
+	pivMDS->maxThreads(m_maxThreads);
 	if (!m_componentLayout) {
 		// the graph might be disconnected therefore we need
 		// the component layouter
@@ -122,57 +614,49 @@ void StressMinimization::computeInitialLayout(GraphAttributes& GA)
 
 
 void StressMinimization::replaceInfinityDistances(
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
+	Array<double>& shortestPathMatrix,
 	double newVal)
 {
-	const Graph &G = *shortestPathMatrix.graphOf();
-
-	for(node v : G.nodes) {
-		for(node w : G.nodes) {
-			if (v != w && isinf(shortestPathMatrix[v][w])) {
-				shortestPathMatrix[v][w] = newVal;
-			}
+	for (double &dist : shortestPathMatrix) {
+		if (isinf(dist)) {
+			dist = newVal;
 		}
 	}
 }
 
 
 void StressMinimization::calcWeights(
-	const Graph& G,
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	NodeArray<NodeArray<double> >& weightMatrix)
+	const Array<double>& shortestPathMatrix,
+	Array<double>& weightMatrix)
 {
-	for (node v : G.nodes) {
-		for (node w : G.nodes) {
-			if (v != w) {
-				// w_ij = d_ij^-2
-				weightMatrix[v][w] = 1
-					/ (shortestPathMatrix[v][w] * shortestPathMatrix[v][w]);
-			}
+	const int size = shortestPathMatrix.size();
+	weightMatrix.init(size);
+	parallelFor(numberOfThreadsFor(m_maxThreads, size, MIN_ROWS_PER_THREAD * 1024), size, [&](int begin, int end, unsigned int) {
+		for (int i = begin; i < end; i++) {
+			const double dist = shortestPathMatrix[i];
+			// w_ij = d_ij^-2, and no weight on the diagonal
+			weightMatrix[i] = (dist != 0) ? 1 / (dist * dist) : 0;
 		}
-	}
+	});
 }
 
 
 double StressMinimization::calcStress(
-	const GraphAttributes& GA,
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	NodeArray<NodeArray<double> >& weightMatrix)
+	const Coordinates& coords,
+	const Array<double>& shortestPathMatrix,
+	const Array<double>& weightMatrix)
 {
+	const int n = coords.x.size();
 	double stress = 0;
-	for (node v = GA.constGraph().firstNode(); v != nullptr; v = v->succ()) {
-		for (node w = v->succ(); w != nullptr; w = w->succ()) {
-			double xDiff = GA.x(v) - GA.x(w);
-			double yDiff = GA.y(v) - GA.y(w);
-			double zDiff = 0.0;
-			if (GA.has(GraphAttributes::threeD))
-			{
-				zDiff = GA.z(v) - GA.z(w);
-			}
+	for (int v = 0; v < n; v++) {
+		for (int w = v + 1; w < n; w++) {
+			double xDiff = coords.x[v] - coords.x[w];
+			double yDiff = coords.y[v] - coords.y[w];
+			double zDiff = coords.z.size() > 0 ? coords.z[v] - coords.z[w] : 0.0;
 			double dist = sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
 			if (dist != 0) {
-				stress += weightMatrix[v][w] * (shortestPathMatrix[v][w] - dist)
-					* (shortestPathMatrix[v][w] - dist);//
+				const double desDistance = shortestPathMatrix[v * n + w];
+				stress += weightMatrix[v * n + w] * (desDistance - dist) * (desDistance - dist);
 			}
 		}
 	}
@@ -180,162 +664,113 @@ double StressMinimization::calcStress(
 }
 
 
-void StressMinimization::copyLayout(
-	const GraphAttributes& GA,
-	NodeArray<double>& newX,
-	NodeArray<double>& newY)
-{
-	// copy the layout
-	for(node v : GA.constGraph().nodes)
-	{
-		newX[v] = GA.x(v);
-		newY[v] = GA.y(v);
-	}
-}
-
-
-void StressMinimization::copyLayout(
-	const GraphAttributes& GA,
-	NodeArray<double>& newX,
-	NodeArray<double>& newY,
-	NodeArray<double>& newZ)
-{
-	// copy the layout
-	for(node v : GA.constGraph().nodes)
-	{
-		newX[v] = GA.x(v);
-		newY[v] = GA.y(v);
-		newZ[v] = GA.z(v);
-	}
-}
-
-
 void StressMinimization::minimizeStress(
 	GraphAttributes& GA,
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	NodeArray<NodeArray<double> >& weightMatrix)
+	const Array<double>& shortestPathMatrix,
+	const Array<double>& weightMatrix)
 {
 	const Graph& G = GA.constGraph();
+	const int n = G.numberOfNodes();
+	const bool threeD = GA.has(GraphAttributes::threeD);
 	int numberOfPerformedIterations = 0;
 
 	double prevStress = numeric_limits<double>::max();
 	double curStress = numeric_limits<double>::max();
 
-	if (m_terminationCriterion == TerminationCriterion::Stress) {
-		curStress = calcStress(GA, shortestPathMatrix, weightMatrix);
+	Coordinates cur, next;
+	for (Coordinates *coords : {&cur, &next}) {
+		coords->x.init(n);
+		coords->y.init(n);
+		if (threeD) {
+			coords->z.init(n);
+		}
 	}
-
-	NodeArray<double> newX;
-	NodeArray<double> newY;
-	NodeArray<double> newZ;
-
-	if (m_terminationCriterion == TerminationCriterion::PositionDifference) {
-		newX.init(G);
-		newY.init(G);
-		if (GA.has(GraphAttributes::threeD))
-			newZ.init(G);
+	int i = 0;
+	for (node v : G.nodes) {
+		cur.x[i] = GA.x(v);
+		cur.y[i] = GA.y(v);
+		if (threeD) {
+			cur.z[i] = GA.z(v);
+		}
+		++i;
 	}
+
 	do {
-		if (m_terminationCriterion == TerminationCriterion::PositionDifference) {
-			if (GA.has(GraphAttributes::threeD))
-				copyLayout(GA, newX, newY, newZ);
-			else copyLayout(GA, newX, newY);
-		}
-		nextIteration(GA, shortestPathMatrix, weightMatrix);
+		// the stress of the previous layout is a by-product of the iteration,
+		// so the stress criterion is checked one iteration later
+		double stress = nextIteration(cur, next, shortestPathMatrix, weightMatrix, threeD);
 		if (m_terminationCriterion == TerminationCriterion::Stress) {
 			prevStress = curStress;
-			curStress = calcStress(GA, shortestPathMatrix, weightMatrix);
+			curStress = stress;
 		}
-	} while (!finished(GA, ++numberOfPerformedIterations, newX, newY, prevStress, curStress));
+		std::swap(cur, next);
+	} while (!finished(++numberOfPerformedIterations, next, cur, prevStress, curStress));
+
+	i = 0;
+	for (node v : G.nodes) {
+		GA.x(v) = cur.x[i];
+		GA.y(v) = cur.y[i];
+		if (threeD) {
+			GA.z(v) = cur.z[i];
+		}
+		++i;
+	}
 
-	Logger::slout() << "Iteration count:\t" << numberOfPerformedIterations
-		<< "\tStress:\t" << calcStress(GA, shortestPathMatrix, weightMatrix) << endl;
+	if (Logger::is_slout()) {
+		Logger::slout() << "Iteration count:\t" << numberOfPerformedIterations
+			<< "\tStress:\t" << calcStress(cur, shortestPathMatrix, weightMatrix) << endl;
+	}
 }
 
 
-void StressMinimization::nextIteration(
-	GraphAttributes& GA,
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	NodeArray<NodeArray<double> >& weights)
+double StressMinimization::nextIteration(
+	const Coordinates& cur,
+	Coordinates& next,
+	const Array<double>& shortestPathMatrix,
+	const Array<double>& weightMatrix,
+	bool threeD)
 {
-	const Graph& G = GA.constGraph();
-
-	for (node v : G.nodes)
-	{
-		double newXCoord = 0.0;
-		double newYCoord = 0.0;
-		double newZCoord = 0.0;
-		double& currXCoord = GA.x(v);
-		double& currYCoord = GA.y(v);
-		double totalWeight = 0;
-		for (node w : G.nodes)
-		{
-			if (v == w) {
-				continue;
-			}
-			// calculate euclidean distance between both points
-			double xDiff = currXCoord - GA.x(w);
-			double yDiff = currYCoord - GA.y(w);
-			double zDiff = (GA.has(GraphAttributes::threeD)) ? GA.z(v) - GA.z(w) : 0.0;
-			double euclideanDist = sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
-			// get the weight
-			double weight = weights[v][w];
-			// get the desired distance
-			double desDistance = shortestPathMatrix[v][w];
-			// reset the voted x coordinate
-			// if x is not fixed
-			if (!m_fixXCoords) {
-				double voteX = GA.x(w);
-				if (euclideanDist != 0) {
-					// calc the vote
-					voteX += desDistance * (currXCoord - voteX) / euclideanDist;
-				}
-				// add the vote
-				newXCoord += weight * voteX;
-			}
-			// reset the voted y coordinate
-			// y is not fixed
-			if (!m_fixYCoords) {
-				double voteY = GA.y(w);
-				if (euclideanDist != 0) {
-					// calc the vote
-					voteY += desDistance * (currYCoord - voteY) / euclideanDist;
-				}
-				newYCoord += weight * voteY;
-			}
-			if (GA.has(GraphAttributes::threeD) && !m_fixZCoords) {
-				// reset the voted z coordinate
-				double voteZ = GA.z(w);
-				if (euclideanDist != 0) {
-					// calc the vote
-					voteZ += desDistance * (GA.z(v) - voteZ) / euclideanDist;
-				}
-				newZCoord += weight * voteZ;
-			}
-			// sum up the weights
-			totalWeight += weight;
-		}
-		// update the positions
-		if (totalWeight != 0) {
-			if (!m_fixXCoords) {
-				currXCoord = newXCoord / totalWeight;
-			}
-			if (!m_fixYCoords) {
-				currYCoord = newYCoord / totalWeight;
-			}
-			if (GA.has(GraphAttributes::threeD) && !m_fixZCoords) {
-				GA.z(v) = newZCoord / totalWeight;
+	const int n = cur.x.size();
+	const double *x = &cur.x[0];
+	const double *y = &cur.y[0];
+	const double *z = threeD ? &cur.z[0] : nullptr;
+	Array<double> rowStress(n);
+
+	parallelFor(numberOfThreadsFor(m_maxThreads, n, MIN_ROWS_PER_THREAD), n, [&](int begin, int end, unsigned int) {
+		for (int v = begin; v < end; v++) {
+			const double *dist = &shortestPathMatrix[v * n];
+			const double *weight = &weightMatrix[v * n];
+			RowSums sums;
+			// skip the diagonal
+			const SIMDKernel<AddVotes> &addVotes = threeD ? addVotes3D : addVotes2D;
+			addVotes(v, 0, v, dist, weight, x, y, z, sums);
+			addVotes(v, v + 1, n, dist, weight, x, y, z, sums);
+			const double totalWeight = sums.weight;
+			rowStress[v] = sums.stress;
+
+			// update the positions
+			const bool update = totalWeight != 0;
+			next.x[v] = (update && !m_fixXCoords) ? sums.x / totalWeight : x[v];
+			next.y[v] = (update && !m_fixYCoords) ? sums.y / totalWeight : y[v];
+			if (threeD) {
+				next.z[v] = (update && !m_fixZCoords) ? sums.z / totalWeight : z[v];
 			}
 		}
+	});
+
+	// every pair is counted twice
+	double stress = 0;
+	for (double s : rowStress) {
+		stress += s;
 	}
+	return stress / 2;
 }
 
 
 bool StressMinimization::finished(
-	GraphAttributes& GA,
 	int numberOfPerformedIterations,
-	NodeArray<double>& prevXCoords,
-	NodeArray<double>& prevYCoords,
+	const Coordinates& prevCoords,
+	const Coordinates& curCoords,
 	const double prevStress,
 	const double curStress)
 {
@@ -351,12 +786,12 @@ bool StressMinimization::finished(
 		double dividend = 0;
 		// compute the translation of all nodes between
 		// the consecutive layouts
-		for (node v : GA.constGraph().nodes)
+		for (int v = 0; v < prevCoords.x.size(); v++)
 		{
-			double diffX = prevXCoords[v] - GA.x(v);
-			double diffY = prevYCoords[v] - GA.y(v);
+			double diffX = prevCoords.x[v] - curCoords.x[v];
+			double diffY = prevCoords.y[v] - curCoords.y[v];
 			dividend += diffX * diffX + diffY * diffY;
-			eucNorm += prevXCoords[v] * prevXCoords[v] + prevYCoords[v] * prevYCoords[v];
+			eucNorm += prevCoords.x[v] * prevCoords.x[v] + prevCoords.y[v] * prevCoords.y[v];
 		}
 		return sqrt(dividend) / sqrt(eucNorm) < EPSILON;
 	}
@@ -368,18 +803,29 @@ bool StressMinimization::finished(
 	}
 }
 
-
-void StressMinimization::initMatrices(const Graph& G,
-	NodeArray<NodeArray<double> >& shortestPathMatrix,
-	NodeArray<NodeArray<double> >& weightMatrix)
+LayoutCostEstimate StressMinimization::estimateCost(const GraphAttributes &GA) const
 {
-	// init shortest path matrix by infinity distances
-	for (node v : G.nodes)
-	{
-		shortestPathMatrix[v].init(G, std::numeric_limits<double>::infinity());
-		shortestPathMatrix[v][v] = 0;
-		weightMatrix[v].init(G, 0);
+	const LayoutCostEstimate::GraphProfile profile(GA.constGraph());
+	const double n = profile.numberOfNodes;
+	const double m = profile.numberOfEdges;
+
+	// shortest path and weight matrix cover either every component on its own
+	// or the whole graph
+	const double pairs = m_componentLayout ? double(profile.maxComponentNodes) * profile.maxComponentNodes : n * n;
+	const double allPairs = m_componentLayout ? profile.sumSquaredNodes : n * n;
+
+	LayoutCostEstimate cost;
+	cost.peakMemory = 2 * LayoutCostEstimate::attributesMemory(GA) + 2 * pairs * sizeof(double);
+
+	// one BFS (or Dijkstra if edge costs are given) per node, then one
+	// quadratic sweep per iteration
+	double apsp = n * (n + m);
+	if (m_hasEdgeCostsAttribute && n > 2) {
+		apsp *= std::log2(n);
 	}
+	cost.operations = apsp + double(m_numberOfIterations) * allPairs;
+	cost.timeClass = LayoutCostEstimate::TimeClass::Quadratic;
+	return cost;
 }
 
 }
@@ -123,6 +123,25 @@ void NodePairEnergy::compCandEnergy()
 }
 
 
+double NodePairEnergy::candidateEnergy(const node v, const DPoint &newPos) const
+{
+	int numv = (*m_nodeNums)[v];
+	double candidateEnergy = energy();
+	for (node u : m_nonIsolated) {
+		if (u != v) {
+			int j = (*m_nodeNums)[u];
+			candidateEnergy -= (*m_pairEnergy)(min(j, numv), max(j, numv));
+			candidateEnergy += computeCoordEnergy(v, u, newPos, currentPos(u));
+			if (candidateEnergy < 0.0) {
+				OGDF_ASSERT(candidateEnergy > -0.00001);
+				candidateEnergy = 0.0;
+			}
+		}
+	}
+	return candidateEnergy;
+}
+
+
 #ifdef OGDF_DEBUG
 void NodePairEnergy::printInternalData() const
 {
@@ -104,6 +104,17 @@ bool Planarity::lowLevelIntersect(
 	const DPoint &e2s,
 	const DPoint &e2t) const
 {
+	// DLine::intersection only reports points inside both bounding boxes up
+	// to the epsilon of OGDF_GEOM_ET. Such a point exists iff the point in
+	// the middle of the gap between two boxes is close enough to the first.
+	auto apart = [](double high1, double low2) {
+		return !OGDF_GEOM_ET.leq((high1 + low2)/2, high1);
+	};
+	if(apart(max(e1s.m_x,e1t.m_x), min(e2s.m_x,e2t.m_x))
+	 || apart(max(e2s.m_x,e2t.m_x), min(e1s.m_x,e1t.m_x))
+	 || apart(max(e1s.m_y,e1t.m_y), min(e2s.m_y,e2t.m_y))
+	 || apart(max(e2s.m_y,e2t.m_y), min(e1s.m_y,e1t.m_y)))
+		return false;
 	DPoint s1(e1s),t1(e1t),s2(e2s),t2(e2t);
 	DLine l1(s1,t1), l2(s2,t2);
 	DPoint dummy;
@@ -111,21 +122,18 @@ bool Planarity::lowLevelIntersect(
 }
 
 
-// computes the energy if the node returned by testNode() is moved
-// to position testPos().
-void Planarity::compCandEnergy()
+// calls visit(edgeNum1, edgeNum2, cross) with edgeNum1 < edgeNum2 for every
+// pair of edges whose crossing changes if v is moved to newPos
+template<typename Visit>
+void Planarity::forChangedCrossings(const node v, const DPoint &newPos, Visit visit) const
 {
-	node v = testNode();
-	m_candidateEnergy = energy();
-	m_crossingChanges.clear();
-
 	for(adjEntry adj : v->adjEntries) {
 		edge e = adj->theEdge();
 		if (!e->isSelfLoop()) {
 			// first we compute the two endpoints of e if v is on its new position
 			node s = e->source();
 			node t = e->target();
-			DPoint p1 = testPos();
+			const DPoint &p1 = newPos;
 			DPoint p2 = (s == v) ? currentPos(t) : currentPos(s);
 			int e_num = (*m_edgeNums)[e];
 			// now we compute the crossings of all other edges with e
@@ -137,15 +145,8 @@ void Planarity::compCandEnergy()
 						bool cross = lowLevelIntersect(p1, p2, currentPos(s2), currentPos(t2));
 						int f_num = (*m_edgeNums)[f];
 						bool priorIntersect = (*m_crossingMatrix)(min(e_num, f_num), max(e_num, f_num));
-						if (priorIntersect != cross) {
-							if (priorIntersect) m_candidateEnergy--; // this intersection was saved
-							else m_candidateEnergy++; // produced a new intersection
-							ChangedCrossing cc;
-							cc.edgeNum1 = min(e_num, f_num);
-							cc.edgeNum2 = max(e_num, f_num);
-							cc.cross = cross;
-							m_crossingChanges.pushBack(cc);
-						}
+						if (priorIntersect != cross)
+							visit(min(e_num, f_num), max(e_num, f_num), cross);
 					}
 				}
 			}
@@ -154,6 +155,35 @@ void Planarity::compCandEnergy()
 }
 
 
+// computes the energy if the node returned by testNode() is moved
+// to position testPos().
+void Planarity::compCandEnergy()
+{
+	m_candidateEnergy = energy();
+	m_crossingChanges.clear();
+
+	forChangedCrossings(testNode(), testPos(), [&](int edgeNum1, int edgeNum2, bool cross) {
+		if (cross) m_candidateEnergy++; // produced a new intersection
+		else m_candidateEnergy--; // this intersection was saved
+		ChangedCrossing cc;
+		cc.edgeNum1 = edgeNum1;
+		cc.edgeNum2 = edgeNum2;
+		cc.cross = cross;
+		m_crossingChanges.pushBack(cc);
+	});
+}
+
+
+double Planarity::candidateEnergy(const node v, const DPoint &newPos) const
+{
+	double candidateEnergy = energy();
+	forChangedCrossings(v, newPos, [&](int, int, bool cross) {
+		candidateEnergy += cross ? 1 : -1;
+	});
+	return candidateEnergy;
+}
+
+
 // this functions sets the crossingMatrix according to candidateCrossings
 void Planarity::internalCandidateTaken() {
 	for(const ChangedCrossing &cc : m_crossingChanges) {
@@ -63,25 +63,44 @@ void PlanarityGrid::computeEnergy()
 
 
 // computes the energy if the node returned by testNode() is moved
-// to position testPos().
+// to position testPos(). A new grid is only built if the cell size does
+// not fit the candidate layout anymore, otherwise the crossings are
+// counted locally in the current grid.
 void PlanarityGrid::compCandEnergy()
 {
 	delete m_candidateGrid;
+	m_candidateGrid = nullptr;
 	node v = testNode();
 	const DPoint& newPos = testPos();
-	if(m_currentGrid->newGridNecessary(v,newPos))
+	if(m_currentGrid->newGridNecessary(v,newPos)) {
 		m_candidateGrid = new UniformGrid(m_layout,v,newPos);
+		m_candidateEnergy = m_candidateGrid->numberOfCrossings();
+	}
 	else
-		m_candidateGrid = new UniformGrid(*m_currentGrid,v,newPos);
-	m_candidateEnergy = m_candidateGrid->numberOfCrossings();
+		m_candidateEnergy = m_currentGrid->crossingsAfterMove(v,newPos);
 }
 
 
-// this functions sets the currentGrid to the candidateGrid
+double PlanarityGrid::candidateEnergy(const node v, const DPoint &newPos) const
+{
+	if(m_currentGrid->newGridNecessary(v,newPos))
+		return UniformGrid(m_layout,v,newPos).numberOfCrossings();
+	return m_currentGrid->crossingsAfterMove(v,newPos);
+}
+
+
+// this function sets the currentGrid to the candidateGrid or updates
+// the current grid in place
 void PlanarityGrid::internalCandidateTaken() {
-	delete m_currentGrid;
-	m_currentGrid = m_candidateGrid;
-	m_candidateGrid = nullptr;
+	if(m_candidateGrid == nullptr) {
+		node v = testNode();
+		m_currentGrid->moveNode(v,currentPos(v));
+	}
+	else {
+		delete m_currentGrid;
+		m_currentGrid = m_candidateGrid;
+		m_candidateGrid = nullptr;
+	}
 }
 
 
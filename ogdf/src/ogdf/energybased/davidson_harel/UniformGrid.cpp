@@ -250,7 +250,7 @@ UniformGrid::UniformGrid(const GraphAttributes &AG) :
 	DIntersectableRect ir;
 	computeGridGeometry(v,pos,ir);
 	double maxLength = max(ir.height(),ir.width());
-	m_CellSize = maxLength/(m_edgeMultiplier*(m_graph).numberOfEdges());
+	m_CellSize = preferredCellSize(maxLength);
 	List<edge> L;
 	m_graph.allEdges(L);
 	computeCrossings(L,v,pos);
@@ -281,7 +281,7 @@ UniformGrid::UniformGrid(
 	DIntersectableRect ir;
 	computeGridGeometry(v,newPos,ir);
 	double maxLength = max(ir.height(),ir.width());
-	m_CellSize = maxLength/(m_edgeMultiplier*(m_graph).numberOfEdges());
+	m_CellSize = preferredCellSize(maxLength);
 	List<edge> L;
 	m_graph.allEdges(L);
 	computeCrossings(L,v,newPos);
@@ -311,11 +311,21 @@ UniformGrid::UniformGrid(
 	usedTime(m_time);
 	DIntersectableRect ir;
 	computeGridGeometry(v,newPos,ir);
-	double l = max(ir.width(),ir.height());
-	l/=(m_graph.numberOfEdges()*m_edgeMultiplier);
+	double l = preferredCellSize(max(ir.width(),ir.height()));
 	OGDF_ASSERT(l > 0.5*m_CellSize);
 	OGDF_ASSERT(l < 2.0*m_CellSize);
 #endif
+	moveNode(v,newPos);
+#ifdef OGDF_DEBUG
+	m_time = usedTime(m_time);
+#endif
+}
+
+
+//updates the grid for node v moved to newPos. Only the edges incident to v
+//are removed from their cells and reinserted
+void UniformGrid::moveNode(const node v, const DPoint& newPos)
+{
 	//compute the list of edge incident to v
 	List<edge> incident;
 	v->adjEdges(incident);
@@ -348,9 +358,34 @@ UniformGrid::UniformGrid(
 	//list incident where not present. Now we reinsert the edges into the
 	//grid with their new positions and update the crossings
 	computeCrossings(incident,v,newPos);
-#ifdef OGDF_DEBUG
-	m_time = usedTime(m_time);
-#endif
+}
+
+
+//counts the crossings for node v moved to newPos the same way as moveNode
+//followed by numberOfCrossings(), but without changing the grid. The edges
+//incident to v are still stored at their old positions. They share v with
+//each new edge and thus never cross it, so they need not be skipped
+int UniformGrid::crossingsAfterMove(const node v, const DPoint& newPos) const
+{
+	int crossNum = m_crossNum;
+	SList<IPoint> crossedCells;
+	for(adjEntry adj : v->adjEntries) {
+		edge e = adj->theEdge();
+		//a self-loop is listed twice, but its crossings are removed once
+		if(!e->isSelfLoop() || adj == e->adjSource())
+			crossNum -= m_crossings[e].size();
+		node s = e->source(), t = e->target();
+		DPoint sPos = (s == v) ? newPos : DPoint(m_layout.x(s),m_layout.y(s));
+		DPoint tPos = (t == v) ? newPos : DPoint(m_layout.x(t),m_layout.y(t));
+		DoubleModifiedBresenham(sPos,tPos,crossedCells);
+		for(const IPoint &p : crossedCells) {
+			for(edge e2 : m_grid(p.m_x,p.m_y)) {
+				if(crossingTest(e,e2,v,newPos,p))
+					++crossNum;
+			}
+		}
+	}
+	return crossNum;
 }
 
 
@@ -410,6 +445,9 @@ void UniformGrid::computeCrossings(
 			if (!edgeList.empty()) { //there are already edges in that list
 				OGDF_ASSERT(!edgeList.empty());
 				for (edge e2 : edgeList) {
+#ifdef OGDF_DEBUG
+					m_crossingTests++;
+#endif
 					if (crossingTest(e, e2, moved, newPos, p)) { //two edges cross in p
 						++m_crossNum;
 						m_crossings[e].pushBack(e2);
@@ -441,7 +479,7 @@ bool UniformGrid::crossingTest(
 	const edge e2,
 	const node moved,
 	const DPoint& newPos,
-	const IPoint& cell)
+	const IPoint& cell) const
 {
 	bool crosses = false;
 	node s1 = e1->source(), t1 = e1->target();
@@ -462,9 +500,6 @@ bool UniformGrid::crossingTest(
 		else pt2 = newPos;
 		DLine l1(ps1,pt1),l2(ps2,pt2);
 		DPoint crossPoint;
-#ifdef OGDF_DEBUG
-		m_crossingTests++;
-#endif
 		if (l1.intersection(l2,crossPoint)
 		 && crossPoint.m_x >= xLeft
 		 && crossPoint.m_x < xRight
@@ -686,7 +721,7 @@ ostream &operator<<(ostream &out, const UniformGrid &ug)
 	node v = ug.m_graph.firstNode();
 	ug.computeGridGeometry(v,DPoint(ug.m_layout.x(v),ug.m_layout.y(v)),ir);
 	double l = max(ir.width(),ir.height());
-	cout << "\nPreferred Cell Size: " << l/(ug.m_graph.numberOfEdges()*ug.m_edgeMultiplier);
+	cout << "\nPreferred Cell Size: " << ug.preferredCellSize(l);
 #endif
 	return out;
 }
@@ -140,6 +140,7 @@ void ArrayGraph::readFrom(const GraphAttributes& GA, const EdgeArray<float>& edg
 		m_nodeXPos[m_numNodes] = (float)GA.x(v);
 		m_nodeYPos[m_numNodes] = (float)GA.y(v);
 		m_nodeSize[m_numNodes] = nodeSize[v];
+		m_nodeMoveRadius[m_numNodes] = FLT_MAX;
 		nodeIndex[v] = m_numNodes;
 		m_avgNodeSize += nodeSize[v];
 		m_numNodes++;
@@ -30,6 +30,7 @@
  */
 
 #include <ogdf/energybased/fast_multipole_embedder/FMEMultipoleKernel.h>
+#include <ogdf/basic/Tracer.h>
 
 namespace ogdf {
 namespace fast_multipole_embedder {
@@ -76,73 +77,87 @@ void FMEMultipoleKernel::quadtreeConstruction(ArrayPartition& pointPartition)
 	// use a simple parallel sorting algorithm
 	LinearQuadtree::LQPoint* points = tree.pointArray();
 	sort_parallel(points, tree.numberOfPoints(), LQPointComparer);
+	sync();
+	if (isMainThread())
+	{
+		// the parallel sort does not tell whether the order has changed
+		globalContext->reuseQuadtree = tree.canReuseTree(true);
+	}
 #else
 	if (isMainThread())
 	{
-		LinearQuadtree::LQPoint* points = tree.pointArray();
-		sort_single(points, tree.numberOfPoints(), LQPointComparer);
+		OGDF_TRACE_SCOPE("FastMultipoleEmbedder::sortPoints");
+		// the points were sorted in the last iteration, so they are usually (nearly) sorted
+		const bool orderChanged = tree.sortPoints();
+		globalContext->reuseQuadtree = tree.canReuseTree(orderChanged);
 	}
 #endif
 	// wait because the quadtree builder needs the sorted order
 	sync();
-	// if not a parallel run, we can do the easy way
-	if (isSingleThreaded())
+	// if the cells of the points did not change, the old tree is only refitted below
+	if (!globalContext->reuseQuadtree)
 	{
-		LinearQuadtreeBuilder builder(tree);
-		// prepare the tree
-		builder.prepareTree();
-		// and link it
-		builder.build();
-		LQPartitioner partitioner( localContext );
-		partitioner.partition();
-	} else // the more difficult part
-	{
-		// snap the left point of the interval of the thread to the first in the cell
-		LinearQuadtree::PointID beginPoint = tree.findFirstPointInCell(pointPartition.begin);
-		LinearQuadtree::PointID endPoint_plus_one;
-		// if this thread is the last one, no snapping required for the right point
-		if (threadNr()==numThreads()-1)
-			endPoint_plus_one = tree.numberOfPoints();
-		else // find the left point of the next thread
-			endPoint_plus_one = tree.findFirstPointInCell(pointPartition.end+1);
-
-		// now we can prepare the snapped interval
-		LinearQuadtreeBuilder builder(tree);
-		// this function prepares the tree from begin point to endPoint_plus_one-1 (EXCLUDING endPoint_plus_one)
-		builder.prepareTree(beginPoint, endPoint_plus_one);
-		// save the start, end and count of the inner node chain in the context
-		localContext->firstInnerNode = builder.firstInner;
-		localContext->lastInnerNode = builder.lastInner;
-		localContext->numInnerNodes = builder.numInnerNodes;
-		// save the start, end and count of the leaf node chain in the context
-		localContext->firstLeaf = builder.firstLeaf;
-		localContext->lastLeaf = builder.lastLeaf;
-		localContext->numLeaves = builder.numLeaves;
-		// wait until all are finished
-		sync();
-
-		// now the main thread has to link the tree
-		if (isMainThread())
+		// if not a parallel run, we can do the easy way
+		if (isSingleThreaded())
 		{
-			// with his own builder
-			LinearQuadtreeBuilder sbuilder(tree);
-			// first we need the complete chain data
-			sbuilder.firstInner = globalContext->pLocalContext[0]->firstInnerNode;
-			sbuilder.firstLeaf = globalContext->pLocalContext[0]->firstLeaf;
-			sbuilder.numInnerNodes = globalContext->pLocalContext[0]->numInnerNodes;
-			sbuilder.numLeaves = globalContext->pLocalContext[0]->numLeaves;
-			for (uint32_t j=1; j < numThreads(); j++)
+			OGDF_TRACE_SCOPE("FastMultipoleEmbedder::buildQuadtree");
+			LinearQuadtreeBuilder builder(tree);
+			// prepare the tree
+			builder.prepareTree();
+			// and link it
+			builder.build();
+			LQPartitioner partitioner( localContext );
+			partitioner.partition();
+		} else // the more difficult part
+		{
+			// snap the left point of the interval of the thread to the first in the cell
+			LinearQuadtree::PointID beginPoint = tree.findFirstPointInCell(pointPartition.begin);
+			LinearQuadtree::PointID endPoint_plus_one;
+			// if this thread is the last one, no snapping required for the right point
+			if (threadNr()==numThreads()-1)
+				endPoint_plus_one = tree.numberOfPoints();
+			else // find the left point of the next thread
+				endPoint_plus_one = tree.findFirstPointInCell(pointPartition.end+1);
+
+			// now we can prepare the snapped interval
+			LinearQuadtreeBuilder builder(tree);
+			// this function prepares the tree from begin point to endPoint_plus_one-1 (EXCLUDING endPoint_plus_one)
+			builder.prepareTree(beginPoint, endPoint_plus_one);
+			// save the start, end and count of the inner node chain in the context
+			localContext->firstInnerNode = builder.firstInner;
+			localContext->lastInnerNode = builder.lastInner;
+			localContext->numInnerNodes = builder.numInnerNodes;
+			// save the start, end and count of the leaf node chain in the context
+			localContext->firstLeaf = builder.firstLeaf;
+			localContext->lastLeaf = builder.lastLeaf;
+			localContext->numLeaves = builder.numLeaves;
+			// wait until all are finished
+			sync();
+
+			// now the main thread has to link the tree
+			if (isMainThread())
 			{
-				sbuilder.numLeaves += globalContext->pLocalContext[j]->numLeaves;
-				sbuilder.numInnerNodes += globalContext->pLocalContext[j]->numInnerNodes;
+				// with his own builder
+				LinearQuadtreeBuilder sbuilder(tree);
+				// first we need the complete chain data
+				sbuilder.firstInner = globalContext->pLocalContext[0]->firstInnerNode;
+				sbuilder.firstLeaf = globalContext->pLocalContext[0]->firstLeaf;
+				sbuilder.numInnerNodes = globalContext->pLocalContext[0]->numInnerNodes;
+				sbuilder.numLeaves = globalContext->pLocalContext[0]->numLeaves;
+				for (uint32_t j=1; j < numThreads(); j++)
+				{
+					sbuilder.numLeaves += globalContext->pLocalContext[j]->numLeaves;
+					sbuilder.numInnerNodes += globalContext->pLocalContext[j]->numInnerNodes;
+				}
+				sbuilder.lastInner = globalContext->pLocalContext[numThreads()-1]->lastInnerNode;
+				sbuilder.lastLeaf = globalContext->pLocalContext[numThreads()-1]->lastLeaf;
+				// Link the tree
+				OGDF_TRACE_SCOPE("FastMultipoleEmbedder::buildQuadtree");
+				sbuilder.build();
+				// and run the partitions
+				LQPartitioner partitioner(localContext);
+				partitioner.partition();
 			}
-			sbuilder.lastInner = globalContext->pLocalContext[numThreads()-1]->lastInnerNode;
-			sbuilder.lastLeaf = globalContext->pLocalContext[numThreads()-1]->lastLeaf;
-			// Link the tree
-			sbuilder.build();
-			// and run the partitions
-			LQPartitioner partitioner(localContext);
-			partitioner.partition();
 		}
 	}
 	// wait for tree to finish
@@ -509,21 +524,24 @@ void FMEMultipoleKernel::operator()(FMEGlobalContext* globalContext)
 	}
 
 	uint32_t maxNumIt = options->preProcMaxNumIterations;
-	for (uint32_t currNumIteration = 0; currNumIteration < maxNumIt; currNumIteration++)
 	{
-		// iterate over all edges and store the resulting forces in the threads array
-		for_loop(edgePartition,
-			edge_force_function< static_cast<int>(FMEEdgeForce::DivDegree) > (localContext)	// divide the forces by degree of the node to avoid oscilation
-			);
-		// wait until all edges are done
-		sync();
-		// now collect the forces in parallel and put the sum into the global array and move the nodes accordingly
-		for_loop(nodePointPartition,
-			func_comp(
-			collect_force_function<FMECollect::EdgeFactorRep | FMECollect::ZeroThreadArray >(localContext),
-			node_move_function<TIME_STEP_PREP | ZERO_GLOBAL_ARRAY>(localContext)
-			)
-			);
+		OGDF_TRACE_SCOPE("FastMultipoleEmbedder::preprocessing");
+		for (uint32_t currNumIteration = 0; currNumIteration < maxNumIt; currNumIteration++)
+		{
+			// iterate over all edges and store the resulting forces in the threads array
+			for_loop(edgePartition,
+				edge_force_function< static_cast<int>(FMEEdgeForce::DivDegree) > (localContext)	// divide the forces by degree of the node to avoid oscilation
+				);
+			// wait until all edges are done
+			sync();
+			// now collect the forces in parallel and put the sum into the global array and move the nodes accordingly
+			for_loop(nodePointPartition,
+				func_comp(
+				collect_force_function<FMECollect::EdgeFactorRep | FMECollect::ZeroThreadArray >(localContext),
+				node_move_function<TIME_STEP_PREP | ZERO_GLOBAL_ARRAY | USE_NODE_MOVE_RAD>(localContext)
+				)
+				);
+		}
 	}
 	if (isMainThread())
 	{
@@ -541,31 +559,40 @@ void FMEMultipoleKernel::operator()(FMEGlobalContext* globalContext)
 		localContext->avgForce = 0.0;
 
 		// construct the quadtree
-		quadtreeConstruction(nodePointPartition);
-		// wait for all threads to finish
-		sync();
-
-		if (isSingleThreaded()) // if is single threaded run the simple approximation
-			multipoleApproxSingleThreaded(nodePointPartition);
-		else // otherwise use the partitioning
-			multipoleApproxFinal(nodePointPartition);
-		// now wait until all forces are summed up in the global array and mapped to graph node order
-		sync();
+		{
+			OGDF_TRACE_SCOPE("FastMultipoleEmbedder::quadtreeConstruction");
+			quadtreeConstruction(nodePointPartition);
+			// wait for all threads to finish
+			sync();
+		}
 
-		// run the edge forces
-		for_loop(edgePartition,							// iterate over all edges and sum up the forces in the threads array
-			edge_force_function< static_cast<int>(FMEEdgeForce::DivDegree) >(localContext)	// divide the forces by degree of the node to avoid oscilation
-		);
-		// wait until edges are finished
-		sync();
+		{
+			OGDF_TRACE_SCOPE("FastMultipoleEmbedder::repulsiveForces");
+			if (isSingleThreaded()) // if is single threaded run the simple approximation
+				multipoleApproxSingleThreaded(nodePointPartition);
+			else // otherwise use the partitioning
+				multipoleApproxFinal(nodePointPartition);
+			// now wait until all forces are summed up in the global array and mapped to graph node order
+			sync();
+		}
 
-		// collect the edge forces and move nodes without waiting
-		for_loop(nodePointPartition,
-			func_comp(
-				collect_force_function<FMECollect::EdgeFactorRep | FMECollect::ZeroThreadArray>(localContext),
-				node_move_function<TIME_STEP_NORMAL | ZERO_GLOBAL_ARRAY>(localContext)
-			)
-		);
+		{
+			OGDF_TRACE_SCOPE("FastMultipoleEmbedder::edgeForces");
+			// run the edge forces
+			for_loop(edgePartition,							// iterate over all edges and sum up the forces in the threads array
+				edge_force_function< static_cast<int>(FMEEdgeForce::DivDegree) >(localContext)	// divide the forces by degree of the node to avoid oscilation
+			);
+			// wait until edges are finished
+			sync();
+
+			// collect the edge forces and move nodes without waiting
+			for_loop(nodePointPartition,
+				func_comp(
+					collect_force_function<FMECollect::EdgeFactorRep | FMECollect::ZeroThreadArray>(localContext),
+					node_move_function<TIME_STEP_NORMAL | ZERO_GLOBAL_ARRAY | USE_NODE_MOVE_RAD>(localContext)
+				)
+			);
+		}
 		// wait so we can decide if we need another iteration
 		sync();
 		// check the max force square for all threads
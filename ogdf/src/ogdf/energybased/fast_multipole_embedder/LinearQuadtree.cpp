@@ -32,6 +32,9 @@
 #include <ogdf/energybased/fast_multipole_embedder/LinearQuadtree.h>
 #include <ogdf/energybased/fast_multipole_embedder/WSPD.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace ogdf {
 namespace fast_multipole_embedder {
 
@@ -89,6 +92,10 @@ void LinearQuadtree::allocate(uint32_t n)
 	m_pointXPos = static_cast<float*>(OGDF_MALLOC_16(m_numPoints*sizeof(float)));
 	m_pointYPos = static_cast<float*>(OGDF_MALLOC_16(m_numPoints*sizeof(float)));
 	m_pointSize = static_cast<float*>(OGDF_MALLOC_16(m_numPoints*sizeof(float)));
+	m_sortBuffer = static_cast<LQPoint*>(OGDF_MALLOC_16(m_numPoints*sizeof(LQPoint)));
+	m_splitBits = static_cast<uint8_t*>(OGDF_MALLOC_16(m_numPoints*sizeof(uint8_t)));
+	m_treeBuilt = false;
+	m_numReusedTrees = 0;
 	m_notWspd = static_cast<LQWSPair*>(OGDF_MALLOC_16(m_maxNumNodes*sizeof(LQWSPair) * 27));
 	m_directNodes = static_cast<NodeID*>(OGDF_MALLOC_16(m_maxNumNodes*sizeof(NodeID)));
 	m_WSPD = new WSPD(m_maxNumNodes);
@@ -105,6 +112,8 @@ void LinearQuadtree::deallocate()
 	OGDF_FREE_16(m_pointXPos);
 	OGDF_FREE_16(m_pointYPos);
 	OGDF_FREE_16(m_pointSize);
+	OGDF_FREE_16(m_sortBuffer);
+	OGDF_FREE_16(m_splitBits);
 	OGDF_FREE_16(m_notWspd);
 	OGDF_FREE_16(m_directNodes);
 	delete m_WSPD;
@@ -113,7 +122,8 @@ void LinearQuadtree::deallocate()
 
 uint64_t LinearQuadtree::sizeInBytes() const
 {
-	return m_numPoints*sizeof(LQPoint) +
+	return 2*m_numPoints*sizeof(LQPoint) +
+		m_numPoints*sizeof(uint8_t) +
 		m_maxNumNodes*sizeof(LQNode) +
 		m_maxNumNodes*sizeof(LQWSPair)*27 +
 		m_maxNumNodes*sizeof(NodeID) +
@@ -121,6 +131,111 @@ uint64_t LinearQuadtree::sizeInBytes() const
 }
 
 
+bool LinearQuadtree::sortPoints()
+{
+	const uint32_t n = m_numPoints;
+
+	// find the sorted runs of the current order
+	uint32_t numDescents = 0;
+	for (uint32_t i = 1; i < n; i++) {
+		if (m_points[i].mortonNr < m_points[i-1].mortonNr) {
+			numDescents++;
+		}
+	}
+	if (numDescents == 0) {
+		return false;
+	}
+
+	LQPoint* src = m_points;
+	LQPoint* dst = m_sortBuffer;
+
+	if (numDescents <= n / OGDF_LQ_MERGE_SORT_RUN_RATIO) {
+		// nearly sorted: merge adjacent runs until a single run is left
+		std::vector<uint32_t> runStart;
+		runStart.reserve(numDescents + 2);
+		runStart.push_back(0);
+		for (uint32_t i = 1; i < n; i++) {
+			if (m_points[i].mortonNr < m_points[i-1].mortonNr) {
+				runStart.push_back(i);
+			}
+		}
+		runStart.push_back(n);
+
+		while (runStart.size() > 2) {
+			std::vector<uint32_t> merged;
+			merged.reserve(runStart.size() / 2 + 2);
+			size_t r = 0;
+			for (; r + 2 < runStart.size(); r += 2) {
+				std::merge(src + runStart[r], src + runStart[r+1],
+				           src + runStart[r+1], src + runStart[r+2],
+				           dst + runStart[r], LQPointComparer);
+				merged.push_back(runStart[r]);
+			}
+			if (r + 1 < runStart.size()) {
+				// an odd run is left over
+				std::copy(src + runStart[r], src + runStart[r+1], dst + runStart[r]);
+				merged.push_back(runStart[r]);
+			}
+			merged.push_back(n);
+			runStart.swap(merged);
+			std::swap(src, dst);
+		}
+	} else {
+		// LSD radix sort with 8 bit digits
+		const int numDigits = sizeof(MortonNR);
+		std::vector<uint32_t> count(256 * numDigits, 0);
+		for (uint32_t i = 0; i < n; i++) {
+			MortonNR key = m_points[i].mortonNr;
+			for (int d = 0; d < numDigits; d++) {
+				count[256*d + ((key >> (8*d)) & 0xff)]++;
+			}
+		}
+
+		for (int d = 0; d < numDigits; d++) {
+			uint32_t* digitCount = &count[256*d];
+			// skip digits that are the same for all points
+			if (digitCount[(src[0].mortonNr >> (8*d)) & 0xff] == n) {
+				continue;
+			}
+			uint32_t sum = 0;
+			for (int b = 0; b < 256; b++) {
+				uint32_t c = digitCount[b];
+				digitCount[b] = sum;
+				sum += c;
+			}
+			for (uint32_t i = 0; i < n; i++) {
+				dst[digitCount[(src[i].mortonNr >> (8*d)) & 0xff]++] = src[i];
+			}
+			std::swap(src, dst);
+		}
+	}
+
+	// the sorted points are in src, the other array becomes the buffer
+	m_points = src;
+	m_sortBuffer = dst;
+	return true;
+}
+
+
+bool LinearQuadtree::canReuseTree(bool orderChanged)
+{
+	bool reuse = m_treeBuilt && !orderChanged;
+	for (uint32_t i = 0; i + 1 < m_numPoints; i++) {
+		uint8_t bit = static_cast<uint8_t>(mostSignificantBit(m_points[i].mortonNr ^ m_points[i+1].mortonNr));
+		if (bit != m_splitBits[i]) {
+			reuse = false;
+			m_splitBits[i] = bit;
+		}
+	}
+	if (reuse) {
+		m_numReusedTrees++;
+	}
+	// the builder sets this flag again after building a new tree
+	m_treeBuilt = reuse;
+	return reuse;
+}
+
+
 //! iterates back in the sequence until the first point with another morton number occures, returns that point +1
 LinearQuadtree::PointID LinearQuadtree::findFirstPointInCell(LinearQuadtree::PointID somePointInCell) const
 {
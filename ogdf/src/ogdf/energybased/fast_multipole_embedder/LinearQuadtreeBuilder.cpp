@@ -122,7 +122,8 @@ void LinearQuadtreeBuilder::buildHierarchy()
 {
 	tree.clear();
 	restoreChainLastNode = 0;
-	tree.m_root = buildHierarchy(n, 128);
+	// if all points share one cell, the only inner node is the end of the chain
+	tree.m_root = (numLeaves > 1) ? buildHierarchy(n, 128) : firstLeaf;
 }
 
 
@@ -136,6 +137,7 @@ void LinearQuadtreeBuilder::build()
 	tree.m_numInnerNodes = numInnerNodes;
 	tree.m_firstLeaf = firstLeaf;
 	tree.m_numLeaves = numLeaves;
+	tree.m_treeBuilt = true;
 }
 
 }
@@ -32,6 +32,7 @@
 #include <ogdf/energybased/fmmm/FruchtermanReingold.h>
 #include <ogdf/energybased/fmmm/numexcept.h>
 #include <ogdf/basic/Array2D.h>
+#include <ogdf/basic/ParallelFor.h>
 
 namespace ogdf {
 namespace energybased {
@@ -40,6 +41,50 @@ namespace fmmm {
 FruchtermanReingold::FruchtermanReingold()
 {
 	grid_quotient(2);
+	max_threads(1);
+}
+
+
+void FruchtermanReingold::add_rep_force(
+	node u,
+	node v,
+	NodeArray<NodeAttributes> &A,
+	NodeArray<DPoint>& F_rep,
+	numexcept &N)
+{
+	DPoint f_rep_u_on_v;
+	DPoint pos_u = A[u].get_position();
+	DPoint pos_v = A[v].get_position();
+	if (pos_u == pos_v)
+	{//if2  (Exception handling if two nodes have the same position)
+		pos_u = N.choose_distinct_random_point_in_radius_epsilon(pos_u);
+	}//if2
+	DPoint vector_v_minus_u = pos_v - pos_u;
+	double norm_v_minus_u = vector_v_minus_u.norm();
+	if (!N.f_rep_near_machine_precision(norm_v_minus_u, f_rep_u_on_v))
+	{
+		double scalar = f_rep_scalar(norm_v_minus_u) / norm_v_minus_u;
+		f_rep_u_on_v.m_x = scalar * vector_v_minus_u.m_x;
+		f_rep_u_on_v.m_y = scalar * vector_v_minus_u.m_y;
+	}
+	F_rep[v] = F_rep[v] + f_rep_u_on_v;
+	F_rep[u] = F_rep[u] - f_rep_u_on_v;
+}
+
+
+void FruchtermanReingold::sum_up_thread_forces(
+	const Array<node> &nodes,
+	Array<NodeArray<DPoint>> &F_thread,
+	NodeArray<DPoint>& F_rep,
+	unsigned int threads)
+{
+	parallelFor(threads, nodes.size(), [&](int begin, int end, unsigned int) {
+		for (int i = begin; i < end; i++) {
+			node v = nodes[i];
+			for (unsigned int t = 1; t < threads; t++)
+				F_rep[v] = F_rep[v] + F_thread[t][v];
+		}
+	});
 }
 
 
@@ -49,49 +94,37 @@ void FruchtermanReingold::calculate_exact_repulsive_forces(
 	NodeArray<DPoint>& F_rep)
 {
 	//naive algorithm by Fruchterman & Reingold
-	numexcept N;
-	DPoint f_rep_u_on_v;
-	DPoint vector_v_minus_u;
-	DPoint pos_u, pos_v;
 	DPoint nullpoint(0, 0);
-	double norm_v_minus_u;
 	int node_number = G.numberOfNodes();
-	Array<node> array_of_the_nodes(node_number + 1);
-	double scalar;
-
-	for (node v : G.nodes)
-		F_rep[v] = nullpoint;
+	Array<node> array_of_the_nodes(node_number);
 
-	int counter = 1;
+	int counter = 0;
 	for (node v : G.nodes)
 	{
+		F_rep[v] = nullpoint;
 		array_of_the_nodes[counter] = v;
 		counter++;
 	}
 
-	for (int i = 1; i < node_number; i++) {
-		for (int j = i + 1; j <= node_number; j++)
-		{
-			node u = array_of_the_nodes[i];
-			node v = array_of_the_nodes[j];
-			pos_u = A[u].get_position();
-			pos_v = A[v].get_position();
-			if (pos_u == pos_v)
-			{//if2  (Exception handling if two nodes have the same position)
-				pos_u = N.choose_distinct_random_point_in_radius_epsilon(pos_u);
-			}//if2
-			vector_v_minus_u = pos_v - pos_u;
-			norm_v_minus_u = vector_v_minus_u.norm();
-			if (!N.f_rep_near_machine_precision(norm_v_minus_u, f_rep_u_on_v))
-			{
-				scalar = f_rep_scalar(norm_v_minus_u) / norm_v_minus_u;
-				f_rep_u_on_v.m_x = scalar * vector_v_minus_u.m_x;
-				f_rep_u_on_v.m_y = scalar * vector_v_minus_u.m_y;
-			}
-			F_rep[v] = F_rep[v] + f_rep_u_on_v;
-			F_rep[u] = F_rep[u] - f_rep_u_on_v;
+	//every thread sums up its forces in its own buffer; thread 0 writes to F_rep directly
+	const unsigned int threads = numberOfThreadsFor(m_maxThreads, node_number, MIN_NODES_PER_THREAD);
+	Array<NodeArray<DPoint>> F_thread(1, threads - 1);
+	for (unsigned int t = 1; t < threads; t++)
+		F_thread[t].init(G, nullpoint);
+
+	//row i has node_number-i-1 pairs, so the rows are dealt out round-robin
+	//to give every thread about the same amount of work
+	parallelFor(threads, threads, [&](int, int, unsigned int t) {
+		numexcept N;
+		NodeArray<DPoint> &F = (t == 0) ? F_rep : F_thread[t];
+		for (int i = t; i < node_number - 1; i += threads) {
+			for (int j = i + 1; j < node_number; j++)
+				add_rep_force(array_of_the_nodes[i], array_of_the_nodes[j], A, F, N);
 		}
-	}
+	});
+
+	if (threads > 1)
+		sum_up_thread_forces(array_of_the_nodes, F_thread, F_rep, threads);
 }
 
 
@@ -101,23 +134,18 @@ void FruchtermanReingold::calculate_approx_repulsive_forces(
 	NodeArray<DPoint>& F_rep)
 {
 	//GRID algorithm by Fruchterman & Reingold
-	numexcept N;
-	List<IPoint> neighbour_boxes;
-	List<node> neighbour_box;
-	IPoint neighbour;
-	DPoint f_rep_u_on_v;
-	DPoint vector_v_minus_u;
 	DPoint nullpoint(0, 0);
-	DPoint pos_u, pos_v;
-	double norm_v_minus_u;
-	double scalar;
-
-	int i, j, act_i, act_j, k, l, length;
 	double gridboxlength;//length of a box in the GRID
 
 	//init F_rep
+	Array<node> array_of_the_nodes(G.numberOfNodes());
+	int counter = 0;
 	for (node v : G.nodes)
+	{
 		F_rep[v] = nullpoint;
+		array_of_the_nodes[counter] = v;
+		counter++;
+	}
 
 	//init max_gridindex and set contained_nodes
 
@@ -125,12 +153,6 @@ void FruchtermanReingold::calculate_approx_repulsive_forces(
 	max_gridindex = ((max_gridindex > 0) ? max_gridindex : 0);
 	Array2D<List<node> >  contained_nodes(0, max_gridindex, 0, max_gridindex);
 
-	for (i = 0; i <= max_gridindex; i++)
-	for (j = 0; j <= max_gridindex; j++)
-	{
-		contained_nodes(i, j).clear();
-	}
-
 	gridboxlength = boxlength / (max_gridindex + 1);
 	for (node v : G.nodes)
 	{
@@ -141,94 +163,53 @@ void FruchtermanReingold::calculate_approx_repulsive_forces(
 		contained_nodes(x_index, y_index).pushBack(v);
 	}
 
-	//force calculation
+	//force calculation; the grid columns are split among the threads,
+	//each of which sums up its forces in its own buffer
+	const unsigned int threads = numberOfThreadsFor(m_maxThreads, G.numberOfNodes(), MIN_NODES_PER_THREAD);
+	Array<NodeArray<DPoint>> F_thread(1, threads - 1);
+	for (unsigned int t = 1; t < threads; t++)
+		F_thread[t].init(G, nullpoint);
 
-	for (i = 0; i <= max_gridindex; i++)
-	for (j = 0; j <= max_gridindex; j++)
-	{
-		//step1: calculate forces inside contained_nodes(i,j)
+	parallelFor(threads, max_gridindex + 1, [&](int begin, int end, unsigned int t) {
+		numexcept N;
+		NodeArray<DPoint> &F = (t == 0) ? F_rep : F_thread[t];
+		Array<node> nodearray_i_j;
 
-		length = contained_nodes(i, j).size();
-		Array<node> nodearray_i_j(length + 1);
-		k = 1;
-		for (node v : contained_nodes(i, j))
+		for (int i = begin; i < end; i++)
+		for (int j = 0; j <= max_gridindex; j++)
 		{
-			nodearray_i_j[k] = v;
-			k++;
-		}
+			//step1: calculate forces inside contained_nodes(i,j)
 
-		for (k = 1; k < length; k++)
-		for (l = k + 1; l <= length; l++)
-		{
-			node u = nodearray_i_j[k];
-			node v = nodearray_i_j[l];
-			pos_u = A[u].get_position();
-			pos_v = A[v].get_position();
-			if (pos_u == pos_v)
-			{//if2  (Exception handling if two nodes have the same position)
-				pos_u = N.choose_distinct_random_point_in_radius_epsilon(pos_u);
-			}//if2
-			vector_v_minus_u = pos_v - pos_u;
-			norm_v_minus_u = vector_v_minus_u.norm();
-
-			if (!N.f_rep_near_machine_precision(norm_v_minus_u, f_rep_u_on_v))
+			int length = contained_nodes(i, j).size();
+			nodearray_i_j.init(length);
+			int k = 0;
+			for (node v : contained_nodes(i, j))
 			{
-				scalar = f_rep_scalar(norm_v_minus_u) / norm_v_minus_u;
-				f_rep_u_on_v.m_x = scalar * vector_v_minus_u.m_x;
-				f_rep_u_on_v.m_y = scalar * vector_v_minus_u.m_y;
+				nodearray_i_j[k] = v;
+				k++;
 			}
-			F_rep[v] = F_rep[v] + f_rep_u_on_v;
-			F_rep[u] = F_rep[u] - f_rep_u_on_v;
-		}
 
-		//step 2: calculated forces to nodes in neighbour boxes
+			for (k = 0; k < length - 1; k++)
+			for (int l = k + 1; l < length; l++)
+				add_rep_force(nodearray_i_j[k], nodearray_i_j[l], A, F, N);
 
-		//find_neighbour_boxes
-
-		neighbour_boxes.clear();
-		for (k = i - 1; k <= i + 1; k++)
-		for (l = j - 1; l <= j + 1; l++)
-		if ((k >= 0) && (l >= 0) && (k <= max_gridindex) && (l <= max_gridindex))
-		{
-			neighbour.m_x = k;
-			neighbour.m_y = l;
-			if ((k != i) || (l != j))
-				neighbour_boxes.pushBack(neighbour);
-		}
-
-
-		//forget neighbour_boxes that already had access to this box
-		for (const IPoint &act_neighbour_box : neighbour_boxes)
-		{
-			act_i = act_neighbour_box.m_x;
-			act_j = act_neighbour_box.m_y;
-			if ((act_j == j + 1) || ((act_j == j) && (act_i == i + 1)))
+			//step 2: calculated forces to nodes in neighbour boxes
+			//(only the boxes that did not already have access to this box)
+			for (k = i - 1; k <= i + 1; k++)
+			for (int l = j; l <= j + 1; l++)
+			if ((k >= 0) && (k <= max_gridindex) && (l <= max_gridindex)
+			 && ((l == j + 1) || (k == i + 1)))
 			{
 				for (node v : contained_nodes(i, j)) {
-					for (node u : contained_nodes(act_i, act_j))
-					{
-						pos_u = A[u].get_position();
-						pos_v = A[v].get_position();
-						if (pos_u == pos_v)
-						{//  (Exception handling if two nodes have the same position)
-							pos_u = N.choose_distinct_random_point_in_radius_epsilon(pos_u);
-						}
-						vector_v_minus_u = pos_v - pos_u;
-						norm_v_minus_u = vector_v_minus_u.norm();
-
-						if (!N.f_rep_near_machine_precision(norm_v_minus_u, f_rep_u_on_v))
-						{
-							scalar = f_rep_scalar(norm_v_minus_u) / norm_v_minus_u;
-							f_rep_u_on_v.m_x = scalar * vector_v_minus_u.m_x;
-							f_rep_u_on_v.m_y = scalar * vector_v_minus_u.m_y;
-						}
-						F_rep[v] = F_rep[v] + f_rep_u_on_v;
-						F_rep[u] = F_rep[u] - f_rep_u_on_v;
-					}
+					for (node u : contained_nodes(k, l))
+						add_rep_force(u, v, A, F, N);
 				}
 			}
 		}
-	}
+	});
+
+	if (threads > 1)
+		sum_up_thread_forces(array_of_the_nodes, F_thread, F_rep, threads);
 }
 
 
@@ -32,6 +32,7 @@
 
 #include <ogdf/energybased/fmmm/NewMultipoleMethod.h>
 #include <ogdf/energybased/fmmm/numexcept.h>
+#include <ogdf/basic/ParallelFor.h>
 
 
 #define MIN_BOX_LENGTH   1e-300
@@ -58,6 +59,7 @@ NewMultipoleMethod::NewMultipoleMethod()
 	precision(4); particles_in_leaves(25);
 	tree_construction_way(FMMMOptions::ReducedTreeConstruction::SubtreeBySubtree);
 	find_sm_cell(FMMMOptions::SmallestCellFinding::Iteratively);
+	max_threads(1);
 }
 
 
@@ -83,14 +85,13 @@ void NewMultipoleMethod::calculate_repulsive_forces_by_NMM(
 	NodeArray<DPoint> F_direct(G);
 	NodeArray<DPoint> F_local_exp(G);
 	NodeArray<DPoint> F_multipole_exp(G);
-	List<QuadTreeNodeNM*> quad_tree_leaves;
+	Array<QuadTreeNodeNM*> quad_tree_leaves;
 
 	//initializations
 
 	for(node v : G.nodes)
 		F_direct[v]=F_local_exp[v]=F_multipole_exp[v]=nullpoint;
 
-	quad_tree_leaves.clear();
 	switch (tree_construction_way()) {
 	case FMMMOptions::ReducedTreeConstruction::PathByPath:
 		build_up_red_quad_tree_path_by_path(G,A,T);
@@ -1958,54 +1959,71 @@ inline void NewMultipoleMethod::delete_red_quad_tree_and_count_treenodes(QuadTre
 inline void NewMultipoleMethod::form_multipole_expansions(
 	NodeArray<NodeAttributes>& A,
 	QuadTreeNM& T,
-	List<QuadTreeNodeNM*>& quad_tree_leaves)
+	Array<QuadTreeNodeNM*>& quad_tree_leaves)
 {
+	//the centers are set sequentially, since they are perturbed randomly
+	List<QuadTreeNodeNM*> leaves, shifted_nodes;
 	T.set_act_ptr(T.get_root_ptr());
-	form_multipole_expansion_of_subtree(A,T,quad_tree_leaves);
+	form_multipole_expansion_of_subtree(A,T,leaves,shifted_nodes);
+
+	quad_tree_leaves.init(leaves.size());
+	int i = 0;
+	for(QuadTreeNodeNM *leaf_ptr : leaves)
+		quad_tree_leaves[i++] = leaf_ptr;
+
+	//form expansions for leaf nodes
+	parallelFor(m_maxThreads, quad_tree_leaves.size(), [&](int begin, int end, unsigned int) {
+		for(int j = begin; j < end; j++)
+			form_multipole_expansion_of_leaf_node(A,quad_tree_leaves[j]);
+	});
+
+	//add shifted expansions bottom-up
+	for(QuadTreeNodeNM *act_ptr : shifted_nodes)
+		add_shifted_expansion_to_father_expansion(act_ptr);
 }
 
 
 void NewMultipoleMethod::form_multipole_expansion_of_subtree(
 	NodeArray<NodeAttributes>& A,
 	QuadTreeNM& T,
-	List<QuadTreeNodeNM*>& quad_tree_leaves)
+	List<QuadTreeNodeNM*>& quad_tree_leaves,
+	List<QuadTreeNodeNM*>& shifted_nodes)
 {
 	init_expansion_Lists(T.get_act_ptr());
 	set_center(T.get_act_ptr());
 
-	if(T.get_act_ptr()->is_leaf()) //form expansions for leaf nodes
+	if(T.get_act_ptr()->is_leaf())
 	{//if
 		quad_tree_leaves.pushBack(T.get_act_ptr());
-		form_multipole_expansion_of_leaf_node(A,T.get_act_ptr());
 	}//if
-	else //rekursive calls and add shifted expansions
+	else //rekursive calls; remember the children for adding shifted expansions
 	{//else
 		if(T.get_act_ptr()->child_lt_exists())
 		{
 			T.go_to_lt_child();
-			form_multipole_expansion_of_subtree(A,T,quad_tree_leaves);
-			add_shifted_expansion_to_father_expansion(T.get_act_ptr());
+			form_multipole_expansion_of_subtree(A,T,quad_tree_leaves,shifted_nodes);
+			shifted_nodes.pushBack(T.get_act_ptr());
 			T.go_to_father();
 		}
 		if(T.get_act_ptr()->child_rt_exists())
 		{
 			T.go_to_rt_child();
-			form_multipole_expansion_of_subtree(A,T,quad_tree_leaves);
-			add_shifted_expansion_to_father_expansion(T.get_act_ptr());
+			form_multipole_expansion_of_subtree(A,T,quad_tree_leaves,shifted_nodes);
+			shifted_nodes.pushBack(T.get_act_ptr());
 			T.go_to_father();
 		}
 		if(T.get_act_ptr()->child_lb_exists())
 		{
 			T.go_to_lb_child();
-			form_multipole_expansion_of_subtree(A,T,quad_tree_leaves);
-			add_shifted_expansion_to_father_expansion(T.get_act_ptr());
+			form_multipole_expansion_of_subtree(A,T,quad_tree_leaves,shifted_nodes);
+			shifted_nodes.pushBack(T.get_act_ptr());
 			T.go_to_father();
 		}
 		if(T.get_act_ptr()->child_rb_exists())
 		{
 			T.go_to_rb_child();
-			form_multipole_expansion_of_subtree(A,T,quad_tree_leaves);
-			add_shifted_expansion_to_father_expansion(T.get_act_ptr());
+			form_multipole_expansion_of_subtree(A,T,quad_tree_leaves,shifted_nodes);
+			shifted_nodes.pushBack(T.get_act_ptr());
 			T.go_to_father();
 		}
 	}//else
@@ -2455,181 +2473,227 @@ void NewMultipoleMethod::add_local_expansion_of_leaf(
 
 void NewMultipoleMethod::transform_local_exp_to_forces(
 	NodeArray <NodeAttributes>&A,
-	List<QuadTreeNodeNM*>& quad_tree_leaves,
+	const Array<QuadTreeNodeNM*>& quad_tree_leaves,
 	NodeArray<DPoint>& F_local_exp)
 {
-	complex<double> sum;
-	complex<double> complex_null (0,0);
-	complex<double> z_0;
-	complex<double> z_v_minus_z_0_over_k_minus_1;
-	DPoint force_vector;
-
 	//calculate derivative of the potential polynom (= local expansion at leaf nodes)
 	//and evaluate it for each node in contained_nodes()
 	//and transform the complex number back to the real-world, to obtain the force
 
-	for(const QuadTreeNodeNM *leaf_ptr : quad_tree_leaves)
-	{
-		List<node> contained_nodes;
-		leaf_ptr->get_contained_nodes(contained_nodes);
-		z_0 = leaf_ptr->get_Sm_center();
+	parallelFor(m_maxThreads, quad_tree_leaves.size(), [&](int begin, int end, unsigned int) {
+		complex<double> sum;
+		complex<double> complex_null (0,0);
+		complex<double> z_0;
+		complex<double> z_v_minus_z_0_over_k_minus_1;
+		DPoint force_vector;
 
-		for(node v : contained_nodes)
+		for(int i = begin; i < end; i++)
 		{
-			complex<double> z_v (A[v].get_x(),A[v].get_y());
-			sum = complex_null;
-			z_v_minus_z_0_over_k_minus_1 = 1;
-			for(int k=1; k<=precision(); k++)
+			const QuadTreeNodeNM *leaf_ptr = quad_tree_leaves[i];
+			List<node> contained_nodes;
+			leaf_ptr->get_contained_nodes(contained_nodes);
+			z_0 = leaf_ptr->get_Sm_center();
+
+			for(node v : contained_nodes)
 			{
-				sum += double(k) * leaf_ptr->get_local_exp()[k] *
-					z_v_minus_z_0_over_k_minus_1;
-				z_v_minus_z_0_over_k_minus_1 *= z_v - z_0;
+				complex<double> z_v (A[v].get_x(),A[v].get_y());
+				sum = complex_null;
+				z_v_minus_z_0_over_k_minus_1 = 1;
+				for(int k=1; k<=precision(); k++)
+				{
+					sum += double(k) * leaf_ptr->get_local_exp()[k] *
+						z_v_minus_z_0_over_k_minus_1;
+					z_v_minus_z_0_over_k_minus_1 *= z_v - z_0;
+				}
+				force_vector.m_x = sum.real();
+				force_vector.m_y = (-1) * sum.imag();
+				F_local_exp[v] = force_vector;
 			}
-			force_vector.m_x = sum.real();
-			force_vector.m_y = (-1) * sum.imag();
-			F_local_exp[v] = force_vector;
 		}
-	}
+	});
 }
 
 
 void NewMultipoleMethod::transform_multipole_exp_to_forces(
 	NodeArray<NodeAttributes>& A,
-	List<QuadTreeNodeNM*>& quad_tree_leaves,
+	const Array<QuadTreeNodeNM*>& quad_tree_leaves,
 	NodeArray<DPoint>& F_multipole_exp)
 {
-	complex<double> sum;
-	complex<double> z_0;
-	complex<double> z_v_minus_z_0_over_minus_k_minus_1;
-	DPoint force_vector;
-
 	//for each leaf u in the M-List of an actual leaf v do:
 	//calculate derivative of the multipole expansion function at u
 	//and evaluate it for each node in v.get_contained_nodes()
 	//and transform the complex number back to the real-world, to obtain the force
 
-	for(QuadTreeNodeNM *act_leaf_ptr : quad_tree_leaves)
-	{
-		List<node> act_contained_nodes;
-		act_leaf_ptr->get_contained_nodes(act_contained_nodes);
+	parallelFor(m_maxThreads, quad_tree_leaves.size(), [&](int begin, int end, unsigned int) {
+		complex<double> sum;
+		complex<double> z_0;
+		complex<double> z_v_minus_z_0_over_minus_k_minus_1;
+		DPoint force_vector;
 
-		List<QuadTreeNodeNM*> M;
-		act_leaf_ptr->get_M(M);
-
-		for(const QuadTreeNodeNM *M_node_ptr : M)
+		for(int i = begin; i < end; i++)
 		{
-			z_0 = M_node_ptr->get_Sm_center();
-			for(node v : act_contained_nodes)
-			{
-				complex<double> z_v (A[v].get_x(),A[v].get_y());
-				z_v_minus_z_0_over_minus_k_minus_1 = 1.0/(z_v-z_0);
-				sum = M_node_ptr->get_multipole_exp()[0]*
-					z_v_minus_z_0_over_minus_k_minus_1;
+			const QuadTreeNodeNM *act_leaf_ptr = quad_tree_leaves[i];
+			List<node> act_contained_nodes;
+			act_leaf_ptr->get_contained_nodes(act_contained_nodes);
 
-				for(int k=1; k<=precision(); k++)
+			List<QuadTreeNodeNM*> M;
+			act_leaf_ptr->get_M(M);
+
+			for(const QuadTreeNodeNM *M_node_ptr : M)
+			{
+				z_0 = M_node_ptr->get_Sm_center();
+				for(node v : act_contained_nodes)
 				{
-					z_v_minus_z_0_over_minus_k_minus_1 /= z_v - z_0;
-					sum -= double(k) * M_node_ptr->get_multipole_exp()[k] *
+					complex<double> z_v (A[v].get_x(),A[v].get_y());
+					z_v_minus_z_0_over_minus_k_minus_1 = 1.0/(z_v-z_0);
+					sum = M_node_ptr->get_multipole_exp()[0]*
 						z_v_minus_z_0_over_minus_k_minus_1;
-				}
-				force_vector.m_x = sum.real();
-				force_vector.m_y = (-1) * sum.imag();
-				F_multipole_exp[v] =  F_multipole_exp[v] + force_vector;
 
+					for(int k=1; k<=precision(); k++)
+					{
+						z_v_minus_z_0_over_minus_k_minus_1 /= z_v - z_0;
+						sum -= double(k) * M_node_ptr->get_multipole_exp()[k] *
+							z_v_minus_z_0_over_minus_k_minus_1;
+					}
+					force_vector.m_x = sum.real();
+					force_vector.m_y = (-1) * sum.imag();
+					F_multipole_exp[v] =  F_multipole_exp[v] + force_vector;
+
+				}
 			}
 		}
-	}
+	});
 }
 
 
 void NewMultipoleMethod::calculate_neighbourcell_forces(
 	NodeArray<NodeAttributes>& A,
-	List <QuadTreeNodeNM*>& quad_tree_leaves,
+	const Array<QuadTreeNodeNM*>& quad_tree_leaves,
 	NodeArray<DPoint>& F_direct)
 {
-	numexcept N;
-	List<node> act_contained_nodes,neighbour_contained_nodes,non_neighbour_contained_nodes;
-	List<QuadTreeNodeNM*> neighboured_leaves;
-	List<QuadTreeNodeNM*> non_neighboured_leaves;
-	double act_leaf_boxlength,neighbour_leaf_boxlength;
-	DPoint act_leaf_dlc,neighbour_leaf_dlc;
-	DPoint f_rep_u_on_v;
-	DPoint vector_v_minus_u;
-	DPoint nullpoint(0,0);
-	DPoint pos_u,pos_v;
-	double norm_v_minus_u,scalar;
-	int length;
-
-	for(QuadTreeNodeNM *act_leaf : quad_tree_leaves)
-	{//forall
-		act_leaf->get_contained_nodes(act_contained_nodes);
-
-		if(act_contained_nodes.size() <= particles_in_leaves())
-		{//if (usual case)
-
-			//Step1:calculate forces inside act_contained_nodes
-
-			length = act_contained_nodes.size();
-			Array<node> numbered_nodes (length+1);
-			int k = 1;
-			for(node v : act_contained_nodes)
-			{
-				numbered_nodes[k]= v;
-				k++;
-			}
+	//every thread sums up its forces in its own buffer; thread 0 writes to F_direct directly
+	const unsigned int threads = std::min(m_maxThreads, static_cast<unsigned int>(std::max(quad_tree_leaves.size(), 1)));
+	Array<NodeArray<DPoint>> F_thread(1, threads - 1);
+	for (unsigned int t = 1; t < threads; t++)
+		F_thread[t].init(*A.graphOf(), DPoint(0, 0));
+
+	parallelFor(threads, quad_tree_leaves.size(), [&](int begin, int end, unsigned int t) {
+		numexcept N;
+		List<node> act_contained_nodes,neighbour_contained_nodes,non_neighbour_contained_nodes;
+		List<QuadTreeNodeNM*> neighboured_leaves;
+		List<QuadTreeNodeNM*> non_neighboured_leaves;
+		double act_leaf_boxlength,neighbour_leaf_boxlength;
+		DPoint act_leaf_dlc,neighbour_leaf_dlc;
+		DPoint f_rep_u_on_v;
+		DPoint vector_v_minus_u;
+		DPoint nullpoint(0,0);
+		DPoint pos_u,pos_v;
+		double norm_v_minus_u,scalar;
+		int length;
+		NodeArray<DPoint> &F = (t == 0) ? F_direct : F_thread[t];
+
+		for(int i = begin; i < end; i++)
+		{//forall
+			const QuadTreeNodeNM *act_leaf = quad_tree_leaves[i];
+			act_leaf->get_contained_nodes(act_contained_nodes);
+
+			if(act_contained_nodes.size() <= particles_in_leaves())
+			{//if (usual case)
+
+				//Step1:calculate forces inside act_contained_nodes
+
+				length = act_contained_nodes.size();
+				Array<node> numbered_nodes (length+1);
+				int k = 1;
+				for(node v : act_contained_nodes)
+				{
+					numbered_nodes[k]= v;
+					k++;
+				}
 
-			for(k = 1; k<length; k++)
-			{
-				for(int l = k+1; l<=length; l++)
+				for(k = 1; k<length; k++)
 				{
-					node u = numbered_nodes[k];
-					node v = numbered_nodes[l];
-					pos_u = A[u].get_position();
-					pos_v = A[v].get_position();
-					if (pos_u == pos_v)
-					{//if2  (Exception handling if two nodes have the same position)
-						pos_u = N.choose_distinct_random_point_in_radius_epsilon(pos_u);
-					}//if2
-					vector_v_minus_u = pos_v - pos_u;
-					norm_v_minus_u = vector_v_minus_u.norm();
-					if(!N.f_rep_near_machine_precision(norm_v_minus_u,f_rep_u_on_v))
+					for(int l = k+1; l<=length; l++)
 					{
-						scalar = f_rep_scalar(norm_v_minus_u)/norm_v_minus_u ;
-						f_rep_u_on_v.m_x = scalar * vector_v_minus_u.m_x;
-						f_rep_u_on_v.m_y = scalar * vector_v_minus_u.m_y;
+						node u = numbered_nodes[k];
+						node v = numbered_nodes[l];
+						pos_u = A[u].get_position();
+						pos_v = A[v].get_position();
+						if (pos_u == pos_v)
+						{//if2  (Exception handling if two nodes have the same position)
+							pos_u = N.choose_distinct_random_point_in_radius_epsilon(pos_u);
+						}//if2
+						vector_v_minus_u = pos_v - pos_u;
+						norm_v_minus_u = vector_v_minus_u.norm();
+						if(!N.f_rep_near_machine_precision(norm_v_minus_u,f_rep_u_on_v))
+						{
+							scalar = f_rep_scalar(norm_v_minus_u)/norm_v_minus_u ;
+							f_rep_u_on_v.m_x = scalar * vector_v_minus_u.m_x;
+							f_rep_u_on_v.m_y = scalar * vector_v_minus_u.m_y;
+						}
+						F[v] = F[v] + f_rep_u_on_v;
+						F[u] = F[u] - f_rep_u_on_v;
 					}
-					F_direct[v] = F_direct[v] + f_rep_u_on_v;
-					F_direct[u] = F_direct[u] - f_rep_u_on_v;
 				}
-			}
 
-			//Step 2: calculated forces to nodes in act_contained_nodes() of
-			//leaf_ptr->get_D1()
+				//Step 2: calculated forces to nodes in act_contained_nodes() of
+				//leaf_ptr->get_D1()
 
-			act_leaf->get_D1(neighboured_leaves);
-			act_leaf_boxlength = act_leaf->get_Sm_boxlength();
-			act_leaf_dlc = act_leaf->get_Sm_downleftcorner();
+				act_leaf->get_D1(neighboured_leaves);
+				act_leaf_boxlength = act_leaf->get_Sm_boxlength();
+				act_leaf_dlc = act_leaf->get_Sm_downleftcorner();
 
-			for(const QuadTreeNodeNM *neighbour_leaf : neighboured_leaves)
-			{//forall2
-				//forget boxes that have already been looked at
+				for(const QuadTreeNodeNM *neighbour_leaf : neighboured_leaves)
+				{//forall2
+					//forget boxes that have already been looked at
 
-				neighbour_leaf_boxlength = neighbour_leaf->get_Sm_boxlength();
-				neighbour_leaf_dlc = neighbour_leaf->get_Sm_downleftcorner();
+					neighbour_leaf_boxlength = neighbour_leaf->get_Sm_boxlength();
+					neighbour_leaf_dlc = neighbour_leaf->get_Sm_downleftcorner();
 
-				if( (act_leaf_boxlength > neighbour_leaf_boxlength) ||
-					(act_leaf_boxlength == neighbour_leaf_boxlength &&
-					act_leaf_dlc.m_x < neighbour_leaf_dlc.m_x)
-					|| (act_leaf_boxlength == neighbour_leaf_boxlength &&
-					act_leaf_dlc.m_x ==  neighbour_leaf_dlc.m_x &&
-					act_leaf_dlc.m_y < neighbour_leaf_dlc.m_y) )
-				{//if
-					neighbour_leaf->get_contained_nodes(neighbour_contained_nodes);
+					if( (act_leaf_boxlength > neighbour_leaf_boxlength) ||
+						(act_leaf_boxlength == neighbour_leaf_boxlength &&
+						act_leaf_dlc.m_x < neighbour_leaf_dlc.m_x)
+						|| (act_leaf_boxlength == neighbour_leaf_boxlength &&
+						act_leaf_dlc.m_x ==  neighbour_leaf_dlc.m_x &&
+						act_leaf_dlc.m_y < neighbour_leaf_dlc.m_y) )
+					{//if
+						neighbour_leaf->get_contained_nodes(neighbour_contained_nodes);
 
-					for(node v : act_contained_nodes)
-					{
-						for(node u : neighbour_contained_nodes)
+						for(node v : act_contained_nodes)
 						{
+							for(node u : neighbour_contained_nodes)
+							{
+								pos_u = A[u].get_position();
+								pos_v = A[v].get_position();
+								if (pos_u == pos_v)
+								{//if2  (Exception handling if two nodes have the same position)
+									pos_u = N.choose_distinct_random_point_in_radius_epsilon(pos_u);
+								}//if2
+								vector_v_minus_u = pos_v - pos_u;
+								norm_v_minus_u = vector_v_minus_u.norm();
+								if(!N.f_rep_near_machine_precision(norm_v_minus_u,f_rep_u_on_v))
+								{
+									scalar = f_rep_scalar(norm_v_minus_u)/norm_v_minus_u ;
+									f_rep_u_on_v.m_x = scalar * vector_v_minus_u.m_x;
+									f_rep_u_on_v.m_y = scalar * vector_v_minus_u.m_y;
+								}
+								F[v] = F[v] + f_rep_u_on_v;
+								F[u] = F[u] - f_rep_u_on_v;
+							}
+						}
+					}//if
+				}//forall2
+
+				//Step 3: calculated forces to nodes in act_contained_nodes() of
+				//leaf_ptr->get_D2()
+
+				act_leaf->get_D2(non_neighboured_leaves);
+				for(const QuadTreeNodeNM *non_neighbour_leaf : non_neighboured_leaves)
+				{//forall3
+					non_neighbour_leaf->get_contained_nodes(non_neighbour_contained_nodes);
+					for(node v : act_contained_nodes)
+						for(node u : non_neighbour_contained_nodes)
+						{//for
 							pos_u = A[u].get_position();
 							pos_v = A[v].get_position();
 							if (pos_u == pos_v)
@@ -2644,59 +2708,43 @@ void NewMultipoleMethod::calculate_neighbourcell_forces(
 								f_rep_u_on_v.m_x = scalar * vector_v_minus_u.m_x;
 								f_rep_u_on_v.m_y = scalar * vector_v_minus_u.m_y;
 							}
-							F_direct[v] = F_direct[v] + f_rep_u_on_v;
-							F_direct[u] = F_direct[u] - f_rep_u_on_v;
-						}
-					}
-				}//if
-			}//forall2
-
-			//Step 3: calculated forces to nodes in act_contained_nodes() of
-			//leaf_ptr->get_D2()
-
-			act_leaf->get_D2(non_neighboured_leaves);
-			for(const QuadTreeNodeNM *non_neighbour_leaf : non_neighboured_leaves)
-			{//forall3
-				non_neighbour_leaf->get_contained_nodes(non_neighbour_contained_nodes);
+							F[v] = F[v] + f_rep_u_on_v;
+						}//for
+				}//forall3
+			}//if(usual case)
+			else //special case (more then particles_in_leaves() particles in this leaf)
+			{//else
 				for(node v : act_contained_nodes)
-					for(node u : non_neighbour_contained_nodes)
-					{//for
-						pos_u = A[u].get_position();
-						pos_v = A[v].get_position();
-						if (pos_u == pos_v)
-						{//if2  (Exception handling if two nodes have the same position)
-							pos_u = N.choose_distinct_random_point_in_radius_epsilon(pos_u);
-						}//if2
-						vector_v_minus_u = pos_v - pos_u;
-						norm_v_minus_u = vector_v_minus_u.norm();
-						if(!N.f_rep_near_machine_precision(norm_v_minus_u,f_rep_u_on_v))
-						{
-							scalar = f_rep_scalar(norm_v_minus_u)/norm_v_minus_u ;
-							f_rep_u_on_v.m_x = scalar * vector_v_minus_u.m_x;
-							f_rep_u_on_v.m_y = scalar * vector_v_minus_u.m_y;
-						}
-						F_direct[v] = F_direct[v] + f_rep_u_on_v;
-					}//for
-			}//forall3
-		}//if(usual case)
-		else //special case (more then particles_in_leaves() particles in this leaf)
-		{//else
-			for(node v : act_contained_nodes)
-			{
-				pos_v = A[v].get_position();
-				pos_u = N.choose_distinct_random_point_in_radius_epsilon(pos_v);
-				vector_v_minus_u = pos_v - pos_u;
-				norm_v_minus_u = vector_v_minus_u.norm();
-				if(!N.f_rep_near_machine_precision(norm_v_minus_u,f_rep_u_on_v))
 				{
-					scalar = f_rep_scalar(norm_v_minus_u)/norm_v_minus_u ;
-					f_rep_u_on_v.m_x = scalar * vector_v_minus_u.m_x;
-					f_rep_u_on_v.m_y = scalar * vector_v_minus_u.m_y;
+					pos_v = A[v].get_position();
+					pos_u = N.choose_distinct_random_point_in_radius_epsilon(pos_v);
+					vector_v_minus_u = pos_v - pos_u;
+					norm_v_minus_u = vector_v_minus_u.norm();
+					if(!N.f_rep_near_machine_precision(norm_v_minus_u,f_rep_u_on_v))
+					{
+						scalar = f_rep_scalar(norm_v_minus_u)/norm_v_minus_u ;
+						f_rep_u_on_v.m_x = scalar * vector_v_minus_u.m_x;
+						f_rep_u_on_v.m_y = scalar * vector_v_minus_u.m_y;
+					}
+					F[v] =  F[v] + f_rep_u_on_v;
+				}
+			}//else
+		}//forall
+	});
+
+	//every node is contained in exactly one leaf
+	if (threads > 1) {
+		parallelFor(threads, quad_tree_leaves.size(), [&](int begin, int end, unsigned int) {
+			List<node> contained_nodes;
+			for (int i = begin; i < end; i++) {
+				quad_tree_leaves[i]->get_contained_nodes(contained_nodes);
+				for (node v : contained_nodes) {
+					for (unsigned int t = 1; t < threads; t++)
+						F_direct[v] = F_direct[v] + F_thread[t][v];
 				}
-				F_direct[v] =  F_direct[v] + f_rep_u_on_v;
 			}
-		}//else
-	}//forall
+		});
+	}
 }
 
 
@@ -53,6 +53,7 @@ ModularMultilevelMixer::ModularMultilevelMixer()
 	m_coarseningRatio    = 1.0;
 	m_levelBound         = false;
 	m_randomize          = false;
+	m_retainHierarchy    = false;
 
 	// module options
 	setMultilevelBuilder(new SolarMerger);
@@ -74,6 +75,7 @@ void ModularMultilevelMixer::call(MultilevelGraph &MLG)
 	const Graph &G = MLG.getGraph();
 
 	m_errorCode = erc::None;
+	m_hierarchy.clear();
 	clock_t time = clock();
 	if ((!m_multilevelBuilder || !m_initialPlacement) && !m_oneLevelLayoutModule) {
 		OGDF_THROW(AlgorithmFailureException);
@@ -105,6 +107,9 @@ void ModularMultilevelMixer::call(MultilevelGraph &MLG)
 			m_errorCode = erc::LevelBound;
 			return;
 		}
+		if (m_retainHierarchy) {
+			addLevelsToHierarchy(MLG);
+		}
 		if (m_randomize)
 		{
 			for(node v : G.nodes) {
@@ -158,8 +163,62 @@ void ModularMultilevelMixer::call(MultilevelGraph &MLG)
 		}
 	}
 
+	if (m_retainHierarchy) {
+		if (m_hierarchy.empty()) {
+			m_hierarchy.init(G.maxNodeIndex() + 1);
+		}
+		NodeArray<int> index(G);
+		for (node v : G.nodes) {
+			index[v] = v->index();
+		}
+		m_hierarchy.aggregate(MLG.getGraphAttributes(), index);
+	}
+
 	time = clock() - time;
 }
 
 
+void ModularMultilevelMixer::addLevelsToHierarchy(MultilevelGraph &MLG)
+{
+	// merged nodes have been deleted, but node indices are kept until they are reinserted
+	const int n = MLG.getGraph().maxNodeIndex() + 1;
+	m_hierarchy.init(n);
+
+	// number on the current hierarchy level of each node index, -1 if merged
+	std::vector<int> current(n);
+	for (int i = 0; i < n; ++i) {
+		current[i] = i;
+	}
+
+	const std::vector<NodeMerge *> &merges = MLG.getMerges();
+	int level = 0;
+	for (auto it = merges.begin(); it != merges.end(); ++level) {
+		// the node each merged node of this level has been merged into
+		std::vector<int> mergedInto(n, -1);
+		for (int mergeLevel = (*it)->m_level; it != merges.end() && (*it)->m_level == mergeLevel; ++it) {
+			if (!(*it)->m_changedNodes.empty()) {
+				mergedInto[(*it)->m_mergedNode] = (*it)->m_changedNodes.front();
+			}
+		}
+
+		std::vector<int> next(n, -1);
+		for (int i = 0; i < n; ++i) {
+			if (current[i] >= 0 && mergedInto[i] < 0) {
+				next[i] = m_hierarchy.addNode(level + 1);
+			}
+		}
+		for (int i = 0; i < n; ++i) {
+			if (current[i] >= 0) {
+				int representative = i;
+				while (mergedInto[representative] >= 0) {
+					representative = mergedInto[representative];
+				}
+				m_hierarchy.setParent(level, current[i], next[representative]);
+			}
+		}
+		current.swap(next);
+	}
+}
+
+
 } // namespace ogdf
@@ -31,11 +31,28 @@
 
 
 #include <ogdf/basic/ArrayBuffer.h>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/external/Minisat.h>
 
+#include <functional>
+#include <memory>
+
 namespace Minisat
 {
 
+//! Converts signed variables (as used by Clause::add) to literals.
+static void toLits(const std::vector<Internal::Var> &signedVars, Internal::vec<Internal::Lit> &lits)
+{
+	lits.clear();
+	for (Internal::Var signedVar : signedVars) {
+		if (signedVar >= 0) {
+			lits.push(Internal::mkLit(signedVar-1, true));
+		} else {
+			lits.push(Internal::mkLit(-(signedVar+1), false));
+		}
+	}
+}
+
 void Clause::addMultiple(int Amount, ...)
 {
 	va_list params;
@@ -121,6 +138,119 @@ bool Formula::solve( Model &ReturnModel, double& timeLimit )
 }
 
 
+bool Formula::solve( Model &ReturnModel, const std::vector<Internal::Var> &assumps )
+{
+	Internal::vec<Internal::Lit> lits;
+	toLits(assumps, lits);
+
+	// variables only used in assumptions have to be known to the solver
+	for (int i = 0; i < lits.size(); ++i) {
+		while (Internal::var(lits[i]) >= Solver::nVars()) {
+			Solver::newVar();
+		}
+	}
+
+	bool solv = Solver::solve(lits);
+
+	if (solv)
+		ReturnModel.setModel(*this);
+
+	return solv;
+}
+
+
+bool Formula::solvePortfolio( Model &ReturnModel, int numberOfSolvers, const std::vector<Internal::Var> &assumps )
+{
+	if (numberOfSolvers <= 1) {
+		return solve(ReturnModel, assumps);
+	}
+
+	Internal::vec<Internal::Lit> lits;
+	toLits(assumps, lits);
+	for (int i = 0; i < lits.size(); ++i) {
+		while (Internal::var(lits[i]) >= Solver::nVars()) {
+			Solver::newVar();
+		}
+	}
+
+	if (!Solver::okay()) {
+		return false;
+	}
+
+	// copy the clause database (including learned clauses) into differently configured solvers
+	std::vector<std::unique_ptr<Internal::Solver>> portfolio;
+	for (int k = 1; k < numberOfSolvers; ++k) {
+		Internal::Solver *S = new Internal::Solver;
+		portfolio.emplace_back(S);
+
+		S->random_seed = 91648253 + 1000003 * k;
+		S->rnd_init_act = true;
+		S->rnd_pol = k % 2 == 0;
+		S->random_var_freq = 0.01 * (k % 4);
+		S->luby_restart = k % 3 != 2;
+		S->phase_saving = k % 3;
+		S->var_decay = k % 2 ? 0.9 : 0.99;
+
+		while (S->nVars() < Solver::nVars()) {
+			S->newVar();
+		}
+		for (int i = 0; i < Solver::trail.size(); ++i) {
+			S->addClause(Solver::trail[i]);
+		}
+		Internal::vec<Internal::Lit> ps;
+		for (const Internal::vec<Internal::CRef> *db : { &this->clauses, &this->learnts }) {
+			for (int i = 0; i < db->size(); ++i) {
+				const Internal::Clause &c = Solver::ca[(*db)[i]];
+				ps.clear();
+				for (int j = 0; j < c.size(); ++j) {
+					ps.push(c[j]);
+				}
+				S->addClause_(ps);
+			}
+		}
+	}
+
+	// race all solvers, the first result interrupts the others
+	using Internal::lbool;
+	std::atomic<int> winner(-1);
+	Internal::lbool result = l_Undef;
+
+	auto race = [&](int k) {
+		Internal::Solver &S = k == 0 ? *this : *portfolio[k-1];
+		Internal::lbool status = S.solveLimited(lits);
+		int none = -1;
+		if (status != l_Undef && winner.compare_exchange_strong(none, k)) {
+			result = status;
+			Solver::interrupt();
+			for (auto &other : portfolio) {
+				other->interrupt();
+			}
+		}
+	};
+
+	std::vector<std::function<void()>> tasks;
+	for (int k = 1; k < numberOfSolvers; ++k) {
+		tasks.emplace_back([&race, k] { race(k); });
+	}
+	std::vector<ogdf::Thread> threads;
+	for (auto &task : tasks) {
+		threads.emplace_back(task);
+	}
+	race(0);
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	Solver::clearInterrupt();
+
+	bool solv = result == l_True;
+
+	if (solv)
+		ReturnModel.setModel(winner == 0 ? *this : *portfolio[winner-1]);
+
+	return solv;
+}
+
+
 void Formula::removeClause(int i)
 {
 	Internal::CRef cr = Solver::clauses[i];
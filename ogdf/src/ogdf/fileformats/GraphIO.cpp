@@ -33,6 +33,7 @@
 #include <ogdf/basic/Logger.h>
 #include <ogdf/basic/AdjacencyOracle.h>
 #include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/basic/Tracer.h>
 #include <ogdf/fileformats/GraphIO.h>
 #include <ogdf/fileformats/GmlParser.h>
 #include <ogdf/fileformats/OgmlParser.h>
@@ -81,6 +82,7 @@ ostream &GraphIO::indent(ostream &os, int depth)
 
 bool GraphIO::read(Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::read");
 	for(auto &reader : readers) {
 		if(reader(G, is)) {
 			return true;
@@ -102,6 +104,7 @@ bool GraphIO::readGML(Graph &G, const string &filename)
 
 bool GraphIO::readGML(Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::readGML");
 	if(!is.good()) return false;
 	GmlParser parser(is);
 	return !parser.error() && parser.read(G);
@@ -673,6 +676,7 @@ bool GraphIO::readGML(ClusterGraph &C, Graph &G, const string &filename)
 
 bool GraphIO::readGML(ClusterGraph &C, Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::readGML");
 	if(!is.good()) return false;
 
 	GmlParser gml(is);
@@ -714,6 +718,7 @@ bool GraphIO::readGML(GraphAttributes &A, Graph &G, const string &filename)
 
 bool GraphIO::readGML(GraphAttributes &A, Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::readGML");
 	if (!is.good()) return false;
 	GmlParser parser(is);
 	if (parser.error()) return false;
@@ -831,6 +836,7 @@ bool GraphIO::readGML(ClusterGraphAttributes &A, ClusterGraph &C, Graph &G, cons
 
 bool GraphIO::readGML(ClusterGraphAttributes &A, ClusterGraph &C, Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::readGML");
 	if(!is.good()) return false;
 
 	GmlParser gml(is);
@@ -1202,12 +1208,14 @@ bool GraphIO::drawSVG(const ClusterGraphAttributes &A, const string &filename, c
 
 bool GraphIO::drawSVG(const GraphAttributes &attr, ostream &os, const SVGSettings &settings)
 {
+	OGDF_TRACE_SCOPE("GraphIO::drawSVG");
 	SvgPrinter printer(attr, settings);
 	return printer.draw(os);
 }
 
 bool GraphIO::drawSVG(const ClusterGraphAttributes &attr, ostream &os, const SVGSettings &settings)
 {
+	OGDF_TRACE_SCOPE("GraphIO::drawSVG");
 	SvgPrinter printer(attr, settings);
 	return printer.draw(os);
 }
@@ -1220,6 +1228,7 @@ bool GraphIO::readGraphML(Graph &G, const string &filename)
 
 bool GraphIO::readGraphML(Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::readGraphML");
 	if(!is.good()) {
 		return false;
 	}
@@ -1241,6 +1250,7 @@ bool GraphIO::readGraphML(ClusterGraph &C, Graph &G, const string &filename)
 
 bool GraphIO::readGraphML(ClusterGraph &C, Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::readGraphML");
 	if(!is.good()) {
 		return false;
 	}
@@ -1262,6 +1272,7 @@ bool GraphIO::readGraphML(GraphAttributes &A, Graph &G, const string &filename)
 
 bool GraphIO::readGraphML(GraphAttributes &A, Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::readGraphML");
 	if(!is.good()) {
 		return false;
 	}
@@ -1283,6 +1294,7 @@ bool GraphIO::readGraphML(ClusterGraphAttributes &A, ClusterGraph &C, Graph &G,
 
 bool GraphIO::readGraphML(ClusterGraphAttributes &A, ClusterGraph &C, Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::readGraphML");
 	GraphMLParser parser(is);
 	return parser.read(G, C, A);
 }
@@ -1301,6 +1313,7 @@ bool GraphIO::readDOT(Graph &G, const string &filename)
 
 bool GraphIO::readDOT(Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::readDOT");
 	if(!is.good()) {
 		return false;
 	}
@@ -1322,6 +1335,7 @@ bool GraphIO::readDOT(ClusterGraph &C, Graph &G, const string &filename)
 
 bool GraphIO::readDOT(ClusterGraph &C, Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::readDOT");
 	if(!is.good()) {
 		return false;
 	}
@@ -1343,6 +1357,7 @@ bool GraphIO::readDOT(GraphAttributes &A, Graph &G, const string &filename)
 
 bool GraphIO::readDOT(GraphAttributes &A, Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::readDOT");
 	if(!is.good()) {
 		return false;
 	}
@@ -1364,6 +1379,7 @@ bool GraphIO::readDOT(ClusterGraphAttributes &A, ClusterGraph &C, Graph &G, cons
 
 bool GraphIO::readDOT(ClusterGraphAttributes &A, ClusterGraph &C, Graph &G, istream &is)
 {
+	OGDF_TRACE_SCOPE("GraphIO::readDOT");
 	if(!is.good()) {
 		return false;
 	}
@@ -31,6 +31,7 @@
  */
 
 #include <ogdf/layered/FastHierarchyLayout.h>
+#include <ogdf/basic/ParallelFor.h>
 
 namespace ogdf {
 
@@ -51,88 +52,90 @@ class withKey
 public:
 	int element;
 	double key;
-
-	withKey &operator=(const withKey& wk) {
-		element=wk.element;
-		key=wk.key;
-		return *this;
-	}
-	friend ostream& operator<<(ostream& out,const withKey& wk) {
-		out<<wk.element<<"("<<wk.key<<")";
-		return out;
-	}
-	friend istream& operator>>(istream& in,withKey& wk) {
-		in>>wk.element>>wk.key;
-		return in;
-	}
-};
-
-
-class cmpWithKey {
-public:
-	static int compare(const withKey &wk1, const withKey &wk2) {
-		if(wk1.key<wk2.key) return -1;
-		if(wk1.key>wk2.key) return 1;
-		return 0;
-	}
-	OGDF_AUGMENT_STATICCOMPARER(withKey)
 };
 
 
 /**
- * \brief Class kList extends the class List by functions needed in the FastHierarchLayout algorithm.
+ * \brief Class kList is a list of withKey elements with the functions needed
+ * in the FastHierarchLayout algorithm.
  *
- * Especially, it computes the median of a list and reduces it.
+ * Especially, it computes the median of a list and reduces it. The elements
+ * are stored in an array; pop() removes the first element.
  */
-class kList : public List<withKey> {
+class kList {
+	ArrayBuffer<withKey> m_list;
+	int m_head = 0; //!< index of the first element
+
 public:
+	bool empty() const {
+		return m_head == m_list.size();
+	}
+
+	int size() const {
+		return m_list.size() - m_head;
+	}
+
+	void clear() {
+		m_list.clear();
+		m_head = 0;
+	}
+
 	bool pop(int& e,double& k) {
 		if(empty()) return 0;
-		withKey wk=popFrontRet();
+		const withKey &wk = m_list[m_head++];
 		e=wk.element;
 		k=wk.key;
 		return 1;
 	}
 
-	double peek() {
-		return front().key;
+	double peek() const {
+		return m_list[m_head].key;
 	}
 
 	void add(int e,double k) {
 		withKey wK;
 		wK.element=e;
 		wK.key=k;
-		pushBack(wK);
+		m_list.push(wK);
 	}
 
 	double median() const {
 		int sz = size();
 		if(sz == 0)
 			return 0;
-		ListConstIterator<withKey> it = get(sz/2);
-		double k = (*it).key;
+		double k = m_list[m_head + sz/2].key;
 		if (sz == 2*(int) (sz/2))
-			k = (k + (*it.pred()).key) / 2;
+			k = (k + m_list[m_head + sz/2 - 1].key) / 2;
 		return k;
 	}
 
+	//! Sorts the list by key.
+	void sort() {
+		std::sort(m_list.begin() + m_head, m_list.end(),
+			[](const withKey &wk1, const withKey &wk2) { return wk1.key < wk2.key; });
+	}
+
+	void reverse() {
+		std::reverse(m_list.begin() + m_head, m_list.end());
+	}
 
 	//! Scans the list for pairs of elements with the same double key.
 	/**
 	 * Replaces them by one element. If integer key is 0, it removes element from list.
+	 * The list is empty afterwards.
 	 * \pre List must be sorted by key (in any direction)
 	 */
 	void reduce(kList& newList) {
 		if (empty()) return;
 		withKey oldWK,newWK;
-		newWK = oldWK = popFrontRet();
+		newWK = oldWK = m_list[m_head++];
 
 		while (!empty()) {
-			oldWK = popFrontRet();
+			oldWK = m_list[m_head++];
 			if (oldWK.key > newWK.key + ALLOW ||
 			    oldWK.key < newWK.key - ALLOW) {
 				if (newWK.element) {
-					newList.pushBack(newWK);
+					newList.m_list.push(newWK);
 				}
 				newWK = oldWK;
 			} else {
@@ -140,8 +143,9 @@ public:
 			}
 		}
 		if (newWK.element) {
-			newList.pushBack(newWK);
+			newList.m_list.push(newWK);
 		}
+		clear();
 	}
 };
 
@@ -154,6 +158,7 @@ FastHierarchyLayout::FastHierarchyLayout()
 	m_minNodeDist    = LayoutStandards::defaultNodeSeparation();
 	m_minLayerDist   = 1.5 * LayoutStandards::defaultNodeSeparation();
 	m_fixedLayerDist = false;
+	m_maxThreads     = 1;
 }
 
 
@@ -162,6 +167,7 @@ FastHierarchyLayout::FastHierarchyLayout(const FastHierarchyLayout &fhl)
 	m_minNodeDist    = fhl.m_minNodeDist;
 	m_minLayerDist   = fhl.m_minLayerDist;
 	m_fixedLayerDist = fhl.m_fixedLayerDist;
+	m_maxThreads     = fhl.m_maxThreads;
 }
 
 
@@ -170,6 +176,7 @@ FastHierarchyLayout &FastHierarchyLayout::operator=(const FastHierarchyLayout &f
 	m_minNodeDist    = fhl.m_minNodeDist;
 	m_minLayerDist   = fhl.m_minLayerDist;
 	m_fixedLayerDist = fhl.m_fixedLayerDist;
+	m_maxThreads     = fhl.m_maxThreads;
 
 	return *this;
 }
@@ -183,27 +190,28 @@ void FastHierarchyLayout::doCall(const HierarchyLevelsBase &levels,
 
 	int actLayer = 0;
 	int actNode = 0;
-	List<int> *newEdge;
 
 	// initialize class variables
 
 	n		= GC.numberOfNodes();
 	m		= GC.numberOfEdges();
 	k		= levels.size();
-	x		= new double[n];
-	breadth		= new double[n];
-	layer		= new int[n];
-	adj[0]		= new List<int>[n];
-	adj[1]		= new List<int>[n];
-	virt		= new bool[n];
-	longEdge	= new List<int>*[n];
-	height		= new double[k];
-	y			= new double[k];
-	first		= new int[k+1];
+	m_numberOfThreads = numberOfThreadsFor(m_maxThreads, n, 4096);
+	x		.init(n);
+	breadth		.init(n);
+	layer		.init(n);
+	virt		.init(n);
+	longEdge	.init(n);
+	height		.init(k);
+	y			.init(k);
+	first		.init(k+1);
+	chain.clear();
+	chainBegin.clear();
+	chainEnd.clear();
 
 	// CG
 	forallnodes {
-		longEdge[actNode] = nullptr;
+		longEdge[actNode] = -1;
 	}
 
 	// Compute first.
@@ -213,19 +221,42 @@ void FastHierarchyLayout::doCall(const HierarchyLevelsBase &levels,
 		height[actLayer] = 0;
 	}
 
+	// Number nodes top down and from left to right
+	NodeArray<int> number(GC);
+	Array<node> original(n);
+	foralllayers {
+		const LevelBase &level = levels[actLayer];
+		forallnodesonlayer {
+			node v1 = level[actNode - first[actLayer]];
+			number[v1] = actNode;
+			original[actNode] = v1;
+		}
+	}
+
 	// Compute
-	//    breadth, height, virt, longEdge for nonvirtual nodes
-	for(node v1 : GC.nodes) {
-		int n1 = first[H.rank(v1)] + levels.pos(v1); // Number nodes top down and from left to right
-		virt[n1] = H.isLongEdgeDummy(v1);
-		breadth[n1] = 0;
-		layer[n1] = H.rank(v1);
-		if(!virt[n1]) {
-			breadth[n1] = AGC.getWidth(v1);
-			incrTo(height[layer[n1]],AGC.getHeight(v1));
-			newEdge = new List<int>;
-			newEdge->pushBack(n1);
-			longEdge[n1] = newEdge;
+	//    breadth, height, virt, layer
+	parallelFor(m_numberOfThreads, k, [&](int begin, int end, unsigned int) {
+		for (int l = begin; l < end; ++l) {
+			for (int n1 = first[l]; n1 < first[l+1]; ++n1) {
+				node v1 = original[n1];
+				virt[n1] = H.isLongEdgeDummy(v1);
+				breadth[n1] = 0;
+				layer[n1] = l;
+				if(!virt[n1]) {
+					breadth[n1] = AGC.getWidth(v1);
+					incrTo(height[l],AGC.getHeight(v1));
+				}
+			}
+		}
+	});
+
+	// compute longEdge for nonvirtual nodes
+	forallnodes {
+		if(!virt[actNode]) {
+			longEdge[actNode] = chainBegin.size();
+			chainBegin.push(chain.size());
+			chain.push(actNode);
+			chainEnd.push(chain.size());
 		}
 	}
 
@@ -236,43 +267,59 @@ void FastHierarchyLayout::doCall(const HierarchyLevelsBase &levels,
 		//if(GC.chain(e1).size() > 1) {
 		if(e1 && GC.chain(e1).size() > 1 && e == GC.chain(e1).front())
 		{
-			newEdge = new List<int>;
-			for (edge e2 : GC.chain(e1)) {
-				node v1 = e2->target();
-				int n1 = first[H.rank(v1)] + levels.pos(v1); // Number nodes top down and from left to right
-				newEdge->pushBack(n1);
+			// last node is nonvirtual and is not part of the long edge.
+			const List<edge> &edges = GC.chain(e1);
+			int begin = chain.size();
+			for (ListConstIterator<edge> it = edges.begin(); it != edges.rbegin(); ++it) {
+				chain.push(number[(*it)->target()]);
 			}
-			newEdge->popBack(); // last node is nonvirtual and must be removed from list.
 
 			// CG: avoid assigning a redirected edge to a dummy node twice
-			if(newEdge->size() == 1 && longEdge[newEdge->front()] != nullptr) {
-				delete newEdge;
+			if(chain.size() - begin == 1 && longEdge[chain[begin]] != -1) {
+				chain.pop();
 
 			} else {
-				// for every node in the the list, assign the longEdge (stored in
-				// newEdge) to the node.
-				for (int n1 : *newEdge) {
-					longEdge[n1] = newEdge;
+				// for every node in the the list, assign the longEdge to the node.
+				int e2 = chainBegin.size();
+				chainBegin.push(begin);
+				chainEnd.push(chain.size());
+				for (int c = begin; c < chain.size(); c++) {
+					longEdge[chain[c]] = e2;
 				}
 			}
 		}
 	}
 
-	// Compute adjacencylists adj[0] and adj[1] for every node.
+	// Compute adjacencylists adj[0] and adj[1] for every node. Since sources
+	// (targets) are scanned in internal order, the lists are sorted according
+	// to the internal numbering.
+	for (int d = 0; d < 2; d++) {
+		adjStart[d].init(0, n, 0);
+		adj[d].init(m);
+	}
 	for(edge e1 : GC.edges) {
-		node v1 = e1->source();
-		node v2 = e1->target();
-		int n1 = first[H.rank(v1)] + levels.pos(v1);
-		int n2 = first[H.rank(v2)] + levels.pos(v2);
-		adj[0][n2].pushBack(n1);
-		adj[1][n1].pushBack(n2);
+		adjStart[0][number[e1->target()] + 1]++;
+		adjStart[1][number[e1->source()] + 1]++;
 	}
-
-	// Sort the adjacencylists adj[0] and adj[1] for every node according to
-	// the internal numbering.
-	forallnodes {
-		adj[0][actNode].quicksort();
-		adj[1][actNode].quicksort();
+	for (int d = 0; d < 2; d++) {
+		for (int n1 = 0; n1 < n; n1++) {
+			adjStart[d][n1+1] += adjStart[d][n1];
+		}
+	}
+	{
+		Array<int> next[2] = {adjStart[0], adjStart[1]};
+		forallnodes {
+			for(adjEntry adj1 : original[actNode]->adjEntries) {
+				edge e1 = adj1->theEdge();
+				if (e1->source() == adj1->theNode()) {
+					int n2 = number[e1->target()];
+					adj[0][next[0][n2]++] = actNode;
+				} else {
+					int n1 = number[e1->source()];
+					adj[1][next[1][n1]++] = actNode;
+				}
+			}
+		}
 	}
 
 
@@ -280,47 +327,46 @@ void FastHierarchyLayout::doCall(const HierarchyLevelsBase &levels,
 	findPlacement();
 
 	// Copy coordinates into AGC
-	for(node v1 : GC.nodes) {
-		int n1 = first[H.rank(v1)] + levels.pos(v1);
-		AGC.x(v1) = x[n1];
-		if(GC.isDummy(v1) && !H.isLongEdgeDummy(v1))
-			AGC.y(v1) = 0.5*(y[layer[n1]-1]+y[layer[n1]]);
-		else
-			AGC.y(v1) = y[layer[n1]];
-	}
+	parallelFor(m_numberOfThreads, n, [&](int begin, int end, unsigned int) {
+		for (int n1 = begin; n1 < end; n1++) {
+			node v1 = original[n1];
+			AGC.x(v1) = x[n1];
+			if(GC.isDummy(v1) && !H.isLongEdgeDummy(v1))
+				AGC.y(v1) = 0.5*(y[layer[n1]-1]+y[layer[n1]]);
+			else
+				AGC.y(v1) = y[layer[n1]];
+		}
+	});
 
 	// Cleanup
-
-	List<int> *toDelete;
-	forallnodes {
-		if(longEdge[actNode] != nullptr) {
-			toDelete = longEdge[actNode];
-			for (int n1 : *toDelete) {
-				longEdge[n1] = nullptr;
-			}
-			delete toDelete;
-		}
+	for (int d = 0; d < 2; d++) {
+		adjStart[d].init();
+		adj[d].init();
 	}
-	delete[] y;
-	delete[] first;
-	delete[] height;
-	delete[] x;
-	delete[] breadth;
-	delete[] layer;
-	delete[] adj[0];
-	delete[] adj[1];
-	delete[] virt;
-	delete[] longEdge;
+	chain.clear();
+	chain.init();
+	chainBegin.clear();
+	chainBegin.init();
+	chainEnd.clear();
+	chainEnd.init();
+	longEdge.init();
+	y.init();
+	first.init();
+	height.init();
+	x.init();
+	breadth.init();
+	layer.init();
+	virt.init();
 }
 
 
 void FastHierarchyLayout::sortLongEdges(int actNode,
 	int dir,
-	double *pos,
+	Array<double> &pos,
 	bool& exD,
 	double &dist,
-	int *block,
-	bool *marked)
+	const Array<int> &block,
+	Array<bool> &marked) const
 {
 	if(marked[actNode])
 		// if node was already placed.
@@ -328,18 +374,21 @@ void FastHierarchyLayout::sortLongEdges(int actNode,
 
 	bool exB=0;
 	double best=0;
+	const int begin = chainBegin[longEdge[actNode]];
+	const int end = chainEnd[longEdge[actNode]];
 
 	// Mark the long edge. Thus all virtual nodes on the long edge will be
 	// regarded as placed.
-	for (int next : *longEdge[actNode]) {
-		marked[next] = 1;
+	for (int c = begin; c < end; c++) {
+		marked[chain[c]] = 1;
 	}
 
 	// Traverse the long Edge.
 	// If for a virtual node there exists a left direct sibling w and w belongs
 	// to the same block then call sortLongEdges recursively for w. Store
 	// leftmost (rightmost) position in best.
-	for (int next : *longEdge[actNode]) {
+	for (int c = begin; c < end; c++) {
+		int next = chain[c];
 		if( sameLayer(next - dir, next) && block[next - dir] == block[next]) {
 			sortLongEdges(next - dir, dir, pos, exD, dist, block, marked);
 			if(!exB ||
@@ -354,7 +403,8 @@ void FastHierarchyLayout::sortLongEdges(int actNode,
 	// Traverse long edge
 	// Set postion of every virtual node on edge to best. Test for every node
 	// if the direct left (right) sibling belongs to a different block.
-	for (int next : *longEdge[actNode]) {
+	for (int c = begin; c < end; c++) {
+		int next = chain[c];
 		pos[next]=best;
 		if( sameLayer(next + dir,next) &&
 			block[next + dir] != block[next] &&
@@ -370,20 +420,116 @@ void FastHierarchyLayout::sortLongEdges(int actNode,
 }
 
 
+void FastHierarchyLayout::placeLongEdges(int dir, Array<double> &pos) const
+{
+	int actNode,actLayer;
+	bool exD;
+	double dist;
+	Array<int> block(n);
+	Array<bool> marked(n);
+	kList neighbours;
+
+	pos.init(n);
+
+	// Partition the graph into blocks according to the technical report.
+	int blockCount = 0;
+	forallnodes
+		block[actNode] = marked[actNode] = 0;
+	foralllayers {
+		actNode = (dir == 1 ? first[actLayer] : first[actLayer+1] - 1);
+		if(!block[actNode]) {
+			for (int c = chainBegin[longEdge[actNode]]; c < chainEnd[longEdge[actNode]]; c++) {
+				block[chain[c]] = blockCount;
+			}
+			blockCount++;
+		}
+		actNode += dir;
+		while(actNode >= first[actLayer] && actNode < first[actLayer+1]) {
+			if(!block[actNode]) {
+				for (int c = chainBegin[longEdge[actNode]]; c < chainEnd[longEdge[actNode]]; c++) {
+					block[chain[c]] = block[actNode-dir];
+				}
+			}
+			actNode += dir;
+		}
+	}
+
+	// Store the nodes of every block consecutively: the nodes of block i
+	// are blockNodes[blockStart[i]], ..., blockNodes[blockStart[i+1]-1].
+	Array<int> blockStart(blockCount + 1);
+	Array<int> blockNodes(n);
+	blockStart.fill(0);
+	forallnodes
+		blockStart[block[actNode] + 1]++;
+	for(int i = 0; i < blockCount; i++)
+		blockStart[i+1] += blockStart[i];
+	{
+		Array<int> next(blockStart);
+		foralllayers {
+			for(actNode = ( (dir == 1) ? first[actLayer] : (first[actLayer+1]-1) );
+				actNode >= first[actLayer] && actNode < first[actLayer+1];
+				actNode += dir)
+			{
+				blockNodes[next[block[actNode]]++] = actNode;
+			}
+		}
+	}
+
+	for(int i = 0; i < blockCount;i++) {
+		// for every block
+		if(blockStart[i] == blockStart[i+1])
+			continue;
+		exD = 0;
+		dist = 0;
+		for (int j = blockStart[i]; j < blockStart[i+1]; j++) {
+			// for every node of the block apply sortLongEdges
+			sortLongEdges(blockNodes[j],dir,pos,exD,dist,block,marked);
+		}
+		if(!exD) {
+			// The currently examined block does not share its layers with
+			// another block that has been placed before. Thus the block
+			// can be freely moved. We compute a position for the block by
+			// minimizing the total edge length to neighbours of blocks
+			// that have already been placed. dist has not been computed by
+			// sortLongEdges and is now set to the optimal value.
+			actLayer = layer[blockNodes[blockStart[i]]];
+			forallnodesonlayer {
+				for (int a = adjStart[0][actNode]; a < adjStart[0][actNode+1]; a++) {
+					neighbours.add(0,pos[adj[0][a]] - pos[actNode]);
+				}
+			}
+			if(!neighbours.empty()) {
+				neighbours.sort();
+				dist =- dir*neighbours.median();
+				neighbours.clear();
+			}
+		}
+		// If exD is true, dist has been computed by sortLongEdges.
+
+		// Move the nodes of the block to their positions.
+		for (int j = blockStart[i]; j < blockStart[i+1]; j++) {
+			pos[blockNodes[j]] -= dir * dist;
+		}
+	}
+}
+
+
 bool FastHierarchyLayout::placeSingleNode(int leftBnd,
 	int rightBnd,
 	int actNode,
 	double& best,
-	int d)
+	int d) const
 {
-	kList neighbours;
-
-	for (int next : adj[d][actNode]) {
-		neighbours.add(0,x[next]);
-	}
-	if(neighbours.empty())
+	int sz = degree(d,actNode);
+	if(sz == 0)
 		return 0;
-	best = neighbours.median();
+
+	// median of the neighbours
+	const int *neighbours = &adj[d][adjStart[d][actNode]];
+	double median = x[neighbours[sz/2]];
+	if (sz == 2*(int) (sz/2))
+		median = (median + x[neighbours[sz/2 - 1]]) / 2;
+	best = median;
 
 	// if median outside boundaries, get free position as close as possible
 	// to boundary.
@@ -456,7 +602,8 @@ void FastHierarchyLayout::placeNodes(int leftBnd,
 			res[i]=0;
 			for(actNode = mdl[i];actNode >= left && actNode <= right;actNode +=dir) {
 				resChange = 0;
-				for (int next : adj[d][actNode]) {
+				for (int j = adjStart[d][actNode]; j < adjStart[d][actNode+1]; j++) {
+					int next = adj[d][j];
 					if(dir*(x[next] - x[actNode]) < ALLOW)
 						resChange++;
 					else {
@@ -485,8 +632,7 @@ void FastHierarchyLayout::placeNodes(int leftBnd,
 			}
 			if(bnd[i] != -1)
 				bds.add(m,x[bnd[i]] - mDist[bnd[i]] + mDist[mdl[i]]);
-			cmpWithKey cmp;
-			bds.quicksort(cmp);
+			bds.sort();
 			bds.reduce(bends[i]);
 		}
 		if(!bends[0].empty())
@@ -547,52 +693,55 @@ void FastHierarchyLayout::placeNodes(int leftBnd,
 
 void FastHierarchyLayout::moveLongEdge(int actNode,
 	int dir,
-	bool *marked)
+	Array<bool> &marked)
 {
 	if (!marked[actNode] && virt[actNode]) {
 		// if actNode belongs to a long edge and has not been moved yet.
+		const int begin = chainBegin[longEdge[actNode]];
+		const int end = chainEnd[longEdge[actNode]];
+
 		// mark all virtual nodes of the long edge
-		for (int next : *longEdge[actNode]) {
-			marked[next] = 1;
+		for (int c = begin; c < end; c++) {
+			marked[chain[c]] = 1;
 		}
 
 		// first non virtual node of long edge
-		int fst = adj[0][longEdge[actNode]->front()].front();
+		int fst = firstAdj(0, chain[begin]);
 
 		// second non virtual node of long edge
-		int lst = adj[1][longEdge[actNode]->back()].front();
+		int lst = firstAdj(1, chain[end - 1]);
 
 		// Contains an order of the two positions of the nonvirtual nodes of
 		// the long edge. The function moveLongEdge first tries to place the
 		// long edge onto the first position If not successful, moveLongEdge
 		// tries to place the long edge onto the second position
-		List<double> toTest;
+		double toTest[2];
 
 		if (dir < 0) {
-			toTest.pushBack(x[fst] < x[lst] ? x[fst] : x[lst]);
-			toTest.pushBack(x[fst] < x[lst] ? x[lst] : x[fst]);
+			toTest[0] = x[fst] < x[lst] ? x[fst] : x[lst];
+			toTest[1] = x[fst] < x[lst] ? x[lst] : x[fst];
 		}
 		else if (dir > 0) {
-			toTest.pushBack(x[fst] < x[lst] ? x[lst] : x[fst]);
-			toTest.pushBack(x[fst] < x[lst] ? x[fst] : x[lst]);
+			toTest[0] = x[fst] < x[lst] ? x[lst] : x[fst];
+			toTest[1] = x[fst] < x[lst] ? x[fst] : x[lst];
 		}
 		else {
-			toTest.pushBack(x[fst]);
-			toTest.pushBack(x[lst]);
+			toTest[0] = x[fst];
+			toTest[1] = x[lst];
 		}
 		double xFirst; // stores the first and most preferred position
-		xFirst = toTest.front();
+		xFirst = toTest[0];
 
-		double xOpt;  // stores the preferred position
+		double xOpt = 0;  // stores the preferred position
 
 		bool done = false;
-		while (!done && !toTest.empty()) {
-			xOpt = toTest.front(); // Best position that can be reached by moving
+		for (int t = 0; !done && t < 2; t++) {
+			xOpt = toTest[t]; // Best position that can be reached by moving
 			// the long edge
-			toTest.popFront();
 			done = 1;
-			for (int next : *longEdge[actNode]) {
+			for (int c = begin; c < end; c++) {
 				// for all virtual nodes on the long edge
+				int next = chain[c];
 
 				// Try moving to the left
 				if (!isFirst(next)) {
@@ -626,31 +775,32 @@ void FastHierarchyLayout::moveLongEdge(int actNode,
 			// the  two positions of the nonvirtual nodes. It now tries to
 			// approximate the most preferred position.
 			xOpt = xFirst;
-			for (int next : *longEdge[actNode]) {
+			for (int c = begin; c < end; c++) {
+				int next = chain[c];
 				if (!isFirst(next))
 					incrTo(xOpt, x[next - 1] + totalB[next] - totalB[next - 1]);
 				if (!isLast(next))
 					decrTo(xOpt, x[next + 1] + totalB[next] - totalB[next + 1]);
 			}
 		}
-		for (int next : *longEdge[actNode]) {
-			x[next] = xOpt;
+		for (int c = begin; c < end; c++) {
+			x[chain[c]] = xOpt;
 		}
 	}
 }
 
 
-void FastHierarchyLayout::straightenEdge(int actNode,bool *marked)
+void FastHierarchyLayout::straightenEdge(int actNode,Array<bool> &marked)
 {
 	if(!marked[actNode] && // breadth[actNode] < ALLOW &&
-		adj[0][actNode].size() == 1 &&
-		adj[1][actNode].size() == 1 &&
-		longEdge[actNode]->size() < 2)
+		degree(0,actNode) == 1 &&
+		degree(1,actNode) == 1 &&
+		longEdgeSize(actNode) < 2)
 	{
 		marked[actNode]=1;
 
-		int fst=adj[0][actNode].front();
-		int lst=adj[1][actNode].front();
+		int fst=firstAdj(0,actNode);
+		int lst=firstAdj(1,actNode);
 
 		// Get optimal position for actNode
 		double xOpt=x[fst] + (x[lst] - x[fst]) *
@@ -684,40 +834,40 @@ void FastHierarchyLayout::straightenEdge(int actNode,bool *marked)
 void FastHierarchyLayout::findPlacement()
 {
 	int actNode,actLayer,dir,leftBnd,leftNxt,rightNxt;
-	bool *marked=new bool[n];
-	//ListConstIterator<int> _it = 0;
+	Array<bool> marked(n);
 
 	// Replace all virtual nodes in an edge traversing only one layer by a
 	// nonvirtual node.
 	forallnodes if(virt[actNode] &&
-		!virt[adj[0][actNode].front()] &&
-		!virt[adj[1][actNode].front()])
+		!virt[firstAdj(0,actNode)] &&
+		!virt[firstAdj(1,actNode)])
 		virt[actNode] = 0;
 
 	// Compute minimal distances between nodes (totalB)
 
-	totalB = new double[n];
-	double toAdd;
-	forallnodes {
-		if (!actNode ||
-			layer[actNode-1] < layer[actNode])
-			totalB[actNode]=0;
-		else {
-			toAdd = breadth[actNode-1] / 2 + breadth[actNode] / 2;
-			// Enlarge the minimal Distance for nodes with a lot of neighbours.
-			incrTo(toAdd,m_minNodeDist / 3 * (double)(adj[0][actNode-1].size() + adj[0][actNode].size()));
-			incrTo(toAdd,m_minNodeDist / 3 * (double)(adj[1][actNode-1].size() + adj[1][actNode].size()));
-			// distances are computed such that they are placed on a grid based on minNodeDist.
-			toAdd = m_minNodeDist *(int)(toAdd/m_minNodeDist + 1 - ALLOW);
-			toAdd += m_minNodeDist;
-			totalB[actNode] = totalB[actNode-1] + toAdd;
+	totalB.init(n);
+	parallelFor(m_numberOfThreads, k, [&](int begin, int end, unsigned int) {
+		for (int l = begin; l < end; l++) {
+			for (int v = first[l]; v < first[l+1]; v++) {
+				if (v == first[l])
+					totalB[v]=0;
+				else {
+					double toAdd = breadth[v-1] / 2 + breadth[v] / 2;
+					// Enlarge the minimal Distance for nodes with a lot of neighbours.
+					incrTo(toAdd,m_minNodeDist / 3 * (double)(degree(0,v-1) + degree(0,v)));
+					incrTo(toAdd,m_minNodeDist / 3 * (double)(degree(1,v-1) + degree(1,v)));
+					// distances are computed such that they are placed on a grid based on minNodeDist.
+					toAdd = m_minNodeDist *(int)(toAdd/m_minNodeDist + 1 - ALLOW);
+					toAdd += m_minNodeDist;
+					totalB[v] = totalB[v-1] + toAdd;
+				}
+			}
 		}
-	}
+	});
 
 	// Remove crossings of long edges
 	// Applied for long edges that cross each other in inner segments.
 
-	List<int> *newEdge,*oldEdge;
 	int down,spl;
 
 
@@ -725,22 +875,25 @@ void FastHierarchyLayout::findPlacement()
 	// segments between the two layers according to the order of virtual nodes
 	// on layer l. We consider consecutive pairs of inner edges segments
 	// from left to right.  If two inner edge segments cross, we split the
-	// right long edge between the two layers by parting the corresponding list
-	// into two sublists.
+	// right long edge between the two layers by moving its upper part
+	// into a new long edge.
 	foralllayers {
 		int last=-1;
 		forallnodesonlayer {
 			if(virt[actNode]) {
-				down=adj[1][actNode].front();
+				down=firstAdj(1,actNode);
 				if(virt[down]) {
 					if(last!=-1&&last>down) {
-						oldEdge = longEdge[actNode];
-						spl = actLayer - layer[oldEdge->front()] + 1;
-						newEdge = new List<int>;
-						oldEdge->split(oldEdge->get(spl),(*newEdge),
-							(*oldEdge));
-						for (int next : *newEdge) {
-							longEdge[next] = newEdge;
+						int oldEdge = longEdge[actNode];
+						spl = chainBegin[oldEdge] + actLayer - layer[chain[chainBegin[oldEdge]]] + 1;
+						if (spl < chainEnd[oldEdge]) {
+							int newEdge = chainBegin.size();
+							chainBegin.push(chainBegin[oldEdge]);
+							chainEnd.push(spl);
+							chainBegin[oldEdge] = spl;
+							for (int c = chainBegin[newEdge]; c < spl; c++) {
+								longEdge[chain[c]] = newEdge;
+							}
 						}
 					} else
 						last = down;
@@ -751,99 +904,25 @@ void FastHierarchyLayout::findPlacement()
 
 	// Place long edges
 
-	bool exD;
-	int *block = new int[n];
-	double *pos = new double[n];
-	kList neighbours;
-	double dist;
-
-	forallnodes
-		x[actNode] = 0;
-	for(dir = 1; dir >= -1;dir -= 2) {
-		// for dir = 1, move long edges as far as possible to the left
-		// for dir = -1, move long edges as far as possible to the right
-
-
-		// Partition the graph into blocks according to the technical report.
-		int blockCount = 0;
-		forallnodes
-			block[actNode] = marked[actNode] = 0;
-		foralllayers {
-			actNode = (dir == 1 ? first[actLayer] : first[actLayer+1] - 1);
-			if(!block[actNode]) {
-				for (int next : *longEdge[actNode]){
-					block[next] = blockCount;
-				}
-				blockCount++;
-			}
-			actNode += dir;
-			while(actNode >= first[actLayer] && actNode < first[actLayer+1]) {
-				if(!block[actNode]) {
-					for (int next : *longEdge[actNode]){
-						block[next] = block[actNode-dir];
-					}
-				}
-				actNode += dir;
-			}
+	// pos[0]: move long edges as far as possible to the left
+	// pos[1]: move long edges as far as possible to the right
+	// Both placements are independent.
+	Array<double> pos[2];
+	parallelFor(std::min(m_numberOfThreads, 2u), 2, [&](int begin, int end, unsigned int) {
+		for (int i = begin; i < end; i++) {
+			placeLongEdges(i ? -1 : 1, pos[i]);
 		}
+	});
 
-		// Store the nodes of every block in a separate list
-		List<int> *blockNodes = new List<int>[n];
-		foralllayers {
-			for(actNode = ( (dir == 1) ? first[actLayer] : (first[actLayer+1]-1) );
-				actNode >= first[actLayer] && actNode < first[actLayer+1];
-				actNode += dir)
-			{
-				blockNodes[block[actNode]].pushBack(actNode);
-			}
-		}
-
-		for(int i = 0; i < blockCount;i++) {
-			// for every block
-			exD = 0;
-			dist = 0;
-			for (int actNodeInBlock : blockNodes[i]) {
-				// for every node of the block apply sortLongEdges
-				sortLongEdges(actNodeInBlock,dir,pos,exD,dist,block,marked);
-			}
-			if(!exD) {
-				// The currently examined block does not share its layers with
-				// another block that has been placed before. Thus the block
-				// can be freely moved. We compute a position for the block by
-				// minimizing the total edge length to neighbours of blocks
-				// that have already been placed. dist has not been computed by
-				// sortLongEdges and is now set to the optimal value.
-				actLayer = layer[blockNodes[i].front()];
-				forallnodesonlayer {
-					for (int next : adj[0][actNode]) {
-						neighbours.add(0,pos[next] - pos[actNode]);
-					}
-				}
-				if(!neighbours.empty()) {
-					cmpWithKey cmp;
-					neighbours.quicksort(cmp);
-					dist =- dir*neighbours.median();
-					neighbours.clear();
-				}
-			}
-			// If exD is true, dist has been computed by sortLongEdges.
-
-			// Move the nodes of the block to their positions.
-			for (int actNodeInBlock : blockNodes[i]) {
-				pos[actNodeInBlock] -= dir * dist;
-			}
-		}
-
-		// Compute for every node the average of the two positions of the left
-		// and right placement.
-		forallnodes
-			x[actNode] += pos[actNode] / 2;
-
-		delete[] blockNodes;
+	// Compute for every node the average of the two positions of the left
+	// and right placement.
+	forallnodes {
+		x[actNode] = 0;
+		x[actNode] += pos[0][actNode] / 2;
+		x[actNode] += pos[1][actNode] / 2;
 	}
-
-	delete[] block;
-	delete[] pos;
+	pos[0].init();
+	pos[1].init();
 
 	// Place nonvirtual nodes
 
@@ -853,39 +932,39 @@ void FastHierarchyLayout::findPlacement()
 	// -1 : is not yet clear
 	// 0  : top down traversal
 	// 1  : bottom up traversal
-	int *nodeDir = new int[n];
-
-	forallnodes
-		nodeDir[actNode] = -1;
+	Array<int> nodeDir(0, n-1, -1);
 
 
 
 	// Initialization of marked.
 	// marked is used to indicate the placement of a sequence.
-	forallnodes {
-		if(virt[actNode]) {
-			int next = actNode + 1;
-			while(sameLayer(next,actNode) && !virt[next])
-				next++;
-
-			// If actNode is representative of a fixed inner sequence, the
-			// sequence is already placed and marked is set
-			marked[actNode] = sameLayer(next,actNode) &&
-				x[next] - x[actNode] < totalB[next] - totalB[actNode] + ALLOW;
-
-		} else
-			marked[actNode] = 0;
-	}
+	parallelFor(m_numberOfThreads, n, [&](int begin, int end, unsigned int) {
+		for (int v = begin; v < end; v++) {
+			if(virt[v]) {
+				int next = v + 1;
+				while(sameLayer(next,v) && !virt[next])
+					next++;
+
+				// If v is representative of a fixed inner sequence, the
+				// sequence is already placed and marked is set
+				marked[v] = sameLayer(next,v) &&
+					x[next] - x[v] < totalB[next] - totalB[v] + ALLOW;
+
+			} else
+				marked[v] = 0;
+		}
+	});
 
 	forallnodes {
 		if(marked[actNode] && nodeDir[actNode] == -1) {
 			// for every fixed sequence, traverse the long edge belonging to
 			// the representative actnode
-			for (int next : *longEdge[actNode]) {
+			for (int c = chainBegin[longEdge[actNode]]; c < chainEnd[longEdge[actNode]]; c++) {
 				// for every virtual node next of the long edge mark the
 				// corrsponding sequence as to be placed in the upward
 				// traversal if next is above of actnode and in the downward
 				// traversal if next is below actNode.
+				int next = chain[c];
 				if(next != actNode)
 					nodeDir[next] = next < actNode;
 			}
@@ -895,11 +974,11 @@ void FastHierarchyLayout::findPlacement()
 	// mDist is equal to totalB during the first traversal. After the first
 	// traversal it is set to the positions computed in the first traversal.
 	// It is only modified for external sequences.
-	mDist = new double[n];
-	// Die folgende forallnodes Schleife wurde f?r den Vorschlag von
-	// Christoph (siehe unten) entfernt, da ?berfl?ssig
-	forallnodes
-		mDist[actNode] = totalB[actNode];
+	mDist = totalB;
+
+	// The sequences of a layer that are placed in the current traversal,
+	// given by their bounding virtual nodes (-1 if external).
+	ArrayBuffer<int> seqLeftBnd, seqRightBnd;
 
 	for(dir = 0;dir < 2;dir++) {
 		// for every traversal
@@ -909,57 +988,56 @@ void FastHierarchyLayout::findPlacement()
 		{
 			// for every layer (if dir = 0 top down)
 
-#if 0
-			// Änderungen vorgeschlagen von Christoph
-			// führen aber dazu, dass sich Knoten zu Nahe kommen
-			// können (näher als minDist) (Carsten)
-			for(int i1 = first[actLayer]; i1 < first[actLayer+1]; i1++)
-				mDist[i1] = x[i1];
-
+			seqLeftBnd.clear();
+			seqRightBnd.clear();
 			leftBnd=-1;
 			forallnodesonlayer {
-				if(virt[actNode] && virt[adj[dir][actNode].front()]) {
-					x[actNode] = x[adj[dir][actNode].front()];
-
-					if(leftBnd == -1)
-						placeNodes(-1,actNode,first[actLayer],actNode-1,dir);
-					else
-						placeNodes(leftBnd,actNode,leftBnd+1,actNode-1,dir);
-
+				if(virt[actNode]) {
+					// For every sequence, bounded by leftBnd and actNode.
+					if(leftBnd == -1) {
+						// leftBnd is not a node. The sequence is external. Place it.
+						seqLeftBnd.push(-1);
+						seqRightBnd.push(actNode);
+					}
+					else if(nodeDir[leftBnd] != !dir && !marked[leftBnd]) {
+						// internal sequence that has not been placed yet. Place it.
+						seqLeftBnd.push(leftBnd);
+						seqRightBnd.push(actNode);
+					}
 					leftBnd = actNode;
 				}
 			}
+			// External sequence to the right or no virtual node in the
+			// complete layer. Place it.
+			seqLeftBnd.push(leftBnd);
+			seqRightBnd.push(-1);
+
+			// The sequences are separated by virtual nodes, which are not
+			// moved, so they can be placed independently.
+			unsigned int threads = numberOfThreadsFor(m_numberOfThreads,
+				first[actLayer+1] - first[actLayer], 1024);
+			parallelFor(threads, seqLeftBnd.size(), [&](int begin, int end, unsigned int) {
+				for (int i = begin; i < end; i++) {
+					int lBnd = seqLeftBnd[i];
+					int rBnd = seqRightBnd[i];
+					placeNodes(lBnd, rBnd,
+						lBnd == -1 ? first[actLayer] : lBnd + 1,
+						rBnd == -1 ? first[actLayer+1] - 1 : rBnd - 1, dir);
+				}
+			});
 
-			if(leftBnd == -1)
-				placeNodes(-1,-1,first[actLayer],first[actLayer+1]-1,dir);
-			else
-				placeNodes(leftBnd,-1,leftBnd+1,first[actLayer+1]-1,dir);
-
-			for(int i1 = first[actLayer]; i1 < first[actLayer+1]; i1++)
-				mDist[i1] = totalB[i1];
-#endif
-
+			// Update mDist for external sequences and adjust nodeDir for the
+			// next layer.
 			leftBnd=-1;
 			forallnodesonlayer {
 				if(virt[actNode]) {
-					// For every sequence, bounded by leftBnd and actNode.
 					if(leftBnd == -1) {
-						// leftBnd is not a node. The sequence is external. Place it.
-						placeNodes(-1,actNode,first[actLayer],actNode - 1,dir);
 						for(int next = first[actLayer]; next < actNode; next++)
 							mDist[next] = mDist[actNode] - x[actNode] + x[next];
 					}
 					else if(nodeDir[leftBnd] != !dir) { // nodeDir[leftBnd] == dir ||  nodeDir[leftBnd] == -1
-						// internal sequence
-
-						if(!marked[leftBnd])
-							// sequence has not been placed yet. Place it.
-							placeNodes(leftBnd,actNode,leftBnd + 1,
-							actNode - 1,dir);
-
-						// Adjust nodeDir for the next layer.
-						leftNxt = adj[!dir][leftBnd].front();
-						rightNxt = adj[!dir][actNode].front();
+						leftNxt = firstAdj(!dir,leftBnd);
+						rightNxt = firstAdj(!dir,actNode);
 						if(virt[leftNxt] && virt[rightNxt])
 							for(int next = leftNxt + 1;next < rightNxt; next++)
 								nodeDir[next] = dir;
@@ -968,21 +1046,16 @@ void FastHierarchyLayout::findPlacement()
 				}
 			}
 			if(leftBnd == -1) {
-				// No virtual node in the complete layer. Place it.
-				placeNodes(-1,-1,first[actLayer],first[actLayer+1] - 1,dir);
 				for (int next = first[actLayer]; next < first[actLayer+1]; next++)
 					mDist[next] = x[next];
 			}
 			else {
-				// External sequence to the right. Place it.
-				placeNodes(leftBnd,-1,leftBnd + 1,first[actLayer+1] - 1,dir);
 				for (int next = first[actLayer+1] - 1;next > leftBnd; next--)
 					mDist[next] = mDist[leftBnd] - x[leftBnd] + x[next];
 			}
 		}
 	}
-	delete[] nodeDir;
-	delete[] mDist;
+	mDist.init();
 
 	// Apply moveLongEdge to every long edge.
 	forallnodes
@@ -1002,24 +1075,32 @@ void FastHierarchyLayout::findPlacement()
 
 	// Compute ordinates for the layers and boxY
 
+	// minD[layer] = distance between layer and the next layer
+	Array<double> minD(k);
+	parallelFor(m_numberOfThreads, k, [&](int begin, int end, unsigned int) {
+		for (int l = begin; l < end; l++) {
+			minD[l] = m_minLayerDist;
+			if(!m_fixedLayerDist) {
+				for (int v = first[l]; v < first[l+1]; v++) {
+					// adjust the distance of the layer to the longest edge
+					for (int j = adjStart[1][v]; j < adjStart[1][v+1]; j++) {
+						int next = adj[1][j];
+						incrTo(minD[l],(x[next] - x[v]) / 3);
+						incrTo(minD[l],(x[v] - x[next]) / 3);
+					}
+				}
+				decrTo(minD[l],10 * m_minLayerDist);
+			}
+		}
+	});
+
 	double boxY = k ? height[0] / 2 : 0; // y-value for the bounding box.
 
 	foralllayers {
 		y[actLayer] = boxY;
-		double minD = m_minLayerDist;
-		if(!m_fixedLayerDist) {
-			forallnodesonlayer {
-				// adjust the distance of the layer to the longest edge
-				for (int next : adj[1][actNode]) {
-					incrTo(minD,(x[next] - x[actNode]) / 3);
-					incrTo(minD,(x[actNode] - x[next]) / 3);
-				}
-			}
-			decrTo(minD,10 * m_minLayerDist);
-		}
 		boxY += height[actLayer] / 2;
 		if(actLayer < k - 1)
-			boxY += minD + height[actLayer+1] / 2;
+			boxY += minD[actLayer] + height[actLayer+1] / 2;
 	}
 
 	// Apply straightenEdge to every long edge with one virtual node.
@@ -1038,8 +1119,7 @@ void FastHierarchyLayout::findPlacement()
 			straightenEdge(actNode,marked);
 		}
 	}
-	delete[] marked;
-	delete[] totalB;
+	totalB.init();
 }
 
 
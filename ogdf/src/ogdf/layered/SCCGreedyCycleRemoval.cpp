@@ -0,0 +1,264 @@
+/** \file
+ * \brief Implementation of class SCCGreedyCycleRemoval
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/layered/SCCGreedyCycleRemoval.h>
+#include <ogdf/basic/ParallelFor.h>
+#include <ogdf/basic/simple_graph_alg.h>
+
+#include <atomic>
+
+namespace ogdf {
+
+namespace {
+
+//! Flat adjacency structure of the edges inside strong components.
+/**
+ * The nodes of each component occupy the consecutive index range
+ * [compStart[c], compStart[c+1]) and the incident arcs of node i (given
+ * by the index of their other end node) are stored in
+ * outArc[outStart[i] .. outStart[i+1]) and inArc[inStart[i] .. inStart[i+1]).
+ */
+struct ComponentArcs {
+	Array<int> compStart;
+	Array<int> outStart, inStart;
+	Array<int> outArc, inArc;
+};
+
+//! Computes the Eades-Lin-Smyth order of the nodes in [first, last).
+/**
+ * Writes to \p pos the position of each node within the order of its component.
+ */
+void greedyOrder(const ComponentArcs &A, int first, int last, Array<int> &pos)
+{
+	const int n = last - first;
+
+	// per node: remaining degrees and the linked list of its bucket
+	std::vector<int> in(n), out(n), next(n), prev(n), bucket(n);
+	std::vector<bool> removed(n, false);
+	std::vector<int> sinks, sources;
+
+	int maxIn = 0, maxOut = 0;
+	for (int i = 0; i < n; ++i) {
+		out[i] = A.outStart[first+i+1] - A.outStart[first+i];
+		in [i] = A.inStart [first+i+1] - A.inStart [first+i];
+		maxIn  = std::max(maxIn,  in [i]);
+		maxOut = std::max(maxOut, out[i]);
+	}
+
+	// buckets for out - in in [-maxIn, maxOut], -1 marks empty lists
+	std::vector<int> head(maxIn + maxOut + 1, -1);
+	int maxBucket = 0;
+
+	auto unlink = [&](int i) {
+		if (prev[i] >= 0) {
+			next[prev[i]] = next[i];
+		} else {
+			head[bucket[i]] = next[i];
+		}
+		if (next[i] >= 0) {
+			prev[next[i]] = prev[i];
+		}
+	};
+
+	// puts a node that is neither removed nor collected as sink or source into its place
+	auto place = [&](int i) {
+		if (out[i] == 0) {
+			sinks.push_back(i);
+		} else if (in[i] == 0) {
+			sources.push_back(i);
+		} else {
+			int b = bucket[i] = out[i] - in[i] + maxIn;
+			prev[i] = -1;
+			next[i] = head[b];
+			if (next[i] >= 0) {
+				prev[next[i]] = i;
+			}
+			head[b] = i;
+			maxBucket = std::max(maxBucket, b);
+		}
+	};
+
+	// moves a node in a bucket to its new place after a degree change
+	auto relocate = [&](int i) {
+		if (bucket[i] >= 0) {
+			unlink(i);
+			bucket[i] = -1;
+			place(i);
+		}
+	};
+
+	for (int i = 0; i < n; ++i) {
+		bucket[i] = -1;
+		place(i);
+	}
+
+	int left = 0, right = n;
+	for (int k = 0; k < n; ++k) {
+		int u;
+		if (!sinks.empty()) {
+			u = sinks.back();
+			sinks.pop_back();
+			pos[first+u] = --right;
+		} else {
+			if (!sources.empty()) {
+				u = sources.back();
+				sources.pop_back();
+			} else {
+				while (head[maxBucket] < 0) {
+					--maxBucket;
+				}
+				u = head[maxBucket];
+				unlink(u);
+			}
+			pos[first+u] = left++;
+		}
+		removed[u] = true;
+
+		// neighbours kept as sinks or sources stay there
+		for (int j = A.outStart[first+u]; j < A.outStart[first+u+1]; ++j) {
+			int w = A.outArc[j] - first;
+			if (!removed[w]) {
+				--in[w];
+				relocate(w);
+			}
+		}
+		for (int j = A.inStart[first+u]; j < A.inStart[first+u+1]; ++j) {
+			int w = A.inArc[j] - first;
+			if (!removed[w]) {
+				--out[w];
+				relocate(w);
+			}
+		}
+	}
+}
+
+}
+
+SCCGreedyCycleRemoval::SCCGreedyCycleRemoval()
+  : m_maxThreads(std::max(1, System::numberOfProcessors()))
+{
+}
+
+void SCCGreedyCycleRemoval::call(const Graph &G, List<edge> &arcSet)
+{
+	arcSet.clear();
+
+	NodeArray<int> component(G);
+	const int numComps = strongComponents(G, component);
+
+	// number the nodes consecutively per component
+	ComponentArcs A;
+	A.compStart.init(numComps + 1);
+	A.compStart.fill(0);
+	for (node v : G.nodes) {
+		++A.compStart[component[v] + 1];
+	}
+	for (int c = 0; c < numComps; ++c) {
+		A.compStart[c+1] += A.compStart[c];
+	}
+
+	const int n = G.numberOfNodes();
+	NodeArray<int> index(G);
+	{
+		Array<int> fill(numComps);
+		for (int c = 0; c < numComps; ++c) {
+			fill[c] = A.compStart[c];
+		}
+		for (node v : G.nodes) {
+			index[v] = fill[component[v]]++;
+		}
+	}
+
+	// collect the arcs inside components (without self-loops) in CSR form
+	A.outStart.init(n + 1);
+	A.inStart.init(n + 1);
+	A.outStart.fill(0);
+	A.inStart.fill(0);
+	int numArcs = 0;
+	for (edge e : G.edges) {
+		node s = e->source(), t = e->target();
+		if (s != t && component[s] == component[t]) {
+			++A.outStart[index[s] + 1];
+			++A.inStart[index[t] + 1];
+			++numArcs;
+		}
+	}
+	for (int i = 0; i < n; ++i) {
+		A.outStart[i+1] += A.outStart[i];
+		A.inStart[i+1] += A.inStart[i];
+	}
+	A.outArc.init(numArcs);
+	A.inArc.init(numArcs);
+	{
+		Array<int> outFill(n), inFill(n);
+		for (int i = 0; i < n; ++i) {
+			outFill[i] = A.outStart[i];
+			inFill[i] = A.inStart[i];
+		}
+		for (edge e : G.edges) {
+			node s = e->source(), t = e->target();
+			if (s != t && component[s] == component[t]) {
+				A.outArc[outFill[index[s]]++] = index[t];
+				A.inArc[inFill[index[t]]++] = index[s];
+			}
+		}
+	}
+
+	// process nontrivial components, largest first
+	Array<int> comps(numComps);
+	int numNontrivial = 0;
+	for (int c = 0; c < numComps; ++c) {
+		if (A.compStart[c+1] - A.compStart[c] > 1) {
+			comps[numNontrivial++] = c;
+		}
+	}
+	std::sort(comps.begin(), comps.begin() + numNontrivial, [&](int c1, int c2) {
+		return A.compStart[c1+1] - A.compStart[c1] > A.compStart[c2+1] - A.compStart[c2];
+	});
+
+	Array<int> pos(n);
+	pos.fill(0);
+	std::atomic<int> nextComp(0);
+	const unsigned int threads = numberOfThreadsFor(m_maxThreads, numArcs, 10000);
+	parallelFor(threads, threads, [&](int, int, unsigned int) {
+		for (int k = nextComp++; k < numNontrivial; k = nextComp++) {
+			int c = comps[k];
+			greedyOrder(A, A.compStart[c], A.compStart[c+1], pos);
+		}
+	});
+
+	for (edge e : G.edges) {
+		node s = e->source(), t = e->target();
+		if (component[s] == component[t] && pos[index[s]] >= pos[index[t]]) {
+			arcSet.pushBack(e);
+		}
+	}
+}
+
+}
@@ -41,6 +41,7 @@
 #include <ogdf/packing/TileToRowsCCPacker.h>
 #include <ogdf/basic/simple_graph_alg.h>
 #include <ogdf/basic/Thread.h>
+#include <ogdf/basic/Tracer.h>
 
 #include <atomic>
 
@@ -952,6 +953,8 @@ void SugiyamaLayout::doCall(GraphAttributes &AG, bool umlCall, NodeArray<int> &r
 	if (G.numberOfNodes() == 0)
 		return;
 
+	OGDF_TRACE_SCOPE("SugiyamaLayout::call");
+
 	// compute connected component of G
 	NodeArray<int> component(G);
 	m_numCC = connectedComponents(G,component);
@@ -959,6 +962,7 @@ void SugiyamaLayout::doCall(GraphAttributes &AG, bool umlCall, NodeArray<int> &r
 	const bool optimizeHorizEdges = (umlCall || rank.valid());
 	if(!rank.valid())
 	{
+		OGDF_TRACE_SCOPE("SugiyamaLayout::ranking");
 		if(umlCall)
 		{
 			LongestPathRanking ranking;
@@ -1012,7 +1016,10 @@ void SugiyamaLayout::doCall(GraphAttributes &AG, bool umlCall, NodeArray<int> &r
 			const GraphCopy &GC = H;
 			NodeArray<bool> mark(GC);
 
-			m_layout->call(levels,AG);
+			{
+				OGDF_TRACE_SCOPE("SugiyamaLayout::coordinateAssignment");
+				m_layout->call(levels,AG);
+			}
 
 			double
 				minX =  numeric_limits<double>::max(),
@@ -1097,7 +1104,10 @@ void SugiyamaLayout::doCall(GraphAttributes &AG, bool umlCall, NodeArray<int> &r
 
 		// call packer
 		Array<DPoint> offset(m_numCC);
-		m_packer->call(boundingBox,offset,m_pageRatio);
+		{
+			OGDF_TRACE_SCOPE("SugiyamaLayout::packing");
+			m_packer->call(boundingBox,offset,m_pageRatio);
+		}
 
 		// The arrangement is given by offset to the origin of the coordinate
 		// system. We still have to shift each node and edge by the offset
@@ -1164,7 +1174,10 @@ void SugiyamaLayout::doCall(GraphAttributes &AG, bool umlCall, NodeArray<int> &r
 
 		const GraphCopy &GC = H;
 
-		m_layout->call(levels,AG);
+		{
+			OGDF_TRACE_SCOPE("SugiyamaLayout::coordinateAssignment");
+			m_layout->call(levels,AG);
+		}
 
 		if(optimizeHorizEdges)
 		{
@@ -1300,6 +1313,7 @@ const HierarchyLevels *LayerByLayerSweep::reduceCrossings(const SugiyamaLayout &
 const HierarchyLevelsBase *SugiyamaLayout::reduceCrossings(Hierarchy &H)
 {
 	OGDF_ASSERT(m_runs >= 1);
+	OGDF_TRACE_SCOPE("SugiyamaLayout::crossingMinimization");
 
 	if (useSubgraphs() == false) {
 		int64_t t;
@@ -1357,4 +1371,29 @@ const HierarchyLevelsBase *SugiyamaLayout::reduceCrossings(Hierarchy &H)
 	return pLevels;
 }
 
+LayoutCostEstimate SugiyamaLayout::estimateCost(const GraphAttributes &GA) const
+{
+	const Graph &G = GA.constGraph();
+	const double n = G.numberOfNodes();
+	const double m = G.numberOfEdges();
+
+	// the proper hierarchy gets one dummy node per layer spanned by an edge;
+	// assume an average span of three layers
+	const double properNodes = n + 2 * m;
+	const double properEdges = 3 * m;
+	const double logN = properNodes > 2 ? std::log2(properNodes) : 1.0;
+
+	LayoutCostEstimate cost;
+	cost.peakMemory = LayoutCostEstimate::attributesMemory(GA)
+	  + 2 * LayoutCostEstimate::graphMemory(properNodes, properEdges)
+	  + m_runs * properNodes * sizeof(int);
+
+	// every run sweeps until fails() sweeps did not improve, and coordinate
+	// assignment is linear in the proper hierarchy
+	cost.operations = double(m_runs) * (m_fails + 2) * (properNodes * logN + properEdges)
+	  + properNodes + properEdges;
+	cost.timeClass = LayoutCostEstimate::TimeClass::Quadratic;
+	return cost;
+}
+
 } // end namespace ogdf
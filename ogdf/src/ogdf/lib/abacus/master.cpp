@@ -38,6 +38,11 @@
 #include <ogdf/lib/abacus/setbranchrule.h>
 #include <ogdf/lib/abacus/standardpool.h>
 
+#include <ogdf/basic/Thread.h>
+
+#include <algorithm>
+#include <exception>
+
 namespace abacus {
 
 const char* Master::STATUS_[] = {
@@ -158,6 +163,8 @@ Master::Master(
 	conElimAge_(1),
 	varElimAge_(1),
 	status_(Unprocessed),
+	nThreads_(1),
+	concurrent_(false),
 	nSub_(0),
 	nLp_(0),
 	highestLevel_(0),
@@ -302,14 +309,19 @@ Master::STATUS Master::optimize()
 	*   If the optimization of a subproblem fails we quit the optimization
 	*   immediately..
 	*/
-	Sub *current;
+	if (nThreads_ > 1) {
+		_optimizeConcurrently();
+	}
+	else {
+		Sub *current;
 
-	while ((current = select())) {
-		++nSubSelected_;
+		while ((current = select())) {
+			++nSubSelected_;
 
-		if (current->optimize()) {
-			status_ = Error;
-			break;
+			if (current->optimize()) {
+				status_ = Error;
+				break;
+			}
 		}
 	}
 
@@ -529,8 +541,19 @@ Sub* Master::select()
 	/* If one of the criteria for early termination is satisfied then
 	*   we fathom all subproblems of the tree, in order to perform a
 	*   correct cleaning up.
-	*
-	*   The maximal level of the enumeration tree is no termination criterion
+	*/
+	if (_terminate()) {
+		root_->fathomTheSubTree();
+		return nullptr;
+	}
+
+	return openSub_->select();
+}
+
+
+bool Master::_terminate()
+{
+	/* The maximal level of the enumeration tree is no termination criterion
 	*   in this sense, because it only prevents the generation of further
 	*   sons of subproblems having this maximal level, but does not
 	*   stop the optimization.
@@ -538,17 +561,15 @@ Sub* Master::select()
 	if (totalTime_.exceeds(maxCpuTime())) {
 		Logger::ilout(Logger::Level::Default) << "Maximal CPU time " << maxCpuTimeAsString() << " exceeded." << endl
 		 << "Stop optimization." << endl;
-		root_->fathomTheSubTree();
 		status_ = MaxCpuTime;
-		return nullptr;
+		return true;
 	}
 
 	if (totalCowTime_.exceeds(maxCowTime())) {
 		Logger::ilout(Logger::Level::Default) << "Maximal elapsed time " << maxCowTimeAsString() << " exceeded." << endl
 		 << "Stop optimization." << endl;
-		root_->fathomTheSubTree();
 		status_ = MaxCowTime;
-		return nullptr;
+		return true;
 	}
 
 	if (guaranteed()) {
@@ -556,8 +577,7 @@ Sub* Master::select()
 		 << "Guarantee " << requiredGuarantee() << " % reached." << endl
 		 << "Terminate optimization." << endl;
 		status_ = Guaranteed;
-		root_->fathomTheSubTree();
-		return nullptr;
+		return true;
 	}
 
 	if (nSubSelected_ >= maxNSub()) {
@@ -565,11 +585,98 @@ Sub* Master::select()
 		 << "Maximal number of subproblems reached: " << maxNSub() << endl
 		 << "Terminate optimization." << endl;
 		status_ = MaxNSub;
-		root_->fathomTheSubTree();
-		return nullptr;
+		return true;
 	}
 
-	return openSub_->select();
+	return false;
+}
+
+
+void Master::_optimizeConcurrently()
+{
+	// process the subproblems with several threads
+	/* Each thread repeatedly selects an open subproblem and optimizes it
+	*   while holding the lock of the master. The lock is only released
+	*   while a linear program is solved (see Master::LpSolverSection), hence
+	*   each subproblem keeps its own LP-solver and all other data of the
+	*   master, like the pools and the set of open subproblems, is shared.
+	*   If the set of open subproblems is empty, a thread waits until
+	*   another subproblem has been processed, since this might have
+	*   generated new sons or made a dormant subproblem available.
+	*/
+	std::exception_ptr failure;
+	bool terminated = false;
+
+	auto worker = [&] {
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		try {
+			while (status_ == Processing) {
+				if (_terminate()) {
+					terminated = true;
+					break;
+				}
+
+				Sub *current = openSub_->select();
+
+				if (!current) {
+					if (processing_.empty()) break;
+					subProcessed_.wait(lock);
+					continue;
+				}
+
+				++nSubSelected_;
+				processing_.push_back(current);
+
+				int error = current->optimize();
+
+				processing_.erase(std::find(processing_.begin(), processing_.end(), current));
+				if (error) status_ = Error;
+
+				subProcessed_.notify_all();
+			}
+		}
+		catch (...) {
+			if (!failure) failure = std::current_exception();
+			status_ = Error;
+		}
+
+		subProcessed_.notify_all();
+	};
+
+	concurrent_ = true;
+
+	std::vector<ogdf::Thread> threads;
+	for (int i = 1; i < nThreads_; ++i) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	concurrent_ = false;
+	processing_.clear();
+
+	if (failure) std::rethrow_exception(failure);
+
+	if (terminated) root_->fathomTheSubTree();
+}
+
+
+double Master::_processedDualBound(const Sub *sub) const
+{
+	double bound = sub->dualBound();
+
+	for (const Sub *s : processing_) {
+		if (optSense_.max()) {
+			if (s->dualBound() > bound) bound = s->dualBound();
+		}
+		else
+			if (s->dualBound() < bound) bound = s->dualBound();
+	}
+
+	return bound;
 }
 
 
@@ -1215,6 +1322,8 @@ void Master::printParameters() const
 	 << maxLevel_ << endl
 	 << "  Maximal number of subproblems          : "
 	 << maxNSub_ << endl
+	 << "  Number of threads                      : "
+	 << nThreads_ << endl
 	 << "  CPU time limit                         : "
 	 << maxCpuTimeAsString() << endl
 	 << "  Wall-clock time limit                  : "
@@ -1346,6 +1455,16 @@ void Master::maxNSub(int max)
 }
 
 
+void Master::nThreads(int n)
+{
+	if (n < 1) {
+		Logger::ifout() << "Master::nThreads " << n << ", only positive integers are valid\n";
+		OGDF_THROW_PARAM(AlgorithmFailureException, ogdf::AlgorithmFailureCode::IllegalParameter);
+	}
+	nThreads_ = n;
+}
+
+
 void Master::tailOffPercent(double p)
 {
 	if (p < 0.0) {
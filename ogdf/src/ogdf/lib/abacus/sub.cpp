@@ -267,9 +267,11 @@ int Sub::optimize()
 	/* The global dual bound is the maximum (minimum) of the
 	*   dual bound of the subproblem and the dual bounds of the
 	*   subproblems which still have to be processed if this
-	*   is a maximization (minimization) problem.
+	*   is a maximization (minimization) problem. If the subproblems
+	*   are processed concurrently, the subproblems currently processed
+	*   by other threads have to be considered, too.
 	*/
-	double newDual = dualBound_;
+	double newDual = master_->_processedDualBound(this);
 
 	if (master_->optSense()->max()) {
 		if (master_->openSub()->dualBound() > newDual)
@@ -1128,7 +1130,10 @@ int Sub::solveLp ()
 
 	localTimer_.start(true);
 
-	status = lp_->optimize(lpMethod_);
+	{
+		Master::LpSolverSection section(master_);
+		status = lp_->optimize(lpMethod_);
+	}
 	lastLP_ = lpMethod_;
 
 	master_->lpSolverTime_.addCentiSeconds( lp_->lpSolverTime_.centiSeconds() );
@@ -2344,7 +2349,10 @@ double Sub::lpRankBranchingRule(BranchRule *branchRule, int iterLimit)
 
 	branchRule->extract(lp_);
 	localTimer_.start(true);
-	lp_->optimize(LP::Dual);
+	{
+		Master::LpSolverSection section(master_);
+		lp_->optimize(LP::Dual);
+	}
 	master_->lpTime_.addCentiSeconds(localTimer_.centiSeconds());
 
 	// get the \a value of the linear program
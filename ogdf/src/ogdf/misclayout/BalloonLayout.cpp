@@ -42,30 +42,26 @@
 
 
 #include <ogdf/basic/simple_graph_alg.h>
-#include <ogdf/basic/Queue.h>
+#include <ogdf/basic/ParallelFor.h>
+
+#include <algorithm>
 
 
 namespace ogdf {
 
 
 BalloonLayout::BalloonLayout() :
+	m_numberOfThreads(1),
 	m_rootSelection(BalloonLayout::RootSelection::Center),  //how to select the root
 	m_estimateFactor(1.2),        //weight of radius addition value
 	m_childOrder(ChildOrder::Fixed),    //how to arrange the children
 	m_treeComputation(BalloonLayout::TreeComputation::Bfs),  //spanning tree by...
-	m_evenAngles(false)
-{
-#ifdef OGDF_DEBUG
-	m_treeEdge = nullptr;
-#endif
-}
+	m_evenAngles(false),
+	m_maxThreads(1)
+{ }
 
 BalloonLayout::~BalloonLayout()
-{
-#ifdef OGDF_DEBUG
-	delete m_treeEdge;
-#endif
-}
+{ }
 
 BalloonLayout &BalloonLayout::operator=(const BalloonLayout &bl)
 {
@@ -74,6 +70,7 @@ BalloonLayout &BalloonLayout::operator=(const BalloonLayout &bl)
 	m_rootSelection   = bl.m_rootSelection;
 	m_estimateFactor  = bl.m_estimateFactor;
 	m_evenAngles      = bl.m_evenAngles;
+	m_maxThreads      = bl.m_maxThreads;
 
 	return *this;
 }
@@ -85,37 +82,27 @@ void BalloonLayout::call(GraphAttributes &AG)
 	if(G.numberOfNodes() == 0) return;
 
 	OGDF_ASSERT(isConnected(G));
-#ifdef OGDF_DEBUG
-	delete m_treeEdge;
-	m_treeEdge = new EdgeArray<bool>();
-	m_treeEdge->init(G, false);
-#endif
 
 	m_rootSelection = RootSelection::Center;
 	m_treeComputation = TreeComputation::Bfs;
-	m_childOrder = ChildOrder::Fixed;
 
 	computeTree(G);
-#ifdef OGDF_DEBUG
-	AG.fillColor(m_treeRoot) = Color::Name::Mediumblue;
-	cout << "Treeroot is blue\n";
-#endif
 
 	// determine root of tree (m_root)
 	m_root = m_treeRoot;
 	selectRoot(G);
+
+	// all following passes work on the tree in preorder
+	linearizeTree();
 #ifdef OGDF_DEBUG
-	AG.fillColor(m_root) = Color(0xaa, 0x00, 0xaa);
-	for(edge e : G.edges)
-	{
-		if ((*m_treeEdge)[e])
-			AG.strokeColor(e) = Color(0xaa, 0x00, 0xaa);
-	}
+	checkTree(G);
 #endif
+	m_numberOfThreads = numberOfThreadsFor(m_maxThreads, G.numberOfNodes(), 4096);
+	splitTree();
 
 	computeRadii(AG);
 
-	// computes m_angle[v]
+	// computes m_angle
 	computeAngles(G);
 
 	// computes final coordinates of nodes
@@ -126,9 +113,8 @@ void BalloonLayout::call(GraphAttributes &AG)
 void BalloonLayout::selectRoot(const Graph &G)
 //Todo: Vorgabewert durch user erlauben, firstNode?
 {
-#ifdef OGDF_DEBUG
-	checkTree(G, true);
-#endif
+	const int n = m_node.size();
+	int root = 0;
 
 	switch(m_rootSelection)
 	{
@@ -139,7 +125,7 @@ void BalloonLayout::selectRoot(const Graph &G)
 			for(node v : G.nodes)
 				if(v->degree() > maxDeg)
 				{
-					m_root = v;
+					root = m_pos[v];
 					maxDeg = v->degree();
 				}
 		}
@@ -147,263 +133,263 @@ void BalloonLayout::selectRoot(const Graph &G)
 
 	case BalloonLayout::RootSelection::Center:
 		{
-			NodeArray<int> degree(G);
-			Queue<node> leaves;
-
-			if (G.numberOfNodes() == 1)
-				leaves.append(G.firstNode());
+			//the last vertex that remains when removing leaves
+			//repeatedly is a center of the tree
+			Array<int> degree(n);
+			Array<int> leaves(n);
+			int head = 0, tail = 0;
+
+			if (n == 1)
+				leaves[tail++] = 0;
 			else
 				for(node v : G.nodes) {
-					degree[v] = m_childCount[v];
-					if (m_parent[v] != nullptr) degree[v]++;
-					if(degree[v] == 1)
-						leaves.append(v);
-			}
+					int i = m_pos[v];
+					degree[i] = childCount(i);
+					if (m_parent[i] >= 0) degree[i]++;
+					if(degree[i] == 1)
+						leaves[tail++] = i;
+				}
 
-			node v = nullptr;
-			while(!leaves.empty()) {
-				v = leaves.pop();
+			while (head < tail) {
+				root = leaves[head++];
 
-				node p = m_parent[v];
-				if (p != nullptr && --degree[p] == 1) {
-					leaves.append(p);
+				int p = m_parent[root];
+				if (p >= 0 && --degree[p] == 1) {
+					leaves[tail++] = p;
 				}
-				ListConstIterator<node> it = m_childList[v].begin();
-				while (it.valid())
-				{
-					if (--degree[*it] == 1)
-						leaves.append(*it);
-					++it;
+				for (int k = m_childStart[root]; k < m_childStart[root+1]; ++k) {
+					if (--degree[m_child[k]] == 1)
+						leaves[tail++] = m_child[k];
 				}
 			}//while leaves
-
-			m_root = v;
-			//we swap the parent relationship on the path
-			//from m_treeRoot to m_root
-
-			node u = m_root;
-			v = nullptr;
-			while (u != nullptr)
-			{
-				node w = m_parent[u];
-				m_parent[u] = v;
-				if (v != nullptr)
-				{
-					//may change the child order
-					m_childCount[v]++;
-					m_childList[v].pushBack(u);
-				}//if v
-				if (w != nullptr)
-				{
-					m_childCount[w]--;
-					ListIterator<node> it = m_childList[w].begin();
-					while (it.valid())
-					{
-						if ((*it)==u)
-						{
-							m_childList[w].del(it);
-							break;
-						}
-						++it;
-					}//while children
-				}//if w
-				v = u;
-				u = w;
-			}//while
 		}
 		break;
-	default: {cout << m_rootSelection << "\n";
-		throw AlgorithmFailureException(AlgorithmFailureCode::Unknown);} break;
 	}//switch
 
-#ifdef OGDF_DEBUG
-	checkTree(G, false);
-#endif
+	m_root = m_node[root];
+	if (root == 0) return;
+
+	//we swap the parent relationship on the path
+	//from m_treeRoot to m_root: each node on the path
+	//loses its child on the path and gets its former
+	//parent as last child
+	Array<int> parent(m_parent);
+	for (int u = root, v = -1; u >= 0; v = u, u = m_parent[u]) {
+		parent[u] = v;
+	}
+
+	Array<int> childStart(n+1);
+	Array<int> child(n-1);
+	int k = 0;
+	for (int i = 0; i < n; ++i) {
+		childStart[i] = k;
+		for (int j = m_childStart[i]; j < m_childStart[i+1]; ++j) {
+			if (parent[m_child[j]] == i)
+				child[k++] = m_child[j];
+		}
+		int p = m_parent[i];
+		if (p >= 0 && parent[p] == i)
+			child[k++] = p;
+	}
+	childStart[n] = k;
+
+	std::swap(m_parent, parent);
+	std::swap(m_childStart, childStart);
+	std::swap(m_child, child);
 }//selectroot
 
-#ifdef OGDF_DEBUG
-void BalloonLayout::computeRadii(GraphAttributes &AG)
-#else
-void BalloonLayout::computeRadii(const GraphAttributes &AG)
-#endif
+
+void BalloonLayout::linearizeTree()
 {
-	const Graph &G = AG.constGraph();
-	m_radius.init(G, 0.0);
-	m_oRadius.init(G, 0.0);
-	m_estimate.init(G, 0.0);
-	m_maxChildRadius.init(G, 0.0);
-	m_size.init(G, 0.0);
+	const int n = m_node.size();
+
+	//order[k] is the current position of the k-th node in preorder
+	Array<int> order(n);
+	Array<int> newPos(n);
+	ArrayBuffer<int> stack(n);
+	stack.push(m_pos[m_root]);
+	for (int k = 0; k < n; ++k) {
+		int i = stack.popRet();
+		order[k] = i;
+		newPos[i] = k;
+		for (int j = m_childStart[i+1] - 1; j >= m_childStart[i]; --j)
+			stack.push(m_child[j]);
+	}
 
-	for(node u : G.nodes)
-	{
-		double w = AG.width(u);
-		double h = AG.height(u);
-		double t = 0.5*sqrt(w*w+h*h);
-		m_size[u] = max(0.007, t); //assure we  don't have zero values, some default
+	Array<node> nodes(n);
+	Array<int> parent(n);
+	Array<int> childStart(n+1);
+	Array<int> child(n-1);
+	int c = 0;
+	for (int k = 0; k < n; ++k) {
+		int i = order[k];
+		nodes[k] = m_node[i];
+		m_pos[nodes[k]] = k;
+		parent[k] = m_parent[i] >= 0 ? newPos[m_parent[i]] : -1;
+		childStart[k] = c;
+		for (int j = m_childStart[i]; j < m_childStart[i+1]; ++j)
+			child[c++] = newPos[m_child[j]];
 	}
+	childStart[n] = c;
 
-	Queue<node> level;
+	std::swap(m_node, nodes);
+	std::swap(m_parent, parent);
+	std::swap(m_childStart, childStart);
+	std::swap(m_child, child);
 
-	switch (m_childOrder)
-	{
-		case ChildOrder::Optimized: //todo
-		case ChildOrder::Fixed:
-		{
-			//compute radii in SNS model bottom up
-			//for leaves we use the smallest enclosing circle radius
-			//Using sqrt is quite slow, maybe an approximation will do
-			//r = 0.5*sqrt(w*w + h*h)
-			NodeArray<int> children(G);
-			Queue<node> leaves;
-
-			if (G.numberOfNodes() > 1)
-			{
-				for (node v : G.nodes) {
-					if((children[v] = m_childCount[v]) == 0)
-					{
-						leaves.append(v);
-						m_oRadius[v] = m_size[v];
-					}
-				}
-				//kann man wieder zusammenfassen mit unterer Schleife,
-				//da Berechnung geaendert
-				while(!leaves.empty()) {
-					node v = leaves.pop();
+	//the subtree of a node ends where the subtree of its last child ends
+	m_subtreeEnd.init(n);
+	for (int k = n-1; k >= 0; --k) {
+		m_subtreeEnd[k] = childCount(k) > 0 ? m_subtreeEnd[m_child[m_childStart[k+1]-1]] : k+1;
+	}
+}
 
-					node p = m_parent[v];
 
-					if (p != nullptr)
-					{
-						double t = m_oRadius[v];
-						//we sum up the outer radius values here at
-						//the parent node to compute the estimate for
-						//the inner radius later
-						m_estimate[p] += t;
-						//set the value for the largest child radius
-						if (m_maxChildRadius[p] < t)
-							m_maxChildRadius[p] = t;
-						//if all children are processed, push p into queue
-						if (--children[p] == 0)
-						{
-							//we processed all children of p
-							//and can derive the radius value
-							level.append(p);
-						}//if children == 0
-					}//if parent
-					//inner radius estimate
-					m_radius[v] =  m_oRadius[v];
-					//cout <<"Child-Radius: "<<m_radius[v]<<"\n";
-				}//while
-				while(!level.empty())
-				{
-#ifdef OGDF_DEBUG
-					cout << "Non-leaf node processed\n";
-#endif
-					node v = level.pop();
+void BalloonLayout::splitTree()
+{
+	const int n = m_node.size();
+	m_top.clear();
+	m_tasks.clear();
+	m_taskBegin.init(m_numberOfThreads + 1);
+
+	//subtrees of at most grain nodes become tasks, all
+	//nodes above them are processed sequentially
+	const int grain = m_numberOfThreads > 1 ? std::max(n / static_cast<int>(16*m_numberOfThreads), 1) : n;
+	for (int i = 0; i < n; ) {
+		if (m_subtreeEnd[i] - i <= grain) {
+			m_tasks.push(i);
+			i = m_subtreeEnd[i];
+		} else {
+			m_top.push(i++);
+		}
+	}
 
-					//compute radii
-					//inner radius estimate, outer currently holds sum of children
-					//we add the node object size to the radii
+	//thread t gets the tasks in the t-th part of the preorder
+	unsigned int t = 0;
+	m_taskBegin[0] = 0;
+	for (int k = 0; k < m_tasks.size(); ++k) {
+		unsigned int part = static_cast<unsigned int>(static_cast<long long>(m_tasks[k]) * m_numberOfThreads / n);
+		while (t < part)
+			m_taskBegin[++t] = k;
+	}
+	while (t < m_numberOfThreads)
+		m_taskBegin[++t] = m_tasks.size();
+}
 
-					//even angles: just sum up size of largest child
-					if (m_evenAngles)
-					{
-						m_radius[v] = max((m_maxChildRadius[v]/max(m_childCount[v], 1) +
-									m_estimateFactor*2.0*(m_childCount[v]*m_maxChildRadius[v]))/
-									(2*Math::pi), 2.0*m_size[v]);
-#ifdef OGDF_DEBUG
-						cout <<"Even angles \n";
-#endif
-					}
-					else
-					{
-						if (m_childCount[v] == 1)
-						{
-							m_radius[v] = max(2.0*m_size[v], 1.1*m_maxChildRadius[v]);
-#ifdef OGDF_DEBUG
-							AG.fillColor(v) = Color(0x33, 0x00, 0x00);
 
-							cout << "Radien mit einem Kind: "<< v->degree() <<" : "<<m_radius[v] << " "<< (m_maxChildRadius[v]/max(m_childCount[v], 4) +
-									m_estimateFactor*2.0*m_estimate[v])/
-									(2.0*Math::pi)<<" "<< 1.1*m_maxChildRadius[v]<<"\n";
+template<typename Function>
+void BalloonLayout::forAllBottomUp(Function f) const
+{
+	parallelFor(m_numberOfThreads, m_numberOfThreads, [&](int begin, int end, unsigned int) {
+		for (int t = m_taskBegin[begin]; t < m_taskBegin[end]; ++t) {
+			for (int i = m_subtreeEnd[m_tasks[t]] - 1; i >= m_tasks[t]; --i)
+				f(i);
+		}
+	});
+	for (int k = m_top.size() - 1; k >= 0; --k)
+		f(m_top[k]);
+}
 
-#endif
-						}
-						else
-						{
-						//better version:
-						m_radius[v] = max(max((m_maxChildRadius[v]/max(m_childCount[v], 4) +
-									m_estimateFactor*2.0*m_estimate[v])/
-									(2.0*Math::pi), 2*m_size[v]), 1.1*m_maxChildRadius[v]);
-#ifdef OGDF_DEBUG
-							cout << "Radien: "<< v->degree() <<" : "<<m_radius[v] << " "<< (m_maxChildRadius[v]/max(m_childCount[v], 4) +
-									m_estimateFactor*2.0*m_estimate[v])/
-									(2.0*Math::pi)<<" "<< 1.1*m_maxChildRadius[v]<<"\n";
-#endif
-#if 0
-						else
-						m_radius[v] = max((m_maxChildRadius[v]/max(m_childCount[v], 2) +
-									m_estimateFactor*2.0*m_estimate[v])/
-									(2.0*Math::pi), 2*m_size[v]);
-#endif
-						}
-					}//if even angles
-
-					//outer radius is inner radius + radius of largest child
-					double t;
-					//if there is only a single child, it will be placed
-					//on the same ray, therefore we do not need to reserve
-					//space for a circle (we only estimate the space needed
-					//here by taking the maximum instead of computing the
-					//real value, which would take the distance into account
-					if (m_childCount[v] == 1)
-					//parent radius should never be smaller!
-					{
-						t = max(m_radius[v], m_maxChildRadius[v]);
-#ifdef OGDF_DEBUG
-						if (m_radius[v]< m_maxChildRadius[v]) cout<<"\n\nParent radius is smaller!!\n";
-#endif
-					}
-					else
-						t = m_radius[v] + m_maxChildRadius[v];
 
-					//adjust parent values
-					node p = m_parent[v];
-					//Invariant: outer radius of children of p is already computed
-					if (p != nullptr)
-					{
-						//we sum up the outer radius values here at
-						//the parent node to compute the estimate for
-						//the inner radius later
-						m_estimate[p] += t;
-						//set the value for the largest child radius
-						if (m_maxChildRadius[p] < t)
-							m_maxChildRadius[p] = t;
-						//if all children are processed, push p into queue
-						if (--children[p] == 0)
-						{
-							//we processed all children of p
-							//and can derive the radius value
-							level.append(p);
-						}//if children == 0
-					}//if parent
-					m_oRadius[v] = t;
-				}
-			}//if more than one node
+template<typename Function>
+void BalloonLayout::forAllTopDown(Function f) const
+{
+	for (int i : m_top)
+		f(i);
+	parallelFor(m_numberOfThreads, m_numberOfThreads, [&](int begin, int end, unsigned int) {
+		for (int t = m_taskBegin[begin]; t < m_taskBegin[end]; ++t) {
+			for (int i = m_tasks[t]; i < m_subtreeEnd[m_tasks[t]]; ++i)
+				f(i);
 		}
-		break;
-	}//switch childorder
-#ifdef OGDF_DEBUG
-	checkTree(G, false);
-#endif
+	});
+}
+
+
+void BalloonLayout::computeRadii(const GraphAttributes &AG)
+{
+	const int n = m_node.size();
+	m_radius.init(0, n-1, 0.0);
+	m_oRadius.init(0, n-1, 0.0);
+	m_estimate.init(0, n-1, 0.0);
+	m_maxChildRadius.init(0, n-1, 0.0);
+	m_size.init(n);
+
+	parallelFor(m_numberOfThreads, n, [&](int begin, int end, unsigned int) {
+		for (int i = begin; i < end; ++i) {
+			double w = AG.width(m_node[i]);
+			double h = AG.height(m_node[i]);
+			double t = 0.5*sqrt(w*w+h*h);
+			m_size[i] = max(0.007, t); //assure we  don't have zero values, some default
+		}
+	});
+
+	if (n == 1) return;
+
+	//compute radii in SNS model bottom up, the order of the
+	//children does not matter here
+	//for leaves we use the smallest enclosing circle radius
+	//Using sqrt is quite slow, maybe an approximation will do
+	//r = 0.5*sqrt(w*w + h*h)
+	forAllBottomUp([&](int v) {
+		const int children = childCount(v);
+		if (children == 0) {
+			m_radius[v] = m_oRadius[v] = m_size[v];
+			return;
+		}
+
+		//we sum up the outer radius values of the children
+		//to compute the estimate for the inner radius, and
+		//keep the largest child radius
+		double estimate = 0.0;
+		double maxChildRadius = 0.0;
+		for (int k = m_childStart[v]; k < m_childStart[v+1]; ++k) {
+			double t = m_oRadius[m_child[k]];
+			estimate += t;
+			if (maxChildRadius < t)
+				maxChildRadius = t;
+		}
+		m_estimate[v] = estimate;
+		m_maxChildRadius[v] = maxChildRadius;
+
+		//compute radii
+		//we add the node object size to the radii
+		double radius;
+		if (m_evenAngles)
+		{
+			//even angles: just sum up size of largest child
+			radius = max((maxChildRadius/max(children, 1) +
+						m_estimateFactor*2.0*(children*maxChildRadius))/
+						(2*Math::pi), 2.0*m_size[v]);
+		}
+		else if (children == 1)
+		{
+			radius = max(2.0*m_size[v], 1.1*maxChildRadius);
+		}
+		else
+		{
+			radius = max(max((maxChildRadius/max(children, 4) +
+						m_estimateFactor*2.0*estimate)/
+						(2.0*Math::pi), 2*m_size[v]), 1.1*maxChildRadius);
+		}
+		m_radius[v] = radius;
+
+		//outer radius is inner radius + radius of largest child
+		//if there is only a single child, it will be placed
+		//on the same ray, therefore we do not need to reserve
+		//space for a circle (we only estimate the space needed
+		//here by taking the maximum instead of computing the
+		//real value, which would take the distance into account
+		if (children == 1)
+			m_oRadius[v] = max(radius, maxChildRadius);
+		else
+			m_oRadius[v] = radius + maxChildRadius;
+	});
 }//computeRadii
 
+
 void BalloonLayout::computeTree(const Graph &G)
 {
 	node v = G.firstNode();
-	m_parent.init(G, nullptr);
-	m_childCount.init(G, 0);
-	m_childList.init(G);
 
 	//if the graph is not a tree, compute some spanning tree
 	//and store the corresponding pointers in m_parent
@@ -423,310 +409,211 @@ void BalloonLayout::computeTree(const Graph &G)
 
 void BalloonLayout::computeBFSTree(const Graph &G, node v)
 {
-	SListPure<node> bfsqueue;
-	NodeArray<bool> marked(G, false);
-
-	bfsqueue.pushBack(v);
-
-	marked[v] =  true;
+	const int n = G.numberOfNodes();
+	m_pos.init(G, -1);
+	m_node.init(n);
+	m_parent.init(n);
+	m_childStart.init(n+1);
+	m_child.init(n-1);
 
 	m_treeRoot = v;
-
-	node w;
-
-	while (!bfsqueue.empty())
+	m_node[0] = v;
+	m_pos[v] = 0;
+	m_parent[0] = -1;
+
+	//the children of each node are discovered one after
+	//another, so they get consecutive BFS positions
+	int last = 1;
+	for (int i = 0; i < n; ++i)
 	{
-		w = bfsqueue.popFrontRet();
-
-		for(adjEntry adj : w->adjEntries) {
+		m_childStart[i] = last - 1;
 
-			edge e = adj->theEdge();
-			node u = e->opposite(w);
-			if (!marked[u])
+		for(adjEntry adj : m_node[i]->adjEntries) {
+			node u = adj->twinNode();
+			if (m_pos[u] < 0)
 			{
-				m_parent[u] = w;
-				m_childCount[w]++;
-				bfsqueue.pushBack(u);
-				m_childList[w].pushBack(u);
-
-				marked[u] = true;
-#ifdef OGDF_DEBUG
-				(*m_treeEdge)[e] = true;
-#endif
+				m_pos[u] = last;
+				m_node[last] = u;
+				m_parent[last] = i;
+				m_child[last - 1] = last;
+				++last;
 			}
 		}
-	}//while
-#ifdef OGDF_DEBUG
-	checkTree(G, true);
-#endif
+	}
+	m_childStart[n] = n - 1;
 }//computeBFSTree
 
 #ifdef OGDF_DEBUG
-void BalloonLayout::checkTree(const Graph &G, bool treeRoot)
+void BalloonLayout::checkTree(const Graph &G)
 {
-	//check the tree
-	//can each node be reached?
-	int testchecker = 0;
-	int listchecker = 0;
-	SListPure<node> testqueue;
-	testqueue.pushBack((treeRoot ? m_treeRoot : m_root));
-	while (!testqueue.empty())
-	{
-		node z = testqueue.popFrontRet();
-		testchecker++;
-		ListConstIterator<node> it = m_childList[z].begin();
-		while (it.valid() && (listchecker <= 2*G.numberOfNodes()))
-		{
-			listchecker++;
-			testqueue.pushBack((*it));
-			++it;
-		}//while
-	}//while
-	OGDF_ASSERT(G.numberOfNodes() == testchecker);
+	//each node has a single position, and parents
+	//and subtrees are consistent with the preorder
+	const int n = m_node.size();
+	OGDF_ASSERT(n == G.numberOfNodes());
+	OGDF_ASSERT(m_node[0] == m_root);
+	OGDF_ASSERT(m_parent[0] == -1);
+	OGDF_ASSERT(m_childStart[n] == n - 1);
+	for (int i = 0; i < n; ++i) {
+		OGDF_ASSERT(m_pos[m_node[i]] == i);
+		OGDF_ASSERT(i == 0 || m_parent[i] < i);
+		OGDF_ASSERT(i == 0 || m_subtreeEnd[i] <= m_subtreeEnd[m_parent[i]]);
+		int next = i + 1;
+		for (int k = m_childStart[i]; k < m_childStart[i+1]; ++k) {
+			OGDF_ASSERT(m_child[k] == next);
+			OGDF_ASSERT(m_parent[m_child[k]] == i);
+			next = m_subtreeEnd[m_child[k]];
+		}
+		OGDF_ASSERT(next == m_subtreeEnd[i]);
+	}
 }
 #endif
 
-void BalloonLayout::computeAngles(const Graph &G)
+void BalloonLayout::optimizeChildOrder(int p, ArrayBuffer<int> &sorted)
 {
-#ifdef OGDF_DEBUG
-	checkTree(G, false);
-	int checker = 0;
-#endif
-
-	m_angle.init(G, 0.0);
-	node v;
+	//the angle of a child grows with its outer radius; we sort
+	//the children by decreasing radius and then alternate between
+	//the largest and the smallest remaining ones, so that small
+	//subtrees lie between large ones (angular resolution) and the
+	//large subtrees are spread around p (aspect ratio)
+	sorted.clear();
+	for (int k = m_childStart[p]; k < m_childStart[p+1]; ++k)
+		sorted.push(m_child[k]);
+	std::sort(sorted.begin(), sorted.end(), [&](int a, int b) {
+		return m_oRadius[a] > m_oRadius[b] || (m_oRadius[a] == m_oRadius[b] && a < b);
+	});
+
+	int k = m_childStart[p];
+	for (int lo = 0, hi = sorted.size() - 1; lo <= hi; ) {
+		m_child[k++] = sorted[lo++];
+		if (lo <= hi)
+			m_child[k++] = sorted[hi--];
+	}
+}
 
-	v = m_root;
-	SListPure<node> queue;
-	queue.pushBack(v);
+void BalloonLayout::computeAngles(const Graph &G)
+{
+	const int n = m_node.size();
+	m_angle.init(0, n-1, 0.0);
+
+	//the angles of the children of a node only depend on
+	//the radii, so all nodes can be processed independently
+	parallelFor(m_numberOfThreads, n, [&](int begin, int end, unsigned int) {
+		ArrayBuffer<int> sorted;
+		for (int p = begin; p < end; ++p)
+		{
+			const int children = childCount(p);
+			if (children == 0) continue;
 
-	while (!queue.empty())
-	{
-		node p = queue.popFrontRet();
+			if (children == 1)
+			{
+				m_angle[m_child[m_childStart[p]]] = Math::pi;//not used currently, fixed to parent angle
+				continue;
+			}
 
-		//process children
+			if (m_childOrder == ChildOrder::Optimized)
+				optimizeChildOrder(p, sorted);
 
-		if (m_childCount[p] > 0)
-		{
 			double pestimate = m_estimate[p]; //the circumference estimate of the parent
 			double fullAngle = 2.0*Math::pi;  //angle that has to be shared by children
-			ListConstIterator<node> it = m_childList[p].begin();
-			if (m_childCount[p] == 1)
-			{
-				m_angle[*it] = Math::pi;//not used currently, fixed to parent angle
-				queue.pushBack(*it);
-#ifdef OGDF_DEBUG
-				checker++;
-#endif
-			}
-			else
+
+			//The outer radius of ONE of the children may be larger
+			//than half of the estimate, but we never assign more than
+			//pi, therefore we have to make two runs to check and correct
+			//this. If the outer radius is more than half of the parent's
+			//estimate, we only assign pi
+			if (!m_evenAngles)
 			{
-				//The outer radius of ONE of the children may be larger
-				//than half of the estimate, but we never assign more than
-				//pi, therefore we have to make two runs to check and correct
-				//this. If the outer radius is more than half of the parent's
-				//estimate, we only assign pi
-				if (!m_evenAngles)
+				for (int k = m_childStart[p]; k < m_childStart[p+1]; ++k)
 				{
-#ifdef OGDF_DEBUG
-					bool checkMulti = false;
-#endif
-					ListConstIterator<node> it2 = it;
-					while (it2.valid())
+					if (m_oRadius[m_child[k]]/m_estimate[p] > 0.501)
 					{
-						if (m_oRadius[*it2]/m_estimate[p]>0.501)
-						{
-#ifdef OGDF_DEBUG
-							if (checkMulti)
-								cout << "More than one large child vertex!\n";
-							checkMulti = true;
-#endif
-							pestimate = pestimate - m_oRadius[*it2];
-							fullAngle = Math::pi;
-#ifndef OGDF_DEBUG
-							break;
-#endif
-						}
-						++it2;
+						pestimate = pestimate - m_oRadius[m_child[k]];
+						fullAngle = Math::pi;
+						break;
 					}
 				}
-				while (it.valid())
-				{
-					v = (*it);
-					++it;
-
-#ifdef OGDF_DEBUG
-					checker++;
-#endif
-
-					if (m_evenAngles)
-					{
-						m_angle[v] = Math::pi*2.0/m_childCount[p];
-						queue.pushBack(v);
-					}
-					else
-					{
-						double anglesum = 0.0;
-#if 0
-						//erst alle Winkel aufaddieren und dann anteilig
-						//auf 2pi bzw. 100%
-						m_angle[v] = anglesum;
-#endif
-
-						queue.pushBack(v);
-
-						//Anteil an Plazierungsradius des Parent
-						//we use the diameter fraction of the estimate value
-						double ratio = m_oRadius[v]/m_estimate[p];
-						//restrict vertices to at most half of the space, otherwise.
-						//there will be an overlap
-						if (ratio > 0.501) anglesum = Math::pi;
-						else anglesum = fullAngle*m_oRadius[v]/pestimate;
-#if 0
-						cout<<"\nAnteil : "<<m_oRadius[v]/m_estimate[p]<<" bei Kindern: "<<m_childCount[p]<<"\n";
-#endif
-
-						m_angle[v] = anglesum;
-#ifdef OGDF_DEBUG
-						if (anglesum >Math::pi) cout << "Angle large than pi!!"<<anglesum<<"children"<< m_childCount[p]<<" full: "<<fullAngle<<"\n";
-#endif
-#if 0
-						cout <<"Set angle at "<<v->index()<<" "<<m_angle[v]<<"\n";
-#endif
-					}//else
+			}
 
-#if 0
-					it++;
-#endif
-				}//while children
-			}//else
-		}//if children
-	}//while queue
-	#ifdef OGDF_DEBUG
-	cout << "Checker computeAngles: "<<checker<<" Non: "<<G.numberOfNodes()<<"\n";
-	#endif
-
-	return;
+			for (int k = m_childStart[p]; k < m_childStart[p+1]; ++k)
+			{
+				int v = m_child[k];
+				if (m_evenAngles)
+				{
+					m_angle[v] = Math::pi*2.0/children;
+				}
+				else
+				{
+					//we use the diameter fraction of the estimate value
+					double ratio = m_oRadius[v]/m_estimate[p];
+					//restrict vertices to at most half of the space, otherwise.
+					//there will be an overlap
+					if (ratio > 0.501) m_angle[v] = Math::pi;
+					else m_angle[v] = fullAngle*m_oRadius[v]/pestimate;
+				}
+			}//for children
+		}
+	});
 }
 
 void BalloonLayout::computeCoordinates(GraphAttributes &AG)
 {
-#if 0
-	const Graph &G = AG.constGraph();
-#endif
-	node v;
+	const int n = m_node.size();
+	m_x.init(n);
+	m_y.init(n);
+	m_direction.init(n);
+
 	//place the nodes top down
 	//first root
-	v = m_root;
-	AG.x(v) = 0.0;
-	AG.y(v) = 0.0;
+	m_x[0] = 0.0;
+	m_y[0] = 0.0;
+	m_direction[0] = 0.0;
 
-	SListPure<node> queue;
-	queue.pushBack(v);
-#ifdef OGDF_DEBUG
-	cout<<"Processing queue \n";
-#if 0
-	for(node v : G.nodes)
-	{
-		cout<<"Angle "<<v<<" "<<m_angle[v]<<"\n";
-	}
-#endif
-#endif
-	while (!queue.empty())
-	{
-		node p = queue.popFrontRet();
-		double x = AG.x(p);
-		double y = AG.y(p);
-		//process children
+	forAllTopDown([&](int p) {
+		const int first = m_childStart[p];
+		const int stop = m_childStart[p+1];
+		if (first == stop) return;
 
-#if 0
-		cout <<"Pop Queue\n";
-#endif
-		if (m_childCount[p] > 0)
-		{
-			//we start at the parent's angle and skip half of the angle
-			//of the last element
-			double anglesum = fmod(m_angle[p]-Math::pi+
-				m_angle[*m_childList[p].begin()]/2.0, 2.0*Math::pi);//0.0;
-#if 0
-			double sumchecker = 0.0;// debug value
-			cout<<"Angle start offset: "<<anglesum<<"\n";
-#endif
-			ListConstIterator<node> it = m_childList[p].begin();
-			#ifdef OGDF_DEBUG
-			AG.fillColor(*it) = Color(0xab, 0x00, 0x07);
-			#endif
-			//special case if only a single child: Same direction as parent
-			if (m_childCount[p] == 1)
-			{
-				node w = (*it);
-				queue.pushBack(w);
-				anglesum = m_angle[p];
-				m_angle[w] = anglesum;
-				AG.x(w) = x+cos(anglesum)*m_radius[p];
-				AG.y(w) = y+sin(anglesum)*m_radius[p];
-#ifdef OGDF_DEBUG
-				AG.fillColor(w) = Color(0x00, 0xab, 0x00);
-#endif
-			}
-			else
-			while (it.valid())
-			{
-#if 0
-				cout<<"Next child\n";
-#endif
-				node w = (*it);
-				queue.pushBack(w);
+		const double x = m_x[p];
+		const double y = m_y[p];
 
-				++it;
-
-				node z;
-				if (it.valid()) z = (*it);
-				else z =  (*m_childList[p].begin());
-
-#if 0
-				cout <<w<<" "<< w->degree()<<" Winkel: "<<m_angle[w]<<" anglesum "<<anglesum <<"\n";
-				cout<<"angles..."<<anglesum<<"\n";
-#endif
+		//special case if only a single child: Same direction as parent
+		if (stop - first == 1)
+		{
+			int w = m_child[first];
+			m_direction[w] = m_direction[p];
+			m_x[w] = x+cos(m_direction[p])*m_radius[p];
+			m_y[w] = y+sin(m_direction[p])*m_radius[p];
+			return;
+		}
 
-				AG.x(w) = x+cos(anglesum)*m_radius[p];
+		//we start at the parent's angle and skip half of the angle
+		//of the first element
+		double anglesum = fmod(m_direction[p]-Math::pi+
+			m_angle[m_child[first]]/2.0, 2.0*Math::pi);
+		for (int k = first; k < stop; ++k)
+		{
+			int w = m_child[k];
+			m_x[w] = x+cos(anglesum)*m_radius[p];
+			m_y[w] = y+sin(anglesum)*m_radius[p];
 
-				AG.y(w) = y+sin(anglesum)*m_radius[p];
+			//assign the direction to w to allow its children to use it
+			m_direction[w] = anglesum;
 
-#if 0
-				sumchecker += m_angle[w];
-#endif
-				double s = m_angle[w];
-				//assign the direction to w to allow its children to use it
-				m_angle[w] = anglesum;
-
-				//z's value is the required angle, not the direction
-				anglesum = fmod((anglesum + (s+m_angle[z])/2.0), 2.0*Math::pi);
-#if 0
-				cout <<"Finished...\n";
-#endif
+			//the next child's value is the required angle, not the direction
+			if (k + 1 < stop)
+				anglesum = fmod((anglesum + (m_angle[w]+m_angle[m_child[k+1]])/2.0), 2.0*Math::pi);
+		}
+	});
 
-			}//while children
-#if 0
-			cout<<"\nWinkelgesamtsumme: "<<sumchecker<<" Anzahl Kinder: "<<m_childCount[p] <<"\n\n";
-#endif
-		}//if children
-	}//while queue
-	#ifdef OGDF_DEBUG
-	AG.fillColor(m_treeRoot) = Color::Name::Mediumblue;
-	//AG.fillColor(m_root) = "#BBCC00";
-	#endif
+	parallelFor(m_numberOfThreads, n, [&](int begin, int end, unsigned int) {
+		for (int i = begin; i < end; ++i) {
+			AG.x(m_node[i]) = m_x[i];
+			AG.y(m_node[i]) = m_y[i];
+		}
+	});
 	AG.clearAllBends();
 }
 
-#ifdef OGDF_DEBUG
-void BalloonLayout::check(Graph &G)
-{
-	checkTree(G, true);
-	//TODO: check angle
-}//Check
-#endif
-
 ostream &operator<<(ostream &os, const BalloonLayout::RootSelection &rs) {
 	switch (rs) {
 		case BalloonLayout::RootSelection::Center:        os << "Center";        break;
@@ -1155,4 +1155,22 @@ double BertaultLayout::nodeDistribution(GraphAttributes &AG)
 		return -1;
 }
 
+LayoutCostEstimate BertaultLayout::estimateCost(const GraphAttributes &GA) const
+{
+	const Graph &G = GA.constGraph();
+	const double n = G.numberOfNodes();
+	const double m = G.numberOfEdges();
+
+	// every iteration computes node-node and node-edge forces for all nodes
+	const double iterations = iter_no == 0 ? 10 * n : iter_no;
+
+	LayoutCostEstimate cost;
+	cost.peakMemory = LayoutCostEstimate::attributesMemory(GA) + n * (sizeof(BertaultSections) + 2 * sizeof(double));
+	cost.operations = iterations * n * (n + m);
+	cost.timeClass = iter_no == 0
+	  ? LayoutCostEstimate::TimeClass::Cubic
+	  : LayoutCostEstimate::TimeClass::Quadratic;
+	return cost;
+}
+
 }//namespace ogdf
@@ -34,9 +34,11 @@
 
 #include <ogdf/misclayout/CircularLayout.h>
 #include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/basic/ArrayBuffer.h>
 #include <ogdf/basic/Queue.h>
 #include <ogdf/basic/tuples.h>
 #include <ogdf/packing/TileToRowsCCPacker.h>
+#include <algorithm>
 
 
 
@@ -103,7 +105,7 @@ struct ClusterStructure
 	void initCluster(int nCluster, const Array<int> &parent);
 
 	void sortChildren(int i,
-		List<node> &nodes,
+		const ArrayBuffer<node> &nodes,
 		Array<List<int> > &posList,
 		Array<double> &parentWeight,
 		Array<double> &dirFromParent,
@@ -111,7 +113,7 @@ struct ClusterStructure
 
 	int numberOfCluster() const { return m_nodesIn.size(); }
 
-	void resetNodes(int cluster, const List<node> &nodes);
+	void resetNodes(int cluster, const ArrayBuffer<node> &nodes);
 
 	const Graph &m_G;
 	Array<SList<node> > m_nodesIn;
@@ -126,7 +128,7 @@ struct ClusterStructure
 };
 
 
-void ClusterStructure::resetNodes(int cluster, const List<node> &nodes)
+void ClusterStructure::resetNodes(int cluster, const ArrayBuffer<node> &nodes)
 {
 	OGDF_ASSERT(m_nodesIn[cluster].size() == nodes.size());
 
@@ -134,9 +136,8 @@ void ClusterStructure::resetNodes(int cluster, const List<node> &nodes)
 
 	L.clear();
 
-	ListConstIterator<node> it;
-	for(it = nodes.begin(); it.valid(); ++it)
-		L.pushBack(*it);
+	for(node v : nodes)
+		L.pushBack(v);
 }
 
 
@@ -159,7 +160,7 @@ void ClusterStructure::initCluster(int nCluster, const Array<int> &parent)
 
 void ClusterStructure::sortChildren(
 	int i,
-	List<node> &nodes,
+	const ArrayBuffer<node> &nodes,
 	Array<List<int> > &posList,
 	Array<double> &parentWeight,
 	Array<double> &dirFromParent,
@@ -172,12 +173,11 @@ void ClusterStructure::sortChildren(
 		posList[parent].clear();
 
 	int pos = 0;
-	ListConstIterator<node> it;
-	for(it = nodes.begin(); it.valid(); ++it)
+	for(node v : nodes)
 	{
-		for(adjEntry adj : (*it)->adjEntries) {
+		for(adjEntry adj : v->adjEntries) {
 			edge e = adj->theEdge();
-			node w = e->opposite(*it);
+			node w = e->opposite(v);
 			if (m_clusterOf[w] != i)
 				posList[m_clusterOf[w]].pushBack(pos);
 		}
@@ -296,210 +296,346 @@ struct InfoAC
 };
 
 
-class CircleGraph : public Graph
+//! The subgraph induced by a cluster, stored in flat adjacency arrays.
+/**
+ * The nodes of the cluster are numbered 0, ..., n-1 in the order of
+ * ClusterStructure::m_nodesIn. The adjacency lists contain the edges in the
+ * order in which a graph would create them by iterating over the out-edges of
+ * these nodes. All buffers are reused for the next cluster.
+ */
+class CircleGraph
 {
 public:
-	CircleGraph(const ClusterStructure &C, NodeArray<node> &toCircle, int c);
+	explicit CircleGraph(const ClusterStructure &C) : m_C(C), m_toCircle(C, -1), m_n(0) { }
+
+	//! Builds the subgraph induced by cluster \p c.
+	void init(int c);
+
+	//! Orders the nodes on the circle, paths of a DFS tree are placed consecutively.
+	/**
+	 * Afterwards, the nodes are renumbered by their position on the circle.
+	 */
+	void order(Array<int> &circle);
 
-	void order(List<node> &nodeList);
-	void swapping(List<node> &nodeList, int maxIterations);
+	//! Swaps neighbours on the circle as long as this saves crossings, for at most \p maxIterations rounds.
+	void swapping(Array<int> &circle, int maxIterations);
 
-	node fromCircle(node vCircle) const { return m_fromCircle[vCircle]; }
+	int numberOfNodes() const { return m_n; }
+
+	node fromCircle(int vCircle) const { return m_fromCircle[vCircle]; }
 
 private:
-	NodeArray<node> m_fromCircle;
-
-	void dfs(
-		NodeArray<int>  &depth,
-		NodeArray<node> &father,
-		node v,
-		node f,
-		int d);
+	const ClusterStructure &m_C;
+	NodeArray<int> m_toCircle;
+	int m_n;
+
+	Array<node> m_fromCircle;
+	Array<int> m_adjStart;  //!< adjacency list of i is m_adj[m_adjStart[i], m_adjStart[i+1])
+	Array<int> m_adj;
+
+	// the above for renumbering
+	Array<node> m_fromCircleBuffer;
+	Array<int> m_adjStartBuffer, m_adjBuffer;
+
+	// buffers
+	Array<int> m_depth, m_father, m_next, m_pos;
+	Array<int> m_bucketStart;
+	ArrayBuffer<Tuple2<int,int>> m_stack;
+	ArrayBuffer<int> m_posX, m_posY;
+
+	//! Computes depth (starting with 1) and father of each node in a DFS tree rooted at node 0.
+	void dfs();
+
+	//! Returns how many crossings are saved by swapping the neighbours \p u and \p v on the circle.
+	int64_t savedCrossings(int u, int v);
+
+	template<typename T>
+	static void reserve(Array<T> &a, int size) {
+		if (a.size() < size) {
+			a.init(size);
+		}
+	}
 };
 
 
-CircleGraph::CircleGraph(
-	const ClusterStructure &C,
-	NodeArray<node> &toCircle,
-	int c)
+void CircleGraph::init(int c)
 {
-	m_fromCircle.init(*this);
+	const SList<node> &nodes = m_C.m_nodesIn[c];
+	m_n = nodes.size();
+	reserve(m_fromCircle, m_n);
+	reserve(m_adjStart, m_n + 1);
+
+	int i = 0;
+	for (node v : nodes) {
+		m_fromCircle[i] = v;
+		m_toCircle[v] = i++;
+	}
 
-	SListConstIterator<node> it;
-	for(it = C.m_nodesIn[c].begin(); it.valid(); ++it)
-	{
-		node vCircle = newNode();
-		toCircle    [*it]     = vCircle;
-		m_fromCircle[vCircle] = *it;
+	// count the degrees within the cluster, self-loops are ignored
+	for (i = 0; i <= m_n; ++i) {
+		m_adjStart[i] = 0;
 	}
+	for (i = 0; i < m_n; ++i) {
+		node v = m_fromCircle[i];
+		for (adjEntry adj : v->adjEntries) {
+			edge e = adj->theEdge();
+			node w = e->target();
+			if (w == v) continue;
 
-	for(it = C.m_nodesIn[c].begin(); it.valid(); ++it)
-	{
-		for(adjEntry adj : (*it)->adjEntries) {
+			if (m_C.m_clusterOf[w] == c) {
+				++m_adjStart[i + 1];
+				++m_adjStart[m_toCircle[w] + 1];
+			}
+		}
+	}
+	for (i = 0; i < m_n; ++i) {
+		m_adjStart[i + 1] += m_adjStart[i];
+	}
+
+	// fill the adjacency lists in the order of edge creation
+	reserve(m_adj, m_adjStart[m_n]);
+	reserve(m_next, m_n);
+	for (i = 0; i < m_n; ++i) {
+		m_next[i] = m_adjStart[i];
+	}
+	for (i = 0; i < m_n; ++i) {
+		node v = m_fromCircle[i];
+		for (adjEntry adj : v->adjEntries) {
 			edge e = adj->theEdge();
 			node w = e->target();
-			if (w == *it) continue;
+			if (w == v) continue;
 
-			if(C.m_clusterOf[w] == c)
-				newEdge(toCircle[*it],toCircle[w]);
+			if (m_C.m_clusterOf[w] == c) {
+				int j = m_toCircle[w];
+				m_adj[m_next[i]++] = j;
+				m_adj[m_next[j]++] = i;
+			}
 		}
 	}
 }
 
 
-class DepthBucket : public BucketFunc<node>
+void CircleGraph::dfs()
 {
-public:
-	explicit DepthBucket(const NodeArray<int> &depth) : m_depth(depth) { }
-
-	int getBucket(const node &v) override
-	{
-		return -m_depth[v];
+	reserve(m_depth, m_n);
+	reserve(m_father, m_n);
+	for (int i = 0; i < m_n; ++i) {
+		m_depth[i] = 0;
+		m_father[i] = -1;
 	}
 
-	// undefined methods to avoid automatic creation
-	DepthBucket(const DepthBucket &);
-	DepthBucket &operator=(const DepthBucket &);
+	// pairs of node and next adjacency to consider
+	m_stack.clear();
+	m_depth[0] = 1;
+	m_stack.push(Tuple2<int,int>(0, m_adjStart[0]));
+	while (!m_stack.empty()) {
+		Tuple2<int,int> &top = m_stack.top();
+		const int v = top.x1();
+		if (top.x2() == m_adjStart[v + 1]) {
+			m_stack.pop();
+			continue;
+		}
 
-private:
-	const NodeArray<int> &m_depth;
-};
+		const int w = m_adj[top.x2()++];
+		if (w == m_father[v] || m_depth[w] != 0) continue;
+
+		m_depth[w] = m_depth[v] + 1;
+		m_father[w] = v;
+		m_stack.push(Tuple2<int,int>(w, m_adjStart[w]));
+	}
+}
 
 
 // Idee: Benutzung von outerplanarity (nachschlagen!)
-void CircleGraph::order(List<node> &nodeList)
+void CircleGraph::order(Array<int> &circle)
 {
-	NodeArray<int>  depth  (*this,0);
-	NodeArray<node> father (*this);
-
-	dfs(depth, father, firstNode(), nullptr, 1);
-
-	SListPure<node> circleNodes;
-	allNodes(circleNodes);
-
-	DepthBucket bucket(depth);
-	circleNodes.bucketSort(-numberOfNodes(),0,bucket);
+	reserve(circle, m_n);
+	dfs();
 
-	NodeArray<bool> visited(*this,false);
+	// stable bucket sort by decreasing depth
+	reserve(m_bucketStart, m_n + 2);
+	for (int d = 0; d <= m_n + 1; ++d) {
+		m_bucketStart[d] = 0;
+	}
+	for (int i = 0; i < m_n; ++i) {
+		++m_bucketStart[m_n - m_depth[i] + 1];
+	}
+	for (int d = 0; d <= m_n; ++d) {
+		m_bucketStart[d + 1] += m_bucketStart[d];
+	}
+	reserve(m_pos, m_n);
+	for (int i = 0; i < m_n; ++i) {
+		m_pos[m_bucketStart[m_n - m_depth[i]]++] = i;
+	}
 
-	ListIterator<node> itCombined;
+	// follow the path from each node to the first visited node and concatenate
+	// the paths; the first path stopping at the root is inserted after the root
+	Array<int> &next = m_next;
+	Array<int> &visited = m_depth;
+	const int none = -1;
+	int head = none, tail = none, combined = none;
 	bool combinedAtRoot = false;
 
-	SListConstIterator<node> it;
-	for(it = circleNodes.begin(); it.valid(); ++it)
+	for (int k = 0; k < m_n; ++k)
 	{
-		node v = *it;
-		List<node> currentPath;
-
-		ListIterator<node> itInserted;
-		while(v != nullptr && !visited[v])
-		{
-			visited[v] = true;
-			itInserted = currentPath.pushBack(v);
-			v = father[v];
+		int v = m_pos[k];
+		if (visited[v] < 0) continue;
+
+		int pathStart = v, last = none;
+		while (v != none && visited[v] >= 0) {
+			visited[v] = -1;
+			next[v] = m_father[v];
+			last = v;
+			v = m_father[v];
 		}
 
-		if(v && father[v] == nullptr && !combinedAtRoot) {
+		if (v != none && m_father[v] == none && !combinedAtRoot) {
 			combinedAtRoot = true;
 
-			while(!currentPath.empty())
-				currentPath.moveToSucc(currentPath.begin(),nodeList,itCombined);
+			for (int w = pathStart, succ; w != v; w = succ) {
+				succ = next[w];
+				next[w] = next[combined];
+				next[combined] = w;
+				if (tail == combined) {
+					tail = w;
+				}
+			}
 
 		} else {
-			if (v == nullptr)
-				itCombined = itInserted;
+			if (v == none) {
+				combined = last;
+			}
 
-			nodeList.conc(currentPath);
+			next[last] = none;
+			if (tail == none) {
+				head = pathStart;
+			} else {
+				next[tail] = pathStart;
+			}
+			tail = last;
 		}
 	}
-}
 
-void CircleGraph::dfs(
-	NodeArray<int>  &depth,
-	NodeArray<node> &father,
-	node v,
-	node f,
-	int d)
-{
-	if (depth[v] != 0)
-		return;
-
-	depth [v] = d;
-	father[v] = f;
-
-	for(adjEntry adj : v->adjEntries) {
-		edge e = adj->theEdge();
-		node w = e->opposite(v);
-		if(w == f) continue;
-
-		dfs(depth,father,w,v,d+1);
+	int k = 0;
+	for (int v = head; v != none; v = next[v]) {
+		circle[k++] = v;
+	}
+	OGDF_ASSERT(k == m_n);
+
+	// renumber the nodes by their position, neighbours on the circle are then close in memory
+	Array<int> &newIndex = m_pos;
+	reserve(m_fromCircleBuffer, m_n);
+	reserve(m_adjStartBuffer, m_n + 1);
+	reserve(m_adjBuffer, m_adjStart[m_n]);
+	for (k = 0; k < m_n; ++k) {
+		newIndex[circle[k]] = k;
 	}
+	m_adjStartBuffer[0] = 0;
+	for (k = 0; k < m_n; ++k) {
+		const int v = circle[k];
+		int j = m_adjStartBuffer[k];
+		for (int i = m_adjStart[v]; i < m_adjStart[v + 1]; ++i) {
+			m_adjBuffer[j++] = newIndex[m_adj[i]];
+		}
+		m_adjStartBuffer[k + 1] = j;
+		m_fromCircleBuffer[k] = m_fromCircle[v];
+		circle[k] = k;
+	}
+	std::swap(m_fromCircle, m_fromCircleBuffer);
+	std::swap(m_adjStart, m_adjStartBuffer);
+	std::swap(m_adj, m_adjBuffer);
 }
 
 
-void CircleGraph::swapping(List<node> &nodeList, int maxIterations)
+int64_t CircleGraph::savedCrossings(int u, int v)
 {
-	ListIterator<node> it;
-
-	if (nodeList.size() >= 3)
-	{
-		NodeArray<int> pos(*this);
-		const int n = numberOfNodes();
-
-		int currentPos = 0;
-		for(it = nodeList.begin(); it.valid(); ++it)
-			pos[*it] = currentPos++;
-
-		int iterations = 0;
-		bool improvement;
-		do {
-			improvement = false;
-
-			for(it = nodeList.begin(); it.valid(); ++it)
-			{
-				ListIterator<node> itNext = nodeList.cyclicSucc(it);
-
-				node u = *it, v = *itNext;
-				// we fake a numbering around the circle starting with u at pos. 0
-				// using the formula: (pos[t]-offset) % n
-				// and pos[u] + offset = n
-				int offset = n - pos[u];
+	// we fake a numbering around the circle starting with u at pos. 0
+	const int n = m_n;
+	const int posU = m_pos[u];
+	auto relativePos = [&](int t) {
+		const int p = m_pos[t] - posU;
+		return (p < 0) ? p + n : p;
+	};
+	const int beginU = m_adjStart[u], endU = m_adjStart[u + 1];
+	const int beginV = m_adjStart[v], endV = m_adjStart[v + 1];
+
+	// edges ux and vy cross after the swap iff posX < posY, common neighbours do not count
+	int64_t improvementCrossings = 0;
+	if (int64_t(endU - beginU) * (endV - beginV) <= 8 * (endU - beginU + endV - beginV)) {
+		for (int i = beginU; i < endU; ++i) {
+			const int x = m_adj[i];
+			if (x == v) continue;
+
+			const int posX = relativePos(x);
+			for (int j = beginV; j < endV; ++j) {
+				const int y = m_adj[j];
+				if (y == u || y == x) continue;
+
+				const int posY = relativePos(y);
+				improvementCrossings += (posX > posY) ? -1 : 1;
+			}
+		}
+		return improvementCrossings;
+	}
 
-				// we count how many crossings we save when swapping u and v
-				int improvementCrosings = 0;
+	// high degrees: compare the sorted positions of both neighbourhoods
+	m_posX.clear();
+	for (int i = beginU; i < endU; ++i) {
+		if (m_adj[i] != v) {
+			m_posX.push(relativePos(m_adj[i]));
+		}
+	}
+	m_posY.clear();
+	for (int j = beginV; j < endV; ++j) {
+		if (m_adj[j] != u) {
+			m_posY.push(relativePos(m_adj[j]));
+		}
+	}
+	std::sort(m_posX.begin(), m_posX.end());
+	std::sort(m_posY.begin(), m_posY.end());
+
+	const int sizeY = m_posY.size();
+	int less = 0, lessOrEqual = 0;
+	for (int posX : m_posX) {
+		while (less < sizeY && m_posY[less] < posX) {
+			++less;
+		}
+		lessOrEqual = std::max(lessOrEqual, less);
+		while (lessOrEqual < sizeY && m_posY[lessOrEqual] == posX) {
+			++lessOrEqual;
+		}
+		improvementCrossings += (sizeY - lessOrEqual) - less;
+	}
+	return improvementCrossings;
+}
 
-				for(adjEntry adj : u->adjEntries) {
-					edge ux = adj->theEdge();
-					node x = ux->opposite(u);
-					if(x == v) continue;
 
-					int posX = (pos[x] + offset) % n;
+void CircleGraph::swapping(Array<int> &circle, int maxIterations)
+{
+	const int n = m_n;
+	if (n < 3) return;
 
-					for(adjEntry adjV : v->adjEntries) {
-						edge vy = adjV->theEdge();
-						node y = vy->opposite(v);
-						if (y == u || y == x) continue;
+	for (int i = 0; i < n; ++i) {
+		m_pos[circle[i]] = i;
+	}
 
-						int posY = (pos[y] + offset) % n;
+	int iterations = 0;
+	bool improvement;
+	do {
+		improvement = false;
 
-						if(posX > posY)
-							--improvementCrosings;
-						else
-							++improvementCrosings;
-					}
-				}
+		for (int i = 0; i < n; ++i)
+		{
+			const int j = (i + 1 == n) ? 0 : i + 1;
+			const int u = circle[i], v = circle[j];
 
-				if(improvementCrosings > 0) {
-					improvement = true;
-					swap(*it,*itNext);
-					swap(pos[u],pos[v]);
-				}
+			if (savedCrossings(u, v) > 0) {
+				improvement = true;
+				std::swap(circle[i], circle[j]);
+				std::swap(m_pos[u], m_pos[v]);
 			}
-		} while(improvement && ++iterations <= maxIterations);
-	}
-
-	for(it = nodeList.begin(); it.valid(); ++it)
-		*it = m_fromCircle[*it];
+		}
+	} while (improvement && ++iterations <= maxIterations);
 }
 
 
@@ -757,7 +893,9 @@ void CircularLayout::doCall(GraphCopyAttributes &AG, ClusterStructure &C)
 
 	int mainSite = C.m_mainSiteCluster.front();
 
-	NodeArray<node> toCircle(C);
+	CircleGraph GC(C);
+	Array<int> circle;
+	ArrayBuffer<node> nodes;
 
 	Queue<int> queue;
 	queue.append(mainSite);
@@ -771,12 +909,14 @@ void CircularLayout::doCall(GraphCopyAttributes &AG, ClusterStructure &C)
 	{
 		int cluster = queue.pop();
 
-		CircleGraph GC(C, toCircle, cluster);
+		GC.init(cluster);
 
 		// order nodes on circle
-		List<node> nodes;
-		GC.order(nodes);
-		GC.swapping(nodes,50);
+		GC.order(circle);
+		GC.swapping(circle,50);
+		nodes.clear();
+		for(int k = 0; k < GC.numberOfNodes(); ++k)
+			nodes.push(GC.fromCircle(circle[k]));
 		C.resetNodes(cluster, nodes);
 #ifdef OUTPUT
 		cout << "after swapping of " << cluster << ": " << nodes << endl;
@@ -1599,28 +1739,38 @@ void CircularLayout::computePreferedAngles(
 	const int nCluster = C.numberOfCluster();
 	const int mainSite = C.m_mainSiteCluster.front();
 
-	Array<int> level(nCluster);
-	Queue<int> Q;
-
-	level[mainSite] = 0;
-	Q.append(mainSite);
+	// clusters in BFS order and the inner radius of their level
+	Array<int> bfsOrder(nCluster);
+	Array<double> r1(nCluster);
+	int numOrdered = 0;
 
-	while(!Q.empty())
+	bfsOrder[numOrdered++] = mainSite;
+	for(int k = 0; k < numOrdered; ++k)
 	{
-		int c = Q.pop();
+		int c = bfsOrder[k];
 
-		int nLevel = level[c]+1;
+		double rChild = (c == mainSite) ? outerRadius[mainSite]+m_minDistLevel
+		                                : r1[c] + m_minDistLevel + 2*outerRadius[c];
 		ListConstIterator<int> it;
 		for(it = C.m_childCluster[c].begin(); it.valid(); ++it) {
-			level[*it] = nLevel;
-			Q.append(*it);
+			r1[*it] = rChild;
+			bfsOrder[numOrdered++] = *it;
 		}
 	}
 
-	ListConstIterator<int> it;
-	for(it = C.m_childCluster[mainSite].begin(); it.valid(); ++it)
-		assignPrefAngle(C,outerRadius,preferedAngle,
-			*it,1,outerRadius[mainSite]+m_minDistLevel);
+	// children are handled before their parent
+	for(int k = numOrdered-1; k > 0; --k)
+	{
+		int c = bfsOrder[k];
+		double maxPrefChild = 0;
+
+		ListConstIterator<int> it;
+		for(it = C.m_childCluster[c].begin(); it.valid(); ++it)
+			maxPrefChild += preferedAngle[*it];
+
+		double rc = r1[c] + outerRadius[c];
+		preferedAngle[c] = max(2*asin((outerRadius[c] + m_minDistSibling/2)/rc), maxPrefChild);
+	}
 
 #ifdef OUTPUT
 	cout << "\nprefered angles:" << endl;
@@ -1629,34 +1779,6 @@ void CircularLayout::computePreferedAngles(
 #endif
 }
 
-void CircularLayout::assignPrefAngle(ClusterStructure &C,
-	const Array<double> &outerRadius,
-	Array<double> &preferedAngle,
-	int c,
-	int l,
-	double r1)
-{
-	double maxPrefChild = 0;
-
-	ListConstIterator<int> it;
-	for(it = C.m_childCluster[c].begin(); it.valid(); ++it) {
-		assignPrefAngle(C,outerRadius,preferedAngle,
-			*it,l+1,r1 + m_minDistLevel + 2*outerRadius[c]);
-#if 0
-		if(preferedAngle[*it] > maxPrefChild)
-			maxPrefChild = preferedAngle[*it];
-#endif
-		maxPrefChild += preferedAngle[*it];
-	}
-
-	double rc = r1 + outerRadius[c];
-#if 0
-	preferedAngle[c] = max((2*outerRadius[c] + m_minDistSibling) / rc, maxPrefChild);
-#else
-	preferedAngle[c] = max(2*asin((outerRadius[c] + m_minDistSibling/2)/rc), maxPrefChild);
-#endif
-}
-
 
 // assigns the biconnected components of the graph as clusters
 void CircularLayout::assignClustersByBiconnectedComponents(ClusterStructure &C)
@@ -0,0 +1,350 @@
+/** \file
+ * \brief Implementation of class OverlapRemovalLayout
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/misclayout/OverlapRemovalLayout.h>
+#include <ogdf/basic/SpatialIndex.h>
+#include <ogdf/basic/Tracer.h>
+#include <ogdf/basic/Math.h>
+
+namespace ogdf {
+
+namespace {
+
+// maximal stretch of an overlapping pair per round, as proposed for PRISM
+const double s_maxStretch = 1.5;
+
+// relative amount by which overlapping pairs are pushed beyond touching, so
+// that pairs do not get stuck at the boundary due to rounding
+const double s_overshoot = 0.01;
+
+// maximal number of conjugate gradient iterations per round
+const int s_solverIterations = 50;
+
+// residual relative to the initial one at which the conjugate gradient method stops
+const double s_solverTolerance = 1e-3;
+
+// Returns the factor by which the distance of u and v has to grow such that
+// their rectangles are at least sep apart, or 1 if they already are.
+double overlapFactor(const GraphAttributes &GA, node u, node v, double sep)
+{
+	const double dx = std::abs(GA.x(u) - GA.x(v));
+	const double dy = std::abs(GA.y(u) - GA.y(v));
+	const double w = (GA.width(u) + GA.width(v)) / 2 + sep;
+	const double h = (GA.height(u) + GA.height(v)) / 2 + sep;
+	if (dx >= w || dy >= h) {
+		return 1.0;
+	}
+	if (dx == 0.0) {
+		return h / dy;
+	}
+	if (dy == 0.0) {
+		return w / dx;
+	}
+	return std::min(w / dx, h / dy);
+}
+
+// Solves L x = b with conjugate gradients, where L is the Laplacian of the
+// proximity graph with the given edge weights and x holds the initial guess.
+void solveLaplacian(const std::vector<int> &offset, const std::vector<int> &adjacent,
+		const std::vector<double> &weight, const std::vector<double> &b, std::vector<double> &x)
+{
+	const int n = static_cast<int>(x.size());
+	std::vector<double> r(n), p(n), q(n);
+
+	auto multiply = [&](const std::vector<double> &v, std::vector<double> &result) {
+		for (int i = 0; i < n; ++i) {
+			double sum = 0.0;
+			for (int k = offset[i]; k < offset[i + 1]; ++k) {
+				sum += weight[k] * (v[i] - v[adjacent[k]]);
+			}
+			result[i] = sum;
+		}
+	};
+
+	multiply(x, q);
+	double rr = 0.0;
+	for (int i = 0; i < n; ++i) {
+		r[i] = p[i] = b[i] - q[i];
+		rr += r[i] * r[i];
+	}
+
+	const double tolerance = s_solverTolerance * s_solverTolerance * rr;
+	for (int iteration = 0; iteration < s_solverIterations && rr > tolerance; ++iteration) {
+		multiply(p, q);
+		double pq = 0.0;
+		for (int i = 0; i < n; ++i) {
+			pq += p[i] * q[i];
+		}
+		if (pq <= 0.0) {
+			break;
+		}
+
+		const double alpha = rr / pq;
+		double rrNew = 0.0;
+		for (int i = 0; i < n; ++i) {
+			x[i] += alpha * p[i];
+			r[i] -= alpha * q[i];
+			rrNew += r[i] * r[i];
+		}
+		const double beta = rrNew / rr;
+		for (int i = 0; i < n; ++i) {
+			p[i] = r[i] + beta * p[i];
+		}
+		rr = rrNew;
+	}
+}
+
+// Moves nodes sharing their position onto a small spiral, since the stress
+// model cannot separate coincident nodes.
+void separateCoincidentNodes(GraphAttributes &GA, Array<node> nodes, double radius)
+{
+	std::sort(nodes.begin(), nodes.end(), [&](node u, node v) {
+		return GA.x(u) < GA.x(v) || (GA.x(u) == GA.x(v) && GA.y(u) < GA.y(v));
+	});
+
+	for (int i = 1, k = 0; i < nodes.size(); ++i) {
+		const node u = nodes[i - 1 - k], v = nodes[i];
+		if (GA.x(u) == GA.x(v) && GA.y(u) == GA.y(v)) {
+			++k;
+			const double angle = k * 2.399963229728653; // golden angle
+			GA.x(v) += radius * std::sqrt(k) * std::cos(angle);
+			GA.y(v) += radius * std::sqrt(k) * std::sin(angle);
+		} else {
+			k = 0;
+		}
+	}
+}
+
+// Scales the drawing uniformly if its bounding box is smaller than the total
+// area of the nodes, since no overlap-free drawing can exist then. Local
+// stress sweeps spread such dense drawings only slowly.
+void scaleToNodeArea(GraphAttributes &GA, const Array<node> &nodes)
+{
+	double minX = GA.x(nodes[0]), maxX = minX, minY = GA.y(nodes[0]), maxY = minY;
+	double area = 0.0;
+	for (node v : nodes) {
+		minX = std::min(minX, GA.x(v));
+		maxX = std::max(maxX, GA.x(v));
+		minY = std::min(minY, GA.y(v));
+		maxY = std::max(maxY, GA.y(v));
+		area += GA.width(v) * GA.height(v);
+	}
+
+	const double boxArea = (maxX - minX) * (maxY - minY);
+	if (boxArea <= 0.0 || boxArea >= area) {
+		return;
+	}
+	const double scale = std::sqrt(area / boxArea);
+	const double centerX = (minX + maxX) / 2, centerY = (minY + maxY) / 2;
+	for (node v : nodes) {
+		GA.x(v) = centerX + scale * (GA.x(v) - centerX);
+		GA.y(v) = centerY + scale * (GA.y(v) - centerY);
+	}
+}
+
+}
+
+
+OverlapRemovalLayout::OverlapRemovalLayout()
+	: m_separation(4.0)
+	, m_maxIterations(500)
+	, m_neighbours(4)
+{ }
+
+
+int OverlapRemovalLayout::proximityEdges(const GraphAttributes &GA, const NodeArray<int> &index, std::vector<ProximityEdge> &edges) const
+{
+	const SpatialIndex spatial(GA);
+	ArrayBuffer<node> hits;
+	int overlaps = 0;
+
+	for (node v : GA.constGraph().nodes) {
+		const double w = GA.width(v) / 2 + m_separation, h = GA.height(v) / 2 + m_separation;
+		const DPoint p(GA.x(v), GA.y(v));
+
+		hits.clear();
+		spatial.nodesInBox(DRect(p.m_x - w, p.m_y - h, p.m_x + w, p.m_y + h), hits);
+		for (node u : hits) {
+			if (index[u] <= index[v]) {
+				continue;
+			}
+			const double t = overlapFactor(GA, u, v, m_separation);
+			if (t > 1.0) {
+				++overlaps;
+				const double length = p.distance(DPoint(GA.x(u), GA.y(u)));
+				edges.push_back({index[v], index[u], std::min(t * (1 + s_overshoot), s_maxStretch) * length});
+			}
+		}
+
+		hits.clear();
+		spatial.nearestNodes(p, m_neighbours + 1, hits);
+		for (node u : hits) {
+			if (u != v) {
+				const double length = p.distance(DPoint(GA.x(u), GA.y(u)));
+				edges.push_back({std::min(index[u], index[v]), std::max(index[u], index[v]), length});
+			}
+		}
+	}
+	return overlaps;
+}
+
+
+int OverlapRemovalLayout::numberOfOverlaps(const GraphAttributes &GA) const
+{
+	const SpatialIndex spatial(GA);
+	ArrayBuffer<node> hits;
+	int overlaps = 0;
+
+	for (node v : GA.constGraph().nodes) {
+		const double w = GA.width(v) / 2 + m_separation, h = GA.height(v) / 2 + m_separation;
+		hits.clear();
+		spatial.nodesInBox(DRect(GA.x(v) - w, GA.y(v) - h, GA.x(v) + w, GA.y(v) + h), hits);
+		for (node u : hits) {
+			if (u->index() > v->index() && overlapFactor(GA, u, v, m_separation) > 1.0) {
+				++overlaps;
+			}
+		}
+	}
+	return overlaps;
+}
+
+
+void OverlapRemovalLayout::call(GraphAttributes &GA)
+{
+	OGDF_TRACE_SCOPE("OverlapRemovalLayout::call");
+
+	const Graph &G = GA.constGraph();
+	const int n = G.numberOfNodes();
+	if (n < 2) {
+		return;
+	}
+
+	NodeArray<int> index(G);
+	Array<node> nodes(n);
+	double averageSize = 0.0;
+	int i = 0;
+	for (node v : G.nodes) {
+		nodes[i] = v;
+		index[v] = i++;
+		averageSize += GA.width(v) + GA.height(v);
+	}
+	averageSize /= 2 * n;
+	separateCoincidentNodes(GA, nodes, std::max(averageSize, m_separation) / 100);
+	scaleToNodeArea(GA, nodes);
+
+	std::vector<ProximityEdge> edges;
+	std::vector<int> offset(n + 1);
+	std::vector<int> adjacent;
+	std::vector<double> length;
+	std::vector<double> weight;
+	std::vector<double> x(n), y(n), bx(n), by(n);
+
+	for (int round = 0; round < m_maxIterations; ++round) {
+		edges.clear();
+		if (proximityEdges(GA, index, edges) == 0) {
+			break;
+		}
+
+		// keep the longest desired length of each pair
+		std::sort(edges.begin(), edges.end(), [](const ProximityEdge &a, const ProximityEdge &b) {
+			return a.source < b.source || (a.source == b.source && (a.target < b.target
+			    || (a.target == b.target && a.length > b.length)));
+		});
+		edges.erase(std::unique(edges.begin(), edges.end(), [](const ProximityEdge &a, const ProximityEdge &b) {
+			return a.source == b.source && a.target == b.target;
+		}), edges.end());
+
+		// store the proximity graph in compressed adjacency arrays
+		std::fill(offset.begin(), offset.end(), 0);
+		for (const ProximityEdge &e : edges) {
+			++offset[e.source + 1];
+			++offset[e.target + 1];
+		}
+		for (int v = 0; v < n; ++v) {
+			offset[v + 1] += offset[v];
+		}
+		adjacent.resize(2 * edges.size());
+		length.resize(2 * edges.size());
+		weight.resize(2 * edges.size());
+		std::vector<int> next(offset.begin(), offset.end() - 1);
+		for (const ProximityEdge &e : edges) {
+			adjacent[next[e.source]] = e.target;
+			length[next[e.source]++] = e.length;
+			adjacent[next[e.target]] = e.source;
+			length[next[e.target]++] = e.length;
+		}
+
+		for (int v = 0; v < n; ++v) {
+			x[v] = GA.x(nodes[v]);
+			y[v] = GA.y(nodes[v]);
+		}
+
+		// one stress majorization step with weights 1/d^2
+		std::fill(bx.begin(), bx.end(), 0.0);
+		std::fill(by.begin(), by.end(), 0.0);
+		for (int v = 0; v < n; ++v) {
+			for (int k = offset[v]; k < offset[v + 1]; ++k) {
+				const int u = adjacent[k];
+				const double dx = x[v] - x[u], dy = y[v] - y[u];
+				const double distance = std::sqrt(dx * dx + dy * dy);
+				weight[k] = length[k] > 0.0 ? 1.0 / (length[k] * length[k]) : 0.0;
+				if (distance > 0.0) {
+					bx[v] += weight[k] * length[k] * dx / distance;
+					by[v] += weight[k] * length[k] * dy / distance;
+				}
+			}
+		}
+		solveLaplacian(offset, adjacent, weight, bx, x);
+		solveLaplacian(offset, adjacent, weight, by, y);
+
+		for (int v = 0; v < n; ++v) {
+			GA.x(nodes[v]) = x[v];
+			GA.y(nodes[v]) = y[v];
+		}
+	}
+}
+
+
+LayoutCostEstimate OverlapRemovalLayout::estimateCost(const GraphAttributes &GA) const
+{
+	const Graph &G = GA.constGraph();
+	const double n = G.numberOfNodes();
+
+	// every round builds a spatial index and runs the sweeps over the proximity graph
+	const double degree = m_neighbours + 4;
+	LayoutCostEstimate cost;
+	cost.peakMemory = LayoutCostEstimate::attributesMemory(GA)
+	  + n * (sizeof(node) + 2 * sizeof(int) + 2 * sizeof(double))
+	  + n * degree * (sizeof(ProximityEdge) + 2 * (sizeof(int) + sizeof(double)));
+	cost.operations = m_maxIterations * n * (std::log2(std::max(n, 2.0)) * degree + 2 * s_solverIterations * degree);
+	cost.timeClass = LayoutCostEstimate::TimeClass::Loglinear;
+	return cost;
+}
+
+}
@@ -30,68 +30,339 @@
  */
 
 #include <ogdf/misclayout/ProcrustesSubLayout.h>
+#include <ogdf/basic/SIMDKernel.h>
+#include <random>
+
+#ifdef OGDF_SIMD_X86
+#include <immintrin.h>
+#endif
+#ifdef OGDF_SIMD_WASM
+#include <wasm_simd128.h>
+#endif
 
 namespace ogdf {
 
-//! Creates an instance of circular layout.
-ProcrustesSubLayout::ProcrustesSubLayout(LayoutModule* pSubLayout) : m_pSubLayout(pSubLayout), m_scaleToInitialLayout(true)
+namespace {
+
+//! Number of independent partial sums in the reference implementation, allowing for vectorization.
+constexpr int LANES = 4;
+
+//! The first and second moments of two point sets \a p and \a q.
+struct Moments {
+	enum { PX, PY, QX, QY, PP, QQ, QXPX, QXPY, QYPX, QYPY, NUM };
+	double sum[NUM] = {};
+
+	Moments &operator+=(const Moments &other) {
+		for (int k = 0; k < NUM; ++k) {
+			sum[k] += other.sum[k];
+		}
+		return *this;
+	}
+};
+
+//! Adds the contribution of point \p i to \p m.
+inline void addMoments(int i,
+	const double *px, const double *py, const double *qx, const double *qy,
+	Moments &m)
 {
-	// nothing
+	m.sum[Moments::PX] += px[i];
+	m.sum[Moments::PY] += py[i];
+	m.sum[Moments::QX] += qx[i];
+	m.sum[Moments::QY] += qy[i];
+	m.sum[Moments::PP] += px[i] * px[i] + py[i] * py[i];
+	m.sum[Moments::QQ] += qx[i] * qx[i] + qy[i] * qy[i];
+	m.sum[Moments::QXPX] += qx[i] * px[i];
+	m.sum[Moments::QXPY] += qx[i] * py[i];
+	m.sum[Moments::QYPX] += qy[i] * px[i];
+	m.sum[Moments::QYPY] += qy[i] * py[i];
 }
 
-void ProcrustesSubLayout::copyFromGraphAttributes(const GraphAttributes& graphAttributes, ProcrustesPointSet& pointSet)
+//! Signature of the kernels adding the moments of the points [0, n) to m.
+using AddMoments = void(int n,
+	const double *px, const double *py, const double *qx, const double *qy,
+	Moments &m);
+
+//! Portable implementation of #AddMoments, independent partial sums allow for auto-vectorization.
+void addMomentsScalar(int n,
+	const double *px, const double *py, const double *qx, const double *qy,
+	Moments &m)
 {
-	const Graph& graph = graphAttributes.constGraph();
+	Moments lanes[LANES];
 	int i = 0;
-	for (node v = graph.firstNode(); v; v = v->succ())
-	{
-		pointSet.set(i, graphAttributes.x(v), graphAttributes.y(v));
-		i++;
+	for (; i + LANES <= n; i += LANES) {
+		for (int l = 0; l < LANES; ++l) {
+			addMoments(i + l, px, py, qx, qy, lanes[l]);
+		}
 	}
+	for (; i < n; ++i) {
+		addMoments(i, px, py, qx, qy, lanes[0]);
+	}
+	lanes[0] += lanes[1];
+	lanes[2] += lanes[3];
+	lanes[0] += lanes[2];
+	m += lanes[0];
 }
 
-void ProcrustesSubLayout::translate(GraphAttributes& graphAttributes, double dx, double dy)
+#ifdef OGDF_SIMD_X86
+//! SSE2 implementation of #AddMoments.
+OGDF_SIMD_TARGET("sse2")
+void addMomentsSSE2(int n,
+	const double *px, const double *py, const double *qx, const double *qy,
+	Moments &m)
 {
-	const Graph& graph = graphAttributes.constGraph();
-	for (node v = graph.firstNode(); v; v = v->succ())
-	{
-		graphAttributes.x(v) += dx;
-		graphAttributes.y(v) += dy;
+	__m128d acc[Moments::NUM];
+	for (int k = 0; k < Moments::NUM; ++k) {
+		acc[k] = _mm_setzero_pd();
+	}
+	int i = 0;
+	for (; i + 2 <= n; i += 2) {
+		const __m128d vpx = _mm_loadu_pd(px + i);
+		const __m128d vpy = _mm_loadu_pd(py + i);
+		const __m128d vqx = _mm_loadu_pd(qx + i);
+		const __m128d vqy = _mm_loadu_pd(qy + i);
+		acc[Moments::PX] = _mm_add_pd(acc[Moments::PX], vpx);
+		acc[Moments::PY] = _mm_add_pd(acc[Moments::PY], vpy);
+		acc[Moments::QX] = _mm_add_pd(acc[Moments::QX], vqx);
+		acc[Moments::QY] = _mm_add_pd(acc[Moments::QY], vqy);
+		acc[Moments::PP] = _mm_add_pd(acc[Moments::PP], _mm_add_pd(_mm_mul_pd(vpx, vpx), _mm_mul_pd(vpy, vpy)));
+		acc[Moments::QQ] = _mm_add_pd(acc[Moments::QQ], _mm_add_pd(_mm_mul_pd(vqx, vqx), _mm_mul_pd(vqy, vqy)));
+		acc[Moments::QXPX] = _mm_add_pd(acc[Moments::QXPX], _mm_mul_pd(vqx, vpx));
+		acc[Moments::QXPY] = _mm_add_pd(acc[Moments::QXPY], _mm_mul_pd(vqx, vpy));
+		acc[Moments::QYPX] = _mm_add_pd(acc[Moments::QYPX], _mm_mul_pd(vqy, vpx));
+		acc[Moments::QYPY] = _mm_add_pd(acc[Moments::QYPY], _mm_mul_pd(vqy, vpy));
+	}
+	for (; i < n; ++i) {
+		addMoments(i, px, py, qx, qy, m);
+	}
+
+	// lambdas would not inherit the target, so the lanes are summed explicitly
+	double a[2];
+	for (int k = 0; k < Moments::NUM; ++k) {
+		_mm_storeu_pd(a, acc[k]);
+		m.sum[k] += a[0] + a[1];
 	}
 }
 
-void ProcrustesSubLayout::rotate(GraphAttributes& graphAttributes, double angle)
+//! AVX2 implementation of #AddMoments using fused multiply-add.
+OGDF_SIMD_TARGET("avx2,fma")
+void addMomentsAVX2(int n,
+	const double *px, const double *py, const double *qx, const double *qy,
+	Moments &m)
 {
-	const Graph& graph = graphAttributes.constGraph();
-	for (node v = graph.firstNode(); v; v = v->succ())
-	{
-		double x = cos(angle)*graphAttributes.x(v) - sin(angle)*graphAttributes.y(v);
-		double y = sin(angle)*graphAttributes.x(v) + cos(angle)*graphAttributes.y(v);
-		graphAttributes.x(v) = x;
-		graphAttributes.y(v) = y;
+	__m256d acc[Moments::NUM];
+	for (int k = 0; k < Moments::NUM; ++k) {
+		acc[k] = _mm256_setzero_pd();
+	}
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m256d vpx = _mm256_loadu_pd(px + i);
+		const __m256d vpy = _mm256_loadu_pd(py + i);
+		const __m256d vqx = _mm256_loadu_pd(qx + i);
+		const __m256d vqy = _mm256_loadu_pd(qy + i);
+		acc[Moments::PX] = _mm256_add_pd(acc[Moments::PX], vpx);
+		acc[Moments::PY] = _mm256_add_pd(acc[Moments::PY], vpy);
+		acc[Moments::QX] = _mm256_add_pd(acc[Moments::QX], vqx);
+		acc[Moments::QY] = _mm256_add_pd(acc[Moments::QY], vqy);
+		acc[Moments::PP] = _mm256_fmadd_pd(vpy, vpy, _mm256_fmadd_pd(vpx, vpx, acc[Moments::PP]));
+		acc[Moments::QQ] = _mm256_fmadd_pd(vqy, vqy, _mm256_fmadd_pd(vqx, vqx, acc[Moments::QQ]));
+		acc[Moments::QXPX] = _mm256_fmadd_pd(vqx, vpx, acc[Moments::QXPX]);
+		acc[Moments::QXPY] = _mm256_fmadd_pd(vqx, vpy, acc[Moments::QXPY]);
+		acc[Moments::QYPX] = _mm256_fmadd_pd(vqy, vpx, acc[Moments::QYPX]);
+		acc[Moments::QYPY] = _mm256_fmadd_pd(vqy, vpy, acc[Moments::QYPY]);
+	}
+	for (; i < n; ++i) {
+		addMoments(i, px, py, qx, qy, m);
+	}
+
+	double a[4];
+	for (int k = 0; k < Moments::NUM; ++k) {
+		_mm256_storeu_pd(a, acc[k]);
+		m.sum[k] += (a[0] + a[1]) + (a[2] + a[3]);
 	}
 }
 
-void ProcrustesSubLayout::scale(GraphAttributes& graphAttributes, double scale)
+//! AVX-512 implementation of #AddMoments.
+OGDF_SIMD_TARGET("avx512f")
+void addMomentsAVX512(int n,
+	const double *px, const double *py, const double *qx, const double *qy,
+	Moments &m)
 {
-	const Graph& graph = graphAttributes.constGraph();
-	for (node v = graph.firstNode(); v; v = v->succ())
-	{
-		graphAttributes.x(v) *= scale;
-		graphAttributes.y(v) *= scale;
+	__m512d acc[Moments::NUM];
+	for (int k = 0; k < Moments::NUM; ++k) {
+		acc[k] = _mm512_setzero_pd();
+	}
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		const __m512d vpx = _mm512_loadu_pd(px + i);
+		const __m512d vpy = _mm512_loadu_pd(py + i);
+		const __m512d vqx = _mm512_loadu_pd(qx + i);
+		const __m512d vqy = _mm512_loadu_pd(qy + i);
+		acc[Moments::PX] = _mm512_add_pd(acc[Moments::PX], vpx);
+		acc[Moments::PY] = _mm512_add_pd(acc[Moments::PY], vpy);
+		acc[Moments::QX] = _mm512_add_pd(acc[Moments::QX], vqx);
+		acc[Moments::QY] = _mm512_add_pd(acc[Moments::QY], vqy);
+		acc[Moments::PP] = _mm512_fmadd_pd(vpy, vpy, _mm512_fmadd_pd(vpx, vpx, acc[Moments::PP]));
+		acc[Moments::QQ] = _mm512_fmadd_pd(vqy, vqy, _mm512_fmadd_pd(vqx, vqx, acc[Moments::QQ]));
+		acc[Moments::QXPX] = _mm512_fmadd_pd(vqx, vpx, acc[Moments::QXPX]);
+		acc[Moments::QXPY] = _mm512_fmadd_pd(vqx, vpy, acc[Moments::QXPY]);
+		acc[Moments::QYPX] = _mm512_fmadd_pd(vqy, vpx, acc[Moments::QYPX]);
+		acc[Moments::QYPY] = _mm512_fmadd_pd(vqy, vpy, acc[Moments::QYPY]);
+	}
+	for (; i < n; ++i) {
+		addMoments(i, px, py, qx, qy, m);
+	}
+
+	double a[8];
+	for (int k = 0; k < Moments::NUM; ++k) {
+		_mm512_storeu_pd(a, acc[k]);
+		m.sum[k] += ((a[0] + a[1]) + (a[2] + a[3])) + ((a[4] + a[5]) + (a[6] + a[7]));
 	}
 }
+#endif
 
-void ProcrustesSubLayout::flipY(GraphAttributes& graphAttributes)
+#ifdef OGDF_SIMD_WASM
+//! WebAssembly SIMD implementation of #AddMoments.
+void addMomentsWasm(int n,
+	const double *px, const double *py, const double *qx, const double *qy,
+	Moments &m)
 {
-	const Graph& graph = graphAttributes.constGraph();
-	for (node v = graph.firstNode(); v; v = v->succ())
-	{
-		graphAttributes.y(v) = -graphAttributes.y(v);
+	v128_t acc[Moments::NUM];
+	for (int k = 0; k < Moments::NUM; ++k) {
+		acc[k] = wasm_f64x2_splat(0.0);
+	}
+	int i = 0;
+	for (; i + 2 <= n; i += 2) {
+		const v128_t vpx = wasm_v128_load(px + i);
+		const v128_t vpy = wasm_v128_load(py + i);
+		const v128_t vqx = wasm_v128_load(qx + i);
+		const v128_t vqy = wasm_v128_load(qy + i);
+		acc[Moments::PX] = wasm_f64x2_add(acc[Moments::PX], vpx);
+		acc[Moments::PY] = wasm_f64x2_add(acc[Moments::PY], vpy);
+		acc[Moments::QX] = wasm_f64x2_add(acc[Moments::QX], vqx);
+		acc[Moments::QY] = wasm_f64x2_add(acc[Moments::QY], vqy);
+		acc[Moments::PP] = wasm_f64x2_add(acc[Moments::PP], wasm_f64x2_add(wasm_f64x2_mul(vpx, vpx), wasm_f64x2_mul(vpy, vpy)));
+		acc[Moments::QQ] = wasm_f64x2_add(acc[Moments::QQ], wasm_f64x2_add(wasm_f64x2_mul(vqx, vqx), wasm_f64x2_mul(vqy, vqy)));
+		acc[Moments::QXPX] = wasm_f64x2_add(acc[Moments::QXPX], wasm_f64x2_mul(vqx, vpx));
+		acc[Moments::QXPY] = wasm_f64x2_add(acc[Moments::QXPY], wasm_f64x2_mul(vqx, vpy));
+		acc[Moments::QYPX] = wasm_f64x2_add(acc[Moments::QYPX], wasm_f64x2_mul(vqy, vpx));
+		acc[Moments::QYPY] = wasm_f64x2_add(acc[Moments::QYPY], wasm_f64x2_mul(vqy, vpy));
+	}
+	for (; i < n; ++i) {
+		addMoments(i, px, py, qx, qy, m);
+	}
+
+	for (int k = 0; k < Moments::NUM; ++k) {
+		m.sum[k] += wasm_f64x2_extract_lane(acc[k], 0) + wasm_f64x2_extract_lane(acc[k], 1);
+	}
+}
+#endif
+
+//! Two random point sets for the self-test and the benchmark of the kernels.
+struct MomentsInput {
+	Array<double> px, py, qx, qy;
+
+	explicit MomentsInput(int n) : px(n), py(n), qx(n), qy(n) {
+		std::minstd_rand rng(n);
+		std::uniform_real_distribution<double> position(-100, 100);
+		for (int i = 0; i < n; ++i) {
+			px[i] = position(rng);
+			py[i] = position(rng);
+			qx[i] = position(rng);
+			qy[i] = position(rng);
+		}
+	}
+
+	Moments moments(AddMoments *kernel) const {
+		Moments m;
+		kernel(px.size(), &px[0], &py[0], &qx[0], &qy[0], m);
+		return m;
+	}
+};
+
+//! Returns the implementations of #AddMoments, from the least to the most advanced instruction set.
+std::vector<SIMDKernel<AddMoments>::Variant> addMomentsVariants()
+{
+	std::vector<SIMDKernel<AddMoments>::Variant> variants = {{"scalar", 0, &addMomentsScalar}};
+#ifdef OGDF_SIMD_X86
+	variants.push_back({"sse2", static_cast<unsigned int>(CPUFeatureMask::SSE2), &addMomentsSSE2});
+	variants.push_back({"avx2", static_cast<unsigned int>(CPUFeatureMask::AVX2) | static_cast<unsigned int>(CPUFeatureMask::FMA), &addMomentsAVX2});
+	variants.push_back({"avx512", static_cast<unsigned int>(CPUFeatureMask::AVX512F), &addMomentsAVX512});
+#endif
+#ifdef OGDF_SIMD_WASM
+	variants.push_back({"wasm-simd128", static_cast<unsigned int>(CPUFeatureMask::WASM_SIMD128), &addMomentsWasm});
+#endif
+	return variants;
+}
+
+bool checkAddMoments(AddMoments *variant, AddMoments *reference)
+{
+	// small and odd sizes exercise the remainder loops
+	for (int n : {1, 2, 7, 1001}) {
+		MomentsInput input(n);
+		Moments a = input.moments(variant);
+		Moments b = input.moments(reference);
+		for (int k = 0; k < Moments::NUM; ++k) {
+			if (std::fabs(a.sum[k] - b.sum[k]) > 1e-9 * std::max(std::fabs(a.sum[k]), std::fabs(b.sum[k])) + 1e-12) {
+				return false;
+			}
+		}
 	}
+	return true;
+}
+
+void addMomentsWorkload(AddMoments *variant)
+{
+	static const MomentsInput input(4096);
+	volatile double sink = 0;
+	for (int i = 0; i < 64; ++i) {
+		sink = sink + input.moments(variant).sum[Moments::QXPY];
+	}
+}
+
+SIMDKernel<AddMoments> addMomentsKernel("ProcrustesSubLayout moments", addMomentsVariants(), checkAddMoments, addMomentsWorkload);
+
+}
+
+ProcrustesSubLayout::ProcrustesSubLayout(LayoutModule* pSubLayout)
+	: m_pSubLayout(pSubLayout), m_scaleToInitialLayout(true), m_numAnchors(0)
+{
+	// nothing
+}
+
+void ProcrustesSubLayout::selectAnchors(const Graph& graph)
+{
+	const int n = graph.numberOfNodes();
+	const int k = (m_numAnchors == 0 || m_numAnchors > n) ? n : m_numAnchors;
+	if (m_anchors.size() != k) {
+		m_anchors.init(k);
+	}
+
+	// take the node at which the k-th fraction of the node list is exceeded
+	int i = 0, j = 0;
+	for (node v = graph.firstNode(); v && j < k; v = v->succ(), ++i) {
+		if ((static_cast<long long>(i) + 1) * k / n > j) {
+			m_anchors[j++] = v;
+		}
+	}
+}
+
+DPoint ProcrustesSubLayout::copyAnchors(const GraphAttributes& graphAttributes, Array<double>& x, Array<double>& y) const
+{
+	const int k = m_anchors.size();
+	if (x.size() != k) {
+		x.init(k);
+		y.init(k);
+	}
+
+	// coordinates are taken relative to the first anchor, which avoids cancellation in the second moments
+	const DPoint ref(graphAttributes.x(m_anchors[0]), graphAttributes.y(m_anchors[0]));
+	for (int i = 0; i < k; ++i) {
+		x[i] = graphAttributes.x(m_anchors[i]) - ref.m_x;
+		y[i] = graphAttributes.y(m_anchors[i]) - ref.m_y;
+	}
+	return ref;
 }
 
-//! Computes a circular layout for graph attributes \p graphAttributes.
 void ProcrustesSubLayout::call(GraphAttributes& graphAttributes)
 {
 	// any layout?
@@ -99,55 +370,58 @@ void ProcrustesSubLayout::call(GraphAttributes& graphAttributes)
 		return;
 
 	const Graph& graph = graphAttributes.constGraph();
+	if (graph.empty()) {
+		m_pSubLayout->call(graphAttributes);
+		return;
+	}
 
-	// the nodes as points from the initial layout before
-	ProcrustesPointSet initialPointSet(graph.numberOfNodes());
-	copyFromGraphAttributes(graphAttributes, initialPointSet);
-	initialPointSet.normalize();
+	// the anchors as points from the initial layout before
+	selectAnchors(graph);
+	const DPoint initialRef = copyAnchors(graphAttributes, m_initialX, m_initialY);
 
 	// call the layout algorithm
 	m_pSubLayout->call(graphAttributes);
 
-	// two new pointsets, one which holds the new layout
-	ProcrustesPointSet newPointSet(graph.numberOfNodes());
-	copyFromGraphAttributes(graphAttributes, newPointSet);
-	newPointSet.normalize();
-	newPointSet.rotateTo(initialPointSet);
-
-	// and one which holds the new layout with flipped y coords
-	ProcrustesPointSet newFlippedPointSet(graph.numberOfNodes());
-	copyFromGraphAttributes(graphAttributes, newFlippedPointSet);
-	newFlippedPointSet.normalize(true);
-	newFlippedPointSet.rotateTo(initialPointSet);
-
-	// which layout is better
-	bool useFlippedLayout = initialPointSet.compare(newFlippedPointSet) < initialPointSet.compare(newPointSet);
-	double scaleFactor = initialPointSet.scale();
-	if (useFlippedLayout)
-	{
-		reverseTransform(graphAttributes, newFlippedPointSet);
-		if (!m_scaleToInitialLayout)
-			scaleFactor = newFlippedPointSet.scale();
-	}
-	else
-	{
-		reverseTransform(graphAttributes, newPointSet);
-		if (!m_scaleToInitialLayout)
-			scaleFactor = newFlippedPointSet.scale();
-	}
+	const DPoint newRef = copyAnchors(graphAttributes, m_newX, m_newY);
+	Moments m;
+	addMomentsKernel(m_anchors.size(), &m_initialX[0], &m_initialY[0], &m_newX[0], &m_newY[0], m);
 
-	// everything is uniform and rotated. now get back to the initial layout
-	scale(graphAttributes, scaleFactor);
-	translate(graphAttributes, initialPointSet.originX(), initialPointSet.originY());
-}
+	// avg centers and root mean square distances to them
+	const double num = m_anchors.size();
+	const DPoint initialCenter(m.sum[Moments::PX] / num, m.sum[Moments::PY] / num);
+	const DPoint newCenter(m.sum[Moments::QX] / num, m.sum[Moments::QY] / num);
+	auto rmsd = [&](double squares, const DPoint &center) {
+		const double variance = squares / num - (center.m_x * center.m_x + center.m_y * center.m_y);
+		return (num > 1 && variance > 0) ? std::sqrt(variance) : 1.0;
+	};
+	const double initialScale = rmsd(m.sum[Moments::PP], initialCenter);
+	const double newScale = rmsd(m.sum[Moments::QQ], newCenter);
 
-void ProcrustesSubLayout::reverseTransform(GraphAttributes& graphAttributes, const ProcrustesPointSet& pointSet)
-{
-	translate(graphAttributes, -pointSet.originX(), -pointSet.originY());
-	if (pointSet.isFlipped())
-		flipY(graphAttributes);
-	scale(graphAttributes, 1.0/pointSet.scale());
-	rotate(graphAttributes, pointSet.angle());
+	// cross covariance of the centered point sets
+	const double sxx = m.sum[Moments::QXPX] - num * newCenter.m_x * initialCenter.m_x;
+	const double sxy = m.sum[Moments::QXPY] - num * newCenter.m_x * initialCenter.m_y;
+	const double syx = m.sum[Moments::QYPX] - num * newCenter.m_y * initialCenter.m_x;
+	const double syy = m.sum[Moments::QYPY] - num * newCenter.m_y * initialCenter.m_y;
+
+	// the optimal rotation of the new layout and of the new layout with flipped y coords,
+	// the remaining squared distance decreases with the length of (a, b)
+	const double a = sxy - syx, b = sxx + syy;
+	const double aFlipped = sxy + syx, bFlipped = sxx - syy;
+	const bool useFlippedLayout = aFlipped * aFlipped + bFlipped * bFlipped > a * a + b * b;
+	const double angle = useFlippedLayout ? atan2(aFlipped, bFlipped) : atan2(a, b);
+
+	// move every node by the same similarity transform
+	const double scaleFactor = m_scaleToInitialLayout ? initialScale / newScale : 1.0;
+	const double cosScaled = cos(angle) * scaleFactor, sinScaled = sin(angle) * scaleFactor;
+	const double flip = useFlippedLayout ? -1.0 : 1.0;
+	const DPoint from = newRef + newCenter;
+	const DPoint to = initialRef + initialCenter;
+	for (node v : graph.nodes) {
+		const double dx = graphAttributes.x(v) - from.m_x;
+		const double dy = flip * (graphAttributes.y(v) - from.m_y);
+		graphAttributes.x(v) = to.m_x + cosScaled * dx - sinScaled * dy;
+		graphAttributes.y(v) = to.m_y + sinScaled * dx + cosScaled * dy;
+	}
 }
 
 ProcrustesPointSet::ProcrustesPointSet(int numPoints) :
@@ -35,6 +35,7 @@
 #include <ogdf/orthogonal/OrthoShaper.h>
 #include <ogdf/orthogonal/FlowCompaction.h>
 #include <ogdf/orthogonal/EdgeRouter.h>
+#include <ogdf/basic/Tracer.h>
 
 
 namespace ogdf {
@@ -100,7 +101,10 @@ void OrthoLayout::call(PlanRep &PG,
 	OFG.traditional(!m_progressive);
 	OFG.setBendBound(m_bendBound);
 
-	OFG.call(PG,E,OR);
+	{
+		OGDF_TRACE_SCOPE("OrthoLayout::shape");
+		OFG.call(PG,E,OR);
+	}
 
 
 	// PHASE 2: construction of a feasible drawing of the expanded graph
@@ -142,20 +146,27 @@ void OrthoLayout::call(PlanRep &PG,
 	OGDF_ASSERT(pInfoExp);
 
 	FlowCompaction fca;
-	fca.constructiveHeuristics(PG,OR,rcGrid,gridDrawing);
+	{
+		OGDF_TRACE_SCOPE("OrthoLayout::constructiveCompaction");
+		fca.constructiveHeuristics(PG,OR,rcGrid,gridDrawing);
+	}
 
 	OR.undissect();
 
 	// call flow compaction on grid
 	FlowCompaction fc;
 	fc.scalingSteps(m_scalingSteps);
-	fc.improvementHeuristics(PG, OR, rcGrid, gridDrawing);
+	{
+		OGDF_TRACE_SCOPE("OrthoLayout::flowCompaction");
+		fc.improvementHeuristics(PG, OR, rcGrid, gridDrawing);
+	}
 
 
 	// PHASE 3: routing of edges
 
 	MinimumEdgeDistances<int> minDistGrid(PG, gridDrawing.toGrid(separation));
 	{
+		OGDF_TRACE_SCOPE("OrthoLayout::edgeRouting");
 		EdgeRouter router;
 		router.call(PG, OR, gridDrawing, E, rcGrid, minDistGrid, gridDrawing.width(), gridDrawing.height());
 	}
@@ -166,7 +177,10 @@ void OrthoLayout::call(PlanRep &PG,
 	// PHASE 4: apply improvement compaction heuristics
 
 	// call flow compaction on grid
-	fc.improvementHeuristics(PG, OR, minDistGrid, gridDrawing, int(gridDrawing.toGrid(m_separation)));
+	{
+		OGDF_TRACE_SCOPE("OrthoLayout::improvementCompaction");
+		fc.improvementHeuristics(PG, OR, minDistGrid, gridDrawing, int(gridDrawing.toGrid(m_separation)));
+	}
 
 
 	// re-map result
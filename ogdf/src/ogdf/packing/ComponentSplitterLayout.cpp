@@ -35,7 +35,9 @@
 #include <ogdf/graphalg/ConvexHull.h>
 //used for splitting
 #include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/basic/extended_graph_alg.h>
 #include <ogdf/basic/GraphCopy.h>
+#include <ogdf/basic/Tracer.h>
 
 
 namespace ogdf {
@@ -53,6 +55,7 @@ void ComponentSplitterLayout::call(GraphAttributes &GA)
 	// Only do preparations and call if layout is valid
 	if (m_secondaryLayout)
 	{
+		OGDF_TRACE_SCOPE("ComponentSplitterLayout::call");
 		//first we split the graph into its components
 		const Graph& G = GA.constGraph();
 
@@ -93,7 +96,10 @@ void ComponentSplitterLayout::call(GraphAttributes &GA)
 					cGA.doubleWeight(e) = GA.doubleWeight(GC.original(e));
 				}
 			}
-			m_secondaryLayout->call(cGA);
+			{
+				OGDF_TRACE_SCOPE("ComponentSplitterLayout::componentLayout");
+				m_secondaryLayout->call(cGA);
+			}
 
 			//copy layout information back into GA
 			for(node v : GC.nodes)
@@ -111,7 +117,10 @@ void ComponentSplitterLayout::call(GraphAttributes &GA)
 		}
 
 		// rotate component drawings and call the packer
-		reassembleDrawings(GA, nodesInCC);
+		{
+			OGDF_TRACE_SCOPE("ComponentSplitterLayout::reassembleDrawings");
+			reassembleDrawings(GA, nodesInCC);
+		}
 
 	}//if valid
 }
@@ -351,5 +360,54 @@ void ComponentSplitterLayout::reassembleDrawings(GraphAttributes& GA, const Arra
 #endif
 }
 
+LayoutCostEstimate ComponentSplitterLayout::estimateCost(const GraphAttributes &GA) const
+{
+	const Graph &G = GA.constGraph();
+	LayoutCostEstimate cost = LayoutModule::estimateCost(GA);
+	if (G.empty() || !m_secondaryLayout) {
+		return cost;
+	}
+
+	// estimate the secondary layout on the largest component only
+	NodeArray<int> component(G);
+	int numberOfComponents = connectedComponents(G, component);
+	Array<int> size(0, numberOfComponents - 1, 0);
+	for (node v : G.nodes) {
+		++size[component[v]];
+	}
+
+	int largest = 0;
+	double sumSquared = 0.0;
+	for (int i = 0; i < numberOfComponents; ++i) {
+		sumSquared += double(size[i]) * size[i];
+		if (size[i] > size[largest]) {
+			largest = i;
+		}
+	}
+
+	List<node> nodes;
+	for (node v : G.nodes) {
+		if (component[v] == largest) {
+			nodes.pushBack(v);
+		}
+	}
+	Graph H;
+	NodeArray<node> nodeMap;
+	inducedSubGraph(G, nodes.begin(), H, nodeMap);
+	GraphAttributes HA(H, GA.attributes());
+
+	// the components are laid out one after another, so the memory of the
+	// largest is the peak and the time scales with the component sizes
+	LayoutCostEstimate secondary = m_secondaryLayout->estimateCost(HA);
+	const double nmax = size[largest];
+	const double scale = secondary.timeClass <= LayoutCostEstimate::TimeClass::Loglinear
+	  ? G.numberOfNodes() / nmax
+	  : sumSquared / (nmax * nmax);
+
+	cost.peakMemory += secondary.peakMemory;
+	cost.operations += scale * secondary.operations;
+	cost.timeClass = secondary.timeClass;
+	return cost;
+}
 
 } // namespace ogdf
@@ -34,11 +34,11 @@
 
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/Array.h>
+#include <ogdf/basic/FlatPQTree.h>
 #include <ogdf/basic/NodeArray.h>
 #include <ogdf/basic/SList.h>
 #include <ogdf/basic/simple_graph_alg.h>
 #include <ogdf/basic/STNumbering.h>
-#include <ogdf/planarity/booth_lueker/PlanarPQTree.h>
 #include <ogdf/planarity/BoothLueker.h>
 #include <ogdf/planarity/booth_lueker/EmbedPQTree.h>
 
@@ -244,66 +244,51 @@ bool BoothLueker::preparation(Graph &G, bool embed)
 // of G. numbering contains an st-numbering of the component.
 bool BoothLueker::doTest(Graph &G,NodeArray<int> &numbering)
 {
-	bool planar = true;
+	return isPlanarSTNumbered(G, numbering);
+}
 
-	NodeArray<SListPure<PlanarLeafKey<IndInfo*>* > > inLeaves(G);
-	NodeArray<SListPure<PlanarLeafKey<IndInfo*>* > > outLeaves(G);
-	Array<node> table(G.numberOfNodes()+1);
 
-	for(node v : G.nodes)
-	{
-		for(adjEntry adj : v->adjEntries) {
-			edge e = adj->theEdge();
-			if (numbering[e->opposite(v)] > numbering[v])
-				//sideeffect: loops are ignored
-			{
-				PlanarLeafKey<IndInfo*>* L = new PlanarLeafKey<IndInfo*>(e);
-				inLeaves[v].pushFront(L);
-			}
+bool BoothLueker::isPlanarSTNumbered(const Graph &G, const NodeArray<int> &numbering)
+{
+	const int n = G.numberOfNodes();
+
+	// leaf keys are edge indices; the keys of the edges leading from the node
+	// with number i to higher (lower) numbered nodes are stored consecutively
+	// in inKeys (outKeys) from inStart[i] (outStart[i]) to inStart[i+1]
+	// (outStart[i+1]); self-loops are ignored
+	Array<int> inStart(0, n+1, 0), outStart(0, n+1, 0);
+	for (edge e : G.edges) {
+		int i = numbering[e->source()], j = numbering[e->target()];
+		if (i != j) {
+			++inStart[min(i, j)];
+			++outStart[max(i, j)];
 		}
-		table[numbering[v]] = v;
 	}
-
-	for(node v : G.nodes)
-	{
-		for (PlanarLeafKey<IndInfo*>* L : inLeaves[v])
-		{
-			outLeaves[L->userStructKey()->opposite(v)].pushFront(L);
-		}
+	for (int i = 1; i <= n+1; i++) {
+		inStart[i] += inStart[i-1];
+		outStart[i] += outStart[i-1];
 	}
 
-	PlanarPQTree T;
-
-	T.Initialize(inLeaves[table[1]]);
-	for (int i = 2; i < G.numberOfNodes(); i++)
-	{
-		if (T.Reduction(outLeaves[table[i]]))
-		{
-			T.ReplaceRoot(inLeaves[table[i]]);
-			T.emptyAllPertinentNodes();
-
-		}
-		else
-		{
-			planar = false;
-			break;
+	Array<int> inKeys(max(1, inStart[n+1])), outKeys(max(1, outStart[n+1]));
+	for (edge e : G.edges) {
+		int i = numbering[e->source()], j = numbering[e->target()];
+		if (i != j) {
+			inKeys[--inStart[min(i, j)]] = e->index();
+			outKeys[--outStart[max(i, j)]] = e->index();
 		}
 	}
-	if (planar)
-		T.emptyAllPertinentNodes();
 
-
-	// Cleanup
-	for(node v : G.nodes)
-	{
-		while (!inLeaves[v].empty())
-		{
-			PlanarLeafKey<IndInfo*>* L = inLeaves[v].popFrontRet();
-			delete L;
+	const int *in = inKeys.begin(), *out = outKeys.begin();
+	FlatPQTree T;
+	T.initialize(in + inStart[1], in + inStart[2]);
+	for (int i = 2; i < n; i++) {
+		if (!T.reduction(out + outStart[i], out + outStart[i+1])) {
+			return false;
 		}
+		T.replaceRoot(in + inStart[i], in + inStart[i+1]);
 	}
 
-	return planar;
+	return true;
 }
 
 
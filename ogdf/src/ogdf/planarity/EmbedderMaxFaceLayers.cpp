@@ -40,6 +40,7 @@
 #include <ogdf/planarity/EmbedderMaxFaceLayers.h>
 #include <ogdf/planarity/embedder/EmbedderMaxFaceBiconnectedGraphsLayers.h>
 #include <ogdf/planarity/embedder/ConnectedSubgraph.h>
+#include <ogdf/planarity/embedder/BlockTraversal.h>
 
 namespace ogdf {
 
@@ -96,9 +97,19 @@ void EmbedderMaxFaceLayers::doCall(Graph& G, adjEntry& adjExternal)
 	nodeLength.init(pBCTree->bcTree());
 	cstrLength.init(pBCTree->bcTree());
 	spqrTrees.init(pBCTree->bcTree(),nullptr);
-	computeBlockGraphs(rootBlockNode, nullptr);
+	const unsigned int threads = numberOfThreadsFor(m_maxThreads, G.numberOfEdges(), 1000);
+	embedder::BlockTraversal blocks(*pBCTree, rootBlockNode);
+	blocks.forEachBlock(threads, [&](node bT) {
+		computeBlockGraph(bT, blocks.parentCutVertex(bT));
+	});
+
+	//Bottom-Up-Traversal, independent blocks are processed concurrently:
+	blocks.bottomUp(threads, [&](node bT) {
+		if (bT != rootBlockNode) {
+			constraintMaxFace(bT, blocks.parentCutVertex(bT));
+		}
+	});
 
-	//Bottom-Up-Traversal:
 	for(adjEntry adj : rootBlockNode->adjEntries) {
 		edge e = adj->theEdge();
 		node cT = e->source();
@@ -115,7 +126,7 @@ void EmbedderMaxFaceLayers::doCall(Graph& G, adjEntry& adjExternal)
 
 			node blockNode = e2->source();
 			node cutVertex = pBCTree->cutVertex(cT, blockNode);
-			length_v_in_rootBlock += constraintMaxFace(blockNode, cutVertex);
+			length_v_in_rootBlock += cstrLength[blockNode][nH_to_nBlockEmbedding[blockNode][cutVertex]];
 		}
 		nodeLength[rootBlockNode][cB] = length_v_in_rootBlock;
 	}
@@ -140,29 +151,9 @@ void EmbedderMaxFaceLayers::doCall(Graph& G, adjEntry& adjExternal)
 }
 
 
-void EmbedderMaxFaceLayers::computeBlockGraphs(const node& bT, const node& cH)
+void EmbedderMaxFaceLayers::computeBlockGraph(const node& bT, const node& cH)
 {
-	//recursion:
-	for(adjEntry adj : bT->adjEntries) {
-		edge e = adj->theEdge();
-		if (e->source() == bT)
-			continue;
-
-		node cT = e->source();
-		for(adjEntry adjCT : cT->adjEntries) {
-			edge e2 = adjCT->theEdge();
-			if (e2->source() == cT)
-				continue;
-			node cH2 = pBCTree->cutVertex(cT, e2->source());
-			computeBlockGraphs(e2->source(), cH2);
-		}
-	}
-
-	//embed block bT:
-	node m_cH = cH;
-	if (m_cH == nullptr)
-		m_cH = pBCTree->cutVertex(bT->firstAdj()->twinNode(), bT);
-	embedder::ConnectedSubgraph<int>::call(pBCTree->auxiliaryGraph(), blockG[bT], m_cH,
+	embedder::ConnectedSubgraph<int>::call(pBCTree->auxiliaryGraph(), blockG[bT], cH,
 		nBlockEmbedding_to_nH[bT], eBlockEmbedding_to_eH[bT],
 		nH_to_nBlockEmbedding[bT], eH_to_eBlockEmbedding[bT]);
 	nodeLength[bT].init(blockG[bT], 0);
@@ -180,6 +171,7 @@ int EmbedderMaxFaceLayers::constraintMaxFace(const node& bT, const node& cH)
 {
 	//forall (v \in B, v \neq c) do:
 	//  length_B(v) := \sum_{(v, B') \in B} ConstraintMaxFace(B', v);
+	//(the values of the child blocks B' have already been computed)
 	for(adjEntry adj : bT->adjEntries) {
 		edge e = adj->theEdge();
 		if (e->target() != bT)
@@ -197,7 +189,7 @@ int EmbedderMaxFaceLayers::constraintMaxFace(const node& bT, const node& cH)
 
 			node bT2 = e2->source();
 			node cutVertex = pBCTree->cutVertex(vT, bT2);
-			length_v_in_block += constraintMaxFace(bT2, cutVertex);
+			length_v_in_block += cstrLength[bT2][nH_to_nBlockEmbedding[bT2][cutVertex]];
 		}
 		nodeLength[bT][nH_to_nBlockEmbedding[bT][vH]] = length_v_in_block;
 	}
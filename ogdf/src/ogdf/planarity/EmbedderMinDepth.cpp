@@ -34,6 +34,7 @@
 #include <ogdf/planarity/EmbedderMinDepth.h>
 #include <ogdf/planarity/embedder/EmbedderMaxFaceBiconnectedGraphs.h>
 #include <ogdf/planarity/embedder/ConnectedSubgraph.h>
+#include <ogdf/planarity/embedder/BlockTraversal.h>
 
 namespace ogdf {
 
@@ -91,31 +92,23 @@ void EmbedderMinDepth::doCall(Graph& G, adjEntry& adjExternal)
 	eH_to_eBlockEmbedding.init(pBCTree->bcTree());
 	nodeLength.init(pBCTree->bcTree());
 	spqrTrees.init(pBCTree->bcTree(),nullptr);
-	computeBlockGraphs(rootBlockNode, nullptr);
+	const unsigned int threads = numberOfThreadsFor(m_maxThreads, G.numberOfEdges(), 1000);
+	embedder::BlockTraversal blocks(*pBCTree, rootBlockNode);
+	blocks.forEachBlock(threads, [&](node bT) {
+		computeBlockGraph(bT, blocks.parentCutVertex(bT));
+	});
 
 	//Edge lengths of BC-tree, values m_{c, B} for all (c, B) \in bcTree:
 	m_cB.init(pBCTree->bcTree(), 0);
 
 	//Bottom-up traversal: (set m_cB for all {c, B} \in bcTree)
+	//independent blocks are processed concurrently
 	nodeLength[rootBlockNode].init(blockG[rootBlockNode], 0);
-	for(adjEntry adj : rootBlockNode->adjEntries) {
-		edge e = adj->theEdge();
-		node cT = e->source();
-		//node cH = pBCTree->cutVertex(cT, rootBlockNode);
-
-		//set length of c in block graph of root block node:
-		for(adjEntry adjCT : cT->adjEntries) {
-			edge e2 = adjCT->theEdge();
-			if (e2->target() != cT)
-				continue;
-
-			node blockNode = e2->source();
-			node cutVertex = pBCTree->cutVertex(cT, blockNode);
-
-			//Start recursion:
-			m_cB[e2] = bottomUpTraversal(blockNode, cutVertex);
+	blocks.bottomUp(threads, [&](node bT) {
+		if (bT != rootBlockNode) {
+			m_cB[blocks.parentEdge(bT)] = bottomUpTraversal(bT, blocks.parentCutVertex(bT));
 		}
-	}
+	});
 
 	//Top-down traversal: (set m_cB for all {B, c} \in bcTree and get min depth
 	//for each block)
@@ -154,29 +147,9 @@ void EmbedderMinDepth::doCall(Graph& G, adjEntry& adjExternal)
 }
 
 
-void EmbedderMinDepth::computeBlockGraphs(const node& bT, const node& cH)
+void EmbedderMinDepth::computeBlockGraph(const node& bT, const node& cH)
 {
-	//recursion:
-	for(adjEntry adj : bT->adjEntries) {
-		edge e = adj->theEdge();
-		if (e->source() == bT)
-			continue;
-
-		node cT = e->source();
-		for(adjEntry adjCT : cT->adjEntries) {
-			edge e2 = adjCT->theEdge();
-			if (e2->source() == cT)
-				continue;
-			node cH2 = pBCTree->cutVertex(cT, e2->source());
-			computeBlockGraphs(e2->source(), cH2);
-		}
-	}
-
-	//embed block bT:
-	node m_cH = cH;
-	if (m_cH == nullptr)
-		m_cH = pBCTree->cutVertex(bT->firstAdj()->twinNode(), bT);
-	embedder::ConnectedSubgraph<int>::call(pBCTree->auxiliaryGraph(), blockG[bT], m_cH,
+	embedder::ConnectedSubgraph<int>::call(pBCTree->auxiliaryGraph(), blockG[bT], cH,
 		nBlockEmbedding_to_nH[bT], eBlockEmbedding_to_eH[bT],
 		nH_to_nBlockEmbedding[bT], eH_to_eBlockEmbedding[bT]);
 
@@ -194,7 +167,7 @@ int EmbedderMinDepth::bottomUpTraversal(const node& bT, const node& cH)
 	int m_B = 0; //max_{c \in B} m_B(c)
 	List<node> cInBWithProperty; //{c \in B | m_B(c) = m_B}
 
-	//Recursion:
+	//m_{c, B'} of all child blocks B' have already been computed:
 	for(adjEntry adj : bT->adjEntries) {
 		edge e = adj->theEdge();
 		if (e->target() != bT)
@@ -208,10 +181,6 @@ int EmbedderMinDepth::bottomUpTraversal(const node& bT, const node& cH)
 			if (e == e_cT_bT2)
 				continue;
 
-			node bT2 = e_cT_bT2->source();
-			node c_in_bT2 = pBCTree->cutVertex(cT, bT2);
-			m_cB[e_cT_bT2] = bottomUpTraversal(bT2, c_in_bT2);
-
 			//update m_B and cInBWithProperty:
 			if (m_B < m_cB[e_cT_bT2])
 			{
@@ -34,6 +34,7 @@
 
 #include <ogdf/planarity/EmbedderMinDepthMaxFace.h>
 #include <ogdf/planarity/embedder/ConnectedSubgraph.h>
+#include <ogdf/planarity/embedder/BlockTraversal.h>
 #include <ogdf/planarity/embedder/EmbedderMaxFaceBiconnectedGraphs.h>
 
 namespace ogdf {
@@ -89,6 +90,10 @@ void EmbedderMinDepthMaxFace::doCall(Graph& G, adjEntry& adjExternal)
 	OGDF_ASSERT(rootBlockNode != nullptr);
 
 
+	const unsigned int threads = numberOfThreadsFor(m_maxThreads, G.numberOfEdges(), 1000);
+	embedder::BlockTraversal blocks(*pBCTree, rootBlockNode);
+
+
 	/* MIN DEPTH                                                                */
 
 	//Node lengths of block graph:
@@ -98,24 +103,12 @@ void EmbedderMinDepthMaxFace::doCall(Graph& G, adjEntry& adjExternal)
 	md_m_cB.init(pBCTree->bcTree(), 0);
 
 	//Bottom-up traversal: (set m_cB for all {c, B} \in bcTree)
-	for(adjEntry adj : rootBlockNode->adjEntries) {
-		edge e = adj->theEdge();
-		node cT = e->source();
-		//node cH = pBCTree->cutVertex(cT, rootBlockNode);
-
-		//set length of c in block graph of root block node:
-		for(adjEntry adjCT : cT->adjEntries) {
-			edge e2 = adjCT->theEdge();
-			if (e2->target() != cT)
-				continue;
-
-			node blockNode = e2->source();
-			node cutVertex = pBCTree->cutVertex(cT, blockNode);
-
-			//Start recursion:
-			md_m_cB[e2] = md_bottomUpTraversal(blockNode, cutVertex);
+	//independent blocks are processed concurrently
+	blocks.bottomUp(threads, [&](node bT) {
+		if (bT != rootBlockNode) {
+			md_m_cB[blocks.parentEdge(bT)] = md_bottomUpTraversal(bT, blocks.parentCutVertex(bT));
 		}
-	}
+	});
 
 	//Top-down traversal: (set m_cB for all {B, c} \in bcTree and get min depth
 	//for each block)
@@ -132,7 +125,13 @@ void EmbedderMinDepthMaxFace::doCall(Graph& G, adjEntry& adjExternal)
 	mf_nodeLength.init(pBCTree->auxiliaryGraph(), 0);
 	mf_maxFaceSize.init(pBCTree->bcTree(), 0);
 
-	//Bottom-Up-Traversal:
+	//Bottom-Up-Traversal, independent blocks are processed concurrently:
+	blocks.bottomUp(threads, [&](node bT) {
+		if (bT != rootBlockNode) {
+			mf_constraintMaxFace(bT, blocks.parentCutVertex(bT));
+		}
+	});
+
 	for(adjEntry adj : rootBlockNode->adjEntries) {
 		edge e = adj->theEdge();
 		node cT = e->source();
@@ -148,7 +147,7 @@ void EmbedderMinDepthMaxFace::doCall(Graph& G, adjEntry& adjExternal)
 
 			node blockNode = e2->source();
 			node cutVertex = pBCTree->cutVertex(cT, blockNode);
-			length_v_in_rootBlock += mf_constraintMaxFace(blockNode, cutVertex);
+			length_v_in_rootBlock += mf_cstrLength[cutVertex];
 		}
 		mf_nodeLength[cH] = length_v_in_rootBlock;
 	}
@@ -201,7 +200,7 @@ int EmbedderMinDepthMaxFace::md_bottomUpTraversal(const node& bT, const node& cH
 	int m_B = 0; //max_{c \in B} m_B(c)
 	List<node> M_B; //{c \in B | m_B(c) = m_B}
 
-	//Recursion:
+	//m_{c, B'} of all child blocks B' have already been computed:
 	for(adjEntry adj : bT->adjEntries) {
 		edge e = adj->theEdge();
 		if (e->target() != bT)
@@ -215,10 +214,6 @@ int EmbedderMinDepthMaxFace::md_bottomUpTraversal(const node& bT, const node& cH
 			if (e == e_cT_bT2)
 				continue;
 
-			node bT2 = e_cT_bT2->source();
-			node c_in_bT2 = pBCTree->cutVertex(cT, bT2);
-			md_m_cB[e_cT_bT2] = md_bottomUpTraversal(bT2, c_in_bT2);
-
 			//update m_B and M_B:
 			if (m_B < md_m_cB[e_cT_bT2])
 			{
@@ -591,6 +586,7 @@ int EmbedderMinDepthMaxFace::mf_constraintMaxFace(const node& bT, const node& cH
 {
 	//forall (v \in B, v \neq c) do:
 	//  length_B(v) := \sum_{(v, B') \in B} ConstraintMaxFace(B', v);
+	//(the values of the child blocks B' have already been computed)
 	for(adjEntry adj : bT->adjEntries) {
 		edge e = adj->theEdge();
 		if (e->target() != bT)
@@ -608,7 +604,7 @@ int EmbedderMinDepthMaxFace::mf_constraintMaxFace(const node& bT, const node& cH
 
 			node bT2 = e2->source();
 			node cutVertex = pBCTree->cutVertex(vT, bT2);
-			length_v_in_block += mf_constraintMaxFace(bT2, cutVertex);
+			length_v_in_block += mf_cstrLength[cutVertex];
 		}
 		mf_nodeLength[vH] = length_v_in_block;
 	}
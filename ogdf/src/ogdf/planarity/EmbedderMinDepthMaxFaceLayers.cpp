@@ -42,6 +42,7 @@
 
 #include <ogdf/planarity/EmbedderMinDepthMaxFaceLayers.h>
 #include <ogdf/planarity/embedder/ConnectedSubgraph.h>
+#include <ogdf/planarity/embedder/BlockTraversal.h>
 #include <ogdf/planarity/embedder/EmbedderMaxFaceBiconnectedGraphsLayers.h>
 
 namespace ogdf {
@@ -94,6 +95,10 @@ void EmbedderMinDepthMaxFaceLayers::doCall(Graph& G, adjEntry& adjExternal)
 	}
 	OGDF_ASSERT(rootBlockNode != nullptr);
 
+	const unsigned int threads = numberOfThreadsFor(m_maxThreads, G.numberOfEdges(), 1000);
+	embedder::BlockTraversal blocks(*pBCTree, rootBlockNode);
+
+
 	/* MIN DEPTH                                                                */
 
 	//Node lengths of block graph:
@@ -103,24 +108,12 @@ void EmbedderMinDepthMaxFaceLayers::doCall(Graph& G, adjEntry& adjExternal)
 	md_m_cB.init(pBCTree->bcTree(), 0);
 
 	//Bottom-up traversal: (set m_cB for all {c, B} \in bcTree)
-	for(adjEntry adj : rootBlockNode->adjEntries) {
-		edge e = adj->theEdge();
-		node cT = e->source();
-		//node cH = pBCTree->cutVertex(cT, rootBlockNode);
-
-		//set length of c in block graph of root block node:
-		for(adjEntry adjCT : cT->adjEntries) {
-			edge e2 = adjCT->theEdge();
-			if (e2->target() != cT)
-				continue;
-
-			node blockNode = e2->source();
-			node cutVertex = pBCTree->cutVertex(cT, blockNode);
-
-			//Start recursion:
-			md_m_cB[e2] = md_bottomUpTraversal(blockNode, cutVertex);
+	//independent blocks are processed concurrently
+	blocks.bottomUp(threads, [&](node bT) {
+		if (bT != rootBlockNode) {
+			md_m_cB[blocks.parentEdge(bT)] = md_bottomUpTraversal(bT, blocks.parentCutVertex(bT));
 		}
-	}
+	});
 
 	//Top-down traversal: (set m_cB for all {B, c} \in bcTree and get min depth
 	//for each block)
@@ -136,7 +129,13 @@ void EmbedderMinDepthMaxFaceLayers::doCall(Graph& G, adjEntry& adjExternal)
 	mf_nodeLength.init(pBCTree->auxiliaryGraph(), 0);
 	mf_maxFaceSize.init(pBCTree->bcTree(), 0);
 
-	//Bottom-Up-Traversal:
+	//Bottom-Up-Traversal, independent blocks are processed concurrently:
+	blocks.bottomUp(threads, [&](node bT) {
+		if (bT != rootBlockNode) {
+			mf_constraintMaxFace(bT, blocks.parentCutVertex(bT));
+		}
+	});
+
 	for(adjEntry adj : rootBlockNode->adjEntries) {
 		edge e = adj->theEdge();
 		node cT = e->source();
@@ -152,7 +151,7 @@ void EmbedderMinDepthMaxFaceLayers::doCall(Graph& G, adjEntry& adjExternal)
 
 			node blockNode = e2->source();
 			node cutVertex = pBCTree->cutVertex(cT, blockNode);
-			length_v_in_rootBlock += mf_constraintMaxFace(blockNode, cutVertex);
+			length_v_in_rootBlock += mf_cstrLength[cutVertex];
 		}
 		mf_nodeLength[cH] = length_v_in_rootBlock;
 	}
@@ -203,7 +202,7 @@ int EmbedderMinDepthMaxFaceLayers::md_bottomUpTraversal(const node& bT, const no
 	int m_B = 0; //max_{c \in B} m_B(c)
 	List<node> M_B; //{c \in B | m_B(c) = m_B}
 
-	//Recursion:
+	//m_{c, B'} of all child blocks B' have already been computed:
 	for(adjEntry adj : bT->adjEntries) {
 		edge e = adj->theEdge();
 		if (e->target() != bT)
@@ -217,10 +216,6 @@ int EmbedderMinDepthMaxFaceLayers::md_bottomUpTraversal(const node& bT, const no
 			if (e == e_cT_bT2)
 				continue;
 
-			node bT2 = e_cT_bT2->source();
-			node c_in_bT2 = pBCTree->cutVertex(cT, bT2);
-			md_m_cB[e_cT_bT2] = md_bottomUpTraversal(bT2, c_in_bT2);
-
 			//update m_B and M_B:
 			if (m_B < md_m_cB[e_cT_bT2])
 			{
@@ -584,6 +579,7 @@ int EmbedderMinDepthMaxFaceLayers::mf_constraintMaxFace(const node& bT, const no
 {
 	//forall (v \in B, v \neq c) do:
 	//  length_B(v) := \sum_{(v, B') \in B} ConstraintMaxFace(B', v);
+	//(the values of the child blocks B' have already been computed)
 	for(adjEntry adj : bT->adjEntries) {
 		edge e = adj->theEdge();
 		if (e->target() != bT)
@@ -601,7 +597,7 @@ int EmbedderMinDepthMaxFaceLayers::mf_constraintMaxFace(const node& bT, const no
 
 			node bT2 = e2->source();
 			node cutVertex = pBCTree->cutVertex(vT, bT2);
-			length_v_in_block += mf_constraintMaxFace(bT2, cutVertex);
+			length_v_in_block += mf_cstrLength[cutVertex];
 		}
 		mf_nodeLength[vH] = length_v_in_block;
 	}
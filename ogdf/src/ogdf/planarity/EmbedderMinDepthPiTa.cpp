@@ -34,6 +34,7 @@
 
 #include <ogdf/planarity/EmbedderMinDepthPiTa.h>
 #include <ogdf/planarity/embedder/ConnectedSubgraph.h>
+#include <ogdf/planarity/embedder/BlockTraversal.h>
 
 namespace ogdf {
 
@@ -120,7 +121,23 @@ void EmbedderMinDepthPiTa::doCall(Graph& G, adjEntry& adjExternal)
 	eBlockEmbedding_to_eH.init(pBCTree->bcTree());
 	nH_to_nBlockEmbedding.init(pBCTree->bcTree());
 	eH_to_eBlockEmbedding.init(pBCTree->bcTree());
-	embedBlocks(rootBlockNode, nullptr);
+	embedder::BlockTraversal blocks(*pBCTree, rootBlockNode);
+	blocks.forEachBlock(numberOfThreadsFor(m_maxThreads, G.numberOfEdges(), 1000), [&](node bT) {
+		embedBlock(bT, blocks.parentCutVertex(bT));
+	});
+
+	if (!useExtendedDepthDefinition()) {
+		for (node bT : blocks.postOrder()) {
+			if (blockG[bT].numberOfEdges() == 1) {
+				for(node n : blockG[bT].nodes) {
+					node nOrg = pBCTree->original(nBlockEmbedding_to_nH[bT][n]);
+					if (nOrg->degree() == 1) {
+						oneEdgeBlockNodes.pushBack(nOrg);
+					}
+				}
+			}
+		}
+	}
 
 	//Second step: Constrained Minimization
 	node vT = rootBlockNode->firstAdj()->twinNode();
@@ -795,43 +812,13 @@ int EmbedderMinDepthPiTa::computeBlockCutfaceTreeEdgeLengths(const node& n)
 }
 
 
-void EmbedderMinDepthPiTa::embedBlocks(const node& bT, const node& cH)
+void EmbedderMinDepthPiTa::embedBlock(const node& bT, const node& cH)
 {
-	//recursion:
-	for(adjEntry adj : bT->adjEntries) {
-		edge e = adj->theEdge();
-		if (e->source() == bT)
-			continue;
-
-		node cT = e->source();
-		for(adjEntry adjCT : cT->adjEntries) {
-			edge e2 = adjCT->theEdge();
-			if (e2->source() == cT)
-				continue;
-			node cH2 = pBCTree->cutVertex(cT, e2->source());
-			embedBlocks(e2->source(), cH2);
-		}
-	}
-
-	//embed block bT:
-	node m_cH = cH;
-	if (m_cH == nullptr)
-		m_cH = pBCTree->cutVertex(bT->firstAdj()->twinNode(), bT);
-	embedder::ConnectedSubgraph<int>::call(pBCTree->auxiliaryGraph(), blockG[bT], m_cH,
+	embedder::ConnectedSubgraph<int>::call(pBCTree->auxiliaryGraph(), blockG[bT], cH,
 		nBlockEmbedding_to_nH[bT], eBlockEmbedding_to_eH[bT],
 		nH_to_nBlockEmbedding[bT], eH_to_eBlockEmbedding[bT]);
 	planarEmbed(blockG[bT]);
 	nodeLength[bT].init(blockG[bT], 0);
-
-	if (!useExtendedDepthDefinition()
-	 && blockG[bT].numberOfEdges() == 1) {
-		for(node n : blockG[bT].nodes) {
-			node nOrg = pBCTree->original(nBlockEmbedding_to_nH[bT][n]);
-			if (nOrg->degree() == 1) {
-				oneEdgeBlockNodes.pushBack(nOrg);
-			}
-		}
-	}
 }
 
 
@@ -39,6 +39,7 @@
 #include <ogdf/planarity/SimpleEmbedder.h>
 #include <ogdf/packing/TileToRowsCCPacker.h>
 #include <ogdf/graphalg/CliqueFinder.h>
+#include <ogdf/basic/Tracer.h>
 
 namespace ogdf {
 
@@ -58,6 +59,7 @@ PlanarizationLayout::PlanarizationLayout()
 
 void PlanarizationLayout::call(GraphAttributes &ga)
 {
+	OGDF_TRACE_SCOPE("PlanarizationLayout::call");
 	m_nCrossings = 0;
 
 	PlanRep pr(ga);
@@ -69,18 +71,27 @@ void PlanarizationLayout::call(GraphAttributes &ga)
 	{
 		// 1. crossing minimization
 		int cr;
-		m_crossMin->call(pr, cc, cr);
+		{
+			OGDF_TRACE_SCOPE("PlanarizationLayout::crossingMinimization");
+			m_crossMin->call(pr, cc, cr);
+		}
 		m_nCrossings += cr;
 		OGDF_ASSERT(isPlanar(pr));
 
 		// 2. embedding
 		adjEntry adjExternal;
-		m_embedder->call(pr, adjExternal);
+		{
+			OGDF_TRACE_SCOPE("PlanarizationLayout::embedding");
+			m_embedder->call(pr, adjExternal);
+		}
 
 		// 3. (planar) layout
 
 		Layout drawing(pr);
-		m_planarLayouter->call(pr, adjExternal, drawing);
+		{
+			OGDF_TRACE_SCOPE("PlanarizationLayout::planarLayout");
+			m_planarLayouter->call(pr, adjExternal, drawing);
+		}
 
 		for(int i = pr.startNode(); i < pr.stopNode(); ++i) {
 			node vG = pr.v(i);
@@ -100,7 +111,10 @@ void PlanarizationLayout::call(GraphAttributes &ga)
 	}
 
 	// 4. arrange CCs
-	arrangeCCs(pr, ga, boundingBox);
+	{
+		OGDF_TRACE_SCOPE("PlanarizationLayout::arrangeCCs");
+		arrangeCCs(pr, ga, boundingBox);
+	}
 
 	ga.removeUnnecessaryBendsHV();
 }
@@ -113,10 +127,14 @@ void PlanarizationLayout::call(GraphAttributes &ga)
 void PlanarizationLayout::call(GraphAttributes &ga, Graph &g)
 {
 	OGDF_ASSERT(&ga.constGraph() == &g);
+	OGDF_TRACE_SCOPE("PlanarizationLayout::call");
 
 	ga.clearAllBends();
 	CliqueReplacer cliqueReplacer(ga,g);
-	preprocessCliques(g, cliqueReplacer);
+	{
+		OGDF_TRACE_SCOPE("PlanarizationLayout::preprocessCliques");
+		preprocessCliques(g, cliqueReplacer);
+	}
 
 	m_nCrossings = 0;
 
@@ -147,13 +165,19 @@ void PlanarizationLayout::call(GraphAttributes &ga, Graph &g)
 	{
 		// 1. crossing minimization
 		int cr;
-		m_crossMin->call(pr, cc, cr, &costOrig, &forbiddenOrig);
+		{
+			OGDF_TRACE_SCOPE("PlanarizationLayout::crossingMinimization");
+			m_crossMin->call(pr, cc, cr, &costOrig, &forbiddenOrig);
+		}
 		m_nCrossings += cr;
 		OGDF_ASSERT(isPlanar(pr));
 
 		// 2. embedding
 		adjEntry adjExternal;
-		m_embedder->call(pr, adjExternal);
+		{
+			OGDF_TRACE_SCOPE("PlanarizationLayout::embedding");
+			m_embedder->call(pr, adjExternal);
+		}
 
 		// 3. (planar) layout
 
@@ -168,7 +192,10 @@ void PlanarizationLayout::call(GraphAttributes &ga, Graph &g)
 		}
 
 		Layout drawing(pr);
-		m_planarLayouter->call(pr, adjExternal, drawing);
+		{
+			OGDF_TRACE_SCOPE("PlanarizationLayout::planarLayout");
+			m_planarLayouter->call(pr, adjExternal, drawing);
+		}
 
 		// we now have to reposition clique nodes
 
@@ -298,7 +325,10 @@ void PlanarizationLayout::call(GraphAttributes &ga, Graph &g)
 	}
 
 	// 4. arrange CCs
-	arrangeCCs(pr, ga, boundingBox);
+	{
+		OGDF_TRACE_SCOPE("PlanarizationLayout::arrangeCCs");
+		arrangeCCs(pr, ga, boundingBox);
+	}
 
 	ga.removeUnnecessaryBendsHV();
 	cliqueReplacer.undoStars();
@@ -435,6 +465,7 @@ void PlanarizationLayout::fillAdjNodes(List<node>& adjNodes,
 
 void PlanarizationLayout::callSimDraw(GraphAttributes &ga)
 {
+	OGDF_TRACE_SCOPE("PlanarizationLayout::callSimDraw");
 	const Graph &g = ga.constGraph();
 	m_nCrossings = 0;
 
@@ -453,18 +484,27 @@ void PlanarizationLayout::callSimDraw(GraphAttributes &ga)
 	{
 		// 1. crossing minimization
 		int cr;
-		m_crossMin->call(pr, cc, cr, &costOrig, nullptr, &esgOrig);
+		{
+			OGDF_TRACE_SCOPE("PlanarizationLayout::crossingMinimization");
+			m_crossMin->call(pr, cc, cr, &costOrig, nullptr, &esgOrig);
+		}
 		m_nCrossings += cr;
 		OGDF_ASSERT(isPlanar(pr));
 
 		// 2. embedding
 		adjEntry adjExternal;
-		m_embedder->call(pr, adjExternal);
+		{
+			OGDF_TRACE_SCOPE("PlanarizationLayout::embedding");
+			m_embedder->call(pr, adjExternal);
+		}
 
 		// 3. (planar) layout
 
 		Layout drawing(pr);
-		m_planarLayouter->call(pr, adjExternal, drawing);
+		{
+			OGDF_TRACE_SCOPE("PlanarizationLayout::planarLayout");
+			m_planarLayouter->call(pr, adjExternal, drawing);
+		}
 
 		for(int i = pr.startNode(); i < pr.stopNode(); ++i) {
 			node vG = pr.v(i);
@@ -484,7 +524,10 @@ void PlanarizationLayout::callSimDraw(GraphAttributes &ga)
 	}
 
 	// 4. arrange CCs
-	arrangeCCs(pr, ga, boundingBox);
+	{
+		OGDF_TRACE_SCOPE("PlanarizationLayout::arrangeCCs");
+		arrangeCCs(pr, ga, boundingBox);
+	}
 
 	ga.removeUnnecessaryBendsHV();
 }
@@ -524,4 +567,23 @@ void PlanarizationLayout::arrangeCCs(PlanRep &pr, GraphAttributes &ga, Array<DPo
 	}
 }
 
+LayoutCostEstimate PlanarizationLayout::estimateCost(const GraphAttributes &ga) const
+{
+	const Graph &G = ga.constGraph();
+	const double n = G.numberOfNodes();
+	const double m = G.numberOfEdges();
+
+	// the planarized representation gains a dummy node per crossing; assume
+	// O(m) crossings. Every edge reinsertion searches the dual graph.
+	const double planNodes = n + m;
+	const double planEdges = 3 * m;
+
+	LayoutCostEstimate cost;
+	cost.peakMemory = LayoutCostEstimate::attributesMemory(ga)
+	  + 3 * LayoutCostEstimate::graphMemory(planNodes, planEdges);
+	cost.operations = m * (planNodes + planEdges);
+	cost.timeClass = LayoutCostEstimate::TimeClass::Quadratic;
+	return cost;
+}
+
 } // end namespace ogdf
@@ -92,8 +92,8 @@ void SimpleIncNodeInserter::insertCopyNode(node v, Graph::NodeType vTyp)
 //insert a copy for original node v respecting the given
 //embedding, i.e. inserting crossings at adjacent edges
 //if necessary
-//has currently running time of m*n because faces in the embedding
-//are recomputed, speed up by updating them manually
+//the faces in the embedding are updated while inserting the
+//edges, they are not recomputed
 void SimpleIncNodeInserter::insertCopyNode(
 	node v,
 	CombinatorialEmbedding &E,
@@ -144,8 +144,6 @@ void SimpleIncNodeInserter::insertCopyNode(
 	//edges to nodes with not yet existing copies
 	//edges to nodes outside the face f
 
-	E.computeFaces();//should we manually update the face?
-
 	if (adExternal)
 	{
 		E.setExternalFace(E.rightFace(adExternal));
@@ -43,6 +43,7 @@ EdgeInsertionModule *VariableEmbeddingInserter::clone() const
 VariableEmbeddingInserter &VariableEmbeddingInserter::operator=(const VariableEmbeddingInserter &inserter)
 {
 	VariableEmbeddingInserterBase::operator=(inserter);
+	m_maxThreads = inserter.m_maxThreads;
 	return *this;
 }
 
@@ -56,6 +57,7 @@ Module::ReturnType VariableEmbeddingInserter::doCall(
 {
 	VarEdgeInserterCore core(pr, pCostOrig, pForbiddenOrig, pEdgeSubgraph);
 	core.timeLimit(timeLimit());
+	core.maxThreads(m_maxThreads);
 
 	ReturnType retVal = core.call(origEdges, removeReinsert(), percentMostCrossed());
 	runsPostprocessing(core.runsPostprocessing());
@@ -72,6 +74,7 @@ Module::ReturnType VariableEmbeddingInserter::doCallPostprocessing(
 {
 	VarEdgeInserterCore core(pr, pCostOrig, pForbiddenOrig, pEdgeSubgraphs);
 	core.timeLimit(timeLimit());
+	core.maxThreads(m_maxThreads);
 
 	ReturnType retVal = core.callPostprocessing(origEdges, removeReinsert(), percentMostCrossed());
 	runsPostprocessing(core.runsPostprocessing());
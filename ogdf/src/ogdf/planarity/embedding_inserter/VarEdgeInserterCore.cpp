@@ -35,7 +35,9 @@
 #include <ogdf/basic/simple_graph_alg.h>
 #include <ogdf/basic/extended_graph_alg.h>
 #include <ogdf/basic/FaceArray.h>
+#include <ogdf/basic/ParallelFor.h>
 #include <ogdf/decomposition/StaticPlanarSPQRTree.h>
+#include <memory>
 
 namespace ogdf {
 
@@ -45,10 +47,6 @@ Module::ReturnType VarEdgeInserterCore::call(
 	RemoveReinsertType rrPost,
 	double percentMostCrossed)
 {
-	double T;
-	usedTime(T);
-
-	Module::ReturnType retValue = Module::ReturnType::Feasible;
 	m_runsPostprocessing = 0;
 
 	if (origEdges.size() == 0)
@@ -84,20 +82,10 @@ Module::ReturnType VarEdgeInserterCore::call(
 
 				for (edge eOrigRR : currentOrigEdges)
 				{
-					int pathLength = (m_pCost != nullptr) ? costCrossed(eOrigRR) : (m_pr.chain(eOrigRR).size() - 1);
+					int pathLength = pathCost(eOrigRR);
 					if (pathLength == 0) continue; // cannot improve
 
-					m_pr.removeEdgePath(eOrigRR);
-
-					storeTypeOfCurrentEdge(eOrigRR);
-					//m_typeOfCurrentEdge = m_forbidCrossingGens ? PG.typeOrig(eOrigRR) : Graph::association;
-
-					SList<adjEntry> iep;
-					m_st = eOrigRR;
-					insert(m_pr.copy(eOrigRR->source()), m_pr.copy(eOrigRR->target()), iep);
-					m_pr.insertEdgePath(eOrigRR,iep);
-
-					int newPathLength = (m_pCost != nullptr) ? costCrossed(eOrigRR) : (m_pr.chain(eOrigRR).size() - 1);
+					int newPathLength = reinsert(eOrigRR);
 					OGDF_ASSERT(newPathLength <= pathLength);
 
 					if(newPathLength < pathLength)
@@ -107,9 +95,9 @@ Module::ReturnType VarEdgeInserterCore::call(
 		}
 	}
 
+	Module::ReturnType retValue = Module::ReturnType::Feasible;
 	if(!doIncrementalPostprocessing) {
 		// postprocessing (remove-reinsert heuristc)
-		const int m = m_pr.original().numberOfEdges();
 		SListPure<edge> rrEdges;
 
 		switch(rrPost)
@@ -131,55 +119,7 @@ Module::ReturnType VarEdgeInserterCore::call(
 			break;
 		}
 
-		// marks the end of the interval of rrEdges over which we iterate
-		// initially set to invalid iterator which means all edges
-		SListConstIterator<edge> itStop;
-
-		bool improved;
-		do {
-			// abort postprocessing if time limit reached
-			if (m_timeLimit >= 0 && m_timeLimit <= usedTime(T)) {
-				retValue = Module::ReturnType::TimeoutFeasible;
-				break;
-			}
-
-			++m_runsPostprocessing;
-			improved = false;
-
-			if(rrPost == RemoveReinsertType::MostCrossed)
-			{
-				embedding_inserter::CrossingsBucket<PlanRepLight> bucket(&m_pr);
-				rrEdges.bucketSort(bucket);
-
-				const int num = int(0.01 * percentMostCrossed * m);
-				itStop = rrEdges.get(num);
-			}
-
-			SListConstIterator<edge> it;
-			for(it = rrEdges.begin(); it != itStop; ++it)
-			{
-				edge eOrig = *it;
-
-				int pathLength = (m_pCost != nullptr) ? costCrossed(eOrig) : (m_pr.chain(eOrig).size() - 1);
-				if (pathLength == 0) continue; // cannot improve
-
-				m_pr.removeEdgePath(eOrig);
-
-				storeTypeOfCurrentEdge(eOrig);
-
-				SList<adjEntry> eip;
-				m_st = eOrig;
-				insert(m_pr.copy(eOrig->source()), m_pr.copy(eOrig->target()), eip);
-				m_pr.insertEdgePath(eOrig,eip);
-
-				// we cannot find a shortest path that is longer than before!
-				int newPathLength = (m_pCost != nullptr) ? costCrossed(eOrig) : (m_pr.chain(eOrig).size() - 1);
-				OGDF_ASSERT(newPathLength <= pathLength);
-
-				if(newPathLength < pathLength)
-					improved = true;
-			}
-		} while (improved);
+		retValue = postprocessing(rrEdges, rrPost, percentMostCrossed);
 	}
 
 #ifdef OGDF_DEBUG
@@ -202,10 +142,6 @@ Module::ReturnType VarEdgeInserterCore::callPostprocessing(
 	RemoveReinsertType rrPost,
 	double percentMostCrossed)
 {
-	double T;
-	usedTime(T);
-
-	Module::ReturnType retValue = Module::ReturnType::Feasible;
 	m_runsPostprocessing = 0;
 
 	if (origEdges.size() == 0)
@@ -214,10 +150,7 @@ Module::ReturnType VarEdgeInserterCore::callPostprocessing(
 	if(rrPost == RemoveReinsertType::Incremental || rrPost == RemoveReinsertType::IncInserted)
 		return Module::ReturnType::Feasible;
 
-	SListPure<edge> currentOrigEdges;
-
 	// postprocessing (remove-reinsert heuristc)
-	const int m = m_pr.original().numberOfEdges();
 	SListPure<edge> rrEdges;
 
 	switch(rrPost)
@@ -239,20 +172,47 @@ Module::ReturnType VarEdgeInserterCore::callPostprocessing(
 		break;
 	}
 
+	Module::ReturnType retValue = postprocessing(rrEdges, rrPost, percentMostCrossed);
+
+#ifdef OGDF_DEBUG
+	bool isPlanar =
+#endif
+		planarEmbed(m_pr);
+
+	OGDF_ASSERT(isPlanar);
+
+	m_pr.removePseudoCrossings();
+	OGDF_ASSERT(m_pr.representsCombEmbedding());
+
+	return retValue;
+}
+
+
+// remove-reinsert heuristic; the whole phase is bounded by the time limit
+Module::ReturnType VarEdgeInserterCore::postprocessing(
+	SListPure<edge> &rrEdges,
+	RemoveReinsertType rrPost,
+	double percentMostCrossed)
+{
+	StopwatchWallClock watch;
+	watch.start();
+
+	const int m = m_pr.original().numberOfEdges();
+
 	// marks the end of the interval of rrEdges over which we iterate
 	// initially set to invalid iterator which means all edges
 	SListConstIterator<edge> itStop;
 
 	bool improved;
+	bool timeout = false;
 	do {
 		// abort postprocessing if time limit reached
-		if (m_timeLimit >= 0 && m_timeLimit <= usedTime(T)) {
-			retValue = Module::ReturnType::TimeoutFeasible;
+		if (timeLimitReached(watch)) {
+			timeout = true;
 			break;
 		}
 
 		++m_runsPostprocessing;
-		improved = false;
 
 		if(rrPost == RemoveReinsertType::MostCrossed)
 		{
@@ -263,43 +223,215 @@ Module::ReturnType VarEdgeInserterCore::callPostprocessing(
 			itStop = rrEdges.get(num);
 		}
 
-		SListConstIterator<edge> it;
-		for(it = rrEdges.begin(); it != itStop; ++it)
-		{
-			edge eOrig = *it;
+		if (m_maxThreads > 1)
+			improved = reinsertConcurrent(rrEdges.begin(), itStop, watch, timeout);
+		else
+			improved = reinsertSequential(rrEdges.begin(), itStop, watch, timeout);
+	} while (improved && !timeout);
 
-			int pathLength = (m_pCost != nullptr) ? costCrossed(eOrig) : (m_pr.chain(eOrig).size() - 1);
-			if (pathLength == 0) continue; // cannot improve
+	return timeout ? Module::ReturnType::TimeoutFeasible : Module::ReturnType::Feasible;
+}
 
-			m_pr.removeEdgePath(eOrig);
 
-			storeTypeOfCurrentEdge(eOrig);
+bool VarEdgeInserterCore::reinsertSequential(
+	SListConstIterator<edge> it,
+	SListConstIterator<edge> itStop,
+	const Stopwatch &watch,
+	bool &timeout)
+{
+	bool improved = false;
+	for(; it != itStop; ++it)
+	{
+		if (timeLimitReached(watch)) {
+			timeout = true;
+			break;
+		}
 
-			SList<adjEntry> eip;
-			m_st = eOrig;
-			insert(m_pr.copy(eOrig->source()), m_pr.copy(eOrig->target()), eip);
-			m_pr.insertEdgePath(eOrig,eip);
+		edge eOrig = *it;
+
+		int pathLength = pathCost(eOrig);
+		if (pathLength == 0) continue; // cannot improve
+
+		// we cannot find a shortest path that is longer than before!
+		int newPathLength = reinsert(eOrig);
+		OGDF_ASSERT(newPathLength <= pathLength);
+
+		if(newPathLength < pathLength)
+			improved = true;
+	}
+
+	return improved;
+}
 
-			// we cannot find a shortest path that is longer than before!
-			int newPathLength = (m_pCost != nullptr) ? costCrossed(eOrig) : (m_pr.chain(eOrig).size() - 1);
-			OGDF_ASSERT(newPathLength <= pathLength);
 
-			if(newPathLength < pathLength)
+bool VarEdgeInserterCore::reinsertConcurrent(
+	SListConstIterator<edge> it,
+	SListConstIterator<edge> itStop,
+	const Stopwatch &watch,
+	bool &timeout)
+{
+	const int minBatchSize = static_cast<int>(m_maxThreads);
+	const int maxBatchSize = 8 * minBatchSize;
+
+	Array<edge> candidate(maxBatchSize);
+	Array<int> gain(maxBatchSize);
+	Array<SList<edge>> crossed(maxBatchSize);
+
+	bool improved = false;
+	int batchSize = minBatchSize;
+	SListConstIterator<edge> itBatch = it;
+	while (itBatch != itStop)
+	{
+		if (timeLimitReached(watch)) {
+			timeout = true;
+			break;
+		}
+
+		Array<SListConstIterator<edge>> position(batchSize);
+		int n = 0;
+		for(it = itBatch; it != itStop && n < batchSize; ++it) {
+			if (pathCost(*it) > 0) {
+				position[n] = it;
+				candidate[n++] = *it;
+			}
+		}
+
+		// evaluate the batch speculatively against the current planarization
+		parallelFor(numberOfThreadsFor(m_maxThreads, n, 1), n, [&](int begin, int end, unsigned int) {
+			for (int i = begin; i < end; ++i)
+				gain[i] = evaluateReinsertion(candidate[i], crossed[i]);
+		});
+
+		// candidates that would be reinserted along their current path leave the
+		// planarization unchanged; the first other one is committed, and since the
+		// evaluations of its successors are outdated then, they are evaluated again
+		itBatch = it;
+		batchSize = std::min(2 * batchSize, maxBatchSize);
+		for (int i = 0; i < n; ++i)
+		{
+			edge eOrig = candidate[i];
+			if (gain[i] == 0 && reinsertionKeepsPath(eOrig, crossed[i]))
+				continue;
+
+			m_pr.removeEdgePath(eOrig);
+			SList<adjEntry> eip;
+			for (edge e : crossed[i])
+				eip.pushBack(e->adjSource());
+			m_pr.insertEdgePath(eOrig, eip);
+
+			if (gain[i] > 0)
 				improved = true;
+
+			itBatch = position[i];
+			++itBatch;
+			batchSize = minBatchSize;
+			break;
 		}
-	} while (improved);
+	}
 
-#ifdef OGDF_DEBUG
-	bool isPlanar =
-#endif
-		planarEmbed(m_pr);
+	return improved;
+}
 
-	OGDF_ASSERT(isPlanar);
 
-	m_pr.removePseudoCrossings();
-	OGDF_ASSERT(m_pr.representsCombEmbedding());
+bool VarEdgeInserterCore::reinsertionKeepsPath(edge eOrig, const SList<edge> &crossed) const
+{
+	const List<edge> &path = m_pr.chain(eOrig);
+	if (path.size() - 1 != crossed.size())
+		return false;
+
+	auto isCrossingOfOrig = [&](node v) {
+		if (!m_pr.isDummy(v))
+			return false;
+		for (adjEntry adj : v->adjEntries)
+			if (m_pr.original(adj->theEdge()) == eOrig)
+				return true;
+		return false;
+	};
+
+	SListConstIterator<edge> itCrossed = crossed.begin();
+	for (ListConstIterator<edge> it = path.begin().succ(); it.valid(); ++it, ++itCrossed)
+	{
+		// find the piece of the crossed edge that remains after removing the path,
+		// i.e., the first one of the pieces merged by unsplitting the crossings
+		node u = (*it)->source();
+		edge e = nullptr;
+		do {
+			for (adjEntry adj : u->adjEntries) {
+				if (adj->theEdge()->target() == u && m_pr.original(adj->theEdge()) != eOrig) {
+					e = adj->theEdge();
+					break;
+				}
+			}
+			u = e->source();
+		} while (isCrossingOfOrig(u));
 
-	return retValue;
+		if (e != *itCrossed)
+			return false;
+	}
+
+	return true;
+}
+
+
+int VarEdgeInserterCore::evaluateReinsertion(edge eOrig, SList<edge> &crossed) const
+{
+	PlanRepLight pr(m_pr);
+
+	// the copy lists its edges in the same order as m_pr
+	EdgeArray<edge> prEdge(pr, nullptr);
+	auto itEdge = m_pr.edges.begin();
+	for (edge e : pr.edges) {
+		OGDF_ASSERT(pr.original(e) == m_pr.original(*itEdge));
+		prEdge[e] = *itEdge;
+		++itEdge;
+	}
+
+	std::unique_ptr<VarEdgeInserterCore> core(createWorkerCore(pr));
+	int pathLength = core->pathCost(eOrig);
+
+	SList<adjEntry> eip;
+	core->findPath(eOrig, eip);
+
+	// removing the path of eOrig unsplits the same edges in both graphs
+	crossed.clear();
+	for (adjEntry adj : eip)
+		crossed.pushBack(prEdge[adj->theEdge()]);
+
+	pr.insertEdgePath(eOrig, eip);
+	return pathLength - core->pathCost(eOrig);
+}
+
+
+VarEdgeInserterCore *VarEdgeInserterCore::createWorkerCore(PlanRepLight &pr) const
+{
+	return new VarEdgeInserterCore(pr, m_pCost, m_pForbidden, m_pSubgraph);
+}
+
+
+VarEdgeInserterCore *VarEdgeInserterUMLCore::createWorkerCore(PlanRepLight &pr) const
+{
+	return new VarEdgeInserterUMLCore(pr, m_pCost, m_pSubgraph);
+}
+
+
+void VarEdgeInserterCore::findPath(edge eOrig, SList<adjEntry> &eip)
+{
+	m_pr.removeEdgePath(eOrig);
+
+	storeTypeOfCurrentEdge(eOrig);
+
+	m_st = eOrig;
+	insert(m_pr.copy(eOrig->source()), m_pr.copy(eOrig->target()), eip);
+}
+
+
+int VarEdgeInserterCore::reinsert(edge eOrig)
+{
+	SList<adjEntry> eip;
+	findPath(eOrig, eip);
+	m_pr.insertEdgePath(eOrig, eip);
+
+	return pathCost(eOrig);
 }
 
 
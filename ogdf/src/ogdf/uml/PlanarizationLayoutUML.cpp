@@ -424,7 +424,7 @@ void PlanarizationLayoutUML::callFixEmbed(UMLGraph &umlGraph)
 {
 	m_nCrossings = 0;
 
-	if(((const Graph &)umlGraph).empty())
+	if(umlGraph.constGraph().empty())
 		return;
 
 	//check necessary preconditions
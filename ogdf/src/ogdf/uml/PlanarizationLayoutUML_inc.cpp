@@ -57,7 +57,7 @@ void PlanarizationLayoutUML::callIncremental(
 {
 	try {
 
-		if(((const Graph &)umlGraph).empty())
+		if(umlGraph.constGraph().empty())
 			return;
 
 		//check preconditions
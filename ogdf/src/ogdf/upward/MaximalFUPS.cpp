@@ -51,11 +51,19 @@ Module::ReturnType MaximalFUPS::doCall(UpwardPlanRep &UPR, List<edge> &delEdges)
 	for(node n : G.nodes) {
 		GC.newNode(n);
 	}
+
+	// all candidate subgraphs are tested with one incremental formula on a full copy
+	GraphCopy full(G);
+	EdgeArray<bool> selected(full, false);
+	UpSAT tester(full, true);
+	tester.setPortfolioSize(m_portfolioSize);
+
 	if(singleSource) {
 		for(adjEntry adj : source->adjEntries) {
 			edge eG = adj->theEdge();
 			OGDF_ASSERT( source == eG->source() );
 			GC.newEdge( eG );
+			selected[full.copy(eG)] = true;
 		}
 	} else source = nullptr;
 
@@ -69,15 +77,17 @@ Module::ReturnType MaximalFUPS::doCall(UpwardPlanRep &UPR, List<edge> &delEdges)
 		if (m_timelimit != 0 && timer.seconds()>m_timelimit) break;
 		edge fG = edges.popFrontRet();
 		if( fG->source() == source ) continue;
-		edge f = GC.newEdge( fG );
-		UpSAT tester(GC, true);
-		if (!tester.testUpwardPlanarity()) {
-			GC.delEdge(f);
+		selected[full.copy(fG)] = true;
+		if (tester.testUpwardPlanarity(selected)) {
+			GC.newEdge( fG );
+		} else {
+			selected[full.copy(fG)] = false;
 			delEdges.pushBack(fG);
 		}
 	}
 	timer.stop();
 	UpSAT embedder(GC, true);
+	embedder.setPortfolioSize(m_portfolioSize);
 	adjEntry externalToItsRight;
 	NodeArray<int>* nodeOrder = nullptr;
 	if(!singleSource) nodeOrder = new NodeArray<int>(GC);
@@ -85,7 +95,7 @@ Module::ReturnType MaximalFUPS::doCall(UpwardPlanRep &UPR, List<edge> &delEdges)
 		return Module::ReturnType::Error;
 
 	if(!singleSource) { //make single source
-		for(node n : G.nodes) {
+		for(node n : GC.nodes) {
 			if(n->indeg() == 0 && (*nodeOrder)[n]>0) {
 				adjEntry adj = n->lastAdj();
 				do {
@@ -39,6 +39,7 @@ namespace ogdf {
 
 UpSAT::UpSAT(Graph &G)
   : feasibleOriginalEdges(false)
+  , m_portfolioSize(1)
   , m_G(G)
   , N(m_G)
   , M(m_G)
@@ -65,6 +66,14 @@ UpSAT::UpSAT(GraphCopy &G, bool _feasibleOriginalEdges)
 	feasibleOriginalEdges = _feasibleOriginalEdges;
 }
 
+bool UpSAT::solve(Model &model, const std::vector<int> &assumptions)
+{
+	if (m_portfolioSize > 1) {
+		return m_F.solvePortfolio(model, m_portfolioSize, assumptions);
+	}
+	return m_F.solve(model, assumptions);
+}
+
 void UpSAT::computeDominatingEdges()
 {
 	NodeArray<bool> visit(m_G);
@@ -152,6 +161,10 @@ void UpSAT::reset()
 			tau[N[u]][N[v]] = -1;
 		}
 	}
+	for (edge e : m_G.edges) {
+		D[e].clear();
+	}
+	selector.clear();
 	m_F.reset();
 }
 
@@ -244,6 +257,9 @@ void UpSAT::ruleUpward()
 			}
 			clause c = m_F.newClause();
 			c->add(w1);
+			if (!selector.empty()) {
+				c->add(-selector[M[e]]);
+			}
 			m_F.finalizeClause(c);
 			++numberOfClauses;
 		}
@@ -361,6 +377,11 @@ void UpSAT::ruleTutte()
 				c2->addMultiple(5, -w1, -w2, -w3, -w4, -w5);
 				c3->addMultiple(4, -w1, w2, w4, -w6);
 				c4->addMultiple(4, -w1, w2, -w4, w6);
+				if (!selector.empty()) {
+					for (clause c : {c1, c2, c3, c4}) {
+						c->addMultiple(2, -selector[M[e]], -selector[M[f]]);
+					}
+				}
 				m_F.finalizeClause(c1);
 				m_F.finalizeClause(c2);
 				m_F.finalizeClause(c3);
@@ -403,7 +424,7 @@ bool UpSAT::HL(bool embed, adjEntry& externalToItsRight, NodeArray<int> *nodeOrd
 	ruleUpward();
 	ruleTutte();
 	Model model;
-	bool result = m_F.solve(model);
+	bool result = solve(model);
 
 	if (!result) {
 		return result;
@@ -426,7 +447,7 @@ bool UpSAT::HL(bool embed, adjEntry& externalToItsRight, NodeArray<int> *nodeOrd
 	rulePlanarity();
 
 	Model embModel;
-	m_F.solve(embModel);
+	solve(embModel);
 
 	if (embed) {
 		embedFromModel(embModel, externalToItsRight);
@@ -450,7 +471,7 @@ bool UpSAT::FPSS(NodeArray<int> *nodeOrder)
 	ruleUpward();
 	ruleTutte();
 	Model model;
-	bool result = m_F.solve(model);
+	bool result = solve(model);
 	if(nodeOrder) writeNodeOrder(model,nodeOrder);
 	return result;
 }
@@ -468,7 +489,7 @@ bool UpSAT::OE(bool embed, adjEntry& externalToItsRight, NodeArray<int> *nodeOrd
 
 	m_F.newVars(numberOfVariables);
 	Model model;
-	bool result = m_F.solve(model);
+	bool result = solve(model);
 
 	if (result && embed) {
 		embedFromModel(model, externalToItsRight);
@@ -573,6 +594,42 @@ void UpSAT::embedFromModel(const Model &model, adjEntry& externalToItsRight)
 }
 
 bool UpSAT::testUpwardPlanarity(NodeArray<int> *nodeOrder/* = NULL*/) { return FPSS(nodeOrder); }
+
+bool UpSAT::testUpwardPlanarity(const EdgeArray<bool> &selected, NodeArray<int> *nodeOrder/* = NULL*/)
+{
+	if (selector.empty()) {
+		// Dominating pairs may only be skipped if the order respects every edge,
+		// otherwise all pairs of (possibly selected) edges get Tutte clauses.
+		if (feasibleOriginalEdges) {
+			computeDominatingEdges();
+		}
+		computeTauVariables();
+		computeMuVariables();
+		if (feasibleOriginalEdges) {
+			computeSigmaVariables();
+		}
+		selector.resize(m_G.numberOfEdges());
+		for (edge e : m_G.edges) {
+			selector[M[e]] = ++numberOfVariables;
+		}
+		m_F.newVars(numberOfVariables);
+		ruleTauTransitive();
+		ruleUpward();
+		ruleTutte();
+	}
+
+	std::vector<int> assumptions;
+	assumptions.reserve(m_G.numberOfEdges());
+	for (edge e : m_G.edges) {
+		assumptions.push_back(selected[e] ? selector[M[e]] : -selector[M[e]]);
+	}
+	Model model;
+	bool result = solve(model, assumptions);
+	if (result && nodeOrder) {
+		writeNodeOrder(model, nodeOrder);
+	}
+	return result;
+}
 bool UpSAT::embedUpwardPlanar(adjEntry& externalToItsRight, NodeArray<int> *nodeOrder/* = NULL*/)   { return HL(true, externalToItsRight, nodeOrder);   }
 
 class Comp {
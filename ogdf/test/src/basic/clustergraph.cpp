@@ -0,0 +1,289 @@
+/** \file
+ * \brief Tests for the cluster tree queries of ClusterGraph and for ClusterAnalysis
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <bandit/bandit.h>
+#include <ogdf/basic/DisjointSets.h>
+#include <ogdf/basic/graph_generators.h>
+#include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/cluster/ClusterAnalysis.h>
+#include <ogdf/cluster/ClusterArray.h>
+
+using namespace ogdf;
+using namespace bandit;
+
+//! Returns the depth of \p c by walking up to the root.
+static int walkDepth(cluster c)
+{
+	int depth = 0;
+	for (; c->parent() != nullptr; c = c->parent()) {
+		depth++;
+	}
+	return depth;
+}
+
+//! Returns the lowest common ancestor of \p c and \p d by walking up the parents.
+static cluster walkCommonCluster(cluster c, cluster d)
+{
+	int dc = walkDepth(c), dd = walkDepth(d);
+	for (; dc > dd; dc--) c = c->parent();
+	for (; dd > dc; dd--) d = d->parent();
+	while (c != d) {
+		c = c->parent();
+		d = d->parent();
+	}
+	return c;
+}
+
+//! Returns true iff \p c lies in the subtree rooted at \p ancestor.
+static bool walkIsDescendant(cluster c, cluster ancestor)
+{
+	for (; c != nullptr; c = c->parent()) {
+		if (c == ancestor) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//! Returns a random cluster of \p C satisfying \p includeCluster.
+template<typename Predicate>
+static cluster chooseCluster(const ClusterGraph &C, Predicate includeCluster)
+{
+	Array<cluster> candidates(0, C.numberOfClusters() - 1, nullptr);
+	int k = 0;
+	for (cluster c : C.clusters) {
+		if (includeCluster(c)) {
+			candidates[k++] = c;
+		}
+	}
+	return k == 0 ? nullptr : candidates[randomNumber(0, k - 1)];
+}
+
+static cluster chooseCluster(const ClusterGraph &C)
+{
+	return chooseCluster(C, [](cluster) { return true; });
+}
+
+//! Creates a random graph with a random cluster tree of about \p numberOfClusters clusters.
+static void randomClusteredGraph(Graph &G, ClusterGraph &C, int n, int m, int numberOfClusters)
+{
+	randomSimpleGraph(G, n, m);
+	makeConnected(G);
+	C.init(G);
+	randomClusterGraph(C, G, numberOfClusters);
+}
+
+static void checkCommonClusters(const ClusterGraph &C, const Graph &G)
+{
+	for (node v : G.nodes) {
+		node w = G.chooseNode();
+		cluster lca = walkCommonCluster(C.clusterOf(v), C.clusterOf(w));
+		AssertThat(C.commonCluster(v, w), Equals(lca));
+
+		cluster c1, c2;
+		AssertThat(C.commonClusterLastAncestors(v, w, c1, c2), Equals(lca));
+		if (C.clusterOf(v) == C.clusterOf(w)) {
+			AssertThat(c1, Equals(lca));
+			AssertThat(c2, Equals(lca));
+		} else {
+			AssertThat(c1 == nullptr, Equals(C.clusterOf(v) == lca));
+			AssertThat(c2 == nullptr, Equals(C.clusterOf(w) == lca));
+			if (c1 != nullptr) {
+				AssertThat(c1->parent(), Equals(lca));
+				AssertThat(walkIsDescendant(C.clusterOf(v), c1), IsTrue());
+			}
+			if (c2 != nullptr) {
+				AssertThat(c2->parent(), Equals(lca));
+				AssertThat(walkIsDescendant(C.clusterOf(w), c2), IsTrue());
+			}
+		}
+
+		List<cluster> path;
+		AssertThat(C.commonClusterPath(v, w, path), Equals(lca));
+		AssertThat(path.front(), Equals(C.clusterOf(v)));
+		AssertThat(path.back(), Equals(C.clusterOf(w)));
+		AssertThat(path.size(), Equals(walkDepth(C.clusterOf(v)) + walkDepth(C.clusterOf(w)) - 2 * walkDepth(lca) + 1));
+		for (ListConstIterator<cluster> it = path.begin(); it.succ().valid(); ++it) {
+			cluster c = *it, d = *it.succ();
+			AssertThat(c->parent() == d || d->parent() == c, IsTrue());
+		}
+	}
+}
+
+go_bandit([]() {
+	describe("ClusterGraph", []() {
+		it("computes lowest common clusters", []() {
+			Graph G;
+			ClusterGraph C;
+			randomClusteredGraph(G, C, 300, 600, 60);
+			checkCommonClusters(C, G);
+
+			for (cluster c : C.clusters) {
+				cluster d = chooseCluster(C);
+				AssertThat(C.commonCluster(c, d), Equals(walkCommonCluster(c, d)));
+				AssertThat(C.isDescendant(c, d), Equals(walkIsDescendant(c, d)));
+				AssertThat(C.isDescendant(d, c), Equals(walkIsDescendant(d, c)));
+			}
+
+			SList<node> nodes;
+			cluster lca = nullptr;
+			for (int i = 0; i < 5; i++) {
+				node v = G.chooseNode();
+				nodes.pushBack(v);
+				lca = lca == nullptr ? C.clusterOf(v) : walkCommonCluster(lca, C.clusterOf(v));
+			}
+			AssertThat(C.commonCluster(nodes), Equals(lca));
+		});
+
+		it("keeps lowest common clusters up to date when the cluster tree changes", []() {
+			Graph G;
+			ClusterGraph C;
+			randomClusteredGraph(G, C, 200, 400, 40);
+			checkCommonClusters(C, G);
+
+			for (int i = 0; i < 10 && C.numberOfClusters() > 2; i++) {
+				cluster c = chooseCluster(C, [&](cluster d) { return d != C.rootCluster(); });
+				cluster parent = chooseCluster(C, [&](cluster d) { return !walkIsDescendant(d, c); });
+				C.moveCluster(c, parent);
+				checkCommonClusters(C, G);
+
+				C.reassignNode(G.chooseNode(), chooseCluster(C));
+				checkCommonClusters(C, G);
+
+				SList<node> nodes;
+				nodes.pushBack(G.chooseNode());
+				C.createCluster(nodes, chooseCluster(C));
+				checkCommonClusters(C, G);
+
+				C.delCluster(chooseCluster(C, [&](cluster d) { return d != C.rootCluster(); }));
+				checkCommonClusters(C, G);
+			}
+
+			ClusterGraph copy(C);
+			checkCommonClusters(copy, G);
+		});
+	});
+
+	describe("ClusterAnalysis", []() {
+		for (int numberOfClusters : {1, 10, 80}) {
+			it("analyzes a graph with up to " + to_string(numberOfClusters) + " clusters", [&]() {
+				Graph G;
+				ClusterGraph C;
+				randomClusteredGraph(G, C, 150, 300, numberOfClusters);
+				ClusterAnalysis ca(C, true);
+
+				ClusterArray<NodeArray<bool>> contains(C);
+				for (cluster c : C.clusters) {
+					contains[c].init(G, false);
+					c->getClusterNodes(contains[c]);
+				}
+
+				for (cluster c : C.clusters) {
+					int outer = 0, inner = 0;
+					for (node v : G.nodes) {
+						bool isOuter = false, isInner = false;
+						for (adjEntry adj : v->adjEntries) {
+							bool inside = contains[c][adj->twinNode()];
+							isOuter |= contains[c][v] && !inside;
+							isInner |= !contains[c][v] && inside;
+						}
+						AssertThat(ca.isOuterActive(v, c), Equals(isOuter));
+						AssertThat(ca.isInnerActive(v, c), Equals(isInner));
+						outer += isOuter;
+						inner += isInner;
+						if (isOuter) {
+							AssertThat(ca.minOALevel(v), IsLessThanOrEqualTo(walkDepth(c)));
+						}
+						if (isInner) {
+							AssertThat(ca.minIALevel(v), IsLessThanOrEqualTo(walkDepth(c)));
+						}
+						if (!contains[c][v]) {
+							AssertThat(ca.bagIndex(v, c), Equals(ClusterAnalysis::DefaultIndex));
+						}
+					}
+					AssertThat(ca.outerActive(c), Equals(outer));
+					AssertThat(ca.innerActive(c), Equals(inner));
+					AssertThat(ca.oaNodes(c).size(), Equals(outer));
+
+					// bags are the components of the subgraph induced by c
+					// after contracting each child cluster
+					DisjointSets<> uf;
+					NodeArray<int> set(G);
+					for (node v : G.nodes) {
+						set[v] = uf.makeSet();
+					}
+					auto unite = [&](node u, node v) {
+						int s = uf.find(set[u]), t = uf.find(set[v]);
+						if (s != t) {
+							uf.link(s, t);
+						}
+					};
+					for (edge e : G.edges) {
+						if (contains[c][e->source()] && contains[c][e->target()]) {
+							unite(e->source(), e->target());
+						}
+					}
+					for (cluster child : c->children) {
+						List<node> nodes;
+						child->getClusterNodes(nodes);
+						for (node v : nodes) {
+							unite(nodes.front(), v);
+						}
+					}
+					int bags = 0;
+					for (node v : G.nodes) {
+						if (!contains[c][v]) {
+							continue;
+						}
+						if (uf.find(set[v]) == set[v]) {
+							bags++;
+						}
+						for (node w : G.nodes) {
+							if (contains[c][w]) {
+								AssertThat(ca.bagIndex(v, c) == ca.bagIndex(w, c), Equals(uf.find(set[v]) == uf.find(set[w])));
+							}
+						}
+					}
+					AssertThat(ca.numberOfBags(c), Equals(bags));
+				}
+
+				// independent bags are bags without outer active vertices
+				AssertThat(ca.numberOfIndyBags(), IsGreaterThan(0));
+				for (node v : G.nodes) {
+					int i = ca.indyBagIndex(v);
+					AssertThat(i, IsGreaterThanOrEqualTo(0));
+					AssertThat(i, IsLessThan(ca.numberOfIndyBags()));
+					cluster root = ca.indyBagRoot(i);
+					AssertThat(contains[root][v], IsTrue());
+					AssertThat(ca.isOuterActive(v, root), IsFalse());
+				}
+			});
+		}
+	});
+});
@@ -91,6 +91,88 @@ void performIteration(int n, int m) {
 	});
 }
 
+//! Asserts that \c dual is the dual graph of \c emb as if it was constructed from scratch.
+void validateDual(const Graph &graph, const CombinatorialEmbedding &emb, DualGraph &dual) {
+	AssertThat(dual.consistencyCheck(), IsTrue());
+	AssertThat(dual.numberOfFaces(), Equals(graph.numberOfNodes()));
+	AssertThat(dual.getGraph().numberOfNodes(), Equals(emb.numberOfFaces()));
+	AssertThat(dual.getGraph().numberOfEdges(), Equals(graph.numberOfEdges()));
+
+	for (face f : emb.faces) {
+		node v = dual.dualNode(f);
+		AssertThat(dual.primalFace(v), Equals(f));
+
+		// the dual adjacency entries are ordered like the face cycle
+		adjEntry adjDual = dual.dualEdge(f->firstAdj()->theEdge())->adjSource();
+		if (f->firstAdj() != f->firstAdj()->theEdge()->adjSource()) {
+			adjDual = adjDual->twin();
+		}
+		for (adjEntry adj : f->entries) {
+			AssertThat(dual.primalEdge(adjDual->theEdge()), Equals(adj->theEdge()));
+			AssertThat(adjDual->theNode(), Equals(v));
+			adjDual = adjDual->cyclicSucc();
+		}
+		AssertThat(v->degree(), Equals(f->size()));
+	}
+
+	for (node v : graph.nodes) {
+		face f = dual.dualFace(v);
+		AssertThat(dual.primalNode(f), Equals(v));
+		AssertThat(f->size(), Equals(v->degree()));
+	}
+
+	for (edge e : graph.edges) {
+		edge g = dual.dualEdge(e);
+		AssertThat(dual.primalEdge(g), Equals(e));
+		AssertThat(dual.primalFace(g->source()), Equals(emb.rightFace(e->adjSource())));
+		AssertThat(dual.primalFace(g->target()), Equals(emb.rightFace(e->adjTarget())));
+	}
+}
+
+//! Inserts and removes \c k random edges while updating the dual graph.
+void performUpdates(int n, int m, int k) {
+	Graph graph;
+	planarConnectedGraph(graph, n, m);
+	CombinatorialEmbedding emb(graph);
+	DualGraph dual(emb);
+
+	it("inserts edges by splitting faces", [&] {
+		for (int i = 0; i < k; i++) {
+			face f = emb.chooseFace();
+			if (f->size() < 2) {
+				continue;
+			}
+			Array<adjEntry> entries(f->size());
+			int j = 0;
+			for (adjEntry adj : f->entries) {
+				entries[j++] = adj;
+			}
+			int src = randomNumber(0, f->size() - 1);
+			int tgt = (src + randomNumber(1, f->size() - 1)) % f->size();
+			edge e = dual.splitPrimalFace(entries[src], entries[tgt]);
+			AssertThat(e->source(), Equals(entries[src]->theNode()));
+			AssertThat(e->target(), Equals(entries[tgt]->theNode()));
+		}
+		AssertThat(emb.consistencyCheck(), IsTrue());
+		validateDual(graph, emb, dual);
+	});
+
+	it("removes edges by joining faces", [&] {
+		for (int i = 0; i < k; i++) {
+			edge e = graph.chooseEdge([&](edge eCand) {
+				return emb.rightFace(eCand->adjSource()) != emb.rightFace(eCand->adjTarget());
+			});
+			if (e == nullptr) {
+				break;
+			}
+			face f = dual.joinPrimalFaces(e);
+			AssertThat(dual.primalFace(dual.dualNode(f)), Equals(f));
+		}
+		AssertThat(emb.consistencyCheck(), IsTrue());
+		validateDual(graph, emb, dual);
+	});
+}
+
 go_bandit([]() {
 	describe("DualGraph",[] {
 		for(int i = 1; i <= 100; i++) {
@@ -98,5 +180,11 @@ go_bandit([]() {
 				performIteration(100, 200);
 			});
 		}
+
+		for(int i = 1; i <= 20; i++) {
+			describe("incremental update #" + to_string(i), [i]() {
+				performUpdates(50, 60 + 5*i, 100);
+			});
+		}
 	});
 });
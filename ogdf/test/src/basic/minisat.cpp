@@ -99,6 +99,36 @@ static void readDIMACSTest()
 	AssertThat(satisfiable, IsFalse());
 }
 
+static void assumptionsTest()
+{
+	Minisat::Formula F;
+	Minisat::Model model;
+	// 3 and 4 act as selectors switching the contradicting clauses on
+	F.addClause(std::vector<int>{1, -3});
+	F.addClause(std::vector<int>{-1, -4});
+
+	AssertThat(F.solve(model, {3, -4}), IsTrue());
+	AssertThat(model.getValue(1), IsTrue());
+	AssertThat(F.solve(model, {-3, 4}), IsTrue());
+	AssertThat(model.getValue(1), IsFalse());
+	AssertThat(F.solve(model, {3, 4}), IsFalse());
+
+	// the formula itself is still satisfiable afterwards
+	AssertThat(F.solve(model), IsTrue());
+}
+
+static void portfolioTest(int numberOfSolvers)
+{
+	Minisat::Formula F;
+	Minisat::Model model;
+	AssertThat(F.readDimacs(RESOURCE_DIR + "/" + "minisat/satisfiable.txt"), IsTrue());
+	AssertThat(F.solvePortfolio(model, numberOfSolvers), IsTrue());
+	AssertThat(F.solvePortfolio(model, numberOfSolvers, {3}), IsFalse());
+
+	F.addClause(std::vector<int>{3});
+	AssertThat(F.solvePortfolio(model, numberOfSolvers), IsFalse());
+}
+
 go_bandit([]() {
 	describe("Minisat wrapper", []() {
 		it("solves a satisfiable formula", []() {
@@ -110,5 +140,13 @@ go_bandit([]() {
 		it("reads a DIMACS file and is able to solve the formula and change it", []() {
 			readDIMACSTest();
 		});
+		it("solves a formula under assumptions", []() {
+			assumptionsTest();
+		});
+		for (int k : {1, 2, 4}) {
+			it("solves a formula with a portfolio of " + to_string(k) + " solvers", [k]() {
+				portfolioTest(k);
+			});
+		}
 	});
 });
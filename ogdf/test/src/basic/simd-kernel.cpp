@@ -0,0 +1,134 @@
+/** \file
+ * \brief Tests for SIMDKernel and the detection of CPU features
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <bandit/bandit.h>
+#include <ogdf/basic/SIMDKernel.h>
+#include <ogdf/basic/graph_generators.h>
+#include <ogdf/energybased/StressMinimization.h>
+#include <sstream>
+
+using namespace ogdf;
+using namespace bandit;
+
+static int twiceScalar(int a) { return 2 * a; }
+static int twiceShifted(int a) { return a << 1; }
+static int twiceWrong(int a) { return a; }
+
+//! A feature that is never detected.
+static constexpr unsigned int UNKNOWN_FEATURE = 1u << 31;
+
+go_bandit([]() {
+	describe("SIMD kernels", []() {
+		after_each([]() {
+			SIMDKernels::restrictFeatures(~0u);
+		});
+
+#if defined(__x86_64__) || defined(_M_X64)
+		it("detects SSE2 on x86-64", []() {
+			AssertThat(System::cpuSupports(CPUFeature::SSE2), IsTrue());
+		});
+#endif
+
+		it("detects AVX2 and AVX-512 only along with AVX", []() {
+			if (System::cpuSupports(CPUFeature::AVX2) || System::cpuSupports(CPUFeature::AVX512F)) {
+				AssertThat(System::cpuSupports(CPUFeature::AVX), IsTrue());
+			}
+		});
+
+		it("selects the most advanced available variant", []() {
+			SIMDKernel<int(int)> kernel("twice", {
+				{"scalar", 0, &twiceScalar},
+				{"shifted", 0, &twiceShifted},
+				{"unknown", UNKNOWN_FEATURE, &twiceWrong}},
+				[](int (*variant)(int), int (*reference)(int)) { return variant(21) == reference(21); },
+				[](int (*variant)(int)) { variant(1); });
+
+			AssertThat(kernel.selectedVariant(), Equals(1));
+			AssertThat(kernel(21), Equals(42));
+			AssertThat(kernel.isAvailable(2), IsFalse());
+
+			kernel.selectVariant(0);
+			AssertThat(kernel(4), Equals(8));
+			AssertThat(kernel.selfTest(1), IsTrue());
+		});
+
+		it("reports variants failing the self-test", []() {
+			SIMDKernel<int(int)> kernel("twice", {
+				{"scalar", 0, &twiceScalar},
+				{"wrong", 0, &twiceWrong}},
+				[](int (*variant)(int), int (*reference)(int)) { return variant(21) == reference(21); },
+				[](int (*variant)(int)) { variant(1); });
+
+			std::ostringstream os;
+			AssertThat(SIMDKernels::selfTest(&os), IsFalse());
+			AssertThat(os.str(), Contains("wrong"));
+		});
+
+		it("passes the self-test of all kernels", []() {
+			std::ostringstream os;
+			bool passed = SIMDKernels::selfTest(&os);
+			AssertThat(os.str(), Equals(""));
+			AssertThat(passed, IsTrue());
+		});
+
+		it("falls back to the reference implementations", []() {
+			AssertThat(SIMDKernels::all().empty(), IsFalse());
+			SIMDKernels::restrictFeatures(0);
+			for (SIMDKernelBase *kernel : SIMDKernels::all()) {
+				AssertThat(kernel->selectedVariant(), Equals(0));
+			}
+		});
+
+		it("computes similar stress majorization layouts with every variant", []() {
+			Graph G;
+			randomSimpleGraph(G, 300, 600);
+			GraphAttributes reference(G), current(G);
+			StressMinimization L;
+			L.setIterations(10);
+			SIMDKernels::restrictFeatures(0);
+			L.call(reference);
+			SIMDKernels::restrictFeatures(~0u);
+			L.call(current);
+
+			for (node v : G.nodes) {
+				AssertThat(current.x(v), EqualsWithDelta(reference.x(v), 1e-6 * (1 + std::fabs(reference.x(v)))));
+				AssertThat(current.y(v), EqualsWithDelta(reference.y(v), 1e-6 * (1 + std::fabs(reference.y(v)))));
+			}
+		});
+
+		it("benchmarks all available variants", []() {
+			std::ostringstream os;
+			SIMDKernels::benchmark(os, 1, true);
+			for (SIMDKernelBase *kernel : SIMDKernels::all()) {
+				AssertThat(os.str(), Contains(kernel->name()));
+				AssertThat(kernel->isAvailable(kernel->selectedVariant()), IsTrue());
+			}
+		});
+	});
+});
@@ -0,0 +1,174 @@
+/** \file
+ * \brief Tests for the SpatialIndex class
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <bandit/bandit.h>
+#include <ogdf/basic/SpatialIndex.h>
+#include <ogdf/basic/graph_generators.h>
+#include <random>
+
+using namespace ogdf;
+using namespace bandit;
+
+static void randomLayout(GraphAttributes &GA, std::minstd_rand &rng)
+{
+	std::uniform_real_distribution<double> coord(0.0, 1000.0);
+	std::uniform_real_distribution<double> size(5.0, 30.0);
+	for (node v : GA.constGraph().nodes) {
+		GA.x(v) = coord(rng);
+		GA.y(v) = coord(rng);
+		GA.width(v) = size(rng);
+		GA.height(v) = size(rng);
+	}
+	for (edge e : GA.constGraph().edges) {
+		GA.bends(e).clear();
+		if (e->index() % 3 == 0) {
+			GA.bends(e).pushBack(DPoint(coord(rng), coord(rng)));
+		}
+	}
+}
+
+static bool contains(const GraphAttributes &GA, node v, const DRect &box)
+{
+	return GA.x(v) - GA.width(v) / 2 <= box.p2().m_x && box.p1().m_x <= GA.x(v) + GA.width(v) / 2
+	    && GA.y(v) - GA.height(v) / 2 <= box.p2().m_y && box.p1().m_y <= GA.y(v) + GA.height(v) / 2;
+}
+
+static void assertNodesInBox(const GraphAttributes &GA, const SpatialIndex &index, const DRect &box)
+{
+	ArrayBuffer<node> hits;
+	index.nodesInBox(box, hits);
+	NodeArray<bool> hit(GA.constGraph(), false);
+	for (node v : hits) {
+		AssertThat(hit[v], IsFalse());
+		hit[v] = true;
+	}
+	for (node v : GA.constGraph().nodes) {
+		AssertThat(hit[v], Equals(contains(GA, v, box)));
+	}
+}
+
+go_bandit([]() {
+	describe("SpatialIndex", []() {
+		std::minstd_rand rng(42);
+		Graph G;
+		GraphAttributes GA(G, GraphAttributes::nodeGraphics | GraphAttributes::edgeGraphics);
+
+		before_each([&]() {
+			randomGraph(G, 200, 400);
+			randomLayout(GA, rng);
+		});
+
+		it("handles an empty graph", [&]() {
+			G.clear();
+			SpatialIndex index(GA);
+			ArrayBuffer<node> nodes;
+			index.nodesInBox(DRect(0, 0, 1000, 1000), nodes);
+			index.nearestNodes(DPoint(0, 0), 3, nodes);
+			AssertThat(nodes.empty(), IsTrue());
+			AssertThat(index.nodeAt(DPoint(0, 0)) == nullptr, IsTrue());
+			AssertThat(index.edgeAt(DPoint(0, 0), 10) == nullptr, IsTrue());
+		});
+
+		it("finds exactly the nodes intersecting a box", [&]() {
+			SpatialIndex index(GA);
+			for (int i = 0; i < 20; ++i) {
+				double x = 50.0 * i, y = 1000.0 - 40.0 * i;
+				assertNodesInBox(GA, index, DRect(x, y - 200, x + 150, y));
+			}
+		});
+
+		it("finds the topmost node under a point", [&]() {
+			SpatialIndex index(GA);
+			for (node v : G.nodes) {
+				node hit = index.nodeAt(DPoint(GA.x(v), GA.y(v)));
+				AssertThat(hit == nullptr, IsFalse());
+				AssertThat(hit->index() >= v->index(), IsTrue());
+			}
+			AssertThat(index.nodeAt(DPoint(-500, -500)) == nullptr, IsTrue());
+		});
+
+		it("finds edges along their polylines", [&]() {
+			SpatialIndex index(GA);
+			for (edge e : G.edges) {
+				DPoint p(GA.x(e->source()), GA.y(e->source()));
+				DPoint q = GA.bends(e).empty() ? DPoint(GA.x(e->target()), GA.y(e->target())) : GA.bends(e).front();
+				DPoint mid((p.m_x + q.m_x) / 2, (p.m_y + q.m_y) / 2);
+				AssertThat(index.edgeAt(mid, 1e-6) == nullptr, IsFalse());
+
+				ArrayBuffer<edge> hits;
+				index.edgesInBox(DRect(mid.m_x - 1, mid.m_y - 1, mid.m_x + 1, mid.m_y + 1), hits);
+				AssertThat(std::find(hits.begin(), hits.end(), e) != hits.end(), IsTrue());
+			}
+		});
+
+		it("returns the nearest nodes in order of distance", [&]() {
+			SpatialIndex index(GA);
+			DPoint p(500, 500);
+			ArrayBuffer<node> nearest;
+			index.nearestNodes(p, 10, nearest);
+			AssertThat(nearest.size(), Equals(10));
+
+			auto distance = [&](node v) {
+				double dx = std::max(std::abs(GA.x(v) - p.m_x) - GA.width(v) / 2, 0.0);
+				double dy = std::max(std::abs(GA.y(v) - p.m_y) - GA.height(v) / 2, 0.0);
+				return std::sqrt(dx * dx + dy * dy);
+			};
+			for (int i = 1; i < nearest.size(); ++i) {
+				AssertThat(distance(nearest[i - 1]), IsLessThanOrEqualTo(distance(nearest[i]) + 1e-9));
+			}
+			int closer = 0;
+			for (node v : G.nodes) {
+				if (distance(v) < distance(nearest[9]) - 1e-9) {
+					++closer;
+				}
+			}
+			AssertThat(closer, IsLessThan(10));
+		});
+
+		it("stays consistent after moving nodes", [&]() {
+			SpatialIndex index(GA);
+			int i = 0;
+			for (node v : G.nodes) {
+				if (i++ % 4 == 0) {
+					GA.x(v) = 2000.0 + i;
+					GA.y(v) = 2000.0;
+					index.updateNode(v);
+				}
+			}
+			assertNodesInBox(GA, index, DRect(1900, 1900, 2300, 2100));
+			assertNodesInBox(GA, index, DRect(0, 0, 500, 500));
+			AssertThat(index.boundingBox().p2().m_x, IsGreaterThanOrEqualTo(2000.0));
+
+			edge e = G.firstEdge();
+			GA.bends(e).pushBack(DPoint(-300, -300));
+			index.updateEdge(e);
+			AssertThat(index.edgeAt(DPoint(-300, -300), 1e-6) == e, IsTrue());
+		});
+	});
+});
@@ -0,0 +1,110 @@
+/** \file
+ * \brief Tests for the Tracer class
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <bandit/bandit.h>
+#include <ogdf/basic/Tracer.h>
+#include <ogdf/basic/graph_generators.h>
+#include <ogdf/energybased/FMMMLayout.h>
+
+using namespace ogdf;
+using namespace bandit;
+
+static void tracedFunction()
+{
+	TraceScope outer("outer");
+	{
+		TraceScope inner("inner");
+	}
+}
+
+go_bandit([]() {
+	describe("Tracer", []() {
+		before_each([]() {
+			Tracer::enable(false);
+			Tracer::clear();
+		});
+
+		after_each([]() {
+			Tracer::enable(false);
+			Tracer::clear();
+		});
+
+		it("records nothing while disabled", []() {
+			tracedFunction();
+			AssertThat(Tracer::numberOfEvents(), Equals(0u));
+		});
+
+		it("records nested spans", []() {
+			Tracer::enable();
+			tracedFunction();
+			std::vector<Tracer::Event> events = Tracer::events();
+			AssertThat(events.size(), Equals(2u));
+			AssertThat(string(events[0].name), Equals("inner"));
+			AssertThat(events[0].depth, Equals(1));
+			AssertThat(string(events[1].name), Equals("outer"));
+			AssertThat(events[1].depth, Equals(0));
+			AssertThat(events[1].start, IsLessThanOrEqualTo(events[0].start));
+			AssertThat(events[1].start + events[1].duration,
+			           IsGreaterThanOrEqualTo(events[0].start + events[0].duration));
+		});
+
+		it("clears recorded spans", []() {
+			Tracer::enable();
+			tracedFunction();
+			Tracer::clear();
+			AssertThat(Tracer::numberOfEvents(), Equals(0u));
+		});
+
+		it("writes Chrome trace events", []() {
+			Tracer::enable();
+			tracedFunction();
+			std::ostringstream os;
+			Tracer::writeChromeTrace(os);
+			string json = os.str();
+			AssertThat(json, StartsWith("{\"traceEvents\":["));
+			AssertThat(json, Contains("\"name\":\"outer\""));
+			AssertThat(json, Contains("\"ph\":\"X\""));
+		});
+
+		it("records the phases of a layout module", []() {
+			Graph G;
+			randomSimpleGraph(G, 50, 100);
+			GraphAttributes GA(G);
+			Tracer::enable();
+			FMMMLayout fmmm;
+			fmmm.call(GA);
+			std::ostringstream os;
+			Tracer::writeChromeTrace(os);
+#ifdef OGDF_TRACING
+			AssertThat(os.str(), Contains("FMMMLayout::call"));
+			AssertThat(os.str(), Contains("FMMMLayout::forceCalculation"));
+#endif
+		});
+	});
+});
@@ -351,6 +351,10 @@ registerDirectedCutVariants(std::vector<ModuleTuple<T>*> &modules)
 
 		modules.push_back(new ModuleTuple<T>(ss.str(), alg, 1));
 	}
+
+	MinSteinerTreeDirectedCut<T> *alg = new MinSteinerTreeDirectedCut<T>();
+	alg->setNumberOfThreads(4);
+	modules.push_back(new ModuleTuple<T>("DirectedCut, 4 threads", alg, 1));
 }
 
 /**
@@ -0,0 +1,120 @@
+/** \file
+ * \brief Tests for BalloonLayout
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <bandit/bandit.h>
+
+#include <ogdf/misclayout/BalloonLayout.h>
+
+#include "layout_helpers.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+//! Creates a random tree with \p n nodes in linear time.
+static void randomTreeFast(Graph &G, int n)
+{
+	Array<node> v(n);
+	v[0] = G.newNode();
+	for (int i = 1; i < n; ++i) {
+		v[i] = G.newNode();
+		G.newEdge(v[randomNumber(0, i - 1)], v[i]);
+	}
+}
+
+go_bandit([]() {
+	describe("BalloonLayout", []() {
+		BalloonLayout balloon;
+		describeLayoutModule("BalloonLayout", balloon, 0, {GraphRequirement::connected});
+
+		BalloonLayout balloonOptimized;
+		balloonOptimized.setChildOrder(BalloonLayout::ChildOrder::Optimized);
+		describeLayoutModule("BalloonLayout with optimized child order", balloonOptimized, 0, {GraphRequirement::connected});
+
+		it("places the leaves of a star on a circle", []() {
+			Graph G;
+			node center = G.newNode();
+			for (int i = 0; i < 50; ++i) {
+				G.newEdge(center, G.newNode());
+			}
+			GraphAttributes GA(G);
+			BalloonLayout L;
+			L.call(GA);
+
+			DPoint c(GA.x(center), GA.y(center));
+			double radius = c.distance(DPoint(GA.x(G.lastNode()), GA.y(G.lastNode())));
+			AssertThat(radius, IsGreaterThan(0.0));
+			for (adjEntry adj : center->adjEntries) {
+				node v = adj->twinNode();
+				AssertThat(c.distance(DPoint(GA.x(v), GA.y(v))), IsGreaterThan(radius - 1e-9) && IsLessThan(radius + 1e-9));
+			}
+		});
+
+		it("does not depend on the number of threads", []() {
+			Graph G;
+			randomTreeFast(G, 100000);
+			Array<node> nodes(G.numberOfNodes());
+			int i = 0;
+			for (node v : G.nodes) {
+				nodes[i++] = v;
+			}
+			for (i = 0; i < 20000; ++i) {
+				G.newEdge(nodes[randomNumber(0, nodes.high())], nodes[randomNumber(0, nodes.high())]);
+			}
+			GraphAttributes GA1(G), GA4(G);
+			BalloonLayout L;
+			L.setChildOrder(BalloonLayout::ChildOrder::Optimized);
+			L.call(GA1);
+			L.maxThreads(4);
+			L.call(GA4);
+
+			for (node v : G.nodes) {
+				AssertThat(GA4.x(v), Equals(GA1.x(v)));
+				AssertThat(GA4.y(v), Equals(GA1.y(v)));
+			}
+		});
+
+		it("keeps the edge lengths when optimizing the child order", []() {
+			Graph G;
+			randomTreeFast(G, 5000);
+			GraphAttributes GA(G), GAOpt(G);
+			BalloonLayout L;
+			L.call(GA);
+			L.setChildOrder(BalloonLayout::ChildOrder::Optimized);
+			L.call(GAOpt);
+
+			auto length = [](const GraphAttributes &A, edge e) {
+				return DPoint(A.x(e->source()), A.y(e->source())).distance(DPoint(A.x(e->target()), A.y(e->target())));
+			};
+			for (edge e : G.edges) {
+				double l = length(GA, e);
+				AssertThat(length(GAOpt, e), IsGreaterThan(l*(1 - 1e-9)) && IsLessThan(l*(1 + 1e-9)));
+			}
+		});
+	});
+});
@@ -0,0 +1,105 @@
+/** \file
+ * \brief Tests for CircularLayout
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <bandit/bandit.h>
+
+#include <ogdf/misclayout/CircularLayout.h>
+
+#include "layout_helpers.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+//! Returns the distance of \p v to the center of all nodes.
+static double distanceToCenter(const GraphAttributes &GA, node v)
+{
+	DPoint center;
+	for (node w : GA.constGraph().nodes) {
+		center.m_x += GA.x(w);
+		center.m_y += GA.y(w);
+	}
+	center.m_x /= GA.constGraph().numberOfNodes();
+	center.m_y /= GA.constGraph().numberOfNodes();
+	return center.distance(DPoint(GA.x(v), GA.y(v)));
+}
+
+go_bandit([]() {
+	describe("CircularLayout", []() {
+		CircularLayout circular;
+		describeLayoutModule("CircularLayout", circular);
+
+		it("places a biconnected graph on a single circle", []() {
+			Graph G;
+			planarBiconnectedGraph(G, 100, 180);
+			GraphAttributes GA(G);
+			CircularLayout L;
+			L.call(GA);
+
+			double radius = distanceToCenter(GA, G.firstNode());
+			for (node v : G.nodes) {
+				AssertThat(distanceToCenter(GA, v), IsGreaterThan(radius - 1e-6) && IsLessThan(radius + 1e-6));
+			}
+		});
+
+		it("handles a long cycle", []() {
+			Graph G;
+			customGraph(G, 300000, {});
+			node last = G.lastNode();
+			for (node v : G.nodes) {
+				G.newEdge(last, v);
+				last = v;
+			}
+			GraphAttributes GA(G);
+			CircularLayout L;
+			L.call(GA);
+			AssertThat(std::isfinite(GA.x(G.firstNode())), IsTrue());
+		});
+
+		it("handles a long path", []() {
+			Graph G;
+			customGraph(G, 300000, {});
+			for (node v = G.firstNode(); v->succ(); v = v->succ()) {
+				G.newEdge(v, v->succ());
+			}
+			GraphAttributes GA(G);
+			CircularLayout L;
+			L.call(GA);
+			AssertThat(std::isfinite(GA.x(G.lastNode())), IsTrue());
+		});
+
+		it("handles a cluster with two nodes of high degree", []() {
+			Graph G;
+			completeBipartiteGraph(G, 2, 20000);
+			GraphAttributes GA(G);
+			CircularLayout L;
+			L.call(GA);
+			AssertThat(std::isfinite(GA.x(G.firstNode())), IsTrue());
+		});
+	});
+});
@@ -32,14 +32,66 @@
 #include <bandit/bandit.h>
 
 #include <ogdf/energybased/FMMMLayout.h>
+#include <ogdf/basic/graph_generators.h>
 #include <ogdf/energybased/SpringEmbedderGridVariant.h>
 #include <ogdf/energybased/GEMLayout.h>
 #include <ogdf/energybased/DavidsonHarelLayout.h>
+#include <ogdf/energybased/davidson_harel/Planarity.h>
+#include <ogdf/energybased/davidson_harel/PlanarityGrid.h>
+#include <ogdf/energybased/davidson_harel/Repulsion.h>
 #include <ogdf/energybased/PivotMDS.h>
+#include <ogdf/energybased/StressMinimization.h>
+#include <ogdf/energybased/SpringEmbedderKK.h>
+#include <ogdf/energybased/FastMultipoleRelayoutSession.h>
+#include <ogdf/energybased/fast_multipole_embedder/LinearQuadtree.h>
+#include <ogdf/energybased/fast_multipole_embedder/LinearQuadtreeBuilder.h>
 
 #include "layout_helpers.h"
 
 using namespace ogdf;
+using namespace ogdf::fast_multipole_embedder;
+
+//! fills the points of \p tree with random morton numbers and returns them sorted
+static std::vector<LinearQuadtree::LQPoint> randomPoints(LinearQuadtree &tree, uint32_t maxCoordinate)
+{
+	std::vector<LinearQuadtree::LQPoint> points(tree.numberOfPoints());
+	for (uint32_t i = 0; i < tree.numberOfPoints(); i++) {
+		points[i].mortonNr = (MortonNR(randomNumber(0, maxCoordinate)) << 24) | randomNumber(0, maxCoordinate);
+		points[i].node = 0;
+		points[i].ref = i;
+		tree.pointArray()[i] = points[i];
+	}
+	std::stable_sort(points.begin(), points.end(), LQPointComparer);
+	return points;
+}
+
+//! returns the graph distances from \p s to all nodes
+static NodeArray<int> distancesFrom(const Graph &G, node s)
+{
+	NodeArray<int> dist(G, -1);
+	List<node> queue;
+	dist[s] = 0;
+	queue.pushBack(s);
+	while (!queue.empty()) {
+		node v = queue.popFrontRet();
+		for (adjEntry adj : v->adjEntries) {
+			node w = adj->twinNode();
+			if (dist[w] < 0) {
+				dist[w] = dist[v] + 1;
+				queue.pushBack(w);
+			}
+		}
+	}
+	return dist;
+}
+
+static void assertSortedAs(LinearQuadtree &tree, const std::vector<LinearQuadtree::LQPoint> &expected)
+{
+	for (uint32_t i = 0; i < tree.numberOfPoints(); i++) {
+		AssertThat(tree.pointArray()[i].mortonNr, Equals(expected[i].mortonNr));
+		AssertThat(tree.pointArray()[i].ref, Equals(expected[i].ref));
+	}
+}
 
 go_bandit([](){ bandit::describe("Energy-based layouts", [](){
 	FMMMLayout                fmmm, fmmmNice, fmmmHQ;
@@ -47,11 +99,13 @@ go_bandit([](){ bandit::describe("Energy-based layouts", [](){
 	GEMLayout                 gem;
 	DavidsonHarelLayout       dhl;
 	PivotMDS                  pmds;
+	SpringEmbedderKK          kk, kkSingle;
 
 	fmmmHQ.qualityVersusSpeed(FMMMOptions::QualityVsSpeed::GorgeousAndEfficient);
 	fmmmHQ.useHighLevelOptions(true);
 	fmmmNice.qualityVersusSpeed(FMMMOptions::QualityVsSpeed::NiceAndIncredibleSpeed);
 	frlHQ.iterations(1000);
+	kkSingle.setSinglePrecisionMatrices(true);
 
 	// call              name                                                                         module    extraAttributes req        maxNodes isGridLayout skip
 	describeLayoutModule("Fast Multipole Multilevel Embedder"                                       , fmmm);
@@ -62,4 +116,344 @@ go_bandit([](){ bandit::describe("Energy-based layouts", [](){
 	describeLayoutModule("GEM layout"                                                               , gem);
 	describeLayoutModule("Davidson-Harel layout"                                                    , dhl);
 	describeLayoutModule("PivotMDS layout"                                                          , pmds    , 0              , {GraphRequirement::connected});
+	describeLayoutModule("Kamada-Kawai layout"                                                      , kk      , 0              , {GraphRequirement::connected});
+	describeLayoutModule("Kamada-Kawai layout with single precision matrices"                       , kkSingle, 0              , {GraphRequirement::connected});
+
+	bandit::describe("Fast Multipole Multilevel Embedder with multiple threads", [](){
+		for (auto method : {FMMMOptions::RepulsiveForcesMethod::NMM, FMMMOptions::RepulsiveForcesMethod::GridApproximation}) {
+			string name = method == FMMMOptions::RepulsiveForcesMethod::NMM ? "multipoles" : "a grid";
+			bandit::it("lays out a large graph approximating repulsive forces by " + name, [method](){
+				Graph G;
+				randomSimpleGraph(G, 10000, 20000);
+				GraphAttributes GA(G);
+				FMMMLayout L;
+				L.repulsiveForcesCalculation(method);
+				L.maxThreads(4);
+				L.call(GA);
+
+				DRect box = GA.boundingBox();
+				AssertThat(std::isfinite(box.width()) && std::isfinite(box.height()), IsTrue());
+				AssertThat(box.width(), IsGreaterThan(0.0));
+				AssertThat(box.height(), IsGreaterThan(0.0));
+			});
+		}
+	});
+
+	bandit::describe("PivotMDS with multiple threads", [](){
+		bandit::it("yields the same layout as with a single thread", [](){
+			Graph G;
+			randomSimpleGraph(G, 20000, 40000);
+			makeConnected(G);
+			GraphAttributes sequential(G), concurrent(G);
+			PivotMDS L;
+			L.setNumberOfPivots(50);
+			L.call(sequential);
+			L.maxThreads(4);
+			L.call(concurrent);
+
+			for (node v : G.nodes) {
+				AssertThat(concurrent.x(v), Equals(sequential.x(v)));
+				AssertThat(concurrent.y(v), Equals(sequential.y(v)));
+			}
+		});
+
+		bandit::it("computes a 3D layout of a tetrahedron", [](){
+			Graph G;
+			completeGraph(G, 4);
+			GraphAttributes GA(G, GraphAttributes::nodeGraphics | GraphAttributes::threeD);
+			PivotMDS L;
+			L.maxThreads(4);
+			L.call(GA);
+
+			for (node v : G.nodes) {
+				for (node w : G.nodes) {
+					if (v != w) {
+						double dist = std::sqrt((GA.x(v) - GA.x(w)) * (GA.x(v) - GA.x(w))
+						                      + (GA.y(v) - GA.y(w)) * (GA.y(v) - GA.y(w))
+						                      + (GA.z(v) - GA.z(w)) * (GA.z(v) - GA.z(w)));
+						AssertThat(dist, IsGreaterThan(1.0));
+					}
+				}
+			}
+		});
+	});
+
+	bandit::describe("Stress minimization", [](){
+		bandit::it("yields the same layout with multiple threads", [](){
+			Graph G;
+			randomSimpleGraph(G, 500, 1000);
+			GraphAttributes sequential(G), concurrent(G);
+			StressMinimization L;
+			L.call(sequential);
+			L.maxThreads(4);
+			L.call(concurrent);
+
+			for (node v : G.nodes) {
+				AssertThat(concurrent.x(v), Equals(sequential.x(v)));
+				AssertThat(concurrent.y(v), Equals(sequential.y(v)));
+			}
+		});
+
+		for (auto criterion : {StressMinimization::TerminationCriterion::PositionDifference, StressMinimization::TerminationCriterion::Stress}) {
+			string name = criterion == StressMinimization::TerminationCriterion::Stress ? "stress" : "position difference";
+			bandit::it("converges by " + name, [criterion](){
+				Graph G;
+				randomSimpleGraph(G, 200, 400);
+				makeConnected(G);
+				GraphAttributes GA(G, GraphAttributes::nodeGraphics | GraphAttributes::threeD);
+				StressMinimization L;
+				L.convergenceCriterion(criterion);
+				L.setIterations(1000);
+				L.maxThreads(2);
+				L.call(GA);
+
+				DRect box = GA.boundingBox();
+				AssertThat(std::isfinite(box.width()) && std::isfinite(box.height()), IsTrue());
+				AssertThat(box.width(), IsGreaterThan(0.0));
+				AssertThat(box.height(), IsGreaterThan(0.0));
+			});
+		}
+	});
+
+	bandit::describe("Kamada-Kawai layout with edge lengths", [](){
+		for (bool singlePrecision : {false, true}) {
+			bandit::it("stretches a path according to its edge lengths" + string(singlePrecision ? " using single precision" : ""), [singlePrecision](){
+				Graph G;
+				node u = G.newNode(), v = G.newNode(), w = G.newNode();
+				edge e = G.newEdge(u, v), f = G.newEdge(v, w);
+				GraphAttributes GA(G);
+				GA.x(u) = 0; GA.y(u) = 0;
+				GA.x(v) = 10; GA.y(v) = 20;
+				GA.x(w) = 30; GA.y(w) = 0;
+				EdgeArray<double> length(G);
+				length[e] = 1;
+				length[f] = 3;
+				SpringEmbedderKK L;
+				L.setSinglePrecisionMatrices(singlePrecision);
+				L.call(GA, length);
+
+				auto dist = [&](node s, node t) {
+					return std::hypot(GA.x(s) - GA.x(t), GA.y(s) - GA.y(t));
+				};
+				// the lengths are adapted to the node sizes by (1 + length)
+				AssertThat(dist(v, w) / dist(u, v), IsGreaterThan(1.9) && IsLessThan(2.1));
+				AssertThat(dist(u, w), IsGreaterThan(0.99 * (dist(u, v) + dist(v, w))));
+			});
+		}
+	});
+
+	bandit::describe("Davidson-Harel energy functions", [](){
+		bandit::it("count the same crossings with and without a grid while moving nodes", [](){
+			Graph G;
+			randomSimpleGraph(G, 60, 150);
+			GraphAttributes GA(G);
+			for (node v : G.nodes) {
+				GA.x(v) = randomDouble(0, 1000);
+				GA.y(v) = randomDouble(0, 1000);
+			}
+			davidson_harel::Planarity plan(GA);
+			davidson_harel::PlanarityGrid grid(GA);
+			davidson_harel::Repulsion rep(GA);
+			plan.computeEnergy();
+			grid.computeEnergy();
+			rep.computeEnergy();
+			AssertThat(grid.energy(), Equals(plan.energy()));
+
+			for (int i = 0; i < 500; ++i) {
+				node v = G.chooseNode();
+				DPoint p(GA.x(v) + randomDouble(-100, 100), GA.y(v) + randomDouble(-100, 100));
+				double expected = plan.computeCandidateEnergy(v, p);
+				AssertThat(plan.candidateEnergy(v, p), Equals(expected));
+				AssertThat(grid.candidateEnergy(v, p), Equals(expected));
+				AssertThat(grid.computeCandidateEnergy(v, p), Equals(expected));
+				AssertThat(rep.candidateEnergy(v, p), Equals(rep.computeCandidateEnergy(v, p)));
+				if (randomNumber(0, 1) == 1) {
+					plan.candidateTaken();
+					grid.candidateTaken();
+					rep.candidateTaken();
+				}
+			}
+
+			davidson_harel::Planarity fresh(GA);
+			fresh.computeEnergy();
+			AssertThat(plan.energy(), Equals(fresh.energy()));
+			AssertThat(grid.energy(), Equals(fresh.energy()));
+		});
+
+		bandit::it("lay out a graph evaluating candidates with multiple threads", [](){
+			Graph G;
+			randomSimpleGraph(G, 600, 1200);
+			GraphAttributes GA(G);
+			for (node v : G.nodes) {
+				GA.x(v) = randomDouble(0, 1000);
+				GA.y(v) = randomDouble(0, 1000);
+			}
+			DavidsonHarelLayout L;
+			L.setSpeed(DavidsonHarelLayout::SpeedParameter::Fast);
+			L.maxThreads(4);
+			L.call(GA);
+
+			DRect box = GA.boundingBox();
+			AssertThat(std::isfinite(box.width()) && std::isfinite(box.height()), IsTrue());
+			AssertThat(box.width(), IsGreaterThan(0.0));
+			AssertThat(box.height(), IsGreaterThan(0.0));
+		});
+	});
+
+	bandit::describe("Linear quadtree of the fast multipole embedder", [](){
+		const uint32_t n = 5000;
+		std::vector<float> x(n), y(n), size(n);
+		LinearQuadtree tree(n, x.data(), y.data(), size.data());
+
+		bandit::it("sorts random points", [&](){
+			std::vector<LinearQuadtree::LQPoint> expected = randomPoints(tree, (1 << 24) - 1);
+			AssertThat(tree.sortPoints(), IsTrue());
+			assertSortedAs(tree, expected);
+		});
+
+		bandit::it("sorts points with many equal morton numbers", [&](){
+			std::vector<LinearQuadtree::LQPoint> expected = randomPoints(tree, 3);
+			AssertThat(tree.sortPoints(), IsTrue());
+			assertSortedAs(tree, expected);
+		});
+
+		bandit::it("sorts nearly sorted points", [&](){
+			std::vector<LinearQuadtree::LQPoint> expected = randomPoints(tree, (1 << 24) - 1);
+			std::copy(expected.begin(), expected.end(), tree.pointArray());
+			for (int i = 0; i < 20; i++) {
+				std::swap(tree.pointArray()[randomNumber(0, n-1)], tree.pointArray()[randomNumber(0, n-1)]);
+			}
+			tree.sortPoints();
+			assertSortedAs(tree, expected);
+		});
+
+		bandit::it("keeps sorted points", [&](){
+			std::vector<LinearQuadtree::LQPoint> expected = randomPoints(tree, (1 << 24) - 1);
+			std::copy(expected.begin(), expected.end(), tree.pointArray());
+			AssertThat(tree.sortPoints(), IsFalse());
+			assertSortedAs(tree, expected);
+		});
+
+		bandit::it("reuses the tree only if the cells are unchanged", [&](){
+			randomPoints(tree, 1000);
+			tree.sortPoints();
+			LinearQuadtree::LQPoint* points = tree.pointArray();
+			points[n-1].mortonNr = points[n-2].mortonNr + 1;
+			AssertThat(tree.canReuseTree(true), IsFalse());
+			LinearQuadtreeBuilder builder(tree);
+			builder.prepareTree();
+			builder.build();
+			uint32_t numLeaves = tree.numberOfLeaves();
+
+			AssertThat(tree.canReuseTree(false), IsTrue());
+			AssertThat(tree.canReuseTree(true), IsFalse());
+			AssertThat(tree.canReuseTree(false), IsFalse());
+
+			builder.prepareTree();
+			builder.build();
+			AssertThat(tree.numberOfLeaves(), Equals(numLeaves));
+			// moving the last point into the cell of its predecessor changes the tree
+			points[n-1].mortonNr = points[n-2].mortonNr;
+			AssertThat(tree.canReuseTree(false), IsFalse());
+		});
+	});
+
+	bandit::describe("Fast multipole relayout session", [](){
+		for (int n : {10, 20}) {
+			bandit::describe("on a " + to_string(n) + "x" + to_string(n) + " grid", [n](){
+				Graph G;
+				GraphAttributes GA(G);
+				node center = nullptr;
+
+				bandit::before_each([&](){
+					gridGraph(G, n, n, false, false);
+					GA.init(G, GraphAttributes::nodeGraphics | GraphAttributes::edgeGraphics);
+					for (node v : G.nodes) {
+						GA.x(v) = randomDouble(0, 1000);
+						GA.y(v) = randomDouble(0, 1000);
+					}
+					center = G.chooseNode();
+				});
+
+				bandit::it("keeps pinned nodes in place", [&](){
+					FastMultipoleRelayoutSession session(GA);
+					session.globalPassInterval(2);
+					NodeArray<double> x(G), y(G);
+					for (node v : G.nodes) {
+						if (v->index() % 3 == 0) {
+							session.pin(v);
+						}
+						x[v] = GA.x(v);
+						y[v] = GA.y(v);
+					}
+					session.layout();
+					for (int i = 0; i < 2; i++) {
+						session.nodeChanged(center);
+						session.update();
+					}
+					AssertThat(session.lastUpdateWasGlobal(), IsTrue());
+					for (node v : G.nodes) {
+						if (session.isPinned(v)) {
+							AssertThat(GA.x(v), Equals(x[v]));
+							AssertThat(GA.y(v), Equals(y[v]));
+						} else {
+							AssertThat(GA.x(v), !Equals(x[v]));
+						}
+					}
+				});
+
+				bandit::it("moves only the neighborhood of changed nodes", [&](){
+					FastMultipoleRelayoutSession session(GA);
+					session.globalPassInterval(0);
+					session.neighborhoodRadius(2);
+					session.layout();
+					NodeArray<double> x(G), y(G);
+					for (node v : G.nodes) {
+						x[v] = GA.x(v);
+						y[v] = GA.y(v);
+					}
+
+					GA.x(center) += 100;
+					session.nodeChanged(center);
+					session.update();
+					AssertThat(session.lastUpdateWasGlobal(), IsFalse());
+
+					NodeArray<int> dist = distancesFrom(G, center);
+					bool neighborMoved = false;
+					for (node v : G.nodes) {
+						AssertThat(std::isfinite(GA.x(v)) && std::isfinite(GA.y(v)), IsTrue());
+						if (dist[v] > 2) {
+							AssertThat(GA.x(v), Equals(x[v]));
+							AssertThat(GA.y(v), Equals(y[v]));
+						} else if (dist[v] > 0) {
+							neighborMoved |= GA.x(v) != x[v] || GA.y(v) != y[v];
+						}
+					}
+					AssertThat(neighborMoved, IsTrue());
+				});
+
+				bandit::it("places added nodes next to their neighbors", [&](){
+					FastMultipoleRelayoutSession session(GA);
+					session.globalPassInterval(0);
+					session.layout();
+					for (node v : G.nodes) {
+						GA.x(v) += 5000;
+					}
+
+					node w = G.newNode();
+					GA.width(w) = GA.height(w) = 20;
+					G.newEdge(center, w);
+					G.delEdge(center->firstAdj()->theEdge());
+					session.update();
+
+					double dx = GA.x(w) - GA.x(center);
+					double dy = GA.y(w) - GA.y(center);
+					DRect box = GA.boundingBox();
+					AssertThat(std::isfinite(dx) && std::isfinite(dy), IsTrue());
+					AssertThat(dx*dx + dy*dy, IsLessThan(box.width()*box.width() + box.height()*box.height()));
+					AssertThat(GA.x(w), IsGreaterThan(1000.0));
+				});
+			});
+		}
+	});
 }); });
@@ -270,6 +270,22 @@ inline void describeLayoutModule(
 				});
 			}
 		}
+
+		if(!isGridLayout) {
+			bandit::it("estimates its cost", [&](){
+				Graph G, H;
+				randomSimpleGraph(G, MIN_NODES, 2*MIN_NODES);
+				randomSimpleGraph(H, 4*MIN_NODES, 8*MIN_NODES);
+				GraphAttributes GA(G), HA(H);
+
+				LayoutCostEstimate small = L.estimateCost(GA);
+				LayoutCostEstimate large = L.estimateCost(HA);
+				AssertThat(small.peakMemory, IsGreaterThan(0.0));
+				AssertThat(small.operations, IsGreaterThan(0.0));
+				AssertThat(large.peakMemory, IsGreaterThan(small.peakMemory));
+				AssertThat(large.operations, IsGreaterThan(small.operations));
+			});
+		}
 	};
 
 	if(skipMe) {
@@ -0,0 +1,116 @@
+/** \file
+ * \brief Tests for the hierarchies exported by multilevel layouts
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <bandit/bandit.h>
+
+#include <ogdf/basic/graph_generators.h>
+#include <ogdf/energybased/FMMMLayout.h>
+#include <ogdf/energybased/FastMultipoleEmbedder.h>
+#include <ogdf/energybased/multilevel_mixer/ModularMultilevelMixer.h>
+
+using namespace ogdf;
+using namespace bandit;
+
+static void assertValidHierarchy(const LayoutHierarchy &H, const Graph &G)
+{
+	AssertThat(H.numberOfLevels(), IsGreaterThan(0));
+	AssertThat(H.level(0).numberOfNodes(), Equals(G.numberOfNodes()));
+
+	for (int i = 0; i < H.numberOfLevels(); ++i) {
+		const LayoutHierarchy::Level &L = H.level(i);
+		int mass = 0;
+		for (int v = 0; v < L.numberOfNodes(); ++v) {
+			mass += L.mass[v];
+			if (i + 1 < H.numberOfLevels()) {
+				AssertThat(L.parent[v], IsGreaterThanOrEqualTo(0));
+				AssertThat(L.parent[v], IsLessThan(H.level(i + 1).numberOfNodes()));
+			} else {
+				AssertThat(L.parent[v], Equals(-1));
+			}
+		}
+		AssertThat(mass, Equals(G.numberOfNodes()));
+
+		for (int e = 0; e < L.numberOfEdges(); ++e) {
+			AssertThat(L.source[e], IsLessThan(L.target[e]));
+			AssertThat(L.weight[e], IsGreaterThan(0.0));
+		}
+		if (i > 0) {
+			AssertThat(L.numberOfNodes(), IsLessThanOrEqualTo(H.level(i - 1).numberOfNodes()));
+		}
+	}
+}
+
+template<typename Layout>
+static void describeHierarchy(const char *name, std::function<void(Layout&, bool)> retain)
+{
+	describe(name, [&]() {
+		it("does not keep the hierarchy by default", []() {
+			Graph G;
+			randomSimpleGraph(G, 200, 400);
+			GraphAttributes GA(G);
+			Layout L;
+			L.call(GA);
+			AssertThat(L.hierarchy().empty(), IsTrue());
+		});
+
+		it("exports a hierarchy covering all nodes", [&]() {
+			Graph G;
+			randomSimpleGraph(G, 500, 1000);
+			GraphAttributes GA(G);
+			Layout L;
+			retain(L, true);
+			L.call(GA);
+
+			const LayoutHierarchy &H = L.hierarchy();
+			AssertThat(H.numberOfLevels(), IsGreaterThan(1));
+			assertValidHierarchy(H, G);
+		});
+
+		it("exports a hierarchy of a disconnected graph", [&]() {
+			Graph G;
+			randomSimpleGraph(G, 300, 200);
+			GraphAttributes GA(G);
+			Layout L;
+			retain(L, true);
+			L.call(GA);
+			assertValidHierarchy(L.hierarchy(), G);
+		});
+	});
+}
+
+go_bandit([]() {
+	describe("Multilevel hierarchies", []() {
+		describeHierarchy<FMMMLayout>("FMMMLayout",
+			[](FMMMLayout &L, bool b) { L.retainHierarchy(b); });
+		describeHierarchy<FastMultipoleMultilevelEmbedder>("FastMultipoleMultilevelEmbedder",
+			[](FastMultipoleMultilevelEmbedder &L, bool b) { L.retainHierarchy(b); });
+		describeHierarchy<ModularMultilevelMixer>("ModularMultilevelMixer",
+			[](ModularMultilevelMixer &L, bool b) { L.setRetainHierarchy(b); });
+	});
+});
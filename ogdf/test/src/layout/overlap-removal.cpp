@@ -0,0 +1,117 @@
+/** \file
+ * \brief Tests for OverlapRemovalLayout
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <bandit/bandit.h>
+
+#include <ogdf/misclayout/OverlapRemovalLayout.h>
+
+#include "layout_helpers.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+static void randomBoxes(GraphAttributes &GA, double extent)
+{
+	for (node v : GA.constGraph().nodes) {
+		GA.x(v) = randomDouble(0, extent);
+		GA.y(v) = randomDouble(0, extent);
+		GA.width(v) = randomDouble(10, 60);
+		GA.height(v) = randomDouble(10, 30);
+	}
+}
+
+go_bandit([]() {
+	describe("Overlap removal", []() {
+		OverlapRemovalLayout overlapRemoval;
+		describeLayoutModule("OverlapRemovalLayout", overlapRemoval);
+
+		it("removes all overlaps of a dense drawing", []() {
+			Graph G;
+			randomSimpleGraph(G, 300, 600);
+			GraphAttributes GA(G);
+			randomBoxes(GA, 200);
+
+			OverlapRemovalLayout L;
+			AssertThat(L.numberOfOverlaps(GA), IsGreaterThan(0));
+			L.call(GA);
+			AssertThat(L.numberOfOverlaps(GA), Equals(0));
+		});
+
+		it("separates nodes sharing their position", []() {
+			Graph G;
+			randomSimpleGraph(G, 20, 20);
+			GraphAttributes GA(G);
+			for (node v : G.nodes) {
+				GA.x(v) = GA.y(v) = 0.0;
+			}
+
+			OverlapRemovalLayout L;
+			L.call(GA);
+			AssertThat(L.numberOfOverlaps(GA), Equals(0));
+		});
+
+		it("does not move nodes of a drawing without overlaps", []() {
+			Graph G;
+			randomSimpleGraph(G, 50, 100);
+			GraphAttributes GA(G);
+			int i = 0;
+			for (node v : G.nodes) {
+				GA.x(v) = 100.0 * (i % 10);
+				GA.y(v) = 100.0 * (i++ / 10);
+			}
+			GraphAttributes original(GA);
+
+			OverlapRemovalLayout L;
+			L.call(GA);
+			for (node v : G.nodes) {
+				AssertThat(GA.x(v), Equals(original.x(v)));
+				AssertThat(GA.y(v), Equals(original.y(v)));
+			}
+		});
+
+		it("preserves the left-to-right order of separated nodes", []() {
+			Graph G;
+			node u = G.newNode(), v = G.newNode(), w = G.newNode();
+			GraphAttributes GA(G);
+			GA.x(u) = 0;
+			GA.x(v) = 5;
+			GA.x(w) = 10;
+			for (node x : G.nodes) {
+				GA.y(x) = 0;
+				GA.width(x) = GA.height(x) = 20;
+			}
+
+			OverlapRemovalLayout L;
+			L.call(GA);
+			AssertThat(L.numberOfOverlaps(GA), Equals(0));
+			AssertThat(GA.x(u), IsLessThan(GA.x(v)));
+			AssertThat(GA.x(v), IsLessThan(GA.x(w)));
+		});
+	});
+});
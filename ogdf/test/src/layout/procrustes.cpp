@@ -0,0 +1,200 @@
+/** \file
+ * \brief Tests for ProcrustesSubLayout
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <bandit/bandit.h>
+
+#include <ogdf/misclayout/ProcrustesSubLayout.h>
+
+#include "layout_helpers.h"
+
+using namespace ogdf;
+using namespace bandit;
+
+//! Moves the drawing by a fixed similarity transform and perturbs every node by up to #noise.
+class TransformLayout : public LayoutModule
+{
+public:
+	double angle = 0, scale = 1, dx = 0, dy = 0, noise = 0;
+	bool flip = false;
+
+	virtual void call(GraphAttributes &GA) override {
+		for (node v : GA.constGraph().nodes) {
+			double x = GA.x(v), y = flip ? -GA.y(v) : GA.y(v);
+			GA.x(v) = scale * (cos(angle) * x - sin(angle) * y) + dx + randomDouble(-noise, noise);
+			GA.y(v) = scale * (sin(angle) * x + cos(angle) * y) + dy + randomDouble(-noise, noise);
+		}
+	}
+};
+
+//! Aligns \p GA to \p initial as ProcrustesSubLayout did before the closed form.
+static void alignByPointSets(const GraphAttributes &initial, GraphAttributes &GA, bool scaleToInitialLayout)
+{
+	const Graph &G = GA.constGraph();
+	ProcrustesPointSet initialSet(G.numberOfNodes()), newSet(G.numberOfNodes()), flippedSet(G.numberOfNodes());
+	int i = 0;
+	for (node v : G.nodes) {
+		initialSet.set(i, initial.x(v), initial.y(v));
+		newSet.set(i, GA.x(v), GA.y(v));
+		flippedSet.set(i++, GA.x(v), GA.y(v));
+	}
+	initialSet.normalize();
+	newSet.normalize();
+	newSet.rotateTo(initialSet);
+	flippedSet.normalize(true);
+	flippedSet.rotateTo(initialSet);
+
+	const ProcrustesPointSet &best = initialSet.compare(flippedSet) < initialSet.compare(newSet) ? flippedSet : newSet;
+	double factor = scaleToInitialLayout ? initialSet.scale() : best.scale();
+	for (node v : G.nodes) {
+		double x = (GA.x(v) - best.originX()) / best.scale();
+		double y = (GA.y(v) - best.originY()) / best.scale();
+		if (best.isFlipped()) {
+			y = -y;
+		}
+		GA.x(v) = factor * (cos(best.angle()) * x - sin(best.angle()) * y) + initialSet.originX();
+		GA.y(v) = factor * (sin(best.angle()) * x + cos(best.angle()) * y) + initialSet.originY();
+	}
+}
+
+static void assertSameLayout(const GraphAttributes &GA, const GraphAttributes &expected, double tolerance)
+{
+	for (node v : GA.constGraph().nodes) {
+		AssertThat(GA.x(v), IsGreaterThan(expected.x(v) - tolerance) && IsLessThan(expected.x(v) + tolerance));
+		AssertThat(GA.y(v), IsGreaterThan(expected.y(v) - tolerance) && IsLessThan(expected.y(v) + tolerance));
+	}
+}
+
+go_bandit([]() {
+	describe("ProcrustesSubLayout", []() {
+		Graph G;
+		randomSimpleGraph(G, 200, 400);
+
+		for (bool flip : {false, true}) {
+			it(std::string("restores a ") + (flip ? "flipped, " : "") + "rotated, scaled and moved drawing", [&]() {
+				GraphAttributes GA(G);
+				getRandomLayout(GA);
+				GraphAttributes initial(GA);
+
+				TransformLayout transform;
+				transform.angle = 2.1;
+				transform.scale = 3.5;
+				transform.dx = 1e4;
+				transform.dy = -250;
+				transform.flip = flip;
+				ProcrustesSubLayout procrustes(&transform);
+				procrustes.call(GA);
+				assertSameLayout(GA, initial, 1e-6);
+			});
+		}
+
+		it("keeps the new scale if requested", [&]() {
+			GraphAttributes GA(G);
+			getRandomLayout(GA);
+			GraphAttributes expected(GA);
+
+			TransformLayout transform;
+			transform.angle = -0.7;
+			transform.scale = 0.25;
+			transform.dx = 80;
+			ProcrustesSubLayout procrustes(&transform);
+			procrustes.setScaleToInitialLayout(false);
+			procrustes.call(GA);
+
+			// the same drawing scaled around its center
+			double cx = 0, cy = 0;
+			for (node v : G.nodes) {
+				cx += expected.x(v);
+				cy += expected.y(v);
+			}
+			cx /= G.numberOfNodes();
+			cy /= G.numberOfNodes();
+			for (node v : G.nodes) {
+				expected.x(v) = cx + 0.25 * (expected.x(v) - cx);
+				expected.y(v) = cy + 0.25 * (expected.y(v) - cy);
+			}
+			assertSameLayout(GA, expected, 1e-6);
+		});
+
+		it("restores a transformed drawing from a few anchors", [&]() {
+			GraphAttributes GA(G);
+			getRandomLayout(GA);
+			GraphAttributes initial(GA);
+
+			TransformLayout transform;
+			transform.angle = 1;
+			transform.scale = 10;
+			transform.flip = true;
+			ProcrustesSubLayout procrustes(&transform);
+			procrustes.setNumberOfAnchors(7);
+			AssertThat(procrustes.numberOfAnchors(), Equals(7));
+			procrustes.call(GA);
+			assertSameLayout(GA, initial, 1e-6);
+		});
+
+		for (bool scaleToInitialLayout : {true, false}) {
+			it(std::string("aligns a perturbed drawing like the point sets") + (scaleToInitialLayout ? "" : " keeping the new scale"), [&]() {
+				GraphAttributes GA(G);
+				getRandomLayout(GA);
+				GraphAttributes initial(GA);
+
+				TransformLayout transform;
+				transform.angle = 4;
+				transform.scale = 2;
+				transform.dy = 500;
+				transform.noise = 5;
+				transform.flip = true;
+				ProcrustesSubLayout procrustes(&transform);
+				procrustes.setScaleToInitialLayout(scaleToInitialLayout);
+				setSeed(42);
+				procrustes.call(GA);
+
+				GraphAttributes expected(initial);
+				setSeed(42);
+				transform.call(expected);
+				alignByPointSets(initial, expected, scaleToInitialLayout);
+				assertSameLayout(GA, expected, 1e-6);
+			});
+		}
+
+		it("reuses its buffers for graphs of different size", [&]() {
+			TransformLayout transform;
+			transform.angle = 0.5;
+			ProcrustesSubLayout procrustes(&transform);
+			for (int n : {0, 1, 50, 10}) {
+				Graph H;
+				randomSimpleGraph(H, n, n / 2);
+				GraphAttributes GA(H);
+				getRandomLayout(GA);
+				GraphAttributes initial(GA);
+				procrustes.call(GA);
+				assertSameLayout(GA, initial, 1e-6);
+			}
+		});
+	});
+});
@@ -37,17 +37,84 @@
 #include <ogdf/layered/OptimalHierarchyLayout.h>
 #include <ogdf/layered/OptimalRanking.h>
 #include <ogdf/layered/GreedyCycleRemoval.h>
+#include <ogdf/layered/SCCGreedyCycleRemoval.h>
+#include <ogdf/layered/LongestPathRanking.h>
+#include <ogdf/basic/graph_generators.h>
 
 #include "layout_helpers.h"
 
 using namespace ogdf;
 
+static void describeCycleRemoval(unsigned int threads)
+{
+	bandit::it("computes a feedback arc set using " + to_string(threads) + " threads", [threads]() {
+		for (int n = 10; n <= 1000; n *= 10) {
+			Graph G;
+			randomDiGraph(G, n, 5.0/n);
+			edge loop = G.newEdge(G.firstNode(), G.firstNode());
+
+			SCCGreedyCycleRemoval cycleRemoval;
+			cycleRemoval.maxThreads(threads);
+			List<edge> arcSet;
+			cycleRemoval.call(G, arcSet);
+
+			EdgeArray<bool> inArcSet(G, false);
+			for (edge e : arcSet) {
+				AssertThat(inArcSet[e], IsFalse());
+				inArcSet[e] = true;
+			}
+			AssertThat(inArcSet[loop], IsTrue());
+
+			// arcs of the set lie in strong components
+			NodeArray<int> component(G);
+			strongComponents(G, component);
+			for (edge e : arcSet) {
+				AssertThat(component[e->source()], Equals(component[e->target()]));
+			}
+
+			for (edge e : arcSet) {
+				G.delEdge(e);
+			}
+			AssertThat(isAcyclic(G), IsTrue());
+		}
+	});
+}
+
+static void describeFastHierarchyLayout(unsigned int threads)
+{
+	bandit::it("computes the same layout using " + to_string(threads) + " threads", [threads]() {
+		Graph G;
+		randomHierarchy(G, 5000, 10000, false, false, true);
+		GraphAttributes GA(G), GAThreads(G);
+
+		SugiyamaLayout sugi;
+		sugi.runs(1);
+		sugi.setLayout(new FastHierarchyLayout);
+		sugi.call(GA);
+
+		FastHierarchyLayout *fhl = new FastHierarchyLayout;
+		fhl->maxThreads(threads);
+		sugi.setLayout(fhl);
+		sugi.call(GAThreads);
+
+		for (node v : G.nodes) {
+			AssertThat(GAThreads.x(v), Equals(GA.x(v)));
+			AssertThat(GAThreads.y(v), Equals(GA.y(v)));
+		}
+	});
+}
+
 go_bandit([](){ bandit::describe("Sugiyama layouts", [](){
-	SugiyamaLayout sugi, sugiOpt, sugiTrans, sugiRuns;
+	SugiyamaLayout sugi, sugiThreads, sugiOpt, sugiTrans, sugiRuns, sugiSCC;
 
 	sugi.setLayout(new FastHierarchyLayout);
 	describeLayoutModule("Sugiyama with fast hierarchy", sugi, 0, {}, 100);
 
+	FastHierarchyLayout *fhl = new FastHierarchyLayout;
+	fhl->maxThreads(4);
+	sugiThreads.setLayout(fhl);
+	describeLayoutModule("Sugiyama with multithreaded fast hierarchy", sugiThreads, 0, {}, 100);
+
 	std::string desc = "Sugiyama with optimal ranking, median";
 	sugiOpt.setLayout(new OptimalHierarchyLayout);
 	desc += " and optimal hierarchy";
@@ -63,4 +130,21 @@ go_bandit([](){ bandit::describe("Sugiyama layouts", [](){
 
 	sugiRuns.runs(40);
 	describeLayoutModule("Sugiyama with 40 runs", sugiRuns, 0, {}, 50);
+
+	LongestPathRanking *lpr = new LongestPathRanking;
+	lpr->setSubgraph(new SCCGreedyCycleRemoval);
+	sugiSCC.setRanking(lpr);
+	describeLayoutModule("Sugiyama with SCC-based greedy cycle removal", sugiSCC, 0, {}, 100);
+
+	bandit::describe("FastHierarchyLayout", []() {
+		for (unsigned int threads : {2, 4}) {
+			describeFastHierarchyLayout(threads);
+		}
+	});
+
+	bandit::describe("SCCGreedyCycleRemoval", []() {
+		for (unsigned int threads : {1, 4}) {
+			describeCycleRemoval(threads);
+		}
+	});
 }); });
@@ -347,6 +347,10 @@ void testSubgraphPlanarizer() {
 		testSPEdgeInserter(new FixedEmbeddingInserter, "FixedEmbedding");
 		testSPEdgeInserter(new MultiEdgeApproxInserter, "MultiEdgeApprox");
 		testSPEdgeInserter(new VariableEmbeddingInserter, "VariableEmbedding");
+
+		VariableEmbeddingInserter *concurrentInserter = new VariableEmbeddingInserter;
+		concurrentInserter->maxThreads(4);
+		testSPEdgeInserter(concurrentInserter, "VariableEmbedding with 4 threads");
 		testSPEdgeInserter(new VariableEmbeddingInserterDyn, "VariableEmbeddingDyn", true);
 	});
 }
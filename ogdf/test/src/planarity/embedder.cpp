@@ -141,6 +141,55 @@ void describeEmbedder<EmbedderOptimalFlexDraw>(const string &title) {
 	});
 }
 
+//! Glues \p numberOfBlocks random triconnected planar graphs at random cut vertices.
+void manyBlocksGraph(Graph &graph, int numberOfBlocks) {
+	graph.clear();
+	Array<node> nodes;
+	for(int i = 0; i < numberOfBlocks; i++) {
+		Graph block;
+		int n = randomNumber(4, 20);
+		planarTriconnectedGraph(block, n, randomNumber(int(1.5*n), 3*n-6));
+		NodeArray<node> copy(block);
+		node first = block.firstNode();
+		for(node v : block.nodes) {
+			copy[v] = (v == first && nodes.size() > 0) ? nodes[randomNumber(0, nodes.size()-1)] : graph.newNode();
+		}
+		for(edge e : block.edges) {
+			graph.newEdge(copy[e->source()], copy[e->target()]);
+		}
+		for(node v : block.nodes) {
+			nodes.grow(1, copy[v]);
+		}
+	}
+}
+
+template<typename EmbedderType>
+void describeConcurrentEmbedder(const string &title) {
+	it(title + " yields the same embedding using multiple threads", [&]() {
+		Graph graph;
+		manyBlocksGraph(graph, 200);
+
+		EmbedderType embedder;
+		embedder.maxThreads(4);
+		testEmbedder(embedder, graph, false);
+
+		GraphCopy sequential(graph), concurrent(graph);
+		adjEntry adjSequential, adjConcurrent;
+		embedder(concurrent, adjConcurrent);
+		embedder.maxThreads(1);
+		embedder(sequential, adjSequential);
+
+		AssertThat(adjConcurrent->index(), Equals(adjSequential->index()));
+		for(node v : graph.nodes) {
+			adjEntry adjS = sequential.copy(v)->firstAdj();
+			for(adjEntry adjC : concurrent.copy(v)->adjEntries) {
+				AssertThat(adjC->index(), Equals(adjS->index()));
+				adjS = adjS->succ();
+			}
+		}
+	});
+}
+
 go_bandit([]() {
 	describe("Embedders", []() {
 		describeEmbedder<EmbedderMaxFace>("EmbedderMaxFace");
@@ -153,5 +202,13 @@ go_bandit([]() {
 		describeEmbedder<EmbedderOptimalFlexDraw>("EmbedderOptimalFlexDraw");
 #endif
 		describeEmbedder<SimpleEmbedder>("SimpleEmbedder");
+
+		describe("on graphs with many blocks", []() {
+			describeConcurrentEmbedder<EmbedderMaxFace>("EmbedderMaxFace");
+			describeConcurrentEmbedder<EmbedderMaxFaceLayers>("EmbedderMaxFaceLayers");
+			describeConcurrentEmbedder<EmbedderMinDepth>("EmbedderMinDepth");
+			describeConcurrentEmbedder<EmbedderMinDepthMaxFace>("EmbedderMinDepthMaxFace");
+			describeConcurrentEmbedder<EmbedderMinDepthMaxFaceLayers>("EmbedderMinDepthMaxFaceLayers");
+		});
 	});
 });
@@ -39,6 +39,7 @@
 #include <ogdf/planarity/BoyerMyrvold.h>
 #include <ogdf/basic/extended_graph_alg.h>
 #include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/basic/STNumbering.h>
 #include <ogdf/planarity/NonPlanarCore.h>
 #include <ogdf/planarity/PlanarizationLayout.h>
 #include <ogdf/planarity/SubgraphPlanarizer.h>
@@ -520,6 +521,21 @@ go_bandit([](){
 		BoyerMyrvold bm;
 		describeModule("Boyer-Myrvold", bm);
 
+		it("tests st-numbered biconnected graphs like Boyer-Myrvold", [&](){
+			for(int i = 0; i < 200; i++){
+				Graph G;
+				int n = randomNumber(3, 200);
+				planarBiconnectedGraph(G, n, randomNumber(n, 3*n-6));
+				for(int k = randomNumber(0, 3); k > 0; k--){
+					node v = G.chooseNode();
+					G.newEdge(v, G.chooseNode([&](node w) { return w != v; }));
+				}
+				NodeArray<int> numbering(G, 0);
+				computeSTNumbering(G, numbering, nullptr, nullptr, true);
+				AssertThat(BoothLueker::isPlanarSTNumbered(G, numbering), Equals(isPlanar(G)));
+			}
+		});
+
 		it("transforms based on the right graph, when it's a GraphCopySimple", [&](){
 			Graph G;
 			randomRegularGraph(G, 10, 6);
@@ -4,8 +4,11 @@
 #include <ogdf/basic/Graph_d.h>
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/graph_generators.h>
+#include <ogdf/basic/SpatialIndex.h>
+#include <ogdf/basic/Tracer.h>
 #include <ogdf/cluster/ClusterGraph.h>
 #include <ogdf/cluster/ClusterGraphAttributes.h>
+#include <ogdf/module/LayoutModule.h>
 
 using namespace emscripten;
 
@@ -417,10 +420,107 @@ void defineGraphGenerators () {
   function("wheelGraph", &ogdf::wheelGraph);
 }
 
+std::string getChromeTrace () {
+  std::stringstream os;
+  ogdf::Tracer::writeChromeTrace(os);
+  return os.str();
+}
+
+void defineTracer () {
+  class_<ogdf::Tracer>("Tracer")
+    .class_function("enable", &ogdf::Tracer::enable)
+    .class_function("enabled", &ogdf::Tracer::enabled)
+    .class_function("clear", &ogdf::Tracer::clear)
+    .class_function("numberOfEvents", &ogdf::Tracer::numberOfEvents)
+    .class_function("getChromeTrace", &getChromeTrace)
+    ;
+}
+
+void defineLayoutModule () {
+  enum_<ogdf::LayoutCostEstimate::TimeClass>("TimeClass")
+    .value("Linear", ogdf::LayoutCostEstimate::TimeClass::Linear)
+    .value("Loglinear", ogdf::LayoutCostEstimate::TimeClass::Loglinear)
+    .value("Quadratic", ogdf::LayoutCostEstimate::TimeClass::Quadratic)
+    .value("Cubic", ogdf::LayoutCostEstimate::TimeClass::Cubic)
+    ;
+
+  value_object<ogdf::LayoutCostEstimate>("LayoutCostEstimate")
+    .field("peakMemory", &ogdf::LayoutCostEstimate::peakMemory)
+    .field("operations", &ogdf::LayoutCostEstimate::operations)
+    .field("timeClass", &ogdf::LayoutCostEstimate::timeClass)
+    ;
+
+  class_<ogdf::LayoutModule>("LayoutModule")
+    .function("call", &ogdf::LayoutModule::call)
+    .function("estimateCost", &ogdf::LayoutModule::estimateCost)
+    ;
+}
+
+val indexArray (const std::vector<int>& indices) {
+  return val(typed_memory_view(indices.size(), indices.data())).call<val>("slice");
+}
+
+val spatialIndexNodesInBox (const ogdf::SpatialIndex& index, double x1, double y1, double x2, double y2) {
+  ogdf::ArrayBuffer<ogdf::node> hits;
+  index.nodesInBox(ogdf::DRect(x1, y1, x2, y2), hits);
+  std::vector<int> indices;
+  for (ogdf::node v : hits) {
+    indices.push_back(v->index());
+  }
+  return indexArray(indices);
+}
+
+val spatialIndexEdgesInBox (const ogdf::SpatialIndex& index, double x1, double y1, double x2, double y2) {
+  ogdf::ArrayBuffer<ogdf::edge> hits;
+  index.edgesInBox(ogdf::DRect(x1, y1, x2, y2), hits);
+  std::vector<int> indices;
+  for (ogdf::edge e : hits) {
+    indices.push_back(e->index());
+  }
+  return indexArray(indices);
+}
+
+val spatialIndexNearestNodes (const ogdf::SpatialIndex& index, double x, double y, int k) {
+  ogdf::ArrayBuffer<ogdf::node> hits;
+  index.nearestNodes(ogdf::DPoint(x, y), k, hits);
+  std::vector<int> indices;
+  for (ogdf::node v : hits) {
+    indices.push_back(v->index());
+  }
+  return indexArray(indices);
+}
+
+int spatialIndexNodeAt (const ogdf::SpatialIndex& index, double x, double y) {
+  ogdf::node v = index.nodeAt(ogdf::DPoint(x, y));
+  return v ? v->index() : -1;
+}
+
+int spatialIndexEdgeAt (const ogdf::SpatialIndex& index, double x, double y, double tolerance) {
+  ogdf::edge e = index.edgeAt(ogdf::DPoint(x, y), tolerance);
+  return e ? e->index() : -1;
+}
+
+void defineSpatialIndex () {
+  class_<ogdf::SpatialIndex>("SpatialIndex")
+    .constructor<const ogdf::GraphAttributes&>()
+    .function("build", &ogdf::SpatialIndex::build)
+    .function("updateNode", &ogdf::SpatialIndex::updateNode, allow_raw_pointers())
+    .function("updateEdge", &ogdf::SpatialIndex::updateEdge, allow_raw_pointers())
+    .function("nodesInBox", &spatialIndexNodesInBox)
+    .function("edgesInBox", &spatialIndexEdgesInBox)
+    .function("nearestNodes", &spatialIndexNearestNodes)
+    .function("nodeAt", &spatialIndexNodeAt)
+    .function("edgeAt", &spatialIndexEdgeAt)
+    ;
+}
+
 void defineBasic () {
   defineGraph();
   defineGraphAttributes();
   defineGraphGenerators();
+  defineTracer();
+  defineLayoutModule();
+  defineSpatialIndex();
 
   function("setSeed", &ogdf::setSeed);
 }
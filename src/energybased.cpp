@@ -4,24 +4,102 @@
 #include <ogdf/energybased/FastMultipoleEmbedder.h>
 #include <ogdf/energybased/FMMMLayout.h>
 #include <ogdf/energybased/GEMLayout.h>
+#include <ogdf/energybased/LayoutHierarchy.h>
 #include <ogdf/energybased/MultilevelLayout.h>
+#include <ogdf/energybased/SpringEmbedderKK.h>
 #include <ogdf/energybased/TutteLayout.h>
 
 using namespace emscripten;
 
+// The typed arrays are views into the module memory. They are valid as long
+// as the hierarchy is alive and the memory does not grow.
+template <typename T> val typedArrayView (const std::vector<T>& values) {
+  return val(typed_memory_view(values.size(), values.data()));
+}
+
+int hierarchyNumberOfNodes (const ogdf::LayoutHierarchy& H, int i) {
+  return H.level(i).numberOfNodes();
+}
+
+int hierarchyNumberOfEdges (const ogdf::LayoutHierarchy& H, int i) {
+  return H.level(i).numberOfEdges();
+}
+
+val hierarchyParent (const ogdf::LayoutHierarchy& H, int i) {
+  return typedArrayView(H.level(i).parent);
+}
+
+val hierarchyMass (const ogdf::LayoutHierarchy& H, int i) {
+  return typedArrayView(H.level(i).mass);
+}
+
+val hierarchyX (const ogdf::LayoutHierarchy& H, int i) {
+  return typedArrayView(H.level(i).x);
+}
+
+val hierarchyY (const ogdf::LayoutHierarchy& H, int i) {
+  return typedArrayView(H.level(i).y);
+}
+
+val hierarchyWidth (const ogdf::LayoutHierarchy& H, int i) {
+  return typedArrayView(H.level(i).width);
+}
+
+val hierarchyHeight (const ogdf::LayoutHierarchy& H, int i) {
+  return typedArrayView(H.level(i).height);
+}
+
+val hierarchySource (const ogdf::LayoutHierarchy& H, int i) {
+  return typedArrayView(H.level(i).source);
+}
+
+val hierarchyTarget (const ogdf::LayoutHierarchy& H, int i) {
+  return typedArrayView(H.level(i).target);
+}
+
+val hierarchyWeight (const ogdf::LayoutHierarchy& H, int i) {
+  return typedArrayView(H.level(i).weight);
+}
+
+void defineLayoutHierarchy () {
+  class_<ogdf::LayoutHierarchy>("LayoutHierarchy")
+    .constructor()
+    .function("empty", &ogdf::LayoutHierarchy::empty)
+    .function("numberOfLevels", &ogdf::LayoutHierarchy::numberOfLevels)
+    .function("numberOfNodes", &hierarchyNumberOfNodes)
+    .function("numberOfEdges", &hierarchyNumberOfEdges)
+    .function("parent", &hierarchyParent)
+    .function("mass", &hierarchyMass)
+    .function("x", &hierarchyX)
+    .function("y", &hierarchyY)
+    .function("width", &hierarchyWidth)
+    .function("height", &hierarchyHeight)
+    .function("source", &hierarchySource)
+    .function("target", &hierarchyTarget)
+    .function("weight", &hierarchyWeight)
+    ;
+}
+
 void defineDavidsonHarelLayout () {
-  class_<ogdf::DavidsonHarelLayout>("DavidsonHarelLayout")
+  class_<ogdf::DavidsonHarelLayout, base<ogdf::LayoutModule>>("DavidsonHarelLayout")
     .constructor()
     .function("call", &ogdf::DavidsonHarelLayout::call)
+    .property("maxThreads",
+        select_overload<unsigned int()const>(&ogdf::DavidsonHarelLayout::maxThreads),
+        select_overload<void(unsigned int)>(&ogdf::DavidsonHarelLayout::maxThreads))
     ;
 }
 
 void defineFMMMLayout () {
-  class_<ogdf::FMMMLayout>("FMMMLayout")
+  class_<ogdf::FMMMLayout, base<ogdf::LayoutModule>>("FMMMLayout")
     .constructor()
     .function("call", select_overload<void(ogdf::GraphAttributes&)>(&ogdf::FMMMLayout::call))
     .function("callEdgeLength", select_overload<void(ogdf::GraphAttributes&, const ogdf::EdgeArray<double>&)>(&ogdf::FMMMLayout::call))
     .function("setSingleLevel", &ogdf::FMMMLayout::setSingleLevel)
+    .function("hierarchy", &ogdf::FMMMLayout::hierarchy)
+    .property("retainHierarchy",
+        select_overload<bool()const>(&ogdf::FMMMLayout::retainHierarchy),
+        select_overload<void(bool)>(&ogdf::FMMMLayout::retainHierarchy))
     .property("useHighLevelOptions",
         select_overload<bool()const>(&ogdf::FMMMLayout::useHighLevelOptions),
         select_overload<void(bool)>(&ogdf::FMMMLayout::useHighLevelOptions))
@@ -40,6 +118,9 @@ void defineFMMMLayout () {
     .property("randSeed",
         select_overload<int()const>(&ogdf::FMMMLayout::randSeed),
         select_overload<void(int)>(&ogdf::FMMMLayout::randSeed))
+    .property("maxThreads",
+        select_overload<unsigned int()const>(&ogdf::FMMMLayout::maxThreads),
+        select_overload<void(unsigned int)>(&ogdf::FMMMLayout::maxThreads))
     .property("edgeLengthMeasurement",
         select_overload<ogdf::FMMMOptions::EdgeLengthMeasurement()const>(&ogdf::FMMMLayout::edgeLengthMeasurement),
         select_overload<void(ogdf::FMMMOptions::EdgeLengthMeasurement)>(&ogdf::FMMMLayout::edgeLengthMeasurement))
@@ -94,7 +175,7 @@ void defineFMMMLayout () {
 }
 
 void defineGEMLayout () {
-  class_<ogdf::GEMLayout>("GEMLayout")
+  class_<ogdf::GEMLayout, base<ogdf::LayoutModule>>("GEMLayout")
     .constructor()
     .function("call", &ogdf::GEMLayout::call)
     .property("attractionFormula",
@@ -140,26 +221,43 @@ void defineGEMLayout () {
 }
 
 void defineMultilevelLayout () {
-  class_<ogdf::MultilevelLayout>("MultilevelLayout")
+  class_<ogdf::MultilevelLayout, base<ogdf::LayoutModule>>("MultilevelLayout")
     .constructor()
     .function("call", &ogdf::MultilevelLayout::call)
     ;
 }
 
+void defineSpringEmbedderKK () {
+  class_<ogdf::SpringEmbedderKK, base<ogdf::LayoutModule>>("SpringEmbedderKK")
+    .constructor()
+    .function("call", select_overload<void(ogdf::GraphAttributes&)>(&ogdf::SpringEmbedderKK::call))
+    .function("callEdgeLength", select_overload<void(ogdf::GraphAttributes&, const ogdf::EdgeArray<double>&)>(&ogdf::SpringEmbedderKK::call))
+    .function("setStopTolerance", &ogdf::SpringEmbedderKK::setStopTolerance)
+    .function("setDesLength", &ogdf::SpringEmbedderKK::setDesLength)
+    .function("setGlobalIterationFactor", &ogdf::SpringEmbedderKK::setGlobalIterationFactor)
+    .function("computeMaxIterations", &ogdf::SpringEmbedderKK::computeMaxIterations)
+    .property("useLayout", &ogdf::SpringEmbedderKK::useLayout, &ogdf::SpringEmbedderKK::setUseLayout)
+    .property("zeroLength", &ogdf::SpringEmbedderKK::zeroLength, &ogdf::SpringEmbedderKK::setZeroLength)
+    .property("maxGlobalIterations", &ogdf::SpringEmbedderKK::maxGlobalIterations, &ogdf::SpringEmbedderKK::setMaxGlobalIterations)
+    .property("maxLocalIterations", &ogdf::SpringEmbedderKK::maxLocalIterations, &ogdf::SpringEmbedderKK::setMaxLocalIterations)
+    .property("singlePrecisionMatrices", &ogdf::SpringEmbedderKK::singlePrecisionMatrices, &ogdf::SpringEmbedderKK::setSinglePrecisionMatrices)
+    ;
+}
+
 void defineTutteLayout () {
-  class_<ogdf::TutteLayout>("TutteLayout")
+  class_<ogdf::TutteLayout, base<ogdf::LayoutModule>>("TutteLayout")
     .constructor()
     .function("call", select_overload<void(ogdf::GraphAttributes&)>(&ogdf::TutteLayout::call))
     ;
 }
 
 void defineEnergybased () {
-  class_<ogdf::DTreeMultilevelEmbedder2D>("DTreeMultilevelEmbedder")
+  class_<ogdf::DTreeMultilevelEmbedder2D, base<ogdf::LayoutModule>>("DTreeMultilevelEmbedder")
     .constructor()
     .function("call", &ogdf::DTreeMultilevelEmbedder2D::call)
     ;
 
-  class_<ogdf::FastMultipoleEmbedder>("FastMultipoleEmbedder")
+  class_<ogdf::FastMultipoleEmbedder, base<ogdf::LayoutModule>>("FastMultipoleEmbedder")
     .constructor()
     .function("call", select_overload<void(ogdf::GraphAttributes&)>(&ogdf::FastMultipoleEmbedder::call))
     ;
@@ -173,5 +271,7 @@ void defineEnergybased () {
   defineFMMMLayout();
   defineGEMLayout();
   defineMultilevelLayout();
+  defineSpringEmbedderKK();
   defineTutteLayout();
+  defineLayoutHierarchy();
 }
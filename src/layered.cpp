@@ -1,10 +1,78 @@
 #include <emscripten/bind.h>
 #include <ogdf/layered/SugiyamaLayout.h>
+#include <ogdf/layered/LongestPathRanking.h>
+#include <ogdf/layered/OptimalRanking.h>
+#include <ogdf/layered/CoffmanGrahamRanking.h>
+#include <ogdf/layered/DfsAcyclicSubgraph.h>
+#include <ogdf/layered/GreedyCycleRemoval.h>
+#include <ogdf/layered/SCCGreedyCycleRemoval.h>
+#include <ogdf/layered/FastHierarchyLayout.h>
+#include <ogdf/layered/FastSimpleHierarchyLayout.h>
 
 using namespace emscripten;
 
 void defineLayered () {
-  class_<ogdf::SugiyamaLayout>("SugiyamaLayout")
+  class_<ogdf::AcyclicSubgraphModule>("AcyclicSubgraphModule")
+    .function("call", &ogdf::AcyclicSubgraphModule::call)
+    ;
+
+  class_<ogdf::DfsAcyclicSubgraph, base<ogdf::AcyclicSubgraphModule>>("DfsAcyclicSubgraph")
+    .constructor()
+    ;
+
+  class_<ogdf::GreedyCycleRemoval, base<ogdf::AcyclicSubgraphModule>>("GreedyCycleRemoval")
+    .constructor()
+    ;
+
+  class_<ogdf::SCCGreedyCycleRemoval, base<ogdf::AcyclicSubgraphModule>>("SCCGreedyCycleRemoval")
+    .constructor()
+    .property("maxThreads", select_overload<unsigned int() const>(&ogdf::SCCGreedyCycleRemoval::maxThreads), select_overload<void(unsigned int)>(&ogdf::SCCGreedyCycleRemoval::maxThreads))
+    ;
+
+  class_<ogdf::RankingModule>("RankingModule")
+    ;
+
+  class_<ogdf::LongestPathRanking, base<ogdf::RankingModule>>("LongestPathRanking")
+    .constructor()
+    .function("setSubgraph", &ogdf::LongestPathRanking::setSubgraph, allow_raw_pointers())
+    .property("separateDeg0Layer", select_overload<bool() const>(&ogdf::LongestPathRanking::separateDeg0Layer), select_overload<void(bool)>(&ogdf::LongestPathRanking::separateDeg0Layer))
+    .property("separateMultiEdges", select_overload<bool() const>(&ogdf::LongestPathRanking::separateMultiEdges), select_overload<void(bool)>(&ogdf::LongestPathRanking::separateMultiEdges))
+    .property("optimizeEdgeLength", select_overload<bool() const>(&ogdf::LongestPathRanking::optimizeEdgeLength), select_overload<void(bool)>(&ogdf::LongestPathRanking::optimizeEdgeLength))
+    ;
+
+  class_<ogdf::OptimalRanking, base<ogdf::RankingModule>>("OptimalRanking")
+    .constructor()
+    .function("setSubgraph", &ogdf::OptimalRanking::setSubgraph, allow_raw_pointers())
+    .property("separateMultiEdges", select_overload<bool() const>(&ogdf::OptimalRanking::separateMultiEdges), select_overload<void(bool)>(&ogdf::OptimalRanking::separateMultiEdges))
+    ;
+
+  class_<ogdf::CoffmanGrahamRanking, base<ogdf::RankingModule>>("CoffmanGrahamRanking")
+    .constructor()
+    .function("setSubgraph", &ogdf::CoffmanGrahamRanking::setSubgraph, allow_raw_pointers())
+    .property("width", select_overload<int() const>(&ogdf::CoffmanGrahamRanking::width), select_overload<void(int)>(&ogdf::CoffmanGrahamRanking::width))
+    ;
+
+  class_<ogdf::HierarchyLayoutModule>("HierarchyLayoutModule")
+    ;
+
+  class_<ogdf::FastHierarchyLayout, base<ogdf::HierarchyLayoutModule>>("FastHierarchyLayout")
+    .constructor()
+    .property("nodeDistance", select_overload<double() const>(&ogdf::FastHierarchyLayout::nodeDistance), select_overload<void(double)>(&ogdf::FastHierarchyLayout::nodeDistance))
+    .property("layerDistance", select_overload<double() const>(&ogdf::FastHierarchyLayout::layerDistance), select_overload<void(double)>(&ogdf::FastHierarchyLayout::layerDistance))
+    .property("fixedLayerDistance", select_overload<bool() const>(&ogdf::FastHierarchyLayout::fixedLayerDistance), select_overload<void(bool)>(&ogdf::FastHierarchyLayout::fixedLayerDistance))
+    .property("maxThreads", select_overload<unsigned int() const>(&ogdf::FastHierarchyLayout::maxThreads), select_overload<void(unsigned int)>(&ogdf::FastHierarchyLayout::maxThreads))
+    ;
+
+  class_<ogdf::FastSimpleHierarchyLayout, base<ogdf::HierarchyLayoutModule>>("FastSimpleHierarchyLayout")
+    .constructor()
+    .property("nodeDistance", select_overload<double() const>(&ogdf::FastSimpleHierarchyLayout::nodeDistance), select_overload<void(double)>(&ogdf::FastSimpleHierarchyLayout::nodeDistance))
+    .property("layerDistance", select_overload<double() const>(&ogdf::FastSimpleHierarchyLayout::layerDistance), select_overload<void(double)>(&ogdf::FastSimpleHierarchyLayout::layerDistance))
+    .property("downward", select_overload<bool() const>(&ogdf::FastSimpleHierarchyLayout::downward), select_overload<void(bool)>(&ogdf::FastSimpleHierarchyLayout::downward))
+    .property("leftToRight", select_overload<bool() const>(&ogdf::FastSimpleHierarchyLayout::leftToRight), select_overload<void(bool)>(&ogdf::FastSimpleHierarchyLayout::leftToRight))
+    .property("balanced", select_overload<bool() const>(&ogdf::FastSimpleHierarchyLayout::balanced), select_overload<void(bool)>(&ogdf::FastSimpleHierarchyLayout::balanced))
+    ;
+
+  class_<ogdf::SugiyamaLayout, base<ogdf::LayoutModule>>("SugiyamaLayout")
     .constructor()
     .function("call", select_overload<void(ogdf::GraphAttributes&)>(&ogdf::SugiyamaLayout::call))
     .function("callCluster", select_overload<void(ogdf::ClusterGraphAttributes&)>(&ogdf::SugiyamaLayout::call))
@@ -2,21 +2,32 @@
 #include <ogdf/misclayout/BalloonLayout.h>
 #include <ogdf/misclayout/BertaultLayout.h>
 #include <ogdf/misclayout/CircularLayout.h>
+#include <ogdf/misclayout/OverlapRemovalLayout.h>
+#include <ogdf/misclayout/ProcrustesSubLayout.h>
 
 using namespace emscripten;
 
 void defineMisclayout () {
-  class_<ogdf::BalloonLayout>("BalloonLayout")
+  class_<ogdf::BalloonLayout, base<ogdf::LayoutModule>>("BalloonLayout")
     .constructor()
+    .property("childOrder", &ogdf::BalloonLayout::getChildOrder, &ogdf::BalloonLayout::setChildOrder)
+    .property("maxThreads",
+        select_overload<unsigned int()const>(&ogdf::BalloonLayout::maxThreads),
+        select_overload<void(unsigned int)>(&ogdf::BalloonLayout::maxThreads))
     .function("call", &ogdf::BalloonLayout::call)
     ;
 
-  class_<ogdf::BertaultLayout>("BertaultLayout")
+  enum_<ogdf::BalloonLayout::ChildOrder>("BalloonLayoutChildOrder")
+    .value("Fixed", ogdf::BalloonLayout::ChildOrder::Fixed)
+    .value("Optimized", ogdf::BalloonLayout::ChildOrder::Optimized)
+    ;
+
+  class_<ogdf::BertaultLayout, base<ogdf::LayoutModule>>("BertaultLayout")
     .constructor()
     .function("call", &ogdf::BertaultLayout::call)
     ;
 
-  class_<ogdf::CircularLayout>("CircularLayout")
+  class_<ogdf::CircularLayout, base<ogdf::LayoutModule>>("CircularLayout")
     .constructor()
     .property("minDistCircle",
         select_overload<double(void)const>(&ogdf::CircularLayout::minDistCircle),
@@ -35,4 +46,30 @@ void defineMisclayout () {
         select_overload<void(double)>(&ogdf::CircularLayout::pageRatio))
     .function("call", &ogdf::CircularLayout::call)
     ;
+
+  class_<ogdf::OverlapRemovalLayout, base<ogdf::LayoutModule>>("OverlapRemovalLayout")
+    .constructor()
+    .property("separation",
+        select_overload<double(void)const>(&ogdf::OverlapRemovalLayout::separation),
+        select_overload<void(double)>(&ogdf::OverlapRemovalLayout::separation))
+    .property("maxIterations",
+        select_overload<int(void)const>(&ogdf::OverlapRemovalLayout::maxIterations),
+        select_overload<void(int)>(&ogdf::OverlapRemovalLayout::maxIterations))
+    .property("neighbours",
+        select_overload<int(void)const>(&ogdf::OverlapRemovalLayout::neighbours),
+        select_overload<void(int)>(&ogdf::OverlapRemovalLayout::neighbours))
+    .function("call", &ogdf::OverlapRemovalLayout::call)
+    .function("numberOfOverlaps", &ogdf::OverlapRemovalLayout::numberOfOverlaps)
+    ;
+
+  class_<ogdf::ProcrustesSubLayout, base<ogdf::LayoutModule>>("ProcrustesSubLayout")
+    .constructor<ogdf::LayoutModule*>(allow_raw_pointers())
+    .property("scaleToInitialLayout",
+        &ogdf::ProcrustesSubLayout::scaleToInitialLayout,
+        &ogdf::ProcrustesSubLayout::setScaleToInitialLayout)
+    .property("numberOfAnchors",
+        &ogdf::ProcrustesSubLayout::numberOfAnchors,
+        &ogdf::ProcrustesSubLayout::setNumberOfAnchors)
+    .function("call", &ogdf::ProcrustesSubLayout::call)
+    ;
 }
@@ -4,7 +4,7 @@
 using namespace emscripten;
 
 void definePacking () {
-  class_<ogdf::ComponentSplitterLayout>("ComponentSplitterLayout")
+  class_<ogdf::ComponentSplitterLayout, base<ogdf::LayoutModule>>("ComponentSplitterLayout")
     .constructor()
     .function("call", &ogdf::ComponentSplitterLayout::call)
     ;
@@ -1,11 +1,59 @@
 #include <emscripten/bind.h>
 #include <ogdf/planarity/PlanarizationLayout.h>
+#include <ogdf/planarity/SimpleEmbedder.h>
+#include <ogdf/planarity/EmbedderMaxFace.h>
+#include <ogdf/planarity/EmbedderMaxFaceLayers.h>
+#include <ogdf/planarity/EmbedderMinDepth.h>
+#include <ogdf/planarity/EmbedderMinDepthMaxFace.h>
+#include <ogdf/planarity/EmbedderMinDepthMaxFaceLayers.h>
+#include <ogdf/planarity/EmbedderMinDepthPiTa.h>
 
 using namespace emscripten;
 
 void definePlanarity () {
-  class_<ogdf::PlanarizationLayout>("PlanarizationLayout")
+  class_<ogdf::EmbedderModule>("EmbedderModule")
+    ;
+
+  class_<ogdf::SimpleEmbedder, base<ogdf::EmbedderModule>>("SimpleEmbedder")
+    .constructor()
+    ;
+
+  class_<ogdf::EmbedderMaxFace, base<ogdf::EmbedderModule>>("EmbedderMaxFace")
+    .constructor()
+    .property("maxThreads", select_overload<unsigned int() const>(&ogdf::EmbedderMaxFace::maxThreads), select_overload<void(unsigned int)>(&ogdf::EmbedderMaxFace::maxThreads))
+    ;
+
+  class_<ogdf::EmbedderMaxFaceLayers, base<ogdf::EmbedderModule>>("EmbedderMaxFaceLayers")
+    .constructor()
+    .property("maxThreads", select_overload<unsigned int() const>(&ogdf::EmbedderMaxFaceLayers::maxThreads), select_overload<void(unsigned int)>(&ogdf::EmbedderMaxFaceLayers::maxThreads))
+    ;
+
+  class_<ogdf::EmbedderMinDepth, base<ogdf::EmbedderModule>>("EmbedderMinDepth")
+    .constructor()
+    .property("maxThreads", select_overload<unsigned int() const>(&ogdf::EmbedderMinDepth::maxThreads), select_overload<void(unsigned int)>(&ogdf::EmbedderMinDepth::maxThreads))
+    ;
+
+  class_<ogdf::EmbedderMinDepthMaxFace, base<ogdf::EmbedderModule>>("EmbedderMinDepthMaxFace")
+    .constructor()
+    .property("maxThreads", select_overload<unsigned int() const>(&ogdf::EmbedderMinDepthMaxFace::maxThreads), select_overload<void(unsigned int)>(&ogdf::EmbedderMinDepthMaxFace::maxThreads))
+    ;
+
+  class_<ogdf::EmbedderMinDepthMaxFaceLayers, base<ogdf::EmbedderModule>>("EmbedderMinDepthMaxFaceLayers")
+    .constructor()
+    .property("maxThreads", select_overload<unsigned int() const>(&ogdf::EmbedderMinDepthMaxFaceLayers::maxThreads), select_overload<void(unsigned int)>(&ogdf::EmbedderMinDepthMaxFaceLayers::maxThreads))
+    ;
+
+  class_<ogdf::EmbedderMinDepthPiTa, base<ogdf::EmbedderModule>>("EmbedderMinDepthPiTa")
+    .constructor()
+    .property("useExtendedDepthDefinition", select_overload<bool() const>(&ogdf::EmbedderMinDepthPiTa::useExtendedDepthDefinition), select_overload<void(bool)>(&ogdf::EmbedderMinDepthPiTa::useExtendedDepthDefinition))
+    .property("maxThreads", select_overload<unsigned int() const>(&ogdf::EmbedderMinDepthPiTa::maxThreads), select_overload<void(unsigned int)>(&ogdf::EmbedderMinDepthPiTa::maxThreads))
+    ;
+
+  class_<ogdf::PlanarizationLayout, base<ogdf::LayoutModule>>("PlanarizationLayout")
     .constructor()
     .function("call", select_overload<void(ogdf::GraphAttributes&)>(&ogdf::PlanarizationLayout::call))
+    .function("setEmbedder", &ogdf::PlanarizationLayout::setEmbedder, allow_raw_pointers())
+    .function("numberOfCrossings", &ogdf::PlanarizationLayout::numberOfCrossings)
+    .property("pageRatio", select_overload<double() const>(&ogdf::PlanarizationLayout::pageRatio), select_overload<void(double)>(&ogdf::PlanarizationLayout::pageRatio))
     ;
 }
@@ -4,7 +4,7 @@
 using namespace emscripten;
 
 void defineTree () {
-  class_<ogdf::TreeLayout>("TreeLayout")
+  class_<ogdf::TreeLayout, base<ogdf::LayoutModule>>("TreeLayout")
     .constructor()
     .function("call", &ogdf::TreeLayout::call)
     ;
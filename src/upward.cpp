@@ -5,7 +5,7 @@
 using namespace emscripten;
 
 void defineUpward () {
-  class_<ogdf::DominanceLayout>("DominanceLayout")
+  class_<ogdf::DominanceLayout, base<ogdf::LayoutModule>>("DominanceLayout")
     .constructor()
     .function("call", &ogdf::DominanceLayout::call)
     ;
@@ -0,0 +1,33 @@
+/* eslint-env mocha */
+
+const assert = require('power-assert')
+const {run} = require('../util')
+
+run((ogdf) => {
+  const {
+    Graph,
+    GraphAttributes,
+    DavidsonHarelLayout,
+    FMMMLayout,
+    TimeClass,
+    randomSimpleGraph
+  } = ogdf
+
+  describe('LayoutModule', () => {
+    describe('estimateCost(GA)', () => {
+      it('predicts memory and time without running the layout', () => {
+        const graph = new Graph()
+        randomSimpleGraph(graph, 100, 200)
+        const attributes = new GraphAttributes(graph, GraphAttributes.nodeGraphics | GraphAttributes.edgeGraphics)
+
+        const fmmm = new FMMMLayout().estimateCost(attributes)
+        const dh = new DavidsonHarelLayout().estimateCost(attributes)
+        assert(fmmm.peakMemory > 0)
+        assert(fmmm.timeClass === TimeClass.Loglinear)
+        assert(dh.timeClass === TimeClass.Quadratic)
+        assert(dh.peakMemory > fmmm.peakMemory)
+        assert(dh.operations > fmmm.operations)
+      })
+    })
+  })
+})
@@ -0,0 +1,69 @@
+/* eslint-env mocha */
+
+const assert = require('power-assert')
+const {run} = require('../util')
+
+run((ogdf) => {
+  const {
+    Graph,
+    GraphAttributes,
+    SpatialIndex
+  } = ogdf
+
+  describe('SpatialIndex', () => {
+    const createGrid = () => {
+      const graph = new Graph()
+      const attributes = new GraphAttributes(graph, GraphAttributes.nodeGraphics | GraphAttributes.edgeGraphics)
+      const nodes = []
+      for (let i = 0; i < 10; ++i) {
+        const node = graph.newNode()
+        attributes.x(node, 100 * i)
+        attributes.y(node, 0)
+        attributes.width(node, 20)
+        attributes.height(node, 20)
+        nodes.push(node)
+      }
+      for (let i = 1; i < 10; ++i) {
+        graph.newEdge(nodes[i - 1], nodes[i])
+      }
+      return {graph, attributes, nodes}
+    }
+
+    describe('nodesInBox()', () => {
+      it('returns the indices of the nodes intersecting the box', () => {
+        const {attributes} = createGrid()
+        const index = new SpatialIndex(attributes)
+        const hits = Array.from(index.nodesInBox(150, -10, 350, 10)).sort()
+        assert.deepEqual(hits, [2, 3])
+      })
+    })
+
+    describe('nodeAt()', () => {
+      it('returns -1 when no node is hit', () => {
+        const {attributes} = createGrid()
+        const index = new SpatialIndex(attributes)
+        assert.equal(index.nodeAt(405, 5), 4)
+        assert.equal(index.nodeAt(450, 50), -1)
+      })
+    })
+
+    describe('edgeAt()', () => {
+      it('finds the edge under the cursor', () => {
+        const {attributes} = createGrid()
+        const index = new SpatialIndex(attributes)
+        assert.equal(index.edgeAt(250, 2, 5), 2)
+      })
+    })
+
+    describe('updateNode()', () => {
+      it('keeps the index in sync with moved nodes', () => {
+        const {attributes, nodes} = createGrid()
+        const index = new SpatialIndex(attributes)
+        attributes.y(nodes[0], 1000)
+        index.updateNode(nodes[0])
+        assert.equal(index.nodeAt(0, 1000), 0)
+        assert.deepEqual(Array.from(index.nearestNodes(0, 0, 1)), [1])
+      })
+    })
+  })
+})
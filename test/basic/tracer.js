@@ -0,0 +1,43 @@
+/* eslint-env mocha */
+
+const assert = require('power-assert')
+const {run} = require('../util')
+
+run((ogdf) => {
+  const {
+    Graph,
+    GraphAttributes,
+    FMMMLayout,
+    Tracer,
+    randomSimpleGraph
+  } = ogdf
+
+  describe('Tracer', () => {
+    afterEach(() => {
+      Tracer.enable(false)
+      Tracer.clear()
+    })
+
+    describe('getChromeTrace()', () => {
+      it('exports spans of a layout call', () => {
+        const graph = new Graph()
+        randomSimpleGraph(graph, 20, 40)
+        const attributes = new GraphAttributes(graph, GraphAttributes.nodeGraphics | GraphAttributes.edgeGraphics)
+
+        Tracer.enable(true)
+        const layout = new FMMMLayout()
+        layout.call(attributes)
+        assert(Tracer.numberOfEvents() > 0)
+
+        const trace = JSON.parse(Tracer.getChromeTrace())
+        assert(trace.traceEvents.some(({name}) => name === 'FMMMLayout::call'))
+      })
+    })
+
+    describe('enabled()', () => {
+      it('is false by default', () => {
+        assert.equal(Tracer.enabled(), false)
+      })
+    })
+  })
+})
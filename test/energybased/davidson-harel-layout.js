@@ -0,0 +1,43 @@
+/* eslint-env mocha */
+
+const assert = require('power-assert')
+const {run} = require('../util')
+
+run((ogdf) => {
+  const {
+    Graph,
+    GraphAttributes,
+    DavidsonHarelLayout,
+    NodeList,
+    randomSimpleGraph
+  } = ogdf
+  describe('DavidsonHarelLayout', () => {
+    describe('maxThreads(value)', () => {
+      it('sets parameter', () => {
+        const layout = new DavidsonHarelLayout()
+        assert.equal(layout.maxThreads, 1)
+        layout.maxThreads = 4
+        assert.equal(layout.maxThreads, 4)
+        layout.maxThreads = 0
+        assert.equal(layout.maxThreads, 1)
+      })
+    })
+
+    describe('call(GA)', () => {
+      it('computes layout', () => {
+        const graph = new Graph()
+        randomSimpleGraph(graph, 30, 60)
+        const attributes = new GraphAttributes(graph, GraphAttributes.nodeGraphics | GraphAttributes.edgeGraphics)
+        const layout = new DavidsonHarelLayout()
+        layout.maxThreads = 2
+        layout.call(attributes)
+        const nodes = new NodeList()
+        graph.allNodes(nodes)
+        for (let i = 0; i < nodes.size(); ++i) {
+          assert(Number.isFinite(attributes.x(nodes.get(i))))
+          assert(Number.isFinite(attributes.y(nodes.get(i))))
+        }
+      })
+    })
+  })
+})
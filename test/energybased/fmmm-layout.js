@@ -7,7 +7,8 @@ run((ogdf) => {
   const {
     Graph,
     GraphAttributes,
-    FMMMLayout
+    FMMMLayout,
+    randomSimpleGraph
   } = ogdf
   describe('FMMMLayout', () => {
     describe('useHighLevelOptions(value)', () => {
@@ -40,6 +41,17 @@ run((ogdf) => {
       })
     })
 
+    describe('maxThreads(value)', () => {
+      it('sets parameter', () => {
+        const layout = new FMMMLayout()
+        assert(layout.maxThreads >= 1)
+        layout.maxThreads = 1
+        assert.equal(layout.maxThreads, 1)
+        layout.maxThreads = 0
+        assert.equal(layout.maxThreads, 1)
+      })
+    })
+
     describe('call(GA)', () => {
       it('computes layout', () => {
         const graph = new Graph()
@@ -58,5 +70,27 @@ run((ogdf) => {
         layout.call(attributes)
       })
     })
+
+    describe('hierarchy()', () => {
+      it('exports the levels as typed arrays', () => {
+        const graph = new Graph()
+        randomSimpleGraph(graph, 500, 1000)
+        const attributes = new GraphAttributes(graph, GraphAttributes.nodeGraphics | GraphAttributes.edgeGraphics)
+
+        const layout = new FMMMLayout()
+        layout.retainHierarchy = true
+        layout.call(attributes)
+
+        const hierarchy = layout.hierarchy()
+        assert(hierarchy.numberOfLevels() > 1)
+        assert.equal(hierarchy.numberOfNodes(0), 500)
+        const parent = hierarchy.parent(0)
+        assert(parent instanceof Int32Array)
+        assert.equal(parent.length, 500)
+        assert(hierarchy.x(1) instanceof Float64Array)
+        assert(hierarchy.numberOfNodes(1) < 500)
+        hierarchy.delete()
+      })
+    })
   })
 })
@@ -0,0 +1,65 @@
+/* eslint-env mocha */
+
+const assert = require('power-assert')
+const {run} = require('../util')
+
+run((ogdf) => {
+  const {
+    Graph,
+    GraphAttributes,
+    NodeList,
+    SpringEmbedderKK,
+    planarConnectedGraph
+  } = ogdf
+  describe('SpringEmbedderKK', () => {
+    describe('useLayout(value)', () => {
+      it('sets parameter', () => {
+        const layout = new SpringEmbedderKK()
+        assert.equal(layout.useLayout, true)
+        layout.useLayout = false
+        assert.equal(layout.useLayout, false)
+      })
+    })
+
+    describe('maxGlobalIterations(value)', () => {
+      it('sets parameter', () => {
+        const layout = new SpringEmbedderKK()
+        layout.maxGlobalIterations = 100
+        assert.equal(layout.maxGlobalIterations, 100)
+        layout.maxGlobalIterations = 0
+        assert.equal(layout.maxGlobalIterations, 100)
+      })
+    })
+
+    describe('singlePrecisionMatrices(value)', () => {
+      it('sets parameter', () => {
+        const layout = new SpringEmbedderKK()
+        assert.equal(layout.singlePrecisionMatrices, false)
+        layout.singlePrecisionMatrices = true
+        assert.equal(layout.singlePrecisionMatrices, true)
+      })
+    })
+
+    describe('call(GA)', () => {
+      it('computes layout', () => {
+        const graph = new Graph()
+        planarConnectedGraph(graph, 50, 100)
+        const attributes = new GraphAttributes(graph, GraphAttributes.nodeGraphics | GraphAttributes.edgeGraphics)
+        const nodes = new NodeList()
+        graph.allNodes(nodes)
+        for (let i = 0; i < nodes.size(); ++i) {
+          attributes.x(nodes.get(i), i % 7)
+          attributes.y(nodes.get(i), Math.floor(i / 7))
+        }
+
+        const layout = new SpringEmbedderKK()
+        layout.singlePrecisionMatrices = true
+        layout.call(attributes)
+        for (let i = 0; i < nodes.size(); ++i) {
+          assert(Number.isFinite(attributes.x(nodes.get(i))))
+          assert(Number.isFinite(attributes.y(nodes.get(i))))
+        }
+      })
+    })
+  })
+})
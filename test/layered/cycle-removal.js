@@ -0,0 +1,63 @@
+/* eslint-env mocha */
+
+const assert = require('power-assert')
+const {run} = require('../util')
+
+run((ogdf) => {
+  const {
+    Graph,
+    EdgeList,
+    GraphAttributes,
+    LongestPathRanking,
+    SCCGreedyCycleRemoval,
+    SugiyamaLayout
+  } = ogdf
+
+  describe('SCCGreedyCycleRemoval', () => {
+    describe('call(G, arcSet)', () => {
+      it('breaks every cycle', () => {
+        const graph = new Graph()
+        const u = graph.newNode()
+        const v = graph.newNode()
+        const w = graph.newNode()
+        const x = graph.newNode()
+        graph.newEdge(u, v)
+        graph.newEdge(v, w)
+        graph.newEdge(w, u)
+        graph.newEdge(w, x)
+
+        const cycleRemoval = new SCCGreedyCycleRemoval()
+        cycleRemoval.maxThreads = 2
+        assert.equal(cycleRemoval.maxThreads, 2)
+        const arcSet = new EdgeList()
+        cycleRemoval.call(graph, arcSet)
+        assert.equal(arcSet.size(), 1)
+        assert.notEqual(arcSet.get(0).target().index(), x.index())
+      })
+    })
+
+    describe('as subgraph module of a ranking', () => {
+      it('computes layout', () => {
+        const graph = new Graph()
+        const u = graph.newNode()
+        const v = graph.newNode()
+        const w = graph.newNode()
+        graph.newEdge(u, v)
+        graph.newEdge(v, w)
+        graph.newEdge(w, u)
+
+        const {
+          nodeGraphics,
+          edgeGraphics
+        } = GraphAttributes
+        const attributes = new GraphAttributes(graph, nodeGraphics | edgeGraphics)
+        const ranking = new LongestPathRanking()
+        ranking.setSubgraph(new SCCGreedyCycleRemoval())
+        const layout = new SugiyamaLayout()
+        layout.setRanking(ranking)
+        layout.call(attributes)
+        assert.equal(layout.numberOfLevels(), 3)
+      })
+    })
+  })
+})
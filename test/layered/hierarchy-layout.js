@@ -0,0 +1,84 @@
+/* eslint-env mocha */
+
+const assert = require('power-assert')
+const {run} = require('../util')
+
+run((ogdf) => {
+  const {
+    Graph,
+    GraphAttributes,
+    FastHierarchyLayout,
+    FastSimpleHierarchyLayout,
+    NodeList,
+    SugiyamaLayout,
+    randomSimpleGraph
+  } = ogdf
+
+  const computeLayout = (graph, hierarchyLayout) => {
+    const attributes = new GraphAttributes(graph, GraphAttributes.nodeGraphics | GraphAttributes.edgeGraphics)
+    const layout = new SugiyamaLayout()
+    layout.runs = 1
+    layout.setLayout(hierarchyLayout)
+    layout.call(attributes)
+    return attributes
+  }
+
+  describe('FastHierarchyLayout', () => {
+    describe('as layout module of SugiyamaLayout', () => {
+      it('computes the same layout with several threads', () => {
+        const graph = new Graph()
+        randomSimpleGraph(graph, 100, 200)
+        const first = computeLayout(graph, new FastHierarchyLayout())
+        const hierarchyLayout = new FastHierarchyLayout()
+        hierarchyLayout.maxThreads = 4
+        const second = computeLayout(graph, hierarchyLayout)
+
+        const nodes = new NodeList()
+        graph.allNodes(nodes)
+        for (let i = 0; i < nodes.size(); ++i) {
+          assert.equal(first.x(nodes.get(i)), second.x(nodes.get(i)))
+          assert.equal(first.y(nodes.get(i)), second.y(nodes.get(i)))
+        }
+      })
+    })
+
+    describe('maxThreads', () => {
+      it('can set and get values', () => {
+        const layout = new FastHierarchyLayout()
+        assert.equal(layout.maxThreads, 1)
+        layout.maxThreads = 4
+        assert.equal(layout.maxThreads, 4)
+      })
+    })
+
+    describe('fixedLayerDistance', () => {
+      it('can set and get values', () => {
+        const layout = new FastHierarchyLayout()
+        assert.equal(layout.fixedLayerDistance, false)
+        layout.fixedLayerDistance = true
+        assert.equal(layout.fixedLayerDistance, true)
+      })
+    })
+  })
+
+  describe('FastSimpleHierarchyLayout', () => {
+    describe('as layout module of SugiyamaLayout', () => {
+      it('computes layout', () => {
+        const graph = new Graph()
+        randomSimpleGraph(graph, 100, 200)
+        const hierarchyLayout = new FastSimpleHierarchyLayout()
+        hierarchyLayout.balanced = false
+        computeLayout(graph, hierarchyLayout)
+      })
+    })
+
+    describe('balanced', () => {
+      it('can set and get values', () => {
+        const layout = new FastSimpleHierarchyLayout()
+        assert.equal(layout.balanced, true)
+        layout.balanced = false
+        assert.equal(layout.balanced, false)
+      })
+    })
+  })
+})
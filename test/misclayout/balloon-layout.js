@@ -0,0 +1,55 @@
+/* eslint-env mocha */
+
+const assert = require('power-assert')
+const {run} = require('../util')
+
+run((ogdf) => {
+  const {
+    Graph,
+    GraphAttributes,
+    BalloonLayout,
+    BalloonLayoutChildOrder,
+    NodeList,
+    randomTree
+  } = ogdf
+  describe('BalloonLayout', () => {
+    describe('call(GA)', () => {
+      it('computes the same layout with several threads', () => {
+        const graph = new Graph()
+        randomTree(graph, 200)
+        const first = new GraphAttributes(graph, GraphAttributes.nodeGraphics | GraphAttributes.edgeGraphics)
+        const second = new GraphAttributes(graph, GraphAttributes.nodeGraphics | GraphAttributes.edgeGraphics)
+        const layout = new BalloonLayout()
+        layout.childOrder = BalloonLayoutChildOrder.Optimized
+        layout.call(first)
+        layout.maxThreads = 4
+        layout.call(second)
+
+        const nodes = new NodeList()
+        graph.allNodes(nodes)
+        for (let i = 0; i < nodes.size(); ++i) {
+          assert.equal(first.x(nodes.get(i)), second.x(nodes.get(i)))
+          assert.equal(first.y(nodes.get(i)), second.y(nodes.get(i)))
+        }
+      })
+    })
+
+    describe('childOrder', () => {
+      it('can set and get values', () => {
+        const layout = new BalloonLayout()
+        assert(layout.childOrder === BalloonLayoutChildOrder.Fixed)
+        layout.childOrder = BalloonLayoutChildOrder.Optimized
+        assert(layout.childOrder === BalloonLayoutChildOrder.Optimized)
+      })
+    })
+
+    describe('maxThreads', () => {
+      it('can set and get values', () => {
+        const layout = new BalloonLayout()
+        assert.equal(layout.maxThreads, 1)
+        layout.maxThreads = 4
+        assert.equal(layout.maxThreads, 4)
+      })
+    })
+  })
+})
@@ -0,0 +1,63 @@
+/* eslint-env mocha */
+
+const assert = require('power-assert')
+const {run} = require('../util')
+
+run((ogdf) => {
+  const {
+    Graph,
+    GraphAttributes,
+    FMMMLayout,
+    NodeList,
+    OverlapRemovalLayout,
+    randomSimpleGraph
+  } = ogdf
+  describe('OverlapRemovalLayout', () => {
+    describe('call(GA)', () => {
+      it('removes overlaps left by an energy-based layout', () => {
+        const graph = new Graph()
+        randomSimpleGraph(graph, 100, 200)
+        const attributes = new GraphAttributes(graph, GraphAttributes.nodeGraphics | GraphAttributes.edgeGraphics)
+        new FMMMLayout().call(attributes)
+        const nodes = new NodeList()
+        graph.allNodes(nodes)
+        for (let i = 0; i < nodes.size(); ++i) {
+          attributes.width(nodes.get(i), 80)
+          attributes.height(nodes.get(i), 30)
+        }
+
+        const layout = new OverlapRemovalLayout()
+        assert(layout.numberOfOverlaps(attributes) > 0)
+        layout.call(attributes)
+        assert.equal(layout.numberOfOverlaps(attributes), 0)
+      })
+    })
+
+    describe('separation', () => {
+      it('can set and get values', () => {
+        const layout = new OverlapRemovalLayout()
+        const value = 10.0
+        layout.separation = value
+        assert.equal(layout.separation, value)
+      })
+    })
+
+    describe('maxIterations', () => {
+      it('can set and get values', () => {
+        const layout = new OverlapRemovalLayout()
+        const value = 100
+        layout.maxIterations = value
+        assert.equal(layout.maxIterations, value)
+      })
+    })
+
+    describe('neighbours', () => {
+      it('can set and get values', () => {
+        const layout = new OverlapRemovalLayout()
+        const value = 6
+        layout.neighbours = value
+        assert.equal(layout.neighbours, value)
+      })
+    })
+  })
+})
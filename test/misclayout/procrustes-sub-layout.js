@@ -0,0 +1,68 @@
+/* eslint-env mocha */
+
+const assert = require('power-assert')
+const {run} = require('../util')
+
+run((ogdf) => {
+  const {
+    Graph,
+    GraphAttributes,
+    FMMMLayout,
+    NodeList,
+    ProcrustesSubLayout,
+    randomSimpleGraph
+  } = ogdf
+  describe('ProcrustesSubLayout', () => {
+    describe('call(GA)', () => {
+      it('keeps the center of successive frames', () => {
+        const graph = new Graph()
+        randomSimpleGraph(graph, 100, 200)
+        const attributes = new GraphAttributes(graph, GraphAttributes.nodeGraphics | GraphAttributes.edgeGraphics)
+        const nodes = new NodeList()
+        graph.allNodes(nodes)
+        for (let i = 0; i < nodes.size(); ++i) {
+          attributes.x(nodes.get(i), 1000 + 10 * (i % 10))
+          attributes.y(nodes.get(i), 10 * Math.floor(i / 10))
+        }
+        const center = () => {
+          let x = 0
+          let y = 0
+          for (let i = 0; i < nodes.size(); ++i) {
+            x += attributes.x(nodes.get(i))
+            y += attributes.y(nodes.get(i))
+          }
+          return [x / nodes.size(), y / nodes.size()]
+        }
+        const [x, y] = center()
+
+        const sub = new FMMMLayout()
+        const layout = new ProcrustesSubLayout(sub)
+        layout.numberOfAnchors = 20
+        for (let frame = 0; frame < 3; ++frame) {
+          layout.call(attributes)
+          const [cx, cy] = center()
+          assert(Math.abs(cx - x) < 50)
+          assert(Math.abs(cy - y) < 50)
+        }
+      })
+    })
+
+    describe('scaleToInitialLayout', () => {
+      it('can set and get values', () => {
+        const layout = new ProcrustesSubLayout(new FMMMLayout())
+        assert.equal(layout.scaleToInitialLayout, true)
+        layout.scaleToInitialLayout = false
+        assert.equal(layout.scaleToInitialLayout, false)
+      })
+    })
+
+    describe('numberOfAnchors', () => {
+      it('can set and get values', () => {
+        const layout = new ProcrustesSubLayout(new FMMMLayout())
+        assert.equal(layout.numberOfAnchors, 0)
+        layout.numberOfAnchors = 64
+        assert.equal(layout.numberOfAnchors, 64)
+      })
+    })
+  })
+})
@@ -0,0 +1,56 @@
+/* eslint-env mocha */
+
+const assert = require('power-assert')
+const {run} = require('../util')
+
+run((ogdf) => {
+  const {
+    Graph,
+    GraphAttributes,
+    PlanarizationLayout,
+    EmbedderMaxFace,
+    EmbedderMaxFaceLayers,
+    EmbedderMinDepth,
+    EmbedderMinDepthMaxFace,
+    EmbedderMinDepthMaxFaceLayers
+  } = ogdf
+
+  const embedders = {
+    EmbedderMaxFace,
+    EmbedderMaxFaceLayers,
+    EmbedderMinDepth,
+    EmbedderMinDepthMaxFace,
+    EmbedderMinDepthMaxFaceLayers
+  }
+
+  Object.keys(embedders).forEach((name) => {
+    describe(name, () => {
+      describe('as embedder module of PlanarizationLayout', () => {
+        it('computes layout of a graph with several blocks', () => {
+          const graph = new Graph()
+          const center = graph.newNode()
+          for (let i = 0; i < 4; ++i) {
+            const u = graph.newNode()
+            const v = graph.newNode()
+            graph.newEdge(center, u)
+            graph.newEdge(u, v)
+            graph.newEdge(v, center)
+          }
+
+          const {
+            nodeGraphics,
+            edgeGraphics
+          } = GraphAttributes
+          const attributes = new GraphAttributes(graph, nodeGraphics | edgeGraphics)
+          const embedder = new embedders[name]()
+          embedder.maxThreads = 2
+          assert.equal(embedder.maxThreads, 2)
+          const layout = new PlanarizationLayout()
+          layout.setEmbedder(embedder)
+          layout.call(attributes)
+          assert.equal(layout.numberOfCrossings(), 0)
+        })
+      })
+    })
+  })
+})